@@ -0,0 +1,145 @@
+#include "TosClientV2.h"
+#include "mock/MockTosServer.h"
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+
+using namespace VolcengineTos;
+
+// 统计进程内的堆分配次数与字节数
+static std::atomic<uint64_t> allocCount(0);
+static std::atomic<uint64_t> allocBytes(0);
+
+void* operator new(size_t size) {
+    allocCount.fetch_add(1, std::memory_order_relaxed);
+    allocBytes.fetch_add(size, std::memory_order_relaxed);
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+struct AllocSample {
+    uint64_t count;
+    uint64_t bytes;
+};
+
+static AllocSample sample() {
+    return {allocCount.load(), allocBytes.load()};
+}
+
+static void printRow(const std::string& name, const AllocSample& begin, const AllocSample& end, int calls) {
+    std::cout << std::left << std::setw(48) << name << std::right << std::setw(14) << (end.count - begin.count) / calls
+              << std::setw(16) << (end.bytes - begin.bytes) / calls << std::endl;
+}
+
+static const std::string bucket = "alloc-bucket";
+
+static std::string keyOf(int i) {
+    std::stringstream ss;
+    ss << "list/object-" << std::setw(8) << std::setfill('0') << i;
+    return ss.str();
+}
+
+// 构造 keys 个对象的列举结果，模拟 SDK 内部 output -> Outcome -> 调用方的传递路径
+static Outcome<TosError, ListObjectsType2Output> buildListOutcome(int keys) {
+    Outcome<TosError, ListObjectsType2Output> res;
+    ListObjectsType2Output output;
+    std::vector<ListedObjectV2> contents;
+    contents.reserve(keys);
+    for (int i = 0; i < keys; i++) {
+        ListedObjectV2 object;
+        object.setKey(keyOf(i));
+        object.setETag("\"0123456789abcdef0123456789abcdef\"");
+        Owner owner;
+        owner.setId("owner-id-0000000000");
+        owner.setDisplayName("owner-display-name");
+        object.setOwner(owner);
+        contents.push_back(std::move(object));
+    }
+    output.setContents(std::move(contents));
+    res.setSuccess(true);
+    res.setR(std::move(output));
+    return res;
+}
+
+int main(int argc, char** argv) {
+    int keys = 1000;
+    int calls = 50;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string k = argv[i];
+        if (k == "--keys") {
+            keys = std::atoi(argv[i + 1]);
+        } else if (k == "--calls") {
+            calls = std::atoi(argv[i + 1]);
+        } else {
+            std::cerr << "unknown option " << k << std::endl;
+            return 1;
+        }
+    }
+
+    MockTosServer server;
+    if (!server.start()) {
+        std::cerr << "failed to start mock server" << std::endl;
+        return 1;
+    }
+    InitializeClient();
+    {
+        ClientConfig config;
+        config.endPoint = server.endpoint();
+        config.proxyHost = "127.0.0.1";
+        config.proxyPort = server.port();
+        TosClientV2 client("cn-mock", "ak", "sk", config);
+        CreateBucketV2Input createBucket(bucket);
+        client.createBucket(createBucket);
+        for (int i = 0; i < keys; i++) {
+            PutObjectV2Input input(bucket, keyOf(i), std::make_shared<std::stringstream>("x"));
+            if (!client.putObject(input).isSuccess()) {
+                std::cerr << "prepare failed" << std::endl;
+                return 1;
+            }
+        }
+
+        std::cout << std::left << std::setw(48) << "benchmark" << std::right << std::setw(14) << "allocs/call"
+                  << std::setw(16) << "bytes/call" << std::endl;
+
+        auto begin = sample();
+        for (int i = 0; i < calls; i++) {
+            auto res = buildListOutcome(keys);
+            if (res.result().getContents().size() != static_cast<size_t>(keys)) {
+                return 1;
+            }
+        }
+        printRow("build ListObjectsType2 outcome " + std::to_string(keys) + " keys", begin, sample(), calls);
+
+        ListObjectsType2Input input(bucket);
+        input.setPrefix("list/");
+        input.setMaxKeys(keys);
+        // 预热连接池
+        client.listObjectsType2(input);
+        begin = sample();
+        for (int i = 0; i < calls; i++) {
+            auto res = client.listObjectsType2(input);
+            if (!res.isSuccess() || res.result().getContents().size() != static_cast<size_t>(keys)) {
+                std::cerr << "listObjectsType2 failed" << std::endl;
+                return 1;
+            }
+        }
+        printRow("listObjectsType2 " + std::to_string(keys) + " keys", begin, sample(), calls);
+    }
+    CloseClient();
+    server.stop();
+    return 0;
+}
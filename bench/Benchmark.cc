@@ -0,0 +1,899 @@
+#include "TosClientV2.h"
+#include "metrics/Metrics.h"
+#include "mock/MockTosServer.h"
+#include "utils/crc64.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace VolcengineTos;
+
+struct BenchOptions {
+    int latencyMs = 0;
+    int64_t bandwidthMbps = 0;
+    double errorRate = 0;
+    bool enableCRC = true;
+    int threads = 8;
+    int ops = 2000;
+    int objectSize = 4096;
+    int fileMB = 64;
+    int objects = 5000;
+    std::vector<int> taskNums = {1, 4, 8, 16};
+    // 只运行单连接吞吐测试，配合 bench/netem_rtt.sh 在不同 RTT 下运行
+    bool singleStreamOnly = false;
+    // 落后连接测试中每 slowEvery 个连接有一个限速为 slowKBps
+    int slowEvery = 8;
+    int64_t slowKBps = 1024;
+};
+
+struct BenchResult {
+    std::string name;
+    int ops = 0;
+    int failed = 0;
+    uint64_t bytes = 0;
+    double seconds = 0;
+    std::vector<double> latencies;
+};
+
+static const std::string bucket = "bench-bucket";
+
+static double percentile(std::vector<double>& v, double q) {
+    if (v.empty()) {
+        return 0;
+    }
+    std::sort(v.begin(), v.end());
+    size_t idx = static_cast<size_t>(q * (v.size() - 1));
+    return v[idx];
+}
+
+static void printHeader() {
+    std::cout << std::left << std::setw(36) << "benchmark" << std::right << std::setw(10) << "ops" << std::setw(8)
+              << "failed" << std::setw(12) << "ops/s" << std::setw(12) << "MB/s" << std::setw(12) << "p50(ms)"
+              << std::setw(12) << "p99(ms)" << std::endl;
+}
+
+static void printResult(BenchResult& r) {
+    double opsPerSec = r.seconds > 0 ? r.ops / r.seconds : 0;
+    double mbPerSec = r.seconds > 0 ? r.bytes / r.seconds / 1024 / 1024 : 0;
+    std::cout << std::left << std::setw(36) << r.name << std::right << std::setw(10) << r.ops << std::setw(8)
+              << r.failed << std::fixed << std::setprecision(1) << std::setw(12) << opsPerSec << std::setw(12)
+              << mbPerSec << std::setprecision(2) << std::setw(12) << percentile(r.latencies, 0.5) << std::setw(12)
+              << percentile(r.latencies, 0.99) << std::endl;
+}
+
+// 多线程执行 fn(i)，记录每次调用的耗时
+template <typename Fn>
+static BenchResult runConcurrent(const std::string& name, int ops, int threads, uint64_t bytesPerOp, Fn fn) {
+    BenchResult result;
+    result.name = name;
+    std::atomic<int> next(0);
+    std::atomic<int> failed(0);
+    std::mutex mu;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&]() {
+            std::vector<double> local;
+            int i;
+            while ((i = next.fetch_add(1)) < ops) {
+                auto begin = std::chrono::steady_clock::now();
+                if (!fn(i)) {
+                    failed++;
+                }
+                std::chrono::duration<double, std::milli> cost = std::chrono::steady_clock::now() - begin;
+                local.push_back(cost.count());
+            }
+            std::lock_guard<std::mutex> lock(mu);
+            result.latencies.insert(result.latencies.end(), local.begin(), local.end());
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    std::chrono::duration<double> cost = std::chrono::steady_clock::now() - start;
+    result.seconds = cost.count();
+    result.ops = ops;
+    result.failed = failed;
+    result.bytes = bytesPerOp * (ops - result.failed);
+    return result;
+}
+
+static std::string keyOf(int i) {
+    std::stringstream ss;
+    ss << "small/" << std::setw(8) << std::setfill('0') << i;
+    return ss.str();
+}
+
+static void benchSmallObjects(const TosClientV2& client, const BenchOptions& opt) {
+    std::string data(opt.objectSize, 'x');
+    auto put = runConcurrent("PutObject " + std::to_string(opt.objectSize) + "B x" + std::to_string(opt.threads),
+                             opt.ops, opt.threads, opt.objectSize, [&](int i) {
+                                 PutObjectV2Input input(bucket, keyOf(i), std::make_shared<std::stringstream>(data));
+                                 return client.putObject(input).isSuccess();
+                             });
+    printResult(put);
+    auto get = runConcurrent("GetObject " + std::to_string(opt.objectSize) + "B x" + std::to_string(opt.threads),
+                             opt.ops, opt.threads, opt.objectSize, [&](int i) {
+                                 GetObjectV2Input input(bucket, keyOf(i));
+                                 auto out = client.getObject(input);
+                                 if (!out.isSuccess()) {
+                                     return false;
+                                 }
+                                 std::stringstream ss;
+                                 ss << out.result().getContent()->rdbuf();
+                                 return ss.str().size() == data.size();
+                             });
+    printResult(get);
+    auto head = runConcurrent("HeadObject x" + std::to_string(opt.threads), opt.ops, opt.threads, 0, [&](int i) {
+        HeadObjectV2Input input(bucket, keyOf(i));
+        return client.headObject(input).isSuccess();
+    });
+    printResult(head);
+}
+
+static void benchTransfer(const TosClientV2& client, const BenchOptions& opt) {
+    const std::string uploadPath = "./tos_bench_upload.dat";
+    const std::string downloadPath = "./tos_bench_download.dat";
+    int64_t size = static_cast<int64_t>(opt.fileMB) * 1024 * 1024;
+    {
+        std::ofstream f(uploadPath, std::ios::binary | std::ios::trunc);
+        std::string block(1024 * 1024, 'y');
+        for (int i = 0; i < opt.fileMB; i++) {
+            f.write(block.data(), block.size());
+        }
+    }
+    for (int taskNum : opt.taskNums) {
+        auto up = runConcurrent("UploadFile " + std::to_string(opt.fileMB) + "MB task=" + std::to_string(taskNum), 1,
+                                1, size, [&](int) {
+                                    UploadFileV2Input input(bucket, "large/object");
+                                    input.setFilePath(uploadPath);
+                                    input.setPartSize(8 * 1024 * 1024);
+                                    input.setTaskNum(taskNum);
+                                    auto out = client.uploadFile(input);
+                                    if (!out.isSuccess()) {
+                                        std::cerr << "uploadFile failed: " << out.error().String() << std::endl;
+                                    }
+                                    return out.isSuccess();
+                                });
+        printResult(up);
+        auto down = runConcurrent("DownloadFile " + std::to_string(opt.fileMB) + "MB task=" + std::to_string(taskNum),
+                                  1, 1, size, [&](int) {
+                                      DownloadFileInput input(bucket, "large/object");
+                                      input.setFilePath(downloadPath);
+                                      input.setPartSize(8 * 1024 * 1024);
+                                      input.setTaskNum(taskNum);
+                                      auto out = client.downloadFile(input);
+                                      if (!out.isSuccess()) {
+                                          std::cerr << "downloadFile failed: " << out.error().String() << std::endl;
+                                      }
+                                      return out.isSuccess();
+                                  });
+        printResult(down);
+    }
+    std::remove(uploadPath.c_str());
+    std::remove(downloadPath.c_str());
+}
+
+// 把 benchTransfer 上传的大对象读入内存：getObject 读出后拷贝与 downloadToBuffer 并发范围读的对比
+static void benchDownloadToBuffer(const TosClientV2& client, const BenchOptions& opt) {
+    int64_t size = static_cast<int64_t>(opt.fileMB) * 1024 * 1024;
+    int taskNum = opt.taskNums.empty() ? 8 : opt.taskNums.back();
+    std::vector<char> buffer(size);
+    auto plain = runConcurrent("GetObjectCopy " + std::to_string(opt.fileMB) + "MB", 1, 1, size, [&](int) {
+        auto out = client.getObject(GetObjectV2Input(bucket, "large/object"));
+        if (!out.isSuccess()) {
+            return false;
+        }
+        auto content = out.result().getContent();
+        content->read(buffer.data(), size);
+        return content->gcount() == size;
+    });
+    printResult(plain);
+    // 单个请求直接写入 buffer，不经过中间的 stringstream
+    auto sink = runConcurrent("GetObjectSink " + std::to_string(opt.fileMB) + "MB", 1, 1, size, [&](int) {
+        auto memory = std::make_shared<MemoryBodySink>(buffer.data(), size);
+        auto out = client.getObject(GetObjectV2Input(bucket, "large/object"), memory);
+        return out.isSuccess() && memory->written() == size;
+    });
+    printResult(sink);
+    auto parallel = runConcurrent("DownloadToBuffer " + std::to_string(opt.fileMB) + "MB task=" +
+                                          std::to_string(taskNum),
+                                  1, 1, size, [&](int) {
+                                      DownloadToBufferInput input(bucket, "large/object", buffer.data(), size);
+                                      input.setTaskNum(taskNum);
+                                      auto out = client.downloadToBuffer(input);
+                                      if (!out.isSuccess()) {
+                                          std::cerr << "downloadToBuffer failed: " << out.error().String()
+                                                    << std::endl;
+                                      }
+                                      return out.isSuccess();
+                                  });
+    printResult(parallel);
+}
+
+// 本地文件 CRC64：单线程顺序计算与 CalcFileCRC 分块并发计算的对比
+static void benchFileCrc(const BenchOptions& opt) {
+    const std::string path = "./tos_bench_crc.dat";
+    int fileMB = opt.fileMB * 8;
+    {
+        std::ofstream f(path, std::ios::binary | std::ios::trunc);
+        std::string block(1024 * 1024, 'z');
+        for (int i = 0; i < fileMB; i++) {
+            block[i % block.size()] = static_cast<char>(i);
+            f.write(block.data(), block.size());
+        }
+    }
+    uint64_t size = static_cast<uint64_t>(fileMB) * 1024 * 1024;
+    uint64_t serialCrc = 0;
+    auto serial = runConcurrent("FileCrc serial " + std::to_string(fileMB) + "MB", 1, 1, size, [&](int) {
+        std::ifstream ifs(path, std::ios::in | std::ios::binary);
+        std::vector<char> buffer(1024 * 1024);
+        serialCrc = 0;
+        while (ifs.read(buffer.data(), buffer.size()) || ifs.gcount() > 0) {
+            serialCrc = CRC64::CalcCRC(serialCrc, buffer.data(), ifs.gcount());
+        }
+        return true;
+    });
+    printResult(serial);
+    int threads = opt.taskNums.empty() ? 8 : opt.taskNums.back();
+    auto parallel = runConcurrent("CalcFileCRC threads=" + std::to_string(threads), 1, 1, size, [&](int) {
+        uint64_t crc = 0;
+        return CRC64::CalcFileCRC(path, threads, crc) && crc == serialCrc;
+    });
+    printResult(parallel);
+    std::remove(path.c_str());
+}
+
+// 小文件和大文件混合的目录：逐个文件上传与 uploadDirectory 共享并发的对比
+static void benchUploadDirectory(const TosClientV2& client, const BenchOptions& opt) {
+    const std::string dir = "./tos_bench_dir/";
+    const int largeFiles = 2;
+    int64_t largeSize = static_cast<int64_t>(opt.fileMB) * 1024 * 1024;
+    int smallFiles = std::max(opt.objects, 1);
+    std::vector<std::string> paths;
+    FileUtils::CreateDir(dir + "small/", false);
+    std::string small(opt.objectSize, 'd');
+    for (int i = 0; i < smallFiles; i++) {
+        paths.push_back("small/" + std::to_string(i));
+        std::ofstream(dir + paths.back(), std::ios::binary | std::ios::trunc) << small;
+    }
+    std::string block(1024 * 1024, 'D');
+    for (int i = 0; i < largeFiles; i++) {
+        paths.push_back("large" + std::to_string(i));
+        std::ofstream f(dir + paths.back(), std::ios::binary | std::ios::trunc);
+        for (int m = 0; m < opt.fileMB; m++) {
+            f.write(block.data(), block.size());
+        }
+    }
+    uint64_t totalBytes = smallFiles * static_cast<uint64_t>(opt.objectSize) + largeFiles * largeSize;
+    int taskNum = opt.taskNums.empty() ? 8 : opt.taskNums.back();
+    const int64_t threshold = 8 * 1024 * 1024;
+    auto perFile = runConcurrent("PerFileUpload dir task=" + std::to_string(taskNum), 1, 1, totalBytes, [&](int) {
+        for (const auto& path : paths) {
+            bool ok;
+            if (path.compare(0, 5, "large") == 0 && largeSize > threshold) {
+                UploadFileV2Input input(bucket, "dir1/" + path);
+                input.setFilePath(dir + path);
+                input.setPartSize(threshold);
+                input.setTaskNum(taskNum);
+                ok = client.uploadFile(input).isSuccess();
+            } else {
+                ok = client.putObjectFromFile(PutObjectFromFileInput(bucket, "dir1/" + path, dir + path)).isSuccess();
+            }
+            if (!ok) {
+                return false;
+            }
+        }
+        return true;
+    });
+    printResult(perFile);
+    auto directory = runConcurrent("UploadDirectory task=" + std::to_string(taskNum), 1, 1, totalBytes, [&](int) {
+        UploadDirectoryInput input(bucket, dir, "dir2/");
+        input.setTaskNum(taskNum);
+        input.setPartSize(threshold);
+        input.setMultipartThreshold(threshold);
+        auto out = client.uploadDirectory(input);
+        if (!out.isSuccess()) {
+            std::cerr << "uploadDirectory failed: " << out.error().String() << std::endl;
+        }
+        return out.isSuccess();
+    });
+    printResult(directory);
+    for (const auto& path : paths) {
+        std::remove((dir + path).c_str());
+    }
+    std::remove((dir + "small").c_str());
+    std::remove(dir.c_str());
+}
+
+// 已同步过的目录中修改少量文件后：整个目录重新上传与 syncDirectory 只上传变化文件的对比
+static void benchSyncDirectory(const TosClientV2& client, const BenchOptions& opt) {
+    const std::string dir = "./tos_bench_sync/";
+    const std::string stateFile = "./tos_bench_sync.state";
+    int smallFiles = std::max(opt.objects, 1);
+    std::vector<std::string> paths;
+    FileUtils::CreateDir(dir + "small/", false);
+    std::string small(opt.objectSize, 's');
+    for (int i = 0; i < smallFiles; i++) {
+        paths.push_back("small/" + std::to_string(i));
+        std::ofstream(dir + paths.back(), std::ios::binary | std::ios::trunc) << small;
+    }
+    std::string block(1024 * 1024, 'S');
+    paths.push_back("large");
+    {
+        std::ofstream f(dir + paths.back(), std::ios::binary | std::ios::trunc);
+        for (int m = 0; m < opt.fileMB; m++) {
+            f.write(block.data(), block.size());
+        }
+    }
+    uint64_t totalBytes = smallFiles * static_cast<uint64_t>(opt.objectSize) + opt.fileMB * 1024ULL * 1024;
+    int taskNum = opt.taskNums.empty() ? 8 : opt.taskNums.back();
+    const int64_t threshold = 8 * 1024 * 1024;
+    SyncDirectoryInput sync(bucket, dir, "dir3/", SyncDirectionType::Upload);
+    sync.setTaskNum(taskNum);
+    sync.setPartSize(threshold);
+    sync.setMultipartThreshold(threshold);
+    sync.setStateFile(stateFile);
+    if (!client.syncDirectory(sync).isSuccess()) {
+        std::cerr << "initial syncDirectory failed" << std::endl;
+        return;
+    }
+    // 修改 1% 的小文件，大小不变
+    std::string changed(opt.objectSize, 'c');
+    for (int i = 0; i < smallFiles; i += 100) {
+        std::ofstream(dir + paths[i], std::ios::binary | std::ios::trunc) << changed;
+    }
+    auto incremental = runConcurrent("SyncDirectory task=" + std::to_string(taskNum), 1, 1, totalBytes, [&](int) {
+        auto out = client.syncDirectory(sync);
+        if (!out.isSuccess()) {
+            std::cerr << "syncDirectory failed: " << out.error().String() << std::endl;
+        }
+        return out.isSuccess();
+    });
+    printResult(incremental);
+    auto full = runConcurrent("FullReupload task=" + std::to_string(taskNum), 1, 1, totalBytes, [&](int) {
+        UploadDirectoryInput input(bucket, dir, "dir3/");
+        input.setTaskNum(taskNum);
+        input.setPartSize(threshold);
+        input.setMultipartThreshold(threshold);
+        return client.uploadDirectory(input).isSuccess();
+    });
+    printResult(full);
+    for (const auto& path : paths) {
+        std::remove((dir + path).c_str());
+    }
+    std::remove((dir + "small").c_str());
+    std::remove(dir.c_str());
+    std::remove(stateFile.c_str());
+}
+
+// 下载 benchUploadDirectory 上传的目录：串行列举后逐个 downloadFile 与 downloadPrefix 的对比
+static void benchDownloadPrefix(const TosClientV2& client, const BenchOptions& opt) {
+    const std::string dir = "./tos_bench_prefix/";
+    int taskNum = opt.taskNums.empty() ? 8 : opt.taskNums.back();
+    const int64_t threshold = 8 * 1024 * 1024;
+    uint64_t totalBytes = 0;
+    std::vector<ListedObjectV2> objects;
+    ListObjectsType2Input list;
+    list.setBucket(bucket);
+    list.setPrefix("dir2/");
+    while (true) {
+        auto out = client.listObjectsType2(list);
+        if (!out.isSuccess()) {
+            std::cerr << "list dir2/ failed" << std::endl;
+            return;
+        }
+        for (const auto& object : out.result().getContents()) {
+            objects.push_back(object);
+            totalBytes += object.getSize();
+        }
+        if (!out.result().isTruncated()) {
+            break;
+        }
+        list.setContinuationToken(out.result().getNextContinuationToken());
+    }
+    auto perFile = runConcurrent("PerFileDownload dir task=" + std::to_string(taskNum), 1, 1, totalBytes, [&](int) {
+        for (const auto& object : objects) {
+            DownloadFileInput input(bucket, object.getKey());
+            input.setFilePath(dir + "1/" + object.getKey().substr(5));
+            input.setPartSize(threshold);
+            input.setTaskNum(object.getSize() > threshold ? taskNum : 1);
+            if (!client.downloadFile(input).isSuccess()) {
+                return false;
+            }
+        }
+        return true;
+    });
+    printResult(perFile);
+    auto prefix = runConcurrent("DownloadPrefix task=" + std::to_string(taskNum), 1, 1, totalBytes, [&](int) {
+        DownloadPrefixInput input(bucket, "dir2/", dir + "2/");
+        input.setTaskNum(taskNum);
+        input.setPartSize(threshold);
+        input.setParallelThreshold(threshold);
+        auto out = client.downloadPrefix(input);
+        if (!out.isSuccess()) {
+            std::cerr << "downloadPrefix failed: " << out.error().String() << std::endl;
+        }
+        return out.isSuccess();
+    });
+    printResult(prefix);
+    for (const auto& sub : {"1/", "2/"}) {
+        for (const auto& object : objects) {
+            std::remove((dir + sub + object.getKey().substr(5)).c_str());
+        }
+        std::remove((dir + sub + "small").c_str());
+        std::remove((dir + sub).c_str());
+    }
+    std::remove(dir.c_str());
+}
+
+// 复制 benchUploadDirectory 上传的目录：串行列举后逐个 copyObject 与 copyPrefix 的对比
+static void benchCopyPrefix(const TosClientV2& client, const BenchOptions& opt) {
+    int taskNum = opt.taskNums.empty() ? 8 : opt.taskNums.back();
+    uint64_t totalBytes = 0;
+    std::vector<ListedObjectV2> objects;
+    ListObjectsType2Input list;
+    list.setBucket(bucket);
+    list.setPrefix("dir2/");
+    while (true) {
+        auto out = client.listObjectsType2(list);
+        if (!out.isSuccess()) {
+            std::cerr << "list dir2/ failed" << std::endl;
+            return;
+        }
+        for (const auto& object : out.result().getContents()) {
+            objects.push_back(object);
+            totalBytes += object.getSize();
+        }
+        if (!out.result().isTruncated()) {
+            break;
+        }
+        list.setContinuationToken(out.result().getNextContinuationToken());
+    }
+    auto perKey = runConcurrent("PerKeyCopyObject dir", 1, 1, totalBytes, [&](int) {
+        for (const auto& object : objects) {
+            CopyObjectV2Input input(bucket, "copy1/" + object.getKey().substr(5), bucket, object.getKey());
+            if (!client.copyObject(input).isSuccess()) {
+                return false;
+            }
+        }
+        return true;
+    });
+    printResult(perKey);
+    auto prefix = runConcurrent("CopyPrefix task=" + std::to_string(taskNum), 1, 1, totalBytes, [&](int) {
+        CopyPrefixInput input(bucket, "dir2/", bucket, "copy2/");
+        input.setTaskNum(taskNum);
+        auto out = client.copyPrefix(input);
+        if (!out.isSuccess()) {
+            std::cerr << "copyPrefix failed: " << out.error().String() << std::endl;
+        }
+        return out.isSuccess();
+    });
+    printResult(prefix);
+}
+
+// 以 256KB 为单位顺序扫描大对象，比较逐个范围读和读会话预读的吞吐
+static void benchSequentialRead(const TosClientV2& client, const BenchOptions& opt) {
+    int64_t size = static_cast<int64_t>(opt.fileMB) * 1024 * 1024;
+    const int64_t step = 256 * 1024;
+    PutObjectV2Input put(bucket, "scan/object", std::make_shared<std::stringstream>(std::string(size, 's')));
+    if (!client.putObject(put).isSuccess()) {
+        std::cerr << "prepare scan object failed" << std::endl;
+        return;
+    }
+    auto plain = runConcurrent("RangeScan " + std::to_string(opt.fileMB) + "MB 256KB", 1, 1, size, [&](int) {
+        for (int64_t start = 0; start < size; start += step) {
+            GetObjectV2Input input(bucket, "scan/object");
+            input.setRange("bytes=" + std::to_string(start) + "-" + std::to_string(start + step - 1));
+            auto out = client.getObject(input);
+            if (!out.isSuccess() || out.result().getGetObjectBasicOutput().getContentLength() != step) {
+                return false;
+            }
+        }
+        return true;
+    });
+    printResult(plain);
+    ReadSessionStats stats;
+    auto session = runConcurrent("SessionScan " + std::to_string(opt.fileMB) + "MB 256KB", 1, 1, size, [&](int) {
+        auto reader = client.openReadSession(GetObjectV2Input(bucket, "scan/object"));
+        for (int64_t start = 0; start < size; start += step) {
+            auto out = reader->read(start, start + step - 1);
+            if (!out.isSuccess() || out.result().getGetObjectBasicOutput().getContentLength() != step) {
+                return false;
+            }
+        }
+        stats = reader->stats();
+        return true;
+    });
+    printResult(session);
+    std::cout << "  prefetch requests " << stats.prefetchRequests << ", hits " << stats.prefetchHits << ", waits "
+              << stats.prefetchWaits << ", wasted " << stats.wastedBytes << " B, window " << stats.window << std::endl;
+}
+
+// 类似列存文件的读取：每次读取多个间隔较小的小范围
+static void benchVectoredRead(const TosClientV2& client, const BenchOptions& opt) {
+    int64_t size = static_cast<int64_t>(opt.fileMB) * 1024 * 1024;
+    const int64_t length = 16 * 1024;
+    const int64_t stride = 24 * 1024;
+    const int rangeNum = static_cast<int>(std::min<int64_t>(64, size / stride));
+    PutObjectV2Input put(bucket, "vector/object", std::make_shared<std::stringstream>(std::string(size, 'v')));
+    if (rangeNum <= 0 || !client.putObject(put).isSuccess()) {
+        std::cerr << "prepare vector object failed" << std::endl;
+        return;
+    }
+    int ops = std::max(opt.ops / 100, 1);
+    uint64_t bytesPerOp = rangeNum * length;
+    auto perRange = runConcurrent("RangeGet x" + std::to_string(rangeNum) + " 16KB", ops, 1, bytesPerOp, [&](int) {
+        for (int r = 0; r < rangeNum; r++) {
+            GetObjectV2Input input(bucket, "vector/object");
+            input.setRange("bytes=" + std::to_string(r * stride) + "-" + std::to_string(r * stride + length - 1));
+            auto out = client.getObject(input);
+            if (!out.isSuccess() || out.result().getGetObjectBasicOutput().getContentLength() != length) {
+                return false;
+            }
+        }
+        return true;
+    });
+    printResult(perRange);
+    std::vector<std::string> buffers(rangeNum, std::string(length, '\0'));
+    int requests = 0;
+    auto vectored = runConcurrent("ReadRanges x" + std::to_string(rangeNum) + " 16KB", ops, 1, bytesPerOp, [&](int) {
+        ReadRangesInput input(bucket, "vector/object");
+        for (int r = 0; r < rangeNum; r++) {
+            input.addRange(r * stride, length, &buffers[r][0]);
+        }
+        input.setMaxRangeSize(256 * 1024);
+        auto out = client.readRanges(input);
+        if (!out.isSuccess()) {
+            return false;
+        }
+        requests = out.result().getRequestCount();
+        for (auto n : out.result().getReadBytes()) {
+            if (n != length) {
+                return false;
+            }
+        }
+        return true;
+    });
+    printResult(vectored);
+    std::cout << "  readRanges requests per call " << requests << std::endl;
+}
+
+static void benchList(const TosClientV2& client, const BenchOptions& opt) {
+    std::string data(16, 'z');
+    runConcurrent("prepare", opt.objects, opt.threads, 0, [&](int i) {
+        PutObjectV2Input input(bucket, "list/" + keyOf(i), std::make_shared<std::stringstream>(data));
+        return client.putObject(input).isSuccess();
+    });
+    for (int maxKeys : {100, 1000}) {
+        int pages = 0;
+        int listed = 0;
+        auto r = runConcurrent("ListObjectsType2 " + std::to_string(opt.objects) + " keys max=" + std::to_string(maxKeys),
+                               1, 1, 0, [&](int) {
+                                   ListObjectsType2Input input(bucket);
+                                   input.setPrefix("list/");
+                                   input.setMaxKeys(maxKeys);
+                                   while (true) {
+                                       auto out = client.listObjectsType2(input);
+                                       if (!out.isSuccess()) {
+                                           return false;
+                                       }
+                                       pages++;
+                                       listed += static_cast<int>(out.result().getContents().size());
+                                       if (!out.result().isTruncated()) {
+                                           return listed == opt.objects;
+                                       }
+                                       input.setContinuationToken(out.result().getNextContinuationToken());
+                                   }
+                               });
+        r.ops = pages;
+        printResult(r);
+    }
+}
+
+// 开启对象缓存后重复读同一批对象，ttl 内直接命中，ttl 为 0 时每次通过 304 重新校验
+static void benchObjectCache(const ClientConfig& baseConfig, const BenchOptions& opt) {
+    std::string data(opt.objectSize, 'x');
+    for (int ttl : {60, 0}) {
+        ClientConfig config = baseConfig;
+        config.enableObjectCache = true;
+        config.objectCacheOptions.ttl = ttl;
+        config.objectCacheOptions.blockSize = 64 * 1024;
+        TosClientV2 client("cn-mock", "ak", "sk", config);
+        int hotObjects = std::max(1, opt.ops / 10);
+        auto get = runConcurrent("CachedGetObject ttl=" + std::to_string(ttl) + " x" + std::to_string(opt.threads),
+                                 opt.ops, opt.threads, opt.objectSize, [&](int i) {
+                                     GetObjectV2Input input(bucket, keyOf(i % hotObjects));
+                                     auto out = client.getObject(input);
+                                     if (!out.isSuccess()) {
+                                         return false;
+                                     }
+                                     std::stringstream ss;
+                                     ss << out.result().getContent()->rdbuf();
+                                     return ss.str() == data;
+                                 });
+        printResult(get);
+        auto stats = client.getObjectCacheStats();
+        std::cout << "  cache hits " << stats.hits << ", misses " << stats.misses << ", revalidations "
+                  << stats.revalidations << ", memory " << stats.memoryBytes << " B" << std::endl;
+    }
+
+    // 范围读按块缓存，覆盖写后必须读到新内容
+    ClientConfig config = baseConfig;
+    config.enableObjectCache = true;
+    config.objectCacheOptions.ttl = 60;
+    config.objectCacheOptions.blockSize = 1024;
+    TosClientV2 client("cn-mock", "ak", "sk", config);
+    std::string content(10000, '\0');
+    for (size_t i = 0; i < content.size(); i++) {
+        content[i] = static_cast<char>('a' + i % 26);
+    }
+    PutObjectV2Input prepare(bucket, "cache/ranged", std::make_shared<std::stringstream>(content));
+    client.putObject(prepare);
+    auto ranged = runConcurrent("CachedRangeGet 10000B x" + std::to_string(opt.threads), opt.ops, opt.threads, 0,
+                           [&](int i) {
+                               int64_t start = (i * 997) % 9000;
+                               int64_t end = start + (i % 7) * 150 + 1;
+                               GetObjectV2Input input(bucket, "cache/ranged");
+                               input.setRangeStart(start);
+                               input.setRangeEnd(end);
+                               auto out = client.getObject(input);
+                               if (!out.isSuccess()) {
+                                   return false;
+                               }
+                               std::stringstream ss;
+                               ss << out.result().getContent()->rdbuf();
+                               return ss.str() == content.substr(start, end - start + 1) &&
+                                      out.result().getGetObjectBasicOutput().getContentLength() == end - start + 1;
+                           });
+    printResult(ranged);
+    std::string updated(5000, 'u');
+    PutObjectV2Input put(bucket, "cache/ranged", std::make_shared<std::stringstream>(updated));
+    GetObjectV2Input input(bucket, "cache/ranged");
+    bool consistent = client.putObject(put).isSuccess();
+    auto out = client.getObject(input);
+    std::stringstream ss;
+    if (out.isSuccess()) {
+        ss << out.result().getContent()->rdbuf();
+    }
+    auto stats = client.getObjectCacheStats();
+    std::cout << "  cache hits " << stats.hits << ", misses " << stats.misses << ", read after overwrite "
+              << (consistent && ss.str() == updated ? "ok" : "STALE") << std::endl;
+}
+
+// 多线程同时读少量热点对象，比较开启元数据缓存和请求合并前后发往服务端的请求数
+static void benchHotKeys(const ClientConfig& baseConfig, MockTosServer& server, const BenchOptions& opt) {
+    std::string data(opt.objectSize, 'h');
+    for (int i = 0; i < 4; i++) {
+        TosClientV2 client("cn-mock", "ak", "sk", baseConfig);
+        PutObjectV2Input input(bucket, "hot/" + std::to_string(i), std::make_shared<std::stringstream>(data));
+        client.putObject(input);
+    }
+    for (int mode = 0; mode < 3; mode++) {
+        ClientConfig config = baseConfig;
+        std::string name = "plain";
+        if (mode >= 1) {
+            config.enableRequestCoalescing = true;
+            name = "coalesced";
+        }
+        if (mode >= 2) {
+            config.enableObjectMetaCache = true;
+            name = "coalesced+metacache";
+        }
+        TosClientV2 client("cn-mock", "ak", "sk", config);
+        auto before = server.stats().requests;
+        auto head = runConcurrent("HotHeadObject " + name, opt.ops, opt.threads * 4, 0, [&](int i) {
+            HeadObjectV2Input input(bucket, "hot/" + std::to_string(i % 4));
+            return client.headObject(input).isSuccess();
+        });
+        printResult(head);
+        auto afterHead = server.stats().requests;
+        auto get = runConcurrent("HotGetObject " + name, opt.ops, opt.threads * 4, opt.objectSize, [&](int i) {
+            GetObjectV2Input input(bucket, "hot/" + std::to_string(i % 4));
+            auto out = client.getObject(input);
+            if (!out.isSuccess()) {
+                return false;
+            }
+            std::stringstream ss;
+            ss << out.result().getContent()->rdbuf();
+            return ss.str() == data;
+        });
+        printResult(get);
+        auto stats = client.getObjectMetaCacheStats();
+        std::cout << "  server requests head " << afterHead - before << ", get " << server.stats().requests - afterHead
+                  << ", coalesced head " << stats.coalescedHeads << ", get " << stats.coalescedGets
+                  << ", meta cache hits " << stats.hits << std::endl;
+    }
+}
+
+// 单个连接上传、下载一个大对象的吞吐，比较默认缓冲区与调大 libcurl 缓冲区和 socket 缓冲区后的差异。
+// RTT 由 bench/netem_rtt.sh 用 netem 在 loopback 上模拟
+static void benchSingleStream(const ClientConfig& baseConfig, const BenchOptions& opt) {
+    int64_t size = static_cast<int64_t>(opt.fileMB) * 1024 * 1024;
+    std::string data(size, 's');
+    std::vector<char> buffer(size);
+    for (int tuned = 0; tuned < 2; tuned++) {
+        ClientConfig config = baseConfig;
+        std::string name = "default";
+        if (tuned) {
+            config.receiveBufferSize = 512 * 1024;
+            config.uploadBufferSize = 2 * 1024 * 1024;
+            config.socketSendBufferSize = 16 * 1024 * 1024;
+            config.socketReceiveBufferSize = 16 * 1024 * 1024;
+            name = "tuned";
+        }
+        TosClientV2 client("cn-mock", "ak", "sk", config);
+        auto put = runConcurrent("SingleStreamPut " + std::to_string(opt.fileMB) + "MB " + name, 1, 1, size,
+                                 [&](int) {
+                                     PutObjectV2Input input(bucket, "stream/object");
+                                     input.setBodySource(std::make_shared<MemoryBodySource>(data.data(), size));
+                                     return client.putObject(input).isSuccess();
+                                 });
+        printResult(put);
+        auto get = runConcurrent("SingleStreamGet " + std::to_string(opt.fileMB) + "MB " + name, 1, 1, size,
+                                 [&](int) {
+                                     auto sink = std::make_shared<MemoryBodySink>(buffer.data(), size);
+                                     auto out = client.getObject(GetObjectV2Input(bucket, "stream/object"), sink);
+                                     return out.isSuccess() && sink->written() == size;
+                                 });
+        printResult(get);
+    }
+}
+
+// 个别连接明显慢于其他连接时 uploadFile/downloadFile 的总耗时，比较关闭与开启落后检测的差异
+static void benchStragglers(const ClientConfig& baseConfig, MockTosServer& server, const BenchOptions& opt) {
+    const std::string uploadPath = "./tos_bench_straggler.dat";
+    const std::string downloadPath = "./tos_bench_straggler_download.dat";
+    int64_t size = static_cast<int64_t>(opt.fileMB) * 1024 * 1024;
+    {
+        std::ofstream f(uploadPath, std::ios::binary | std::ios::trunc);
+        std::string block(1024 * 1024, 'z');
+        for (int i = 0; i < opt.fileMB; i++) {
+            f.write(block.data(), block.size());
+        }
+    }
+    MetricsRegistry::instance()->setEnabled(true);
+    server.setSlowConnections(opt.slowEvery, opt.slowKBps * 1024);
+    for (int detect = 0; detect < 2; detect++) {
+        ClientConfig config = baseConfig;
+        config.enableStragglerDetection = detect == 1;
+        config.stragglerOptions.minElapsedMillis = 1000;
+        std::string name = detect ? "detect" : "default";
+        MetricsRegistry::instance()->reset();
+        TosClientV2 client("cn-mock", "ak", "sk", config);
+        auto up = runConcurrent("StragglerUpload " + name, 1, 1, size, [&](int) {
+            UploadFileV2Input input(bucket, "straggler/object");
+            input.setFilePath(uploadPath);
+            input.setPartSize(8 * 1024 * 1024);
+            input.setTaskNum(8);
+            return client.uploadFile(input).isSuccess();
+        });
+        printResult(up);
+        auto down = runConcurrent("StragglerDownload " + name, 1, 1, size, [&](int) {
+            DownloadFileInput input(bucket, "straggler/object");
+            input.setFilePath(downloadPath);
+            input.setPartSize(8 * 1024 * 1024);
+            input.setTaskNum(8);
+            return client.downloadFile(input).isSuccess();
+        });
+        printResult(down);
+        auto snapshot = MetricsRegistry::instance()->snapshot();
+        std::cout << "  straggler restarts " << snapshot.stragglerRestarts << ", duplicates "
+                  << snapshot.stragglerDuplicates << std::endl;
+    }
+    server.setSlowConnections(0, 0);
+    MetricsRegistry::instance()->setEnabled(false);
+    std::remove(uploadPath.c_str());
+    std::remove(downloadPath.c_str());
+}
+
+static std::vector<int> parseIntList(const std::string& s) {
+    std::vector<int> out;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        out.push_back(std::atoi(item.c_str()));
+    }
+    return out;
+}
+
+int main(int argc, char** argv) {
+    BenchOptions opt;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string k = argv[i];
+        std::string v = argv[i + 1];
+        if (k == "--latency-ms") {
+            opt.latencyMs = std::atoi(v.c_str());
+        } else if (k == "--bandwidth-mbps") {
+            opt.bandwidthMbps = std::atoll(v.c_str());
+        } else if (k == "--error-rate") {
+            opt.errorRate = std::atof(v.c_str());
+        } else if (k == "--crc") {
+            opt.enableCRC = v != "0";
+        } else if (k == "--threads") {
+            opt.threads = std::atoi(v.c_str());
+        } else if (k == "--ops") {
+            opt.ops = std::atoi(v.c_str());
+        } else if (k == "--object-size") {
+            opt.objectSize = std::atoi(v.c_str());
+        } else if (k == "--file-mb") {
+            opt.fileMB = std::atoi(v.c_str());
+        } else if (k == "--objects") {
+            opt.objects = std::atoi(v.c_str());
+        } else if (k == "--task-num") {
+            opt.taskNums = parseIntList(v);
+        } else if (k == "--single-stream-only") {
+            opt.singleStreamOnly = v != "0";
+        } else if (k == "--slow-every") {
+            opt.slowEvery = std::atoi(v.c_str());
+        } else if (k == "--slow-kbps") {
+            opt.slowKBps = std::atoll(v.c_str());
+        } else {
+            std::cerr << "unknown option " << k << std::endl;
+            return 1;
+        }
+    }
+
+    MockTosServerOptions serverOptions;
+    serverOptions.latencyMs = opt.latencyMs;
+    serverOptions.bandwidth = opt.bandwidthMbps * 1024 * 1024 / 8;
+    serverOptions.errorRate = opt.errorRate;
+    serverOptions.enableCRC = opt.enableCRC;
+    MockTosServer server(serverOptions);
+    if (!server.start()) {
+        std::cerr << "failed to start mock server" << std::endl;
+        return 1;
+    }
+
+    InitializeClient();
+    {
+        ClientConfig config;
+        config.endPoint = server.endpoint();
+        config.enableCRC = opt.enableCRC;
+        // 通过 HTTP 代理的方式把所有请求发往本地 mock 服务
+        config.proxyHost = "127.0.0.1";
+        config.proxyPort = server.port();
+        config.maxConnections = std::max(opt.threads, 16) * 2;
+        TosClientV2 client("cn-mock", "ak", "sk", config);
+        CreateBucketV2Input createBucket(bucket);
+        client.createBucket(createBucket);
+
+        std::cout << "mock server 127.0.0.1:" << server.port() << ", latency " << opt.latencyMs << " ms, bandwidth "
+                  << (opt.bandwidthMbps > 0 ? std::to_string(opt.bandwidthMbps) + " Mbps" : "unlimited")
+                  << ", error rate " << opt.errorRate << ", crc " << (opt.enableCRC ? "on" : "off") << std::endl;
+        printHeader();
+        benchSingleStream(config, opt);
+        if (!opt.singleStreamOnly) {
+            benchSmallObjects(client, opt);
+            benchObjectCache(config, opt);
+            benchHotKeys(config, server, opt);
+            benchTransfer(client, opt);
+            benchStragglers(config, server, opt);
+            benchDownloadToBuffer(client, opt);
+            benchFileCrc(opt);
+            benchUploadDirectory(client, opt);
+            benchDownloadPrefix(client, opt);
+            benchCopyPrefix(client, opt);
+            benchSyncDirectory(client, opt);
+            benchSequentialRead(client, opt);
+            benchVectoredRead(client, opt);
+            benchList(client, opt);
+        }
+
+        auto stats = server.stats();
+        std::cout << "server requests " << stats.requests << ", injected errors " << stats.injectedErrors
+                  << ", received " << stats.bytesReceived << " B, sent " << stats.bytesSent << " B" << std::endl;
+    }
+    CloseClient();
+    server.stop();
+    return 0;
+}
@@ -0,0 +1,1084 @@
+#include "MockTosServer.h"
+#include "utils/crc64.h"
+#include "json/json.hpp"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cstring>
+#include <ctime>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <random>
+#include <sstream>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace VolcengineTos;
+
+// 当前连接的带宽上限，为 0 时使用全局的 bandwidth，每个连接由单独的线程处理
+static thread_local int64_t connectionBandwidth = 0;
+
+struct MockTosServer::Request {
+    std::string method;
+    std::string bucket;
+    std::string key;
+    std::map<std::string, std::string> queries;
+    // key 统一转为小写
+    std::map<std::string, std::string> headers;
+    std::string body;
+    bool keepAlive = true;
+
+    bool hasQuery(const std::string& k) const {
+        return queries.count(k) > 0;
+    }
+    std::string query(const std::string& k) const {
+        auto it = queries.find(k);
+        return it == queries.end() ? "" : it->second;
+    }
+    std::string header(const std::string& k) const {
+        auto it = headers.find(k);
+        return it == headers.end() ? "" : it->second;
+    }
+};
+
+struct MockTosServer::Response {
+    int status = 200;
+    std::vector<std::pair<std::string, std::string>> headers;
+    // body 与 data 二选一，data 用于直接返回对象内容，避免拷贝
+    std::string body;
+    std::shared_ptr<const std::string> data;
+    size_t dataOffset = 0;
+    size_t dataLength = 0;
+    // HEAD 请求返回 Content-Length 但不返回 body
+    int64_t headContentLength = -1;
+
+    void setHeader(const std::string& k, const std::string& v) {
+        headers.emplace_back(k, v);
+    }
+};
+
+static std::string toLower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), ::tolower);
+    return s;
+}
+
+static std::string urlDecode(const std::string& s) {
+    std::string out;
+    out.reserve(s.size());
+    for (size_t i = 0; i < s.size(); i++) {
+        if (s[i] == '%' && i + 2 < s.size()) {
+            out.push_back(static_cast<char>(std::stoi(s.substr(i + 1, 2), nullptr, 16)));
+            i += 2;
+        } else if (s[i] == '+') {
+            out.push_back(' ');
+        } else {
+            out.push_back(s[i]);
+        }
+    }
+    return out;
+}
+
+static std::string gmtTime(time_t t) {
+    char buf[64];
+    std::tm tm{};
+    gmtime_r(&t, &tm);
+    strftime(buf, sizeof(buf), "%a, %d %b %Y %H:%M:%S GMT", &tm);
+    return buf;
+}
+
+static std::string isoTime(time_t t) {
+    char buf[64];
+    std::tm tm{};
+    gmtime_r(&t, &tm);
+    strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%S.000Z", &tm);
+    return buf;
+}
+
+static uint64_t crcOf(const std::string& data) {
+    return CRC64::CalcCRC(0, const_cast<char*>(data.data()), data.size());
+}
+
+static std::string etagOf(uint64_t crc, size_t size) {
+    std::stringstream ss;
+    ss << "\"" << std::hex << crc << "-" << size << "\"";
+    return ss.str();
+}
+
+static std::string statusText(int status) {
+    switch (status) {
+        case 200:
+            return "OK";
+        case 204:
+            return "No Content";
+        case 206:
+            return "Partial Content";
+        case 304:
+            return "Not Modified";
+        case 400:
+            return "Bad Request";
+        case 404:
+            return "Not Found";
+        case 409:
+            return "Conflict";
+        case 412:
+            return "Precondition Failed";
+        case 416:
+            return "Range Not Satisfiable";
+        case 429:
+            return "Too Many Requests";
+        case 500:
+            return "Internal Server Error";
+        case 501:
+            return "Not Implemented";
+        case 503:
+            return "Service Unavailable";
+        default:
+            return "Unknown";
+    }
+}
+
+static void setError(MockTosServer::Response& resp, int status, const std::string& code, const std::string& message) {
+    resp.status = status;
+    nlohmann::json j;
+    j["Code"] = code;
+    j["Message"] = message;
+    resp.body = j.dump();
+    resp.setHeader("Content-Type", "application/json");
+}
+
+MockTosServer::MockTosServer(const MockTosServerOptions& options)
+        : options_(options),
+          latencyMs_(options.latencyMs),
+          bandwidth_(options.bandwidth),
+          enableCRC_(options.enableCRC),
+          errorRate_(options.errorRate),
+          errorStatus_(options.errorStatus) {
+}
+
+MockTosServer::~MockTosServer() {
+    stop();
+}
+
+bool MockTosServer::start() {
+    listenFd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd_ < 0) {
+        return false;
+    }
+    int on = 1;
+    setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(static_cast<uint16_t>(options_.port));
+    if (bind(listenFd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(listenFd_, 512) != 0) {
+        close(listenFd_);
+        listenFd_ = -1;
+        return false;
+    }
+    socklen_t len = sizeof(addr);
+    getsockname(listenFd_, reinterpret_cast<sockaddr*>(&addr), &len);
+    port_ = ntohs(addr.sin_port);
+    running_ = true;
+    acceptThread_ = std::thread(&MockTosServer::acceptLoop, this);
+    return true;
+}
+
+void MockTosServer::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    shutdown(listenFd_, SHUT_RDWR);
+    close(listenFd_);
+    if (acceptThread_.joinable()) {
+        acceptThread_.join();
+    }
+    std::map<uint64_t, std::thread> threads;
+    {
+        std::lock_guard<std::mutex> lock(connMu_);
+        for (int fd : connFds_) {
+            shutdown(fd, SHUT_RDWR);
+        }
+        threads.swap(connThreads_);
+        finishedConns_.clear();
+    }
+    for (auto& t : threads) {
+        t.second.join();
+    }
+    listenFd_ = -1;
+}
+
+MockTosServerStats MockTosServer::stats() const {
+    MockTosServerStats s;
+    s.requests = requests_.load();
+    s.injectedErrors = injectedErrors_.load();
+    s.bytesReceived = bytesReceived_.load();
+    s.bytesSent = bytesSent_.load();
+    return s;
+}
+
+void MockTosServer::clear() {
+    std::lock_guard<std::mutex> lock(mu_);
+    buckets_.clear();
+    uploads_.clear();
+}
+
+std::string MockTosServer::nextRequestId() {
+    return "mock-" + std::to_string(requestSeq_.fetch_add(1) + 1);
+}
+
+void MockTosServer::acceptLoop() {
+    while (running_) {
+        int fd = accept(listenFd_, nullptr, nullptr);
+        if (fd < 0) {
+            if (!running_) {
+                break;
+            }
+            continue;
+        }
+        int on = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        std::lock_guard<std::mutex> lock(connMu_);
+        int64_t bandwidth = 0;
+        int every = slowEvery_.load();
+        if (every > 0 && ++connectionSeq_ % every == 0) {
+            bandwidth = slowBandwidth_.load();
+        }
+        // 登记后线程不再使用 connMu_，持锁 join 不会死锁
+        for (auto id : finishedConns_) {
+            auto it = connThreads_.find(id);
+            if (it != connThreads_.end()) {
+                it->second.join();
+                connThreads_.erase(it);
+            }
+        }
+        finishedConns_.clear();
+        connFds_.push_back(fd);
+        auto id = ++connectionId_;
+        connThreads_[id] = std::thread(&MockTosServer::serveConnection, this, fd, bandwidth, id);
+    }
+}
+
+void MockTosServer::serveConnection(int fd, int64_t bandwidth, uint64_t id) {
+    connectionBandwidth = bandwidth;
+    std::string buffer;
+    while (running_) {
+        Request req;
+        if (!readRequest(fd, buffer, req)) {
+            break;
+        }
+        requests_++;
+        Response resp;
+        handle(req, resp);
+        resp.setHeader("x-tos-request-id", nextRequestId());
+        if (!writeResponse(fd, req, resp) || !req.keepAlive) {
+            break;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(connMu_);
+        connFds_.erase(std::remove(connFds_.begin(), connFds_.end(), fd), connFds_.end());
+        close(fd);
+        finishedConns_.push_back(id);
+    }
+}
+
+void MockTosServer::throttle(uint64_t bytes, const std::chrono::steady_clock::time_point& start) {
+    int64_t bandwidth = connectionBandwidth > 0 ? connectionBandwidth : bandwidth_.load();
+    if (bandwidth <= 0) {
+        return;
+    }
+    auto expected = start + std::chrono::microseconds(bytes * 1000000 / bandwidth);
+    auto now = std::chrono::steady_clock::now();
+    if (expected > now) {
+        std::this_thread::sleep_for(expected - now);
+    }
+}
+
+bool MockTosServer::readRequest(int fd, std::string& buffer, Request& req) {
+    size_t headerEnd;
+    char chunk[65536];
+    while ((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+        ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) {
+            return false;
+        }
+        buffer.append(chunk, n);
+    }
+    std::string head = buffer.substr(0, headerEnd);
+    buffer.erase(0, headerEnd + 4);
+
+    std::istringstream lines(head);
+    std::string line;
+    std::getline(lines, line);
+    if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
+    }
+    std::istringstream requestLine(line);
+    std::string target, version;
+    requestLine >> req.method >> target >> version;
+    while (std::getline(lines, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        auto pos = line.find(':');
+        if (pos == std::string::npos) {
+            continue;
+        }
+        auto value = line.substr(pos + 1);
+        value.erase(0, value.find_first_not_of(' '));
+        req.headers[toLower(line.substr(0, pos))] = value;
+    }
+    auto connection = toLower(req.header("connection") + req.header("proxy-connection"));
+    req.keepAlive = connection.find("close") == std::string::npos && version != "HTTP/1.0";
+
+    // 代理方式下 target 为绝对 URL
+    std::string host = req.header("host");
+    auto schemePos = target.find("://");
+    if (schemePos != std::string::npos) {
+        auto pathPos = target.find('/', schemePos + 3);
+        host = target.substr(schemePos + 3, pathPos - schemePos - 3);
+        target = pathPos == std::string::npos ? "/" : target.substr(pathPos);
+    }
+    host = host.substr(0, host.find(':'));
+    auto suffix = "." + options_.domain;
+    if (host.size() > suffix.size() && host.compare(host.size() - suffix.size(), suffix.size(), suffix) == 0) {
+        req.bucket = host.substr(0, host.size() - suffix.size());
+    }
+    auto queryPos = target.find('?');
+    std::string path = target.substr(0, queryPos);
+    if (queryPos != std::string::npos) {
+        std::istringstream qs(target.substr(queryPos + 1));
+        std::string kv;
+        while (std::getline(qs, kv, '&')) {
+            auto eq = kv.find('=');
+            if (eq == std::string::npos) {
+                req.queries[urlDecode(kv)] = "";
+            } else {
+                req.queries[urlDecode(kv.substr(0, eq))] = urlDecode(kv.substr(eq + 1));
+            }
+        }
+    }
+    if (path.size() > 1) {
+        req.key = urlDecode(path.substr(1));
+    }
+    return readBody(fd, buffer, req);
+}
+
+bool MockTosServer::readBody(int fd, std::string& buffer, Request& req) {
+    auto start = std::chrono::steady_clock::now();
+    char chunk[65536];
+    if (toLower(req.header("transfer-encoding")).find("chunked") != std::string::npos) {
+        while (true) {
+            size_t lineEnd;
+            while ((lineEnd = buffer.find("\r\n")) == std::string::npos) {
+                ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+                if (n <= 0) {
+                    return false;
+                }
+                buffer.append(chunk, n);
+            }
+            size_t size = std::stoul(buffer.substr(0, lineEnd), nullptr, 16);
+            buffer.erase(0, lineEnd + 2);
+            while (buffer.size() < size + 2) {
+                ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+                if (n <= 0) {
+                    return false;
+                }
+                buffer.append(chunk, n);
+            }
+            req.body.append(buffer, 0, size);
+            buffer.erase(0, size + 2);
+            throttle(req.body.size(), start);
+            if (size == 0) {
+                break;
+            }
+        }
+    } else {
+        auto cl = req.header("content-length");
+        size_t length = cl.empty() ? 0 : std::stoull(cl);
+        req.body.reserve(length);
+        size_t take = std::min(length, buffer.size());
+        req.body.append(buffer, 0, take);
+        buffer.erase(0, take);
+        while (req.body.size() < length) {
+            size_t want = std::min(sizeof(chunk), length - req.body.size());
+            ssize_t n = recv(fd, chunk, want, 0);
+            if (n <= 0) {
+                return false;
+            }
+            req.body.append(chunk, n);
+            throttle(req.body.size(), start);
+        }
+    }
+    bytesReceived_ += req.body.size();
+    return true;
+}
+
+bool MockTosServer::writeAll(int fd, const char* data, size_t len) {
+    while (len > 0) {
+        ssize_t n = send(fd, data, len, MSG_NOSIGNAL);
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        len -= n;
+    }
+    return true;
+}
+
+bool MockTosServer::writeResponse(int fd, const Request& req, const Response& resp) {
+    const char* body = resp.data ? resp.data->data() + resp.dataOffset : resp.body.data();
+    size_t bodyLength = resp.data ? resp.dataLength : resp.body.size();
+    std::stringstream ss;
+    ss << "HTTP/1.1 " << resp.status << " " << statusText(resp.status) << "\r\n";
+    for (const auto& h : resp.headers) {
+        ss << h.first << ": " << h.second << "\r\n";
+    }
+    if (req.method == "HEAD") {
+        ss << "Content-Length: " << (resp.headContentLength >= 0 ? resp.headContentLength : 0) << "\r\n";
+        bodyLength = 0;
+    } else {
+        ss << "Content-Length: " << bodyLength << "\r\n";
+    }
+    ss << "Connection: " << (req.keepAlive ? "keep-alive" : "close") << "\r\n\r\n";
+    auto head = ss.str();
+    if (!writeAll(fd, head.data(), head.size())) {
+        return false;
+    }
+    // 按 64KB 分块发送，便于限速
+    auto start = std::chrono::steady_clock::now();
+    size_t sent = 0;
+    while (sent < bodyLength) {
+        size_t n = std::min<size_t>(65536, bodyLength - sent);
+        if (!writeAll(fd, body + sent, n)) {
+            return false;
+        }
+        sent += n;
+        throttle(sent, start);
+    }
+    bytesSent_ += bodyLength;
+    return true;
+}
+
+void MockTosServer::handle(const Request& req, Response& resp) {
+    int latency = latencyMs_.load();
+    if (latency > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(latency));
+    }
+    double errorRate;
+    int errorStatus;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        errorRate = errorRate_;
+        errorStatus = errorStatus_;
+    }
+    if (errorRate > 0) {
+        static thread_local std::mt19937 gen(std::random_device{}());
+        std::uniform_real_distribution<double> dist(0, 1);
+        if (dist(gen) < errorRate) {
+            injectedErrors_++;
+            setError(resp, errorStatus, "InjectedError", "error injected by mock server");
+            return;
+        }
+    }
+    if (req.bucket.empty()) {
+        setError(resp, 501, "NotImplemented", "bucket is required");
+        return;
+    }
+    const auto& m = req.method;
+    if (req.key.empty()) {
+        if (m == "PUT") {
+            std::lock_guard<std::mutex> lock(mu_);
+            buckets_[req.bucket];
+        } else if (m == "HEAD") {
+            std::lock_guard<std::mutex> lock(mu_);
+            if (buckets_.count(req.bucket) == 0) {
+                resp.status = 404;
+                return;
+            }
+            resp.setHeader("x-tos-bucket-region", "mock");
+        } else if (m == "DELETE") {
+            std::lock_guard<std::mutex> lock(mu_);
+            buckets_.erase(req.bucket);
+            resp.status = 204;
+        } else if (m == "GET" && req.query("list-type") == "2") {
+            listObjectsType2(req, resp);
+        } else if (m == "POST" && req.hasQuery("delete")) {
+            deleteMultiObjects(req, resp);
+        } else {
+            setError(resp, 501, "NotImplemented", "unsupported bucket operation");
+        }
+        return;
+    }
+    if (m == "PUT") {
+        bool copy = !req.header("x-tos-copy-source").empty();
+        if (req.hasQuery("uploadId") && req.hasQuery("partNumber")) {
+            if (copy) {
+                uploadPartCopy(req, resp);
+            } else {
+                uploadPart(req, resp);
+            }
+        } else if (copy) {
+            copyObject(req, resp);
+        } else {
+            putObject(req, resp);
+        }
+    } else if (m == "POST") {
+        if (req.hasQuery("uploads")) {
+            createMultipartUpload(req, resp);
+        } else if (req.hasQuery("uploadId")) {
+            completeMultipartUpload(req, resp);
+        } else if (req.hasQuery("append")) {
+            appendObject(req, resp);
+        } else {
+            setError(resp, 501, "NotImplemented", "unsupported object operation");
+        }
+    } else if (m == "GET") {
+        if (req.hasQuery("uploadId")) {
+            listParts(req, resp);
+        } else {
+            getObject(req, resp, false);
+        }
+    } else if (m == "HEAD") {
+        getObject(req, resp, true);
+    } else if (m == "DELETE") {
+        if (req.hasQuery("uploadId")) {
+            abortMultipartUpload(req, resp);
+        } else {
+            deleteObject(req, resp);
+        }
+    } else {
+        setError(resp, 501, "NotImplemented", "unsupported method");
+    }
+}
+
+static std::map<std::string, std::string> userMeta(const MockTosServer::Request& req) {
+    std::map<std::string, std::string> meta;
+    for (const auto& h : req.headers) {
+        if (h.first.compare(0, 11, "x-tos-meta-") == 0) {
+            meta[h.first] = h.second;
+        }
+    }
+    return meta;
+}
+
+void MockTosServer::setObjectHeaders(const Object& object, Response& resp) {
+    resp.setHeader("ETag", object.etag);
+    resp.setHeader("Last-Modified", gmtTime(object.lastModified));
+    resp.setHeader("Content-Type", object.contentType.empty() ? "binary/octet-stream" : object.contentType);
+    resp.setHeader("x-tos-storage-class", "STANDARD");
+    if (object.appendable) {
+        resp.setHeader("x-tos-object-type", "Appendable");
+    }
+    if (enableCRC_) {
+        resp.setHeader("x-tos-hash-crc64ecma", std::to_string(object.crc));
+    }
+    for (const auto& kv : object.meta) {
+        resp.setHeader(kv.first, kv.second);
+    }
+}
+
+void MockTosServer::putObject(const Request& req, Response& resp) {
+    Object object;
+    object.crc = crcOf(req.body);
+    object.etag = etagOf(object.crc, req.body.size());
+    object.data = std::make_shared<const std::string>(req.body);
+    object.contentType = req.header("content-type");
+    object.meta = userMeta(req);
+    object.lastModified = time(nullptr);
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        buckets_[req.bucket][req.key] = object;
+    }
+    resp.setHeader("ETag", object.etag);
+    if (enableCRC_) {
+        resp.setHeader("x-tos-hash-crc64ecma", std::to_string(object.crc));
+    }
+}
+
+void MockTosServer::getObject(const Request& req, Response& resp, bool headOnly) {
+    Object object;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        auto b = buckets_.find(req.bucket);
+        if (b == buckets_.end()) {
+            setError(resp, 404, "NoSuchBucket", "the specified bucket does not exist");
+            return;
+        }
+        auto o = b->second.find(req.key);
+        if (o == b->second.end()) {
+            setError(resp, 404, "NoSuchKey", "the specified key does not exist");
+            return;
+        }
+        object = o->second;
+    }
+    auto ifMatch = req.header("if-match");
+    if (!ifMatch.empty() && ifMatch != object.etag) {
+        setError(resp, 412, "PreconditionFailed", "etag mismatch");
+        return;
+    }
+    auto ifNoneMatch = req.header("if-none-match");
+    if (!ifNoneMatch.empty() && ifNoneMatch == object.etag) {
+        resp.status = 304;
+        resp.setHeader("ETag", object.etag);
+        return;
+    }
+    size_t size = object.data->size();
+    size_t begin = 0;
+    size_t end = size == 0 ? 0 : size - 1;
+    auto range = req.header("range");
+    bool partial = false;
+    if (range.compare(0, 6, "bytes=") == 0 && size > 0) {
+        auto spec = range.substr(6);
+        auto dash = spec.find('-');
+        std::string first = spec.substr(0, dash);
+        std::string last = dash == std::string::npos ? "" : spec.substr(dash + 1);
+        if (first.empty() && !last.empty()) {
+            size_t suffix = std::min<size_t>(std::stoull(last), size);
+            begin = size - suffix;
+        } else if (!first.empty()) {
+            begin = std::stoull(first);
+            if (!last.empty()) {
+                end = std::min<size_t>(std::stoull(last), size - 1);
+            }
+        }
+        if (begin >= size || begin > end) {
+            setError(resp, 416, "InvalidRange", "the requested range is not satisfiable");
+            return;
+        }
+        partial = true;
+    }
+    setObjectHeaders(object, resp);
+    if (partial) {
+        resp.status = 206;
+        resp.setHeader("Content-Range",
+                       "bytes " + std::to_string(begin) + "-" + std::to_string(end) + "/" + std::to_string(size));
+    }
+    size_t length = size == 0 ? 0 : end - begin + 1;
+    if (headOnly) {
+        resp.headContentLength = static_cast<int64_t>(length);
+        return;
+    }
+    resp.data = object.data;
+    resp.dataOffset = begin;
+    resp.dataLength = length;
+}
+
+void MockTosServer::deleteObject(const Request& req, Response& resp) {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto b = buckets_.find(req.bucket);
+    if (b != buckets_.end()) {
+        b->second.erase(req.key);
+    }
+    resp.status = 204;
+}
+
+void MockTosServer::appendObject(const Request& req, Response& resp) {
+    uint64_t offset = std::stoull(req.query("offset").empty() ? "0" : req.query("offset"));
+    std::lock_guard<std::mutex> lock(mu_);
+    auto& bucket = buckets_[req.bucket];
+    auto it = bucket.find(req.key);
+    if (it == bucket.end()) {
+        if (offset != 0) {
+            setError(resp, 409, "PositionNotEqualToLength", "offset is not equal to object length");
+            return;
+        }
+        Object object;
+        object.data = std::make_shared<const std::string>();
+        object.contentType = req.header("content-type");
+        object.meta = userMeta(req);
+        object.appendable = true;
+        it = bucket.emplace(req.key, object).first;
+    }
+    auto& object = it->second;
+    if (!object.appendable) {
+        setError(resp, 409, "ObjectNotAppendable", "the object is not appendable");
+        return;
+    }
+    if (offset != object.data->size()) {
+        setError(resp, 409, "PositionNotEqualToLength", "offset is not equal to object length");
+        return;
+    }
+    // 旧的 data 可能正在被其他连接发送，追加时生成新的副本
+    auto data = std::make_shared<std::string>(*object.data);
+    data->append(req.body);
+    object.crc = CRC64::CombineCRC(object.crc, crcOf(req.body), req.body.size());
+    object.data = data;
+    object.etag = etagOf(object.crc, data->size());
+    object.lastModified = time(nullptr);
+    resp.setHeader("x-tos-next-append-offset", std::to_string(data->size()));
+    if (enableCRC_) {
+        resp.setHeader("x-tos-hash-crc64ecma", std::to_string(object.crc));
+    }
+    if (lostAppendRate_ > 0) {
+        static thread_local std::mt19937 gen(std::random_device{}());
+        std::uniform_real_distribution<double> dist(0, 1);
+        if (dist(gen) < lostAppendRate_) {
+            injectedErrors_++;
+            resp = Response();
+            setError(resp, 503, "InjectedError", "append took effect but the response is lost");
+        }
+    }
+}
+
+void MockTosServer::createMultipartUpload(const Request& req, Response& resp) {
+    std::string uploadId;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        uploadId = "upload-" + std::to_string(++uploadSeq_);
+        Upload upload;
+        upload.bucket = req.bucket;
+        upload.key = req.key;
+        upload.contentType = req.header("content-type");
+        upload.meta = userMeta(req);
+        uploads_[uploadId] = upload;
+    }
+    nlohmann::json j;
+    j["Bucket"] = req.bucket;
+    j["Key"] = req.key;
+    j["UploadId"] = uploadId;
+    resp.body = j.dump();
+    resp.setHeader("Content-Type", "application/json");
+}
+
+void MockTosServer::uploadPart(const Request& req, Response& resp) {
+    int partNumber = std::atoi(req.query("partNumber").c_str());
+    Part part;
+    part.crc = crcOf(req.body);
+    part.etag = etagOf(part.crc, req.body.size());
+    part.data = req.body;
+    part.lastModified = time(nullptr);
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        auto it = uploads_.find(req.query("uploadId"));
+        if (it == uploads_.end()) {
+            setError(resp, 404, "NoSuchUpload", "the specified upload does not exist");
+            return;
+        }
+        it->second.parts[partNumber] = std::move(part);
+        resp.setHeader("ETag", it->second.parts[partNumber].etag);
+        if (enableCRC_) {
+            resp.setHeader("x-tos-hash-crc64ecma", std::to_string(it->second.parts[partNumber].crc));
+        }
+    }
+}
+
+// x-tos-copy-source 格式为 /bucket/key，key 经过 URL 编码
+bool MockTosServer::findCopySource(const Request& req, Response& resp, Object& object) {
+    auto source = req.header("x-tos-copy-source");
+    auto query = source.find('?');
+    if (query != std::string::npos) {
+        source = source.substr(0, query);
+    }
+    if (!source.empty() && source.front() == '/') {
+        source.erase(0, 1);
+    }
+    auto slash = source.find('/');
+    if (slash == std::string::npos) {
+        setError(resp, 400, "InvalidArgument", "invalid copy source");
+        return false;
+    }
+    auto bucket = source.substr(0, slash);
+    auto key = urlDecode(source.substr(slash + 1));
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        auto b = buckets_.find(bucket);
+        if (b == buckets_.end() || b->second.count(key) == 0) {
+            setError(resp, 404, "NoSuchKey", "the specified copy source does not exist");
+            return false;
+        }
+        object = b->second[key];
+    }
+    auto ifMatch = req.header("x-tos-copy-source-if-match");
+    if (!ifMatch.empty() && ifMatch != object.etag) {
+        setError(resp, 412, "PreconditionFailed", "copy source etag mismatch");
+        return false;
+    }
+    return true;
+}
+
+void MockTosServer::copyObject(const Request& req, Response& resp) {
+    Object object;
+    if (!findCopySource(req, resp, object)) {
+        return;
+    }
+    if (toLower(req.header("x-tos-metadata-directive")) == "replace") {
+        object.contentType = req.header("content-type");
+        object.meta = userMeta(req);
+    }
+    object.appendable = false;
+    object.lastModified = time(nullptr);
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        buckets_[req.bucket][req.key] = object;
+    }
+    nlohmann::json j;
+    j["ETag"] = object.etag;
+    j["LastModified"] = isoTime(object.lastModified);
+    resp.body = j.dump();
+    resp.setHeader("Content-Type", "application/json");
+}
+
+// 复制的分片不返回 CRC64，与服务端行为一致
+void MockTosServer::uploadPartCopy(const Request& req, Response& resp) {
+    Object object;
+    if (!findCopySource(req, resp, object)) {
+        return;
+    }
+    size_t size = object.data->size();
+    size_t begin = 0;
+    size_t end = size == 0 ? 0 : size - 1;
+    auto range = req.header("x-tos-copy-source-range");
+    if (range.compare(0, 6, "bytes=") == 0) {
+        auto spec = range.substr(6);
+        auto dash = spec.find('-');
+        if (dash == std::string::npos || dash == 0 || dash + 1 == spec.size()) {
+            setError(resp, 400, "InvalidArgument", "invalid copy source range");
+            return;
+        }
+        begin = std::stoull(spec.substr(0, dash));
+        end = std::stoull(spec.substr(dash + 1));
+        if (begin >= size || begin > end || end >= size) {
+            setError(resp, 416, "InvalidRange", "the requested range is not satisfiable");
+            return;
+        }
+    }
+    int partNumber = std::atoi(req.query("partNumber").c_str());
+    Part part;
+    part.data = size == 0 ? std::string() : object.data->substr(begin, end - begin + 1);
+    part.crc = crcOf(part.data);
+    part.etag = etagOf(part.crc, part.data.size());
+    part.lastModified = time(nullptr);
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        auto it = uploads_.find(req.query("uploadId"));
+        if (it == uploads_.end()) {
+            setError(resp, 404, "NoSuchUpload", "the specified upload does not exist");
+            return;
+        }
+        it->second.parts[partNumber] = part;
+    }
+    nlohmann::json j;
+    j["ETag"] = part.etag;
+    j["LastModified"] = isoTime(part.lastModified);
+    resp.body = j.dump();
+    resp.setHeader("Content-Type", "application/json");
+}
+
+void MockTosServer::completeMultipartUpload(const Request& req, Response& resp) {
+    std::vector<int> partNumbers;
+    bool completeAll = toLower(req.header("x-tos-complete-all")) == "yes";
+    std::map<int, std::string> etags;
+    if (!completeAll) {
+        auto j = nlohmann::json::parse(req.body, nullptr, false);
+        if (j.is_discarded() || !j.contains("Parts")) {
+            setError(resp, 400, "MalformedJSON", "invalid complete multipart upload body");
+            return;
+        }
+        for (const auto& p : j.at("Parts")) {
+            int number = p.contains("PartNumber") ? p.at("PartNumber").get<int>() : 0;
+            partNumbers.push_back(number);
+            etags[number] = p.contains("ETag") ? p.at("ETag").get<std::string>() : "";
+        }
+    }
+    Object object;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        auto it = uploads_.find(req.query("uploadId"));
+        if (it == uploads_.end()) {
+            setError(resp, 404, "NoSuchUpload", "the specified upload does not exist");
+            return;
+        }
+        auto& upload = it->second;
+        if (completeAll) {
+            for (const auto& p : upload.parts) {
+                partNumbers.push_back(p.first);
+            }
+        }
+        auto data = std::make_shared<std::string>();
+        for (int number : partNumbers) {
+            auto p = upload.parts.find(number);
+            if (p == upload.parts.end() || (!completeAll && etags[number] != p->second.etag)) {
+                setError(resp, 400, "InvalidPart", "part " + std::to_string(number) + " is invalid");
+                return;
+            }
+            object.crc = CRC64::CombineCRC(object.crc, p->second.crc, p->second.data.size());
+            data->append(p->second.data);
+        }
+        object.data = data;
+        object.etag = etagOf(object.crc, data->size());
+        object.contentType = upload.contentType;
+        object.meta = upload.meta;
+        object.lastModified = time(nullptr);
+        buckets_[upload.bucket][upload.key] = object;
+        uploads_.erase(it);
+    }
+    nlohmann::json j;
+    j["Bucket"] = req.bucket;
+    j["Key"] = req.key;
+    j["ETag"] = object.etag;
+    j["Location"] = "http://" + req.bucket + "." + options_.domain + "/" + req.key;
+    resp.body = j.dump();
+    resp.setHeader("Content-Type", "application/json");
+    resp.setHeader("ETag", object.etag);
+    if (enableCRC_) {
+        resp.setHeader("x-tos-hash-crc64ecma", std::to_string(object.crc));
+    }
+}
+
+void MockTosServer::abortMultipartUpload(const Request& req, Response& resp) {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (uploads_.erase(req.query("uploadId")) == 0) {
+        setError(resp, 404, "NoSuchUpload", "the specified upload does not exist");
+        return;
+    }
+    resp.status = 204;
+}
+
+void MockTosServer::listParts(const Request& req, Response& resp) {
+    nlohmann::json j;
+    nlohmann::json parts = nlohmann::json::array();
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        auto it = uploads_.find(req.query("uploadId"));
+        if (it == uploads_.end()) {
+            setError(resp, 404, "NoSuchUpload", "the specified upload does not exist");
+            return;
+        }
+        for (const auto& p : it->second.parts) {
+            nlohmann::json part;
+            part["PartNumber"] = p.first;
+            part["ETag"] = p.second.etag;
+            part["Size"] = p.second.data.size();
+            part["LastModified"] = isoTime(p.second.lastModified);
+            parts.push_back(part);
+        }
+    }
+    j["Bucket"] = req.bucket;
+    j["Key"] = req.key;
+    j["UploadId"] = req.query("uploadId");
+    j["IsTruncated"] = false;
+    j["Parts"] = parts;
+    resp.body = j.dump();
+    resp.setHeader("Content-Type", "application/json");
+}
+
+void MockTosServer::listObjectsType2(const Request& req, Response& resp) {
+    auto prefix = req.query("prefix");
+    auto delimiter = req.query("delimiter");
+    auto token = req.query("continuation-token");
+    auto startAfter = req.query("start-after");
+    int maxKeys = req.query("max-keys").empty() ? 1000 : std::atoi(req.query("max-keys").c_str());
+    if (maxKeys <= 0 || maxKeys > 1000) {
+        maxKeys = 1000;
+    }
+    std::string marker = token.empty() ? startAfter : token;
+
+    nlohmann::json contents = nlohmann::json::array();
+    nlohmann::json commonPrefixes = nlohmann::json::array();
+    std::string lastPrefix;
+    std::string nextToken;
+    int count = 0;
+    bool truncated = false;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        auto b = buckets_.find(req.bucket);
+        if (b == buckets_.end()) {
+            setError(resp, 404, "NoSuchBucket", "the specified bucket does not exist");
+            return;
+        }
+        auto it = marker.empty() ? b->second.lower_bound(prefix) : b->second.upper_bound(marker);
+        for (; it != b->second.end(); ++it) {
+            const auto& key = it->first;
+            if (key.compare(0, prefix.size(), prefix) != 0) {
+                if (key > prefix) {
+                    break;
+                }
+                continue;
+            }
+            // 上一页以公共前缀结尾时，跳过该前缀下的所有 key
+            if (!marker.empty() && !delimiter.empty() && marker.size() >= delimiter.size() &&
+                marker.compare(marker.size() - delimiter.size(), delimiter.size(), delimiter) == 0 &&
+                key.compare(0, marker.size(), marker) == 0) {
+                continue;
+            }
+            std::string commonPrefix;
+            if (!delimiter.empty()) {
+                auto pos = key.find(delimiter, prefix.size());
+                if (pos != std::string::npos) {
+                    commonPrefix = key.substr(0, pos + delimiter.size());
+                }
+            }
+            if (!commonPrefix.empty() && commonPrefix == lastPrefix) {
+                continue;
+            }
+            if (count == maxKeys) {
+                truncated = true;
+                break;
+            }
+            if (!commonPrefix.empty()) {
+                nlohmann::json cp;
+                cp["Prefix"] = commonPrefix;
+                commonPrefixes.push_back(cp);
+                lastPrefix = commonPrefix;
+                nextToken = commonPrefix;
+            } else {
+                nlohmann::json o;
+                o["Key"] = key;
+                o["LastModified"] = isoTime(it->second.lastModified);
+                o["ETag"] = it->second.etag;
+                o["Size"] = it->second.data->size();
+                o["StorageClass"] = "STANDARD";
+                if (enableCRC_) {
+                    o["HashCrc64ecma"] = std::to_string(it->second.crc);
+                }
+                contents.push_back(o);
+                nextToken = key;
+            }
+            count++;
+        }
+    }
+    nlohmann::json j;
+    j["Name"] = req.bucket;
+    j["Prefix"] = prefix;
+    j["StartAfter"] = startAfter;
+    j["ContinuationToken"] = token;
+    j["MaxKeys"] = maxKeys;
+    j["Delimiter"] = delimiter;
+    j["KeyCount"] = count;
+    j["IsTruncated"] = truncated;
+    if (truncated) {
+        j["NextContinuationToken"] = nextToken;
+    }
+    j["Contents"] = contents;
+    j["CommonPrefixes"] = commonPrefixes;
+    resp.body = j.dump();
+    resp.setHeader("Content-Type", "application/json");
+}
+
+void MockTosServer::deleteMultiObjects(const Request& req, Response& resp) {
+    auto j = nlohmann::json::parse(req.body, nullptr, false);
+    if (j.is_discarded() || !j.contains("Objects")) {
+        setError(resp, 400, "MalformedJSON", "invalid delete multi objects body");
+        return;
+    }
+    bool quiet = j.contains("Quiet") && j.at("Quiet").get<bool>();
+    nlohmann::json deleted = nlohmann::json::array();
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        auto& bucket = buckets_[req.bucket];
+        for (const auto& o : j.at("Objects")) {
+            auto key = o.contains("Key") ? o.at("Key").get<std::string>() : "";
+            bucket.erase(key);
+            if (!quiet) {
+                nlohmann::json d;
+                d["Key"] = key;
+                deleted.push_back(d);
+            }
+        }
+    }
+    nlohmann::json out;
+    out["Deleted"] = deleted;
+    out["Error"] = nlohmann::json::array();
+    resp.body = out.dump();
+    resp.setHeader("Content-Type", "application/json");
+}
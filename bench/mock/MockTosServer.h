@@ -0,0 +1,176 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace VolcengineTos {
+
+// 本地 TOS 模拟服务的配置
+struct MockTosServerOptions {
+    // 监听端口，0 表示由系统分配
+    int port = 0;
+    // 虚拟域名，请求的 Host 为 bucket.domain
+    std::string domain = "tos-mock.local";
+    // 每个请求额外增加的延迟
+    int latencyMs = 0;
+    // 每个连接的收发带宽上限，单位 byte/s，0 表示不限制
+    int64_t bandwidth = 0;
+    // 以 errorRate 的概率返回 errorStatus
+    double errorRate = 0;
+    int errorStatus = 503;
+    // 是否返回 x-tos-hash-crc64ecma
+    bool enableCRC = true;
+};
+
+struct MockTosServerStats {
+    uint64_t requests = 0;
+    uint64_t injectedErrors = 0;
+    uint64_t bytesReceived = 0;
+    uint64_t bytesSent = 0;
+};
+
+// 进程内的 TOS 兼容 HTTP 服务，监听 127.0.0.1，按 HTTP 代理方式接收请求，
+// 因此客户端 endpoint 使用 domain，并把 proxyHost/proxyPort 指向本服务。
+// 支持 put/get(range)/head/delete、分片上传、listObjectsType2、deleteMultiObjects、appendObject。
+class MockTosServer {
+public:
+    explicit MockTosServer(const MockTosServerOptions& options = MockTosServerOptions());
+    ~MockTosServer();
+
+    bool start();
+    void stop();
+
+    int port() const {
+        return port_;
+    }
+    std::string endpoint() const {
+        return "http://" + options_.domain;
+    }
+
+    void setLatencyMs(int latencyMs) {
+        latencyMs_ = latencyMs;
+    }
+    void setBandwidth(int64_t bandwidth) {
+        bandwidth_ = bandwidth;
+    }
+    void setErrorInjection(double errorRate, int errorStatus) {
+        std::lock_guard<std::mutex> lock(mu_);
+        errorRate_ = errorRate;
+        errorStatus_ = errorStatus;
+    }
+    // 每 every 个新连接中有一个的收发带宽限制为 bandwidth，模拟个别落后的连接，every 为 0 时关闭
+    void setSlowConnections(int every, int64_t bandwidth) {
+        slowEvery_ = every;
+        slowBandwidth_ = bandwidth;
+    }
+    // 追加生效后以 errorRate 的概率仍返回 503，模拟响应丢失导致结果不确定的追加
+    void setLostAppendRate(double errorRate) {
+        std::lock_guard<std::mutex> lock(mu_);
+        lostAppendRate_ = errorRate;
+    }
+    void setEnableCRC(bool enableCRC) {
+        enableCRC_ = enableCRC;
+    }
+
+    MockTosServerStats stats() const;
+    // 清空所有桶和对象
+    void clear();
+
+    struct Request;
+    struct Response;
+
+private:
+    struct Object {
+        std::shared_ptr<const std::string> data;
+        uint64_t crc = 0;
+        std::string etag;
+        std::string contentType;
+        std::map<std::string, std::string> meta;
+        time_t lastModified = 0;
+        bool appendable = false;
+    };
+    struct Part {
+        std::string data;
+        uint64_t crc = 0;
+        std::string etag;
+        time_t lastModified = 0;
+    };
+    struct Upload {
+        std::string bucket;
+        std::string key;
+        std::string contentType;
+        std::map<std::string, std::string> meta;
+        std::map<int, Part> parts;
+    };
+    typedef std::map<std::string, Object> Bucket;
+
+    void acceptLoop();
+    void serveConnection(int fd, int64_t bandwidth, uint64_t id);
+    bool readRequest(int fd, std::string& buffer, Request& req);
+    bool readBody(int fd, std::string& buffer, Request& req);
+    bool writeAll(int fd, const char* data, size_t len);
+    bool writeResponse(int fd, const Request& req, const Response& resp);
+    void throttle(uint64_t bytes, const std::chrono::steady_clock::time_point& start);
+
+    void handle(const Request& req, Response& resp);
+    void putObject(const Request& req, Response& resp);
+    void getObject(const Request& req, Response& resp, bool headOnly);
+    void deleteObject(const Request& req, Response& resp);
+    void appendObject(const Request& req, Response& resp);
+    void createMultipartUpload(const Request& req, Response& resp);
+    void uploadPart(const Request& req, Response& resp);
+    void copyObject(const Request& req, Response& resp);
+    void uploadPartCopy(const Request& req, Response& resp);
+    bool findCopySource(const Request& req, Response& resp, Object& object);
+    void completeMultipartUpload(const Request& req, Response& resp);
+    void abortMultipartUpload(const Request& req, Response& resp);
+    void listParts(const Request& req, Response& resp);
+    void listObjectsType2(const Request& req, Response& resp);
+    void deleteMultiObjects(const Request& req, Response& resp);
+
+    void setObjectHeaders(const Object& object, Response& resp);
+    std::string nextRequestId();
+
+private:
+    MockTosServerOptions options_;
+    std::atomic<int> latencyMs_;
+    std::atomic<int64_t> bandwidth_;
+    std::atomic<bool> enableCRC_;
+    double errorRate_;
+    int errorStatus_;
+    double lostAppendRate_ = 0;
+
+    int listenFd_ = -1;
+    int port_ = 0;
+    std::atomic<bool> running_{false};
+    std::thread acceptThread_;
+    std::mutex connMu_;
+    std::vector<int> connFds_;
+    // 连接线程按编号保存，结束的线程登记到 finishedConns_，由 acceptLoop 在接受新连接时回收
+    std::map<uint64_t, std::thread> connThreads_;
+    std::vector<uint64_t> finishedConns_;
+    uint64_t connectionId_ = 0;
+
+    mutable std::mutex mu_;
+    std::map<std::string, Bucket> buckets_;
+    std::map<std::string, Upload> uploads_;
+    uint64_t uploadSeq_ = 0;
+
+    std::atomic<int> slowEvery_{0};
+    std::atomic<int64_t> slowBandwidth_{0};
+    uint64_t connectionSeq_ = 0;
+
+    std::atomic<uint64_t> requestSeq_{0};
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> injectedErrors_{0};
+    std::atomic<uint64_t> bytesReceived_{0};
+    std::atomic<uint64_t> bytesSent_{0};
+};
+}  // namespace VolcengineTos
@@ -0,0 +1,25 @@
+#!/usr/bin/env bash
+# 用 netem 给 loopback 增加时延，在不同 RTT 下运行单连接吞吐测试，需要 root 权限与 iproute2。
+# 用法: sudo bench/netem_rtt.sh <ve-tos-cpp-sdk-bench 路径> [RTT 列表(ms)，默认 "0 10 50 100"] [对象大小(MB)，默认 256]
+# 内核对 SO_SNDBUF/SO_RCVBUF 的上限为 net.core.wmem_max/rmem_max，对比 tuned 结果前可先调大:
+#   sysctl -w net.core.wmem_max=33554432 net.core.rmem_max=33554432
+set -euo pipefail
+
+BENCH=${1:?usage: $0 <bench binary> [rtt list in ms] [file mb]}
+RTTS=${2:-"0 10 50 100"}
+FILE_MB=${3:-256}
+
+cleanup() {
+    tc qdisc del dev lo root 2>/dev/null || true
+}
+trap cleanup EXIT
+
+for rtt in $RTTS; do
+    cleanup
+    if [ "$rtt" -gt 0 ]; then
+        # 请求与响应各经过一次 lo，单向时延取 RTT 的一半
+        tc qdisc add dev lo root netem delay "$((rtt / 2))ms" limit 100000
+    fi
+    echo "=== RTT ${rtt} ms ==="
+    "$BENCH" --single-stream-only 1 --file-mb "$FILE_MB"
+done
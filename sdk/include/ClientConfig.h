@@ -1,6 +1,11 @@
 #pragma once
 #include "common/Common.h"
+#include "cache/ObjectCache.h"
+#include "cache/ObjectMetaCache.h"
+#include "transfer/PartRetryQueue.h"
+#include "transfer/StragglerDetector.h"
 #include <string>
+#include <vector>
 
 namespace VolcengineTos {
 class ClientConfig {
@@ -35,6 +40,63 @@ public:
     int socketTimeout;
     int maxConnections;
     bool isCustomDomain = false;
+    // 客户端对象缓存，默认关闭，开启后 getObject/getObjectToFile 的普通读会优先使用缓存
+    bool enableObjectCache = false;
+    ObjectCacheOptions objectCacheOptions;
+    // headObject 元数据缓存，默认关闭，本 client 的写操作会使对应对象的缓存失效
+    bool enableObjectMetaCache = false;
+    ObjectMetaCacheOptions objectMetaCacheOptions;
+    // 合并并发的相同 headObject/getObject 请求，只发出一次请求，默认关闭
+    bool enableRequestCoalescing = false;
+    // 解析 endpoint 的全部 A/AAAA 地址，新连接在健康地址间分散，建连失败的地址暂时剔除，默认关闭。
+    // 解析结果的缓存时间取 dnsCacheTime，为 0 时为 1 分钟；设置代理时不生效
+    bool enableDnsLoadBalance = false;
+    // 可替代 endPoint 的其他 endpoint，例如 VPC 内同时配置内网（ivolces）与公网 endpoint，按顺序排在 endPoint 之后。
+    // 请求建连失败时立即切换到下一个 endpoint 重试，并按实际访问的 host 重新签名；自定义域名时不生效
+    std::vector<std::string> failoverEndpoints;
+    // 大于 0 时配合 failoverEndpoints，后台每隔 endpointProbeInterval 秒探测各 endpoint 的耗时，
+    // 新请求发往最快的健康 endpoint；为 0 时按配置顺序优先使用靠前的 endpoint
+    int endpointProbeInterval = 0;
+
+    // 以下传输参数的时间单位为秒，0 表示不限制或使用默认值
+    // TCP 建连与 TLS 握手的超时，建连阶段的总耗时不超过 connectionTimeout 与 dialTimeout + tlsHandshakeTimeout 中的较小者
+    int dialTimeout = 10;
+    int tlsHandshakeTimeout = 10;
+    // 请求发送完成后（无请求体时从请求开始）等待响应头的超时
+    int responseHeaderTimeout = 0;
+    // 收到响应头后连续没有收到数据、发送请求体时连续没有发出数据的超时
+    int readTimeout = 0;
+    int writeTimeout = 0;
+    // TCP keepalive：连接空闲 tcpKeepAlive 秒后开始探测，探测间隔与次数为 0 时使用 libcurl/系统默认值
+    int tcpKeepAlive = 30;
+    int tcpKeepAliveInterval = 0;
+    int tcpKeepAliveCount = 0;
+    // 连接池中最多保留的空闲连接数，超出时归还的连接直接关闭
+    int maxIdleConnections = 128;
+    // 空闲超过该时间的连接不再复用，0 时使用 libcurl 的默认值（118 秒）
+    int idleConnectionTimeout = 0;
+    // 以下缓冲区单位为字节，0 表示使用默认值。高带宽、高时延的链路上适当调大可以提升单连接吞吐。
+    // libcurl 的接收缓冲区（CURLOPT_BUFFERSIZE，默认 16KB，最大 10MB）与上传缓冲区（CURLOPT_UPLOAD_BUFFERSIZE，默认 64KB，最大 2MB）
+    int receiveBufferSize = 0;
+    int uploadBufferSize = 0;
+    // socket 的 SO_SNDBUF/SO_RCVBUF，设置后内核不再自动调整，且受 net.core.wmem_max/rmem_max 限制
+    int socketSendBufferSize = 0;
+    int socketReceiveBufferSize = 0;
+    // uploadFile/downloadFile 分片并发传输时监控各分片请求的吞吐，明显慢于中位数的分片请求中止后在新连接上重传，
+    // 下载临近结束时为预计最晚完成的分片发起重复请求，默认关闭
+    bool enableStragglerDetection = false;
+    StragglerOptions stragglerOptions;
+    // uploadFile/downloadFile/resumableCopyObject 中失败的分片在本次调用内按退避时间重新排队并在新连接上重传，
+    // 用尽重试次数后才报告该分片失败
+    PartRetryOptions partRetryOptions;
+    // putObjectFromFile 上传不小于 multipartThreshold 字节的文件时改为分片并发上传（对象的 ETag 为分片上传格式），
+    // getObjectToFile 下载不小于 parallelGetThreshold 字节的对象时改为分段并发下载，0 表示关闭。
+    // getObjectToFile 先以 parallelPartSize 为范围读取第一个分段，由响应的 Content-Range 得到对象大小，不额外发送 HEAD
+    int64_t multipartThreshold = 64 * 1024 * 1024;
+    int64_t parallelGetThreshold = 64 * 1024 * 1024;
+    // 自动并发传输的分片大小与并发数，分片数超过 10000 时自动调大分片
+    int64_t parallelPartSize = 16 * 1024 * 1024;
+    int parallelTaskNum = 8;
     // int MaxConnections;
     // int IdleConnectionTime;
 };
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <type_traits>
+#include <utility>
+
 namespace VolcengineTos {
 template <typename E, typename R>
 class Outcome {
@@ -10,8 +13,15 @@ public:
     }
     explicit Outcome(const R& r) : success_(true), r_(r) {
     }
+    explicit Outcome(R&& r) : success_(true), r_(std::move(r)) {
+    }
     Outcome(const Outcome& other) : success_(other.success_), e_(other.e_), r_(other.r_) {
     }
+    // 移动不抛异常时声明 noexcept，vector<Outcome> 扩容时才会移动而不是拷贝
+    Outcome(Outcome&& other) noexcept(std::is_nothrow_move_constructible<E>::value &&
+                                      std::is_nothrow_move_constructible<R>::value)
+            : success_(other.success_), e_(std::move(other.e_)), r_(std::move(other.r_)) {
+    }
     Outcome& operator=(const Outcome& other) {
         if (this != &other) {
             success_ = other.success_;
@@ -20,6 +30,15 @@ public:
         }
         return *this;
     }
+    Outcome& operator=(Outcome&& other) noexcept(std::is_nothrow_move_assignable<E>::value &&
+                                                 std::is_nothrow_move_assignable<R>::value) {
+        if (this != &other) {
+            success_ = other.success_;
+            e_ = std::move(other.e_);
+            r_ = std::move(other.r_);
+        }
+        return *this;
+    }
     bool isSuccess() const {
         return success_;
     }
@@ -38,11 +57,12 @@ public:
     R& result() {
         return r_;
     }
+    // 按值传入，调用方可以 std::move 结果以避免深拷贝
     void setE(E e) {
-        e_ = e;
+        e_ = std::move(e);
     }
     void setR(R r) {
-        r_ = r;
+        r_ = std::move(r);
     }
 
 private:
@@ -107,6 +107,7 @@ public:
     }
     std::shared_ptr<TosRequest> Build(const std::string& method);
     std::shared_ptr<TosRequest> Build(const std::string& method, std::shared_ptr<std::iostream> content);
+    std::shared_ptr<TosRequest> BuildWithBodySource(const std::string& method, const std::shared_ptr<BodySource>& body);
     std::shared_ptr<TosRequest> BuildWithCopySource(const std::string& method, const std::string& srcBucket,
                                                     const std::string& srcObject);
     std::shared_ptr<TosRequest> build(const std::string& method);
@@ -52,6 +52,9 @@
 #include "model/object/UploadFileInput.h"
 #include "auth/FederationCredentials.h"
 #include "ClientConfig.h"
+#include "transfer/ObjectAppender.h"
+#include "transfer/ObjectReadSession.h"
+#include "transfer/TransferManager.h"
 #include "model/bucket/HeadBucketV2Input.h"
 #include "model/bucket/DeleteBucketInput.h"
 #include "model/object/GetObjectV2Output.h"
@@ -87,6 +90,18 @@
 #include "model/object/CompleteMultipartUploadV2Input.h"
 #include "model/object/GetObjectToFileOutput.h"
 #include "model/object/GetObjectToFileInput.h"
+#include "model/object/ReadRangesInput.h"
+#include "model/object/ReadRangesOutput.h"
+#include "model/object/DownloadToBufferInput.h"
+#include "model/object/DownloadToBufferOutput.h"
+#include "model/object/UploadDirectoryInput.h"
+#include "model/object/UploadDirectoryOutput.h"
+#include "model/object/DownloadPrefixInput.h"
+#include "model/object/DownloadPrefixOutput.h"
+#include "model/object/SyncDirectoryInput.h"
+#include "model/object/SyncDirectoryOutput.h"
+#include "model/object/CopyPrefixInput.h"
+#include "model/object/CopyPrefixOutput.h"
 #include "model/object/PutObjectFromFileOutput.h"
 #include "model/object/PutObjectFromFileIntput.h"
 #include "model/object/UploadPartFromFileOutput.h"
@@ -246,13 +261,34 @@ public:
     Outcome<TosError, DeleteBucketOutput> deleteBucket(const DeleteBucketInput& input) const;
 
     Outcome<TosError, GetObjectV2Output> getObject(const GetObjectV2Input& input) const;
+    // 响应体按偏移写入 sink，例如 MemoryBodySink 直接写入调用方的内存，重试时从偏移 0 重新写入
+    Outcome<TosError, GetObjectV2Output> getObject(const GetObjectV2Input& input,
+                                                   const std::shared_ptr<BodySink>& sink) const;
     //    Outcome<TosError, GetObjectV2Output> getObject(const GetObjectV2Input& input,
     //                                                   std::shared_ptr<std::iostream> resContent,
     //                                                   std::shared_ptr<DataConsumeCallBack> callBack) const;
 
     Outcome<TosError, GetObjectToFileOutput> getObjectToFile(const GetObjectToFileInput& input) const;
+    // 一次读取对象的多个范围，间隔较小的范围合并为一个请求，结果直接写入调用方的 buffer
+    Outcome<TosError, ReadRangesOutput> readRanges(const ReadRangesInput& input) const;
+    // 并发发出范围请求，把整个对象直接下载到调用方的 buffer 中，不经过临时文件和中间缓冲
+    Outcome<TosError, DownloadToBufferOutput> downloadToBuffer(const DownloadToBufferInput& input) const;
+    // 打开一个对象的范围读会话，顺序读或固定步长跳读时自动预读后续数据
+    std::shared_ptr<ObjectReadSession> openReadSession(const GetObjectV2Input& input) const;
+    std::shared_ptr<ObjectReadSession> openReadSession(const GetObjectV2Input& input,
+                                                       const ReadSessionOptions& options) const;
+    // 创建统一调度多个 uploadFile/downloadFile/resumableCopyObject 任务的 TransferManager，
+    // 各任务的分片请求按优先级共享全局并发与带宽上限，任务可以暂停与恢复
+    std::shared_ptr<TransferManager> newTransferManager(const TransferManagerOptions& options) const;
+    // 打开一个追加对象的 appender，多个线程的写入合并后按顺序追加，对象达到大小上限时滚动到新对象
+    std::shared_ptr<ObjectAppender> openAppender(const AppendObjectV2Input& input) const;
+    std::shared_ptr<ObjectAppender> openAppender(const AppendObjectV2Input& input, const AppenderOptions& options) const;
+    // ClientConfig::enableObjectCache 开启时的缓存命中、回源和容量统计
+    ObjectCacheStats getObjectCacheStats() const;
 
     Outcome<TosError, HeadObjectV2Output> headObject(const HeadObjectV2Input& input) const;
+    // ClientConfig::enableObjectMetaCache/enableRequestCoalescing 开启时的缓存和请求合并统计
+    ObjectMetaCacheStats getObjectMetaCacheStats() const;
 
     Outcome<TosError, CopyObjectV2Output> copyObject(const CopyObjectV2Input& input) const;
 
@@ -293,7 +329,15 @@ public:
             const ListMultipartUploadsV2Input& input) const;
 
     Outcome<TosError, UploadFileV2Output> uploadFile(const UploadFileV2Input& input) const;
+    // 并发上传本地目录，所有文件共享 taskNum 个并发，大文件分片上传并优先调度
+    Outcome<TosError, UploadDirectoryOutput> uploadDirectory(const UploadDirectoryInput& input) const;
     Outcome<TosError, DownloadFileOutput> downloadFile(const DownloadFileInput& input) const;
+    // 把前缀下的对象并发下载到本地目录，列举与下载同时进行，大对象分片并发下载
+    Outcome<TosError, DownloadPrefixOutput> downloadPrefix(const DownloadPrefixInput& input) const;
+    // 按大小和 CRC64 比较本地目录与前缀下的对象，只传输有变化的文件
+    Outcome<TosError, SyncDirectoryOutput> syncDirectory(const SyncDirectoryInput& input) const;
+    // 把源前缀下的对象服务端复制到目标前缀，大对象分片并发复制，可选复制后删除源对象
+    Outcome<TosError, CopyPrefixOutput> copyPrefix(const CopyPrefixInput& input) const;
 
     Outcome<TosError, PreSignedURLOutput> preSignedURL(const PreSignedURLInput& input) const;
 
@@ -357,6 +401,10 @@ public:
     Outcome<TosError, DeleteBucketRenameOutput> deleteBucketRename(const DeleteBucketRenameInput& input);
 
 private:
+    // 以下类由 client 创建，共用 client 的连接与线程池
+    friend class ObjectReadSession;
+    friend class TransferManager;
+    friend class ObjectAppender;
     std::shared_ptr<TosClientImpl> tosClientImpl_;
 };
 }  // namespace VolcengineTos
@@ -5,9 +5,13 @@
 #include <iostream>
 #include <utility>
 #include "transport/http/Url.h"
+#include "transport/http/Body.h"
+#include "transport/http/TransferMonitor.h"
 #include "utils/BaseUtils.h"
 #include "Type.h"
 namespace VolcengineTos {
+class OperationMetrics;
+
 class TosRequest {
 public:
     TosRequest() = default;
@@ -62,8 +66,17 @@ public:
     std::shared_ptr<std::iostream> getContent() const {
         return content_;
     }
+    // iostream 请求体通过 StreamBodySource 读取，重试时由其回到起始位置
     void setContent(std::shared_ptr<std::iostream>& content) {
         content_ = content;
+        bodySource_ = content == nullptr ? nullptr : std::make_shared<StreamBodySource>(content);
+    }
+    const std::shared_ptr<BodySource>& getBodySource() const {
+        return bodySource_;
+    }
+    void setBodySource(const std::shared_ptr<BodySource>& bodySource) {
+        content_ = nullptr;
+        bodySource_ = bodySource;
     }
     const std::map<std::string, std::string>& getHeaders() const {
         return headers_;
@@ -107,6 +120,20 @@ public:
     void setRataLimiter(const std::shared_ptr<RateLimiter>& ratalimiter) {
         rataLimiter_ = ratalimiter;
     }
+    // 设置后可在其他线程观察请求进度并中止请求
+    const std::shared_ptr<TransferMonitor>& getTransferMonitor() const {
+        return transferMonitor_;
+    }
+    void setTransferMonitor(const std::shared_ptr<TransferMonitor>& transferMonitor) {
+        transferMonitor_ = transferMonitor;
+    }
+    // 为 true 时使用新建的连接发送请求，不复用连接池中的连接
+    bool isFreshConnection() const {
+        return freshConnection_;
+    }
+    void setFreshConnection(bool freshConnection) {
+        freshConnection_ = freshConnection;
+    }
     int getMaxRetryCount() const {
         return maxRetryCount_;
     }
@@ -119,6 +146,13 @@ public:
     void setFuncName(const std::string& funcname) {
         funcName_ = funcname;
     }
+    // 开启指标时由 roundTrip 按 funcName 查找一次，传给 transport 复用
+    const std::shared_ptr<OperationMetrics>& getOperationMetrics() const {
+        return operationMetrics_;
+    }
+    void setOperationMetrics(const std::shared_ptr<OperationMetrics>& operationMetrics) {
+        operationMetrics_ = operationMetrics;
+    }
     int64_t getContentOffset() const {
         return contentOffset_;
     }
@@ -131,11 +165,31 @@ public:
     void setPreHashCrc64Ecma(uint64_t prehashcrc64ecma) {
         preHashCrc64ecma_ = prehashcrc64ecma;
     }
+    const std::string& getBucket() const {
+        return bucket_;
+    }
+    const std::string& getObjectKey() const {
+        return objectKey_;
+    }
+    void setBucketAndObjectKey(const std::string& bucket, const std::string& objectKey) {
+        bucket_ = bucket;
+        objectKey_ = objectKey;
+    }
     const std::shared_ptr<std::iostream>& getFileContent() const {
         return fileContent_;
     }
     void setFileContent(const std::shared_ptr<std::iostream>& fileContent) {
         fileContent_ = fileContent;
+        // sink 随请求只创建一次，记录文件当前的写位置，每次重试都回到该位置重新写入
+        responseSink_ = fileContent == nullptr ? nullptr : std::make_shared<StreamBodySink>(fileContent);
+    }
+    // 2xx 的响应体写入 responseSink，为空时写入 TosResponse 的 content
+    const std::shared_ptr<BodySink>& getResponseSink() const {
+        return responseSink_;
+    }
+    void setResponseSink(const std::shared_ptr<BodySink>& responseSink) {
+        fileContent_ = nullptr;
+        responseSink_ = responseSink;
     }
 
 private:
@@ -144,16 +198,23 @@ private:
     std::string host_;
     std::string path_;
     std::string timeout_;
+    std::string bucket_;
+    std::string objectKey_;
     int64_t contentLength_ = 0;
     std::shared_ptr<std::iostream> content_;
     std::shared_ptr<std::iostream> fileContent_;
+    std::shared_ptr<BodySource> bodySource_;
+    std::shared_ptr<BodySink> responseSink_;
     std::map<std::string, std::string> headers_;
     std::map<std::string, std::string> queries_;
     DataTransferListener dataTransferListener_ = {nullptr, nullptr};
     std::shared_ptr<RateLimiter> rataLimiter_ = nullptr;
+    std::shared_ptr<TransferMonitor> transferMonitor_;
+    bool freshConnection_ = false;
     bool checkCrc64_ = false;
     int maxRetryCount_ = 0;
     std::string funcName_;
+    std::shared_ptr<OperationMetrics> operationMetrics_;
     int64_t contentOffset_ = 0;
     uint64_t preHashCrc64ecma_ = 0;
 };
@@ -68,6 +68,13 @@ public:
     void setCurlErrCode(int curlErrCode) {
         TosResponse::curlErrCode = curlErrCode;
     }
+    // 建连或 TLS 握手未完成，请求没有到达服务端
+    bool isConnectFailed() const {
+        return connectFailed_;
+    }
+    void setConnectFailed(bool connectFailed) {
+        connectFailed_ = connectFailed;
+    }
 
 private:
     int statusCode_{};
@@ -78,5 +85,6 @@ private:
     std::string Id2_;
     uint64_t hashCrc64Result = 0;
     int curlErrCode = 0;
+    bool connectFailed_ = false;
 };
 }  // namespace VolcengineTos
@@ -7,7 +7,50 @@
 #include <ctime>
 #include <functional>
 #include <sstream>
+#include <string>
 namespace VolcengineTos {
+template <typename E>
+struct EnumNamePair {
+    E value;
+    const char* name;
+};
+
+template <typename E>
+struct NameEnumPair {
+    const char* name;
+    E value;
+};
+
+// 枚举到字符串的只读映射表，常量初始化，无需动态构造，不存在的枚举值返回空串
+template <typename E, size_t N>
+struct EnumToStringTable {
+    EnumNamePair<E> entries[N];
+
+    std::string operator[](E value) const {
+        for (size_t i = 0; i < N; i++) {
+            if (entries[i].value == value) {
+                return entries[i].name;
+            }
+        }
+        return "";
+    }
+};
+
+// 字符串到枚举的只读映射表，未知字符串返回枚举的默认值，查找不修改表，可并发调用
+template <typename E, size_t N>
+struct StringToEnumTable {
+    NameEnumPair<E> entries[N];
+
+    E operator[](const std::string& name) const {
+        for (size_t i = 0; i < N; i++) {
+            if (name == entries[i].name) {
+                return entries[i].value;
+            }
+        }
+        return E();
+    }
+};
+
 enum class ACLType {
     NotSet = 0,
     Private,
@@ -18,7 +61,7 @@ enum class ACLType {
     BucketOwnerFullControl,
     BucketOwnerEntrusted
 };
-static std::map<ACLType, std::string> ACLTypetoString{
+static constexpr EnumToStringTable<ACLType, 8> ACLTypetoString{{
         {ACLType::NotSet, ""},
         {ACLType::Private, "private"},
         {ACLType::PublicRead, "public-read"},
@@ -26,171 +69,212 @@ static std::map<ACLType, std::string> ACLTypetoString{
         {ACLType::AuthenticatedRead, "authenticated-read"},
         {ACLType::BucketOwnerRead, "bucket-owner-read"},
         {ACLType::BucketOwnerFullControl, "bucket-owner-full-control"},
-        {ACLType::BucketOwnerEntrusted, "bucket-owner-entrusted"},
-};
-static std::map<std::string, ACLType> StringtoACLType{{"private", ACLType::Private},
-                                                      {"public-read", ACLType::PublicRead},
-                                                      {"public-read-write", ACLType::PublicReadWrite},
-                                                      {"authenticated-read", ACLType::AuthenticatedRead},
-                                                      {"bucket-owner-read", ACLType::BucketOwnerRead},
-                                                      {"bucket-owner-full-control", ACLType::BucketOwnerFullControl},
-                                                      {"bucket-owner-entrusted", ACLType::BucketOwnerEntrusted}};
+        {ACLType::BucketOwnerEntrusted, "bucket-owner-entrusted"}}};
+static constexpr StringToEnumTable<ACLType, 7> StringtoACLType{{
+        {"private", ACLType::Private},
+        {"public-read", ACLType::PublicRead},
+        {"public-read-write", ACLType::PublicReadWrite},
+        {"authenticated-read", ACLType::AuthenticatedRead},
+        {"bucket-owner-read", ACLType::BucketOwnerRead},
+        {"bucket-owner-full-control", ACLType::BucketOwnerFullControl},
+        {"bucket-owner-entrusted", ACLType::BucketOwnerEntrusted}}};
 
 enum class StorageClassType { NotSet = 0, STANDARD, IA, ARCHIVE_FR, INTELLIGENT_TIERING, COLD_ARCHIVE };
-static std::map<StorageClassType, std::string> StorageClassTypetoString{
+static constexpr EnumToStringTable<StorageClassType, 6> StorageClassTypetoString{{
         {StorageClassType::NotSet, ""},
         {StorageClassType::STANDARD, "STANDARD"},
         {StorageClassType::IA, "IA"},
         {StorageClassType::ARCHIVE_FR, "ARCHIVE_FR"},
         {StorageClassType::INTELLIGENT_TIERING, "INTELLIGENT_TIERING"},
-        {StorageClassType::COLD_ARCHIVE, "COLD_ARCHIVE"}};
-static std::map<std::string, StorageClassType> StringtoStorageClassType{
+        {StorageClassType::COLD_ARCHIVE, "COLD_ARCHIVE"}}};
+static constexpr StringToEnumTable<StorageClassType, 5> StringtoStorageClassType{{
         {"STANDARD", StorageClassType::STANDARD},
         {"IA", StorageClassType::IA},
         {"ARCHIVE_FR", StorageClassType::ARCHIVE_FR},
         {"INTELLIGENT_TIERING", StorageClassType::INTELLIGENT_TIERING},
-        {"COLD_ARCHIVE", StorageClassType::COLD_ARCHIVE}};
+        {"COLD_ARCHIVE", StorageClassType::COLD_ARCHIVE}}};
 
 enum MetadataDirectiveType { COPY = 0, REPLACE };
-static std::map<MetadataDirectiveType, std::string> MetadataDirectiveTypetoString{{COPY, "COPY"}, {REPLACE, "REPLACE"}};
-static std::map<std::string, MetadataDirectiveType> StringtoMetadataDirectiveType{{"COPY", COPY}, {"REPLACE", REPLACE}};
+static constexpr EnumToStringTable<MetadataDirectiveType, 2> MetadataDirectiveTypetoString{{
+        {COPY, "COPY"},
+        {REPLACE, "REPLACE"}}};
+static constexpr StringToEnumTable<MetadataDirectiveType, 2> StringtoMetadataDirectiveType{{
+        {"COPY", COPY},
+        {"REPLACE", REPLACE}}};
 
 enum class AzRedundancyType { NotSet = 0, SingleAz, MultiAz };
-static std::map<AzRedundancyType, std::string> AzRedundancyTypetoString{{AzRedundancyType::NotSet, ""},
-                                                                        {AzRedundancyType::SingleAz, "single-az"},
-                                                                        {AzRedundancyType::MultiAz, "multi-az"}};
-static std::map<std::string, AzRedundancyType> StringtoAzRedundancyType{{"single-az", AzRedundancyType::SingleAz},
-                                                                        {"multi-az", AzRedundancyType::MultiAz}};
+static constexpr EnumToStringTable<AzRedundancyType, 3> AzRedundancyTypetoString{{
+        {AzRedundancyType::NotSet, ""},
+        {AzRedundancyType::SingleAz, "single-az"},
+        {AzRedundancyType::MultiAz, "multi-az"}}};
+static constexpr StringToEnumTable<AzRedundancyType, 2> StringtoAzRedundancyType{{
+        {"single-az", AzRedundancyType::SingleAz},
+        {"multi-az", AzRedundancyType::MultiAz}}};
 
 enum class PermissionType { NotSet = 0, Read, Write, ReadAcp, WriteAcp, FullControl };
-static std::map<PermissionType, std::string> PermissionTypetoString{{PermissionType::NotSet, ""},
-                                                                    {PermissionType::Read, "Read"},
-                                                                    {PermissionType::Write, "Write"},
-                                                                    {PermissionType::ReadAcp, "READ_ACP"},
-                                                                    {PermissionType::WriteAcp, "WRITE_ACP"},
-                                                                    {PermissionType::FullControl, "FULL_CONTROL"}};
-static std::map<std::string, PermissionType> StringtoPermissionType{{"", PermissionType::NotSet},
-                                                                    {"Read", PermissionType::Read},
-                                                                    {"Write", PermissionType::Write},
-                                                                    {"READ_ACP", PermissionType::ReadAcp},
-                                                                    {"WRITE_ACP", PermissionType::WriteAcp},
-                                                                    {"FULL_CONTROL", PermissionType::FullControl}};
+static constexpr EnumToStringTable<PermissionType, 6> PermissionTypetoString{{
+        {PermissionType::NotSet, ""},
+        {PermissionType::Read, "Read"},
+        {PermissionType::Write, "Write"},
+        {PermissionType::ReadAcp, "READ_ACP"},
+        {PermissionType::WriteAcp, "WRITE_ACP"},
+        {PermissionType::FullControl, "FULL_CONTROL"}}};
+static constexpr StringToEnumTable<PermissionType, 6> StringtoPermissionType{{
+        {"", PermissionType::NotSet},
+        {"Read", PermissionType::Read},
+        {"Write", PermissionType::Write},
+        {"READ_ACP", PermissionType::ReadAcp},
+        {"WRITE_ACP", PermissionType::WriteAcp},
+        {"FULL_CONTROL", PermissionType::FullControl}}};
 
 enum class GranteeType { NotSet = 0, Group, CanonicalUser };
-static std::map<GranteeType, std::string> GranteeTypetoString{
-        {GranteeType::NotSet, ""}, {GranteeType::Group, "Group"}, {GranteeType::CanonicalUser, "CanonicalUser"}};
-static std::map<std::string, GranteeType> StringtoGranteeType{
-        {"", GranteeType::NotSet}, {"Group", GranteeType::Group}, {"CanonicalUser", GranteeType::CanonicalUser}};
+static constexpr EnumToStringTable<GranteeType, 3> GranteeTypetoString{{
+        {GranteeType::NotSet, ""},
+        {GranteeType::Group, "Group"},
+        {GranteeType::CanonicalUser, "CanonicalUser"}}};
+static constexpr StringToEnumTable<GranteeType, 3> StringtoGranteeType{{
+        {"", GranteeType::NotSet},
+        {"Group", GranteeType::Group},
+        {"CanonicalUser", GranteeType::CanonicalUser}}};
 
 enum class CannedType { NotSet = 0, AllUsers, AuthenticatedUsers };
-static std::map<CannedType, std::string> CannedTypetoString{{CannedType::NotSet, ""},
-                                                            {CannedType::AllUsers, "AllUsers"},
-                                                            {CannedType::AuthenticatedUsers, "AuthenticatedUsers"}};
-static std::map<std::string, CannedType> StringtoCannedType{{"", CannedType::NotSet},
-                                                            {"AllUsers", CannedType::AllUsers},
-                                                            {"AuthenticatedUsers", CannedType::AuthenticatedUsers}};
+static constexpr EnumToStringTable<CannedType, 3> CannedTypetoString{{
+        {CannedType::NotSet, ""},
+        {CannedType::AllUsers, "AllUsers"},
+        {CannedType::AuthenticatedUsers, "AuthenticatedUsers"}}};
+static constexpr StringToEnumTable<CannedType, 3> StringtoCannedType{{
+        {"", CannedType::NotSet},
+        {"AllUsers", CannedType::AllUsers},
+        {"AuthenticatedUsers", CannedType::AuthenticatedUsers}}};
 
 enum class HttpMethodType { NotSet = 0, Get, Put, Post, Delete, Head };
-static std::map<HttpMethodType, std::string> HttpMethodTypetoString{
-        {HttpMethodType::NotSet, ""},   {HttpMethodType::Get, "GET"},       {HttpMethodType::Put, "PUT"},
-        {HttpMethodType::Post, "POST"}, {HttpMethodType::Delete, "DELETE"}, {HttpMethodType::Head, "HEAD"}};
-static std::map<std::string, HttpMethodType> StringtoHttpMethodType{
-        {"", HttpMethodType::NotSet},   {"GET", HttpMethodType::Get},       {"PUT", HttpMethodType::Put},
-        {"POST", HttpMethodType::Post}, {"DELETE", HttpMethodType::Delete}, {"HEAD", HttpMethodType::Head}};
+static constexpr EnumToStringTable<HttpMethodType, 6> HttpMethodTypetoString{{
+        {HttpMethodType::NotSet, ""},
+        {HttpMethodType::Get, "GET"},
+        {HttpMethodType::Put, "PUT"},
+        {HttpMethodType::Post, "POST"},
+        {HttpMethodType::Delete, "DELETE"},
+        {HttpMethodType::Head, "HEAD"}}};
+static constexpr StringToEnumTable<HttpMethodType, 6> StringtoHttpMethodType{{
+        {"", HttpMethodType::NotSet},
+        {"GET", HttpMethodType::Get},
+        {"PUT", HttpMethodType::Put},
+        {"POST", HttpMethodType::Post},
+        {"DELETE", HttpMethodType::Delete},
+        {"HEAD", HttpMethodType::Head}}};
 
 enum class StatusType { NotSet = 0, StatusEnabled, StatusDisabled };
-static std::map<StatusType, std::string> StatusTypetoString{
-        {StatusType::NotSet, ""}, {StatusType::StatusEnabled, "Enabled"}, {StatusType::StatusDisabled, "Disabled"}};
-static std::map<std::string, StatusType> StringtoStatusType{
-        {"", StatusType::NotSet}, {"Enabled", StatusType::StatusEnabled}, {"Disabled", StatusType::StatusDisabled}};
+static constexpr EnumToStringTable<StatusType, 3> StatusTypetoString{{
+        {StatusType::NotSet, ""},
+        {StatusType::StatusEnabled, "Enabled"},
+        {StatusType::StatusDisabled, "Disabled"}}};
+static constexpr StringToEnumTable<StatusType, 3> StringtoStatusType{{
+        {"", StatusType::NotSet},
+        {"Enabled", StatusType::StatusEnabled},
+        {"Disabled", StatusType::StatusDisabled}}};
 
 enum class RedirectType { NotSet = 0, RedirectMirror, RedirectAsync };
-static std::map<RedirectType, std::string> RedirectTypetoString{
-        {RedirectType::NotSet, ""}, {RedirectType::RedirectMirror, "Mirror"}, {RedirectType::RedirectAsync, "Async"}};
-static std::map<std::string, RedirectType> StringtoRedirectType{
-        {"", RedirectType::NotSet}, {"Mirror", RedirectType::RedirectMirror}, {"Async", RedirectType::RedirectAsync}};
+static constexpr EnumToStringTable<RedirectType, 3> RedirectTypetoString{{
+        {RedirectType::NotSet, ""},
+        {RedirectType::RedirectMirror, "Mirror"},
+        {RedirectType::RedirectAsync, "Async"}}};
+static constexpr StringToEnumTable<RedirectType, 3> StringtoRedirectType{{
+        {"", RedirectType::NotSet},
+        {"Mirror", RedirectType::RedirectMirror},
+        {"Async", RedirectType::RedirectAsync}}};
 
 enum class StorageClassInheritDirectiveType { NotSet = 0, DestinationBucket, SourceObject };
-static std::map<StorageClassInheritDirectiveType, std::string> StorageClassInheritDirectiveTypetoString{
+static constexpr EnumToStringTable<StorageClassInheritDirectiveType, 3> StorageClassInheritDirectiveTypetoString{{
         {StorageClassInheritDirectiveType::NotSet, ""},
         {StorageClassInheritDirectiveType::DestinationBucket, "DESTINATION_BUCKET"},
-        {StorageClassInheritDirectiveType::SourceObject, "SOURCE_OBJECT"}};
-static std::map<std::string, StorageClassInheritDirectiveType> StringtoStorageClassInheritDirectiveType{
+        {StorageClassInheritDirectiveType::SourceObject, "SOURCE_OBJECT"}}};
+static constexpr StringToEnumTable<StorageClassInheritDirectiveType, 3> StringtoStorageClassInheritDirectiveType{{
         {"", StorageClassInheritDirectiveType::NotSet},
         {"DESTINATION_BUCKET", StorageClassInheritDirectiveType::DestinationBucket},
-        {"SOURCE_OBJECT", StorageClassInheritDirectiveType::SourceObject}};
+        {"SOURCE_OBJECT", StorageClassInheritDirectiveType::SourceObject}}};
 
 enum class VersioningStatusType { NotSet = 0, Enabled, Suspended };
-static std::map<VersioningStatusType, std::string> VersioningStatusTypetoString{
+static constexpr EnumToStringTable<VersioningStatusType, 3> VersioningStatusTypetoString{{
         {VersioningStatusType::NotSet, ""},
         {VersioningStatusType::Enabled, "Enabled"},
-        {VersioningStatusType::Suspended, "Suspended"}};
-static std::map<std::string, VersioningStatusType> StringtoVersioningStatusType{
+        {VersioningStatusType::Suspended, "Suspended"}}};
+static constexpr StringToEnumTable<VersioningStatusType, 3> StringtoVersioningStatusType{{
         {"", VersioningStatusType::NotSet},
         {"Enabled", VersioningStatusType::Enabled},
-        {"Suspended", VersioningStatusType::Suspended}};
+        {"Suspended", VersioningStatusType::Suspended}}};
 
 enum class ProtocolType { NotSet = 0, Http, Https };
-static std::map<ProtocolType, std::string> ProtocolTypetoString{
-        {ProtocolType::NotSet, ""}, {ProtocolType::Http, "http"}, {ProtocolType::Https, "https"}};
-static std::map<std::string, ProtocolType> StringtoProtocolType{
-        {"", ProtocolType::NotSet}, {"http", ProtocolType::Http}, {"https", ProtocolType::Https}};
+static constexpr EnumToStringTable<ProtocolType, 3> ProtocolTypetoString{{
+        {ProtocolType::NotSet, ""},
+        {ProtocolType::Http, "http"},
+        {ProtocolType::Https, "https"}}};
+static constexpr StringToEnumTable<ProtocolType, 3> StringtoProtocolType{{
+        {"", ProtocolType::NotSet},
+        {"http", ProtocolType::Http},
+        {"https", ProtocolType::Https}}};
 
 enum class CertStatusType { NotSet = 0, Bound, Unbound, Expired };
-static std::map<CertStatusType, std::string> CertStatusTypetoString{{CertStatusType::NotSet, ""},
-                                                                    {CertStatusType::Bound, "CertBound"},
-                                                                    {CertStatusType::Unbound, "CertUnbound"},
-                                                                    {CertStatusType::Expired, "CertExpired"}};
-static std::map<std::string, CertStatusType> StringtoCertStatusType{{"", CertStatusType::NotSet},
-                                                                    {"CertBound", CertStatusType::Bound},
-                                                                    {"CertUnbound", CertStatusType::Unbound},
-                                                                    {"CertExpired", CertStatusType::Expired}};
+static constexpr EnumToStringTable<CertStatusType, 4> CertStatusTypetoString{{
+        {CertStatusType::NotSet, ""},
+        {CertStatusType::Bound, "CertBound"},
+        {CertStatusType::Unbound, "CertUnbound"},
+        {CertStatusType::Expired, "CertExpired"}}};
+static constexpr StringToEnumTable<CertStatusType, 4> StringtoCertStatusType{{
+        {"", CertStatusType::NotSet},
+        {"CertBound", CertStatusType::Bound},
+        {"CertUnbound", CertStatusType::Unbound},
+        {"CertExpired", CertStatusType::Expired}}};
 
 enum class AccessControlDirectiveType { NotSet = 0, Copy, Replace, Add };
-static std::map<AccessControlDirectiveType, std::string> AccessControlDirectiveTypetoString{
+static constexpr EnumToStringTable<AccessControlDirectiveType, 4> AccessControlDirectiveTypetoString{{
         {AccessControlDirectiveType::NotSet, ""},
         {AccessControlDirectiveType::Copy, "COPY"},
         {AccessControlDirectiveType::Replace, "REPLACE"},
-        {AccessControlDirectiveType::Add, "ADD"}};
-static std::map<std::string, AccessControlDirectiveType> StringtoAccessControlDirectiveType{
+        {AccessControlDirectiveType::Add, "ADD"}}};
+static constexpr StringToEnumTable<AccessControlDirectiveType, 4> StringtoAccessControlDirectiveType{{
         {"", AccessControlDirectiveType::NotSet},
         {"COPY", AccessControlDirectiveType::Copy},
         {"REPLACE", AccessControlDirectiveType::Replace},
-        {"ADD", AccessControlDirectiveType::Add}};
+        {"ADD", AccessControlDirectiveType::Add}}};
 
 enum class CannedAccessControlListType { NotSet = 0, Default, Private, PublicRead };
-static std::map<CannedAccessControlListType, std::string> CannedAccessControlListTypetoString{
+static constexpr EnumToStringTable<CannedAccessControlListType, 4> CannedAccessControlListTypetoString{{
         {CannedAccessControlListType::NotSet, ""},
         {CannedAccessControlListType::Default, "default"},
         {CannedAccessControlListType::Private, "private"},
-        {CannedAccessControlListType::PublicRead, "public-read"}};
-static std::map<std::string, CannedAccessControlListType> StringtoCannedAccessControlListType{
+        {CannedAccessControlListType::PublicRead, "public-read"}}};
+static constexpr StringToEnumTable<CannedAccessControlListType, 4> StringtoCannedAccessControlListType{{
         {"", CannedAccessControlListType::NotSet},
         {"default", CannedAccessControlListType::Default},
         {"private", CannedAccessControlListType::Private},
-        {"public-read", CannedAccessControlListType::PublicRead}};
+        {"public-read", CannedAccessControlListType::PublicRead}}};
 
 enum class TaggingDirectiveType { NotSet = 0, Copy, Replace, Add };
-static std::map<TaggingDirectiveType, std::string> TaggingDirectiveTypetoString{
+static constexpr EnumToStringTable<TaggingDirectiveType, 4> TaggingDirectiveTypetoString{{
         {TaggingDirectiveType::NotSet, ""},
         {TaggingDirectiveType::Copy, "Standard"},
         {TaggingDirectiveType::Replace, "Expedited"},
-        {TaggingDirectiveType::Add, "Bulk"}};
-static std::map<std::string, TaggingDirectiveType> StringtoTaggingDirectiveType{
+        {TaggingDirectiveType::Add, "Bulk"}}};
+static constexpr StringToEnumTable<TaggingDirectiveType, 4> StringtoTaggingDirectiveType{{
         {"", TaggingDirectiveType::NotSet},
         {"Standard", TaggingDirectiveType::Copy},
         {"Expedited", TaggingDirectiveType::Replace},
-        {"Bulk", TaggingDirectiveType::Add}};
+        {"Bulk", TaggingDirectiveType::Add}}};
 
 enum class TierType { NotSet = 0, TierStandard, TierExpedited, TierBulk };
-static std::map<TierType, std::string> TierTypetoString{{TierType::NotSet, ""},
-                                                        {TierType::TierStandard, "Standard"},
-                                                        {TierType::TierExpedited, "Expedited"},
-                                                        {TierType::TierBulk, "Bulk"}};
-static std::map<std::string, TierType> StringtoTierType{{"", TierType::NotSet},
-                                                        {"Standard", TierType::TierStandard},
-                                                        {"Expedited", TierType::TierExpedited},
-                                                        {"Bulk", TierType::TierBulk}};
+static constexpr EnumToStringTable<TierType, 4> TierTypetoString{{
+        {TierType::NotSet, ""},
+        {TierType::TierStandard, "Standard"},
+        {TierType::TierExpedited, "Expedited"},
+        {TierType::TierBulk, "Bulk"}}};
+static constexpr StringToEnumTable<TierType, 4> StringtoTierType{{
+        {"", TierType::NotSet},
+        {"Standard", TierType::TierStandard},
+        {"Expedited", TierType::TierExpedited},
+        {"Bulk", TierType::TierBulk}}};
+
+// syncDirectory 的同步方向
+enum class SyncDirectionType { Upload = 0, Download };
 
 enum LogLevel {
     LogOff = 0,
@@ -198,6 +282,21 @@ enum LogLevel {
     LogDebug,
 };
 
+// 日志分类，可分别设置日志级别
+enum LogCategory {
+    LogCategoryRequest = 0,  // roundTrip 请求结果与重试
+    LogCategoryTransport,    // HttpClient 连接耗时
+    LogCategoryTransfer,     // uploadFile / downloadFile / resumableCopyObject
+    LogCategoryAuth,         // 签名
+    LogCategoryNum,
+};
+
+// 异步日志队列满时的处理策略
+enum LogOverflowPolicy {
+    LogOverflowBlock = 0,    // 阻塞直到队列有空位
+    LogOverflowDropOldest,   // 丢弃队列中最旧的日志
+};
+
 // 支持进度条
 using DataTransferType = int;
 static const DataTransferType DataTransferStarted = 1;
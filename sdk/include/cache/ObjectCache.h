@@ -0,0 +1,143 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+#include "model/object/GetObjectBasicOutput.h"
+
+namespace VolcengineTos {
+struct ObjectCacheOptions {
+    // 内存缓存容量，以及可以放入内存缓存的单个对象大小上限
+    int64_t memoryCapacity = 64 * 1024 * 1024;
+    int64_t memoryObjectLimit = 4 * 1024 * 1024;
+    // 磁盘缓存目录和容量，目录为空时超过 memoryObjectLimit 的对象不缓存
+    std::string diskPath;
+    int64_t diskCapacity = 1024LL * 1024 * 1024;
+    // 缓存块大小，范围读按块缓存和命中
+    int64_t blockSize = 1024 * 1024;
+    // 缓存项在 ttl 秒内直接使用，过期后通过 If-None-Match 重新校验，0 表示每次都校验
+    int ttl = 0;
+};
+
+struct ObjectCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    // 通过 304 重新校验成功的次数
+    uint64_t revalidations = 0;
+    // 校验发现对象已变化而失效的次数
+    uint64_t invalidations = 0;
+    uint64_t evictions = 0;
+    uint64_t hitBytes = 0;
+    int64_t memoryBytes = 0;
+    int64_t diskBytes = 0;
+    uint64_t entries = 0;
+};
+
+struct CachedObjectMeta {
+    GetObjectBasicOutput basicOutput;
+    std::string etag;
+    int64_t size = 0;
+};
+
+// 客户端对象缓存，key 为 bucket/key/versionId。
+// 对象按 blockSize 切块存储，不超过 memoryObjectLimit 的对象放在内存，更大的对象放在磁盘目录中，
+// 两层各自按 LRU 淘汰。所有接口线程安全，磁盘读写在锁外进行，读到已被淘汰的块按未命中处理。
+// 读取对象前先记录 epoch，写入缓存时 epoch 已变化说明期间本 client 写过该对象，读到的数据不再缓存。
+class ObjectCache {
+public:
+    explicit ObjectCache(const ObjectCacheOptions& options);
+    ~ObjectCache();
+
+    static std::string CacheKey(const std::string& bucket, const std::string& key, const std::string& versionId);
+
+    const ObjectCacheOptions& options() const {
+        return options_;
+    }
+    // 大小为 size 的对象能否放入内存或磁盘缓存
+    bool admits(int64_t size) const;
+    // 对象的写 epoch，按 bucket/key 分槽，失效时增加
+    uint64_t epoch(const std::string& cacheKey) const;
+    // 记录大小超出缓存上限的对象，之后对它的读直接请求服务端，不再按块对齐和缓冲；对象失效时清除
+    void markUncacheable(const std::string& cacheKey);
+    bool uncacheable(const std::string& cacheKey) const;
+    // 查询元数据，fresh 表示仍在 ttl 内
+    bool getMeta(const std::string& cacheKey, CachedObjectMeta& meta, bool& fresh);
+    // 重新校验成功后刷新 ttl
+    void markValidated(const std::string& cacheKey);
+    // [start, end] 范围内缺失的第一个和最后一个块，全部命中时返回 false
+    bool missingBlocks(const std::string& cacheKey, int64_t start, int64_t end, int64_t& firstBlock,
+                       int64_t& lastBlock);
+    // 读取 [start, end]，任一块缺失时返回 false
+    bool read(const std::string& cacheKey, int64_t start, int64_t end, std::string& out);
+    // 写入从 offset 开始的连续数据，只保存其中完整的块和对象的最后一块。
+    // 元数据的 etag 与已有缓存不一致时先丢弃旧的缓存，epoch 为读取前记录的 epoch(cacheKey)
+    void put(const std::string& cacheKey, const CachedObjectMeta& meta, int64_t offset, const std::string& data,
+             uint64_t epoch);
+    void invalidate(const std::string& cacheKey);
+    // 失效 bucket/key 的所有版本
+    void invalidateObject(const std::string& bucket, const std::string& key);
+    void clear();
+
+    void recordHit(uint64_t bytes);
+    void recordMiss();
+    void recordRevalidation();
+    ObjectCacheStats stats() const;
+
+private:
+    struct Block {
+        std::string cacheKey;
+        int64_t index = 0;
+        int64_t size = 0;
+        bool onDisk = false;
+        std::string data;
+        std::string path;
+    };
+    typedef std::list<Block>::iterator BlockIter;
+    struct Entry {
+        CachedObjectMeta meta;
+        uint64_t id = 0;
+        bool onDisk = false;
+        std::chrono::steady_clock::time_point validatedAt;
+        std::map<int64_t, BlockIter> blocks;
+    };
+
+    bool isFresh(const Entry& entry) const;
+    void eraseEntryLocked(std::map<std::string, Entry>::iterator it);
+    void eraseBlockLocked(Entry& entry, BlockIter block);
+    void evictLocked(bool onDisk);
+    std::string blockPath(uint64_t id, int64_t index) const;
+    uint64_t& epochLocked(const std::string& cacheKey);
+
+private:
+    ObjectCacheOptions options_;
+    std::string filePrefix_;
+    mutable std::mutex mu_;
+    std::map<std::string, Entry> entries_;
+    // front 为最近使用
+    std::list<Block> memoryLru_;
+    std::list<Block> diskLru_;
+    int64_t memoryBytes_ = 0;
+    int64_t diskBytes_ = 0;
+    uint64_t nextId_ = 0;
+    std::atomic<uint64_t> tmpSeq_{0};
+    // 按 bucket/key 的哈希分槽的写 epoch，由 mu_ 保护
+    std::vector<uint64_t> epochs_;
+    // 超出缓存上限的对象，超过上限后按写入顺序淘汰
+    std::set<std::string> uncacheable_;
+    std::list<std::string> uncacheableOrder_;
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> revalidations_{0};
+    std::atomic<uint64_t> invalidations_{0};
+    std::atomic<uint64_t> evictions_{0};
+    std::atomic<uint64_t> hitBytes_{0};
+};
+}  // namespace VolcengineTos
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include "Outcome.h"
+#include "TosError.h"
+#include "model/object/HeadObjectV2Output.h"
+
+namespace VolcengineTos {
+struct ObjectMetaCacheOptions {
+    // 对象存在时的缓存时间（秒）
+    int ttl = 5;
+    // 对象不存在（404）时的缓存时间（秒），0 表示不缓存 404
+    int negativeTtl = 1;
+    // 最多缓存的对象数，超过后按 LRU 淘汰
+    size_t maxEntries = 10000;
+};
+
+struct ObjectMetaCacheStats {
+    uint64_t hits = 0;
+    // 命中缓存的 404
+    uint64_t negativeHits = 0;
+    uint64_t misses = 0;
+    uint64_t invalidations = 0;
+    uint64_t entries = 0;
+    // 合并到其他正在进行的相同请求上的 headObject/getObject 次数
+    uint64_t coalescedHeads = 0;
+    uint64_t coalescedGets = 0;
+};
+
+// headObject 结果缓存，key 与 ObjectCache::CacheKey 相同。
+// 只缓存成功的结果和 404，其余错误不缓存。
+class ObjectMetaCache {
+public:
+    explicit ObjectMetaCache(const ObjectMetaCacheOptions& options);
+
+    bool get(const std::string& cacheKey, Outcome<TosError, HeadObjectV2Output>& result);
+    // 每次失效都会增加 epoch，请求发出前记录 epoch，返回后 epoch 已变化说明期间有写操作，结果不再缓存
+    uint64_t epoch() const {
+        return epoch_.load();
+    }
+    void put(const std::string& cacheKey, const Outcome<TosError, HeadObjectV2Output>& result, uint64_t epoch);
+    // 失效 bucket/key 的所有版本
+    void invalidateObject(const std::string& bucket, const std::string& key);
+    void clear();
+    ObjectMetaCacheStats stats() const;
+
+private:
+    struct Entry {
+        Outcome<TosError, HeadObjectV2Output> result;
+        std::chrono::steady_clock::time_point expireAt;
+        std::list<std::string>::iterator lru;
+    };
+    void eraseLocked(std::map<std::string, Entry>::iterator it);
+
+private:
+    ObjectMetaCacheOptions options_;
+    mutable std::mutex mu_;
+    std::map<std::string, Entry> entries_;
+    // front 为最近使用
+    std::list<std::string> lru_;
+    std::atomic<uint64_t> epoch_{0};
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> negativeHits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> invalidations_{0};
+};
+}  // namespace VolcengineTos
@@ -0,0 +1,252 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace VolcengineTos {
+
+// 请求各阶段的耗时
+enum MetricsPhase {
+    MetricsPhasePoolWait = 0,  // 等待 curl 连接句柄
+    MetricsPhaseDNS,           // DNS 解析
+    MetricsPhaseConnect,       // 建立 TCP 连接
+    MetricsPhaseTLS,           // TLS 握手
+    MetricsPhaseFirstByte,     // 发送完请求到收到首字节
+    MetricsPhaseTransfer,      // 收取响应体
+    MetricsPhaseHttp,          // 单次 HTTP 请求总耗时
+    MetricsPhaseRequest,       // roundTrip 总耗时，包含重试与退避
+    MetricsPhaseNum,
+};
+
+const char* MetricsPhaseName(MetricsPhase phase);
+
+struct HistogramSnapshot {
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t max = 0;
+    // 非空桶的上界与计数，按上界升序，单位微秒
+    std::vector<std::pair<uint64_t, uint64_t>> buckets;
+
+    // q 取值 [0, 1]，返回对应分位数所在桶的上界
+    uint64_t percentile(double q) const;
+};
+
+// HDR 风格的对数-线性直方图：每个 2 的幂区间再等分为 8 个子桶，相对误差不超过 12.5%，记录无锁
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+    void record(uint64_t micros);
+    HistogramSnapshot snapshot() const;
+
+    static int bucketIndex(uint64_t micros);
+    static uint64_t bucketUpperBound(int index);
+
+private:
+    static const int subBucketBits = 3;
+    static const int subBucketCount = 1 << subBucketBits;
+    static const int maxExponent = 40;
+    static const int bucketNum = subBucketCount + (maxExponent - subBucketBits + 1) * subBucketCount;
+
+    std::atomic<uint64_t> counts_[bucketNum];
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+};
+
+struct OperationMetricsSnapshot {
+    std::string funcName;
+    uint64_t requests = 0;
+    uint64_t retries = 0;
+    uint64_t errors = 0;
+    uint64_t bytesSent = 0;
+    uint64_t bytesReceived = 0;
+    // key 为 MetricsPhaseName，只包含有记录的阶段
+    std::map<std::string, HistogramSnapshot> latency;
+};
+
+// 开启 enableDnsLoadBalance 后按解析出的地址统计新建连接
+struct AddressMetricsSnapshot {
+    std::string host;
+    std::string address;
+    uint64_t connects = 0;
+    uint64_t connectFailures = 0;
+    // 新建连接耗时，包含 TLS 握手
+    HistogramSnapshot connectLatency;
+};
+
+// 配置了 failoverEndpoints 后按 endpoint 统计
+struct EndpointMetricsSnapshot {
+    std::string endpoint;
+    // 切换到该 endpoint 的次数，包括选择更快的 endpoint 与请求建连失败后的切换
+    uint64_t switches = 0;
+    // 探测或请求建连失败的次数
+    uint64_t failures = 0;
+    // 后台探测的耗时
+    HistogramSnapshot probeLatency;
+};
+
+struct MetricsSnapshot {
+    std::vector<OperationMetricsSnapshot> operations;
+    std::vector<AddressMetricsSnapshot> addresses;
+    std::vector<EndpointMetricsSnapshot> endpoints;
+    // 分片并发传输中因吞吐落后被中止重传的分片请求数，以及临近结束时发起的重复分片请求数
+    uint64_t stragglerRestarts = 0;
+    uint64_t stragglerDuplicates = 0;
+    // 分片并发传输中失败后重新排队的分片数
+    uint64_t partRetries = 0;
+    int64_t poolSize = 0;
+    int64_t poolInUse = 0;
+    int64_t poolWaiting = 0;
+    HistogramSnapshot poolWait;
+};
+
+// 导出接口，由 MetricsRegistry::flush 调用
+class MetricsExporter {
+public:
+    virtual ~MetricsExporter() = default;
+    virtual void exportMetrics(const MetricsSnapshot& snapshot) = 0;
+};
+
+// 输出 Prometheus 文本格式，可直接作为 /metrics 的响应体
+class PrometheusTextExporter : public MetricsExporter {
+public:
+    void exportMetrics(const MetricsSnapshot& snapshot) override;
+    std::string getText() const;
+
+    static std::string format(const MetricsSnapshot& snapshot);
+
+private:
+    mutable std::mutex mu_;
+    std::string text_;
+};
+
+class OperationMetrics {
+public:
+    void recordLatency(MetricsPhase phase, uint64_t micros) {
+        latency_[phase].record(micros);
+    }
+    void recordRequest(bool success, int retries) {
+        requests_.fetch_add(1, std::memory_order_relaxed);
+        if (retries > 0) {
+            retries_.fetch_add(retries, std::memory_order_relaxed);
+        }
+        if (!success) {
+            errors_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    void recordBytes(uint64_t sent, uint64_t received) {
+        bytesSent_.fetch_add(sent, std::memory_order_relaxed);
+        bytesReceived_.fetch_add(received, std::memory_order_relaxed);
+    }
+
+private:
+    friend class MetricsRegistry;
+    LatencyHistogram latency_[MetricsPhaseNum];
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> retries_{0};
+    std::atomic<uint64_t> errors_{0};
+    std::atomic<uint64_t> bytesSent_{0};
+    std::atomic<uint64_t> bytesReceived_{0};
+};
+
+class AddressMetrics {
+private:
+    friend class MetricsRegistry;
+    LatencyHistogram connectLatency_;
+    std::atomic<uint64_t> connects_{0};
+    std::atomic<uint64_t> connectFailures_{0};
+};
+
+class EndpointMetrics {
+private:
+    friend class MetricsRegistry;
+    LatencyHistogram probeLatency_;
+    std::atomic<uint64_t> switches_{0};
+    std::atomic<uint64_t> failures_{0};
+};
+
+// 全局指标，默认关闭，关闭时各记录点不计时
+class MetricsRegistry {
+public:
+    static MetricsRegistry* instance() {
+        static MetricsRegistry instance;
+        return &instance;
+    }
+    static bool Enabled() {
+        return instance()->enabled_.load(std::memory_order_relaxed);
+    }
+    void setEnabled(bool enabled) {
+        enabled_.store(enabled, std::memory_order_relaxed);
+    }
+
+    // 按操作名查找或创建，请求路径上每个请求只查找一次，结果随请求传递
+    std::shared_ptr<OperationMetrics> operation(const std::string& funcName);
+    void recordLatency(const std::string& funcName, MetricsPhase phase, uint64_t micros);
+    void recordRequest(const std::string& funcName, bool success, int retries);
+    void recordBytes(const std::string& funcName, uint64_t sent, uint64_t received);
+    void recordAddressConnect(const std::string& host, const std::string& address, bool success, uint64_t micros);
+    void recordEndpointProbe(const std::string& endpoint, bool success, uint64_t micros);
+    void recordEndpointFailure(const std::string& endpoint);
+    void recordEndpointSwitch(const std::string& endpoint);
+    void recordPoolWait(uint64_t micros) {
+        poolWait_.record(micros);
+    }
+    void recordStragglerRestart() {
+        stragglerRestarts_.fetch_add(1, std::memory_order_relaxed);
+    }
+    void recordStragglerDuplicate() {
+        stragglerDuplicates_.fetch_add(1, std::memory_order_relaxed);
+    }
+    void recordPartRetry() {
+        partRetries_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void addPoolSize(int64_t delta) {
+        poolSize_.fetch_add(delta, std::memory_order_relaxed);
+    }
+    void addPoolInUse(int64_t delta) {
+        poolInUse_.fetch_add(delta, std::memory_order_relaxed);
+    }
+    void addPoolWaiting(int64_t delta) {
+        poolWaiting_.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    MetricsSnapshot snapshot() const;
+    // 清空所有按操作统计的数据，连接池 gauge 保留
+    void reset();
+
+    void addExporter(const std::shared_ptr<MetricsExporter>& exporter);
+    // 把当前快照交给所有已注册的 exporter
+    void flush();
+
+private:
+    std::atomic<bool> enabled_{false};
+    mutable std::mutex mu_;
+    std::map<std::string, std::shared_ptr<OperationMetrics>> operations_;
+    // key 为 (host, address)
+    std::map<std::pair<std::string, std::string>, std::shared_ptr<AddressMetrics>> addresses_;
+    std::map<std::string, std::shared_ptr<EndpointMetrics>> endpoints_;
+    std::shared_ptr<EndpointMetrics> endpoint(const std::string& endpoint);
+    std::vector<std::shared_ptr<MetricsExporter>> exporters_;
+    LatencyHistogram poolWait_;
+    std::atomic<uint64_t> stragglerRestarts_{0};
+    std::atomic<uint64_t> stragglerDuplicates_{0};
+    std::atomic<uint64_t> partRetries_{0};
+    std::atomic<int64_t> poolSize_{0};
+    std::atomic<int64_t> poolInUse_{0};
+    std::atomic<int64_t> poolWaiting_{0};
+};
+
+namespace MetricsUtils {
+inline uint64_t ElapsedMicros(const std::chrono::steady_clock::time_point& start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+}  // namespace MetricsUtils
+
+}  // namespace VolcengineTos
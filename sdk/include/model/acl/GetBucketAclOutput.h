@@ -25,6 +25,9 @@ public:
     void setGrant(const std::vector<GrantV2>& grant) {
         grant_ = grant;
     }
+    void setGrant(std::vector<GrantV2>&& grant) {
+        grant_ = std::move(grant);
+    }
 
     void fromJsonString(const std::string& input);
 
@@ -32,6 +32,9 @@ public:
     void setGrant(const std::vector<Grant>& grant) {
         grant_ = grant;
     }
+    void setGrant(std::vector<Grant>&& grant) {
+        grant_ = std::move(grant);
+    }
 
 private:
     RequestInfo requestInfo_;
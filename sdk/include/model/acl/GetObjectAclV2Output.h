@@ -32,6 +32,9 @@ public:
     void setGrant(const std::vector<GrantV2>& grant) {
         grant_ = grant;
     }
+    void setGrant(std::vector<GrantV2>&& grant) {
+        grant_ = std::move(grant);
+    }
     bool isBucketOwnerEntrusted() const {
         return bucketOwnerEntrusted_;
     }
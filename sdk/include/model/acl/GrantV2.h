@@ -17,7 +17,7 @@ public:
     void setPermission(const PermissionType& permission) {
         permission_ = permission;
     }
-    const std::string& getStringFormatPermission() const {
+    std::string getStringFormatPermission() const {
         return PermissionTypetoString[permission_];
     }
 
@@ -31,10 +31,10 @@ public:
     void setCanned(const CannedType& canned) {
         canned_ = canned;
     }
-    const std::string& getStringFormatType() const {
+    std::string getStringFormatType() const {
         return GranteeTypetoString[type_];
     }
-    const std::string& getStringFormatCanned() const {
+    std::string getStringFormatCanned() const {
         return CannedTypetoString[canned_];
     }
 
@@ -19,6 +19,9 @@ public:
     void setGrants(const std::vector<Grant>& grants) {
         grants_ = grants;
     }
+    void setGrants(std::vector<Grant>&& grants) {
+        grants_ = std::move(grants);
+    }
 
 private:
     Owner owner_;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <utility>
 namespace VolcengineTos {
 class Owner {
 public:
@@ -10,12 +11,18 @@ public:
     void setId(const std::string& id) {
         Owner::id_ = id;
     }
+    void setId(std::string&& id) {
+        Owner::id_ = std::move(id);
+    }
     const std::string& getDisplayName() const {
         return displayName_;
     }
     void setDisplayName(const std::string& displayName) {
         Owner::displayName_ = displayName;
     }
+    void setDisplayName(std::string&& displayName) {
+        Owner::displayName_ = std::move(displayName);
+    }
 
 private:
     std::string id_;
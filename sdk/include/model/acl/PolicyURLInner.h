@@ -19,6 +19,9 @@ public:
     void setConditions(const std::vector<PolicySignatureConditionInner>& conditions) {
         conditions_ = conditions;
     }
+    void setConditions(std::vector<PolicySignatureConditionInner>&& conditions) {
+        conditions_ = std::move(conditions);
+    }
     std::string toJsonString() const;
 
 private:
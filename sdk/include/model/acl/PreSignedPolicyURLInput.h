@@ -39,6 +39,9 @@ public:
     void setConditions(const std::vector<PolicySignatureCondition>& conditions) {
         conditions_ = conditions;
     }
+    void setConditions(std::vector<PolicySignatureCondition>&& conditions) {
+        conditions_ = std::move(conditions);
+    }
     const std::string& getAlternativeEndpoint() const {
         return alternativeEndpoint_;
     }
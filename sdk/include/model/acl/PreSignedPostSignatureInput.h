@@ -52,6 +52,9 @@ public:
     void setConditions(const std::vector<PostSignatureCondition>& conditions) {
         conditions_ = conditions;
     }
+    void setConditions(std::vector<PostSignatureCondition>&& conditions) {
+        conditions_ = std::move(conditions);
+    }
     const std::shared_ptr<ContentLengthRange>& getContentLengthRange() const {
         return contentLengthRange_;
     }
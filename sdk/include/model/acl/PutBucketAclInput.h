@@ -62,6 +62,9 @@ public:
     void setGrants(const std::vector<GrantV2>& grants) {
         grants_ = grants;
     }
+    void setGrants(std::vector<GrantV2>&& grants) {
+        grants_ = std::move(grants);
+    }
     const std::string& getGrantWrite() const {
         return grantWrite_;
     }
@@ -76,6 +76,9 @@ public:
     void setGrants(const std::vector<GrantV2>& grants) {
         grants_ = grants;
     }
+    void setGrants(std::vector<GrantV2>&& grants) {
+        grants_ = std::move(grants);
+    }
     bool isBucketOwnerEntrusted() const {
         return bucketOwnerEntrusted_;
     }
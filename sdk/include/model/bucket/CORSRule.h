@@ -29,24 +29,36 @@ public:
     void setAllowedOrigins(const std::vector<std::string>& allowedOrigins) {
         allowedOrigins_ = allowedOrigins;
     }
+    void setAllowedOrigins(std::vector<std::string>&& allowedOrigins) {
+        allowedOrigins_ = std::move(allowedOrigins);
+    }
     const std::vector<std::string>& getAllowedMethods() const {
         return allowedMethods_;
     }
     void setAllowedMethods(const std::vector<std::string>& allowedMethods) {
         allowedMethods_ = allowedMethods;
     }
+    void setAllowedMethods(std::vector<std::string>&& allowedMethods) {
+        allowedMethods_ = std::move(allowedMethods);
+    }
     const std::vector<std::string>& getAllowedHeaders() const {
         return allowedHeaders_;
     }
     void setAllowedHeaders(const std::vector<std::string>& allowedHeaders) {
         allowedHeaders_ = allowedHeaders;
     }
+    void setAllowedHeaders(std::vector<std::string>&& allowedHeaders) {
+        allowedHeaders_ = std::move(allowedHeaders);
+    }
     const std::vector<std::string>& getExposeHeaders() const {
         return exposeHeaders_;
     }
     void setExposeHeaders(const std::vector<std::string>& exposeHeaders) {
         exposeHeaders_ = exposeHeaders;
     }
+    void setExposeHeaders(std::vector<std::string>&& exposeHeaders) {
+        exposeHeaders_ = std::move(exposeHeaders);
+    }
     int getMaxAgeSeconds() const {
         return maxAgeSeconds_;
     }
@@ -19,6 +19,9 @@ public:
     void setRules(const std::vector<FilterRule>& rules) {
         rules_ = rules;
     }
+    void setRules(std::vector<FilterRule>&& rules) {
+        rules_ = std::move(rules);
+    }
 
 private:
     std::vector<FilterRule> rules_;
@@ -18,6 +18,9 @@ public:
     void setRules(const std::vector<CORSRule>& rules) {
         rules_ = rules;
     }
+    void setRules(std::vector<CORSRule>&& rules) {
+        rules_ = std::move(rules);
+    }
 
     void fromJsonString(const std::string& input);
 
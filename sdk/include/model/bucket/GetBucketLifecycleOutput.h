@@ -20,6 +20,9 @@ public:
     void setRules(const std::vector<LifecycleRule>& rules) {
         rules_ = rules;
     }
+    void setRules(std::vector<LifecycleRule>&& rules) {
+        rules_ = std::move(rules);
+    }
 
     void fromJsonString(const std::string& input);
 
@@ -17,6 +17,9 @@ public:
     void setRules(const std::vector<MirrorBackRule>& rules) {
         rules_ = rules;
     }
+    void setRules(std::vector<MirrorBackRule>&& rules) {
+        rules_ = std::move(rules);
+    }
     void fromJsonString(const std::string& input);
 
 private:
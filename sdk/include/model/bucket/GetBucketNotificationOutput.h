@@ -22,12 +22,18 @@ public:
     void setCloudFunctionConfigurations(const std::vector<CloudFunctionConfiguration>& cloudFunctionConfigurations) {
         CloudFunctionConfigurations_ = cloudFunctionConfigurations;
     }
+    void setCloudFunctionConfigurations(std::vector<CloudFunctionConfiguration>&& cloudFunctionConfigurations) {
+        CloudFunctionConfigurations_ = std::move(cloudFunctionConfigurations);
+    }
     const std::vector<RocketMQConfiguration>& getRocketMqConfigurations() const {
         return rocketMQConfigurations_;
     }
     void setRocketMqConfigurations(const std::vector<RocketMQConfiguration>& rocketMqConfigurations) {
         rocketMQConfigurations_ = rocketMqConfigurations;
     }
+    void setRocketMqConfigurations(std::vector<RocketMQConfiguration>&& rocketMqConfigurations) {
+        rocketMQConfigurations_ = std::move(rocketMqConfigurations);
+    }
     void fromJsonString(const std::string& input);
 
 private:
@@ -21,6 +21,9 @@ public:
     void setRules(const std::vector<ReplicationRule>& rules) {
         rules_ = rules;
     }
+    void setRules(std::vector<ReplicationRule>&& rules) {
+        rules_ = std::move(rules);
+    }
 
     void fromJsonString(const std::string& input);
 
@@ -19,7 +19,7 @@ public:
     }
 
     void fromJsonString(const std::string& input);
-    const std::string& getStringFormatVersioningStatus() const {
+    std::string getStringFormatVersioningStatus() const {
         return VersioningStatusTypetoString[status_];
     }
 
@@ -42,6 +42,9 @@ public:
     void setRoutingRules(const std::vector<RoutingRule>& routingRules) {
         routingRules_ = routingRules;
     }
+    void setRoutingRules(std::vector<RoutingRule>&& routingRules) {
+        routingRules_ = std::move(routingRules);
+    }
 
     void fromJsonString(const std::string& input);
 
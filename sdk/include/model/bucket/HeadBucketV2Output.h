@@ -20,7 +20,7 @@ public:
     const StorageClassType& getStorageClass() const {
         return storageClass_;
     }
-    const std::string& getStringFormatStorageClass() const {
+    std::string getStringFormatStorageClass() const {
         return StorageClassTypetoString[storageClass_];
     }
     void setStorageClass(const StorageClassType& storageClass) {
@@ -32,7 +32,7 @@ public:
     void setAzRedundancy(AzRedundancyType azRedundancy) {
         azRedundancy_ = azRedundancy;
     }
-    const std::string& getStringFormatAzRedundancy() const {
+    std::string getStringFormatAzRedundancy() const {
         return AzRedundancyTypetoString[azRedundancy_];
     }
 
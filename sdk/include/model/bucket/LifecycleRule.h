@@ -45,7 +45,7 @@ public:
     StatusType getStatus() const {
         return status_;
     }
-    const std::string& getStringFormatStatus() const {
+    std::string getStringFormatStatus() const {
         return StatusTypetoString[status_];
     }
     void setStatus(StatusType status) {
@@ -57,6 +57,9 @@ public:
     void setTransitions(const std::vector<Transition>& transitions) {
         transitions_ = transitions;
     }
+    void setTransitions(std::vector<Transition>&& transitions) {
+        transitions_ = std::move(transitions);
+    }
     const std::shared_ptr<Expiration>& getExpiratioon() const {
         return expiration_;
     }
@@ -75,6 +78,9 @@ public:
     void setNoncurrentVersionTransitions(const std::vector<NoncurrentVersionTransition>& noncurrentVersionTransitions) {
         noncurrentVersionTransitions_ = noncurrentVersionTransitions;
     }
+    void setNoncurrentVersionTransitions(std::vector<NoncurrentVersionTransition>&& noncurrentVersionTransitions) {
+        noncurrentVersionTransitions_ = std::move(noncurrentVersionTransitions);
+    }
     const std::shared_ptr<NoncurrentVersionExpiration>& getNoncurrentVersionExpiration() const {
         return noncurrentVersionExpiration_;
     }
@@ -91,6 +97,9 @@ public:
     void setTags(const std::vector<Tag>& tags) {
         tags_ = tags;
     }
+    void setTags(std::vector<Tag>&& tags) {
+        tags_ = std::move(tags);
+    }
 
     const std::shared_ptr<AbortInCompleteMultipartUpload>& getAbortInCompleteMultipartUpload() const {
         return abortInCompleteMultipartUpload_;
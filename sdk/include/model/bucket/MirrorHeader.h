@@ -23,12 +23,18 @@ public:
     void setPass(const std::vector<std::string>& pass) {
         pass_ = pass;
     }
+    void setPass(std::vector<std::string>&& pass) {
+        pass_ = std::move(pass);
+    }
     const std::vector<std::string>& getRemove() const {
         return remove_;
     }
     void setRemove(const std::vector<std::string>& remove) {
         remove_ = remove;
     }
+    void setRemove(std::vector<std::string>&& remove) {
+        remove_ = std::move(remove);
+    }
 
 private:
     bool passAll_ = false;
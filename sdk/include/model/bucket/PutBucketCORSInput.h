@@ -26,6 +26,9 @@ public:
     void setRules(const std::vector<CORSRule>& rules) {
         rules_ = rules;
     }
+    void setRules(std::vector<CORSRule>&& rules) {
+        rules_ = std::move(rules);
+    }
     std::string toJsonString() const;
 
 private:
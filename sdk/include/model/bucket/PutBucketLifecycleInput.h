@@ -28,6 +28,9 @@ public:
     void setRules(const std::vector<LifecycleRule>& rules) {
         rules_ = rules;
     }
+    void setRules(std::vector<LifecycleRule>&& rules) {
+        rules_ = std::move(rules);
+    }
 
     std::string toJsonString() const;
 
@@ -28,6 +28,9 @@ public:
     void setRules(const std::vector<MirrorBackRule>& rules) {
         rules_ = rules;
     }
+    void setRules(std::vector<MirrorBackRule>&& rules) {
+        rules_ = std::move(rules);
+    }
     std::string toJsonString() const;
 
 private:
@@ -32,6 +32,9 @@ public:
     void setCloudFunctionConfigurations(const std::vector<CloudFunctionConfiguration>& cloudFunctionConfigurations) {
         cloudFunctionConfigurations_ = cloudFunctionConfigurations;
     }
+    void setCloudFunctionConfigurations(std::vector<CloudFunctionConfiguration>&& cloudFunctionConfigurations) {
+        cloudFunctionConfigurations_ = std::move(cloudFunctionConfigurations);
+    }
     std::string toJsonString() const;
 
 private:
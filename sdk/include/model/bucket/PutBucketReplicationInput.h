@@ -35,6 +35,9 @@ public:
     void setRules(const std::vector<ReplicationRule>& rules) {
         rules_ = rules;
     }
+    void setRules(std::vector<ReplicationRule>&& rules) {
+        rules_ = std::move(rules);
+    }
     std::string toJsonString() const;
 
 private:
@@ -65,6 +65,9 @@ public:
     void setRoutingRules(const std::vector<RoutingRule>& routingRules) {
         routingRules_ = routingRules;
     }
+    void setRoutingRules(std::vector<RoutingRule>&& routingRules) {
+        routingRules_ = std::move(routingRules);
+    }
     std::string toJsonString() const;
 
 private:
@@ -56,7 +56,7 @@ public:
     void setPublicSource(const PublicSource& publicSource) {
         publicSource_ = publicSource;
     }
-    const std::string& getStringFormatRedirectType() const {
+    std::string getStringFormatRedirectType() const {
         return RedirectTypetoString[redirectType_];
     }
     const Transform& getTransform() const {
@@ -48,6 +48,9 @@ public:
     void setPrefixSet(const std::vector<std::string>& prefixSet) {
         prefixSet_ = prefixSet;
     }
+    void setPrefixSet(std::vector<std::string>&& prefixSet) {
+        prefixSet_ = std::move(prefixSet);
+    }
     const Destination& getDestination() const {
         return destination_;
     }
@@ -32,6 +32,9 @@ public:
     void setEvents(const std::vector<std::string>& events) {
         events_ = events;
     }
+    void setEvents(std::vector<std::string>&& events) {
+        events_ = std::move(events);
+    }
     const Filter& getFilter() const {
         return filter_;
     }
@@ -18,6 +18,9 @@ public:
     void setRules(const std::vector<RoutingRule>& rules) {
         rules_ = rules;
     }
+    void setRules(std::vector<RoutingRule>&& rules) {
+        rules_ = std::move(rules);
+    }
 
 private:
     std::vector<RoutingRule> rules_;
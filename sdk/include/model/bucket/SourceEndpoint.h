@@ -17,12 +17,18 @@ public:
     void setPrimary(const std::vector<std::string>& primary) {
         primary_ = primary;
     }
+    void setPrimary(std::vector<std::string>&& primary) {
+        primary_ = std::move(primary);
+    }
     const std::vector<std::string>& getFollower() const {
         return follower_;
     }
     void setFollower(const std::vector<std::string>& follower) {
         follower_ = follower;
     }
+    void setFollower(std::vector<std::string>&& follower) {
+        follower_ = std::move(follower);
+    }
 
 private:
     std::vector<std::string> primary_;
@@ -30,7 +30,7 @@ public:
     void setStorageClass(StorageClassType storageClass) {
         storageClass_ = storageClass;
     }
-    const std::string& getStringFormatStorageClass() const {
+    std::string getStringFormatStorageClass() const {
         return StorageClassTypetoString[storageClass_];
     }
 
@@ -28,6 +28,9 @@ public:
     void setParts(const std::vector<InnerUploadedPart>& parts) {
         parts_ = parts;
     }
+    void setParts(std::vector<InnerUploadedPart>&& parts) {
+        parts_ = std::move(parts);
+    }
     void sort() {
         std::sort(parts_.begin(), parts_.end(), compareByPartNumber);
     }
@@ -67,6 +70,9 @@ public:
     void setUploadedParts(const std::vector<UploadPartOutput>& uploadedParts) {
         uploadedParts_ = uploadedParts;
     }
+    void setUploadedParts(std::vector<UploadPartOutput>&& uploadedParts) {
+        uploadedParts_ = std::move(uploadedParts);
+    }
 
 private:
     std::string key_;
@@ -103,6 +109,9 @@ public:
     void setUploadedParts(const std::vector<UploadPartCopyOutput>& uploadedParts) {
         uploadedParts_ = uploadedParts;
     }
+    void setUploadedParts(std::vector<UploadPartCopyOutput>&& uploadedParts) {
+        uploadedParts_ = std::move(uploadedParts);
+    }
 
 private:
     std::string key_;
@@ -44,6 +44,9 @@ public:
     void setParts(const std::vector<UploadedPartV2>& parts) {
         parts_ = parts;
     }
+    void setParts(std::vector<UploadedPartV2>&& parts) {
+        parts_ = std::move(parts);
+    }
     bool isCompleteAll() const {
         return completeAll_;
     }
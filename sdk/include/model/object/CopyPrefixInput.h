@@ -0,0 +1,118 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include "Type.h"
+#include "CopyPrefixResult.h"
+
+namespace VolcengineTos {
+// 把源对象名映射为目标对象名，返回空字符串时跳过该对象
+using CopyKeyMapper = std::function<std::string(const std::string& srcKey)>;
+// 每个对象处理完成时回调，会在多个线程中并发调用
+using CopyResultCallback = std::function<void(const CopyPrefixResult& result)>;
+
+class CopyPrefixInput {
+public:
+    CopyPrefixInput(std::string srcBucket, std::string srcPrefix, std::string bucket, std::string prefix)
+            : srcBucket_(std::move(srcBucket)),
+              srcPrefix_(std::move(srcPrefix)),
+              bucket_(std::move(bucket)),
+              prefix_(std::move(prefix)) {
+    }
+    CopyPrefixInput() = default;
+    ~CopyPrefixInput() = default;
+    const std::string& getSrcBucket() const {
+        return srcBucket_;
+    }
+    void setSrcBucket(const std::string& srcbucket) {
+        srcBucket_ = srcbucket;
+    }
+    const std::string& getSrcPrefix() const {
+        return srcPrefix_;
+    }
+    void setSrcPrefix(const std::string& srcprefix) {
+        srcPrefix_ = srcprefix;
+    }
+    const std::string& getBucket() const {
+        return bucket_;
+    }
+    void setBucket(const std::string& bucket) {
+        bucket_ = bucket;
+    }
+    const std::string& getPrefix() const {
+        return prefix_;
+    }
+    void setPrefix(const std::string& prefix) {
+        prefix_ = prefix;
+    }
+    const CopyKeyMapper& getKeyMapper() const {
+        return keyMapper_;
+    }
+    void setKeyMapper(const CopyKeyMapper& keymapper) {
+        keyMapper_ = keymapper;
+    }
+    int getTaskNum() const {
+        return taskNum_;
+    }
+    void setTaskNum(int tasknum) {
+        taskNum_ = tasknum;
+    }
+    int64_t getPartSize() const {
+        return partSize_;
+    }
+    void setPartSize(int64_t partsize) {
+        partSize_ = partsize;
+    }
+    int64_t getMultipartThreshold() const {
+        return multipartThreshold_;
+    }
+    void setMultipartThreshold(int64_t multipartthreshold) {
+        multipartThreshold_ = multipartthreshold;
+    }
+    bool isDeleteSource() const {
+        return deleteSource_;
+    }
+    void setDeleteSource(bool deletesource) {
+        deleteSource_ = deletesource;
+    }
+    const std::string& getJournalFile() const {
+        return journalFile_;
+    }
+    void setJournalFile(const std::string& journalfile) {
+        journalFile_ = journalfile;
+    }
+    const CopyResultCallback& getResultCallback() const {
+        return resultCallback_;
+    }
+    void setResultCallback(const CopyResultCallback& resultcallback) {
+        resultCallback_ = resultcallback;
+    }
+    const std::shared_ptr<CancelHook>& getCancelHook() const {
+        return cancelHook_;
+    }
+    void setCancelHook(const std::shared_ptr<CancelHook>& cancelhook) {
+        cancelHook_ = cancelhook;
+    }
+
+private:
+    std::string srcBucket_;
+    std::string srcPrefix_;
+    std::string bucket_;
+    // 未设置 keyMapper 时目标对象名为 prefix + 源对象名去掉 srcPrefix 的部分
+    std::string prefix_;
+    CopyKeyMapper keyMapper_ = nullptr;
+    // 所有对象共享的并发数，包括 copyObject 和大对象的 uploadPartCopy
+    int taskNum_ = 16;
+    int64_t partSize_ = 64 * 1024 * 1024;  // 默认64MB分片大小
+    // 大于该大小的对象使用 uploadPartCopy 并发复制，超过 5GB 的对象总是分片复制
+    int64_t multipartThreshold_ = 512 * 1024 * 1024;
+    // 复制成功并校验后删除源对象，即移动
+    bool deleteSource_ = false;
+    // 记录已完成的对象和分片，重新执行时跳过，为空时不记录
+    std::string journalFile_;
+    CopyResultCallback resultCallback_ = nullptr;
+    std::shared_ptr<CancelHook> cancelHook_ = nullptr;
+};
+}  // namespace VolcengineTos
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace VolcengineTos {
+class CopyPrefixOutput {
+public:
+    const std::string& getBucket() const {
+        return bucket_;
+    }
+    void setBucket(const std::string& bucket) {
+        bucket_ = bucket;
+    }
+    int64_t getListedObjects() const {
+        return listedObjects_;
+    }
+    void setListedObjects(int64_t listedobjects) {
+        listedObjects_ = listedobjects;
+    }
+    int64_t getCopiedObjects() const {
+        return copiedObjects_;
+    }
+    void setCopiedObjects(int64_t copiedobjects) {
+        copiedObjects_ = copiedobjects;
+    }
+    int64_t getCopiedBytes() const {
+        return copiedBytes_;
+    }
+    void setCopiedBytes(int64_t copiedbytes) {
+        copiedBytes_ = copiedbytes;
+    }
+    int64_t getSkippedObjects() const {
+        return skippedObjects_;
+    }
+    void setSkippedObjects(int64_t skippedobjects) {
+        skippedObjects_ = skippedobjects;
+    }
+    int64_t getMultipartObjects() const {
+        return multipartObjects_;
+    }
+    void setMultipartObjects(int64_t multipartobjects) {
+        multipartObjects_ = multipartobjects;
+    }
+    int64_t getDeletedObjects() const {
+        return deletedObjects_;
+    }
+    void setDeletedObjects(int64_t deletedobjects) {
+        deletedObjects_ = deletedobjects;
+    }
+
+private:
+    std::string bucket_;
+    int64_t listedObjects_ = 0;
+    int64_t copiedObjects_ = 0;
+    int64_t copiedBytes_ = 0;
+    // keyMapper 返回空或 journal 中已完成而跳过复制的对象数
+    int64_t skippedObjects_ = 0;
+    // 使用 uploadPartCopy 分片复制的对象数
+    int64_t multipartObjects_ = 0;
+    int64_t deletedObjects_ = 0;
+};
+}  // namespace VolcengineTos
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "TosError.h"
+
+namespace VolcengineTos {
+// copyPrefix 中单个对象的结果
+class CopyPrefixResult {
+public:
+    const std::string& getSrcKey() const {
+        return srcKey_;
+    }
+    void setSrcKey(const std::string& srckey) {
+        srcKey_ = srckey;
+    }
+    const std::string& getKey() const {
+        return key_;
+    }
+    void setKey(const std::string& key) {
+        key_ = key;
+    }
+    int64_t getSize() const {
+        return size_;
+    }
+    void setSize(int64_t size) {
+        size_ = size;
+    }
+    bool isSuccess() const {
+        return success_;
+    }
+    void setSuccess(bool success) {
+        success_ = success;
+    }
+    bool isSkipped() const {
+        return skipped_;
+    }
+    void setSkipped(bool skipped) {
+        skipped_ = skipped;
+    }
+    bool isSourceDeleted() const {
+        return sourceDeleted_;
+    }
+    void setSourceDeleted(bool sourcedeleted) {
+        sourceDeleted_ = sourcedeleted;
+    }
+    const TosError& getError() const {
+        return error_;
+    }
+    void setError(const TosError& error) {
+        error_ = error;
+    }
+
+private:
+    std::string srcKey_;
+    std::string key_;
+    int64_t size_ = 0;
+    bool success_ = false;
+    // journal 中已记录复制完成，本次没有再复制
+    bool skipped_ = false;
+    bool sourceDeleted_ = false;
+    TosError error_;
+};
+}  // namespace VolcengineTos
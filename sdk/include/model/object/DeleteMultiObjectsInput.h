@@ -12,6 +12,9 @@ public:
     void setObjectTobeDeleteds(const std::vector<ObjectTobeDeleted>& objectTobeDeleteds) {
         objectTobeDeleteds_ = objectTobeDeleteds;
     }
+    void setObjectTobeDeleteds(std::vector<ObjectTobeDeleted>&& objectTobeDeleteds) {
+        objectTobeDeleteds_ = std::move(objectTobeDeleteds);
+    }
     bool isQuiet() const {
         return quiet_;
     }
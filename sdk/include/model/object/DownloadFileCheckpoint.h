@@ -80,6 +80,9 @@ public:
     void setPartsInfo(const std::vector<DownloadFilePartInfo>& partsinfo) {
         partsInfo_ = partsinfo;
     }
+    void setPartsInfo(std::vector<DownloadFilePartInfo>&& partsinfo) {
+        partsInfo_ = std::move(partsinfo);
+    }
     const std::string& getIfNoneMatch() const {
         return ifNoneMatch_;
     }
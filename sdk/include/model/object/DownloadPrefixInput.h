@@ -0,0 +1,79 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include "Type.h"
+
+namespace VolcengineTos {
+class DownloadPrefixInput {
+public:
+    DownloadPrefixInput(std::string bucket, std::string prefix, std::string directory)
+            : bucket_(std::move(bucket)), prefix_(std::move(prefix)), directory_(std::move(directory)) {
+    }
+    DownloadPrefixInput() = default;
+    ~DownloadPrefixInput() = default;
+    const std::string& getBucket() const {
+        return bucket_;
+    }
+    void setBucket(const std::string& bucket) {
+        bucket_ = bucket;
+    }
+    const std::string& getPrefix() const {
+        return prefix_;
+    }
+    void setPrefix(const std::string& prefix) {
+        prefix_ = prefix;
+    }
+    const std::string& getDirectory() const {
+        return directory_;
+    }
+    void setDirectory(const std::string& directory) {
+        directory_ = directory;
+    }
+    int getTaskNum() const {
+        return taskNum_;
+    }
+    void setTaskNum(int tasknum) {
+        taskNum_ = tasknum;
+    }
+    int64_t getPartSize() const {
+        return partSize_;
+    }
+    void setPartSize(int64_t partsize) {
+        partSize_ = partsize;
+    }
+    int64_t getParallelThreshold() const {
+        return parallelThreshold_;
+    }
+    void setParallelThreshold(int64_t parallelthreshold) {
+        parallelThreshold_ = parallelthreshold;
+    }
+    int64_t getMaxInflightBytes() const {
+        return maxInflightBytes_;
+    }
+    void setMaxInflightBytes(int64_t maxinflightbytes) {
+        maxInflightBytes_ = maxinflightbytes;
+    }
+    const std::shared_ptr<CancelHook>& getCancelHook() const {
+        return cancelHook_;
+    }
+    void setCancelHook(const std::shared_ptr<CancelHook>& cancelhook) {
+        cancelHook_ = cancelhook;
+    }
+
+private:
+    std::string bucket_;
+    // 前缀下的对象下载到 directory + 去掉前缀后的对象名
+    std::string prefix_;
+    std::string directory_;
+    // 整个前缀共享的并发数
+    int taskNum_ = 8;
+    int64_t partSize_ = 20 * 1024 * 1024;  // 默认20MB分片大小
+    // 大于该大小的对象按 partSize 并发范围下载
+    int64_t parallelThreshold_ = 20 * 1024 * 1024;
+    // 同时在下载中的字节数上限，单个分片或对象超过上限时单独下载
+    int64_t maxInflightBytes_ = 256 * 1024 * 1024;
+    std::shared_ptr<CancelHook> cancelHook_ = nullptr;
+};
+}  // namespace VolcengineTos
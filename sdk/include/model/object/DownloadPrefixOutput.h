@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace VolcengineTos {
+class DownloadPrefixOutput {
+public:
+    const std::string& getBucket() const {
+        return bucket_;
+    }
+    void setBucket(const std::string& bucket) {
+        bucket_ = bucket;
+    }
+    int64_t getListedObjects() const {
+        return listedObjects_;
+    }
+    void setListedObjects(int64_t listedobjects) {
+        listedObjects_ = listedobjects;
+    }
+    int64_t getDownloadedFiles() const {
+        return downloadedFiles_;
+    }
+    void setDownloadedFiles(int64_t downloadedfiles) {
+        downloadedFiles_ = downloadedfiles;
+    }
+    int64_t getDownloadedBytes() const {
+        return downloadedBytes_;
+    }
+    void setDownloadedBytes(int64_t downloadedbytes) {
+        downloadedBytes_ = downloadedbytes;
+    }
+    int64_t getParallelFiles() const {
+        return parallelFiles_;
+    }
+    void setParallelFiles(int64_t parallelfiles) {
+        parallelFiles_ = parallelfiles;
+    }
+
+private:
+    std::string bucket_;
+    int64_t listedObjects_ = 0;
+    int64_t downloadedFiles_ = 0;
+    int64_t downloadedBytes_ = 0;
+    // 使用并发范围下载的对象数
+    int64_t parallelFiles_ = 0;
+};
+}  // namespace VolcengineTos
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace VolcengineTos {
+// 把整个对象下载到调用方提供的 buffer 中，buffer 不小于对象大小
+class DownloadToBufferInput {
+public:
+    DownloadToBufferInput(std::string bucket, std::string key, char* buffer, int64_t bufferSize)
+            : bucket_(std::move(bucket)), key_(std::move(key)), buffer_(buffer), bufferSize_(bufferSize) {
+    }
+    DownloadToBufferInput() = default;
+    ~DownloadToBufferInput() = default;
+    const std::string& getBucket() const {
+        return bucket_;
+    }
+    void setBucket(const std::string& bucket) {
+        bucket_ = bucket;
+    }
+    const std::string& getKey() const {
+        return key_;
+    }
+    void setKey(const std::string& key) {
+        key_ = key;
+    }
+    const std::string& getVersionId() const {
+        return versionID_;
+    }
+    void setVersionId(const std::string& versionid) {
+        versionID_ = versionid;
+    }
+    char* getBuffer() const {
+        return buffer_;
+    }
+    void setBuffer(char* buffer) {
+        buffer_ = buffer;
+    }
+    int64_t getBufferSize() const {
+        return bufferSize_;
+    }
+    void setBufferSize(int64_t buffersize) {
+        bufferSize_ = buffersize;
+    }
+    int64_t getPartSize() const {
+        return partSize_;
+    }
+    void setPartSize(int64_t partsize) {
+        partSize_ = partsize;
+    }
+    int getTaskNum() const {
+        return taskNum_;
+    }
+    void setTaskNum(int tasknum) {
+        taskNum_ = tasknum;
+    }
+
+private:
+    std::string bucket_;
+    std::string key_;
+    std::string versionID_;
+    char* buffer_ = nullptr;
+    int64_t bufferSize_ = 0;
+    // 每个范围请求的大小
+    int64_t partSize_ = 8 * 1024 * 1024;
+    int taskNum_ = 8;
+};
+}  // namespace VolcengineTos
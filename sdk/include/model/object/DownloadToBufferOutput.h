@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "model/RequestInfo.h"
+
+namespace VolcengineTos {
+class DownloadToBufferOutput {
+public:
+    const RequestInfo& getRequestInfo() const {
+        return requestInfo_;
+    }
+    void setRequestInfo(const RequestInfo& requestinfo) {
+        requestInfo_ = requestinfo;
+    }
+    const std::string& getETag() const {
+        return eTag_;
+    }
+    void setETag(const std::string& etag) {
+        eTag_ = etag;
+    }
+    const std::string& getVersionId() const {
+        return versionID_;
+    }
+    void setVersionId(const std::string& versionid) {
+        versionID_ = versionid;
+    }
+    int64_t getContentLength() const {
+        return contentLength_;
+    }
+    void setContentLength(int64_t contentlength) {
+        contentLength_ = contentlength;
+    }
+    uint64_t getHashCrc64ecma() const {
+        return hashCrc64ecma_;
+    }
+    void setHashCrc64ecma(uint64_t hashcrc64ecma) {
+        hashCrc64ecma_ = hashcrc64ecma;
+    }
+    int getRequestCount() const {
+        return requestCount_;
+    }
+    void setRequestCount(int requestcount) {
+        requestCount_ = requestcount;
+    }
+
+private:
+    RequestInfo requestInfo_;
+    std::string eTag_;
+    std::string versionID_;
+    // 写入 buffer 的字节数，即对象大小
+    int64_t contentLength_ = 0;
+    // 由各个范围的 CRC64 合并得到
+    uint64_t hashCrc64ecma_ = 0;
+    int requestCount_ = 0;
+};
+}  // namespace VolcengineTos
@@ -135,7 +135,7 @@ public:
     }
     void fromResponse(TosResponse& res);
 
-    const std::string& getStringFormatStorageClass() const {
+    std::string getStringFormatStorageClass() const {
         return StorageClassTypetoString[storageClass_];
     }
 
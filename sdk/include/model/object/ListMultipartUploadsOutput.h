@@ -76,12 +76,18 @@ public:
     void setUpload(const std::vector<UploadInfo>& upload) {
         upload_ = upload;
     }
+    void setUpload(std::vector<UploadInfo>&& upload) {
+        upload_ = std::move(upload);
+    }
     const std::vector<UploadCommonPrefix>& getCommonPrefixes() const {
         return commonPrefixes_;
     }
     void setCommonPrefixes(const std::vector<UploadCommonPrefix>& commonPrefixes) {
         commonPrefixes_ = commonPrefixes;
     }
+    void setCommonPrefixes(std::vector<UploadCommonPrefix>&& commonPrefixes) {
+        commonPrefixes_ = std::move(commonPrefixes);
+    }
 
 private:
     RequestInfo requestInfo_;
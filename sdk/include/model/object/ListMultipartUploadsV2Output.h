@@ -75,12 +75,18 @@ public:
     void setUploads(const std::vector<ListedUpload>& uploads) {
         uploads_ = uploads;
     }
+    void setUploads(std::vector<ListedUpload>&& uploads) {
+        uploads_ = std::move(uploads);
+    }
     const std::vector<ListedCommonPrefix>& getCommonPrefixes() const {
         return commonPrefixes_;
     }
     void setCommonPrefixes(const std::vector<ListedCommonPrefix>& commonprefixes) {
         commonPrefixes_ = commonprefixes;
     }
+    void setCommonPrefixes(std::vector<ListedCommonPrefix>&& commonprefixes) {
+        commonPrefixes_ = std::move(commonprefixes);
+    }
     void fromJsonString(const std::string& input);
 
 private:
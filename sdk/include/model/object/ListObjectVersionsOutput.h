@@ -81,18 +81,27 @@ public:
     void setCommonPrefixes(const std::vector<ListedCommonPrefix>& commonPrefixes) {
         commonPrefixes_ = commonPrefixes;
     }
+    void setCommonPrefixes(std::vector<ListedCommonPrefix>&& commonPrefixes) {
+        commonPrefixes_ = std::move(commonPrefixes);
+    }
     const std::vector<ListedObjectVersion>& getVersions() const {
         return versions_;
     }
     void setVersions(const std::vector<ListedObjectVersion>& versions) {
         versions_ = versions;
     }
+    void setVersions(std::vector<ListedObjectVersion>&& versions) {
+        versions_ = std::move(versions);
+    }
     const std::vector<ListedDeleteMarkerEntry>& getDeleteMarkers() const {
         return deleteMarkers_;
     }
     void setDeleteMarkers(const std::vector<ListedDeleteMarkerEntry>& deleteMarkers) {
         deleteMarkers_ = deleteMarkers;
     }
+    void setDeleteMarkers(std::vector<ListedDeleteMarkerEntry>&& deleteMarkers) {
+        deleteMarkers_ = std::move(deleteMarkers);
+    }
 
 private:
     RequestInfo requestInfo_;
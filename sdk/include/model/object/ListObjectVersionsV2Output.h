@@ -81,18 +81,27 @@ public:
     void setCommonPrefixes(const std::vector<ListedCommonPrefix>& commonPrefixes) {
         commonPrefixes_ = commonPrefixes;
     }
+    void setCommonPrefixes(std::vector<ListedCommonPrefix>&& commonPrefixes) {
+        commonPrefixes_ = std::move(commonPrefixes);
+    }
     const std::vector<ListedObjectVersionV2>& getVersions() const {
         return versions_;
     }
     void setVersions(const std::vector<ListedObjectVersionV2>& versions) {
         versions_ = versions;
     }
+    void setVersions(std::vector<ListedObjectVersionV2>&& versions) {
+        versions_ = std::move(versions);
+    }
     const std::vector<ListedDeleteMarker>& getDeleteMarkers() const {
         return deleteMarkers_;
     }
     void setDeleteMarkers(const std::vector<ListedDeleteMarker>& deleteMarkers) {
         deleteMarkers_ = deleteMarkers;
     }
+    void setDeleteMarkers(std::vector<ListedDeleteMarker>&& deleteMarkers) {
+        deleteMarkers_ = std::move(deleteMarkers);
+    }
 
 private:
     RequestInfo requestInfo_;
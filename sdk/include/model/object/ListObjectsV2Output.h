@@ -68,12 +68,18 @@ public:
     void setCommonPrefixes(const std::vector<ListedCommonPrefix>& commonPrefixes) {
         commonPrefixes_ = commonPrefixes;
     }
+    void setCommonPrefixes(std::vector<ListedCommonPrefix>&& commonPrefixes) {
+        commonPrefixes_ = std::move(commonPrefixes);
+    }
     const std::vector<ListedObjectV2>& getContents() const {
         return contents_;
     }
     void setContents(const std::vector<ListedObjectV2>& contents) {
         contents_ = contents;
     }
+    void setContents(std::vector<ListedObjectV2>&& contents) {
+        contents_ = std::move(contents);
+    }
 
 private:
     RequestInfo requestInfo_;
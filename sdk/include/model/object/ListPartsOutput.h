@@ -76,6 +76,9 @@ public:
     void setParts(const std::vector<UploadedPartV2>& parts) {
         parts_ = parts;
     }
+    void setParts(std::vector<UploadedPartV2>&& parts) {
+        parts_ = std::move(parts);
+    }
 
     void fromJsonString(const std::string& input);
 
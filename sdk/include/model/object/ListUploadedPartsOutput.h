@@ -74,6 +74,9 @@ public:
     void setUploadedParts(const std::vector<UploadedPart>& uploadedParts) {
         uploadedParts_ = uploadedParts;
     }
+    void setUploadedParts(std::vector<UploadedPart>&& uploadedParts) {
+        uploadedParts_ = std::move(uploadedParts);
+    }
 
 private:
     RequestInfo requestInfo_;
@@ -11,6 +11,9 @@ public:
     void setPrefix(const std::string& prefix) {
         prefix_ = prefix;
     }
+    void setPrefix(std::string&& prefix) {
+        prefix_ = std::move(prefix);
+    }
 
     bool operator==(const ListedCommonPrefix& rhs) const {
         return prefix_ == rhs.prefix_;
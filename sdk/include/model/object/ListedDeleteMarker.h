@@ -17,6 +17,9 @@ public:
     void setKey(const std::string& key) {
         key_ = key;
     }
+    void setKey(std::string&& key) {
+        key_ = std::move(key);
+    }
     time_t getLastModified() const {
         return lastModified_;
     }
@@ -29,12 +32,18 @@ public:
     void setOwner(const Owner& owner) {
         owner_ = owner;
     }
+    void setOwner(Owner&& owner) {
+        owner_ = std::move(owner);
+    }
     const std::string& getVersionId() const {
         return versionID_;
     }
     void setVersionId(const std::string& versionid) {
         versionID_ = versionid;
     }
+    void setVersionId(std::string&& versionid) {
+        versionID_ = std::move(versionid);
+    }
     std::string getStringFormatLastModified() const {
         auto lastModified = lastModified_;
         return TimeUtils::transLastModifiedTimeToString(lastModified);
@@ -17,24 +17,36 @@ public:
     void setKey(const std::string& key) {
         key_ = key;
     }
+    void setKey(std::string&& key) {
+        key_ = std::move(key);
+    }
     const std::string& getLastModified() const {
         return lastModified_;
     }
     void setLastModified(const std::string& lastModified) {
         lastModified_ = lastModified;
     }
+    void setLastModified(std::string&& lastModified) {
+        lastModified_ = std::move(lastModified);
+    }
     const Owner& getOwner() const {
         return owner_;
     }
     void setOwner(const Owner& owner) {
         owner_ = owner;
     }
+    void setOwner(Owner&& owner) {
+        owner_ = std::move(owner);
+    }
     const std::string& getVersionId() const {
         return versionID_;
     }
     void setVersionId(const std::string& versionId) {
         versionID_ = versionId;
     }
+    void setVersionId(std::string&& versionId) {
+        versionID_ = std::move(versionId);
+    }
 
 private:
     bool isLatest_;
@@ -11,18 +11,27 @@ public:
     void setKey(const std::string& key) {
         key_ = key;
     }
+    void setKey(std::string&& key) {
+        key_ = std::move(key);
+    }
     const std::string& getLastModified() const {
         return lastModified_;
     }
     void setLastModified(const std::string& lastModified) {
         lastModified_ = lastModified;
     }
+    void setLastModified(std::string&& lastModified) {
+        lastModified_ = std::move(lastModified);
+    }
     const std::string& getEtag() const {
         return etag_;
     }
     void setEtag(const std::string& etag) {
         etag_ = etag;
     }
+    void setEtag(std::string&& etag) {
+        etag_ = std::move(etag);
+    }
     int64_t getSize() const {
         return size_;
     }
@@ -35,18 +44,27 @@ public:
     void setOwner(const Owner& owner) {
         owner_ = owner;
     }
+    void setOwner(Owner&& owner) {
+        owner_ = std::move(owner);
+    }
     const std::string& getStorageClass() const {
         return storageClass_;
     }
     void setStorageClass(const std::string& storageClass) {
         storageClass_ = storageClass;
     }
+    void setStorageClass(std::string&& storageClass) {
+        storageClass_ = std::move(storageClass);
+    }
     const std::string& getType() const {
         return type_;
     }
     void setType(const std::string& type) {
         type_ = type;
     }
+    void setType(std::string&& type) {
+        type_ = std::move(type);
+    }
 
 private:
     std::string key_;
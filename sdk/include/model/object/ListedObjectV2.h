@@ -13,6 +13,9 @@ public:
     void setKey(const std::string& key) {
         key_ = key;
     }
+    void setKey(std::string&& key) {
+        key_ = std::move(key);
+    }
     time_t getLastModified() const {
         return lastModified_;
     }
@@ -25,6 +28,9 @@ public:
     void setETag(const std::string& etag) {
         eTag_ = etag;
     }
+    void setETag(std::string&& etag) {
+        eTag_ = std::move(etag);
+    }
     int64_t getSize() const {
         return size_;
     }
@@ -37,6 +43,9 @@ public:
     void setOwner(const Owner& owner) {
         owner_ = owner;
     }
+    void setOwner(Owner&& owner) {
+        owner_ = std::move(owner);
+    }
     StorageClassType getStorageClass() const {
         return storageClass_;
     }
@@ -51,7 +60,7 @@ public:
     }
 
     //    static ListedObjectV2 parseListedObjectV2(const nlohmann::json& object);
-    const std::string& getStringFormatStorageClass() const {
+    std::string getStringFormatStorageClass() const {
         return StorageClassTypetoString[storageClass_];
     }
     std::string getStringFormatLastModified() const {
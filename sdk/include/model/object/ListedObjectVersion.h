@@ -11,6 +11,9 @@ public:
     void setEtag(const std::string& etag) {
         etag_ = etag;
     }
+    void setEtag(std::string&& etag) {
+        etag_ = std::move(etag);
+    }
     bool isLatest() const {
         return isLatest_;
     }
@@ -23,18 +26,27 @@ public:
     void setKey(const std::string& key) {
         key_ = key;
     }
+    void setKey(std::string&& key) {
+        key_ = std::move(key);
+    }
     const std::string& getLastModified() const {
         return lastModified_;
     }
     void setLastModified(const std::string& lastModified) {
         lastModified_ = lastModified;
     }
+    void setLastModified(std::string&& lastModified) {
+        lastModified_ = std::move(lastModified);
+    }
     const Owner& getOwner() const {
         return owner_;
     }
     void setOwner(const Owner& owner) {
         owner_ = owner;
     }
+    void setOwner(Owner&& owner) {
+        owner_ = std::move(owner);
+    }
     int64_t getSize() const {
         return size_;
     }
@@ -47,18 +59,27 @@ public:
     void setStorageClass(const std::string& storageClass) {
         storageClass_ = storageClass;
     }
+    void setStorageClass(std::string&& storageClass) {
+        storageClass_ = std::move(storageClass);
+    }
     const std::string& getType() const {
         return type_;
     }
     void setType(const std::string& type) {
         type_ = type;
     }
+    void setType(std::string&& type) {
+        type_ = std::move(type);
+    }
     const std::string& getVersionId() const {
         return versionID_;
     }
     void setVersionId(const std::string& versionId) {
         versionID_ = versionId;
     }
+    void setVersionId(std::string&& versionId) {
+        versionID_ = std::move(versionId);
+    }
 
 private:
     std::string etag_;
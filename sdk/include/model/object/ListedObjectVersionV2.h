@@ -13,6 +13,9 @@ public:
     void setKey(const std::string& key) {
         key_ = key;
     }
+    void setKey(std::string&& key) {
+        key_ = std::move(key);
+    }
     time_t getLastModified() const {
         return lastModified_;
     }
@@ -25,6 +28,9 @@ public:
     void setETag(const std::string& etag) {
         eTag_ = etag;
     }
+    void setETag(std::string&& etag) {
+        eTag_ = std::move(etag);
+    }
     bool isLatest() const {
         return isLatest_;
     }
@@ -43,6 +49,9 @@ public:
     void setOwner(const Owner& owner) {
         owner_ = owner;
     }
+    void setOwner(Owner&& owner) {
+        owner_ = std::move(owner);
+    }
     StorageClassType getStorageClass() const {
         return storageClass_;
     }
@@ -55,13 +64,16 @@ public:
     void setVersionId(const std::string& versionid) {
         versionID_ = versionid;
     }
+    void setVersionId(std::string&& versionid) {
+        versionID_ = std::move(versionid);
+    }
     uint64_t getHashCrc64Ecma() const {
         return hashCrc64ecma_;
     }
     void setHashCrc64Ecma(uint64_t hashcrc64ecma) {
         hashCrc64ecma_ = hashcrc64ecma;
     }
-    const std::string& getStringFormatStorageClass() const {
+    std::string getStringFormatStorageClass() const {
         return StorageClassTypetoString[storageClass_];
     }
     std::string getStringFormatLastModified() const {
@@ -13,18 +13,27 @@ public:
     void setKey(const std::string& key) {
         key_ = key;
     }
+    void setKey(std::string&& key) {
+        key_ = std::move(key);
+    }
     const std::string& getUploadId() const {
         return uploadID_;
     }
     void setUploadId(const std::string& uploadid) {
         uploadID_ = uploadid;
     }
+    void setUploadId(std::string&& uploadid) {
+        uploadID_ = std::move(uploadid);
+    }
     const Owner& getOwner() const {
         return owner_;
     }
     void setOwner(const Owner& owner) {
         owner_ = owner;
     }
+    void setOwner(Owner&& owner) {
+        owner_ = std::move(owner);
+    }
     StorageClassType getStorageClass() const {
         return storageClass_;
     }
@@ -37,7 +46,7 @@ public:
     void setInitiated(time_t initiated) {
         initiated_ = initiated;
     }
-    const std::string& getStringFormatStorageClass() const {
+    std::string getStringFormatStorageClass() const {
         return StorageClassTypetoString[storageClass_];
     }
     std::string getStringFormatInitiated() const {
@@ -16,6 +16,9 @@ public:
     void setConditions(const std::vector<PostSignatureConditionInner>& conditions) {
         conditions_ = conditions;
     }
+    void setConditions(std::vector<PostSignatureConditionInner>&& conditions) {
+        conditions_ = std::move(conditions);
+    }
     const std::string& getExpiration() const {
         return expiration_;
     }
@@ -4,6 +4,7 @@
 
 #include "model/RequestInfo.h"
 #include "PutObjectBasicInput.h"
+#include "transport/http/Body.h"
 namespace VolcengineTos {
 class PutObjectV2Input {
 public:
@@ -29,6 +30,13 @@ public:
     void setContent(std::shared_ptr<std::iostream> content) {
         content_ = std::move(content);
     }
+    // 设置后优先于 content，传输层按偏移读取，重试时无需 seek
+    const std::shared_ptr<BodySource>& getBodySource() const {
+        return bodySource_;
+    }
+    void setBodySource(const std::shared_ptr<BodySource>& bodySource) {
+        bodySource_ = bodySource;
+    }
 
     const std::string& getBucket() const {
         return putObjectBasicInput_.getBucket();
@@ -202,5 +210,6 @@ public:
 private:
     PutObjectBasicInput putObjectBasicInput_;
     std::shared_ptr<std::iostream> content_;
+    std::shared_ptr<BodySource> bodySource_;
 };
 }  // namespace VolcengineTos
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace VolcengineTos {
+// 读取对象中 [offset, offset + length) 的数据，直接写入调用方提供的 buffer
+class ReadRange {
+public:
+    ReadRange(int64_t offset, int64_t length, char* buffer) : offset_(offset), length_(length), buffer_(buffer) {
+    }
+    ReadRange() = default;
+    ~ReadRange() = default;
+    int64_t getOffset() const {
+        return offset_;
+    }
+    void setOffset(int64_t offset) {
+        offset_ = offset;
+    }
+    int64_t getLength() const {
+        return length_;
+    }
+    void setLength(int64_t length) {
+        length_ = length;
+    }
+    char* getBuffer() const {
+        return buffer_;
+    }
+    void setBuffer(char* buffer) {
+        buffer_ = buffer;
+    }
+
+private:
+    int64_t offset_ = 0;
+    int64_t length_ = 0;
+    char* buffer_ = nullptr;
+};
+
+class ReadRangesInput {
+public:
+    ReadRangesInput(std::string bucket, std::string key, std::vector<ReadRange> ranges)
+            : bucket_(std::move(bucket)), key_(std::move(key)), ranges_(std::move(ranges)) {
+    }
+    ReadRangesInput(std::string bucket, std::string key) : bucket_(std::move(bucket)), key_(std::move(key)) {
+    }
+    ReadRangesInput() = default;
+    ~ReadRangesInput() = default;
+    const std::string& getBucket() const {
+        return bucket_;
+    }
+    void setBucket(const std::string& bucket) {
+        bucket_ = bucket;
+    }
+    const std::string& getKey() const {
+        return key_;
+    }
+    void setKey(const std::string& key) {
+        key_ = key;
+    }
+    const std::string& getVersionId() const {
+        return versionID_;
+    }
+    void setVersionId(const std::string& versionid) {
+        versionID_ = versionid;
+    }
+    const std::vector<ReadRange>& getRanges() const {
+        return ranges_;
+    }
+    void setRanges(const std::vector<ReadRange>& ranges) {
+        ranges_ = ranges;
+    }
+    void addRange(int64_t offset, int64_t length, char* buffer) {
+        ranges_.emplace_back(offset, length, buffer);
+    }
+    int64_t getMergeGap() const {
+        return mergeGap_;
+    }
+    void setMergeGap(int64_t mergegap) {
+        mergeGap_ = mergegap;
+    }
+    int64_t getMaxRangeSize() const {
+        return maxRangeSize_;
+    }
+    void setMaxRangeSize(int64_t maxrangesize) {
+        maxRangeSize_ = maxrangesize;
+    }
+    int getTaskNum() const {
+        return taskNum_;
+    }
+    void setTaskNum(int tasknum) {
+        taskNum_ = tasknum;
+    }
+
+private:
+    std::string bucket_;
+    std::string key_;
+    std::string versionID_;
+    std::vector<ReadRange> ranges_;
+    // 相邻范围的间隔不超过 mergeGap 时合并为一个请求，间隔中的数据被丢弃
+    int64_t mergeGap_ = 64 * 1024;
+    // 合并后超过 maxRangeSize 的范围拆分为多个请求并发读取
+    int64_t maxRangeSize_ = 8 * 1024 * 1024;
+    int taskNum_ = 4;
+};
+}  // namespace VolcengineTos
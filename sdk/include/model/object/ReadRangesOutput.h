@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "model/RequestInfo.h"
+
+namespace VolcengineTos {
+class ReadRangesOutput {
+public:
+    const RequestInfo& getRequestInfo() const {
+        return requestInfo_;
+    }
+    void setRequestInfo(const RequestInfo& requestinfo) {
+        requestInfo_ = requestinfo;
+    }
+    const std::string& getETag() const {
+        return eTag_;
+    }
+    void setETag(const std::string& etag) {
+        eTag_ = etag;
+    }
+    const std::vector<int64_t>& getReadBytes() const {
+        return readBytes_;
+    }
+    void setReadBytes(const std::vector<int64_t>& readbytes) {
+        readBytes_ = readbytes;
+    }
+    int getRequestCount() const {
+        return requestCount_;
+    }
+    void setRequestCount(int requestcount) {
+        requestCount_ = requestcount;
+    }
+
+private:
+    RequestInfo requestInfo_;
+    std::string eTag_;
+    // 与输入的 ranges 一一对应，范围超出对象大小时小于请求的长度
+    std::vector<int64_t> readBytes_;
+    // 合并和拆分后实际发出的 GET 请求数
+    int requestCount_ = 0;
+};
+}  // namespace VolcengineTos
@@ -101,6 +101,9 @@ public:
     void setPartsInfo(const std::vector<ResumableCopyPartInfo>& partsInfo) {
         partsInfo_ = partsInfo;
     }
+    void setPartsInfo(std::vector<ResumableCopyPartInfo>&& partsInfo) {
+        partsInfo_ = std::move(partsInfo);
+    }
     const std::string& getUploadId() const {
         return uploadID_;
     }
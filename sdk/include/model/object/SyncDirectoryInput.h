@@ -0,0 +1,97 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include "Type.h"
+
+namespace VolcengineTos {
+class SyncDirectoryInput {
+public:
+    SyncDirectoryInput(std::string bucket, std::string directory, std::string prefix, SyncDirectionType direction)
+            : bucket_(std::move(bucket)),
+              directory_(std::move(directory)),
+              prefix_(std::move(prefix)),
+              direction_(direction) {
+    }
+    SyncDirectoryInput() = default;
+    ~SyncDirectoryInput() = default;
+    const std::string& getBucket() const {
+        return bucket_;
+    }
+    void setBucket(const std::string& bucket) {
+        bucket_ = bucket;
+    }
+    const std::string& getDirectory() const {
+        return directory_;
+    }
+    void setDirectory(const std::string& directory) {
+        directory_ = directory;
+    }
+    const std::string& getPrefix() const {
+        return prefix_;
+    }
+    void setPrefix(const std::string& prefix) {
+        prefix_ = prefix;
+    }
+    SyncDirectionType getDirection() const {
+        return direction_;
+    }
+    void setDirection(SyncDirectionType direction) {
+        direction_ = direction;
+    }
+    bool isDeleteExtras() const {
+        return deleteExtras_;
+    }
+    void setDeleteExtras(bool deleteextras) {
+        deleteExtras_ = deleteextras;
+    }
+    const std::string& getStateFile() const {
+        return stateFile_;
+    }
+    void setStateFile(const std::string& statefile) {
+        stateFile_ = statefile;
+    }
+    int getTaskNum() const {
+        return taskNum_;
+    }
+    void setTaskNum(int tasknum) {
+        taskNum_ = tasknum;
+    }
+    int64_t getPartSize() const {
+        return partSize_;
+    }
+    void setPartSize(int64_t partsize) {
+        partSize_ = partsize;
+    }
+    int64_t getMultipartThreshold() const {
+        return multipartThreshold_;
+    }
+    void setMultipartThreshold(int64_t multipartthreshold) {
+        multipartThreshold_ = multipartthreshold;
+    }
+    const std::shared_ptr<CancelHook>& getCancelHook() const {
+        return cancelHook_;
+    }
+    void setCancelHook(const std::shared_ptr<CancelHook>& cancelhook) {
+        cancelHook_ = cancelhook;
+    }
+
+private:
+    std::string bucket_;
+    // 本地目录中的相对路径对应 prefix + 相对路径
+    std::string directory_;
+    std::string prefix_;
+    SyncDirectionType direction_ = SyncDirectionType::Upload;
+    // 删除目标端多出的文件，上传时删除对象，下载时删除本地文件
+    bool deleteExtras_ = false;
+    // 记录本地文件的大小、修改时间和 CRC64，修改时间未变化的文件不再重新计算，为空时不记录
+    std::string stateFile_;
+    // 计算 CRC64 和传输共享的并发数
+    int taskNum_ = 8;
+    int64_t partSize_ = 20 * 1024 * 1024;  // 默认20MB分片大小
+    // 大于该大小的文件分片上传或分片下载
+    int64_t multipartThreshold_ = 20 * 1024 * 1024;
+    std::shared_ptr<CancelHook> cancelHook_ = nullptr;
+};
+}  // namespace VolcengineTos
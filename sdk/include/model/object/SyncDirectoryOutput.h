@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace VolcengineTos {
+class SyncDirectoryOutput {
+public:
+    const std::string& getBucket() const {
+        return bucket_;
+    }
+    void setBucket(const std::string& bucket) {
+        bucket_ = bucket;
+    }
+    int64_t getTransferredFiles() const {
+        return transferredFiles_;
+    }
+    void setTransferredFiles(int64_t transferredfiles) {
+        transferredFiles_ = transferredfiles;
+    }
+    int64_t getTransferredBytes() const {
+        return transferredBytes_;
+    }
+    void setTransferredBytes(int64_t transferredbytes) {
+        transferredBytes_ = transferredbytes;
+    }
+    int64_t getUnchangedFiles() const {
+        return unchangedFiles_;
+    }
+    void setUnchangedFiles(int64_t unchangedfiles) {
+        unchangedFiles_ = unchangedfiles;
+    }
+    int64_t getDeletedFiles() const {
+        return deletedFiles_;
+    }
+    void setDeletedFiles(int64_t deletedfiles) {
+        deletedFiles_ = deletedfiles;
+    }
+    int64_t getHashedFiles() const {
+        return hashedFiles_;
+    }
+    void setHashedFiles(int64_t hashedfiles) {
+        hashedFiles_ = hashedfiles;
+    }
+    int64_t getHashedBytes() const {
+        return hashedBytes_;
+    }
+    void setHashedBytes(int64_t hashedbytes) {
+        hashedBytes_ = hashedbytes;
+    }
+
+private:
+    std::string bucket_;
+    int64_t transferredFiles_ = 0;
+    int64_t transferredBytes_ = 0;
+    // 大小和 CRC64 一致而跳过的文件数
+    int64_t unchangedFiles_ = 0;
+    int64_t deletedFiles_ = 0;
+    // 本次重新计算 CRC64 的文件数和字节数，不包括状态文件中命中的文件
+    int64_t hashedFiles_ = 0;
+    int64_t hashedBytes_ = 0;
+};
+}  // namespace VolcengineTos
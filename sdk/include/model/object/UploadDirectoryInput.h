@@ -0,0 +1,86 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include "Type.h"
+
+namespace VolcengineTos {
+class UploadDirectoryInput {
+public:
+    UploadDirectoryInput(std::string bucket, std::string directory, std::string prefix)
+            : bucket_(std::move(bucket)), directory_(std::move(directory)), prefix_(std::move(prefix)) {
+    }
+    UploadDirectoryInput() = default;
+    ~UploadDirectoryInput() = default;
+    const std::string& getBucket() const {
+        return bucket_;
+    }
+    void setBucket(const std::string& bucket) {
+        bucket_ = bucket;
+    }
+    const std::string& getDirectory() const {
+        return directory_;
+    }
+    void setDirectory(const std::string& directory) {
+        directory_ = directory;
+    }
+    const std::string& getPrefix() const {
+        return prefix_;
+    }
+    void setPrefix(const std::string& prefix) {
+        prefix_ = prefix;
+    }
+    int getTaskNum() const {
+        return taskNum_;
+    }
+    void setTaskNum(int tasknum) {
+        taskNum_ = tasknum;
+    }
+    int64_t getPartSize() const {
+        return partSize_;
+    }
+    void setPartSize(int64_t partsize) {
+        partSize_ = partsize;
+    }
+    int64_t getMultipartThreshold() const {
+        return multipartThreshold_;
+    }
+    void setMultipartThreshold(int64_t multipartthreshold) {
+        multipartThreshold_ = multipartthreshold;
+    }
+    const std::string& getManifestFile() const {
+        return manifestFile_;
+    }
+    void setManifestFile(const std::string& manifestfile) {
+        manifestFile_ = manifestfile;
+    }
+    const DataTransferListener& getDataTransferListener() const {
+        return dataTransferListener_;
+    }
+    void setDataTransferListener(const DataTransferListener& datatransferlistener) {
+        dataTransferListener_ = datatransferlistener;
+    }
+    const std::shared_ptr<CancelHook>& getCancelHook() const {
+        return cancelHook_;
+    }
+    void setCancelHook(const std::shared_ptr<CancelHook>& cancelhook) {
+        cancelHook_ = cancelhook;
+    }
+
+private:
+    std::string bucket_;
+    // 本地目录，其中的文件上传为 prefix + 相对路径
+    std::string directory_;
+    std::string prefix_;
+    // 整个目录共享的并发数，包括小文件上传和大文件的分片上传
+    int taskNum_ = 8;
+    int64_t partSize_ = 20 * 1024 * 1024;  // 默认20MB分片大小
+    // 大于该大小的文件使用分片上传
+    int64_t multipartThreshold_ = 20 * 1024 * 1024;
+    // 记录已完成的文件和分片，重新执行时跳过未变化的部分，为空时不记录
+    std::string manifestFile_;
+    DataTransferListener dataTransferListener_ = {nullptr, nullptr};  // 整个目录的进度
+    std::shared_ptr<CancelHook> cancelHook_ = nullptr;
+};
+}  // namespace VolcengineTos
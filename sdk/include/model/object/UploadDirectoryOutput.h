@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace VolcengineTos {
+class UploadDirectoryOutput {
+public:
+    const std::string& getBucket() const {
+        return bucket_;
+    }
+    void setBucket(const std::string& bucket) {
+        bucket_ = bucket;
+    }
+    int64_t getUploadedFiles() const {
+        return uploadedFiles_;
+    }
+    void setUploadedFiles(int64_t uploadedfiles) {
+        uploadedFiles_ = uploadedfiles;
+    }
+    int64_t getSkippedFiles() const {
+        return skippedFiles_;
+    }
+    void setSkippedFiles(int64_t skippedfiles) {
+        skippedFiles_ = skippedfiles;
+    }
+    int64_t getUploadedBytes() const {
+        return uploadedBytes_;
+    }
+    void setUploadedBytes(int64_t uploadedbytes) {
+        uploadedBytes_ = uploadedbytes;
+    }
+    int64_t getMultipartFiles() const {
+        return multipartFiles_;
+    }
+    void setMultipartFiles(int64_t multipartfiles) {
+        multipartFiles_ = multipartfiles;
+    }
+
+private:
+    std::string bucket_;
+    int64_t uploadedFiles_ = 0;
+    // manifest 中记录已上传且本地未变化的文件
+    int64_t skippedFiles_ = 0;
+    int64_t uploadedBytes_ = 0;
+    int64_t multipartFiles_ = 0;
+};
+}  // namespace VolcengineTos
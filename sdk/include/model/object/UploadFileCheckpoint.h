@@ -63,6 +63,9 @@ public:
     void setUploadFilePartInfoList(const std::vector<UploadFilePartInfo>& uploadFilePartInfoList) {
         uploadFilePartInfoList_ = uploadFilePartInfoList;
     }
+    void setUploadFilePartInfoList(std::vector<UploadFilePartInfo>&& uploadFilePartInfoList) {
+        uploadFilePartInfoList_ = std::move(uploadFilePartInfoList);
+    }
     void setUploadFilePartInfoByIdx(const UploadFilePartInfo& uploadFilePartInfo, int idx) {
         if (idx < 0 || idx >= uploadFilePartInfoList_.size())
             return;
@@ -70,6 +70,9 @@ public:
     void setPartsInfo(const std::vector<UploadFilePartInfoV2>& partsinfo) {
         partsInfo_ = partsinfo;
     }
+    void setPartsInfo(std::vector<UploadFilePartInfoV2>&& partsinfo) {
+        partsInfo_ = std::move(partsinfo);
+    }
 
     void dump(std::string checkpointFilePath);
     void load(std::string checkpointFilePath);
@@ -86,6 +89,30 @@ public:
         return fileInfo_.getFileSize() == uploadFileSize && fileInfo_.getLastModified() == uploadFileLastModifiedTime;
     }
 
+    bool hasCompletedParts() const {
+        for (const auto& part : partsInfo_) {
+            if (part.isCompleted()) {
+                return true;
+            }
+        }
+        return false;
+    }
+    // 用本地文件各分片的 CRC64 校验已上传的分片，不一致的分片标记为未完成以便重新上传，返回重置的分片数
+    int resetMismatchedParts(const std::vector<uint64_t>& partCRCs) {
+        int reset = 0;
+        for (auto& part : partsInfo_) {
+            auto idx = static_cast<size_t>(part.getPartNum() - 1);
+            if (!part.isCompleted() || (idx < partCRCs.size() && partCRCs[idx] == part.getHashCrc64Result())) {
+                continue;
+            }
+            part.setIsCompleted(false);
+            part.setETag("");
+            part.setHashCrc64Result(0);
+            reset++;
+        }
+        return reset;
+    }
+
 private:
     std::string bucket_;
     std::string key_;
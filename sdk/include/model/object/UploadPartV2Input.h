@@ -3,6 +3,7 @@
 #include <string>
 #include <utility>
 #include "UploadPartBasicInput.h"
+#include "transport/http/Body.h"
 namespace VolcengineTos {
 class UploadPartV2Input {
 public:
@@ -30,6 +31,13 @@ public:
     void setContent(const std::shared_ptr<std::iostream>& content) {
         content_ = content;
     }
+    // 设置后优先于 content，传输层按偏移读取，重试时无需 seek
+    const std::shared_ptr<BodySource>& getBodySource() const {
+        return bodySource_;
+    }
+    void setBodySource(const std::shared_ptr<BodySource>& bodySource) {
+        bodySource_ = bodySource;
+    }
     int64_t getContentLength() const {
         return contentLength_;
     }
@@ -107,6 +115,7 @@ public:
 private:
     UploadPartBasicInput uploadPartBasicInput_;
     std::shared_ptr<std::iostream> content_;
+    std::shared_ptr<BodySource> bodySource_;
     int64_t contentLength_ = 0;
 };
 }  // namespace VolcengineTos
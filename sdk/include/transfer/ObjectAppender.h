@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include "TosError.h"
+#include "model/object/AppendObjectV2Input.h"
+
+namespace VolcengineTos {
+class TosClientV2;
+
+struct AppenderOptions {
+    // 缓冲区上限，缓冲区满时 append 阻塞到已缓冲的数据提交后
+    int64_t maxBufferBytes = 64 * 1024 * 1024;
+    // 缓冲的数据达到 flushBytes，或最早缓冲的数据等待超过 flushIntervalMillis 时提交一次追加。
+    // 提交期间新写入的数据在下一次追加中一起提交
+    int64_t flushBytes = 4 * 1024 * 1024;
+    int flushIntervalMillis = 1000;
+    // 对象大小超过 maxObjectSize 前滚动到新对象，0 表示不滚动。单次 append 的数据不会被拆分到两个对象
+    int64_t maxObjectSize = 0;
+    // 根据原始对象名和滚动序号（从 1 开始）生成新对象名，为空时使用 key.序号
+    std::function<std::string(const std::string& key, int index)> rolloverKey;
+    // 一次追加失败后的重试次数，第 n 次重试前等待 retryBackoffMillis * n 毫秒
+    int maxRetries = 3;
+    int retryBackoffMillis = 1000;
+};
+
+struct AppenderStats {
+    // 调用方写入的字节数与已提交的字节数
+    int64_t appendedBytes = 0;
+    int64_t committedBytes = 0;
+    int64_t bufferedBytes = 0;
+    // 追加请求数，每次合并提交若干次 append 的数据
+    int64_t commits = 0;
+    int64_t retries = 0;
+    // 请求结果不确定时通过 headObject 确认的次数
+    int64_t recoveries = 0;
+    int64_t rollovers = 0;
+    // 当前写入的对象与下一次追加的 offset
+    std::string key;
+    int64_t nextOffset = 0;
+};
+
+// 多个线程并发写入同一个追加对象，写入的数据先进入有界缓冲区，由后台线程合并后按顺序调用 appendObject 提交。
+// 首次提交前通过 headObject 获取对象当前的长度与 CRC64，对象不存在时从 0 开始追加。
+// 每次追加以上一次的 CRC64 作为 preHashCrc64ecma，开启 crc 校验时校验整个对象的 CRC64。
+// 连接断开、5xx 等结果不确定的失败后通过 headObject 判断上一次追加是否已生效，避免数据重复或 offset 错位。
+// 提交最终失败后 appender 不再接受写入，未提交的数据保留在缓冲区中，可以通过 error 获取原因
+class ObjectAppender {
+public:
+    // input 中的 bucket、key 与对象属性用于每次追加，offset 与 content 被忽略
+    ObjectAppender(const TosClientV2& client, const AppendObjectV2Input& input, const AppenderOptions& options);
+    ~ObjectAppender();
+    ObjectAppender(const ObjectAppender&) = delete;
+    ObjectAppender& operator=(const ObjectAppender&) = delete;
+
+    // 写入一条数据，同一条数据总是在同一次追加中提交。appender 已关闭或失败时返回 false
+    bool append(const std::string& data);
+    bool append(const char* data, size_t size);
+    // 等待调用前写入的数据全部提交
+    bool flush();
+    // 提交剩余的数据并停止后台线程，析构时自动调用
+    bool close();
+    TosError error();
+    AppenderStats stats();
+
+private:
+    class Impl;
+    std::shared_ptr<Impl> impl_;
+};
+}  // namespace VolcengineTos
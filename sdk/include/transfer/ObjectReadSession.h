@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "Outcome.h"
+#include "TosError.h"
+#include "model/object/GetObjectV2Input.h"
+#include "model/object/GetObjectV2Output.h"
+
+namespace VolcengineTos {
+class TosClientV2;
+
+struct ReadSessionOptions {
+    // 顺序读的预读窗口大小，根据消费速度在 [minWindow, maxWindow] 之间调整
+    int64_t initialWindow = 1024 * 1024;
+    int64_t minWindow = 256 * 1024;
+    int64_t maxWindow = 16 * 1024 * 1024;
+    // 最多同时预读的窗口数，0 表示关闭预读
+    int prefetchWindows = 4;
+    // 预读缓冲区上限
+    int64_t maxBufferedBytes = 64 * 1024 * 1024;
+};
+
+struct ReadSessionStats {
+    uint64_t reads = 0;
+    // 完全由预读数据满足的读
+    uint64_t prefetchHits = 0;
+    // 命中预读但需要等待预读请求完成的读
+    uint64_t prefetchWaits = 0;
+    uint64_t prefetchRequests = 0;
+    uint64_t prefetchedBytes = 0;
+    // 预读数据中被读取的字节数
+    uint64_t consumedBytes = 0;
+    // 预读后未被读取就丢弃的字节数
+    uint64_t wastedBytes = 0;
+    int64_t window = 0;
+};
+
+// 针对单个对象的范围读会话，识别顺序读和固定步长的跳读，并发预读后续的窗口。
+// 预读请求带 If-Match，对象被修改后预读失败并回退为直接读取。预读请求在 client 共用的线程池中执行。
+// 同一个 session 的 read 会串行执行，多个线程读同一对象时建议各自打开 session。
+class ObjectReadSession {
+public:
+    ObjectReadSession(const TosClientV2& client, const GetObjectV2Input& input, const ReadSessionOptions& options);
+    ~ObjectReadSession();
+    ObjectReadSession(const ObjectReadSession&) = delete;
+    ObjectReadSession& operator=(const ObjectReadSession&) = delete;
+
+    // 读取 [start, end] 闭区间，end 超出对象大小时读到对象末尾
+    Outcome<TosError, GetObjectV2Output> read(int64_t start, int64_t end);
+    ReadSessionStats stats() const;
+
+private:
+    class Impl;
+    std::shared_ptr<Impl> impl_;
+};
+}  // namespace VolcengineTos
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "metrics/Metrics.h"
+
+namespace VolcengineTos {
+struct PartRetryOptions {
+    // 分片请求失败（已用尽 maxRetryCount 次请求级重试）后，在本次 uploadFile/downloadFile/resumableCopyObject 调用内
+    // 重新排队的次数，为 0 时失败的分片直接报告失败
+    int maxRetries = 2;
+    // 第 n 次重新排队的分片至少等待 backoffMillis * 2^(n-1) 毫秒后再发起，不超过 maxBackoffMillis
+    int backoffMillis = 1000;
+    int maxBackoffMillis = 30000;
+    // 重新排队的分片请求使用新建的连接，不复用可能已经异常的连接
+    bool freshConnection = true;
+};
+
+// 分片并发传输的任务队列，多个工作线程共享。失败的分片按指数退避重新排队，由之后取到它的工作线程等待退避结束后重传
+template <typename Part>
+class PartRetryQueue {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        Part part;
+        // 该分片已重新排队的次数，0 表示首次请求
+        int retries = 0;
+        Clock::time_point notBefore;
+    };
+
+    PartRetryQueue(const std::vector<Part>& parts, const PartRetryOptions& options) : options_(options) {
+        for (const auto& part : parts) {
+            Entry entry;
+            entry.part = part;
+            queue_.push_back(std::move(entry));
+        }
+    }
+
+    // 取出最早可以开始的分片，队列为空时返回 false
+    bool pop(Entry& entry) {
+        std::lock_guard<std::mutex> lock(mu_);
+        if (queue_.empty()) {
+            return false;
+        }
+        auto it = std::min_element(queue_.begin(), queue_.end(), [](const Entry& a, const Entry& b) {
+            return a.notBefore < b.notBefore;
+        });
+        entry = std::move(*it);
+        queue_.erase(it);
+        return true;
+    }
+    bool empty() {
+        std::lock_guard<std::mutex> lock(mu_);
+        return queue_.empty();
+    }
+    // 放回队列头部立即重传，不计入重试次数
+    void pushFront(const Entry& entry) {
+        std::lock_guard<std::mutex> lock(mu_);
+        auto front = entry;
+        front.notBefore = Clock::time_point();
+        queue_.push_front(std::move(front));
+    }
+    // 失败的分片按退避时间重新排队，错误不可重试或已用尽重试次数时返回 false
+    bool retry(const Entry& entry, int statusCode) {
+        if (!Retryable(statusCode) || entry.retries >= options_.maxRetries) {
+            return false;
+        }
+        auto next = entry;
+        next.retries++;
+        next.notBefore = Clock::now() + std::chrono::milliseconds(backoff(next.retries));
+        std::lock_guard<std::mutex> lock(mu_);
+        queue_.push_back(std::move(next));
+        if (MetricsRegistry::Enabled()) {
+            MetricsRegistry::instance()->recordPartRetry();
+        }
+        return true;
+    }
+    // 等待退避结束，期间 stop 返回 true 时提前返回 false
+    static bool Wait(const Entry& entry, const std::function<bool()>& stop) {
+        while (Clock::now() < entry.notBefore) {
+            if (stop()) {
+                return false;
+            }
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(entry.notBefore - Clock::now());
+            std::this_thread::sleep_for(std::min(remaining, std::chrono::milliseconds(100)));
+        }
+        return true;
+    }
+    // 连接失败、408、429 与 5xx 可以重试，403/404/405 等需要中断整个任务的错误与其他 4xx 不重试。
+    // statusCode 为 0 表示客户端错误，如 crc 校验失败，重传可能恢复
+    static bool Retryable(int statusCode) {
+        return statusCode <= 0 || statusCode == 408 || statusCode == 429 || statusCode >= 500;
+    }
+    int64_t backoff(int retries) const {
+        int64_t delay = std::max(options_.backoffMillis, 0);
+        for (int i = 1; i < retries && delay < options_.maxBackoffMillis; i++) {
+            delay *= 2;
+        }
+        return std::min<int64_t>(delay, options_.maxBackoffMillis);
+    }
+    bool freshConnection(const Entry& entry) const {
+        return options_.freshConnection && entry.retries > 0;
+    }
+
+private:
+    PartRetryOptions options_;
+    std::mutex mu_;
+    std::deque<Entry> queue_;
+};
+}  // namespace VolcengineTos
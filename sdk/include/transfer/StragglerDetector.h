@@ -0,0 +1,107 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Type.h"
+#include "transport/http/TransferMonitor.h"
+
+namespace VolcengineTos {
+struct StragglerOptions {
+    // 分片请求的吞吐低于同一传输中各分片吞吐中位数的 slowRatio 倍时视为落后，中止后在新连接上重传
+    double slowRatio = 0.3;
+    // 分片请求开始后至少经过 minElapsedMillis 才参与判断，避免把建连与慢启动阶段误判为落后
+    int minElapsedMillis = 3000;
+    // 计算中位数所需的最少样本数
+    int minSamples = 3;
+    // 单个分片最多因落后重启的次数
+    int maxRestarts = 3;
+    // 下载的分片队列为空后，空闲的工作线程为预计最晚完成的分片发起重复请求，先完成者生效
+    bool duplicateTail = true;
+    // 后台检查间隔，为 0 时不启动后台检查
+    int checkIntervalMillis = 200;
+};
+
+class StragglerDetector;
+
+// 一次分片请求，monitor 与 listener 需设置到该分片的请求上
+struct StragglerAttempt {
+    int partNumber = 0;
+    bool duplicate = false;
+    std::shared_ptr<TransferMonitor> monitor = std::make_shared<TransferMonitor>();
+    DataTransferListener listener = {nullptr, nullptr};
+
+private:
+    friend class StragglerDetector;
+    StragglerDetector* detector_ = nullptr;
+    // 因落后被中止
+    bool restart_ = false;
+};
+
+// 监控一次分片并发传输中各分片请求的吞吐，中止明显慢于中位数的分片请求，并在传输临近结束时为落后的分片发起重复请求。
+// 各分片请求的进度经 detector 汇总后转发给整个传输的进度回调，重启与重复请求不会重复计入
+class StragglerDetector {
+public:
+    enum FinishResult {
+        // 本次请求完成了该分片
+        PartSucceed,
+        // 因落后被中止，需要重新上传/下载该分片
+        PartRestart,
+        // 该分片由其他请求完成或仍有其他请求进行中，忽略本次结果
+        PartSuperseded,
+        // 该分片失败
+        PartFailed,
+    };
+
+    // listener 为整个传输的进度回调，可以为空
+    StragglerDetector(const StragglerOptions& options, const DataTransferListener& listener);
+    ~StragglerDetector();
+
+    std::shared_ptr<StragglerAttempt> begin(int partNumber, int64_t size);
+    // 选择一个按中位数吞吐重新请求能更早完成的分片，为其发起重复请求，没有合适的分片时返回 nullptr
+    std::shared_ptr<StragglerAttempt> beginDuplicate();
+    FinishResult finish(const std::shared_ptr<StragglerAttempt>& attempt, bool success);
+    // 是否还有进行中的分片请求
+    bool busy();
+    // 检查一轮进行中的分片请求，中止落后者，由后台线程定期调用
+    void check();
+
+    uint64_t restarts();
+    uint64_t duplicates();
+
+private:
+    struct Part {
+        int64_t size = 0;
+        // 已转发给整个传输的进度，取该分片各次请求进度的最大值
+        int64_t credited = 0;
+        int restarts = 0;
+        bool done = false;
+        std::vector<std::shared_ptr<StragglerAttempt>> attempts;
+    };
+
+    static void progress(const std::shared_ptr<DataTransferStatus>& status);
+    void onProgress(StragglerAttempt* attempt, const DataTransferStatus& status);
+    // 已完成分片与进行足够久的分片请求的吞吐中位数，样本不足时返回 -1
+    double medianRate();
+    static double rateOf(const StragglerAttempt& attempt);
+    void checkLoop();
+
+    StragglerOptions options_;
+    DataTransferListener listener_;
+
+    std::mutex mu_;
+    std::map<int, Part> parts_;
+    // 已完成分片的吞吐，单位字节每秒
+    std::vector<double> completedRates_;
+    uint64_t restarts_ = 0;
+    uint64_t duplicates_ = 0;
+
+    std::condition_variable cv_;
+    bool stop_ = false;
+    std::thread checker_;
+};
+}  // namespace VolcengineTos
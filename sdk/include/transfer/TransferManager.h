@@ -0,0 +1,176 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+#include "TosError.h"
+#include "Type.h"
+#include "model/object/DownloadFileInput.h"
+#include "model/object/ResumableCopyObjectInput.h"
+#include "model/object/UploadFileV2Input.h"
+
+namespace VolcengineTos {
+class TosClientV2;
+
+// 在多个传输任务之间分配分片请求的并发名额。等待中的分片请求按优先级从高到低、同优先级按先后顺序获得名额
+class PartScheduler {
+public:
+    explicit PartScheduler(int maxConcurrency);
+
+    // 获取一个名额，等待期间 stop 返回 true 时放弃等待并返回 false
+    bool acquire(int priority, const std::function<bool()>& stop);
+    void release();
+    // 唤醒等待中的分片请求重新检查 stop
+    void wakeAll();
+
+    int running();
+    int waiting();
+
+private:
+    int maxConcurrency_;
+    std::mutex mu_;
+    std::condition_variable cv_;
+    int running_ = 0;
+    uint64_t sequence_ = 0;
+    // (-priority, sequence)，begin() 为下一个获得名额的请求
+    std::set<std::pair<int, uint64_t>> waiters_;
+};
+
+struct TransferManagerOptions {
+    // 所有任务同时进行的分片请求数上限
+    int maxConcurrency = 16;
+    // 同时运行的任务数上限，等待中的任务按优先级从高到低启动
+    int maxRunningJobs = 64;
+    // 所有上传、下载任务共享的带宽上限，单位字节每秒，0 表示不限制。任务的 input 已设置 RateLimiter 时使用任务自己的
+    int64_t maxBandwidth = 0;
+};
+
+enum class TransferJobState {
+    Pending,
+    Running,
+    Paused,
+    Succeeded,
+    Failed,
+    Cancelled,
+};
+
+struct TransferJobStats {
+    // 已完成的字节数，包括暂停前和 checkpoint 中已完成的部分。复制任务按已完成的分片统计
+    int64_t transferredBytes = 0;
+    // 任务的总字节数，复制任务为 0
+    int64_t totalBytes = 0;
+    // 运行期间的平均吞吐，单位字节每秒，不包括等待与暂停的时间
+    double bytesPerSecond = 0;
+    int64_t runningMillis = 0;
+};
+
+struct TransferManagerStats {
+    int pending = 0;
+    int running = 0;
+    int paused = 0;
+    int succeeded = 0;
+    int failed = 0;
+    int cancelled = 0;
+    // 正在进行与等待名额的分片请求数
+    int activeParts = 0;
+    int waitingParts = 0;
+    // 所有任务已完成的字节数
+    int64_t transferredBytes = 0;
+    // 运行中任务的吞吐之和
+    double bytesPerSecond = 0;
+};
+
+class TransferJob;
+
+// 统一调度多个传输任务：各任务的分片请求从全局优先级队列获取并发名额，共享带宽上限，可以暂停与恢复。
+// 任务强制开启 checkpoint，input 中设置的 CancelHook 由 TransferJob 的 pause/cancel 代替。
+// 销毁时暂停仍在运行的任务并等待其退出
+class TransferManager {
+public:
+    TransferManager(const TosClientV2& client, const TransferManagerOptions& options);
+    ~TransferManager();
+    TransferManager(const TransferManager&) = delete;
+    TransferManager& operator=(const TransferManager&) = delete;
+
+    // priority 越大越优先，如交互式的恢复任务可以使用高于批量备份任务的优先级
+    std::shared_ptr<TransferJob> uploadFile(const UploadFileV2Input& input, int priority = 0);
+    std::shared_ptr<TransferJob> downloadFile(const DownloadFileInput& input, int priority = 0);
+    std::shared_ptr<TransferJob> resumableCopyObject(const ResumableCopyObjectInput& input, int priority = 0);
+
+    // 暂停全部未结束的任务
+    void pauseAll();
+    void resumeAll();
+    TransferManagerStats stats();
+
+private:
+    friend class TransferJob;
+    class Impl;
+    std::shared_ptr<Impl> impl_;
+};
+
+// TransferManager 中的一个 uploadFile/downloadFile/resumableCopyObject 任务
+class TransferJob : public std::enable_shared_from_this<TransferJob> {
+public:
+    int64_t id() const {
+        return id_;
+    }
+    int priority() const {
+        return priority_;
+    }
+    TransferJobState state();
+    // 暂停任务，已完成的分片保存在 checkpoint 中，resume 后继续传输
+    void pause();
+    void resume();
+    // 取消任务，删除 checkpoint 并中止已创建的分片上传
+    void cancel();
+    // 等待任务结束或暂停，返回此时的状态
+    TransferJobState wait();
+    // 任务失败或被取消时的错误
+    TosError error();
+    TransferJobStats stats();
+
+private:
+    friend class TransferManager::Impl;
+    // 使用给定的 CancelHook 执行一次传输，成功时返回 true
+    using Runner = std::function<bool(const std::shared_ptr<CancelHook>&, TosError&)>;
+
+    TransferJob(TransferManager::Impl* manager, int64_t id, int priority);
+    // 等待中的任务开始运行，任务已被暂停或取消时返回 false
+    bool markRunning();
+    // 执行一次传输，abort 为 true 时只清理 checkpoint 与已创建的分片上传
+    void run(bool abort);
+    bool finished();
+    void onProgress(const DataTransferStatus& status);
+    void onPartCopied(int64_t bytes);
+    static void progress(const std::shared_ptr<DataTransferStatus>& status);
+
+    // manager 销毁后置空
+    TransferManager::Impl* manager_;
+    int64_t id_;
+    int priority_;
+    Runner runner_;
+    // 调用方在 input 中设置的进度回调
+    DataTransferListener listener_ = {nullptr, nullptr};
+
+    std::mutex mu_;
+    std::condition_variable cv_;
+    TransferJobState state_ = TransferJobState::Pending;
+    // 已运行过，可能存在 checkpoint
+    bool started_ = false;
+    bool pauseRequested_ = false;
+    bool cancelRequested_ = false;
+    std::shared_ptr<CancelHook> hook_;
+    TosError error_;
+    int64_t transferred_ = 0;
+    int64_t total_ = 0;
+    int64_t runBytes_ = 0;
+    int64_t runMillis_ = 0;
+    std::chrono::steady_clock::time_point runStart_;
+};
+}  // namespace VolcengineTos
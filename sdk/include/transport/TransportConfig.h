@@ -101,6 +101,12 @@ public:
     void setDnsCacheTime(int dnsCacheTime) {
         dnsCacheTime_ = dnsCacheTime;
     }
+    bool isEnableDnsLoadBalance() const {
+        return enableDnsLoadBalance_;
+    }
+    void setEnableDnsLoadBalance(bool enableDnsLoadBalance) {
+        enableDnsLoadBalance_ = enableDnsLoadBalance;
+    }
     int getMaxConnections() const {
         return maxConnections;
     }
@@ -113,24 +119,76 @@ public:
     void setSocketTimeout(int socketTimeout) {
         socketTimeout_ = socketTimeout;
     }
+    int getKeepAliveInterval() const {
+        return keepAliveInterval_;
+    }
+    void setKeepAliveInterval(int keepAliveInterval) {
+        keepAliveInterval_ = keepAliveInterval;
+    }
+    int getKeepAliveCount() const {
+        return keepAliveCount_;
+    }
+    void setKeepAliveCount(int keepAliveCount) {
+        keepAliveCount_ = keepAliveCount;
+    }
+    int getIdleConnectionTimeout() const {
+        return idleConnectionTimeout_;
+    }
+    void setIdleConnectionTimeout(int idleConnectionTimeout) {
+        idleConnectionTimeout_ = idleConnectionTimeout;
+    }
+    int getReceiveBufferSize() const {
+        return receiveBufferSize_;
+    }
+    void setReceiveBufferSize(int receiveBufferSize) {
+        receiveBufferSize_ = receiveBufferSize;
+    }
+    int getUploadBufferSize() const {
+        return uploadBufferSize_;
+    }
+    void setUploadBufferSize(int uploadBufferSize) {
+        uploadBufferSize_ = uploadBufferSize;
+    }
+    int getSocketSendBufferSize() const {
+        return socketSendBufferSize_;
+    }
+    void setSocketSendBufferSize(int socketSendBufferSize) {
+        socketSendBufferSize_ = socketSendBufferSize;
+    }
+    int getSocketReceiveBufferSize() const {
+        return socketReceiveBufferSize_;
+    }
+    void setSocketReceiveBufferSize(int socketReceiveBufferSize) {
+        socketReceiveBufferSize_ = socketReceiveBufferSize;
+    }
 
 private:
+    // 以下时间单位为秒（connectTimeout_、requestTimeout_、socketTimeout_ 为毫秒），0 表示不限制或使用默认值
     int maxIdleCount_ = 128;
     int requestTimeout_ = 120000;
     int dialTimeout_ = 10;
     int keepAlive_ = 30;
+    int keepAliveInterval_ = 0;
+    int keepAliveCount_ = 0;
+    int idleConnectionTimeout_ = 0;
     int connectTimeout_ = 10000;
     int tlsHandshakeTimeout_ = 10;
-    int responseHeaderTimeout_ = 60;
+    int responseHeaderTimeout_ = 0;
     int expectContinueTimeout_ = 3;
-    int readTimeout_ = 120;
-    int writeTimeout_ = 120;
+    int readTimeout_ = 0;
+    int writeTimeout_ = 0;
+    // 以下单位为字节，0 表示使用默认值
+    int receiveBufferSize_ = 0;
+    int uploadBufferSize_ = 0;
+    int socketSendBufferSize_ = 0;
+    int socketReceiveBufferSize_ = 0;
     bool enableVerifySSL_ = true;
     std::string proxyHost_;
     int proxyPort_ = -1;
     std::string proxyUsername_;
     std::string proxyPassword_;
     int dnsCacheTime_ = 0;
+    bool enableDnsLoadBalance_ = false;
     int maxConnections = 25;
     int socketTimeout_ = 30000;
 };
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace VolcengineTos {
+class FileRangeReader;
+
+// 请求体的数据来源。传输层按偏移读取，重试时从偏移 0 重新读取，不依赖 seekg
+class BodySource {
+public:
+    virtual ~BodySource() = default;
+    // 数据总长度，未知时返回 -1
+    virtual int64_t size() = 0;
+    // 从 offset 开始读取最多 len 字节，返回读取的字节数，出错时返回 -1
+    virtual int64_t readAt(int64_t offset, char* buf, int64_t len) = 0;
+    // 能否从任意偏移重新读取，不能时请求失败后不重试
+    virtual bool rewindable() {
+        return true;
+    }
+};
+
+// 响应体的接收方。传输层按偏移写入，重试时从偏移 0 重新写入
+class BodySink {
+public:
+    virtual ~BodySink() = default;
+    // 写入响应体中 [offset, offset + len) 的数据，失败时返回 false
+    virtual bool writeAt(int64_t offset, const char* data, int64_t len) = 0;
+    // 响应体接收完成，返回 false 时请求失败
+    virtual bool commit() {
+        return true;
+    }
+    // 请求失败，已写入的数据无效
+    virtual void abort() {
+    }
+};
+
+// 调用方持有的内存，不拷贝
+class MemoryBodySource : public BodySource {
+public:
+    MemoryBodySource(const char* data, int64_t size) : data_(data), size_(size) {
+    }
+    explicit MemoryBodySource(std::shared_ptr<const std::string> data)
+            : holder_(std::move(data)), data_(holder_->data()), size_(static_cast<int64_t>(holder_->size())) {
+    }
+    int64_t size() override {
+        return size_;
+    }
+    int64_t readAt(int64_t offset, char* buf, int64_t len) override;
+
+private:
+    std::shared_ptr<const std::string> holder_;
+    const char* data_;
+    int64_t size_;
+};
+
+// 文件中 [offset, offset + length) 的数据，length 为 -1 时读到文件末尾。POSIX 下使用 pread，可被多个请求共享
+class FileBodySource : public BodySource {
+public:
+    FileBodySource(const std::string& filePath, int64_t offset = 0, int64_t length = -1);
+    ~FileBodySource() override;
+    bool good() const;
+    int64_t size() override {
+        return length_;
+    }
+    int64_t readAt(int64_t offset, char* buf, int64_t len) override;
+
+private:
+    std::unique_ptr<FileRangeReader> reader_;
+    int64_t offset_;
+    int64_t length_;
+};
+
+// 由调用方的回调提供数据
+class CallbackBodySource : public BodySource {
+public:
+    using ReadFunc = std::function<int64_t(int64_t offset, char* buf, int64_t len)>;
+    CallbackBodySource(int64_t size, ReadFunc read, bool rewindable = true)
+            : size_(size), read_(std::move(read)), rewindable_(rewindable) {
+    }
+    int64_t size() override {
+        return size_;
+    }
+    int64_t readAt(int64_t offset, char* buf, int64_t len) override {
+        return read_(offset, buf, len);
+    }
+    bool rewindable() override {
+        return rewindable_;
+    }
+
+private:
+    int64_t size_;
+    ReadFunc read_;
+    bool rewindable_;
+};
+
+// 兼容 iostream 的请求体，从构造时的读位置开始读取 length 字节，length 为 -1 时读到流末尾。
+// 顺序读取时不 seek，只有偏移不连续（重试）时才 seekg
+class StreamBodySource : public BodySource {
+public:
+    explicit StreamBodySource(std::shared_ptr<std::iostream> stream, int64_t length = -1);
+    int64_t size() override;
+    int64_t readAt(int64_t offset, char* buf, int64_t len) override;
+    bool rewindable() override {
+        return start_ >= 0;
+    }
+
+private:
+    std::shared_ptr<std::iostream> stream_;
+    int64_t start_;
+    int64_t length_;
+    int64_t pos_ = 0;
+};
+
+// 写入调用方持有的内存，超出 capacity 时失败
+class MemoryBodySink : public BodySink {
+public:
+    MemoryBodySink(char* buffer, int64_t capacity) : buffer_(buffer), capacity_(capacity) {
+    }
+    bool writeAt(int64_t offset, const char* data, int64_t len) override;
+    // 已写入的最大偏移
+    int64_t written() const {
+        return written_;
+    }
+
+private:
+    char* buffer_;
+    int64_t capacity_;
+    int64_t written_ = 0;
+};
+
+// 由调用方的回调接收数据
+class CallbackBodySink : public BodySink {
+public:
+    using WriteFunc = std::function<bool(int64_t offset, const char* data, int64_t len)>;
+    explicit CallbackBodySink(WriteFunc write) : write_(std::move(write)) {
+    }
+    bool writeAt(int64_t offset, const char* data, int64_t len) override {
+        return write_(offset, data, len);
+    }
+
+private:
+    WriteFunc write_;
+};
+
+// 兼容 iostream 的响应体，从构造时的写位置开始写入，重试时 seekp 回到起始位置
+class StreamBodySink : public BodySink {
+public:
+    explicit StreamBodySink(std::shared_ptr<std::iostream> stream);
+    bool writeAt(int64_t offset, const char* data, int64_t len) override;
+
+private:
+    std::shared_ptr<std::iostream> stream_;
+    int64_t start_;
+    int64_t pos_ = 0;
+};
+}  // namespace VolcengineTos
@@ -7,12 +7,15 @@
 #include <atomic>
 #include <algorithm>
 #include <cassert>
+#include <map>
 #include <sstream>
 #include "HttpRequest.h"
 #include "HttpResponse.h"
+#include "metrics/Metrics.h"
 #include "curl/curl.h"
 
 namespace VolcengineTos {
+class HostResolver;
 static bool hasInitHttpClient = false;
 struct HttpConfig {
     int maxConnections;
@@ -27,6 +30,27 @@ struct HttpConfig {
     std::string proxyUsername;
     std::string proxyPassword;
     int dnsCacheTime;
+    bool enableDnsLoadBalance;
+    // 以下时间单位为秒，大小单位为字节，0 表示不限制或使用默认值
+    int tlsHandshakeTimeout;
+    int responseHeaderTimeout;
+    int readTimeout;
+    int writeTimeout;
+    int tcpKeepAliveInterval;
+    int tcpKeepAliveCount;
+    int maxIdleCount;
+    int idleConnectionTimeout;
+    int receiveBufferSize;
+    int uploadBufferSize;
+    int socketSendBufferSize;
+    int socketReceiveBufferSize;
+};
+
+// 新建 socket 时由 CURLOPT_SOCKOPTFUNCTION 设置的参数
+struct SocketOptions {
+    int sendBufferSize = 0;
+    int receiveBufferSize = 0;
+    int keepAliveCount = 0;
 };
 
 template< typename RESOURCE_TYPE>
@@ -56,6 +80,12 @@ public:
         return m_resources.size() > 0 && !m_shutdown.load();
     }
 
+    size_t Size()
+    {
+        std::lock_guard<std::mutex> locker(m_queueLock);
+        return m_resources.size();
+    }
+
     void Release(RESOURCE_TYPE resource)
     {
         std::unique_lock<std::mutex> locker(m_queueLock);
@@ -94,10 +124,12 @@ private:
 class CurlContainer
 {
 public:
-    explicit CurlContainer(unsigned maxSize = 25, long socketTimeout = 30000, long connectTimeout = 10000):
+    explicit CurlContainer(unsigned maxSize = 25, long socketTimeout = 30000, long connectTimeout = 10000,
+                           unsigned maxIdleCount = 0):
               maxPoolSize_(maxSize),
               socketTimeout_(socketTimeout),
               connectTimeout_(connectTimeout),
+              maxIdleCount_(maxIdleCount),
               poolSize_(0)
     {
     }
@@ -107,6 +139,7 @@ public:
         for (CURL* handle : handleContainer_.ShutdownAndWait(poolSize_)) {
             curl_easy_cleanup(handle);
         }
+        MetricsRegistry::instance()->addPoolSize(-static_cast<int64_t>(poolSize_));
     }
 
     CURL* Acquire()
@@ -114,24 +147,44 @@ public:
         if(!handleContainer_.HasResourcesAvailable()) {
             growPool();
         }
+        // 指标关闭时不更新连接池 gauge；计入 in use 的句柄用 CURLOPT_PRIVATE 标记，归还时据此扣减，
+        // 请求过程中开关指标也不会使 gauge 漂移
+        if (!MetricsRegistry::Enabled()) {
+            return handleContainer_.Acquire();
+        }
+        auto metrics = MetricsRegistry::instance();
+        metrics->addPoolWaiting(1);
         CURL* handle = handleContainer_.Acquire();
+        metrics->addPoolWaiting(-1);
+        metrics->addPoolInUse(1);
+        curl_easy_setopt(handle, CURLOPT_PRIVATE, this);
         return handle;
     }
 
-    void Release(CURL* handle, bool force)
+    // 返回 handle 是否被换成了新句柄
+    bool Release(CURL* handle, bool force)
     {
+        bool replaced = false;
         if (handle) {
+            char* counted = nullptr;
+            curl_easy_getinfo(handle, CURLINFO_PRIVATE, &counted);
             curl_easy_reset(handle);
-            if (force) {
+            // 空闲句柄过多时换成新句柄，关闭其缓存的连接
+            if (force || (maxIdleCount_ > 0 && handleContainer_.Size() >= maxIdleCount_)) {
                 CURL* newhandle = curl_easy_init();
                 if (newhandle) {
                     curl_easy_cleanup(handle);
                     handle = newhandle;
+                    replaced = true;
                 }
             }
             setDefaultOptions(handle);
             handleContainer_.Release(handle);
+            if (counted != nullptr) {
+                MetricsRegistry::instance()->addPoolInUse(-1);
+            }
         }
+        return replaced;
     }
 
 private:
@@ -159,6 +212,7 @@ private:
                 }
             }
             poolSize_ += actuallyAdded;
+            MetricsRegistry::instance()->addPoolSize(actuallyAdded);
             return actuallyAdded > 0;
         }
         return false;
@@ -184,6 +238,7 @@ private:
     unsigned maxPoolSize_;
     unsigned long socketTimeout_;
     unsigned long connectTimeout_;
+    unsigned maxIdleCount_;
     unsigned poolSize_;
     std::mutex containerLock_;
 };
@@ -209,14 +264,28 @@ public:
 private:
     void setShareHandle(void* curl_handle, int cacheTime);
     void removeDNS(void* curl_handle, const std::shared_ptr<HttpRequest>& request);
+    // keepalive、缓冲区、空闲连接等与具体请求无关的参数
+    void setTransferOptions(void* curl_handle);
     CURLSH* share_handle = nullptr;
+    // 开启 enableDnsLoadBalance 时非空，通过 CURLOPT_CONNECT_TO 指定每个请求连接的地址
+    std::shared_ptr<HostResolver> resolver_;
+    // curl 句柄上次连接的地址，优先沿用以复用连接。句柄被替换时移除，大小不超过连接池
+    std::map<void*, std::string> handleAddress_;
 
 private:
     int requestTimeout_ = 0;
     int socketTimeout_ = 30000;
-    int dialTimeout_;
-    int tcpKeepAlive_;
+    int dialTimeout_ = 0;
+    int tcpKeepAlive_ = 0;
+    int tcpKeepAliveInterval_ = 0;
     int connectTimeout_ = 10000;
+    int responseHeaderTimeout_ = 0;
+    int readTimeout_ = 0;
+    int writeTimeout_ = 0;
+    int idleConnectionTimeout_ = 0;
+    int receiveBufferSize_ = 0;
+    int uploadBufferSize_ = 0;
+    SocketOptions socketOptions_;
     bool enableVerifySSL_ = true;
     std::string proxyHost_;
     int proxyPort_ = -1;
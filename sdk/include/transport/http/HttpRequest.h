@@ -2,12 +2,15 @@
 
 #include "common/Common.h"
 #include "Url.h"
+#include "Body.h"
+#include "TransferMonitor.h"
 #include "Type.h"
 #include <memory>
 #include <sstream>
 #include <string>
 
 namespace VolcengineTos {
+class OperationMetrics;
 
 class HttpRequest {
 public:
@@ -44,6 +47,19 @@ public:
     void setBody(const std::shared_ptr<std::iostream>& body) {
         body_ = body;
     }
+    // 传输层从 bodySource 读取请求体，向 responseSink 写入 2xx 的响应体
+    const std::shared_ptr<BodySource>& getBodySource() const {
+        return bodySource_;
+    }
+    void setBodySource(const std::shared_ptr<BodySource>& bodySource) {
+        bodySource_ = bodySource;
+    }
+    const std::shared_ptr<BodySink>& getResponseSink() const {
+        return responseSink_;
+    }
+    void setResponseSink(const std::shared_ptr<BodySink>& responseSink) {
+        responseSink_ = responseSink;
+    }
 
     const std::string& method() {
         return method_;
@@ -97,12 +113,36 @@ public:
     void setRateLimiter(const std::shared_ptr<RateLimiter>& rateLimiter) {
         rateLimiter_ = rateLimiter;
     }
+    const std::shared_ptr<TransferMonitor>& getTransferMonitor() const {
+        return transferMonitor_;
+    }
+    void setTransferMonitor(const std::shared_ptr<TransferMonitor>& transferMonitor) {
+        transferMonitor_ = transferMonitor;
+    }
+    bool isFreshConnection() const {
+        return freshConnection_;
+    }
+    void setFreshConnection(bool freshConnection) {
+        freshConnection_ = freshConnection;
+    }
     uint64_t getPreHashCrc64Ecma() const {
         return preHashCrc64ecma_;
     }
     void setPreHashCrc64Ecma(uint64_t prehashcrc64ecma) {
         preHashCrc64ecma_ = prehashcrc64ecma;
     }
+    const std::string& getFuncName() const {
+        return funcName_;
+    }
+    void setFuncName(const std::string& funcName) {
+        funcName_ = funcName;
+    }
+    const std::shared_ptr<OperationMetrics>& getOperationMetrics() const {
+        return operationMetrics_;
+    }
+    void setOperationMetrics(const std::shared_ptr<OperationMetrics>& operationMetrics) {
+        operationMetrics_ = operationMetrics;
+    }
 
 private:
     std::string method_;
@@ -112,9 +152,15 @@ private:
     std::map<std::string, std::string> headers_;
     std::shared_ptr<std::iostream> body_;
     std::shared_ptr<std::iostream> responseOutput_;
+    std::shared_ptr<BodySource> bodySource_;
+    std::shared_ptr<BodySink> responseSink_;
     DataTransferListener dataTransferListener_ = {nullptr, nullptr};
     std::shared_ptr<RateLimiter> rateLimiter_ = nullptr;
+    std::shared_ptr<TransferMonitor> transferMonitor_;
+    bool freshConnection_ = false;
     bool checkCrc64 = false;
     uint64_t preHashCrc64ecma_ = 0;
+    std::string funcName_;
+    std::shared_ptr<OperationMetrics> operationMetrics_;
 };
 }  // namespace VolcengineTos
@@ -86,6 +86,13 @@ public:
     void setCurlErrCode(int curlErrCode) {
         curlErrCode_ = curlErrCode;
     }
+    // 建连或 TLS 握手未完成，请求没有到达服务端
+    bool isConnectFailed() const {
+        return connectFailed_;
+    }
+    void setConnectFailed(bool connectFailed) {
+        connectFailed_ = connectFailed;
+    }
 
 private:
     int status_;  // succ, refused, otherErr
@@ -97,5 +104,6 @@ private:
     size_t bodySize_;
     uint64_t hashCrc64Result = 0;
     int curlErrCode_ = 0;
+    bool connectFailed_ = false;
 };
 }  // namespace VolcengineTos
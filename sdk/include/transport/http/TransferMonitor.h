@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace VolcengineTos {
+// 监控单个请求的收发进度，可在其他线程中止请求。
+// 被中止的请求以 CURLE_ABORTED_BY_CALLBACK 失败，不自动重试，所用连接随之关闭
+class TransferMonitor {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // 传输层每次发出请求（包括重试）时调用，进度从 0 开始统计
+    void start() {
+        transferred_.store(0, std::memory_order_relaxed);
+        startTime_.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+    }
+    // 本次请求已收发的字节数，包括请求体与响应体
+    void update(int64_t transferred) {
+        transferred_.store(transferred, std::memory_order_relaxed);
+    }
+    int64_t transferred() const {
+        return transferred_.load(std::memory_order_relaxed);
+    }
+    // 本次请求开始后经过的毫秒数，尚未开始时返回 0
+    int64_t elapsedMillis() const {
+        auto start = startTime_.load(std::memory_order_relaxed);
+        if (start == 0) {
+            return 0;
+        }
+        auto elapsed = Clock::now() - Clock::time_point(Clock::duration(start));
+        return std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+    }
+
+    void abort() {
+        aborted_.store(true, std::memory_order_relaxed);
+    }
+    bool aborted() const {
+        return aborted_.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<int64_t> transferred_{0};
+    std::atomic<Clock::rep> startTime_{0};
+    std::atomic<bool> aborted_{false};
+};
+}  // namespace VolcengineTos
@@ -3,6 +3,9 @@
 #pragma once
 #include <stdint.h>
 #include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <vector>
 
 namespace VolcengineTos {
 class CRC64
@@ -11,5 +14,16 @@ public:
     static uint64_t CalcCRC(uint64_t crc, void *buf, size_t len);
     static uint64_t CombineCRC(uint64_t crc1, uint64_t crc2, uintmax_t len2);
     static uint64_t CalcCRC(uint64_t crc, void *buf, size_t len, bool little);
+
+    // 以下实现在 crc64File.cc，文件按 8MB 分块并发计算后用 CombineCRC 合并，读取失败时返回 false
+    static bool CalcFileCRC(const std::string &filePath, int threads, uint64_t &crc);
+    // 按 partSize 切分文件，返回每个分片的 CRC64，与分片上传的 HashCrc64ecma 一一对应
+    static bool CalcFilePartCRC(const std::string &filePath, int64_t partSize, int threads,
+                                std::vector<uint64_t> &partCRCs);
+    // 只计算 selected 中为 true 的分片，其余分片不读取，CRC64 记为 0
+    static bool CalcFilePartCRC(const std::string &filePath, int64_t partSize, int threads,
+                                const std::vector<bool> &selected, std::vector<uint64_t> &partCRCs);
+    // 顺序读取 stream 直到结尾，读取与多线程计算同时进行
+    static bool CalcStreamCRC(std::istream &stream, int threads, uint64_t &crc);
 };
 } // namespace VolcengineTos
@@ -16,6 +16,7 @@ std::shared_ptr<TosRequest> RequestBuilder::build(const std::string& method) {
     }
 
     auto req = std::make_shared<TosRequest>(scheme_, method, host, path, headers_, query_);
+    req->setBucketAndObjectKey(bucket_, object_);
     return req;
 }
 std::shared_ptr<TosRequest> RequestBuilder::buildSignedURL(const std::string& method) {
@@ -57,6 +58,19 @@ std::shared_ptr<TosRequest> RequestBuilder::Build(const std::string& method, std
     return req;
 }
 
+std::shared_ptr<TosRequest> RequestBuilder::BuildWithBodySource(const std::string& method,
+                                                                const std::shared_ptr<BodySource>& body) {
+    auto req = RequestBuilder::Build(method);
+    if (body) {
+        req->setBodySource(body);
+        if (this->getContentLength() != 0)
+            req->setContentLength(this->getContentLength());
+        else
+            req->resolveContentLength();
+    }
+    return req;
+}
+
 std::string copySource(const std::string& bucket, const std::string& object_, const std::string& versionID) {
     std::string ret;
     auto object = SignV4::uriEncode(object_, false);
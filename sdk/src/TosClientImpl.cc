@@ -6,12 +6,15 @@
 #include "TosClient.h"
 #include "transport/DefaultTransport.h"
 #include "transport/TransportConfig.h"
+#include "transport/EndpointSelector.h"
 #include "utils/MimeType.h"
 #include "model/object/UploadFileInfo.h"
 #include "model/object/UploadFileCheckpoint.h"
 #include "utils/crc64.h"
 #include "model/object/UploadFileCheckpointV2.h"
 #include "utils/LogUtils.h"
+#include "utils/JsonWriter.h"
+#include "metrics/Metrics.h"
 #include "model/object/DownloadFileCheckpoint.h"
 #include "model/object/PostSignatureConditionInner.h"
 #include "model/object/PostPolicyInner.h"
@@ -20,6 +23,8 @@
 #include "model/object/ResumableCopyPartInfo.h"
 #include "model/object/ResumableCopyCheckpoint.h"
 #include "model/acl/PolicyURLInner.h"
+#include "transfer/ScatterBodySink.h"
+#include <algorithm>
 #include <cstring>
 #include <fstream>
 #include <sys/stat.h>
@@ -109,8 +114,23 @@ void TosClientImpl::init(const std::string& endpoint, const std::string& region,
     conf.setProxyUsername(config.proxyUsername);
     conf.setProxyPassword(config.proxyPassword);
     conf.setDnsCacheTime(config.dnsCacheTime);
+    conf.setEnableDnsLoadBalance(config.enableDnsLoadBalance);
     conf.setMaxConnections(config.maxConnections);
     conf.setSocketTimeout(config.socketTimeout);
+    conf.setDialTimeout(config.dialTimeout);
+    conf.setTlsHandshakeTimeout(config.tlsHandshakeTimeout);
+    conf.setResponseHeaderTimeout(config.responseHeaderTimeout);
+    conf.setReadTimeout(config.readTimeout);
+    conf.setWriteTimeout(config.writeTimeout);
+    conf.setKeepAlive(config.tcpKeepAlive);
+    conf.setKeepAliveInterval(config.tcpKeepAliveInterval);
+    conf.setKeepAliveCount(config.tcpKeepAliveCount);
+    conf.setMaxIdleCount(config.maxIdleConnections);
+    conf.setIdleConnectionTimeout(config.idleConnectionTimeout);
+    conf.setReceiveBufferSize(config.receiveBufferSize);
+    conf.setUploadBufferSize(config.uploadBufferSize);
+    conf.setSocketSendBufferSize(config.socketSendBufferSize);
+    conf.setSocketReceiveBufferSize(config.socketReceiveBufferSize);
     transport_ = std::make_shared<DefaultTransport>(conf);
 
     // 保存参数到 config_ 里
@@ -122,6 +142,24 @@ void TosClientImpl::init(const std::string& endpoint, const std::string& region,
     config_.setEnableCrc(config.enableCRC);
     config_.setAutoRecognizeContentType(config.autoRecognizeContentType);
     config_.setMaxRetryCount(config.maxRetryCount);
+    if (config.enableObjectCache) {
+        objectCache_ = std::make_shared<ObjectCache>(config.objectCacheOptions);
+    }
+    if (config.enableObjectMetaCache) {
+        objectMetaCache_ = std::make_shared<ObjectMetaCache>(config.objectMetaCacheOptions);
+    }
+    enableStragglerDetection_ = config.enableStragglerDetection;
+    stragglerOptions_ = config.stragglerOptions;
+    partRetryOptions_ = config.partRetryOptions;
+    multipartThreshold_ = config.multipartThreshold;
+    parallelGetThreshold_ = config.parallelGetThreshold;
+    parallelPartSize_ = config.parallelPartSize;
+    parallelTaskNum_ = config.parallelTaskNum;
+    if (config.enableRequestCoalescing) {
+        headFlight_ = std::make_shared<SingleFlight<Outcome<TosError, HeadObjectV2Output>>>();
+        getFlight_ = std::make_shared<SingleFlight<CoalescedGetResult>>();
+    }
+    trackObjectWrites_ = objectCache_ != nullptr || objectMetaCache_ != nullptr || headFlight_ != nullptr;
     auto schemeHostParameter = initSchemeAndHost(endpoint);
     scheme_ = schemeHostParameter.scheme_;
     host_ = schemeHostParameter.host_;
@@ -132,6 +170,15 @@ void TosClientImpl::init(const std::string& endpoint, const std::string& region,
     if (NetUtils::isS3Endpoint(host_)) {
         connectWithS3EndPoint_ = true;
     }
+    if (!config.failoverEndpoints.empty() && !config.isCustomDomain) {
+        std::vector<EndpointSelector::Endpoint> endpoints = {{scheme_, host_}};
+        for (const auto& e : config.failoverEndpoints) {
+            auto p = initSchemeAndHost(e);
+            endpoints.push_back(EndpointSelector::Endpoint{p.scheme_, p.host_});
+        }
+        endpointSelector_ = std::make_shared<EndpointSelector>(endpoints, config.endpointProbeInterval,
+                                                               EndpointSelector::httpProbe(conf));
+    }
 }
 
 SchemeHostParameter TosClientImpl::initSchemeAndHost(const std::string& endpoint) {
@@ -303,7 +350,7 @@ Outcome<TosError, CreateBucketOutput> TosClientImpl::createBucket(const CreateBu
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     output.setLocation(tosRes.result()->findHeader(http::HEADER_LOCATION));
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -344,7 +391,7 @@ Outcome<TosError, CreateBucketV2Output> TosClientImpl::createBucket(const Create
 
     output.setLocation(tosRes.result()->findHeader(http::HEADER_LOCATION));
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, HeadBucketOutput> TosClientImpl::headBucket(const std::string& bucket) {
@@ -370,7 +417,7 @@ Outcome<TosError, HeadBucketOutput> TosClientImpl::headBucket(const std::string&
     output.setRegion(tosRes.result()->findHeader(HEADER_BUCKET_REGION));
     output.setStorageClass(tosRes.result()->findHeader(HEADER_STORAGE_CLASS));
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, HeadBucketV2Output> TosClientImpl::headBucket(const HeadBucketV2Input& input) {
@@ -397,7 +444,7 @@ Outcome<TosError, HeadBucketV2Output> TosClientImpl::headBucket(const HeadBucket
     output.setStorageClass(StringtoStorageClassType[tosRes.result()->findHeader(HEADER_STORAGE_CLASS)]);
     output.setAzRedundancy(StringtoAzRedundancyType[tosRes.result()->findHeader(HEADER_AZ_REDUNDANCY)]);
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -422,7 +469,7 @@ Outcome<TosError, DeleteBucketOutput> TosClientImpl::deleteBucket(const std::str
     DeleteBucketOutput output;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, DeleteBucketOutput> TosClientImpl::deleteBucket(const DeleteBucketInput& input) {
@@ -448,7 +495,7 @@ Outcome<TosError, DeleteBucketOutput> TosClientImpl::deleteBucket(const DeleteBu
     DeleteBucketOutput output;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, ListBucketsOutput> TosClientImpl::listBuckets(const ListBucketsInput& input) {
@@ -467,7 +514,7 @@ Outcome<TosError, ListBucketsOutput> TosClientImpl::listBuckets(const ListBucket
     ss << tosRes.result()->getContent()->rdbuf();
     output.fromJsonString(ss.str());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -497,7 +544,7 @@ Outcome<TosError, PutBucketPolicyOutput> TosClientImpl::putBucketPolicy(const st
     PutBucketPolicyOutput output;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -528,7 +575,7 @@ Outcome<TosError, GetBucketPolicyOutput> TosClientImpl::getBucketPolicy(const st
     ss << tosRes.result()->getContent()->rdbuf();
     output.setPolicy(ss.str());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -556,7 +603,7 @@ Outcome<TosError, DeleteBucketPolicyOutput> TosClientImpl::deleteBucketPolicy(co
     DeleteBucketPolicyOutput output;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -592,18 +639,6 @@ Outcome<TosError, GetObjectOutput> TosClientImpl::getObject(const std::string& b
     return res;
 }
 
-int64_t TosClientImpl::calContentLength(const std::shared_ptr<std::iostream>& content) {
-    int64_t currentPos = content->tellg();
-    if (currentPos == static_cast<std::streampos>(-1)) {
-        currentPos = 0;
-        content->clear();
-    }
-    content->seekg(0, content->end);
-    int64_t size = content->tellg();
-    content->seekg(currentPos, content->beg);
-    return size;
-}
-
 static std::string isValidSSEC(const std::string& SSECAlgorithm, const std::string& SSECKey,
                                const std::string& SSECKeyMd5) {
     if (SSECAlgorithm.empty() && SSECKey.empty() && SSECKeyMd5.empty()) {
@@ -667,9 +702,330 @@ static void getObjectSetOptionHeader(RequestBuilder& rb, const GetObjectV2Input&
     rb.withQueryCheckEmpty("response-expires", TimeUtils::transTimeToGmtTime(input.getResponseExpires()));
     rb.withQueryCheckEmpty("versionId", input.getVersionId());
 }
+// 解析非负整数，str 必须全部为数字
+static bool parseInt64(const std::string& str, int64_t& value) {
+    if (str.empty() || str.size() > 18) {
+        return false;
+    }
+    value = 0;
+    for (char c : str) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        value = value * 10 + (c - '0');
+    }
+    return true;
+}
+
+// 只有普通读可以使用缓存：不带条件头、SSE-C、图片处理、响应头重写、进度回调和限速，
+// 范围只支持 bytes=a-b 和 bytes=a-
+static bool objectCacheable(const GetObjectV2Input& input, int64_t& start, int64_t& end, bool& ranged) {
+    if (!input.getIfMatch().empty() || !input.getIfNoneMatch().empty() || input.getIfModifiedSince() != 0 ||
+        input.getIfUnmodifiedSince() != 0 || !input.getSsecAlgorithm().empty() || !input.getProcess().empty() ||
+        !input.getResponseCacheControl().empty() || !input.getResponseContentDisposition().empty() ||
+        !input.getResponseContentEncoding().empty() || !input.getResponseContentLanguage().empty() ||
+        !input.getResponseContentType().empty() || input.getResponseExpires() != 0 || input.getTrafficLimit() != 0 ||
+        input.getDataTransferListener().dataTransferStatusChange_ != nullptr || input.getRateLimiter() != nullptr) {
+        return false;
+    }
+    start = 0;
+    end = -1;
+    ranged = false;
+    const auto& range = input.getRange();
+    if (!range.empty()) {
+        if (range.compare(0, 6, "bytes=") != 0) {
+            return false;
+        }
+        auto dash = range.find('-', 6);
+        if (dash == std::string::npos || !parseInt64(range.substr(6, dash - 6), start)) {
+            return false;
+        }
+        if (dash + 1 < range.size() && (!parseInt64(range.substr(dash + 1), end) || end < start)) {
+            return false;
+        }
+        ranged = true;
+    } else if (input.getRangeStart() != 0 || input.getRangeEnd() != 0) {
+        if (input.getRangeEnd() < input.getRangeStart()) {
+            return false;
+        }
+        start = input.getRangeStart();
+        end = input.getRangeEnd();
+        ranged = true;
+    }
+    return true;
+}
+
+// 从响应中取出本次数据在对象中的起始位置和对象总大小
+static bool objectRangeFromOutput(const GetObjectBasicOutput& output, int64_t& offset, int64_t& size) {
+    const auto& contentRange = output.getContentRange();
+    if (contentRange.empty()) {
+        offset = 0;
+        size = output.getContentLength();
+        return size >= 0;
+    }
+    // bytes start-end/total
+    auto space = contentRange.find(' ');
+    auto dash = contentRange.find('-');
+    auto slash = contentRange.find('/');
+    if (space == std::string::npos || dash == std::string::npos || slash == std::string::npos || dash < space) {
+        return false;
+    }
+    return parseInt64(contentRange.substr(space + 1, dash - space - 1), offset) &&
+           parseInt64(contentRange.substr(slash + 1), size);
+}
+
+static std::string readAll(const std::shared_ptr<std::iostream>& content) {
+    if (content == nullptr) {
+        return "";
+    }
+    std::stringstream ss;
+    ss << content->rdbuf();
+    return ss.str();
+}
+
+// 缓存中保存完整对象视角的元数据
+static CachedObjectMeta cachedMetaFromOutput(const GetObjectBasicOutput& output, int64_t size) {
+    CachedObjectMeta meta;
+    meta.basicOutput = output;
+    meta.basicOutput.setContentRange("");
+    meta.basicOutput.setContentLength(size);
+    meta.etag = output.getETags();
+    meta.size = size;
+    return meta;
+}
+
+static Outcome<TosError, GetObjectV2Output> cachedObjectOutcome(GetObjectBasicOutput basicOutput, int64_t start,
+                                                                 int64_t size, bool ranged, std::string& data,
+                                                                 const std::shared_ptr<std::iostream>& fileContent) {
+    Outcome<TosError, GetObjectV2Output> res;
+    auto length = static_cast<int64_t>(data.size());
+    basicOutput.setContentLength(length);
+    if (ranged) {
+        basicOutput.setContentRange("bytes " + std::to_string(start) + "-" + std::to_string(start + length - 1) +
+                                    "/" + std::to_string(size));
+    } else {
+        basicOutput.setContentRange("");
+    }
+    GetObjectV2Output output;
+    output.setGetObjectBasicOutput(basicOutput);
+    if (fileContent != nullptr) {
+        fileContent->write(data.data(), length);
+        if (!fileContent->good()) {
+            TosError error;
+            error.setIsClientError(true);
+            error.setMessage("write file failed");
+            res.setE(error);
+            res.setSuccess(false);
+            return res;
+        }
+        output.setContent(fileContent);
+    } else {
+        output.setContent(std::make_shared<std::stringstream>(std::move(data)));
+    }
+    res.setSuccess(true);
+    res.setR(std::move(output));
+    return res;
+}
+
+bool TosClientImpl::fillObjectCache(const GetObjectV2Input& input, const std::string& cacheKey,
+                                    const CachedObjectMeta& meta, int64_t start, int64_t end, uint64_t epoch) {
+    int64_t firstBlock = 0, lastBlock = 0;
+    if (!objectCache_->missingBlocks(cacheKey, start, end, firstBlock, lastBlock)) {
+        return true;
+    }
+    // 按块对齐补齐缺失的部分，If-Match 保证拿到的仍是同一个版本
+    auto blockSize = objectCache_->options().blockSize;
+    auto offset = firstBlock * blockSize;
+    GetObjectV2Input fetchInput(input.getBucket(), input.getKey());
+    fetchInput.setVersionId(input.getVersionId());
+    fetchInput.setIfMatch(meta.etag);
+    fetchInput.setRange(HttpRange(offset, std::min((lastBlock + 1) * blockSize, meta.size) - 1).toString());
+    auto fetchRes = getObjectFromServer(fetchInput, nullptr, nullptr);
+    if (!fetchRes.isSuccess()) {
+        if (fetchRes.error().getStatusCode() == 412) {
+            objectCache_->invalidate(cacheKey);
+        }
+        return false;
+    }
+    objectCache_->put(cacheKey, meta, offset, readAll(fetchRes.result().getContent()), epoch);
+    return true;
+}
+
+// 返回 false 时由调用方直接请求服务端
+bool TosClientImpl::getObjectFromCache(const GetObjectV2Input& input, int64_t start, int64_t end, bool ranged,
+                                       const std::shared_ptr<std::iostream>& fileContent,
+                                       Outcome<TosError, GetObjectV2Output>& res) {
+    auto cacheKey = ObjectCache::CacheKey(input.getBucket(), input.getKey(), input.getVersionId());
+    // 在发出任何请求前记录 epoch，请求期间本 client 写过该对象时不把读到的数据放入缓存
+    auto epoch = objectCache_->epoch(cacheKey);
+    if (objectCache_->uncacheable(cacheKey)) {
+        objectCache_->recordMiss();
+        return false;
+    }
+    CachedObjectMeta meta;
+    bool fresh = false;
+    if (objectCache_->getMeta(cacheKey, meta, fresh)) {
+        bool valid = fresh;
+        if (!fresh) {
+            // 超过 ttl 后用 If-None-Match 重新校验，304 表示对象未变化
+            HeadObjectV2Input headInput(input.getBucket(), input.getKey(), input.getVersionId());
+            headInput.setIfNoneMatch(meta.etag);
+            auto headRes = headObject(headInput);
+            valid = (!headRes.isSuccess() && headRes.error().getStatusCode() == 304) ||
+                    (headRes.isSuccess() && headRes.result().getETags() == meta.etag);
+            if (valid) {
+                objectCache_->markValidated(cacheKey);
+                objectCache_->recordRevalidation();
+            } else {
+                objectCache_->invalidate(cacheKey);
+            }
+        }
+        if (valid && ranged && start >= meta.size) {
+            // 越界的范围交给服务端返回 416
+            return false;
+        }
+        int64_t last = end < 0 ? meta.size - 1 : std::min(end, meta.size - 1);
+        std::string data;
+        if (valid && fillObjectCache(input, cacheKey, meta, start, last, epoch) &&
+            objectCache_->read(cacheKey, start, last, data)) {
+            objectCache_->recordHit(data.size());
+            res = cachedObjectOutcome(meta.basicOutput, start, meta.size, ranged, data, fileContent);
+            return true;
+        }
+    }
+    objectCache_->recordMiss();
+
+    if (fileContent != nullptr) {
+        // 写文件的场景直接写入文件，再从文件读回需要缓存的部分，避免大对象占用内存
+        res = getObjectFromServer(input, nullptr, fileContent);
+        int64_t offset = 0, size = 0;
+        if (!res.isSuccess() || !objectRangeFromOutput(res.result().getGetObjectBasicOutput(), offset, size)) {
+            return true;
+        }
+        if (!objectCache_->admits(size)) {
+            objectCache_->markUncacheable(cacheKey);
+            return true;
+        }
+        auto fetchedMeta = cachedMetaFromOutput(res.result().getGetObjectBasicOutput(), size);
+        auto length = res.result().getGetObjectBasicOutput().getContentLength();
+        auto blockSize = objectCache_->options().blockSize;
+        fileContent->flush();
+        fileContent->seekg(0, std::ios::beg);
+        std::string buf;
+        for (int64_t pos = 0; pos < length && fileContent->good();) {
+            // 每次读到下一个块边界，保证 put 的数据按块对齐
+            auto n = std::min(length - pos, blockSize - (offset + pos) % blockSize);
+            buf.resize(static_cast<size_t>(n));
+            fileContent->read(&buf[0], n);
+            if (fileContent->gcount() != n) {
+                break;
+            }
+            objectCache_->put(cacheKey, fetchedMeta, offset + pos, buf, epoch);
+            pos += n;
+        }
+        fileContent->clear();
+        fileContent->seekp(0, std::ios::end);
+        return true;
+    }
+
+    // 范围读按块对齐后请求，后续相邻的范围读可以直接命中
+    GetObjectV2Input fetchInput = input;
+    if (ranged) {
+        auto blockSize = objectCache_->options().blockSize;
+        auto alignedStart = start / blockSize * blockSize;
+        fetchInput.setRangeStart(0);
+        fetchInput.setRangeEnd(0);
+        if (end < 0) {
+            fetchInput.setRange("bytes=" + std::to_string(alignedStart) + "-");
+        } else {
+            fetchInput.setRange(HttpRange(alignedStart, (end / blockSize + 1) * blockSize - 1).toString());
+        }
+    }
+    auto fetchRes = getObjectFromServer(fetchInput, nullptr, nullptr);
+    if (!fetchRes.isSuccess()) {
+        res = std::move(fetchRes);
+        return true;
+    }
+    int64_t offset = 0, size = 0;
+    const auto& basicOutput = fetchRes.result().getGetObjectBasicOutput();
+    if (!objectRangeFromOutput(basicOutput, offset, size) || offset > start || (ranged && start >= size)) {
+        return false;
+    }
+    if (!objectCache_->admits(size)) {
+        // 之后对该对象的读直接请求服务端
+        objectCache_->markUncacheable(cacheKey);
+        if (!ranged) {
+            res = std::move(fetchRes);
+            return true;
+        }
+    }
+    auto body = readAll(fetchRes.result().getContent());
+    auto fetchedMeta = cachedMetaFromOutput(basicOutput, size);
+    objectCache_->put(cacheKey, fetchedMeta, offset, body, epoch);
+    int64_t last = end < 0 ? size - 1 : std::min(end, size - 1);
+    if (last - offset + 1 > static_cast<int64_t>(body.size())) {
+        return false;
+    }
+    std::string data;
+    if (start == offset && last - start + 1 == static_cast<int64_t>(body.size())) {
+        data = std::move(body);
+    } else {
+        data = body.substr(start - offset, last - start + 1);
+    }
+    res = cachedObjectOutcome(fetchedMeta.basicOutput, start, size, ranged, data, nullptr);
+    return true;
+}
+
+void TosClientImpl::invalidateObjectCache(const std::string& bucket, const std::string& key) {
+    objectWriteEpoch_.fetch_add(1);
+    if (objectCache_ != nullptr) {
+        objectCache_->invalidateObject(bucket, key);
+    }
+    if (objectMetaCache_ != nullptr) {
+        objectMetaCache_->invalidateObject(bucket, key);
+    }
+}
+
+void TosClientImpl::invalidateObjectCache(const std::string& bucket, const std::vector<ObjectTobeDeleted>& objects) {
+    if (!trackObjectWrites_) {
+        return;
+    }
+    for (const auto& object : objects) {
+        invalidateObjectCache(bucket, object.getKey());
+    }
+}
+
+ObjectMetaCacheStats TosClientImpl::getObjectMetaCacheStats() const {
+    ObjectMetaCacheStats stats;
+    if (objectMetaCache_ != nullptr) {
+        stats = objectMetaCache_->stats();
+    }
+    if (headFlight_ != nullptr) {
+        stats.coalescedHeads = headFlight_->shared();
+        stats.coalescedGets = getFlight_->shared();
+    }
+    return stats;
+}
+
+ObjectCacheStats TosClientImpl::getObjectCacheStats() const {
+    if (objectCache_ == nullptr) {
+        return ObjectCacheStats();
+    }
+    return objectCache_->stats();
+}
+
+std::shared_ptr<TaskExecutor> TosClientImpl::executor() {
+    std::lock_guard<std::mutex> lock(executorMu_);
+    if (executor_ == nullptr) {
+        executor_ = std::make_shared<TaskExecutor>(parallelTaskNum_);
+    }
+    return executor_;
+}
+
 Outcome<TosError, GetObjectV2Output> TosClientImpl::getObject(const GetObjectV2Input& input,
                                                               std::shared_ptr<uint64_t> hashCrc64ecma,
-                                                              std::shared_ptr<std::iostream> fileContent) {
+                                                              std::shared_ptr<std::iostream> fileContent,
+                                                              const PartRequestOptions& partOptions) {
     Outcome<TosError, GetObjectV2Output> res;
     std::string check = isValidNames(input.getBucket(), {input.getKey()}, config_.isCustomDomain());
     if (!check.empty()) {
@@ -698,11 +1054,87 @@ Outcome<TosError, GetObjectV2Output> TosClientImpl::getObject(const GetObjectV2I
         res.setSuccess(false);
         return res;
     }
+    // 计算 crc64 的 downloadFile 场景不走缓存，也不合并请求
+    int64_t start = 0, end = -1;
+    bool ranged = false;
+    if ((objectCache_ == nullptr && getFlight_ == nullptr) || hashCrc64ecma != nullptr ||
+        !objectCacheable(input, start, end, ranged)) {
+        return getObjectFromServer(input, hashCrc64ecma, fileContent, nullptr, partOptions);
+    }
+    // 写文件的调用各自写入自己的文件，不合并
+    if (getFlight_ != nullptr && fileContent == nullptr) {
+        return getObjectCoalesced(input, start, end, ranged);
+    }
+    if (objectCache_ != nullptr && getObjectFromCache(input, start, end, ranged, fileContent, res)) {
+        return res;
+    }
+    return getObjectFromServer(input, nullptr, fileContent);
+}
+
+Outcome<TosError, GetObjectV2Output> TosClientImpl::getObject(const GetObjectV2Input& input,
+                                                              std::shared_ptr<BodySink> sink) {
+    Outcome<TosError, GetObjectV2Output> res;
+    std::string check = isValidNames(input.getBucket(), {input.getKey()}, config_.isCustomDomain());
+    if (check.empty()) {
+        check = isValidSSEC(input.getSsecAlgorithm(), input.getSsecKey(), input.getSsecKeyMd5());
+    }
+    if (check.empty()) {
+        check = isValidRange(input.getRangeStart(), input.getRangeEnd());
+    }
+    if (check.empty() && sink == nullptr) {
+        check = "empty sink";
+    }
+    if (!check.empty()) {
+        TosError error;
+        error.setIsClientError(true);
+        error.setMessage(check);
+        res.setE(error);
+        res.setSuccess(false);
+        return res;
+    }
+    res = getObjectFromServer(input, nullptr, nullptr, std::move(sink));
+    if (res.isSuccess()) {
+        // 响应体已写入 sink
+        res.result().setContent(nullptr);
+    }
+    return res;
+}
 
+Outcome<TosError, GetObjectV2Output> TosClientImpl::getObjectCoalesced(const GetObjectV2Input& input, int64_t start,
+                                                                       int64_t end, bool ranged) {
+    auto flightKey = ObjectCache::CacheKey(input.getBucket(), input.getKey(), input.getVersionId());
+    flightKey.append(1, '\n').append(ranged ? std::to_string(start) + "-" + std::to_string(end) : "");
+    flightKey.append(1, '\n').append(std::to_string(objectWriteEpoch_.load()));
+    auto shared = getFlight_->run(flightKey, [&]() {
+        CoalescedGetResult result;
+        if (objectCache_ == nullptr || !getObjectFromCache(input, start, end, ranged, nullptr, result.outcome)) {
+            result.outcome = getObjectFromServer(input, nullptr, nullptr);
+        }
+        if (result.outcome.isSuccess()) {
+            result.body = std::make_shared<std::string>(readAll(result.outcome.result().getContent()));
+            result.outcome.result().setContent(nullptr);
+        }
+        return result;
+    });
+    // 每个调用方拿到独立的 content
+    if (shared.outcome.isSuccess()) {
+        shared.outcome.result().setContent(std::make_shared<std::stringstream>(*shared.body));
+    }
+    return std::move(shared.outcome);
+}
+
+Outcome<TosError, GetObjectV2Output> TosClientImpl::getObjectFromServer(const GetObjectV2Input& input,
+                                                                        std::shared_ptr<uint64_t> hashCrc64ecma,
+                                                                        std::shared_ptr<std::iostream> fileContent,
+                                                                        std::shared_ptr<BodySink> sink,
+                                                                        const PartRequestOptions& partOptions) {
+    Outcome<TosError, GetObjectV2Output> res;
     auto rb = newBuilder(input.getBucket(), input.getKey());
     getObjectSetOptionHeader(rb, input);
     auto req = rb.Build(http::MethodGet, nullptr);
-    if (fileContent != nullptr) {
+    if (sink != nullptr) {
+        req->setResponseSink(sink);
+    } else if (fileContent != nullptr) {
         req->setFileContent(fileContent);
     }
     // 设置进度条回调
@@ -711,6 +1143,8 @@ Outcome<TosError, GetObjectV2Output> TosClientImpl::getObject(const GetObjectV2I
     // 设置客户端限速
     auto limiter = input.getRateLimiter();
     SetRateLimiterToReq(req, limiter);
+    req->setTransferMonitor(partOptions.monitor);
+    req->setFreshConnection(partOptions.freshConnection);
     // 设置Crc64校验信息, 由于downloadFile 需要使用计算出来的 crc64 所以打开校验
     // downloadFile 场景
     if (hashCrc64ecma != nullptr) {
@@ -749,7 +1183,7 @@ Outcome<TosError, GetObjectV2Output> TosClientImpl::getObject(const GetObjectV2I
     }
     // 断流校验由 libcurl 支持，对应错误码 18
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -758,48 +1192,573 @@ Outcome<TosError, GetObjectToFileOutput> TosClientImpl::getObjectToFile(const Ge
     if (input.getFilePath().empty()) {
         TosError error;
         error.setIsClientError(true);
-        error.setMessage("The file path is empty");
+        error.setMessage("The file path is empty");
+        res.setE(error);
+        res.setSuccess(false);
+        return res;
+    }
+    // 完整读取对象时先 GET 第一个分段，由 Content-Range 得到对象大小，超过阈值的对象其余部分改为分段并发下载。
+    // 该请求不经过元数据缓存和请求合并，避免以缓存中过期的 ETag 作为 If-Match
+    const auto& getInput = input.getGetObjectInput();
+    const auto& filePath = input.getFilePath();
+    struct stat fileStat {};
+    bool isDir = filePath.back() == TOS_PATH_DELIMITER ||
+                 (stat(filePath.c_str(), &fileStat) == 0 && (fileStat.st_mode & S_IFDIR));
+    if (parallelGetThreshold_ > 0 && !isDir && getInput.getRange().empty() && getInput.getRangeStart() == 0 &&
+        getInput.getRangeEnd() == 0 && getInput.getProcess().empty() && getInput.getResponseCacheControl().empty() &&
+        getInput.getResponseContentDisposition().empty() && getInput.getResponseContentEncoding().empty() &&
+        getInput.getResponseContentLanguage().empty() && getInput.getResponseContentType().empty() &&
+        getInput.getResponseExpires() == 0) {
+        bool fallback = false;
+        res = getObjectToFileParallel(input, fallback);
+        if (!fallback) {
+            return res;
+        }
+    }
+    // write to file
+    bool ret = FileUtils::CreateDir(input.getFilePath(), true);
+    if (!ret) {
+        // 错误处理，创建文件夹失败的场景
+        TosError error;
+        error.setMessage("invalid file path, mkdir failed");
+        error.setIsClientError(true);
+        res.setE(error);
+        res.setSuccess(false);
+        return res;
+    }
+    auto fileContent = std::make_shared<std::fstream>(
+            input.getFilePath(), std::ios_base::out | std::ios_base::in | std::ios_base::trunc | std::ios_base::binary);
+    if (!fileContent->good()) {
+        TosError error;
+        error.setIsClientError(true);
+        error.setMessage("open file failed");
+        res.setE(error);
+        res.setSuccess(false);
+        return res;
+    }
+
+    auto res_ = this->getObject(getInput, nullptr, fileContent);
+    if (!res_.isSuccess()) {
+        res.setE(res_.error());
+        res.setSuccess(false);
+        return res;
+    }
+    GetObjectToFileOutput output;
+    output.setGetObjectBasicOutput(res_.result().getGetObjectBasicOutput());
+
+    //    auto resContent = res_.result().getContent();
+    //    *content << resContent->rdbuf();
+    fileContent->close();
+    res.setSuccess(true);
+    res.setR(std::move(output));
+    return res;
+}
+
+Outcome<TosError, DownloadFileFileInfo> getDownloadFileFileInfo(const DownloadFileInput& input);
+void initDownloadEvent(const DownloadFileInput& input, const DownloadFileFileInfo& dfi,
+                       const std::string& checkpointFilePath, std::shared_ptr<DownloadEvent> event);
+
+static HeadObjectV2Output headOutputFromGet(const GetObjectBasicOutput& basicOutput) {
+    HeadObjectV2Output headOutput;
+    headOutput.setRequestInfo(basicOutput.getRequestInfo());
+    headOutput.setETags(basicOutput.getETags());
+    headOutput.setLastModified(basicOutput.getLastModified());
+    headOutput.setDeleteMarker(basicOutput.isDeleteMarker());
+    headOutput.setSsecAlgorithm(basicOutput.getSsecAlgorithm());
+    headOutput.setSsecKeyMd5(basicOutput.getSsecKeyMd5());
+    headOutput.setVersionId(basicOutput.getVersionId());
+    headOutput.setWebsiteRedirectLocation(basicOutput.getWebsiteRedirectLocation());
+    headOutput.setObjectType(basicOutput.getObjectType());
+    headOutput.setHashCrc64Ecma(basicOutput.getHashCrc64Ecma());
+    headOutput.setStorageClass(basicOutput.getStorageClass());
+    headOutput.setMeta(basicOutput.getMeta());
+    headOutput.setContentLength(basicOutput.getContentLength());
+    headOutput.setContentType(basicOutput.getContentType());
+    headOutput.setCacheControl(basicOutput.getCacheControl());
+    headOutput.setContentDisposition(basicOutput.getContentDisposition());
+    headOutput.setContentEncoding(basicOutput.getContentEncoding());
+    headOutput.setContentLanguage(basicOutput.getContentLanguage());
+    headOutput.setExpires(basicOutput.getExpires());
+    return headOutput;
+}
+
+// 以第一个分段的 ETag 读取其余部分时，412 表示对象已被覆盖，416 与 200 表示服务端没有按范围返回
+static bool parallelGetShouldFallback(int statusCode) {
+    return statusCode == 412 || statusCode == 416 || statusCode == 200;
+}
+
+Outcome<TosError, GetObjectToFileOutput> TosClientImpl::getObjectToFileParallel(const GetObjectToFileInput& input,
+                                                                               bool& fallback) {
+    Outcome<TosError, GetObjectToFileOutput> res;
+    TosError error;
+    fallback = false;
+    const auto& getInput = input.getGetObjectInput();
+    int64_t partSize = std::max<int64_t>(parallelPartSize_, 5 * 1024 * 1024);
+    DownloadFileInput download(getInput.getBucket(), getInput.getKey(), getInput.getVersionId());
+    download.setFilePath(input.getFilePath());
+    download.setSsecAlgorithm(getInput.getSsecAlgorithm());
+    download.setSsecKey(getInput.getSsecKey());
+    download.setSsecKeyMd5(getInput.getSsecKeyMd5());
+    download.setPartSize(partSize);
+    download.setTaskNum(parallelTaskNum_);
+    download.setDataTransferListener(getInput.getDataTransferListener());
+    download.setRateLimiter(getInput.getRateLimiter());
+    download.setTrafficLimit(getInput.getTrafficLimit());
+    auto dfi = getDownloadFileFileInfo(download);
+    if (!dfi.isSuccess()) {
+        res.setE(dfi.error());
+        res.setSuccess(false);
+        return res;
+    }
+    const std::string tempFilePath = dfi.result().getTempFilePath();
+    auto tempFile = std::make_shared<std::fstream>(
+            tempFilePath, std::ios_base::out | std::ios_base::in | std::ios_base::trunc | std::ios_base::binary);
+    if (!tempFile->good()) {
+        error.setIsClientError(true);
+        error.setMessage("open file failed");
+        res.setE(error);
+        res.setSuccess(false);
+        return res;
+    }
+    // 第一个分段写入临时文件，请求带有调用方的全部条件
+    GetObjectV2Input firstInput = getInput;
+    firstInput.setRangeStart(0);
+    firstInput.setRangeEnd(partSize - 1);
+    auto firstCrc = std::make_shared<uint64_t>(0);
+    auto firstRes = getObjectFromServer(firstInput, firstCrc, tempFile);
+    tempFile->close();
+    if (!firstRes.isSuccess()) {
+        remove(tempFilePath.c_str());
+        // 服务端没有按范围返回时（例如空对象返回 416 或 200）改为单个 GET
+        auto statusCode = firstRes.error().getStatusCode();
+        if (statusCode == 416 || statusCode == 200) {
+            fallback = true;
+            return res;
+        }
+        res.setE(firstRes.error());
+        res.setSuccess(false);
+        return res;
+    }
+    auto basicOutput = firstRes.result().getGetObjectBasicOutput();
+    int64_t received = basicOutput.getContentLength();
+    int64_t offset = 0, size = 0;
+    if (!objectRangeFromOutput(basicOutput, offset, size) || offset != 0 || received < 0 || received > size) {
+        remove(tempFilePath.c_str());
+        fallback = true;
+        return res;
+    }
+    // 输出与单个 GET 一致
+    basicOutput.setContentRange("");
+    basicOutput.setContentLength(size);
+    uint64_t crc64 = *firstCrc;
+    if (received < size && size < parallelGetThreshold_) {
+        // 未超过阈值时用一个 GET 读取剩余部分
+        tempFile = std::make_shared<std::fstream>(tempFilePath,
+                                                  std::ios_base::out | std::ios_base::in | std::ios_base::binary);
+        tempFile->seekp(received, std::ios_base::beg);
+        if (!tempFile->good()) {
+            remove(tempFilePath.c_str());
+            error.setIsClientError(true);
+            error.setMessage("open file failed");
+            res.setE(error);
+            res.setSuccess(false);
+            return res;
+        }
+        GetObjectV2Input restInput = getInput;
+        restInput.setRangeStart(received);
+        restInput.setRangeEnd(size - 1);
+        restInput.setIfMatch(basicOutput.getETags());
+        auto restCrc = std::make_shared<uint64_t>(0);
+        auto restRes = getObjectFromServer(restInput, restCrc, tempFile);
+        tempFile->close();
+        if (!restRes.isSuccess()) {
+            remove(tempFilePath.c_str());
+            // 对象在两次请求之间被覆盖，改为单个 GET 重新下载
+            if (parallelGetShouldFallback(restRes.error().getStatusCode())) {
+                fallback = true;
+                return res;
+            }
+            res.setE(restRes.error());
+            res.setSuccess(false);
+            return res;
+        }
+        crc64 = CRC64::CombineCRC(crc64, *restCrc, size - received);
+    } else if (received < size) {
+        // 其余分段并发下载，以第一个分段的 ETag 作为 If-Match，保证读取的是同一个版本
+        auto headOutput = headOutputFromGet(basicOutput);
+        download.setIfMatch(basicOutput.getETags());
+        auto event = std::make_shared<DownloadEvent>();
+        initDownloadEvent(download, dfi.result(), "", event);
+        auto cp = initCheckpoint(download, headOutput, dfi.result(), "");
+        if (!cp.isSuccess()) {
+            remove(tempFilePath.c_str());
+            res.setE(cp.error());
+            res.setSuccess(false);
+            return res;
+        }
+        auto checkpoint = cp.result();
+        auto firstPart = checkpoint.getPartsInfo()[0];
+        firstPart.setIsCompleted(true);
+        firstPart.setHashCrc64Ecma(crc64);
+        checkpoint.setDownloadFilePartInfoByIdx(firstPart, 0);
+        // 成功时临时文件已重命名为目标文件，CRC 也已校验
+        auto downloadRes = downloadPartConcurrent(download, headOutput, checkpoint, "", dfi.result(), event,
+                                                  PartSchedule());
+        if (!downloadRes.isSuccess()) {
+            remove(tempFilePath.c_str());
+            // 对象在期间被覆盖（412）或服务端没有按范围返回（416、200）时改为单个 GET 重新下载，其他错误直接返回
+            if (parallelGetShouldFallback(downloadRes.error().getStatusCode())) {
+                fallback = true;
+                return res;
+            }
+            res.setE(downloadRes.error());
+            res.setSuccess(false);
+            return res;
+        }
+        GetObjectToFileOutput output;
+        output.setGetObjectBasicOutput(basicOutput);
+        res.setSuccess(true);
+        res.setR(std::move(output));
+        return res;
+    }
+    // 对象小于一个分段时第一个 GET 已取得全部数据
+    if (config_.isEnableCrc() && basicOutput.getHashCrc64Ecma() != 0 && crc64 != basicOutput.getHashCrc64Ecma()) {
+        remove(tempFilePath.c_str());
+        error.setIsClientError(true);
+        error.setMessage("Check CRC failed: CRC checksum of client is mismatch with tos");
+        res.setE(error);
+        res.setSuccess(false);
+        return res;
+    }
+#ifdef _WIN32
+    remove(dfi.result().getFilePath().c_str());
+#endif
+    if (rename(tempFilePath.c_str(), dfi.result().getFilePath().c_str()) != 0) {
+        remove(tempFilePath.c_str());
+        error.setIsClientError(true);
+        error.setMessage("rename tempfile failed");
+        res.setE(error);
+        res.setSuccess(false);
+        return res;
+    }
+    GetObjectToFileOutput output;
+    output.setGetObjectBasicOutput(basicOutput);
+    res.setSuccess(true);
+    res.setR(std::move(output));
+    return res;
+}
+
+// readRanges 合并、拆分后的一个 GET 请求，targets 是裁剪到 [start, end] 内的部分
+struct ReadRangesChunk {
+    int64_t start = 0;
+    int64_t end = 0;
+    std::vector<ScatterTarget> targets;
+    // targets 对应的输入 range 下标
+    std::vector<size_t> index;
+    Outcome<TosError, GetObjectV2Output> outcome;
+};
+
+static bool readRangesShouldRetry(const TosError& error) {
+    auto statusCode = error.getStatusCode();
+    return statusCode <= 0 || statusCode == 429 || statusCode >= 500;
+}
+
+Outcome<TosError, ReadRangesOutput> TosClientImpl::readRanges(const ReadRangesInput& input) {
+    Outcome<TosError, ReadRangesOutput> res;
+    std::string check = isValidNames(input.getBucket(), {input.getKey()}, config_.isCustomDomain());
+    const auto& ranges = input.getRanges();
+    if (check.empty() && ranges.empty()) {
+        check = "empty read ranges";
+    }
+    for (const auto& range : ranges) {
+        if (check.empty() && (range.getOffset() < 0 || range.getLength() <= 0 || range.getBuffer() == nullptr)) {
+            check = "invalid read range";
+        }
+    }
+    if (!check.empty()) {
+        TosError error;
+        error.setIsClientError(true);
+        error.setMessage(check);
+        res.setE(error);
+        res.setSuccess(false);
+        return res;
+    }
+
+    // 按 offset 排序后合并间隔不超过 mergeGap 的范围（包括重叠的范围）
+    std::vector<size_t> order(ranges.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(),
+              [&](size_t a, size_t b) { return ranges[a].getOffset() < ranges[b].getOffset(); });
+    auto mergeGap = std::max<int64_t>(input.getMergeGap(), 0);
+    std::vector<std::pair<int64_t, int64_t>> spans;
+    for (auto i : order) {
+        auto start = ranges[i].getOffset();
+        auto end = start + ranges[i].getLength() - 1;
+        if (spans.empty() || start > spans.back().second + 1 + mergeGap) {
+            spans.emplace_back(start, end);
+        } else {
+            spans.back().second = std::max(spans.back().second, end);
+        }
+    }
+    // 过大的范围拆分为多个请求并发读取
+    auto maxRangeSize = input.getMaxRangeSize();
+    std::vector<ReadRangesChunk> chunks;
+    for (const auto& span : spans) {
+        auto pieceSize = maxRangeSize > 0 ? maxRangeSize : span.second - span.first + 1;
+        for (auto start = span.first; start <= span.second; start += pieceSize) {
+            ReadRangesChunk chunk;
+            chunk.start = start;
+            chunk.end = std::min(span.second, start + pieceSize - 1);
+            chunks.push_back(std::move(chunk));
+        }
+    }
+    for (auto& chunk : chunks) {
+        for (auto i : order) {
+            auto from = std::max(chunk.start, ranges[i].getOffset());
+            auto to = std::min(chunk.end, ranges[i].getOffset() + ranges[i].getLength() - 1);
+            if (from > to) {
+                continue;
+            }
+            ScatterTarget target;
+            target.offset = from;
+            target.length = to - from + 1;
+            target.buffer = ranges[i].getBuffer() + (from - ranges[i].getOffset());
+            chunk.targets.push_back(target);
+            chunk.index.push_back(i);
+        }
+    }
+
+    std::string ifMatch;
+    auto fetchChunk = [&](ReadRangesChunk& chunk) {
+        GetObjectV2Input getInput(input.getBucket(), input.getKey());
+        getInput.setVersionId(input.getVersionId());
+        getInput.setIfMatch(ifMatch);
+        getInput.setRange(HttpRange(chunk.start, chunk.end).toString());
+        // 失败时重试一次，重试前清空已写入的计数
+        for (int attempt = 0; attempt < 2; attempt++) {
+            std::vector<ScatterTarget*> targets;
+            for (auto& target : chunk.targets) {
+                target.written = 0;
+                targets.push_back(&target);
+            }
+            auto sink = std::make_shared<ScatterBodySink>(chunk.start, std::move(targets));
+            chunk.outcome = getObjectFromServer(getInput, nullptr, nullptr, sink);
+            if (chunk.outcome.isSuccess() || !readRangesShouldRetry(chunk.outcome.error())) {
+                break;
+            }
+        }
+        if (chunk.outcome.isSuccess()) {
+            chunk.outcome.result().setContent(nullptr);
+        }
+    };
+    // 先读第一个请求，之后的请求用它的 ETag 作为 If-Match，对象在读取过程中被修改时返回 412，不会写入新数据。
+    // 请求按 offset 升序，第一个请求失败（包括 416）时之后的请求也不会成功，直接返回它的错误。
+    fetchChunk(chunks.front());
+    if (!chunks.front().outcome.isSuccess()) {
+        res.setE(chunks.front().outcome.error());
+        res.setSuccess(false);
+        return res;
+    }
+    ifMatch = chunks.front().outcome.result().getGetObjectBasicOutput().getETags();
+    auto taskNum = std::min<size_t>(std::max(input.getTaskNum(), 1), chunks.size() - 1);
+    if (taskNum <= 1) {
+        for (size_t i = 1; i < chunks.size(); i++) {
+            fetchChunk(chunks[i]);
+        }
+    } else {
+        std::atomic<size_t> next(1);
+        std::vector<std::thread> threadPool;
+        for (size_t i = 0; i < taskNum; i++) {
+            threadPool.emplace_back([&]() {
+                size_t current;
+                while ((current = next++) < chunks.size()) {
+                    fetchChunk(chunks[current]);
+                }
+            });
+        }
+        for (auto& worker : threadPool) {
+            worker.join();
+        }
+    }
+
+    // 超出对象大小的请求返回 416，只有全部请求都 416 时才返回错误
+    ReadRangesOutput output;
+    std::vector<int64_t> readBytes(ranges.size(), 0);
+    const ReadRangesChunk* first = nullptr;
+    for (const auto& chunk : chunks) {
+        if (!chunk.outcome.isSuccess()) {
+            if (chunk.outcome.error().getStatusCode() == 416) {
+                continue;
+            }
+            res.setE(chunk.outcome.error());
+            res.setSuccess(false);
+            return res;
+        }
+        const auto& basicOutput = chunk.outcome.result().getGetObjectBasicOutput();
+        if (first == nullptr) {
+            first = &chunk;
+        } else if (basicOutput.getETags() != first->outcome.result().getGetObjectBasicOutput().getETags()) {
+            TosError error;
+            error.setIsClientError(true);
+            error.setMessage("object changed during readRanges, etag mismatch");
+            res.setE(error);
+            res.setSuccess(false);
+            return res;
+        }
+        for (size_t t = 0; t < chunk.targets.size(); t++) {
+            readBytes[chunk.index[t]] += chunk.targets[t].written;
+        }
+    }
+    if (first == nullptr) {
+        res.setE(chunks.front().outcome.error());
+        res.setSuccess(false);
+        return res;
+    }
+    const auto& basicOutput = first->outcome.result().getGetObjectBasicOutput();
+    output.setRequestInfo(basicOutput.getRequestInfo());
+    output.setETag(basicOutput.getETags());
+    output.setReadBytes(readBytes);
+    output.setRequestCount(static_cast<int>(chunks.size()));
+    res.setSuccess(true);
+    res.setR(std::move(output));
+    return res;
+}
+
+Outcome<TosError, DownloadToBufferOutput> TosClientImpl::downloadToBuffer(const DownloadToBufferInput& input) {
+    Outcome<TosError, DownloadToBufferOutput> res;
+    std::string check = isValidNames(input.getBucket(), {input.getKey()}, config_.isCustomDomain());
+    if (check.empty() && (input.getBufferSize() < 0 || (input.getBuffer() == nullptr && input.getBufferSize() > 0))) {
+        check = "invalid buffer";
+    }
+    if (check.empty() && input.getPartSize() <= 0) {
+        check = "invalid part size, the size must be positive";
+    }
+    if (!check.empty()) {
+        TosError error;
+        error.setIsClientError(true);
+        error.setMessage(check);
         res.setE(error);
         res.setSuccess(false);
         return res;
     }
-    // write to file
-    bool ret = FileUtils::CreateDir(input.getFilePath(), true);
-    if (!ret) {
-        // 错误处理，创建文件夹失败的场景
-        TosError error;
-        error.setMessage("invalid file path, mkdir failed");
-        error.setIsClientError(true);
-        res.setE(error);
+    HeadObjectV2Input headInput(input.getBucket(), input.getKey(), input.getVersionId());
+    // 不经过元数据缓存，缓存中的 ETag 可能已经过期，后面的范围请求会因 If-Match 返回 412
+    auto headRes = headObjectFromServer(headInput);
+    if (!headRes.isSuccess()) {
+        res.setE(headRes.error());
         res.setSuccess(false);
         return res;
     }
-    auto fileContent = std::make_shared<std::fstream>(
-            input.getFilePath(), std::ios_base::out | std::ios_base::in | std::ios_base::trunc | std::ios_base::binary);
-    if (!fileContent->good()) {
+    const auto& head = headRes.result();
+    auto size = head.getContentLength();
+    if (size > input.getBufferSize()) {
         TosError error;
         error.setIsClientError(true);
-        error.setMessage("open file failed");
+        error.setMessage("buffer is too small, the object size is " + std::to_string(size));
         res.setE(error);
         res.setSuccess(false);
         return res;
     }
 
-    const GetObjectV2Input& basic_input = input.getGetObjectInput();
-    auto res_ = this->getObject(basic_input, nullptr, fileContent);
-    if (!res_.isSuccess()) {
-        res.setE(res_.error());
+    // 每个范围请求的响应体直接写入 buffer 中对应的位置，同时计算该范围的 CRC64
+    struct BufferPart {
+        int64_t offset = 0;
+        int64_t length = 0;
+        int64_t written = 0;
+        uint64_t crc = 0;
+        bool fetched = false;
+        Outcome<TosError, GetObjectV2Output> outcome;
+    };
+    auto partSize = input.getPartSize();
+    std::vector<BufferPart> parts(static_cast<size_t>((size + partSize - 1) / partSize));
+    for (size_t i = 0; i < parts.size(); i++) {
+        parts[i].offset = static_cast<int64_t>(i) * partSize;
+        parts[i].length = std::min(partSize, size - parts[i].offset);
+    }
+    std::atomic<bool> failed(false);
+    auto fetchPart = [&](BufferPart& part) {
+        part.fetched = true;
+        GetObjectV2Input getInput(input.getBucket(), input.getKey());
+        getInput.setVersionId(input.getVersionId());
+        // 使用 HEAD 得到的 ETag 保证各个范围属于同一版本
+        getInput.setIfMatch(head.getETags());
+        getInput.setRange(HttpRange(part.offset, part.offset + part.length - 1).toString());
+        for (int attempt = 0; attempt < 2; attempt++) {
+            auto sink = std::make_shared<MemoryBodySink>(input.getBuffer() + part.offset, part.length);
+            auto hashCrc64ecma = std::make_shared<uint64_t>(0);
+            part.outcome = getObjectFromServer(getInput, hashCrc64ecma, nullptr, sink);
+            part.crc = *hashCrc64ecma;
+            part.written = sink->written();
+            if (part.outcome.isSuccess() || !readRangesShouldRetry(part.outcome.error())) {
+                break;
+            }
+        }
+        if (part.outcome.isSuccess()) {
+            part.outcome.result().setContent(nullptr);
+            if (part.written != part.length) {
+                TosError error;
+                error.setIsClientError(true);
+                error.setMessage("the object is truncated, expect " + std::to_string(part.length) +
+                                 " bytes but got " + std::to_string(part.written));
+                part.outcome.setE(error);
+                part.outcome.setSuccess(false);
+            }
+        }
+        if (!part.outcome.isSuccess()) {
+            failed = true;
+        }
+    };
+    auto taskNum = std::min<size_t>(std::max(input.getTaskNum(), 1), parts.size());
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        size_t current;
+        // 有范围失败后不再发出新的请求
+        while (!failed && (current = next++) < parts.size()) {
+            fetchPart(parts[current]);
+        }
+    };
+    if (taskNum <= 1) {
+        worker();
+    } else {
+        std::vector<std::thread> threadPool;
+        for (size_t i = 0; i < taskNum; i++) {
+            threadPool.emplace_back(worker);
+        }
+        for (auto& t : threadPool) {
+            t.join();
+        }
+    }
+    // 有范围失败时后面的范围可能没有下载，返回第一个失败的范围的错误
+    for (const auto& part : parts) {
+        if (part.fetched && !part.outcome.isSuccess()) {
+            res.setE(part.outcome.error());
+            res.setSuccess(false);
+            return res;
+        }
+    }
+    uint64_t crc = 0;
+    for (size_t i = 0; i < parts.size(); i++) {
+        crc = i == 0 ? parts[i].crc : CRC64::CombineCRC(crc, parts[i].crc, parts[i].length);
+    }
+    if (head.getHashCrc64Ecma() != 0 && crc != head.getHashCrc64Ecma()) {
+        TosError error;
+        error.setIsClientError(true);
+        error.setMessage("Check CRC failed: CRC checksum of client is mismatch with tos");
+        res.setE(error);
         res.setSuccess(false);
         return res;
     }
-    GetObjectToFileOutput output;
-    output.setGetObjectBasicOutput(res_.result().getGetObjectBasicOutput());
-
-    //    auto resContent = res_.result().getContent();
-    //    *content << resContent->rdbuf();
-    fileContent->close();
+    DownloadToBufferOutput output;
+    output.setRequestInfo(head.getRequestInfo());
+    output.setETag(head.getETags());
+    output.setVersionId(head.getVersionId());
+    output.setContentLength(size);
+    output.setHashCrc64ecma(crc);
+    output.setRequestCount(static_cast<int>(parts.size()));
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -862,6 +1821,31 @@ Outcome<TosError, HeadObjectV2Output> TosClientImpl::headObject(const HeadObject
         res.setSuccess(false);
         return res;
     }
+    // 条件请求和 SSE-C 请求不缓存也不合并
+    if ((objectMetaCache_ == nullptr && headFlight_ == nullptr) || !input.getIfMatch().empty() ||
+        !input.getIfNoneMatch().empty() || input.getIfModifiedSince() != 0 || input.getIfUnmodifiedSince() != 0 ||
+        !input.getSsecAlgorithm().empty()) {
+        return headObjectFromServer(input);
+    }
+    auto cacheKey = ObjectCache::CacheKey(input.getBucket(), input.getKey(), input.getVersionId());
+    if (objectMetaCache_ != nullptr && objectMetaCache_->get(cacheKey, res)) {
+        return res;
+    }
+    uint64_t epoch = objectMetaCache_ != nullptr ? objectMetaCache_->epoch() : 0;
+    if (headFlight_ != nullptr) {
+        auto flightKey = cacheKey + "\n" + std::to_string(objectWriteEpoch_.load());
+        res = headFlight_->run(flightKey, [&]() { return headObjectFromServer(input); });
+    } else {
+        res = headObjectFromServer(input);
+    }
+    if (objectMetaCache_ != nullptr) {
+        objectMetaCache_->put(cacheKey, res, epoch);
+    }
+    return res;
+}
+
+Outcome<TosError, HeadObjectV2Output> TosClientImpl::headObjectFromServer(const HeadObjectV2Input& input) {
+    Outcome<TosError, HeadObjectV2Output> res;
     auto rb = newBuilder(input.getBucket(), input.getKey());
     headObjectSetOptionHeader(rb, input);
     auto req = rb.Build(http::MethodHead, nullptr);
@@ -875,7 +1859,7 @@ Outcome<TosError, HeadObjectV2Output> TosClientImpl::headObject(const HeadObject
     output.fromResponse(*tosRes.result());
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -941,7 +1925,7 @@ Outcome<TosError, DeleteObjectOutput> TosClientImpl::deleteObject(const DeleteOb
     output.setDeleteMarker(tosRes.result()->findHeader(HEADER_DELETE_MARKER) == "true");
     output.setVersionId(tosRes.result()->findHeader(HEADER_VERSIONID));
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, DeleteMultiObjectsOutput> TosClientImpl::deleteMultiObjects(const std::string& bucket,
@@ -964,10 +1948,9 @@ Outcome<TosError, DeleteMultiObjectsOutput> TosClientImpl::deleteMultiObjects(co
         res.setSuccess(false);
         return res;
     }
-    std::string data = input.toJsonString();
-    std::string dataMd5 = CryptoUtils::md5Sum(data);
     auto rb = newBuilder(bucket, "");
-    this->deleteMultiObjects(rb, data, dataMd5, res);
+    this->deleteMultiObjects(rb, input, res);
+    invalidateObjectCache(bucket, input.getObjectTobeDeleteds());
     return res;
 }
 Outcome<TosError, DeleteMultiObjectsOutput> TosClientImpl::deleteMultiObjects(const std::string& bucket,
@@ -990,10 +1973,9 @@ Outcome<TosError, DeleteMultiObjectsOutput> TosClientImpl::deleteMultiObjects(co
         res.setSuccess(false);
         return res;
     }
-    std::string data = input.toJsonString();
-    std::string dataMd5 = CryptoUtils::md5Sum(data);
     auto rb = newBuilder(bucket, "", builder);
-    this->deleteMultiObjects(rb, data, dataMd5, res);
+    this->deleteMultiObjects(rb, input, res);
+    invalidateObjectCache(bucket, input.getObjectTobeDeleteds());
     return res;
 }
 Outcome<TosError, DeleteMultiObjectsOutput> TosClientImpl::deleteMultiObjects(DeleteMultiObjectsInput& input) {
@@ -1015,14 +1997,16 @@ Outcome<TosError, DeleteMultiObjectsOutput> TosClientImpl::deleteMultiObjects(De
         return res;
     }
 
-    std::string data = input.toJsonString();
-    std::string dataMd5 = CryptoUtils::md5Sum(data);
+    // 直接序列化到请求体缓冲区，同时计算 Content-MD5
+    JsonWriter writer(input.getObjectTobeDeleteds().size() * 64 + 32, true);
+    writeJson(writer, input);
     auto rb = newBuilder(input.getBucket(), "");
 
-    rb.withHeader(http::HEADER_CONTENT_MD5, dataMd5);
+    rb.withHeader(http::HEADER_CONTENT_MD5, writer.md5());
     rb.withQuery("delete", "");
-    auto req = rb.Build(http::MethodPost, std::make_shared<std::stringstream>(data));
+    auto req = rb.BuildWithBodySource(http::MethodPost, std::make_shared<MemoryBodySource>(writer.release()));
     auto tosRes = roundTrip(req, 200);
+    invalidateObjectCache(input.getBucket(), input.getObjectTobeDeleteds());
     if (!tosRes.isSuccess()) {
         res.setE(tosRes.error());
         res.setSuccess(false);
@@ -1034,7 +2018,7 @@ Outcome<TosError, DeleteMultiObjectsOutput> TosClientImpl::deleteMultiObjects(De
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     output.fromJsonString(out.str());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, PutObjectOutput> TosClientImpl::putObject(const std::string& bucket, const std::string& objectKey,
@@ -1143,7 +2127,10 @@ Outcome<TosError, PutObjectV2Output> TosClientImpl::putObject(const PutObjectV2I
     }
 
     putObjectSetOptionHeader(rb, putObjectBasicInput_);
-    auto req = rb.Build(http::MethodPut, input.getContent());
+    // 指定了长度时不再探测，只能顺序读取的流需要指定长度
+    rb.setContentLength(putObjectBasicInput_.getContentLength());
+    auto req = input.getBodySource() != nullptr ? rb.BuildWithBodySource(http::MethodPut, input.getBodySource())
+                                                : rb.Build(http::MethodPut, input.getContent());
     // 设置回调
     auto handler = putObjectBasicInput_.getDataTransferListener();
     auto limiter = putObjectBasicInput_.getRateLimiter();
@@ -1152,7 +2139,9 @@ Outcome<TosError, PutObjectV2Output> TosClientImpl::putObject(const PutObjectV2I
     SetCrc64ParmToReq(req);
     // 设置funcName
     req->setFuncName(__func__);
-    req->setContentOffset(req->getContent()->tellg());
+    if (req->getContent() != nullptr) {
+        req->setContentOffset(req->getContent()->tellg());
+    }
     auto tosRes = roundTrip(req, 200);
     if (!tosRes.isSuccess()) {
         res.setE(tosRes.error());
@@ -1194,7 +2183,7 @@ Outcome<TosError, PutObjectV2Output> TosClientImpl::putObject(const PutObjectV2I
         }
     }
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 std::string isValidFilePath(const std::string& filePath) {
@@ -1208,7 +2197,8 @@ std::string isValidFilePath(const std::string& filePath) {
     }
     return "invalid file path, the file does not exist";
 }
-Outcome<TosError, PutObjectFromFileOutput> TosClientImpl::putObjectFromFile(const PutObjectFromFileInput& input) {
+Outcome<TosError, PutObjectFromFileOutput> TosClientImpl::putObjectFromFile(const PutObjectFromFileInput& input,
+                                                                            bool autoParallel) {
     Outcome<TosError, PutObjectFromFileOutput> res;
     std::string check = isValidFilePath(input.getFilePath());
     if (!check.empty()) {
@@ -1219,8 +2209,9 @@ Outcome<TosError, PutObjectFromFileOutput> TosClientImpl::putObjectFromFile(cons
         res.setSuccess(false);
         return res;
     }
-    auto content = std::make_shared<std::fstream>(input.getFilePath(), std::ios::in | std::ios_base::binary);
-    if (!content->good()) {
+    // 按偏移 pread 读取文件，重试时无需 seek
+    auto source = std::make_shared<FileBodySource>(input.getFilePath());
+    if (!source->good()) {
         TosError error;
         error.setIsClientError(true);
         error.setMessage("open file failed");
@@ -1228,8 +2219,16 @@ Outcome<TosError, PutObjectFromFileOutput> TosClientImpl::putObjectFromFile(cons
         res.setSuccess(false);
         return res;
     }
-    content->seekg(0, content->beg);
-    PutObjectV2Input input_(input.getPutObjectBasicInput(), content);
+    // 分片上传无法校验整个对象的 Content-MD5/SHA256，也不支持上传回调，这些请求仍使用单个 PUT
+    const auto& basicInput = input.getPutObjectBasicInput();
+    if (autoParallel && multipartThreshold_ > 0 && source->size() >= multipartThreshold_ &&
+        basicInput.getContentMd5().empty() && basicInput.getContentSha256().empty() &&
+        basicInput.getCallBack().empty() &&
+        (basicInput.getContentLength() <= 0 || basicInput.getContentLength() == source->size())) {
+        return putObjectFromFileParallel(input, source->size());
+    }
+    PutObjectV2Input input_(basicInput, nullptr);
+    input_.setBodySource(source);
     auto res_ = this->putObject(input_);
     if (!res_.isSuccess()) {
         res.setE(res_.error());
@@ -1239,7 +2238,70 @@ Outcome<TosError, PutObjectFromFileOutput> TosClientImpl::putObjectFromFile(cons
     PutObjectFromFileOutput output_file;
     output_file.setPutObjectV2Output(res_.result());
     res.setSuccess(true);
-    res.setR(output_file);
+    res.setR(std::move(output_file));
+    return res;
+}
+
+Outcome<TosError, PutObjectFromFileOutput> TosClientImpl::putObjectFromFileParallel(const PutObjectFromFileInput& input,
+                                                                                    int64_t fileSize) {
+    Outcome<TosError, PutObjectFromFileOutput> res;
+    const auto& basicInput = input.getPutObjectBasicInput();
+    UploadFileV2Input upload(basicInput.getBucket(), basicInput.getKey());
+    upload.setFilePath(input.getFilePath());
+    upload.setCacheControl(basicInput.getCacheControl());
+    upload.setContentDisposition(basicInput.getContentDisposition());
+    upload.setContentEncoding(basicInput.getContentEncoding());
+    upload.setContentLanguage(basicInput.getContentLanguage());
+    upload.setContentType(basicInput.getContentType());
+    upload.setExpires(basicInput.getExpires());
+    upload.setAcl(basicInput.getAcl());
+    upload.setGrantFullControl(basicInput.getGrantFullControl());
+    upload.setGrantRead(basicInput.getGrantRead());
+    upload.setGrantReadAcp(basicInput.getGrantReadAcp());
+    upload.setGrantWriteAcp(basicInput.getGrantWriteAcp());
+    upload.setSsecAlgorithm(basicInput.getSsecAlgorithm());
+    upload.setSsecKey(basicInput.getSsecKey());
+    upload.setSsecKeyMd5(basicInput.getSsecKeyMd5());
+    upload.setServerSideEncryption(basicInput.getServerSideEncryption());
+    upload.setMeta(basicInput.getMeta());
+    upload.setWebsiteRedirectLocation(basicInput.getWebsiteRedirectLocation());
+    upload.setStorageClass(basicInput.getStorageClass());
+    // 分片数不超过 10000
+    upload.setPartSize(std::max({parallelPartSize_, int64_t(5 * 1024 * 1024), (fileSize + 9999) / 10000}));
+    upload.setTaskNum(parallelTaskNum_);
+    upload.setDataTransferListener(basicInput.getDataTransferListener());
+    upload.setRateLimiter(basicInput.getRateLimiter());
+    upload.setTrafficLimit(basicInput.getTrafficLimit());
+    // 记录 uploadId，上传失败时取消分片上传，不留下未完成的分片
+    auto uploadId = std::make_shared<std::string>();
+    UploadEventListener listener;
+    listener.eventChange_ = [uploadId](std::shared_ptr<UploadEvent> event) {
+        if (event->type_ == UploadEventCreateMultipartUploadSucceed && event->uploadId_ != nullptr) {
+            *uploadId = *event->uploadId_;
+        }
+    };
+    upload.setUploadEventListener(listener);
+    auto uploadRes = uploadFile(upload);
+    if (!uploadRes.isSuccess()) {
+        if (!uploadId->empty()) {
+            abortMultipartUpload(AbortMultipartUploadInput(basicInput.getBucket(), basicInput.getKey(), *uploadId));
+        }
+        res.setE(uploadRes.error());
+        res.setSuccess(false);
+        return res;
+    }
+    const auto& uploadOutput = uploadRes.result();
+    PutObjectV2Output output;
+    output.setRequestInfo(uploadOutput.getRequestInfo());
+    output.setETag(uploadOutput.getETag());
+    output.setVersionId(uploadOutput.getVersionId());
+    output.setSsecAlgorithm(uploadOutput.getSsecAlgorithm());
+    output.setSsecKeyMd5(uploadOutput.getSsecKeyMd5());
+    output.setHashCrc64ecma(uploadOutput.getHashCrc64Ecma());
+    PutObjectFromFileOutput outputFile;
+    outputFile.setPutObjectV2Output(output);
+    res.setSuccess(true);
+    res.setR(std::move(outputFile));
     return res;
 }
 
@@ -1404,14 +2466,15 @@ Outcome<TosError, std::vector<UploadFilePartInfo>> getPartInfoFromFile(int64_t u
         UploadFilePartInfo info;
         info.setPartNum(i + 1);
         info.setOffset(i * partSize);
-        if (i < partNum - 1) {
+        // 文件大小恰好是 partSize 的整数倍时，最后一个分片也是 partSize
+        if (i < partNum - 1 || lastPartSize == 0) {
             info.setPartSize(partSize);
         } else {
             info.setPartSize(lastPartSize);
         }
         partInfoList.emplace_back(info);
     }
-    ret.setR(partInfoList);
+    ret.setR(std::move(partInfoList));
     ret.setSuccess(true);
     return ret;
 }
@@ -1434,7 +2497,8 @@ Outcome<TosError, std::vector<UploadFilePartInfoV2>> getPartInfoFromFileV2(int64
         UploadFilePartInfoV2 info;
         info.setPartNum(i + 1);
         info.setOffset(i * partSize);
-        if (i < partNum - 1) {
+        // 文件大小恰好是 partSize 的整数倍时，最后一个分片也是 partSize
+        if (i < partNum - 1 || lastPartSize == 0) {
             info.setPartSize(partSize);
         } else {
             info.setPartSize(lastPartSize);
@@ -1449,7 +2513,7 @@ Outcome<TosError, std::vector<UploadFilePartInfoV2>> getPartInfoFromFileV2(int64
         info.setPartSize(0);
         partInfoList.emplace_back(info);
     }
-    ret.setR(partInfoList);
+    ret.setR(std::move(partInfoList));
     ret.setSuccess(true);
     return ret;
 }
@@ -1482,7 +2546,7 @@ Outcome<TosError, UploadFileCheckpoint> TosClientImpl::initCheckpoint(const std:
     }
     checkpoint.setUploadId(output.result().getUploadId());
     ret.setSuccess(true);
-    ret.setR(checkpoint);
+    ret.setR(std::move(checkpoint));
     return ret;
 }
 
@@ -1599,7 +2663,7 @@ Outcome<TosError, UploadFileCheckpointV2> TosClientImpl::initCheckpoint(
     checkpoint.setUploadId(output.result().getUploadId());
 
     ret.setSuccess(true);
-    ret.setR(checkpoint);
+    ret.setR(std::move(checkpoint));
 
     return ret;
 }
@@ -1621,7 +2685,7 @@ Outcome<TosError, UploadFileCheckpoint> TosClientImpl::getCheckpoint(const std::
         deleteCheckpointFile(checkpointFilePath);
         return this->initCheckpoint(bucket, input, fileInfo, checkpointFilePath, builder);
     }
-    ret.setR(checkpoint);
+    ret.setR(std::move(checkpoint));
     ret.setSuccess(true);
     return ret;
 }
@@ -1731,7 +2795,7 @@ Outcome<TosError, UploadFileOutput> TosClientImpl::uploadPartConcurrent(const Up
     ufo.setObjectKey(checkpoint.getKey());
     ufo.setOutput(output.result());
     ret.setSuccess(true);
-    ret.setR(ufo);
+    ret.setR(std::move(ufo));
     return ret;
 }
 Outcome<TosError, UploadFileOutput> TosClientImpl::uploadFile(const std::string& bucket, const UploadFileInput& input,
@@ -1788,11 +2852,32 @@ Outcome<TosError, UploadFileCheckpointV2> TosClientImpl::getCheckpoint(const Upl
         deleteCheckpointFile(checkpointFilePath);
     }
     bool valid = checkpoint.isValid(fileInfo.getFileSize(), fileInfo.getLastModified(), bucket, key);
+    // 大小和修改时间不变时文件内容仍可能变化，并发计算本地已上传分片的 CRC64 进行校验，未完成的分片不读取
+    std::vector<uint64_t> partCRCs;
+    if (valid && config_.isEnableCrc() && checkpoint.hasCompletedParts()) {
+        std::vector<bool> completed;
+        for (const auto& part : checkpoint.getPartsInfo()) {
+            auto idx = static_cast<size_t>(part.getPartNum() - 1);
+            if (part.isCompleted() && part.getPartNum() > 0) {
+                completed.resize(std::max(completed.size(), idx + 1), false);
+                completed[idx] = true;
+            }
+        }
+        valid = CRC64::CalcFilePartCRC(input.getFilePath(), checkpoint.getPartSize(), input.getTaskNum(), completed,
+                                       partCRCs);
+    }
     if (!valid) {
         deleteCheckpointFile(checkpointFilePath);
         return this->initCheckpoint(bucket, key, input, fileInfo, checkpointFilePath, event);
     }
-    ret.setR(checkpoint);
+    if (!partCRCs.empty() && checkpoint.resetMismatchedParts(partCRCs) > 0) {
+        auto logger = LogUtils::GetLogger(LogCategoryTransfer, LogInfo);
+        if (logger != nullptr) {
+            logger->info("uploaded parts are changed locally and will be uploaded again, key: {}", key);
+        }
+        checkpoint.dump(checkpointFilePath);
+    }
+    ret.setR(std::move(checkpoint));
     ret.setSuccess(true);
     return ret;
 }
@@ -1800,10 +2885,11 @@ Outcome<TosError, UploadFileCheckpointV2> TosClientImpl::getCheckpoint(const Upl
 Outcome<TosError, UploadFileV2Output> TosClientImpl::uploadPartConcurrent(const UploadFileV2Input& input,
                                                                           UploadFileCheckpointV2 checkpoint,
                                                                           const std::string& checkpointFilePath,
-                                                                          std::shared_ptr<UploadEvent> event) {
+                                                                          std::shared_ptr<UploadEvent> event,
+                                                                          const PartSchedule& schedule) {
     Outcome<TosError, UploadFileV2Output> ret;
     TosError error;
-    std::vector<UploadFilePartInfoV2> toUpload = checkpoint.getPartsInfo();
+    PartRetryQueue<UploadFilePartInfoV2> toUpload(checkpoint.getPartsInfo(), partRetryOptions_);
     std::vector<std::thread> threadPool;
     std::mutex lock_;
     int64_t partSize_ = input.getPartSize();
@@ -1811,7 +2897,7 @@ Outcome<TosError, UploadFileV2Output> TosClientImpl::uploadPartConcurrent(const
     auto cancel = input.getCancelHook();
     std::atomic<bool> isAbort(false);
     std::atomic<bool> isSuccess(true);
-    auto logger = LogUtils::GetLogger();
+    auto logger = LogUtils::GetLogger(LogCategoryTransfer, LogInfo);
 
     // 进度条相关参数
     UploadDownloadFileProcessStat processStat;
@@ -1825,7 +2911,7 @@ Outcome<TosError, UploadFileV2Output> TosClientImpl::uploadPartConcurrent(const
         pProcessStat->totalBytes_ = checkpoint.getFileInfo().getFileSize();
         // 回归进度条
         if (input.isEnableCheckpoint()) {
-            for (auto& part : toUpload) {
+            for (auto& part : checkpoint.getPartsInfo()) {
                 if (part.isCompleted()) {
                     pProcessStat->consumedBytes_ += part.getPartSize();
                 }
@@ -1833,6 +2919,18 @@ Outcome<TosError, UploadFileV2Output> TosClientImpl::uploadPartConcurrent(const
         }
         pProcessStat->userData = (void*)pProcessStat;
     }
+    std::shared_ptr<StragglerDetector> detector;
+    if (enableStragglerDetection_) {
+        // 同一分片的重复请求会互相覆盖，上传只重启落后的分片请求
+        auto options = stragglerOptions_;
+        options.duplicateTail = false;
+        DataTransferListener listener = {nullptr, nullptr};
+        if (process.dataTransferStatusChange_ != nullptr) {
+            listener = {UploadDownloadFileProcessCallback, (void*)pProcessStat};
+        }
+        detector = std::make_shared<StragglerDetector>(options, listener);
+    }
+    auto stopped = [&]() { return isAbort || (cancel != nullptr && cancel->isCancel()); };
     for (int i = 0; i < input.getTaskNum(); i++) {
         auto res = std::thread([&]() {
             while (true) {
@@ -1846,15 +2944,15 @@ Outcome<TosError, UploadFileV2Output> TosClientImpl::uploadPartConcurrent(const
                 if (isAbort) {
                     break;
                 }
-                // 任务队列中取part
-                UploadFilePartInfoV2 part;
-                {
-                    std::lock_guard<std::mutex> lck(lock_);
-                    if (toUpload.empty())
-                        break;
-                    part = toUpload.front();
-                    toUpload.erase(toUpload.begin());
+                // 任务队列中取part，重新排队的分片等待退避结束后再上传
+                PartRetryQueue<UploadFilePartInfoV2>::Entry entry;
+                if (!toUpload.pop(entry)) {
+                    break;
+                }
+                if (!toUpload.Wait(entry, stopped)) {
+                    break;
                 }
+                UploadFilePartInfoV2 part = entry.part;
 
                 if (part.isCompleted()) {
                     continue;
@@ -1873,13 +2971,27 @@ Outcome<TosError, UploadFileV2Output> TosClientImpl::uploadPartConcurrent(const
                 upiBasic.setTrafficLimit(input.getTrafficLimit());
                 // 设置限流
                 upiBasic.setRateLimiter(input.getRateLimiter());
-                // 设置回调
-                if (process.dataTransferStatusChange_ != nullptr) {
+                // 设置回调，开启落后检测时进度经 detector 汇总
+                std::shared_ptr<StragglerAttempt> attempt;
+                if (detector != nullptr) {
+                    attempt = detector->begin(part.getPartNum(), part.getPartSize());
+                    upiBasic.setDataTransferListener(attempt->listener);
+                } else if (process.dataTransferStatusChange_ != nullptr) {
                     upiBasic.setDataTransferListener({UploadDownloadFileProcessCallback, (void*)pProcessStat});
                 }
                 upi.setUploadPartBasicInput(upiBasic);
                 auto partHashCrc64ecma = std::make_shared<uint64_t>(0);
-                auto res = this->uploadPartFromFile(upi, partHashCrc64ecma);
+                PartRequestOptions partOptions;
+                partOptions.monitor = attempt != nullptr ? attempt->monitor : nullptr;
+                partOptions.freshConnection = toUpload.freshConnection(entry);
+                // 由 TransferManager 调度时先获取全局名额
+                if (schedule.scheduler != nullptr && !schedule.scheduler->acquire(schedule.priority, stopped)) {
+                    break;
+                }
+                auto res = this->uploadPartFromFile(upi, partHashCrc64ecma, partOptions);
+                if (schedule.scheduler != nullptr) {
+                    schedule.scheduler->release();
+                }
 
                 // 下载后检查是否需要中断任务
                 if (cancel != nullptr) {
@@ -1887,6 +2999,17 @@ Outcome<TosError, UploadFileV2Output> TosClientImpl::uploadPartConcurrent(const
                         break;
                     }
                 }
+                if (attempt != nullptr) {
+                    auto result = detector->finish(attempt, res.isSuccess());
+                    if (result == StragglerDetector::PartRestart) {
+                        // 落后的分片放回队列头部，尽快在新连接上重传
+                        toUpload.pushFront(entry);
+                        continue;
+                    }
+                    if (result == StragglerDetector::PartSuperseded) {
+                        continue;
+                    }
+                }
 
                 if (res.isSuccess()) {
                     // 更新 checkpoint 信息, 把更新后的part放到队列中
@@ -1928,6 +3051,13 @@ Outcome<TosError, UploadFileV2Output> TosClientImpl::uploadPartConcurrent(const
                         isAbort = true;
                         break;
                     }
+                    // 可恢复的错误在退避后重传，用尽重试次数后才报告失败
+                    if (toUpload.retry(entry, statusCode)) {
+                        if (logger != nullptr) {
+                            logger->info("retry part {} later, status code {}", part.getPartNum(), statusCode);
+                        }
+                        continue;
+                    }
                     // 事件通知
                     UploadPartInfo partInfo{};
                     partInfo.partNumber_ = part.getPartNum();
@@ -2049,10 +3179,11 @@ Outcome<TosError, UploadFileV2Output> TosClientImpl::uploadPartConcurrent(const
     ufo.setSsecKeyMd5(checkpoint.getSseKeyMd5());
     ufo.setEncodingType(checkpoint.getEncodingType());
     ret.setSuccess(true);
-    ret.setR(ufo);
+    ret.setR(std::move(ufo));
     return ret;
 }
-Outcome<TosError, UploadFileV2Output> TosClientImpl::uploadFile(const UploadFileV2Input& input) {
+Outcome<TosError, UploadFileV2Output> TosClientImpl::uploadFile(const UploadFileV2Input& input,
+                                                                const PartSchedule& schedule) {
     Outcome<TosError, UploadFileV2Output> res;
     TosError error;
     const auto& createMultipartInput = input.getCreateMultipartUploadInput();
@@ -2095,7 +3226,93 @@ Outcome<TosError, UploadFileV2Output> TosClientImpl::uploadFile(const UploadFile
         res.setSuccess(false);
         return res;
     }
-    return uploadPartConcurrent(input, cp.result(), checkpointFilePath, event);
+    return uploadPartConcurrent(input, cp.result(), checkpointFilePath, event, schedule);
+}
+
+Outcome<TosError, UploadDirectoryOutput> TosClientImpl::uploadDirectory(const UploadDirectoryInput& input) {
+    Outcome<TosError, UploadDirectoryOutput> res;
+    std::string check = isValidBucketName(input.getBucket(), config_.isCustomDomain());
+    if (check.empty() && input.getDirectory().empty()) {
+        check = "invalid directory, the directory is empty";
+    }
+    if (check.empty() && (input.getPartSize() < 5 * 1024 * 1024 || input.getPartSize() > 5LL * 1024 * 1024 * 1024)) {
+        check = "invalid part size, the size must be [5242880, 5368709120]";
+    }
+    if (!check.empty()) {
+        TosError error;
+        error.setIsClientError(true);
+        error.setMessage(check);
+        res.setE(error);
+        res.setSuccess(false);
+        return res;
+    }
+    return uploadDirectoryConcurrent(input);
+}
+
+Outcome<TosError, DownloadPrefixOutput> TosClientImpl::downloadPrefix(const DownloadPrefixInput& input) {
+    Outcome<TosError, DownloadPrefixOutput> res;
+    std::string check = isValidBucketName(input.getBucket(), config_.isCustomDomain());
+    if (check.empty() && input.getDirectory().empty()) {
+        check = "invalid directory, the directory is empty";
+    }
+    if (check.empty() && input.getParallelThreshold() > 0 &&
+        (input.getPartSize() < 5 * 1024 * 1024 || input.getPartSize() > 5LL * 1024 * 1024 * 1024)) {
+        check = "invalid part size, the size must be [5242880, 5368709120]";
+    }
+    if (!check.empty()) {
+        TosError error;
+        error.setIsClientError(true);
+        error.setMessage(check);
+        res.setE(error);
+        res.setSuccess(false);
+        return res;
+    }
+    return downloadObjectsConcurrent(input, nullptr);
+}
+
+Outcome<TosError, SyncDirectoryOutput> TosClientImpl::syncDirectory(const SyncDirectoryInput& input) {
+    Outcome<TosError, SyncDirectoryOutput> res;
+    std::string check = isValidBucketName(input.getBucket(), config_.isCustomDomain());
+    if (check.empty() && input.getDirectory().empty()) {
+        check = "invalid directory, the directory is empty";
+    }
+    if (check.empty() && (input.getPartSize() < 5 * 1024 * 1024 || input.getPartSize() > 5LL * 1024 * 1024 * 1024)) {
+        check = "invalid part size, the size must be [5242880, 5368709120]";
+    }
+    if (!check.empty()) {
+        TosError error;
+        error.setIsClientError(true);
+        error.setMessage(check);
+        res.setE(error);
+        res.setSuccess(false);
+        return res;
+    }
+    return syncDirectoryConcurrent(input);
+}
+
+Outcome<TosError, CopyPrefixOutput> TosClientImpl::copyPrefix(const CopyPrefixInput& input) {
+    Outcome<TosError, CopyPrefixOutput> res;
+    std::string check = isValidBucketName(input.getSrcBucket(), config_.isCustomDomain());
+    if (check.empty()) {
+        check = isValidBucketName(input.getBucket(), config_.isCustomDomain());
+    }
+    if (check.empty() && (input.getPartSize() < 5 * 1024 * 1024 || input.getPartSize() > 5LL * 1024 * 1024 * 1024)) {
+        check = "invalid part size, the size must be [5242880, 5368709120]";
+    }
+    // 目标前缀在源前缀之下时，复制出的对象会被再次列举到
+    if (check.empty() && input.getKeyMapper() == nullptr && input.getSrcBucket() == input.getBucket() &&
+        input.getPrefix().compare(0, input.getSrcPrefix().size(), input.getSrcPrefix()) == 0) {
+        check = "invalid prefix, the destination prefix overlaps the source prefix";
+    }
+    if (!check.empty()) {
+        TosError error;
+        error.setIsClientError(true);
+        error.setMessage(check);
+        res.setE(error);
+        res.setSuccess(false);
+        return res;
+    }
+    return copyPrefixConcurrent(input);
 }
 
 void initDownloadEvent(const DownloadFileInput& input, const DownloadFileFileInfo& dfi,
@@ -2201,7 +3418,7 @@ Outcome<TosError, std::vector<DownloadFilePartInfo>> getDownloadFilePartsInfo(in
     if (lastPartSize != 0) {
         partInfoList[partNum - 1].setRangeEnd((partNum - 1) * partSize + lastPartSize - 1);
     }
-    ret.setR(partInfoList);
+    ret.setR(std::move(partInfoList));
     ret.setSuccess(true);
     return ret;
 }
@@ -2242,7 +3459,7 @@ Outcome<TosError, DownloadFileCheckpoint> TosClientImpl::initCheckpoint(const Do
     checkpoint.setPartsInfo(partsInfo.result());
 
     ret.setSuccess(true);
-    ret.setR(checkpoint);
+    ret.setR(std::move(checkpoint));
     return ret;
 }
 
@@ -2299,6 +3516,10 @@ Outcome<TosError, DownloadFileCheckpoint> TosClientImpl::getCheckpoint(const Dow
     }
     const auto& headInput = input.getHeadObjectV2Input();
     bool valid = checkpoint.isValid(headInput, headOutput);
+    // 临时文件在两次下载之间被删除时，已完成分片的数据也不存在了，重新下载全部分片
+    if (valid && !std::ifstream(fileInfo.getTempFilePath(), std::ios_base::in | std::ios_base::binary)) {
+        valid = false;
+    }
     // 清理临时文件
     if (!input.isEnableCheckpoint() || !valid) {
         const std::string& tempFilePath = fileInfo.getTempFilePath();
@@ -2316,7 +3537,7 @@ Outcome<TosError, DownloadFileCheckpoint> TosClientImpl::getCheckpoint(const Dow
         deleteCheckpointFile(checkpointFilePath);
         return this->initCheckpoint(input, headOutput, fileInfo, checkpointFilePath);
     }
-    ret.setR(checkpoint);
+    ret.setR(std::move(checkpoint));
     ret.setSuccess(true);
     return ret;
 }
@@ -2366,7 +3587,7 @@ Outcome<TosError, DownloadFileFileInfo> getDownloadFileFileInfo(const DownloadFi
             ret_tempFilePath << ret_filePath.str() << ".temp";
             fileinfo.setFilePath(ret_filePath.str());
             fileinfo.setTempFilePath(ret_tempFilePath.str());
-            ret.setR(fileinfo);
+            ret.setR(std::move(fileinfo));
             ret.setSuccess(true);
             return ret;
         }
@@ -2387,7 +3608,7 @@ Outcome<TosError, DownloadFileFileInfo> getDownloadFileFileInfo(const DownloadFi
             // key 最后是分隔符，认为是文件夹语义
             if (key.back() == TOS_PATH_DELIMITER) {
                 fileinfo.setKeyEndWithDelimiter(true);
-                ret.setR(fileinfo);
+                ret.setR(std::move(fileinfo));
                 ret.setSuccess(true);
                 return ret;
             }
@@ -2419,10 +3640,12 @@ Outcome<TosError, DownloadFileFileInfo> getDownloadFileFileInfo(const DownloadFi
 
 Outcome<TosError, DownloadFileOutput> TosClientImpl::downloadPartConcurrent(
         const DownloadFileInput& input, const HeadObjectV2Output& headOutput, DownloadFileCheckpoint checkpoint,
-        const std::string& checkpointPath, const DownloadFileFileInfo& dfi, std::shared_ptr<DownloadEvent> event) {
+        const std::string& checkpointPath, const DownloadFileFileInfo& dfi, std::shared_ptr<DownloadEvent> event,
+        const PartSchedule& schedule) {
     Outcome<TosError, DownloadFileOutput> ret;
     TosError error;
-    std::vector<DownloadFilePartInfo> toDownload = checkpoint.getPartsInfo();
+    const std::vector<DownloadFilePartInfo> allParts = checkpoint.getPartsInfo();
+    PartRetryQueue<DownloadFilePartInfo> toDownload(allParts, partRetryOptions_);
     std::vector<std::thread> threadPool;
     std::mutex lock_;
     int64_t partSize_ = input.getPartSize();
@@ -2431,7 +3654,9 @@ Outcome<TosError, DownloadFileOutput> TosClientImpl::downloadPartConcurrent(
     std::string tempFilePath = dfi.getTempFilePath();
     std::atomic<bool> isAbort(false);
     std::atomic<bool> isSuccess(true);
-    auto logger = LogUtils::GetLogger();
+    // 导致任务失败的分片状态码，返回给调用方判断失败原因
+    std::atomic<int> failedStatusCode(0);
+    auto logger = LogUtils::GetLogger(LogCategoryTransfer, LogInfo);
     // 进度条相关参数
     UploadDownloadFileProcessStat processStat;
     auto pProcessStat = &processStat;
@@ -2441,16 +3666,23 @@ Outcome<TosError, DownloadFileOutput> TosClientImpl::downloadPartConcurrent(
         pProcessStat->dataTransferListener_.dataTransferStatusChange_ = process.dataTransferStatusChange_;
         pProcessStat->dataTransferListener_.userData_ = process.userData_;
         pProcessStat->totalBytes_ = headOutput.getContentLength();
-        // 回归进度条
-        if (input.isEnableCheckpoint()) {
-            for (auto& part : toDownload) {
-                if (part.isCompleted()) {
-                    pProcessStat->consumedBytes_ += part.getRangeEnd() - part.getRangeStart() + 1;
-                }
+        // 回归进度条，已完成的分片来自 checkpoint 或 getObjectToFile 的第一个 GET
+        for (auto& part : allParts) {
+            if (part.isCompleted()) {
+                pProcessStat->consumedBytes_ += part.getRangeEnd() - part.getRangeStart() + 1;
             }
         }
         pProcessStat->userData = (void*)pProcessStat;
     }
+    std::shared_ptr<StragglerDetector> detector;
+    if (enableStragglerDetection_) {
+        DataTransferListener listener = {nullptr, nullptr};
+        if (process.dataTransferStatusChange_ != nullptr) {
+            listener = {UploadDownloadFileProcessCallback, (void*)pProcessStat};
+        }
+        detector = std::make_shared<StragglerDetector>(stragglerOptions_, listener);
+    }
+    auto stopped = [&]() { return isAbort || (cancel != nullptr && cancel->isCancel()); };
     for (int i = 0; i < input.getTaskNum(); i++) {
         auto res = std::thread([&]() {
             while (true) {
@@ -2464,18 +3696,40 @@ Outcome<TosError, DownloadFileOutput> TosClientImpl::downloadPartConcurrent(
                 if (isAbort) {
                     break;
                 }
-                // 任务队列中取part
-                DownloadFilePartInfo part;
-                {
-                    std::lock_guard<std::mutex> lck(lock_);
-                    if (toDownload.empty())
+                // 任务队列中取part，重新排队的分片等待退避结束后再下载
+                PartRetryQueue<DownloadFilePartInfo>::Entry entry;
+                std::shared_ptr<StragglerAttempt> attempt;
+                bool idle = false;
+                if (toDownload.pop(entry)) {
+                    if (!toDownload.Wait(entry, stopped)) {
                         break;
-                    part = toDownload.front();
-                    toDownload.erase(toDownload.begin());
+                    }
+                } else if (detector == nullptr) {
+                    break;
+                } else {
+                    idle = true;
+                }
+                DownloadFilePartInfo part = entry.part;
+                if (idle) {
+                    // 队列为空后为落后的分片发起重复请求，没有进行中的分片时退出
+                    attempt = detector->beginDuplicate();
+                    if (attempt == nullptr) {
+                        if (!detector->busy()) {
+                            break;
+                        }
+                        std::this_thread::sleep_for(
+                                std::chrono::milliseconds(std::max(stragglerOptions_.checkIntervalMillis, 50)));
+                        continue;
+                    }
+                    part = allParts[attempt->partNumber - 1];
+                    entry.part = part;
                 }
                 if (part.isCompleted()) {
                     continue;
                 }
+                if (detector != nullptr && attempt == nullptr) {
+                    attempt = detector->begin(part.getPartNum(), part.getRangeEnd() - part.getRangeStart() + 1);
+                }
                 // 发送 GetObject 请求数据
                 GetObjectV2Input input_obj_get;
                 input_obj_get.setBucket(input.getHeadObjectV2Input().getBucket());
@@ -2495,12 +3749,24 @@ Outcome<TosError, DownloadFileOutput> TosClientImpl::downloadPartConcurrent(
 
                 // 设置限流
                 input_obj_get.setRateLimiter(input.getRateLimiter());
-                // 设置回调
-                if (process.dataTransferStatusChange_ != nullptr) {
+                // 设置回调，开启落后检测时进度经 detector 汇总
+                if (attempt != nullptr) {
+                    input_obj_get.setDataTransferListener(attempt->listener);
+                } else if (process.dataTransferStatusChange_ != nullptr) {
                     input_obj_get.setDataTransferListener({UploadDownloadFileProcessCallback, (void*)pProcessStat});
                 }
                 auto partHashCrc64ecma = std::make_shared<uint64_t>(0);
-                auto res = this->getObject(input_obj_get, partHashCrc64ecma, nullptr);
+                PartRequestOptions partOptions;
+                partOptions.monitor = attempt != nullptr ? attempt->monitor : nullptr;
+                partOptions.freshConnection = toDownload.freshConnection(entry);
+                // 由 TransferManager 调度时先获取全局名额
+                if (schedule.scheduler != nullptr && !schedule.scheduler->acquire(schedule.priority, stopped)) {
+                    break;
+                }
+                auto res = this->getObject(input_obj_get, partHashCrc64ecma, nullptr, partOptions);
+                if (schedule.scheduler != nullptr) {
+                    schedule.scheduler->release();
+                }
 
                 // 下载后检查是否需要中断任务
                 if (cancel != nullptr) {
@@ -2508,12 +3774,26 @@ Outcome<TosError, DownloadFileOutput> TosClientImpl::downloadPartConcurrent(
                         break;
                     }
                 }
+                if (attempt != nullptr) {
+                    auto result = detector->finish(attempt, res.isSuccess());
+                    if (result == StragglerDetector::PartRestart) {
+                        // 落后的分片放回队列头部，尽快在新连接上重新下载
+                        toDownload.pushFront(entry);
+                        continue;
+                    }
+                    if (result == StragglerDetector::PartSuperseded) {
+                        continue;
+                    }
+                }
                 if (res.isSuccess()) {
                     // 成功则写入数据到文件
+                    bool written = false;
                     {
                         std::lock_guard<std::mutex> lck(lock_);
                         std::fstream tempFile;
-                        tempFile.open(tempFilePath, std::ios_base::out | std::ios_base::app | std::ios_base::in | std::ios_base::binary);
+                        // 不能以 app 模式打开，否则 seekp 无效，先完成的分片总是写到文件末尾。
+                        // 临时文件由 getCheckpoint 创建，不存在时打开失败，该分片不记为完成
+                        tempFile.open(tempFilePath, std::ios_base::out | std::ios_base::in | std::ios_base::binary);
                         if (tempFile) {
                             auto currentPos = partSize_ * (part.getPartNum() - 1);
                             tempFile.seekp(currentPos, tempFile.beg);
@@ -2530,6 +3810,7 @@ Outcome<TosError, DownloadFileOutput> TosClientImpl::downloadPartConcurrent(
                                 // 下载段成功
                                 DownloadPartInfo partInfo{part.getPartNum(), part.getRangeStart(), part.getRangeEnd()};
                                 downloadEventDownloadPartSucceed(event, eventChange, partInfo);
+                                written = true;
                             }
                             tempFile.close();
                         } else {
@@ -2539,6 +3820,9 @@ Outcome<TosError, DownloadFileOutput> TosClientImpl::downloadPartConcurrent(
                             isSuccess = false;
                         }
                     }
+                    if (!written) {
+                        continue;
+                    }
                     // 更新 checkpoint 信息, 把更新后的 part 放到 checkpoint 的 vector 中，赋值并发安全
                     part.setIsCompleted(true);
                     part.setHashCrc64Ecma(*partHashCrc64ecma);
@@ -2558,12 +3842,21 @@ Outcome<TosError, DownloadFileOutput> TosClientImpl::downloadPartConcurrent(
                         DownloadPartInfo partInfo{part.getPartNum(), part.getRangeStart(), part.getRangeEnd()};
                         downloadEventDownloadPartAborted(event, eventChange, partInfo);
                         // 出现 403、404、405 错误需要中断整个断点续传任务
+                        failedStatusCode = statusCode;
                         isAbort = true;
                         break;
                     }
+                    // 可恢复的错误在退避后重传，用尽重试次数后才报告失败
+                    if (toDownload.retry(entry, statusCode)) {
+                        if (logger != nullptr) {
+                            logger->info("retry part {} later, status code {}", part.getPartNum(), statusCode);
+                        }
+                        continue;
+                    }
                     std::lock_guard<std::mutex> lck(lock_);
                     DownloadPartInfo partInfo{part.getPartNum(), part.getRangeStart(), part.getRangeEnd()};
                     downloadEventDownloadPartFailed(event, eventChange, partInfo);
+                    failedStatusCode = statusCode;
                     isSuccess = false;
                 }
             }
@@ -2582,6 +3875,7 @@ Outcome<TosError, DownloadFileOutput> TosClientImpl::downloadPartConcurrent(
         remove(dfi.getTempFilePath().c_str());
         error.setMessage("the task is canceled");
         error.setIsClientError(true);
+        error.setStatusCode(failedStatusCode);
         ret.setE(error);
         ret.setSuccess(false);
         return ret;
@@ -2610,6 +3904,7 @@ Outcome<TosError, DownloadFileOutput> TosClientImpl::downloadPartConcurrent(
     if (!isSuccess) {
         error.setMessage("some parts are downloaded incorrectly, you can try again");
         error.setIsClientError(true);
+        error.setStatusCode(failedStatusCode);
         ret.setE(error);
         ret.setSuccess(false);
         return ret;
@@ -2658,12 +3953,13 @@ Outcome<TosError, DownloadFileOutput> TosClientImpl::downloadPartConcurrent(
     }
     DownloadFileOutput downloadFileOutput;
     downloadFileOutput.setHeadObjectV2Output(headOutput);
-    ret.setR(downloadFileOutput);
+    ret.setR(std::move(downloadFileOutput));
     ret.setSuccess(true);
     return ret;
 }
 
-Outcome<TosError, DownloadFileOutput> TosClientImpl::downloadFile(const DownloadFileInput& input) {
+Outcome<TosError, DownloadFileOutput> TosClientImpl::downloadFile(const DownloadFileInput& input,
+                                                                  const PartSchedule& schedule) {
     Outcome<TosError, DownloadFileOutput> res;
     TosError error;
     const auto& headInput = input.getHeadObjectV2Input();
@@ -2684,6 +3980,14 @@ Outcome<TosError, DownloadFileOutput> TosClientImpl::downloadFile(const Download
         res.setSuccess(false);
         return res;
     }
+    return downloadFileFromHead(input, checkObjectExists.result(), schedule);
+}
+
+Outcome<TosError, DownloadFileOutput> TosClientImpl::downloadFileFromHead(const DownloadFileInput& input,
+                                                                          const HeadObjectV2Output& headOutput,
+                                                                          const PartSchedule& schedule) {
+    Outcome<TosError, DownloadFileOutput> res;
+    TosError error;
     auto dfi = getDownloadFileFileInfo(input);
     if (!dfi.isSuccess()) {
         error.setIsClientError(true);
@@ -2695,8 +3999,8 @@ Outcome<TosError, DownloadFileOutput> TosClientImpl::downloadFile(const Download
     // 当 key 末尾为分隔符，直接返回的场景
     if (dfi.result().isKeyEndWithDelimiter()) {
         DownloadFileOutput downloadFileOutput;
-        downloadFileOutput.setHeadObjectV2Output(checkObjectExists.result());
-        res.setR(downloadFileOutput);
+        downloadFileOutput.setHeadObjectV2Output(headOutput);
+        res.setR(std::move(downloadFileOutput));
         res.setSuccess(true);
         return res;
     }
@@ -2716,7 +4020,7 @@ Outcome<TosError, DownloadFileOutput> TosClientImpl::downloadFile(const Download
     auto event = std::make_shared<DownloadEvent>();
     initDownloadEvent(input, dfi.result(), checkpointFilePath, event);
     // 检查 checkpoint 文件是否存在 + 检查 checkpoint 文件有效性 + 无效则创建临时文件
-    auto cp = getCheckpoint(input, checkpointFilePath, dfi.result(), checkObjectExists.result(), event);
+    auto cp = getCheckpoint(input, checkpointFilePath, dfi.result(), headOutput, event);
     if (!cp.isSuccess()) {
         error.setMessage(cp.error().getMessage());
         error.setIsClientError(true);
@@ -2724,8 +4028,8 @@ Outcome<TosError, DownloadFileOutput> TosClientImpl::downloadFile(const Download
         res.setSuccess(false);
         return res;
     }
-    return downloadPartConcurrent(input, checkObjectExists.result(), cp.result(), checkpointFilePath, dfi.result(),
-                                  event);
+    return downloadPartConcurrent(input, headOutput, cp.result(), checkpointFilePath, dfi.result(),
+                                  event, schedule);
 }
 
 Outcome<TosError, AppendObjectOutput> TosClientImpl::appendObject(const std::string& bucket,
@@ -2860,7 +4164,7 @@ Outcome<TosError, AppendObjectV2Output> TosClientImpl::appendObject(const Append
     }
     output.setHashCrc64ecma(hashCrc64);
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, SetObjectMetaOutput> TosClientImpl::setObjectMeta(const std::string& bucket,
@@ -2922,7 +4226,7 @@ Outcome<TosError, SetObjectMetaOutput> TosClientImpl::setObjectMeta(const SetObj
     SetObjectMetaOutput output;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -2961,7 +4265,7 @@ Outcome<TosError, ListObjectsOutput> TosClientImpl::listObjects(const std::strin
     output.fromJsonString(ss.str());
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, ListObjectsV2Output> TosClientImpl::listObjects(const ListObjectsV2Input& input) {
@@ -2999,7 +4303,7 @@ Outcome<TosError, ListObjectsV2Output> TosClientImpl::listObjects(const ListObje
     output.fromJsonString(ss.str());
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -3038,7 +4342,7 @@ Outcome<TosError, ListObjectVersionsOutput> TosClientImpl::listObjectVersions(co
     output.fromJsonString(ss.str());
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, ListObjectVersionsV2Output> TosClientImpl::listObjectVersions(
@@ -3077,7 +4381,7 @@ Outcome<TosError, ListObjectVersionsV2Output> TosClientImpl::listObjectVersions(
     output.fromJsonString(ss.str());
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, CopyObjectOutput> TosClientImpl::copyObject(const std::string& bucket,
@@ -3224,7 +4528,7 @@ Outcome<TosError, CopyObjectV2Output> TosClientImpl::copyObject(const CopyObject
     output.setCopySourceVersionId(tosRes.result()->findHeader(HEADER_COPY_SOURCE_VERSION_ID));
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -3412,7 +4716,8 @@ static void uploadPartCopySetOptionHeader(RequestBuilder& rb, const UploadPartCo
     setSSECHeader(input.getSsecAlgorithm(), input.getSsecKey(), input.getSsecKeyMd5(), rb);
     rb.withHeader(HEADER_SSE, input.getServerSideEncryption());
 }
-Outcome<TosError, UploadPartCopyV2Output> TosClientImpl::uploadPartCopy(const UploadPartCopyV2Input& input) {
+Outcome<TosError, UploadPartCopyV2Output> TosClientImpl::uploadPartCopy(const UploadPartCopyV2Input& input,
+                                                                       const PartRequestOptions& partOptions) {
     Outcome<TosError, UploadPartCopyV2Output> res;
     std::vector<std::string> keys = {input.getKey(), input.getSrcKey()};
     std::vector<std::string> bkts = {input.getBucket(), input.getSrcBucket()};
@@ -3474,6 +4779,7 @@ Outcome<TosError, UploadPartCopyV2Output> TosClientImpl::uploadPartCopy(const Up
     uploadPartCopySetOptionHeader(rb, input);
     auto req = rb.BuildWithCopySource(http::MethodPut, input.getSrcBucket(), input.getSrcKey());
     SetCrc64ParmToReq(req);
+    req->setFreshConnection(partOptions.freshConnection);
     auto tosRes = roundTrip(req, 200);
     if (!tosRes.isSuccess()) {
         res.setE(tosRes.error());
@@ -3503,7 +4809,7 @@ Outcome<TosError, UploadPartCopyV2Output> TosClientImpl::uploadPartCopy(const Up
     // PartNumber从input传入
     output.setPartNumber(input.getPartNumber());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -3553,7 +4859,7 @@ Outcome<TosError, PutObjectAclOutput> TosClientImpl::putObjectAcl(const std::str
     PutObjectAclOutput output;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -3601,7 +4907,7 @@ Outcome<TosError, PutObjectAclV2Output> TosClientImpl::putObjectAcl(const PutObj
     PutObjectAclV2Output output;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, GetObjectAclOutput> TosClientImpl::getObjectAcl(const std::string& bucket,
@@ -3665,7 +4971,7 @@ Outcome<TosError, GetObjectAclV2Output> TosClientImpl::getObjectAcl(const GetObj
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     output.setVersionId(tosRes.result()->findHeader(HEADER_VERSIONID));
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -3779,7 +5085,7 @@ Outcome<TosError, CreateMultipartUploadOutput> TosClientImpl::createMultipartUpl
     output.setSsecAlgorithm(tosRes.result()->findHeader(HEADER_SSE_CUSTOMER_ALGORITHM));
     output.setSsecMd5(tosRes.result()->findHeader(HEADER_SSE_CUSTOMER_KEY_MD5));
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, UploadPartOutput> TosClientImpl::uploadPart(const std::string& bucket, const UploadPartInput& input) {
@@ -3846,7 +5152,8 @@ Outcome<TosError, UploadPartOutput> TosClientImpl::uploadPart(const std::string&
     return res;
 }
 Outcome<TosError, UploadPartV2Output> TosClientImpl::uploadPart(const UploadPartV2Input& input,
-                                                                std::shared_ptr<uint64_t> hashCrc64ecma) {
+                                                                std::shared_ptr<uint64_t> hashCrc64ecma,
+                                                                const PartRequestOptions& partOptions) {
     Outcome<TosError, UploadPartV2Output> res;
     const UploadPartBasicInput& uploadPartBasicInput_ = input.getUploadPartBasicInput();
     std::string check =
@@ -3885,7 +5192,7 @@ Outcome<TosError, UploadPartV2Output> TosClientImpl::uploadPart(const UploadPart
         res.setSuccess(false);
         return res;
     }
-    if (input.getContent() == nullptr) {
+    if (input.getContent() == nullptr && input.getBodySource() == nullptr) {
         TosError error;
         error.setIsClientError(true);
         error.setMessage("empty content");
@@ -3905,7 +5212,8 @@ Outcome<TosError, UploadPartV2Output> TosClientImpl::uploadPart(const UploadPart
         rb.withHeader(HEADER_TRAFFIC_LIMIT, std::to_string(input.getTrafficLimit()));
     }
 
-    auto req = rb.Build(http::MethodPut, input.getContent());
+    auto req = input.getBodySource() != nullptr ? rb.BuildWithBodySource(http::MethodPut, input.getBodySource())
+                                                : rb.Build(http::MethodPut, input.getContent());
     // 设置funcName
     req->setFuncName(__func__);
     // 进度条回调设置
@@ -3914,13 +5222,17 @@ Outcome<TosError, UploadPartV2Output> TosClientImpl::uploadPart(const UploadPart
     // 客户端限速
     auto limiter = uploadPartBasicInput_.getRateLimiter();
     SetRateLimiterToReq(req, limiter);
+    req->setTransferMonitor(partOptions.monitor);
+    req->setFreshConnection(partOptions.freshConnection);
     // crc64校验
     SetCrc64ParmToReq(req);
     if (hashCrc64ecma != nullptr) {
         req->setCheckCrc64(true);
     }
     // 针对 uploadFromFile 场景，content 存在 offset
-    req->setContentOffset(req->getContent()->tellg());
+    if (req->getContent() != nullptr) {
+        req->setContentOffset(req->getContent()->tellg());
+    }
     auto tosRes = roundTrip(req, 200);
     if (!tosRes.isSuccess()) {
         res.setE(tosRes.error());
@@ -3959,11 +5271,12 @@ Outcome<TosError, UploadPartV2Output> TosClientImpl::uploadPart(const UploadPart
     }
     output.setHashCrc64ecma(hashCrc64);
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, UploadPartFromFileOutput> TosClientImpl::uploadPartFromFile(const UploadPartFromFileInput& input,
-                                                                              std::shared_ptr<uint64_t> hashCrc64ecma) {
+                                                                              std::shared_ptr<uint64_t> hashCrc64ecma,
+                                                                              const PartRequestOptions& partOptions) {
     Outcome<TosError, UploadPartFromFileOutput> res;
     auto check = isValidFilePath(input.getFilePath());
     if (!check.empty()) {
@@ -3974,8 +5287,8 @@ Outcome<TosError, UploadPartFromFileOutput> TosClientImpl::uploadPartFromFile(co
         res.setSuccess(false);
         return res;
     }
-    auto content = std::make_shared<std::fstream>(input.getFilePath(), std::ios::in | std::ios_base::binary);
-    if (!content->good()) {
+    auto source = std::make_shared<FileBodySource>(input.getFilePath(), input.getOffset(), input.getPartSize());
+    if (!source->good()) {
         TosError error;
         error.setIsClientError(true);
         error.setMessage("open file failed");
@@ -3983,9 +5296,9 @@ Outcome<TosError, UploadPartFromFileOutput> TosClientImpl::uploadPartFromFile(co
         res.setSuccess(false);
         return res;
     }
-    content->seekg(input.getOffset(), content->beg);
-    UploadPartV2Input input_(input.getUploadPartBasicInput(), content, input.getPartSize());
-    auto res_ = this->uploadPart(input_, hashCrc64ecma);
+    UploadPartV2Input input_(input.getUploadPartBasicInput(), nullptr, input.getPartSize());
+    input_.setBodySource(source);
+    auto res_ = this->uploadPart(input_, hashCrc64ecma, partOptions);
     if (!res_.isSuccess()) {
         res.setE(res_.error());
         res.setSuccess(false);
@@ -3994,7 +5307,7 @@ Outcome<TosError, UploadPartFromFileOutput> TosClientImpl::uploadPartFromFile(co
     UploadPartFromFileOutput output_file;
     output_file.setUploadPartV2Output(res_.result());
     res.setSuccess(true);
-    res.setR(output_file);
+    res.setR(std::move(output_file));
     return res;
 }
 Outcome<TosError, CompleteMultipartUploadOutput> TosClientImpl::completeMultipartUpload(
@@ -4035,10 +5348,11 @@ Outcome<TosError, CompleteMultipartUploadOutput> TosClientImpl::completeMultipar
         multipart.setPartsByIdx(part, i);
     }
     multipart.sort();
-    auto content = std::make_shared<std::stringstream>(multipart.toJsonString());
+    JsonWriter writer(partsNum * 64 + 16);
+    writeJson(writer, multipart);
     auto rb = newBuilder(bucket, input.getKey());
     rb.withQuery("uploadId", input.getUploadId());
-    auto req = rb.Build(http::MethodPost, content);
+    auto req = rb.BuildWithBodySource(http::MethodPost, std::make_shared<MemoryBodySource>(writer.release()));
     auto tosRes = roundTrip(req, 200);
     if (!tosRes.isSuccess()) {
         res.setE(tosRes.error());
@@ -4050,7 +5364,7 @@ Outcome<TosError, CompleteMultipartUploadOutput> TosClientImpl::completeMultipar
     output.setVersionId(tosRes.result()->findHeader(HEADER_VERSIONID));
     output.setCrc64(tosRes.result()->findHeader(HEADER_CRC64));
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, CompleteMultipartUploadOutput> TosClientImpl::completeMultipartUpload(
@@ -4064,10 +5378,11 @@ Outcome<TosError, CompleteMultipartUploadOutput> TosClientImpl::completeMultipar
         multipart.setPartsByIdx(part, i);
     }
     multipart.sort();
-    auto content = std::make_shared<std::stringstream>(multipart.toJsonString());
+    JsonWriter writer(partsNum * 64 + 16);
+    writeJson(writer, multipart);
     auto rb = newBuilder(bucket, input.getKey());
     rb.withQuery("uploadId", input.getUploadId());
-    auto req = rb.Build(http::MethodPost, content);
+    auto req = rb.BuildWithBodySource(http::MethodPost, std::make_shared<MemoryBodySource>(writer.release()));
     auto tosRes = roundTrip(req, 200);
     if (!tosRes.isSuccess()) {
         res.setE(tosRes.error());
@@ -4078,7 +5393,7 @@ Outcome<TosError, CompleteMultipartUploadOutput> TosClientImpl::completeMultipar
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     output.setVersionId(tosRes.result()->findHeader(HEADER_VERSIONID));
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, CompleteMultipartUploadV2Output> TosClientImpl::completeMultipartUpload(
@@ -4103,7 +5418,7 @@ Outcome<TosError, CompleteMultipartUploadV2Output> TosClientImpl::completeMultip
         return res;
     }
 
-    std::shared_ptr<std::stringstream> ss = nullptr;
+    std::shared_ptr<BodySource> body = nullptr;
     if (input.isCompleteAll()) {
         if (!input.getParts().empty()) {
             TosError error;
@@ -4122,10 +5437,10 @@ Outcome<TosError, CompleteMultipartUploadV2Output> TosClientImpl::completeMultip
             res.setSuccess(false);
             return res;
         }
-        std::string jsonParts(input.toJsonString());
-        if (jsonParts != "null") {
-            ss = std::make_shared<std::stringstream>(jsonParts);
-        }
+        // 10000 个分片时约 600KB，直接序列化到请求体缓冲区
+        JsonWriter writer(input.getParts().size() * 64 + 16);
+        writeJson(writer, input);
+        body = std::make_shared<MemoryBodySource>(writer.release());
     }
 
     auto rb = newBuilder(input.getBucket(), input.getKey());
@@ -4139,7 +5454,7 @@ Outcome<TosError, CompleteMultipartUploadV2Output> TosClientImpl::completeMultip
     if (!input.getCallBackVar().empty()) {
         rb.withHeader(HEADER_CALLBACK_VAR, input.getCallBackVar());
     }
-    auto req = rb.Build(http::MethodPost, ss);
+    auto req = rb.BuildWithBodySource(http::MethodPost, body);
 
     // 设置funcName
     req->setFuncName(__func__);
@@ -4169,7 +5484,7 @@ Outcome<TosError, CompleteMultipartUploadV2Output> TosClientImpl::completeMultip
         output.setLocation(tosRes.result()->findHeader(http::HEADER_LOCATION));
     }
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, AbortMultipartUploadOutput> TosClientImpl::abortMultipartUpload(
@@ -4204,7 +5519,7 @@ Outcome<TosError, AbortMultipartUploadOutput> TosClientImpl::abortMultipartUploa
     AbortMultipartUploadOutput output;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, AbortMultipartUploadOutput> TosClientImpl::abortMultipartUpload(
@@ -4241,7 +5556,7 @@ Outcome<TosError, AbortMultipartUploadOutput> TosClientImpl::abortMultipartUploa
     AbortMultipartUploadOutput output;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, ListUploadedPartsOutput> TosClientImpl::listUploadedParts(const std::string& bucket,
@@ -4320,7 +5635,7 @@ Outcome<TosError, ListPartsOutput> TosClientImpl::listParts(const ListPartsInput
     output.fromJsonString(ss.str());
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -4350,7 +5665,7 @@ Outcome<TosError, ListMultipartUploadsOutput> TosClientImpl::listMultipartUpload
     output.fromJsonString(ss.str());
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 static void listMultipartUploadsSetOptionHeader(RequestBuilder& rb, const ListMultipartUploadsV2Input& input) {
@@ -4383,7 +5698,7 @@ Outcome<TosError, ListMultipartUploadsV2Output> TosClientImpl::listMultipartUplo
     output.fromJsonString(ss.str());
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -4470,7 +5785,7 @@ Outcome<TosError, PreSignedURLOutput> TosClientImpl::preSignedURL(const PreSigne
     PreSignedURLOutput output;
     output.setSignUrl(url);
     output.setSignHeader(input.getHeader());
-    res.setR(output);
+    res.setR(std::move(output));
     res.setSuccess(true);
     return res;
 }
@@ -4515,7 +5830,7 @@ Outcome<TosError, PutBucketCORSOutput> TosClientImpl::putBucketCORS(const PutBuc
     PutBucketCORSOutput output;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -4545,7 +5860,7 @@ Outcome<TosError, GetBucketCORSOutput> TosClientImpl::getBucketCORS(const GetBuc
     output.fromJsonString(ss.str());
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, DeleteBucketCORSOutput> TosClientImpl::deleteBucketCORS(const DeleteBucketCORSInput& input) {
@@ -4572,7 +5887,7 @@ Outcome<TosError, DeleteBucketCORSOutput> TosClientImpl::deleteBucketCORS(const
     std::stringstream ss;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -4612,63 +5927,8 @@ Outcome<TosError, ListObjectsType2Output> TosClientImpl::listObjectsType2(const
     output.fromJsonString(ss.str());
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
-    // 如果是一次列举，就直接返回
-    // 或者一次就列举完成了，到不了 maxkey 的情况
-    // 或者携带 delimiter 列举 CommonPrefix 的情况
-    // 检查默认值
-    if (input.isListOnlyOnce() || !output.isTruncated()) {
-        res.setSuccess(true);
-        res.setR(output);
-        return res;
-    } else {
-        // 第一次请求获取的结果
-        bool isTruncated = output.isTruncated();
-        int number =
-                static_cast<int>(output.getContents().size()) + static_cast<int>(output.getCommonPrefixes().size());
-        int newMaxKey = input.getMaxKeys() - number;
-        auto content = output.getContents();
-        auto commonPrefixes = output.getCommonPrefixes();
-        rb.withQueryCheckEmpty("max-keys", std::to_string(newMaxKey));
-        rb.withQueryCheckEmpty("continuation-token", output.getNextContinuationToken());
-        while (isTruncated && newMaxKey > 0) {
-            auto req = rb.Build(http::MethodGet, nullptr);
-            auto tosRes = roundTrip(req, 200);
-            if (!tosRes.isSuccess()) {
-                res.setE(tosRes.error());
-                res.setSuccess(false);
-                return res;
-            }
-            ListObjectsType2Output outputTemp;
-            std::stringstream ss;
-            ss << tosRes.result()->getContent()->rdbuf();
-            outputTemp.fromJsonString(ss.str());
-            number = static_cast<int>(outputTemp.getContents().size()) +
-                     static_cast<int>(outputTemp.getCommonPrefixes().size());
-            newMaxKey -= number;
-            isTruncated = outputTemp.isTruncated();
-            rb.withQueryCheckEmpty("max-keys", std::to_string(newMaxKey));
-            rb.withQueryCheckEmpty("continuation-token", outputTemp.getNextContinuationToken());
-            // 重新计算结果
-            output.setKeyCount(outputTemp.getKeyCount());
-            output.setIsTruncated(outputTemp.isTruncated());
-            output.setNextContinuationToken(outputTemp.getNextContinuationToken());
-            // append 到当前两个 vector 的后面
-            auto tempContent = outputTemp.getContents();
-            content.insert(content.end(), tempContent.begin(), tempContent.end());
-            auto tempCommonPrefixes = outputTemp.getCommonPrefixes();
-            commonPrefixes.insert(commonPrefixes.end(), tempCommonPrefixes.begin(), tempCommonPrefixes.end());
-        }
-        output.setContents(content);
-        // 排序并筛选
-        sort(commonPrefixes.begin(), commonPrefixes.end());
-        commonPrefixes.erase(unique(commonPrefixes.begin(), commonPrefixes.end()), commonPrefixes.end());
-        output.setCommonPrefixes(commonPrefixes);
-        res.setSuccess(true);
-        res.setR(output);
-        return res;
-    }
 }
 
 Outcome<TosError, PutBucketStorageClassOutput> TosClientImpl::putBucketStorageClass(
@@ -4697,7 +5957,7 @@ Outcome<TosError, PutBucketStorageClassOutput> TosClientImpl::putBucketStorageCl
     PutBucketStorageClassOutput output;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 // todo: boe4 该接口有问题
@@ -4727,7 +5987,7 @@ Outcome<TosError, GetBucketLocationOutput> TosClientImpl::getBucketLocation(cons
     output.fromJsonString(ss.str());
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -4771,7 +6031,7 @@ Outcome<TosError, PutBucketLifecycleOutput> TosClientImpl::putBucketLifecycle(co
     PutBucketLifecycleOutput output;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -4801,7 +6061,7 @@ Outcome<TosError, GetBucketLifecycleOutput> TosClientImpl::getBucketLifecycle(co
     output.fromJsonString(ss.str());
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, DeleteBucketLifecycleOutput> TosClientImpl::deleteBucketLifecycle(
@@ -4829,7 +6089,7 @@ Outcome<TosError, DeleteBucketLifecycleOutput> TosClientImpl::deleteBucketLifecy
     std::stringstream ss;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -4865,7 +6125,7 @@ Outcome<TosError, PutBucketPolicyOutput> TosClientImpl::putBucketPolicy(const Pu
     PutBucketPolicyOutput output;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -4896,7 +6156,7 @@ Outcome<TosError, GetBucketPolicyOutput> TosClientImpl::getBucketPolicy(const Ge
     ss << tosRes.result()->getContent()->rdbuf();
     output.setPolicy(ss.str());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, DeleteBucketPolicyOutput> TosClientImpl::deleteBucketPolicy(const DeleteBucketPolicyInput& input) {
@@ -4923,7 +6183,7 @@ Outcome<TosError, DeleteBucketPolicyOutput> TosClientImpl::deleteBucketPolicy(co
     DeleteBucketPolicyOutput output;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -4967,7 +6227,7 @@ Outcome<TosError, PutBucketMirrorBackOutput> TosClientImpl::putBucketMirrorBack(
     PutBucketMirrorBackOutput output;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -4997,7 +6257,7 @@ Outcome<TosError, GetBucketMirrorBackOutput> TosClientImpl::getBucketMirrorBack(
     output.fromJsonString(ss.str());
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, DeleteBucketMirrorBackOutput> TosClientImpl::deleteBucketMirrorBack(
@@ -5025,7 +6285,7 @@ Outcome<TosError, DeleteBucketMirrorBackOutput> TosClientImpl::deleteBucketMirro
     std::stringstream ss;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -5070,7 +6330,7 @@ Outcome<TosError, PutObjectTaggingOutput> TosClientImpl::putObjectTagging(const
     PutObjectTaggingOutput output;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -5101,7 +6361,7 @@ Outcome<TosError, GetObjectTaggingOutput> TosClientImpl::getObjectTagging(const
     output.fromJsonString(ss.str());
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, DeleteObjectTaggingOutput> TosClientImpl::deleteObjectTagging(const DeleteObjectTaggingInput& input) {
@@ -5129,7 +6389,7 @@ Outcome<TosError, DeleteObjectTaggingOutput> TosClientImpl::deleteObjectTagging(
     std::stringstream ss;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -5182,7 +6442,7 @@ Outcome<TosError, PutBucketAclOutput> TosClientImpl::putBucketAcl(const PutBucke
     PutBucketAclOutput output;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -5212,7 +6472,7 @@ Outcome<TosError, GetBucketAclOutput> TosClientImpl::getBucketAcl(const GetBucke
     output.fromJsonString(ss.str());
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -5282,7 +6542,7 @@ Outcome<TosError, FetchObjectOutput> TosClientImpl::fetchObject(const FetchObjec
     output.fromJsonString(ssRes.str());
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -5351,7 +6611,7 @@ Outcome<TosError, PutFetchTaskOutput> TosClientImpl::putFetchTask(const PutFetch
     output.fromJsonString(ssRes.str());
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, PreSignedPostSignatureOutput> TosClientImpl::preSignedPostSignature(
@@ -5433,7 +6693,7 @@ Outcome<TosError, PreSignedPostSignatureOutput> TosClientImpl::preSignedPostSign
     std::string signture = SignV4::signingKey(SignKeyInfo(date_, region_, cred_), jsonCondition_);
     PreSignedPostSignatureOutput output(jsonCondition, jsonCondition_, "TOS4-HMAC-SHA256", credential, date, signture);
 
-    res.setR(output);
+    res.setR(std::move(output));
     res.setSuccess(true);
     return res;
 }
@@ -5471,7 +6731,7 @@ Outcome<TosError, std::vector<ResumableCopyPartInfo>> getResumableCopyPartInfoFr
         info.setCopySourceRangeEnd(0);
         partInfoList.emplace_back(info);
     }
-    ret.setR(partInfoList);
+    ret.setR(std::move(partInfoList));
     ret.setSuccess(true);
     return ret;
 }
@@ -5626,7 +6886,7 @@ Outcome<TosError, ResumableCopyCheckpoint> TosClientImpl::initCheckpoint(const R
     checkpoint.setUploadId(output.result().getUploadId());
 
     ret.setSuccess(true);
-    ret.setR(checkpoint);
+    ret.setR(std::move(checkpoint));
 
     return ret;
 }
@@ -5652,17 +6912,17 @@ Outcome<TosError, ResumableCopyCheckpoint> TosClientImpl::getCheckpoint(const Re
         deleteCheckpointFile(checkpointFilePath);
         return this->initCheckpoint(input, headInput, headOutput, event);
     }
-    ret.setR(checkpoint);
+    ret.setR(std::move(checkpoint));
     ret.setSuccess(true);
     return ret;
 }
 
 Outcome<TosError, ResumableCopyObjectOutput> TosClientImpl::resumableCopyConcurrent(
         const ResumableCopyObjectInput& input, ResumableCopyCheckpoint checkpoint,
-        const std::string& checkpointFilePath, std::shared_ptr<CopyEvent> event) {
+        const std::string& checkpointFilePath, std::shared_ptr<CopyEvent> event, const PartSchedule& schedule) {
     Outcome<TosError, ResumableCopyObjectOutput> ret;
     TosError error;
-    std::vector<ResumableCopyPartInfo> toCopy = checkpoint.getPartsInfo();
+    PartRetryQueue<ResumableCopyPartInfo> toCopy(checkpoint.getPartsInfo(), partRetryOptions_);
     std::vector<std::thread> threadPool;
     std::mutex lock_;
     int64_t partSize_ = input.getPartSize();
@@ -5670,7 +6930,8 @@ Outcome<TosError, ResumableCopyObjectOutput> TosClientImpl::resumableCopyConcurr
     auto cancel = input.getCancelHook();
     std::atomic<bool> isAbort(false);
     std::atomic<bool> isSuccess(true);
-    auto logger = LogUtils::GetLogger();
+    auto logger = LogUtils::GetLogger(LogCategoryTransfer, LogInfo);
+    auto stopped = [&]() { return isAbort || (cancel != nullptr && cancel->isCancel()); };
 
     for (int i = 0; i < input.getTaskNum(); i++) {
         auto res = std::thread([&]() {
@@ -5685,15 +6946,15 @@ Outcome<TosError, ResumableCopyObjectOutput> TosClientImpl::resumableCopyConcurr
                 if (isAbort) {
                     break;
                 }
-                // 任务队列中取part
-                ResumableCopyPartInfo part;
-                {
-                    std::lock_guard<std::mutex> lck(lock_);
-                    if (toCopy.empty())
-                        break;
-                    part = toCopy.front();
-                    toCopy.erase(toCopy.begin());
+                // 任务队列中取part，重新排队的分片等待退避结束后再复制
+                PartRetryQueue<ResumableCopyPartInfo>::Entry entry;
+                if (!toCopy.pop(entry)) {
+                    break;
+                }
+                if (!toCopy.Wait(entry, stopped)) {
+                    break;
                 }
+                ResumableCopyPartInfo part = entry.part;
 
                 if (part.isCompleted()) {
                     continue;
@@ -5724,7 +6985,16 @@ Outcome<TosError, ResumableCopyObjectOutput> TosClientImpl::resumableCopyConcurr
                 upci.setServerSideEncryption(input.getServerSideEncryption());
                 upci.setTrafficLimit(input.getTrafficLimit());
 
-                auto res = this->uploadPartCopy(upci);
+                PartRequestOptions partOptions;
+                partOptions.freshConnection = toCopy.freshConnection(entry);
+                // 由 TransferManager 调度时先获取全局名额
+                if (schedule.scheduler != nullptr && !schedule.scheduler->acquire(schedule.priority, stopped)) {
+                    break;
+                }
+                auto res = this->uploadPartCopy(upci, partOptions);
+                if (schedule.scheduler != nullptr) {
+                    schedule.scheduler->release();
+                }
 
                 // 下载后检查是否需要中断任务
                 if (cancel != nullptr) {
@@ -5768,6 +7038,13 @@ Outcome<TosError, ResumableCopyObjectOutput> TosClientImpl::resumableCopyConcurr
                         isAbort = true;
                         break;
                     }
+                    // 可恢复的错误在退避后重传，用尽重试次数后才报告失败
+                    if (toCopy.retry(entry, statusCode)) {
+                        if (logger != nullptr) {
+                            logger->info("retry part {} later, status code {}", part.getPartNum(), statusCode);
+                        }
+                        continue;
+                    }
                     // 事件通知
                     auto eTag_ = std::make_shared<std::string>(res.result().getETag());
                     CopyPartInfo partInfo{part.getPartNum(), part.getCopySourceRangeStart(),
@@ -5870,7 +7147,7 @@ Outcome<TosError, ResumableCopyObjectOutput> TosClientImpl::resumableCopyConcurr
     rco.setSsecKeyMd5(checkpoint.getSsecKeyMd5());
     rco.setEncodingType(checkpoint.getEncodingType());
     ret.setSuccess(true);
-    ret.setR(rco);
+    ret.setR(std::move(rco));
     return ret;
 }
 
@@ -5913,7 +7190,8 @@ std::string getCheckpointPath(const ResumableCopyObjectInput& input) {
     return "";
 }
 
-Outcome<TosError, ResumableCopyObjectOutput> TosClientImpl::resumableCopyObject(const ResumableCopyObjectInput& input) {
+Outcome<TosError, ResumableCopyObjectOutput> TosClientImpl::resumableCopyObject(const ResumableCopyObjectInput& input,
+                                                                                const PartSchedule& schedule) {
     Outcome<TosError, ResumableCopyObjectOutput> res;
     TosError error;
     const auto& bucket = input.getBucket();
@@ -5971,7 +7249,7 @@ Outcome<TosError, ResumableCopyObjectOutput> TosClientImpl::resumableCopyObject(
         res.setSuccess(false);
         return res;
     }
-    return resumableCopyConcurrent(input, cp.result(), checkpointFilePath, event);
+    return resumableCopyConcurrent(input, cp.result(), checkpointFilePath, event, schedule);
 }
 
 Outcome<TosError, PreSignedPolicyURLOutput> TosClientImpl::preSignedPolicyURL(const PreSignedPolicyURLInput& input) {
@@ -6088,7 +7366,7 @@ Outcome<TosError, PreSignedPolicyURLOutput> TosClientImpl::preSignedPolicyURL(co
     bool isCustomDomain = input.isCustomDomain() || config_.isCustomDomain();
     PreSignedPolicyURLOutput output(input.getBucket(), resQueryEncoded, host, scheme, isCustomDomain);
 
-    res.setR(output);
+    res.setR(std::move(output));
     res.setSuccess(true);
     return res;
 }
@@ -6140,7 +7418,7 @@ Outcome<TosError, PutBucketReplicationOutput> TosClientImpl::putBucketReplicatio
     PutBucketReplicationOutput output;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -6174,7 +7452,7 @@ Outcome<TosError, GetBucketReplicationOutput> TosClientImpl::getBucketReplicatio
     output.fromJsonString(ss.str());
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, DeleteBucketReplicationOutput> TosClientImpl::deleteBucketReplication(
@@ -6202,7 +7480,7 @@ Outcome<TosError, DeleteBucketReplicationOutput> TosClientImpl::deleteBucketRepl
     std::stringstream ss;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, PutBucketVersioningOutput> TosClientImpl::putBucketVersioning(const PutBucketVersioningInput& input) {
@@ -6238,7 +7516,7 @@ Outcome<TosError, PutBucketVersioningOutput> TosClientImpl::putBucketVersioning(
     PutBucketVersioningOutput output;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -6268,7 +7546,7 @@ Outcome<TosError, GetBucketVersioningOutput> TosClientImpl::getBucketVersioning(
     output.fromJsonString(ss.str());
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -6304,7 +7582,7 @@ Outcome<TosError, PutBucketWebsiteOutput> TosClientImpl::putBucketWebsite(const
     PutBucketWebsiteOutput output;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -6334,7 +7612,7 @@ Outcome<TosError, GetBucketWebsiteOutput> TosClientImpl::getBucketWebsite(const
     output.fromJsonString(ss.str());
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, DeleteBucketWebsiteOutput> TosClientImpl::deleteBucketWebsite(const DeleteBucketWebsiteInput& input) {
@@ -6361,7 +7639,7 @@ Outcome<TosError, DeleteBucketWebsiteOutput> TosClientImpl::deleteBucketWebsite(
     std::stringstream ss;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -6398,7 +7676,7 @@ Outcome<TosError, PutBucketNotificationOutput> TosClientImpl::putBucketNotificat
     PutBucketNotificationOutput output;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -6429,7 +7707,7 @@ Outcome<TosError, GetBucketNotificationOutput> TosClientImpl::getBucketNotificat
     output.fromJsonString(ss.str());
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -6466,7 +7744,7 @@ Outcome<TosError, PutBucketCustomDomainOutput> TosClientImpl::putBucketCustomDom
     PutBucketCustomDomainOutput output;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -6497,7 +7775,7 @@ Outcome<TosError, ListBucketCustomDomainOutput> TosClientImpl::listBucketCustomD
     output.fromJsonString(ss.str());
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, DeleteBucketCustomDomainOutput> TosClientImpl::deleteBucketCustomDomain(
@@ -6525,7 +7803,7 @@ Outcome<TosError, DeleteBucketCustomDomainOutput> TosClientImpl::deleteBucketCus
     std::stringstream ss;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -6561,7 +7839,7 @@ Outcome<TosError, PutBucketRealTimeLogOutput> TosClientImpl::putBucketRealTimeLo
     PutBucketRealTimeLogOutput output;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -6592,7 +7870,7 @@ Outcome<TosError, GetBucketRealTimeLogOutput> TosClientImpl::getBucketRealTimeLo
     output.fromJsonString(ss.str());
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, DeleteBucketRealTimeLogOutput> TosClientImpl::deleteBucketRealTimeLog(
@@ -6620,7 +7898,7 @@ Outcome<TosError, DeleteBucketRealTimeLogOutput> TosClientImpl::deleteBucketReal
     std::stringstream ss;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -6655,7 +7933,7 @@ Outcome<TosError, RestoreObjectOutput> TosClientImpl::restoreObject(const Restor
     RestoreObjectOutput output;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
@@ -6693,7 +7971,7 @@ Outcome<TosError, RenameObjectOutput> TosClientImpl::renameObject(const RenameOb
     std::stringstream ss;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, PutBucketRenameOutput> TosClientImpl::putBucketRename(const PutBucketRenameInput& input) {
@@ -6727,7 +8005,7 @@ Outcome<TosError, PutBucketRenameOutput> TosClientImpl::putBucketRename(const Pu
     PutBucketRenameOutput output;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, GetBucketRenameOutput> TosClientImpl::getBucketRename(const GetBucketRenameInput& input) {
@@ -6756,7 +8034,7 @@ Outcome<TosError, GetBucketRenameOutput> TosClientImpl::getBucketRename(const Ge
     output.fromJsonString(ss.str());
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 Outcome<TosError, DeleteBucketRenameOutput> TosClientImpl::deleteBucketRename(const DeleteBucketRenameInput& input) {
@@ -6783,10 +8061,66 @@ Outcome<TosError, DeleteBucketRenameOutput> TosClientImpl::deleteBucketRename(co
     std::stringstream ss;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
     return res;
 }
 
+// 记录一次 roundTrip 的总耗时、重试次数与结果，指标关闭时不计时。
+// 按 funcName 查找的 OperationMetrics 挂在请求上，transport 记录各阶段耗时时不再查找
+class RoundTripMetrics {
+public:
+    RoundTripMetrics(const std::shared_ptr<TosRequest>& request,
+                     const Outcome<TosError, std::shared_ptr<TosResponse>>& ret)
+            : ret_(ret) {
+        if (MetricsRegistry::Enabled()) {
+            op_ = MetricsRegistry::instance()->operation(request->getFuncName());
+            request->setOperationMetrics(op_);
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+    ~RoundTripMetrics() {
+        if (op_ == nullptr) {
+            return;
+        }
+        op_->recordLatency(MetricsPhaseRequest, MetricsUtils::ElapsedMicros(start_));
+        op_->recordRequest(ret_.isSuccess(), retries_);
+    }
+    void retry() {
+        retries_++;
+    }
+
+private:
+    const Outcome<TosError, std::shared_ptr<TosResponse>>& ret_;
+    std::shared_ptr<OperationMetrics> op_;
+    int retries_ = 0;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// 写操作结束后失效本地缓存中的对象，失败的写也可能已在服务端生效，因此不区分结果
+class TosClientImpl::ObjectWriteGuard {
+public:
+    ObjectWriteGuard(TosClientImpl& client, const TosRequest& request) : client_(client), request_(request) {
+    }
+    ~ObjectWriteGuard() {
+        const auto& method = request_.getMethod();
+        if (!client_.trackObjectWrites_ || request_.getObjectKey().empty() || method == http::MethodGet ||
+            method == http::MethodHead) {
+            return;
+        }
+        client_.invalidateObjectCache(request_.getBucket(), request_.getObjectKey());
+        // rename 同时影响新的对象名
+        const auto& queries = request_.getQueries();
+        auto name = queries.find("name");
+        if (queries.count("rename") != 0 && name != queries.end()) {
+            client_.invalidateObjectCache(request_.getBucket(), name->second);
+        }
+    }
+
+private:
+    TosClientImpl& client_;
+    const TosRequest& request_;
+};
+
 std::set<std::string> CanRetryMethods = {"createBucket",
                                          "deleteBucket",
                                          "createMultipartUpload",
@@ -6829,34 +8163,84 @@ bool TosClientImpl::checkShouldRetry(const std::shared_ptr<TosRequest>& request,
 
     bool curlErrShouldRetry = (curlErrCode != 0) && findInCanRetryCurlErr(response->getCurlErrCode());
     if (resCode == 429 || resCode >= 500 || curlErrShouldRetry) {
-        if (request->getMethod() == http::MethodGet || request->getMethod() == http::MethodHead) {
-            if (request->getMethod() == http::MethodGet) {
-                auto content_ = request->getContent();
-                if (content_ != nullptr) {
-                    int64_t contentLength_ = calContentLength(content_);
-                    if (contentLength_ != 0) {
-                        return false;
-                    }
-                }
-            }
-            return true;
+        // 请求体按偏移读取，重试时从 0 重新发送，只有不能回退的数据源不重试
+        auto source = request->getBodySource();
+        if (source != nullptr && !source->rewindable()) {
+            return false;
         }
-        if ((resCode == 429 || resCode >= 500 || curlErrShouldRetry) && findInCanRetryMethods(request->getFuncName())) {
-            if (request->getFuncName() == "putObject" || request->getFuncName() == "uploadPart") {
-                auto content_ = request->getContent();
-                if (content_ != nullptr) {
-                    int64_t offset = request->getContentOffset();
-                    content_->seekg(offset, content_->beg);
-                    if (content_->bad() || content_->fail()) {
-                        return false;
-                    }
-                }
-            }
+        if (request->getMethod() == http::MethodGet || request->getMethod() == http::MethodHead) {
             return true;
         }
+        return findInCanRetryMethods(request->getFuncName());
     }
     return false;
 }
+
+int TosClientImpl::routeEndpoint(const std::shared_ptr<TosRequest>& request) {
+    if (endpointSelector_ == nullptr) {
+        return -1;
+    }
+    // 只切换由 endPoint 生成的 host（host_ 或 bucket.host_），指定了 alternativeEndpoint 的请求不参与
+    const auto& host = request->getHost();
+    if (host != host_ && (host.size() <= host_.size() + 1 || host[host.size() - host_.size() - 1] != '.' ||
+                          host.compare(host.size() - host_.size(), host_.size(), host_) != 0)) {
+        return -1;
+    }
+    auto index = endpointSelector_->select();
+    if (index != 0) {
+        retargetRequest(request, 0, index);
+    }
+    return static_cast<int>(index);
+}
+
+bool TosClientImpl::failoverEndpoint(const std::shared_ptr<TosRequest>& request,
+                                     const std::shared_ptr<TosResponse>& resp, int& endpoint,
+                                     std::vector<bool>& tried) {
+    if (endpoint < 0) {
+        return false;
+    }
+    // 请求未到达服务端时才切换，避免非幂等请求被重复执行
+    auto curlErrCode = resp->getCurlErrCode();
+    // CURLE_COULDNT_RESOLVE_HOST、CURLE_COULDNT_CONNECT、CURLE_SSL_CONNECT_ERROR，以及建连完成前的超时
+    if (curlErrCode != 6 && curlErrCode != 7 && curlErrCode != 35 && !resp->isConnectFailed()) {
+        if (resp->getStatusCode() > 0) {
+            endpointSelector_->succeed(endpoint);
+        }
+        return false;
+    }
+    int next = endpointSelector_->failover(endpoint, tried);
+    if (next < 0) {
+        return false;
+    }
+    auto logger = LogUtils::GetLogger(LogCategoryRequest, LogInfo);
+    if (logger != nullptr) {
+        logger->info("connect to {} failed, func name:{}, fail over to {}",
+                     endpointSelector_->endpoint(endpoint).host, request->getFuncName(),
+                     endpointSelector_->endpoint(next).host);
+    }
+    retargetRequest(request, endpoint, next);
+    endpoint = next;
+    return true;
+}
+
+void TosClientImpl::retargetRequest(const std::shared_ptr<TosRequest>& request, size_t from, size_t to) {
+    const auto& fromHost = endpointSelector_->endpoint(from).host;
+    const auto& target = endpointSelector_->endpoint(to);
+    auto host = request->getHost();
+    request->setHost(host.substr(0, host.size() - fromHost.size()) + target.host);
+    request->setScheme(target.scheme);
+    // 签名包含 host，去掉原有的签名头后按新的 host 重新签名
+    auto headers = request->getHeaders();
+    headers.erase(authorization);
+    headers.erase(v4Date);
+    headers.erase("Date");
+    headers.erase(v4SecurityToken);
+    request->setHeaders(headers);
+    for (const auto& h : signer_->signHeader(request)) {
+        request->setSingleHeader(h.first, h.second);
+    }
+}
+
 Outcome<TosError, std::shared_ptr<TosResponse>> TosClientImpl::roundTrip(const std::shared_ptr<TosRequest>& request,
                                                                          int expectedCode) {
     Outcome<TosError, std::shared_ptr<TosResponse>> ret;
@@ -6874,24 +8258,47 @@ Outcome<TosError, std::shared_ptr<TosResponse>> TosClientImpl::roundTrip(const s
         ret.setE(se);
         return ret;
     }
-    auto logger = LogUtils::GetLogger();
+    if (request->getBodySource() != nullptr && request->getContentLength() < 0) {
+        TosError se;
+        se.setIsClientError(true);
+        se.setMessage("unable to determine the length of the request body, please set content length");
+        ret.setE(se);
+        return ret;
+    }
+    RoundTripMetrics metrics(request, ret);
+    ObjectWriteGuard writeGuard(*this, *request);
+    // 日志关闭时 logger 为 nullptr，不计时也不格式化
+    auto logger = LogUtils::GetLogger(LogCategoryRequest, LogInfo);
     auto rateLimiter = request->getRataLimiter();
     auto maxRetry = config_.getMaxRetryCount() < 0 ? 1 : config_.getMaxRetryCount();
+    int endpoint = routeEndpoint(request);
+    std::vector<bool> triedEndpoints;
+    bool failedOver = false;
     for (int retry = 0;; retry++) {
-        if (retry != 0) {
+        if (retry != 0 && !failedOver) {
             TimeUtils::sleepMilliSecondTimes(config_.getRetrySleepScale() * (1 << retry));
         }
-        auto startTime = std::chrono::high_resolution_clock::now();
+        failedOver = false;
+        std::chrono::high_resolution_clock::time_point startTime;
+        if (logger != nullptr) {
+            startTime = std::chrono::high_resolution_clock::now();
+        }
         // 实际进行一次请求
         auto resp = transport_->roundTrip(request);
-        auto endTime = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double, std::milli> fp_ms = endTime - startTime;
+        if (failoverEndpoint(request, resp, endpoint, triedEndpoints)) {
+            // 建连失败时立即换 endpoint 重试，不占用重试次数
+            metrics.retry();
+            failedOver = true;
+            retry--;
+            continue;
+        }
         if (resp->getStatusCode() == expectedCode) {
-            if (logger != nullptr) {
+            if (logger != nullptr && LogUtils::SampleRequestLog(LogCategoryRequest)) {
+                std::chrono::duration<double, std::milli> fp_ms = std::chrono::high_resolution_clock::now() - startTime;
                 logger->info("Response StatusCode:{}, RequestId:{}, Cost:{} ms", resp->getStatusCode(),
                              resp->getRequestID(), fp_ms.count());
             }
-            ret.setR(resp);
+            ret.setR(std::move(resp));
             ret.setSuccess(true);
             return ret;
         } else if (checkShouldRetry(request, resp) && retry < maxRetry) {
@@ -6899,6 +8306,7 @@ Outcome<TosError, std::shared_ptr<TosResponse>> TosClientImpl::roundTrip(const s
                 logger->info("http status code:{}, http error:{}, func name:{}, will retry once", resp->getStatusCode(),
                              resp->getStatusMsg(), request->getFuncName());
             }
+            metrics.retry();
             continue;
         } else {
             // check error
@@ -6981,24 +8389,47 @@ Outcome<TosError, std::shared_ptr<TosResponse>> TosClientImpl::roundTrip(const s
         ret.setE(se);
         return ret;
     }
-    auto logger = LogUtils::GetLogger();
+    if (request->getBodySource() != nullptr && request->getContentLength() < 0) {
+        TosError se;
+        se.setIsClientError(true);
+        se.setMessage("unable to determine the length of the request body, please set content length");
+        ret.setE(se);
+        return ret;
+    }
+    RoundTripMetrics metrics(request, ret);
+    ObjectWriteGuard writeGuard(*this, *request);
+    // 日志关闭时 logger 为 nullptr，不计时也不格式化
+    auto logger = LogUtils::GetLogger(LogCategoryRequest, LogInfo);
     auto rateLimiter = request->getRataLimiter();
     auto maxRetry = config_.getMaxRetryCount() < 0 ? 1 : config_.getMaxRetryCount();
+    int endpoint = routeEndpoint(request);
+    std::vector<bool> triedEndpoints;
+    bool failedOver = false;
     for (int retry = 0;; retry++) {
-        if (retry != 0) {
+        if (retry != 0 && !failedOver) {
             TimeUtils::sleepMilliSecondTimes(config_.getRetrySleepScale() * (1 << retry));
         }
-        auto startTime = std::chrono::high_resolution_clock::now();
+        failedOver = false;
+        std::chrono::high_resolution_clock::time_point startTime;
+        if (logger != nullptr) {
+            startTime = std::chrono::high_resolution_clock::now();
+        }
         // 实际进行一次请求
         auto resp = transport_->roundTrip(request);
-        auto endTime = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double, std::milli> fp_ms = endTime - startTime;
+        if (failoverEndpoint(request, resp, endpoint, triedEndpoints)) {
+            // 建连失败时立即换 endpoint 重试，不占用重试次数
+            metrics.retry();
+            failedOver = true;
+            retry--;
+            continue;
+        }
         if (std::find(expectedCode.begin(), expectedCode.end(), resp->getStatusCode()) != expectedCode.end()) {
-            if (logger != nullptr) {
+            if (logger != nullptr && LogUtils::SampleRequestLog(LogCategoryRequest)) {
+                std::chrono::duration<double, std::milli> fp_ms = std::chrono::high_resolution_clock::now() - startTime;
                 logger->info("Response StatusCode:{}, RequestId:{}, Cost:{} ms", resp->getStatusCode(),
                              resp->getRequestID(), fp_ms.count());
             }
-            ret.setR(resp);
+            ret.setR(std::move(resp));
             ret.setSuccess(true);
             return ret;
         } else if (checkShouldRetry(request, resp) && retry < maxRetry) {
@@ -7006,6 +8437,7 @@ Outcome<TosError, std::shared_ptr<TosResponse>> TosClientImpl::roundTrip(const s
                 logger->info("http status code:{}, http error:{}, func name:{}, will retry once", resp->getStatusCode(),
                              resp->getStatusMsg(), request->getFuncName());
             }
+            metrics.retry();
             continue;
         } else {
             // check error
@@ -7126,7 +8558,7 @@ void TosClientImpl::getObject(RequestBuilder& rb, Outcome<TosError, GetObjectOut
     output.setContent(tosRes.result()->getContent());
     output.setObjectMetaFromResponse(*tosRes.result());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
 }
 void TosClientImpl::headObject(RequestBuilder& rb, Outcome<TosError, HeadObjectOutput>& res) {
     auto req = rb.Build(http::MethodHead, nullptr);
@@ -7141,7 +8573,7 @@ void TosClientImpl::headObject(RequestBuilder& rb, Outcome<TosError, HeadObjectO
     output.setContentRange(rb.findHeader(http::HEADER_CONTENT_RANGE));
     output.setObjectMeta(*(tosRes.result()));
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
 }
 void TosClientImpl::deleteObject(RequestBuilder& rb, Outcome<TosError, DeleteObjectOutput>& res) {
     auto req = rb.Build(http::MethodDelete, nullptr);
@@ -7156,13 +8588,15 @@ void TosClientImpl::deleteObject(RequestBuilder& rb, Outcome<TosError, DeleteObj
     output.setDeleteMarker(tosRes.result()->findHeader(HEADER_DELETE_MARKER) == "true");
     output.setVersionId(tosRes.result()->findHeader(HEADER_VERSIONID));
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
 }
-void TosClientImpl::deleteMultiObjects(RequestBuilder& rb, const std::string& data, const std::string& dataMd5,
+void TosClientImpl::deleteMultiObjects(RequestBuilder& rb, const DeleteMultiObjectsInput& input,
                                        Outcome<TosError, DeleteMultiObjectsOutput>& res) {
-    rb.withHeader(http::HEADER_CONTENT_MD5, dataMd5);
+    JsonWriter writer(input.getObjectTobeDeleteds().size() * 64 + 32, true);
+    writeJson(writer, input);
+    rb.withHeader(http::HEADER_CONTENT_MD5, writer.md5());
     rb.withQuery("delete", "");
-    auto req = rb.Build(http::MethodPost, std::make_shared<std::stringstream>(data));
+    auto req = rb.BuildWithBodySource(http::MethodPost, std::make_shared<MemoryBodySource>(writer.release()));
     auto tosRes = roundTrip(req, 200);
     if (!tosRes.isSuccess()) {
         res.setE(tosRes.error());
@@ -7174,7 +8608,7 @@ void TosClientImpl::deleteMultiObjects(RequestBuilder& rb, const std::string& da
     DeleteMultiObjectsOutput output;
     output.fromJsonString(out.str());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
 }
 void TosClientImpl::putObject(const std::shared_ptr<TosRequest>& req, Outcome<TosError, PutObjectOutput>& res) {
     auto tosRes = roundTrip(req, 200);
@@ -7192,7 +8626,7 @@ void TosClientImpl::putObject(const std::shared_ptr<TosRequest>& req, Outcome<To
     output.setSseCustomerKeyMd5(tosRes.result()->findHeader(HEADER_SSE_CUSTOMER_KEY_MD5));
     output.setSseCustomerKey(tosRes.result()->findHeader(HEADER_SSE_CUSTOMER_KEY));
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
 }
 void TosClientImpl::appendObject(const std::shared_ptr<TosRequest>& req, Outcome<TosError, AppendObjectOutput>& res) {
     auto tosRes = roundTrip(req, 200);
@@ -7210,7 +8644,7 @@ void TosClientImpl::appendObject(const std::shared_ptr<TosRequest>& req, Outcome
     }
     output.setCrc64(tosRes.result()->findHeader(HEADER_CRC64));
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
 }
 
 void TosClientImpl::setObjectMeta(RequestBuilder& rb, Outcome<TosError, SetObjectMetaOutput>& res) {
@@ -7225,7 +8659,7 @@ void TosClientImpl::setObjectMeta(RequestBuilder& rb, Outcome<TosError, SetObjec
     SetObjectMetaOutput output;
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
 }
 void TosClientImpl::copyObject(const std::string& dstBucket, const std::string& dstObject, const std::string& srcBucket,
                                const std::string& srcObject, Outcome<TosError, CopyObjectOutput>& outcome) {
@@ -7254,7 +8688,7 @@ void TosClientImpl::copyObject(std::shared_ptr<TosRequest>& req, Outcome<TosErro
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     output.setCrc64(tosRes.result()->findHeader(HEADER_CRC64));
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
 }
 
 void TosClientImpl::uploadPartCopy(RequestBuilder& rb, const UploadPartCopyInput& input,
@@ -7283,7 +8717,7 @@ void TosClientImpl::uploadPartCopy(RequestBuilder& rb, const UploadPartCopyInput
     output.setLastModified(out.getLastModified());
     output.setCrc64(tosRes.result()->findHeader(HEADER_CRC64));
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
 }
 
 void TosClientImpl::getObjectAcl(RequestBuilder& rb, Outcome<TosError, GetObjectAclOutput>& res) {
@@ -7301,7 +8735,7 @@ void TosClientImpl::getObjectAcl(RequestBuilder& rb, Outcome<TosError, GetObject
     output.fromJsonString(ss.str());
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
 }
 void TosClientImpl::createMultipartUpload(RequestBuilder& rb, Outcome<TosError, CreateMultipartUploadOutput>& res) {
     rb.withQuery("uploads", "");
@@ -7325,7 +8759,7 @@ void TosClientImpl::createMultipartUpload(RequestBuilder& rb, Outcome<TosError,
     output.setSseCustomerMd5(tosRes.result()->findHeader(HEADER_SSE_CUSTOMER_KEY_MD5));
     output.setSseCustomerKey(tosRes.result()->findHeader(HEADER_SSE_CUSTOMER_KEY));
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
 }
 void TosClientImpl::uploadPart(RequestBuilder& rb, const UploadPartInput& input,
                                Outcome<TosError, UploadPartOutput>& res) {
@@ -7355,7 +8789,7 @@ void TosClientImpl::uploadPart(RequestBuilder& rb, const UploadPartInput& input,
     output.setSseCustomerAlgorithm(tosRes.result()->findHeader(HEADER_SSE_CUSTOMER_ALGORITHM));
     output.setSseCustomerMd5(tosRes.result()->findHeader(HEADER_SSE_CUSTOMER_KEY_MD5));
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
 }
 void TosClientImpl::listUploadedParts(RequestBuilder& rb, const std::string& uploadId,
                                       Outcome<TosError, ListUploadedPartsOutput>& res) {
@@ -7373,7 +8807,7 @@ void TosClientImpl::listUploadedParts(RequestBuilder& rb, const std::string& upl
     output.fromJsonString(ss.str());
     output.setRequestInfo(tosRes.result()->GetRequestInfo());
     res.setSuccess(true);
-    res.setR(output);
+    res.setR(std::move(output));
 }
 
 void TosClientImpl::preSignedURL(RequestBuilder& rb, const std::string& method, const std::chrono::duration<int>& ttl,
@@ -7384,7 +8818,7 @@ void TosClientImpl::preSignedURL(RequestBuilder& rb, const std::string& method,
         req->setSingleQuery(iter.first, iter.second);
     }
     auto url = req->toUrl().toString();
-    res.setR(url);
+    res.setR(std::move(url));
     res.setSuccess(true);
 }
 
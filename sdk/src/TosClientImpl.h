@@ -7,6 +7,15 @@
 #include "RequestOptionBuilder.h"
 #include "transport/Transport.h"
 #include "Config.h"
+#include "cache/ObjectCache.h"
+#include "cache/ObjectMetaCache.h"
+#include "cache/SingleFlight.h"
+#include "transfer/LocalFileWalker.h"
+#include "transfer/PartRetryQueue.h"
+#include "transfer/StragglerDetector.h"
+#include "transfer/TransferManager.h"
+#include "utils/TaskExecutor.h"
+#include <atomic>
 #include "model/object/GetObjectOutput.h"
 #include "model/object/HeadObjectOutput.h"
 #include "model/object/DeleteObjectOutput.h"
@@ -65,6 +74,18 @@
 #include "model/object/GetObjectV2Input.h"
 #include "model/object/GetObjectToFileInput.h"
 #include "model/object/GetObjectToFileOutput.h"
+#include "model/object/ReadRangesInput.h"
+#include "model/object/ReadRangesOutput.h"
+#include "model/object/DownloadToBufferInput.h"
+#include "model/object/DownloadToBufferOutput.h"
+#include "model/object/UploadDirectoryInput.h"
+#include "model/object/UploadDirectoryOutput.h"
+#include "model/object/DownloadPrefixInput.h"
+#include "model/object/DownloadPrefixOutput.h"
+#include "model/object/SyncDirectoryInput.h"
+#include "model/object/SyncDirectoryOutput.h"
+#include "model/object/CopyPrefixInput.h"
+#include "model/object/CopyPrefixOutput.h"
 #include "model/object/HeadObjectV2Output.h"
 #include "model/object/HeadObjectV2Input.h"
 #include "model/object/ListObjectsV2Output.h"
@@ -188,6 +209,19 @@
 #include "model/bucket/DeleteBucketRenameInput.h"
 #include "model/bucket/DeleteBucketRenameOutput.h"
 namespace VolcengineTos {
+class EndpointSelector;
+// uploadFile/downloadFile/resumableCopyObject 内部分片请求的传输选项
+struct PartRequestOptions {
+    // 非空时可在其他线程观察并中止请求
+    std::shared_ptr<TransferMonitor> monitor;
+    // 使用新建的连接发送请求
+    bool freshConnection = false;
+};
+// 由 TransferManager 调度的任务在每个分片请求前按任务优先级从全局名额池获取名额
+struct PartSchedule {
+    std::shared_ptr<PartScheduler> scheduler;
+    int priority = 0;
+};
 class TosClientImpl {
 public:
     TosClientImpl(const std::string& endpoint, const std::string& region, const StaticCredentials& cred);
@@ -198,6 +232,8 @@ public:
                   const ClientConfig& config);
 
     ~TosClientImpl() = default;
+    // 后台任务共用的线程池，如 ObjectReadSession 的预读请求，第一次使用时创建
+    std::shared_ptr<TaskExecutor> executor();
     Outcome<TosError, CreateBucketOutput> createBucket(const CreateBucketInput& input);
     Outcome<TosError, CreateBucketV2Output> createBucket(const CreateBucketV2Input& input);
     Outcome<TosError, HeadBucketOutput> headBucket(const std::string& bucket);
@@ -214,8 +250,13 @@ public:
                                                  const RequestOptionBuilder& builder);
     Outcome<TosError, GetObjectV2Output> getObject(const GetObjectV2Input& input,
                                                    std::shared_ptr<uint64_t> hashCrc64ecma,
-                                                   std::shared_ptr<std::iostream> fileContent);
+                                                   std::shared_ptr<std::iostream> fileContent,
+                                                   const PartRequestOptions& partOptions = PartRequestOptions());
+    // 响应体写入调用方的 BodySink，不走缓存，也不合并请求
+    Outcome<TosError, GetObjectV2Output> getObject(const GetObjectV2Input& input, std::shared_ptr<BodySink> sink);
     Outcome<TosError, GetObjectToFileOutput> getObjectToFile(const GetObjectToFileInput& input);
+    Outcome<TosError, ReadRangesOutput> readRanges(const ReadRangesInput& input);
+    Outcome<TosError, DownloadToBufferOutput> downloadToBuffer(const DownloadToBufferInput& input);
     Outcome<TosError, HeadObjectOutput> headObject(const std::string& bucket, const std::string& objectKey);
     Outcome<TosError, HeadObjectOutput> headObject(const std::string& bucket, const std::string& objectKey,
                                                    const RequestOptionBuilder& builder);
@@ -236,11 +277,19 @@ public:
                                                  const std::shared_ptr<std::iostream>& content,
                                                  const RequestOptionBuilder& builder);
     Outcome<TosError, PutObjectV2Output> putObject(const PutObjectV2Input& input);
-    Outcome<TosError, PutObjectFromFileOutput> putObjectFromFile(const PutObjectFromFileInput& input);
+    // autoParallel 为 false 时不按 multipartThreshold 切换为分片上传，用于已自行分片调度的调用方
+    Outcome<TosError, PutObjectFromFileOutput> putObjectFromFile(const PutObjectFromFileInput& input,
+                                                                 bool autoParallel = true);
     Outcome<TosError, UploadFileOutput> uploadFile(const std::string& bucket, const UploadFileInput& input,
                                                    const RequestOptionBuilder& builder);
-    Outcome<TosError, UploadFileV2Output> uploadFile(const UploadFileV2Input& input);
-    Outcome<TosError, DownloadFileOutput> downloadFile(const DownloadFileInput& input);
+    Outcome<TosError, UploadFileV2Output> uploadFile(const UploadFileV2Input& input,
+                                                     const PartSchedule& schedule = PartSchedule());
+    Outcome<TosError, UploadDirectoryOutput> uploadDirectory(const UploadDirectoryInput& input);
+    Outcome<TosError, DownloadPrefixOutput> downloadPrefix(const DownloadPrefixInput& input);
+    Outcome<TosError, SyncDirectoryOutput> syncDirectory(const SyncDirectoryInput& input);
+    Outcome<TosError, CopyPrefixOutput> copyPrefix(const CopyPrefixInput& input);
+    Outcome<TosError, DownloadFileOutput> downloadFile(const DownloadFileInput& input,
+                                                       const PartSchedule& schedule = PartSchedule());
     Outcome<TosError, AppendObjectOutput> appendObject(const std::string& bucket, const std::string& objectKey,
                                                        const std::shared_ptr<std::iostream>& content, int64_t offset);
     Outcome<TosError, AppendObjectOutput> appendObject(const std::string& bucket, const std::string& objectKey,
@@ -275,7 +324,8 @@ public:
     Outcome<TosError, UploadPartCopyOutput> uploadPartCopy(const std::string& bucket, const UploadPartCopyInput& input);
     Outcome<TosError, UploadPartCopyOutput> uploadPartCopy(const std::string& bucket, const UploadPartCopyInput& input,
                                                            const RequestOptionBuilder& builder);
-    Outcome<TosError, UploadPartCopyV2Output> uploadPartCopy(const UploadPartCopyV2Input& input);
+    Outcome<TosError, UploadPartCopyV2Output> uploadPartCopy(const UploadPartCopyV2Input& input,
+                                                             const PartRequestOptions& partOptions = PartRequestOptions());
     Outcome<TosError, PutObjectAclOutput> putObjectAcl(const std::string& bucket, const PutObjectAclInput& input);
     Outcome<TosError, PutObjectAclV2Output> putObjectAcl(const PutObjectAclV2Input& input);
     Outcome<TosError, GetObjectAclOutput> getObjectAcl(const std::string& bucket, const std::string& objectKey);
@@ -292,9 +342,11 @@ public:
     Outcome<TosError, UploadPartOutput> uploadPart(const std::string& bucket, const UploadPartInput& input,
                                                    const RequestOptionBuilder& builder);
     Outcome<TosError, UploadPartV2Output> uploadPart(const UploadPartV2Input& input,
-                                                     std::shared_ptr<uint64_t> hashCrc64ecma);
+                                                     std::shared_ptr<uint64_t> hashCrc64ecma,
+                                                     const PartRequestOptions& partOptions = PartRequestOptions());
     Outcome<TosError, UploadPartFromFileOutput> uploadPartFromFile(const UploadPartFromFileInput& input,
-                                                                   std::shared_ptr<uint64_t> hashCrc64ecma);
+                                                                   std::shared_ptr<uint64_t> hashCrc64ecma,
+                                                                   const PartRequestOptions& partOptions = PartRequestOptions());
     Outcome<TosError, CompleteMultipartUploadOutput> completeMultipartUpload(const std::string& bucket,
                                                                              CompleteMultipartUploadInput& input);
     Outcome<TosError, CompleteMultipartUploadOutput> completeMultipartUpload(const std::string& bucket,
@@ -347,7 +399,8 @@ public:
     Outcome<TosError, PreSignedPostSignatureOutput> preSignedPostSignature(const PreSignedPostSignatureInput& input);
 
     // 2.5.0
-    Outcome<TosError, ResumableCopyObjectOutput> resumableCopyObject(const ResumableCopyObjectInput& input);
+    Outcome<TosError, ResumableCopyObjectOutput> resumableCopyObject(const ResumableCopyObjectInput& input,
+                                                                     const PartSchedule& schedule = PartSchedule());
     Outcome<TosError, PreSignedPolicyURLOutput> preSignedPolicyURL(const PreSignedPolicyURLInput& input);
     Outcome<TosError, PutBucketReplicationOutput> putBucketReplication(const PutBucketReplicationInput& input);
     Outcome<TosError, GetBucketReplicationOutput> getBucketReplication(const GetBucketReplicationInput& input);
@@ -385,6 +438,9 @@ public:
     const std::string& getEndpoint() const;
     void setRegion(const std::string& region);
     void setRegionEndpoint(const std::string& region, const std::string& endpoint);
+    // 未开启对象缓存时返回全 0
+    ObjectCacheStats getObjectCacheStats() const;
+    ObjectMetaCacheStats getObjectMetaCacheStats() const;
 
 protected:
     /**
@@ -405,8 +461,26 @@ private:
     RequestBuilder newBuilder(const std::string& bucket, const std::string& object,
                               const std::string& alternativeEndpoint, const std::map<std::string, std::string>& headers,
                               std::map<std::string, std::string>& queries);
+    // 配置了 failoverEndpoints 时为请求选择 endpoint，返回所选下标；请求的 host 不是由 endpoint 生成时返回 -1
+    int routeEndpoint(const std::shared_ptr<TosRequest>& request);
+    // 请求在 endpoint 上建连失败时切换到下一个 endpoint，返回 false 表示不需要或无法切换
+    bool failoverEndpoint(const std::shared_ptr<TosRequest>& request, const std::shared_ptr<TosResponse>& resp,
+                          int& endpoint, std::vector<bool>& tried);
+    // 把请求的 host 从 endpoint from 换成 to，并按新的 host 重新签名
+    void retargetRequest(const std::shared_ptr<TosRequest>& request, size_t from, size_t to);
     std::string scheme_;
     std::string host_;
+    std::shared_ptr<EndpointSelector> endpointSelector_;
+    // 开启时 uploadFile/downloadFile 的分片并发传输监控并处理落后的分片请求
+    bool enableStragglerDetection_ = false;
+    StragglerOptions stragglerOptions_;
+    // 分片并发传输中失败的分片在本次调用内重新排队
+    PartRetryOptions partRetryOptions_;
+    // putObjectFromFile/getObjectToFile 自动切换为分片并发传输的阈值，0 表示关闭
+    int64_t multipartThreshold_ = 64 * 1024 * 1024;
+    int64_t parallelGetThreshold_ = 64 * 1024 * 1024;
+    int64_t parallelPartSize_ = 16 * 1024 * 1024;
+    int parallelTaskNum_ = 8;
     int urlMode_ = URL_MODE_DEFAULT;
     std::string userAgent_ = DefaultUserAgent();
     std::shared_ptr<Credentials> credentials_;
@@ -415,14 +489,58 @@ private:
     Config config_;
     bool connectWithIP_ = false;
     bool connectWithS3EndPoint_ = false;
+    std::shared_ptr<ObjectCache> objectCache_;
+    std::shared_ptr<ObjectMetaCache> objectMetaCache_;
+    // 合并并发的相同 getObject 时，响应体读入内存后分发给每个调用方
+    struct CoalescedGetResult {
+        Outcome<TosError, GetObjectV2Output> outcome;
+        std::shared_ptr<std::string> body;
+    };
+    std::shared_ptr<SingleFlight<Outcome<TosError, HeadObjectV2Output>>> headFlight_;
+    std::shared_ptr<SingleFlight<CoalescedGetResult>> getFlight_;
+    std::mutex executorMu_;
+    std::shared_ptr<TaskExecutor> executor_;
+    // 本 client 对象写操作的计数，用于避免写之后的读合并到写之前发出的请求上
+    std::atomic<uint64_t> objectWriteEpoch_{0};
+    // 缓存或请求合并开启时才需要跟踪写操作
+    bool trackObjectWrites_ = false;
+    class ObjectWriteGuard;
 
     std::map<std::string, std::string> supportedRegion_ = {{"cn-beijing", "https://tos-cn-beijing.volces.com"},
                                                            {"cn-guangzhou", "https://tos-cn-guangzhou.volces.com"},
                                                            {"cn-shanghai", "https://tos-cn-shanghai.volces.com"}};
     void getObject(RequestBuilder& rb, Outcome<TosError, GetObjectOutput>& res);
+    // 实现在 transfer/UploadDirectory.cc
+    Outcome<TosError, UploadDirectoryOutput> uploadDirectoryConcurrent(const UploadDirectoryInput& input);
+    Outcome<TosError, UploadDirectoryOutput> uploadLocalFilesConcurrent(const UploadDirectoryInput& input,
+                                                                        std::vector<LocalFileInfo> localFiles);
+    // 实现在 transfer/DownloadPrefix.cc
+    // objects 为空时列举 prefix 下的全部对象，否则只下载 objects
+    Outcome<TosError, DownloadPrefixOutput> downloadObjectsConcurrent(const DownloadPrefixInput& input,
+                                                                      const std::vector<ListedObjectV2>* objects);
+    // 实现在 transfer/SyncDirectory.cc
+    Outcome<TosError, SyncDirectoryOutput> syncDirectoryConcurrent(const SyncDirectoryInput& input);
+    // 实现在 transfer/CopyPrefix.cc
+    Outcome<TosError, CopyPrefixOutput> copyPrefixConcurrent(const CopyPrefixInput& input);
+    Outcome<TosError, GetObjectV2Output> getObjectFromServer(const GetObjectV2Input& input,
+                                                             std::shared_ptr<uint64_t> hashCrc64ecma,
+                                                             std::shared_ptr<std::iostream> fileContent,
+                                                             std::shared_ptr<BodySink> sink = nullptr,
+                                                             const PartRequestOptions& partOptions = PartRequestOptions());
+    bool getObjectFromCache(const GetObjectV2Input& input, int64_t start, int64_t end, bool ranged,
+                            const std::shared_ptr<std::iostream>& fileContent,
+                            Outcome<TosError, GetObjectV2Output>& res);
+    Outcome<TosError, GetObjectV2Output> getObjectCoalesced(const GetObjectV2Input& input, int64_t start,
+                                                            int64_t end, bool ranged);
+    Outcome<TosError, HeadObjectV2Output> headObjectFromServer(const HeadObjectV2Input& input);
+    void invalidateObjectCache(const std::string& bucket, const std::string& key);
+    // deleteMultiObjects 的对象名在请求体中，需要单独失效
+    void invalidateObjectCache(const std::string& bucket, const std::vector<ObjectTobeDeleted>& objects);
+    bool fillObjectCache(const GetObjectV2Input& input, const std::string& cacheKey, const CachedObjectMeta& meta,
+                         int64_t start, int64_t end, uint64_t epoch);
     void headObject(RequestBuilder& rb, Outcome<TosError, HeadObjectOutput>& res);
     void deleteObject(RequestBuilder& rb, Outcome<TosError, DeleteObjectOutput>& res);
-    void deleteMultiObjects(RequestBuilder& rb, const std::string& data, const std::string& dataMd5,
+    void deleteMultiObjects(RequestBuilder& rb, const DeleteMultiObjectsInput& input,
                             Outcome<TosError, DeleteMultiObjectsOutput>& res);
     void putObject(const std::shared_ptr<TosRequest>& req, Outcome<TosError, PutObjectOutput>& res);
     void appendObject(const std::shared_ptr<TosRequest>& req, Outcome<TosError, AppendObjectOutput>& res);
@@ -469,10 +587,22 @@ private:
     Outcome<TosError, UploadFileV2Output> uploadPartConcurrent(const UploadFileV2Input& input,
                                                                UploadFileCheckpointV2 checkpoint,
                                                                const std::string& checkpointFilePath,
-                                                               std::shared_ptr<UploadEvent> event);
+                                                               std::shared_ptr<UploadEvent> event,
+                                                               const PartSchedule& schedule);
+    // downloadFile 在 HEAD 之后的部分，headOutput 为下载对象的元数据
+    Outcome<TosError, DownloadFileOutput> downloadFileFromHead(const DownloadFileInput& input,
+                                                               const HeadObjectV2Output& headOutput,
+                                                               const PartSchedule& schedule);
+    // 超过阈值时 putObjectFromFile/getObjectToFile 转为 uploadFile/downloadFile 的分片并发传输
+    Outcome<TosError, PutObjectFromFileOutput> putObjectFromFileParallel(const PutObjectFromFileInput& input,
+                                                                         int64_t fileSize);
+    // fallback 为 true 时调用方改为单个 GET 下载，例如空对象或剩余部分读取时对象已被覆盖
+    Outcome<TosError, GetObjectToFileOutput> getObjectToFileParallel(const GetObjectToFileInput& input,
+                                                                     bool& fallback);
     Outcome<TosError, DownloadFileOutput> downloadPartConcurrent(
             const DownloadFileInput& input, const HeadObjectV2Output& headOutput, DownloadFileCheckpoint checkpoint,
-            const std::string& checkpointPath, const DownloadFileFileInfo& dfi, std::shared_ptr<DownloadEvent> event);
+            const std::string& checkpointPath, const DownloadFileFileInfo& dfi, std::shared_ptr<DownloadEvent> event,
+            const PartSchedule& schedule);
 
     Outcome<TosError, ResumableCopyCheckpoint> getCheckpoint(const ResumableCopyObjectInput& input,
                                                              const HeadObjectV2Input& headInput,
@@ -486,7 +616,8 @@ private:
     Outcome<TosError, ResumableCopyObjectOutput> resumableCopyConcurrent(const ResumableCopyObjectInput& input,
                                                                          ResumableCopyCheckpoint checkpoint,
                                                                          const std::string& checkpointFilePath,
-                                                                         std::shared_ptr<CopyEvent> event);
+                                                                         std::shared_ptr<CopyEvent> event,
+                                                                         const PartSchedule& schedule);
     void uploadPart(RequestBuilder& rb, const UploadPartInput& input, Outcome<TosError, UploadPartOutput>& res);
 
     void listUploadedParts(RequestBuilder& rb, const std::string& uploadId,
@@ -500,7 +631,6 @@ private:
     void init(const std::string& endpoint, const std::string& region, const ClientConfig& config);
     void initRegionEndpoint(const std::string& endpoint, const std::string& region);
     SchemeHostParameter initSchemeAndHost(const std::string& endpoint);
-    int64_t calContentLength(const std::shared_ptr<std::iostream>& content);
     void SetCrc64ParmToReq(const std::shared_ptr<TosRequest>& req);
     void SetProcessHandlerToReq(const std::shared_ptr<TosRequest>& req, DataTransferListener& handler);
     void SetRateLimiterToReq(const std::shared_ptr<TosRequest>& req, const std::shared_ptr<RateLimiter>& limiter);
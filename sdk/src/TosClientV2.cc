@@ -64,6 +64,10 @@ Outcome<TosError, DeleteBucketOutput> TosClientV2::deleteBucket(const DeleteBuck
 Outcome<TosError, GetObjectV2Output> TosClientV2::getObject(const GetObjectV2Input& input) const {
     return tosClientImpl_->getObject(input, nullptr, nullptr);
 }
+Outcome<TosError, GetObjectV2Output> TosClientV2::getObject(const GetObjectV2Input& input,
+                                                            const std::shared_ptr<BodySink>& sink) const {
+    return tosClientImpl_->getObject(input, sink);
+}
 // Outcome<TosError, GetObjectV2Output> TosClientV2::getObject(const GetObjectV2Input& input,
 //                                                             std::shared_ptr<std::iostream> resContent,
 //                                                             std::shared_ptr<DataConsumeCallBack> callBack) const {
@@ -72,9 +76,38 @@ Outcome<TosError, GetObjectV2Output> TosClientV2::getObject(const GetObjectV2Inp
 Outcome<TosError, GetObjectToFileOutput> TosClientV2::getObjectToFile(const GetObjectToFileInput& input) const {
     return tosClientImpl_->getObjectToFile(input);
 }
+Outcome<TosError, ReadRangesOutput> TosClientV2::readRanges(const ReadRangesInput& input) const {
+    return tosClientImpl_->readRanges(input);
+}
+Outcome<TosError, DownloadToBufferOutput> TosClientV2::downloadToBuffer(const DownloadToBufferInput& input) const {
+    return tosClientImpl_->downloadToBuffer(input);
+}
+std::shared_ptr<ObjectReadSession> TosClientV2::openReadSession(const GetObjectV2Input& input) const {
+    return std::make_shared<ObjectReadSession>(*this, input, ReadSessionOptions());
+}
+std::shared_ptr<ObjectReadSession> TosClientV2::openReadSession(const GetObjectV2Input& input,
+                                                                const ReadSessionOptions& options) const {
+    return std::make_shared<ObjectReadSession>(*this, input, options);
+}
+std::shared_ptr<TransferManager> TosClientV2::newTransferManager(const TransferManagerOptions& options) const {
+    return std::make_shared<TransferManager>(*this, options);
+}
+std::shared_ptr<ObjectAppender> TosClientV2::openAppender(const AppendObjectV2Input& input) const {
+    return std::make_shared<ObjectAppender>(*this, input, AppenderOptions());
+}
+std::shared_ptr<ObjectAppender> TosClientV2::openAppender(const AppendObjectV2Input& input,
+                                                          const AppenderOptions& options) const {
+    return std::make_shared<ObjectAppender>(*this, input, options);
+}
+ObjectCacheStats TosClientV2::getObjectCacheStats() const {
+    return tosClientImpl_->getObjectCacheStats();
+}
 Outcome<TosError, HeadObjectV2Output> TosClientV2::headObject(const HeadObjectV2Input& input) const {
     return tosClientImpl_->headObject(input);
 }
+ObjectMetaCacheStats TosClientV2::getObjectMetaCacheStats() const {
+    return tosClientImpl_->getObjectMetaCacheStats();
+}
 Outcome<TosError, DeleteObjectOutput> TosClientV2::deleteObject(const DeleteObjectInput& input) const {
     return tosClientImpl_->deleteObject(input);
 }
@@ -142,10 +175,22 @@ Outcome<TosError, ListMultipartUploadsV2Output> TosClientV2::listMultipartUpload
 Outcome<TosError, UploadFileV2Output> TosClientV2::uploadFile(const UploadFileV2Input& input) const {
     return tosClientImpl_->uploadFile(input);
 }
+Outcome<TosError, UploadDirectoryOutput> TosClientV2::uploadDirectory(const UploadDirectoryInput& input) const {
+    return tosClientImpl_->uploadDirectory(input);
+}
 
 Outcome<TosError, DownloadFileOutput> TosClientV2::downloadFile(const DownloadFileInput& input) const {
     return tosClientImpl_->downloadFile(input);
 }
+Outcome<TosError, DownloadPrefixOutput> TosClientV2::downloadPrefix(const DownloadPrefixInput& input) const {
+    return tosClientImpl_->downloadPrefix(input);
+}
+Outcome<TosError, SyncDirectoryOutput> TosClientV2::syncDirectory(const SyncDirectoryInput& input) const {
+    return tosClientImpl_->syncDirectory(input);
+}
+Outcome<TosError, CopyPrefixOutput> TosClientV2::copyPrefix(const CopyPrefixInput& input) const {
+    return tosClientImpl_->copyPrefix(input);
+}
 Outcome<TosError, PreSignedURLOutput> TosClientV2::preSignedURL(const PreSignedURLInput& input) const {
     return tosClientImpl_->preSignedURL(input);
 }
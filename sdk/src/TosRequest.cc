@@ -15,13 +15,7 @@ Url TosRequest::toUrl() {
 }
 
 void TosRequest::resolveContentLength() {
-    int64_t currentPos = content_->tellg();
-    if (currentPos == static_cast<std::streampos>(-1)) {
-        currentPos = 0;
-        content_->clear();
-    }
-    content_->seekg(0, content_->end);
-    int64_t size = content_->tellg();
-    content_->seekg(currentPos, content_->beg);
+    // 内存和文件的 BodySource 直接返回长度，iostream 只在这里探测一次。长度未知时保留 -1，由 roundTrip 报错
+    int64_t size = bodySource_ == nullptr ? 0 : bodySource_->size();
     this->setContentLength(size);
-}
\ No newline at end of file
+}
@@ -314,10 +314,9 @@ std::string SignV4::doSign(const std::string& method, const std::string& path, c
     std::string buf;
 
     std::string req = this->canonicalRequest(method, path, contentSha256, header, query);
-    std::string canonicalRequest = "canonicalRequest: " + req;
-    auto l = LogUtils::GetLogger();
+    auto l = LogUtils::GetLogger(LogCategoryAuth, LogDebug);
     if (l != nullptr) {
-        l->debug(canonicalRequest);
+        l->debug("canonicalRequest: {}", req);
     }
 
     buf.append(signPrefix).append(split);
@@ -0,0 +1,408 @@
+#include "cache/ObjectCache.h"
+#include "utils/BaseUtils.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <sstream>
+
+using namespace VolcengineTos;
+
+namespace {
+const size_t epochSlots = 1024;
+const size_t maxUncacheable = 1024;
+
+// cacheKey 去掉 versionId 的部分，invalidateObject 失效所有版本，epoch 也按对象分槽
+size_t epochSlot(const std::string& cacheKey) {
+    auto pos = cacheKey.rfind('\n');
+    return std::hash<std::string>()(cacheKey.substr(0, pos)) % epochSlots;
+}
+}  // namespace
+
+ObjectCache::ObjectCache(const ObjectCacheOptions& options) : options_(options), epochs_(epochSlots, 0) {
+    if (options_.blockSize <= 0) {
+        options_.blockSize = ObjectCacheOptions().blockSize;
+    }
+    if (!options_.diskPath.empty()) {
+        if (options_.diskPath.back() != TOS_PATH_DELIMITER) {
+            options_.diskPath.push_back(TOS_PATH_DELIMITER);
+        }
+        if (!FileUtils::CreateDir(options_.diskPath, false)) {
+            options_.diskPath.clear();
+        }
+    }
+    // 同一目录可能被多个进程或多个 client 共用，文件名带上实例标识
+    std::stringstream ss;
+    ss << "tos_cache_" << std::hex << std::chrono::steady_clock::now().time_since_epoch().count() << "_"
+       << reinterpret_cast<uintptr_t>(this) << "_";
+    filePrefix_ = ss.str();
+}
+
+ObjectCache::~ObjectCache() {
+    clear();
+}
+
+std::string ObjectCache::CacheKey(const std::string& bucket, const std::string& key, const std::string& versionId) {
+    std::string cacheKey;
+    cacheKey.reserve(bucket.size() + key.size() + versionId.size() + 2);
+    cacheKey.append(bucket).append(1, '\n').append(key).append(1, '\n').append(versionId);
+    return cacheKey;
+}
+
+std::string ObjectCache::blockPath(uint64_t id, int64_t index) const {
+    return options_.diskPath + filePrefix_ + std::to_string(id) + "_" + std::to_string(index);
+}
+
+bool ObjectCache::isFresh(const Entry& entry) const {
+    if (options_.ttl <= 0) {
+        return false;
+    }
+    return std::chrono::steady_clock::now() - entry.validatedAt < std::chrono::seconds(options_.ttl);
+}
+
+bool ObjectCache::admits(int64_t size) const {
+    if (size < 0) {
+        return false;
+    }
+    if (size <= options_.memoryObjectLimit && options_.memoryCapacity > 0) {
+        return true;
+    }
+    return !options_.diskPath.empty() && options_.diskCapacity > 0;
+}
+
+uint64_t& ObjectCache::epochLocked(const std::string& cacheKey) {
+    return epochs_[epochSlot(cacheKey)];
+}
+
+uint64_t ObjectCache::epoch(const std::string& cacheKey) const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return epochs_[epochSlot(cacheKey)];
+}
+
+void ObjectCache::markUncacheable(const std::string& cacheKey) {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (!uncacheable_.insert(cacheKey).second) {
+        return;
+    }
+    uncacheableOrder_.push_back(cacheKey);
+    while (uncacheableOrder_.size() > maxUncacheable) {
+        uncacheable_.erase(uncacheableOrder_.front());
+        uncacheableOrder_.pop_front();
+    }
+}
+
+bool ObjectCache::uncacheable(const std::string& cacheKey) const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return uncacheable_.count(cacheKey) != 0;
+}
+
+bool ObjectCache::getMeta(const std::string& cacheKey, CachedObjectMeta& meta, bool& fresh) {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = entries_.find(cacheKey);
+    if (it == entries_.end()) {
+        return false;
+    }
+    meta = it->second.meta;
+    fresh = isFresh(it->second);
+    return true;
+}
+
+void ObjectCache::markValidated(const std::string& cacheKey) {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = entries_.find(cacheKey);
+    if (it != entries_.end()) {
+        it->second.validatedAt = std::chrono::steady_clock::now();
+    }
+}
+
+bool ObjectCache::missingBlocks(const std::string& cacheKey, int64_t start, int64_t end, int64_t& firstBlock,
+                                int64_t& lastBlock) {
+    int64_t b0 = start / options_.blockSize;
+    int64_t b1 = end / options_.blockSize;
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = entries_.find(cacheKey);
+    if (it == entries_.end()) {
+        firstBlock = b0;
+        lastBlock = b1;
+        return true;
+    }
+    firstBlock = -1;
+    lastBlock = -1;
+    for (int64_t i = b0; i <= b1; i++) {
+        if (it->second.blocks.count(i) == 0) {
+            if (firstBlock < 0) {
+                firstBlock = i;
+            }
+            lastBlock = i;
+        }
+    }
+    return firstBlock >= 0;
+}
+
+bool ObjectCache::read(const std::string& cacheKey, int64_t start, int64_t end, std::string& out) {
+    out.clear();
+    int64_t bs = options_.blockSize;
+    std::vector<std::string> paths;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        auto it = entries_.find(cacheKey);
+        if (it == entries_.end()) {
+            return false;
+        }
+        if (end < start) {
+            return true;
+        }
+        auto& entry = it->second;
+        for (int64_t i = start / bs; i <= end / bs; i++) {
+            if (entry.blocks.count(i) == 0) {
+                return false;
+            }
+        }
+        out.reserve(end - start + 1);
+        auto& lru = entry.onDisk ? diskLru_ : memoryLru_;
+        for (int64_t i = start / bs; i <= end / bs; i++) {
+            auto block = entry.blocks[i];
+            lru.splice(lru.begin(), lru, block);
+            if (entry.onDisk) {
+                paths.push_back(block->path);
+                continue;
+            }
+            int64_t from = std::max(start, i * bs) - i * bs;
+            int64_t to = std::min(end, i * bs + block->size - 1) - i * bs;
+            out.append(block->data, from, to - from + 1);
+        }
+    }
+    if (paths.empty()) {
+        return true;
+    }
+    // 磁盘块在锁外读取，文件已被淘汰时按未命中处理
+    int64_t first = start / bs;
+    for (size_t n = 0; n < paths.size(); n++) {
+        int64_t i = first + static_cast<int64_t>(n);
+        int64_t from = std::max(start, i * bs) - i * bs;
+        int64_t to = std::min(end, i * bs + bs - 1) - i * bs;
+        std::ifstream f(paths[n], std::ios::in | std::ios::binary);
+        if (!f.good()) {
+            out.clear();
+            return false;
+        }
+        f.seekg(from);
+        std::string buf(static_cast<size_t>(to - from + 1), '\0');
+        f.read(&buf[0], static_cast<std::streamsize>(buf.size()));
+        if (f.gcount() != static_cast<std::streamsize>(buf.size())) {
+            out.clear();
+            return false;
+        }
+        out.append(buf);
+    }
+    return true;
+}
+
+void ObjectCache::put(const std::string& cacheKey, const CachedObjectMeta& meta, int64_t offset,
+                      const std::string& data, uint64_t epoch) {
+    int64_t bs = options_.blockSize;
+    if (offset < 0 || !admits(meta.size)) {
+        return;
+    }
+    bool onDisk = meta.size > options_.memoryObjectLimit || options_.memoryCapacity <= 0;
+    uint64_t id = 0;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        // 读取期间对象被本 client 写过，数据可能是写之前的版本
+        if (epochLocked(cacheKey) != epoch) {
+            return;
+        }
+        auto it = entries_.find(cacheKey);
+        if (it != entries_.end() && (it->second.meta.etag != meta.etag || it->second.meta.size != meta.size)) {
+            eraseEntryLocked(it);
+            it = entries_.end();
+        }
+        if (it == entries_.end()) {
+            Entry entry;
+            entry.meta = meta;
+            entry.id = nextId_++;
+            entry.onDisk = onDisk;
+            entry.validatedAt = std::chrono::steady_clock::now();
+            it = entries_.emplace(cacheKey, entry).first;
+        }
+        id = it->second.id;
+        onDisk = it->second.onDisk;
+    }
+
+    int64_t capacity = onDisk ? options_.diskCapacity : options_.memoryCapacity;
+    std::vector<Block> blocks;
+    // offset 未对齐时跳过开头不完整的块
+    int64_t skip = (bs - offset % bs) % bs;
+    for (int64_t pos = skip; pos < static_cast<int64_t>(data.size()); pos += bs) {
+        int64_t len = std::min<int64_t>(bs, static_cast<int64_t>(data.size()) - pos);
+        // 只保存完整的块，或者对象的最后一块
+        if (len != bs && offset + pos + len != meta.size) {
+            continue;
+        }
+        if (len > capacity) {
+            continue;
+        }
+        Block block;
+        block.cacheKey = cacheKey;
+        block.index = (offset + pos) / bs;
+        block.size = len;
+        block.onDisk = onDisk;
+        if (onDisk) {
+            // 先写临时文件再 rename，避免并发读到写了一半的块
+            block.path = blockPath(id, block.index);
+            auto tmpPath = block.path + ".tmp" + std::to_string(tmpSeq_.fetch_add(1));
+            std::ofstream f(tmpPath, std::ios::out | std::ios::binary | std::ios::trunc);
+            f.write(data.data() + pos, len);
+            f.close();
+            if (!f.good() || std::rename(tmpPath.c_str(), block.path.c_str()) != 0) {
+                std::remove(tmpPath.c_str());
+                continue;
+            }
+        } else {
+            block.data = data.substr(pos, len);
+        }
+        blocks.push_back(std::move(block));
+    }
+    // 0 字节对象没有块，用一个空块表示完整
+    if (meta.size == 0 && offset == 0) {
+        Block block;
+        block.cacheKey = cacheKey;
+        blocks.push_back(std::move(block));
+    }
+
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = entries_.find(cacheKey);
+    if (it == entries_.end() || it->second.id != id) {
+        // 写入期间缓存项已被失效或替换
+        for (auto& block : blocks) {
+            if (block.onDisk) {
+                std::remove(block.path.c_str());
+            }
+        }
+        return;
+    }
+    auto& entry = it->second;
+    auto& lru = onDisk ? diskLru_ : memoryLru_;
+    auto& bytes = onDisk ? diskBytes_ : memoryBytes_;
+    for (auto& block : blocks) {
+        if (entry.blocks.count(block.index) != 0) {
+            // 同一块已由其他线程写入，文件名相同不需要删除
+            continue;
+        }
+        bytes += block.size;
+        lru.push_front(std::move(block));
+        entry.blocks[lru.front().index] = lru.begin();
+    }
+    if (entry.blocks.empty()) {
+        entries_.erase(it);
+        return;
+    }
+    evictLocked(onDisk);
+}
+
+void ObjectCache::eraseBlockLocked(Entry& entry, BlockIter block) {
+    auto& lru = block->onDisk ? diskLru_ : memoryLru_;
+    auto& bytes = block->onDisk ? diskBytes_ : memoryBytes_;
+    bytes -= block->size;
+    if (block->onDisk) {
+        std::remove(block->path.c_str());
+    }
+    entry.blocks.erase(block->index);
+    lru.erase(block);
+}
+
+void ObjectCache::eraseEntryLocked(std::map<std::string, Entry>::iterator it) {
+    while (!it->second.blocks.empty()) {
+        eraseBlockLocked(it->second, it->second.blocks.begin()->second);
+    }
+    entries_.erase(it);
+}
+
+void ObjectCache::evictLocked(bool onDisk) {
+    auto& lru = onDisk ? diskLru_ : memoryLru_;
+    auto& bytes = onDisk ? diskBytes_ : memoryBytes_;
+    auto capacity = onDisk ? options_.diskCapacity : options_.memoryCapacity;
+    while (bytes > capacity && !lru.empty()) {
+        auto block = std::prev(lru.end());
+        auto it = entries_.find(block->cacheKey);
+        if (it == entries_.end()) {
+            bytes -= block->size;
+            lru.erase(block);
+            continue;
+        }
+        eraseBlockLocked(it->second, block);
+        evictions_.fetch_add(1, std::memory_order_relaxed);
+        if (it->second.blocks.empty()) {
+            entries_.erase(it);
+        }
+    }
+}
+
+void ObjectCache::invalidate(const std::string& cacheKey) {
+    std::lock_guard<std::mutex> lock(mu_);
+    epochLocked(cacheKey)++;
+    auto it = entries_.find(cacheKey);
+    if (it != entries_.end()) {
+        eraseEntryLocked(it);
+        invalidations_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void ObjectCache::invalidateObject(const std::string& bucket, const std::string& key) {
+    auto prefix = CacheKey(bucket, key, "");
+    std::lock_guard<std::mutex> lock(mu_);
+    // 在锁内增加 epoch，保证与 put 的检查互斥
+    epochLocked(prefix)++;
+    auto u = uncacheable_.lower_bound(prefix);
+    while (u != uncacheable_.end() && u->compare(0, prefix.size(), prefix) == 0) {
+        uncacheableOrder_.remove(*u);
+        u = uncacheable_.erase(u);
+    }
+    auto it = entries_.lower_bound(prefix);
+    while (it != entries_.end() && it->first.compare(0, prefix.size(), prefix) == 0) {
+        auto next = std::next(it);
+        eraseEntryLocked(it);
+        invalidations_.fetch_add(1, std::memory_order_relaxed);
+        it = next;
+    }
+}
+
+void ObjectCache::clear() {
+    std::lock_guard<std::mutex> lock(mu_);
+    for (auto& epoch : epochs_) {
+        epoch++;
+    }
+    uncacheable_.clear();
+    uncacheableOrder_.clear();
+    while (!entries_.empty()) {
+        eraseEntryLocked(entries_.begin());
+    }
+}
+
+void ObjectCache::recordHit(uint64_t bytes) {
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    hitBytes_.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void ObjectCache::recordMiss() {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ObjectCache::recordRevalidation() {
+    revalidations_.fetch_add(1, std::memory_order_relaxed);
+}
+
+ObjectCacheStats ObjectCache::stats() const {
+    ObjectCacheStats s;
+    s.hits = hits_.load(std::memory_order_relaxed);
+    s.misses = misses_.load(std::memory_order_relaxed);
+    s.revalidations = revalidations_.load(std::memory_order_relaxed);
+    s.invalidations = invalidations_.load(std::memory_order_relaxed);
+    s.evictions = evictions_.load(std::memory_order_relaxed);
+    s.hitBytes = hitBytes_.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mu_);
+    s.memoryBytes = memoryBytes_;
+    s.diskBytes = diskBytes_;
+    s.entries = entries_.size();
+    return s;
+}
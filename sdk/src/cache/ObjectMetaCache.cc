@@ -0,0 +1,96 @@
+#include "cache/ObjectMetaCache.h"
+#include "cache/ObjectCache.h"
+
+using namespace VolcengineTos;
+
+ObjectMetaCache::ObjectMetaCache(const ObjectMetaCacheOptions& options) : options_(options) {
+}
+
+bool ObjectMetaCache::get(const std::string& cacheKey, Outcome<TosError, HeadObjectV2Output>& result) {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = entries_.find(cacheKey);
+    if (it == entries_.end()) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    if (std::chrono::steady_clock::now() >= it->second.expireAt) {
+        eraseLocked(it);
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second.lru);
+    result = it->second.result;
+    if (result.isSuccess()) {
+        hits_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        negativeHits_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+void ObjectMetaCache::put(const std::string& cacheKey, const Outcome<TosError, HeadObjectV2Output>& result,
+                          uint64_t epoch) {
+    int ttl = 0;
+    if (result.isSuccess()) {
+        ttl = options_.ttl;
+    } else if (result.error().getStatusCode() == 404) {
+        ttl = options_.negativeTtl;
+    }
+    if (ttl <= 0 || options_.maxEntries == 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mu_);
+    if (epoch != epoch_.load()) {
+        return;
+    }
+    auto it = entries_.find(cacheKey);
+    if (it != entries_.end()) {
+        eraseLocked(it);
+    }
+    lru_.push_front(cacheKey);
+    Entry entry;
+    entry.result = result;
+    entry.expireAt = std::chrono::steady_clock::now() + std::chrono::seconds(ttl);
+    entry.lru = lru_.begin();
+    entries_.emplace(cacheKey, std::move(entry));
+    while (entries_.size() > options_.maxEntries) {
+        eraseLocked(entries_.find(lru_.back()));
+    }
+}
+
+void ObjectMetaCache::eraseLocked(std::map<std::string, Entry>::iterator it) {
+    lru_.erase(it->second.lru);
+    entries_.erase(it);
+}
+
+void ObjectMetaCache::invalidateObject(const std::string& bucket, const std::string& key) {
+    auto prefix = ObjectCache::CacheKey(bucket, key, "");
+    std::lock_guard<std::mutex> lock(mu_);
+    // 在锁内增加 epoch，保证与 put 的检查互斥
+    epoch_.fetch_add(1);
+    auto it = entries_.lower_bound(prefix);
+    while (it != entries_.end() && it->first.compare(0, prefix.size(), prefix) == 0) {
+        auto next = std::next(it);
+        eraseLocked(it);
+        invalidations_.fetch_add(1, std::memory_order_relaxed);
+        it = next;
+    }
+}
+
+void ObjectMetaCache::clear() {
+    std::lock_guard<std::mutex> lock(mu_);
+    epoch_.fetch_add(1);
+    entries_.clear();
+    lru_.clear();
+}
+
+ObjectMetaCacheStats ObjectMetaCache::stats() const {
+    ObjectMetaCacheStats s;
+    s.hits = hits_.load(std::memory_order_relaxed);
+    s.negativeHits = negativeHits_.load(std::memory_order_relaxed);
+    s.misses = misses_.load(std::memory_order_relaxed);
+    s.invalidations = invalidations_.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mu_);
+    s.entries = entries_.size();
+    return s;
+}
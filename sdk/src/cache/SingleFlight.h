@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace VolcengineTos {
+// 相同 key 的并发调用只有第一个真正执行 fn，其余调用等待并共享它的结果。
+// fn 返回后立即移除 key，之后的调用会重新执行，因此不会返回过期结果。
+template <typename T>
+class SingleFlight {
+public:
+    T run(const std::string& key, const std::function<T()>& fn) {
+        std::unique_lock<std::mutex> lock(mu_);
+        auto it = calls_.find(key);
+        if (it != calls_.end()) {
+            auto call = it->second;
+            lock.unlock();
+            shared_.fetch_add(1, std::memory_order_relaxed);
+            return call.get();
+        }
+        std::promise<T> promise;
+        calls_.emplace(key, promise.get_future().share());
+        lock.unlock();
+
+        // fn 抛出异常时也要移除 key，并把异常交给等待者，否则后续调用会一直拿到 broken_promise
+        CallGuard guard(this, key);
+        try {
+            T result = fn();
+            guard.release();
+            promise.set_value(result);
+            return result;
+        } catch (...) {
+            guard.release();
+            promise.set_exception(std::current_exception());
+            throw;
+        }
+    }
+
+    // 共享了其他调用结果的次数
+    uint64_t shared() const {
+        return shared_.load(std::memory_order_relaxed);
+    }
+
+private:
+    class CallGuard {
+    public:
+        CallGuard(SingleFlight* flight, const std::string& key) : flight_(flight), key_(key) {
+        }
+        ~CallGuard() {
+            release();
+        }
+        void release() {
+            if (flight_ != nullptr) {
+                std::lock_guard<std::mutex> lock(flight_->mu_);
+                flight_->calls_.erase(key_);
+                flight_ = nullptr;
+            }
+        }
+
+    private:
+        SingleFlight* flight_;
+        const std::string& key_;
+    };
+
+    std::mutex mu_;
+    std::map<std::string, std::shared_future<T>> calls_;
+    std::atomic<uint64_t> shared_{0};
+};
+}  // namespace VolcengineTos
@@ -0,0 +1,368 @@
+#include "metrics/Metrics.h"
+#include <sstream>
+
+using namespace VolcengineTos;
+
+static const char* phaseNames[MetricsPhaseNum] = {"pool_wait",  "dns",      "connect", "tls",
+                                                  "first_byte", "transfer", "http",    "request"};
+
+const char* VolcengineTos::MetricsPhaseName(MetricsPhase phase) {
+    if (phase < 0 || phase >= MetricsPhaseNum) {
+        return "";
+    }
+    return phaseNames[phase];
+}
+
+uint64_t HistogramSnapshot::percentile(double q) const {
+    if (count == 0) {
+        return 0;
+    }
+    if (q <= 0) {
+        q = 0;
+    }
+    if (q >= 1) {
+        return max;
+    }
+    auto target = static_cast<uint64_t>(q * count);
+    if (target == 0) {
+        target = 1;
+    }
+    uint64_t seen = 0;
+    for (const auto& bucket : buckets) {
+        seen += bucket.second;
+        if (seen >= target) {
+            return bucket.first < max ? bucket.first : max;
+        }
+    }
+    return max;
+}
+
+LatencyHistogram::LatencyHistogram() {
+    for (int i = 0; i < bucketNum; i++) {
+        counts_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+int LatencyHistogram::bucketIndex(uint64_t micros) {
+    if (micros < static_cast<uint64_t>(subBucketCount)) {
+        return static_cast<int>(micros);
+    }
+    int exponent = 63;
+    while (((micros >> exponent) & 1) == 0) {
+        exponent--;
+    }
+    if (exponent > maxExponent) {
+        return bucketNum - 1;
+    }
+    int sub = static_cast<int>((micros >> (exponent - subBucketBits)) & (subBucketCount - 1));
+    return subBucketCount + (exponent - subBucketBits) * subBucketCount + sub;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(int index) {
+    if (index < subBucketCount) {
+        return index;
+    }
+    int shift = (index - subBucketCount) / subBucketCount;
+    uint64_t sub = (index - subBucketCount) % subBucketCount;
+    return ((subBucketCount + sub + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t micros) {
+    counts_[bucketIndex(micros)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(micros, std::memory_order_relaxed);
+    uint64_t current = max_.load(std::memory_order_relaxed);
+    while (micros > current && !max_.compare_exchange_weak(current, micros, std::memory_order_relaxed)) {
+    }
+}
+
+HistogramSnapshot LatencyHistogram::snapshot() const {
+    HistogramSnapshot snapshot;
+    snapshot.count = count_.load(std::memory_order_relaxed);
+    snapshot.sum = sum_.load(std::memory_order_relaxed);
+    snapshot.max = max_.load(std::memory_order_relaxed);
+    for (int i = 0; i < bucketNum; i++) {
+        uint64_t c = counts_[i].load(std::memory_order_relaxed);
+        if (c > 0) {
+            snapshot.buckets.emplace_back(bucketUpperBound(i), c);
+        }
+    }
+    return snapshot;
+}
+
+std::shared_ptr<OperationMetrics> MetricsRegistry::operation(const std::string& funcName) {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = operations_.find(funcName);
+    if (it != operations_.end()) {
+        return it->second;
+    }
+    auto op = std::make_shared<OperationMetrics>();
+    operations_[funcName] = op;
+    return op;
+}
+
+void MetricsRegistry::recordLatency(const std::string& funcName, MetricsPhase phase, uint64_t micros) {
+    operation(funcName)->recordLatency(phase, micros);
+}
+
+void MetricsRegistry::recordRequest(const std::string& funcName, bool success, int retries) {
+    operation(funcName)->recordRequest(success, retries);
+}
+
+void MetricsRegistry::recordBytes(const std::string& funcName, uint64_t sent, uint64_t received) {
+    operation(funcName)->recordBytes(sent, received);
+}
+
+void MetricsRegistry::recordAddressConnect(const std::string& host, const std::string& address, bool success,
+                                           uint64_t micros) {
+    std::shared_ptr<AddressMetrics> metrics;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        auto& m = addresses_[std::make_pair(host, address)];
+        if (m == nullptr) {
+            m = std::make_shared<AddressMetrics>();
+        }
+        metrics = m;
+    }
+    if (success) {
+        metrics->connects_.fetch_add(1, std::memory_order_relaxed);
+        metrics->connectLatency_.record(micros);
+    } else {
+        metrics->connectFailures_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+std::shared_ptr<EndpointMetrics> MetricsRegistry::endpoint(const std::string& endpoint) {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto& m = endpoints_[endpoint];
+    if (m == nullptr) {
+        m = std::make_shared<EndpointMetrics>();
+    }
+    return m;
+}
+
+void MetricsRegistry::recordEndpointProbe(const std::string& endpoint, bool success, uint64_t micros) {
+    auto metrics = this->endpoint(endpoint);
+    if (success) {
+        metrics->probeLatency_.record(micros);
+    } else {
+        metrics->failures_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void MetricsRegistry::recordEndpointFailure(const std::string& endpoint) {
+    this->endpoint(endpoint)->failures_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MetricsRegistry::recordEndpointSwitch(const std::string& endpoint) {
+    this->endpoint(endpoint)->switches_.fetch_add(1, std::memory_order_relaxed);
+}
+
+MetricsSnapshot MetricsRegistry::snapshot() const {
+    MetricsSnapshot snapshot;
+    std::map<std::string, std::shared_ptr<OperationMetrics>> operations;
+    std::map<std::pair<std::string, std::string>, std::shared_ptr<AddressMetrics>> addresses;
+    std::map<std::string, std::shared_ptr<EndpointMetrics>> endpoints;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        operations = operations_;
+        addresses = addresses_;
+        endpoints = endpoints_;
+    }
+    for (const auto& op : operations) {
+        OperationMetricsSnapshot s;
+        s.funcName = op.first;
+        s.requests = op.second->requests_.load(std::memory_order_relaxed);
+        s.retries = op.second->retries_.load(std::memory_order_relaxed);
+        s.errors = op.second->errors_.load(std::memory_order_relaxed);
+        s.bytesSent = op.second->bytesSent_.load(std::memory_order_relaxed);
+        s.bytesReceived = op.second->bytesReceived_.load(std::memory_order_relaxed);
+        for (int i = 0; i < MetricsPhaseNum; i++) {
+            auto h = op.second->latency_[i].snapshot();
+            if (h.count > 0) {
+                s.latency[MetricsPhaseName(static_cast<MetricsPhase>(i))] = h;
+            }
+        }
+        snapshot.operations.push_back(s);
+    }
+    for (const auto& address : addresses) {
+        AddressMetricsSnapshot s;
+        s.host = address.first.first;
+        s.address = address.first.second;
+        s.connects = address.second->connects_.load(std::memory_order_relaxed);
+        s.connectFailures = address.second->connectFailures_.load(std::memory_order_relaxed);
+        s.connectLatency = address.second->connectLatency_.snapshot();
+        snapshot.addresses.push_back(s);
+    }
+    for (const auto& endpoint : endpoints) {
+        EndpointMetricsSnapshot s;
+        s.endpoint = endpoint.first;
+        s.switches = endpoint.second->switches_.load(std::memory_order_relaxed);
+        s.failures = endpoint.second->failures_.load(std::memory_order_relaxed);
+        s.probeLatency = endpoint.second->probeLatency_.snapshot();
+        snapshot.endpoints.push_back(s);
+    }
+    snapshot.stragglerRestarts = stragglerRestarts_.load(std::memory_order_relaxed);
+    snapshot.stragglerDuplicates = stragglerDuplicates_.load(std::memory_order_relaxed);
+    snapshot.partRetries = partRetries_.load(std::memory_order_relaxed);
+    snapshot.poolSize = poolSize_.load(std::memory_order_relaxed);
+    snapshot.poolInUse = poolInUse_.load(std::memory_order_relaxed);
+    snapshot.poolWaiting = poolWaiting_.load(std::memory_order_relaxed);
+    snapshot.poolWait = poolWait_.snapshot();
+    return snapshot;
+}
+
+void MetricsRegistry::reset() {
+    std::lock_guard<std::mutex> lock(mu_);
+    operations_.clear();
+    addresses_.clear();
+    endpoints_.clear();
+    stragglerRestarts_.store(0, std::memory_order_relaxed);
+    stragglerDuplicates_.store(0, std::memory_order_relaxed);
+    partRetries_.store(0, std::memory_order_relaxed);
+}
+
+void MetricsRegistry::addExporter(const std::shared_ptr<MetricsExporter>& exporter) {
+    if (exporter == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mu_);
+    exporters_.push_back(exporter);
+}
+
+void MetricsRegistry::flush() {
+    std::vector<std::shared_ptr<MetricsExporter>> exporters;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        exporters = exporters_;
+    }
+    if (exporters.empty()) {
+        return;
+    }
+    auto s = snapshot();
+    for (const auto& exporter : exporters) {
+        exporter->exportMetrics(s);
+    }
+}
+
+// Prometheus 输出固定的 le 集合（微秒），每次抓取的序列一致。le 取这些数值所在内部桶的上界，
+// 每个内部桶整体不大于或整体大于 le，累计计数是精确的
+static const uint64_t prometheusBucketValues[] = {100,     250,     500,     1000,     2500,     5000,
+                                                  10000,   25000,   50000,   100000,   250000,   500000,
+                                                  1000000, 2500000, 5000000, 10000000, 30000000, 60000000};
+
+static const std::vector<uint64_t>& prometheusBuckets() {
+    static const std::vector<uint64_t> buckets = []() {
+        std::vector<uint64_t> edges;
+        for (auto v : prometheusBucketValues) {
+            edges.push_back(LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketIndex(v)));
+        }
+        return edges;
+    }();
+    return buckets;
+}
+
+static void writeHistogram(std::stringstream& ss, const std::string& name, const std::string& labels,
+                           const HistogramSnapshot& h) {
+    std::string prefix = labels.empty() ? "" : labels + ",";
+    std::string suffix = labels.empty() ? "" : "{" + labels + "}";
+    uint64_t cumulative = 0;
+    size_t next = 0;
+    for (auto le : prometheusBuckets()) {
+        while (next < h.buckets.size() && h.buckets[next].first <= le) {
+            cumulative += h.buckets[next].second;
+            next++;
+        }
+        ss << name << "_bucket{" << prefix << "le=\"" << le << "\"} " << cumulative << "\n";
+    }
+    ss << name << "_bucket{" << prefix << "le=\"+Inf\"} " << h.count << "\n";
+    ss << name << "_sum" << suffix << " " << h.sum << "\n";
+    ss << name << "_count" << suffix << " " << h.count << "\n";
+}
+
+std::string PrometheusTextExporter::format(const MetricsSnapshot& snapshot) {
+    std::stringstream ss;
+    const std::string latencyName = "tos_sdk_request_duration_microseconds";
+    ss << "# HELP " << latencyName << " TOS SDK request latency by operation and phase.\n";
+    ss << "# TYPE " << latencyName << " histogram\n";
+    for (const auto& op : snapshot.operations) {
+        for (const auto& phase : op.latency) {
+            writeHistogram(ss, latencyName, "operation=\"" + op.funcName + "\",phase=\"" + phase.first + "\"",
+                           phase.second);
+        }
+    }
+
+    const std::vector<std::pair<std::string, uint64_t OperationMetricsSnapshot::*>> counters = {
+            {"tos_sdk_requests_total", &OperationMetricsSnapshot::requests},
+            {"tos_sdk_retries_total", &OperationMetricsSnapshot::retries},
+            {"tos_sdk_errors_total", &OperationMetricsSnapshot::errors},
+            {"tos_sdk_sent_bytes_total", &OperationMetricsSnapshot::bytesSent},
+            {"tos_sdk_received_bytes_total", &OperationMetricsSnapshot::bytesReceived}};
+    for (const auto& counter : counters) {
+        ss << "# TYPE " << counter.first << " counter\n";
+        for (const auto& op : snapshot.operations) {
+            ss << counter.first << "{operation=\"" << op.funcName << "\"} " << op.*(counter.second) << "\n";
+        }
+    }
+
+    if (!snapshot.addresses.empty()) {
+        ss << "# TYPE tos_sdk_address_connects_total counter\n";
+        for (const auto& a : snapshot.addresses) {
+            ss << "tos_sdk_address_connects_total{host=\"" << a.host << "\",address=\"" << a.address << "\"} "
+               << a.connects << "\n";
+        }
+        ss << "# TYPE tos_sdk_address_connect_failures_total counter\n";
+        for (const auto& a : snapshot.addresses) {
+            ss << "tos_sdk_address_connect_failures_total{host=\"" << a.host << "\",address=\"" << a.address
+               << "\"} " << a.connectFailures << "\n";
+        }
+        ss << "# TYPE tos_sdk_address_connect_duration_microseconds histogram\n";
+        for (const auto& a : snapshot.addresses) {
+            writeHistogram(ss, "tos_sdk_address_connect_duration_microseconds",
+                           "host=\"" + a.host + "\",address=\"" + a.address + "\"", a.connectLatency);
+        }
+    }
+
+    if (!snapshot.endpoints.empty()) {
+        ss << "# TYPE tos_sdk_endpoint_switches_total counter\n";
+        for (const auto& e : snapshot.endpoints) {
+            ss << "tos_sdk_endpoint_switches_total{endpoint=\"" << e.endpoint << "\"} " << e.switches << "\n";
+        }
+        ss << "# TYPE tos_sdk_endpoint_failures_total counter\n";
+        for (const auto& e : snapshot.endpoints) {
+            ss << "tos_sdk_endpoint_failures_total{endpoint=\"" << e.endpoint << "\"} " << e.failures << "\n";
+        }
+        ss << "# TYPE tos_sdk_endpoint_probe_duration_microseconds histogram\n";
+        for (const auto& e : snapshot.endpoints) {
+            writeHistogram(ss, "tos_sdk_endpoint_probe_duration_microseconds", "endpoint=\"" + e.endpoint + "\"",
+                           e.probeLatency);
+        }
+    }
+
+    ss << "# TYPE tos_sdk_straggler_restarts_total counter\n";
+    ss << "tos_sdk_straggler_restarts_total " << snapshot.stragglerRestarts << "\n";
+    ss << "# TYPE tos_sdk_straggler_duplicates_total counter\n";
+    ss << "tos_sdk_straggler_duplicates_total " << snapshot.stragglerDuplicates << "\n";
+    ss << "# TYPE tos_sdk_part_retries_total counter\n";
+    ss << "tos_sdk_part_retries_total " << snapshot.partRetries << "\n";
+    ss << "# TYPE tos_sdk_connection_pool_size gauge\n";
+    ss << "tos_sdk_connection_pool_size " << snapshot.poolSize << "\n";
+    ss << "# TYPE tos_sdk_connection_pool_in_use gauge\n";
+    ss << "tos_sdk_connection_pool_in_use " << snapshot.poolInUse << "\n";
+    ss << "# TYPE tos_sdk_connection_pool_waiting gauge\n";
+    ss << "tos_sdk_connection_pool_waiting " << snapshot.poolWaiting << "\n";
+    ss << "# TYPE tos_sdk_connection_pool_wait_microseconds histogram\n";
+    writeHistogram(ss, "tos_sdk_connection_pool_wait_microseconds", "", snapshot.poolWait);
+    return ss.str();
+}
+
+void PrometheusTextExporter::exportMetrics(const MetricsSnapshot& snapshot) {
+    auto text = format(snapshot);
+    std::lock_guard<std::mutex> lock(mu_);
+    text_ = text;
+}
+
+std::string PrometheusTextExporter::getText() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return text_;
+}
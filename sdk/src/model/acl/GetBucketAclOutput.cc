@@ -13,12 +13,12 @@ void VolcengineTos::GetBucketAclOutput::fromJsonString(const std::string& input)
             owner_.setDisplayName(j.at("Owner").at("DisplayName").get<std::string>());
         }
     }
-    nlohmann::json grants = j.at("Grants");
+    const auto& grants = j.at("Grants");
     for (auto& grant : grants) {
         GrantV2 g;
         GranteeV2 ge;
         if (grant.contains("Grantee")) {
-            auto grantee = grant.at("Grantee");
+            const auto& grantee = grant.at("Grantee");
             if (grantee.contains("ID"))
                 ge.setId(grantee.at("ID").get<std::string>());
             if (grantee.contains("DisplayName"))
@@ -31,6 +31,6 @@ void VolcengineTos::GetBucketAclOutput::fromJsonString(const std::string& input)
         g.setGrantee(ge);
         if (grant.contains("Permission"))
             g.setPermission(StringtoPermissionType[grant.at("Permission").get<std::string>()]);
-        grant_.emplace_back(g);
+        grant_.emplace_back(std::move(g));
     }
 }
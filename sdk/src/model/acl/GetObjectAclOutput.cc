@@ -14,12 +14,12 @@ void VolcengineTos::GetObjectAclOutput::fromJsonString(const std::string& input)
             owner_.setDisplayName(j.at("Owner").at("DisplayName").get<std::string>());
         }
     }
-    json grants = j.at("Grants");
+    const auto& grants = j.at("Grants");
     for (auto& grant : grants) {
         Grant g;
         Grantee ge;
         if (grant.contains("Grantee")) {
-            auto grantee = grant.at("Grantee");
+            const auto& grantee = grant.at("Grantee");
             if (grantee.contains("ID"))
                 ge.setId(grantee.at("ID").get<std::string>());
             if (grantee.contains("DisplayName"))
@@ -32,6 +32,6 @@ void VolcengineTos::GetObjectAclOutput::fromJsonString(const std::string& input)
         g.setGrantee(ge);
         if (grant.contains("Permission"))
             g.setPermission(grant.at("Permission").get<std::string>());
-        grant_.emplace_back(g);
+        grant_.emplace_back(std::move(g));
     }
 }
@@ -16,12 +16,12 @@ void VolcengineTos::GetObjectAclV2Output::fromJsonString(const std::string& inpu
     if (j.contains("BucketOwnerEntrusted")) {
         setBucketOwnerEntrusted(j.at("BucketOwnerEntrusted").get<bool>());
     }
-    json grants = j.at("Grants");
+    const auto& grants = j.at("Grants");
     for (auto& grant : grants) {
         GrantV2 g;
         GranteeV2 ge;
         if (grant.contains("Grantee")) {
-            auto grantee = grant.at("Grantee");
+            const auto& grantee = grant.at("Grantee");
             if (grantee.contains("ID"))
                 ge.setId(grantee.at("ID").get<std::string>());
             if (grantee.contains("DisplayName"))
@@ -34,6 +34,6 @@ void VolcengineTos::GetObjectAclV2Output::fromJsonString(const std::string& inpu
         g.setGrantee(ge);
         if (grant.contains("Permission"))
             g.setPermission(StringtoPermissionType[grant.at("Permission").get<std::string>()]);
-        grant_.emplace_back(g);
+        grant_.emplace_back(std::move(g));
     }
 }
@@ -21,7 +21,7 @@ std::string VolcengineTos::ObjectAclRules::toJsonString() {
             grant["Grantee"]["Canned"] = g.getGrantee().getUri();
         if (!g.getPermission().empty())
             grant["Permission"] = g.getPermission();
-        grantArray.push_back(grant);
+        grantArray.push_back(std::move(grant));
     }
     if (!grantArray.empty())
         j["Grants"] = grantArray;
@@ -9,7 +9,7 @@ std::string VolcengineTos::PolicyURLInner::toJsonString() const {
         if (condition.getAnOperator() != nullptr) {
             std::vector<std::string> temp = {*condition.getAnOperator(), condition.getKey(), condition.getValue()};
             nlohmann::json arrayJson(temp);
-            jsonConditons.emplace_back(arrayJson);
+            jsonConditons.emplace_back(std::move(arrayJson));
 
         } else {
             tempJson[condition.getKey()] = condition.getValue();
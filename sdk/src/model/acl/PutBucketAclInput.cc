@@ -24,7 +24,7 @@ std::string VolcengineTos::PutBucketAclInput::toJsonString() const {
         auto permission_ = PermissionTypetoString[g.getPermission()];
         if (!permission_.empty())
             grant["Permission"] = permission_;
-        grantArray.push_back(grant);
+        grantArray.push_back(std::move(grant));
     }
     if (!grantArray.empty())
         j["Grants"] = grantArray;
@@ -4,7 +4,7 @@
 void VolcengineTos::GetBucketCORSOutput::fromJsonString(const std::string& input) {
     auto j = nlohmann::json::parse(input);
     if (j.contains("CORSRules")) {
-        nlohmann::json rules = j.at("CORSRules");
+        const auto& rules = j.at("CORSRules");
         for (auto& r : rules) {
             CORSRule rule;
             int maxAgeSeconds_ = 0;
@@ -23,7 +23,7 @@ void VolcengineTos::GetBucketCORSOutput::fromJsonString(const std::string& input
             if (r.contains("MaxAgeSeconds")) {
                 rule.setMaxAgeSeconds(r.at("MaxAgeSeconds").get<int>());
             }
-            rules_.push_back(rule);
+            rules_.push_back(std::move(rule));
         }
     }
 }
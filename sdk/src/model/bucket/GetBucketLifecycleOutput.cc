@@ -6,7 +6,7 @@
 void VolcengineTos::GetBucketLifecycleOutput::fromJsonString(const std::string& input) {
     auto j = nlohmann::json::parse(input);
     if (j.contains("Rules")) {
-        nlohmann::json rules = j.at("Rules");
+        const auto& rules = j.at("Rules");
         LifecycleRule rule_;
         for (auto& r : rules) {
             if (r.contains("ID")) {
@@ -20,7 +20,7 @@ void VolcengineTos::GetBucketLifecycleOutput::fromJsonString(const std::string&
                 rule_.setStatus(StringtoStatusType[prefix]);
             }
             if (r.contains("Transitions")) {
-                auto trans = r.at("Transitions");
+                const auto& trans = r.at("Transitions");
                 std::vector<Transition> transitions_;
                 for (auto& t : trans) {
                     Transition transition_;
@@ -33,12 +33,12 @@ void VolcengineTos::GetBucketLifecycleOutput::fromJsonString(const std::string&
                     if (t.contains("StorageClass")) {
                         transition_.setStorageClass(StringtoStorageClassType[t.at("StorageClass").get<std::string>()]);
                     }
-                    transitions_.emplace_back(transition_);
+                    transitions_.emplace_back(std::move(transition_));
                 }
                 rule_.setTransitions(transitions_);
             }
             if (r.contains("Expiration")) {
-                auto ex = r.at("Expiration");
+                const auto& ex = r.at("Expiration");
                 Expiration expiration_;
                 if (ex.contains("Date")) {
                     expiration_.setDate(TimeUtils::transLastModifiedStringToTime(ex.at("Date").get<std::string>()));
@@ -49,7 +49,7 @@ void VolcengineTos::GetBucketLifecycleOutput::fromJsonString(const std::string&
                 rule_.setExpiratioon(std::make_shared<Expiration>(expiration_));
             }
             if (r.contains("NoncurrentVersionTransitions")) {
-                auto ncvt = r.at("NoncurrentVersionTransitions");
+                const auto& ncvt = r.at("NoncurrentVersionTransitions");
                 std::vector<NoncurrentVersionTransition> noncurrentVersionTransitions_;
                 for (auto& t : ncvt) {
                     NoncurrentVersionTransition noncurrentVersionTransition_;
@@ -60,12 +60,12 @@ void VolcengineTos::GetBucketLifecycleOutput::fromJsonString(const std::string&
                         noncurrentVersionTransition_.setStorageClass(
                                 StringtoStorageClassType[t.at("StorageClass").get<std::string>()]);
                     }
-                    noncurrentVersionTransitions_.emplace_back(noncurrentVersionTransition_);
+                    noncurrentVersionTransitions_.emplace_back(std::move(noncurrentVersionTransition_));
                 }
                 rule_.setNoncurrentVersionTransitions(noncurrentVersionTransitions_);
             }
             if (r.contains("NoncurrentVersionExpiration")) {
-                auto ncve = r.at("Expiration");
+                const auto& ncve = r.at("Expiration");
                 NoncurrentVersionExpiration expiration_;
                 if (ncve.contains("NoncurrentDays")) {
                     expiration_.setNoncurrentDays(ncve.at("NoncurrentDays").get<int>());
@@ -73,7 +73,7 @@ void VolcengineTos::GetBucketLifecycleOutput::fromJsonString(const std::string&
                 rule_.setNoncurrentVersionExpiration(std::make_shared<NoncurrentVersionExpiration>(expiration_));
             }
             if (r.contains("Tags")) {
-                auto tags = r.at("Tags");
+                const auto& tags = r.at("Tags");
                 std::vector<Tag> tags_;
                 for (auto& t : tags) {
                     Tag tag_;
@@ -83,12 +83,12 @@ void VolcengineTos::GetBucketLifecycleOutput::fromJsonString(const std::string&
                     if (t.contains("Value")) {
                         tag_.setValue(t.at("Value").get<std::string>());
                     }
-                    tags_.emplace_back(tag_);
+                    tags_.emplace_back(std::move(tag_));
                 }
                 rule_.setTags(tags_);
             }
             if (r.contains("AbortIncompleteMultipartUpload")) {
-                auto aimu = r.at("AbortIncompleteMultipartUpload");
+                const auto& aimu = r.at("AbortIncompleteMultipartUpload");
                 AbortInCompleteMultipartUpload abortInCompleteMultipartUpload_;
                 if (aimu.contains("DaysAfterInitiation")) {
                     abortInCompleteMultipartUpload_.setDaysAfterInitiation(aimu.at("DaysAfterInitiation").get<int>());
@@ -6,14 +6,14 @@
 void VolcengineTos::GetBucketMirrorBackOutput::fromJsonString(const std::string& input) {
     auto j = nlohmann::json::parse(input);
     if (j.contains("Rules")) {
-        nlohmann::json rules = j.at("Rules");
+        const auto& rules = j.at("Rules");
         for (auto& r : rules) {
             MirrorBackRule rule_;
             if (r.contains("ID")) {
                 rule_.setId(r.at("ID").get<std::string>());
             }
             if (r.contains("Condition")) {
-                nlohmann::json condition = r.at("Condition");
+                const auto& condition = r.at("Condition");
                 Condition condition_;
                 if (condition.contains("HttpCode")) {
                     condition_.setHttpCode(condition.at("HttpCode").get<int>());
@@ -27,7 +27,7 @@ void VolcengineTos::GetBucketMirrorBackOutput::fromJsonString(const std::string&
                 rule_.setCondition(condition_);
             }
             if (r.contains("Redirect")) {
-                auto redirect = r.at("Redirect");
+                const auto& redirect = r.at("Redirect");
                 Redirect redirect_;
                 if (redirect.contains("RedirectType")) {
                     redirect_.setRedirectType(StringtoRedirectType[redirect.at("RedirectType").get<std::string>()]);
@@ -43,7 +43,7 @@ void VolcengineTos::GetBucketMirrorBackOutput::fromJsonString(const std::string&
                 }
                 if (redirect.contains("MirrorHeader")) {
                     MirrorHeader mirrorHeader_;
-                    auto mirrorHeader = redirect.at("MirrorHeader");
+                    const auto& mirrorHeader = redirect.at("MirrorHeader");
                     if (mirrorHeader.contains("PassAll")) {
                         mirrorHeader_.setPassAll(mirrorHeader.at("PassAll").get<bool>());
                     }
@@ -57,10 +57,10 @@ void VolcengineTos::GetBucketMirrorBackOutput::fromJsonString(const std::string&
                 }
                 if (redirect.contains("Transform")) {
                     Transform transform_;
-                    auto transform = redirect.at("Transform");
+                    const auto& transform = redirect.at("Transform");
                     if (transform.contains("ReplaceKeyPrefix")) {
                         ReplaceKeyPrefix replaceKeyPrefix_;
-                        auto ReplaceKeyPrefix = transform.at("ReplaceKeyPrefix");
+                        const auto& ReplaceKeyPrefix = transform.at("ReplaceKeyPrefix");
                         if (ReplaceKeyPrefix.contains("KeyPrefix")) {
                             replaceKeyPrefix_.setKeyPrefix(ReplaceKeyPrefix.at("KeyPrefix").get<std::string>());
                         }
@@ -78,11 +78,11 @@ void VolcengineTos::GetBucketMirrorBackOutput::fromJsonString(const std::string&
                     redirect_.setTransform(transform_);
                 }
                 if (redirect.contains("PublicSource")) {
-                    auto publicSource = redirect.at("PublicSource");
+                    const auto& publicSource = redirect.at("PublicSource");
                     PublicSource publicSource_;
                     if (publicSource.contains("SourceEndpoint")) {
                         SourceEndpoint sourceEndpoint_;
-                        auto sourceEndpoint = publicSource.at("SourceEndpoint");
+                        const auto& sourceEndpoint = publicSource.at("SourceEndpoint");
                         if (sourceEndpoint.contains("Primary")) {
                             sourceEndpoint_.setPrimary(sourceEndpoint.at("Primary").get<std::vector<std::string>>());
                         }
@@ -95,7 +95,7 @@ void VolcengineTos::GetBucketMirrorBackOutput::fromJsonString(const std::string&
                 }
                 rule_.setRedirect(redirect_);
             }
-            rules_.emplace_back(rule_);
+            rules_.emplace_back(std::move(rule_));
         }
     }
 }
@@ -4,7 +4,7 @@
 void VolcengineTos::GetBucketNotificationOutput::fromJsonString(const std::string& input) {
     auto j = nlohmann::json::parse(input);
     if (j.contains("CloudFunctionConfigurations")) {
-        nlohmann::json config = j.at("CloudFunctionConfigurations");
+        const auto& config = j.at("CloudFunctionConfigurations");
         CloudFunctionConfiguration cloudFunctionConfiguration;
         for (auto& r : config) {
             if (r.contains("RuleId")) {
@@ -17,14 +17,14 @@ void VolcengineTos::GetBucketNotificationOutput::fromJsonString(const std::strin
                 cloudFunctionConfiguration.setCloudFunction(r.at("CloudFunction").get<std::string>());
             }
             if (r.contains("Filter")) {
-                auto filter = r.at("Filter");
+                const auto& filter = r.at("Filter");
                 Filter filter_;
                 if (filter.contains("TOSKey")) {
-                    auto tosKey = filter.at("TOSKey");
+                    const auto& tosKey = filter.at("TOSKey");
                     FilterKey filterKey_;
                     std::vector<FilterRule> rules_;
                     if (tosKey.contains("FilterRules")) {
-                        auto rules = tosKey.at("FilterRules");
+                        const auto& rules = tosKey.at("FilterRules");
                         for (const auto& rule : rules) {
                             FilterRule rule_;
                             if (rule.contains("Name")) {
@@ -33,7 +33,7 @@ void VolcengineTos::GetBucketNotificationOutput::fromJsonString(const std::strin
                             if (rule.contains("Value")) {
                                 rule_.setValue(rule.at("Value").get<std::string>());
                             }
-                            rules_.emplace_back(rule_);
+                            rules_.emplace_back(std::move(rule_));
                         }
                     }
                     filterKey_.setRules(rules_);
@@ -45,7 +45,7 @@ void VolcengineTos::GetBucketNotificationOutput::fromJsonString(const std::strin
         }
     }
     if (j.contains("RocketMQConfigurations")) {
-        nlohmann::json config = j.at("RocketMQConfigurations");
+        const auto& config = j.at("RocketMQConfigurations");
         RocketMQConfiguration rocketMqConfiguration;
         for (auto& r : config) {
             if (r.contains("RuleId")) {
@@ -58,14 +58,14 @@ void VolcengineTos::GetBucketNotificationOutput::fromJsonString(const std::strin
                 rocketMqConfiguration.setRole(r.at("Role").get<std::string>());
             }
             if (r.contains("Filter")) {
-                auto filter = r.at("Filter");
+                const auto& filter = r.at("Filter");
                 Filter filter_;
                 if (filter.contains("TOSKey")) {
-                    auto tosKey = filter.at("TOSKey");
+                    const auto& tosKey = filter.at("TOSKey");
                     FilterKey filterKey_;
                     std::vector<FilterRule> rules_;
                     if (tosKey.contains("FilterRules")) {
-                        auto rules = tosKey.at("FilterRules");
+                        const auto& rules = tosKey.at("FilterRules");
                         for (const auto& rule : rules) {
                             FilterRule rule_;
                             if (rule.contains("Name")) {
@@ -74,7 +74,7 @@ void VolcengineTos::GetBucketNotificationOutput::fromJsonString(const std::strin
                             if (rule.contains("Value")) {
                                 rule_.setValue(rule.at("Value").get<std::string>());
                             }
-                            rules_.emplace_back(rule_);
+                            rules_.emplace_back(std::move(rule_));
                         }
                     }
                     filterKey_.setRules(rules_);
@@ -84,7 +84,7 @@ void VolcengineTos::GetBucketNotificationOutput::fromJsonString(const std::strin
             }
             if (r.contains("RocketMQ")) {
                 RocketMQConf rocketMqConf_;
-                auto rocketMqConf = r.at("RocketMQ");
+                const auto& rocketMqConf = r.at("RocketMQ");
                 if (rocketMqConf.contains("InstanceId")) {
                     rocketMqConf_.setInstanceId(rocketMqConf.at("InstanceId").get<std::string>());
                 }
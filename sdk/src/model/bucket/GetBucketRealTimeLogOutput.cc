@@ -4,12 +4,12 @@
 void VolcengineTos::GetBucketRealTimeLogOutput::fromJsonString(const std::string& input) {
     auto j = nlohmann::json::parse(input);
     if (j.contains("RealTimeLogConfiguration")) {
-        auto config = j.at("RealTimeLogConfiguration");
+        const auto& config = j.at("RealTimeLogConfiguration");
         if (config.contains("Role")) {
             configuration_.setRole(config.at("Role").get<std::string>());
         }
         if (config.contains("AccessLogConfiguration")) {
-            auto acc = config.at("AccessLogConfiguration");
+            const auto& acc = config.at("AccessLogConfiguration");
             AccessLogConfiguration config_;
             if (acc.contains("UseServiceTopic")) {
                 config_.setUseServiceTopic(acc.at("UseServiceTopic").get<bool>());
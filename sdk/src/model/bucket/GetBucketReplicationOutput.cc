@@ -5,7 +5,7 @@ using namespace nlohmann;
 void VolcengineTos::GetBucketReplicationOutput::fromJsonString(const std::string& input) {
     auto j = nlohmann::json::parse(input);
     if (j.contains("Rules")) {
-        nlohmann::json rules = j.at("Rules");
+        const auto& rules = j.at("Rules");
         ReplicationRule rule_;
         for (auto& r : rules) {
             if (r.contains("ID")) {
@@ -23,7 +23,7 @@ void VolcengineTos::GetBucketReplicationOutput::fromJsonString(const std::string
                 rule_.setHistoricalObjectReplication(StringtoStatusType[historicalObjectReplication]);
             }
             if (r.contains("Destination")) {
-                auto destination = r.at("Destination");
+                const auto& destination = r.at("Destination");
                 Destination destination_;
                 if (destination.contains("Bucket")) {
                     destination_.setBucket(destination.at("Bucket").get<std::string>());
@@ -43,7 +43,7 @@ void VolcengineTos::GetBucketReplicationOutput::fromJsonString(const std::string
                 rule_.setDestination(destination_);
             }
             if (r.contains("Progress")) {
-                auto progress = r.at("Progress");
+                const auto& progress = r.at("Progress");
                 Progress progress_;
                 if (progress.contains("HistoricalObject")) {
                     progress_.setHistoricalObject(progress.at("HistoricalObject").get<double>());
@@ -6,7 +6,7 @@ void VolcengineTos::GetBucketWebsiteOutput::fromJsonString(const std::string& in
     auto j = nlohmann::json::parse(input);
 
     if (j.contains("RedirectAllRequestsTo")) {
-        auto r = j.at("RedirectAllRequestsTo");
+        const auto& r = j.at("RedirectAllRequestsTo");
         RedirectAllRequestsTo redirectAllRequestsTo;
         if (r.contains("HostName")) {
             redirectAllRequestsTo.setHostName(r.at("HostName").get<std::string>());
@@ -17,7 +17,7 @@ void VolcengineTos::GetBucketWebsiteOutput::fromJsonString(const std::string& in
         redirectAllRequestsTo_ = std::make_shared<RedirectAllRequestsTo>(redirectAllRequestsTo);
     }
     if (j.contains("IndexDocument")) {
-        auto i = j.at("IndexDocument");
+        const auto& i = j.at("IndexDocument");
         IndexDocument indexDocument;
         if (i.contains("Suffix")) {
             indexDocument.setSuffix(i.at("Suffix").get<std::string>());
@@ -28,7 +28,7 @@ void VolcengineTos::GetBucketWebsiteOutput::fromJsonString(const std::string& in
         indexDocument_ = std::make_shared<IndexDocument>(indexDocument);
     }
     if (j.contains("ErrorDocument")) {
-        auto e = j.at("ErrorDocument");
+        const auto& e = j.at("ErrorDocument");
         ErrorDocument errorDocument;
         if (e.contains("Key")) {
             errorDocument.setKey(e.at("Key").get<std::string>());
@@ -36,12 +36,12 @@ void VolcengineTos::GetBucketWebsiteOutput::fromJsonString(const std::string& in
         errorDocument_ = std::make_shared<ErrorDocument>(errorDocument);
     }
     if (j.contains("RoutingRules")) {
-        auto routingRules = j.at("RoutingRules");
+        const auto& routingRules = j.at("RoutingRules");
         for (const auto& r : routingRules) {
             RoutingRule rule;
             if (r.contains("Condition")) {
                 RoutingRuleCondition condition_;
-                auto condition = r.at("Condition");
+                const auto& condition = r.at("Condition");
                 if (condition.contains("HttpErrorCodeReturnedEquals")) {
                     condition_.setHttpErrorCodeReturnedEquals(condition.at("HttpErrorCodeReturnedEquals").get<int>());
                 }
@@ -52,7 +52,7 @@ void VolcengineTos::GetBucketWebsiteOutput::fromJsonString(const std::string& in
             }
             if (r.contains("Redirect")) {
                 RoutingRuleRedirect routingRuleRedirect_;
-                auto routingRuleRedirect = r.at("Redirect");
+                const auto& routingRuleRedirect = r.at("Redirect");
 
                 if (routingRuleRedirect.contains("HostName")) {
                     routingRuleRedirect_.setHostName(routingRuleRedirect.at("HostName").get<std::string>());
@@ -73,7 +73,7 @@ void VolcengineTos::GetBucketWebsiteOutput::fromJsonString(const std::string& in
                 }
                 rule.setRedirect(routingRuleRedirect_);
             }
-            routingRules_.emplace_back(rule);
+            routingRules_.emplace_back(std::move(rule));
         }
     }
 }
@@ -5,7 +5,7 @@ void VolcengineTos::ListBucketCustomDomainOutput::fromJsonString(const std::stri
     auto j = nlohmann::json::parse(input);
 
     if (j.contains("CustomDomainRules")) {
-        auto rules = j.at("CustomDomainRules");
+        const auto& rules = j.at("CustomDomainRules");
         for (const auto& r : rules) {
             CustomDomainRule rule_;
             if (r.contains("Domain")) {
@@ -27,7 +27,7 @@ void VolcengineTos::ListBucketCustomDomainOutput::fromJsonString(const std::stri
                 auto status = r.at("CertStatus").get<std::string>();
                 rule_.setCertStatus(StringtoCertStatusType[status]);
             }
-            rules_.emplace_back(rule_);
+            rules_.emplace_back(std::move(rule_));
         }
     }
 }
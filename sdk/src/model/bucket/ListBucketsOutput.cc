@@ -21,7 +21,7 @@ VolcengineTos::ListedBucket parseListedBucket(const json& bucket) {
 void VolcengineTos::ListBucketsOutput::fromJsonString(const std::string& output) {
     json j = json::parse(output);
     if (j.contains("Buckets")) {
-        json bkts = j.at("Buckets");
+        const auto& bkts = j.at("Buckets");
         for (auto& bkt : bkts) {
             buckets_.emplace_back(parseListedBucket(bkt));
         }
@@ -25,7 +25,7 @@ std::string VolcengineTos::PutBucketCORSInput::toJsonString() const {
         if (r.getMaxAgeSeconds() != 0) {
             rule["MaxAgeSeconds"] = r.getMaxAgeSeconds();
         }
-        ruleArray.push_back(rule);
+        ruleArray.push_back(std::move(rule));
     }
     if (!ruleArray.empty())
         j["CORSRules"] = ruleArray;
@@ -31,7 +31,7 @@ std::string VolcengineTos::PutBucketLifecycleInput::toJsonString() const {
                 if (t.getStorageClass() != StorageClassType::NotSet) {
                     transitions["StorageClass"] = StorageClassTypetoString[t.getStorageClass()];
                 }
-                transitionsArray.push_back(transitions);
+                transitionsArray.push_back(std::move(transitions));
             }
             if (!transitionsArray.empty())
                 rule["Transitions"] = transitionsArray;
@@ -59,7 +59,7 @@ std::string VolcengineTos::PutBucketLifecycleInput::toJsonString() const {
                 if (n.getStorageClass() != StorageClassType::NotSet) {
                     nTransitions["StorageClass"] = StorageClassTypetoString[n.getStorageClass()];
                 }
-                ncvTransitionsArray.push_back(nTransitions);
+                ncvTransitionsArray.push_back(std::move(nTransitions));
             }
             if (!ncvTransitionsArray.empty())
                 rule["NoncurrentVersionTransitions"] = ncvTransitionsArray;
@@ -82,7 +82,7 @@ std::string VolcengineTos::PutBucketLifecycleInput::toJsonString() const {
                 if (!t.getValue().empty()) {
                     tag["Value"] = t.getValue();
                 }
-                tagArray.push_back(tag);
+                tagArray.push_back(std::move(tag));
             }
             if (!tagArray.empty())
                 rule["Tags"] = tagArray;
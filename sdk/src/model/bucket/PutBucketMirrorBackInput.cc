@@ -92,7 +92,7 @@ std::string VolcengineTos::PutBucketMirrorBackInput::toJsonString() const {
         }
         if (!redirect.empty())
             rule["Redirect"] = redirect;
-        ruleArray.push_back(rule);
+        ruleArray.push_back(std::move(rule));
     }
     if (!ruleArray.empty())
         j["Rules"] = ruleArray;
@@ -48,7 +48,7 @@ std::string VolcengineTos::PutBucketReplicationInput::toJsonString() const {
             }
             rule["Progress"] = progress;
         }
-        ruleArray.push_back(rule);
+        ruleArray.push_back(std::move(rule));
     }
     if (!ruleArray.empty())
         j["Rules"] = ruleArray;
@@ -74,7 +74,7 @@ std::string VolcengineTos::PutBucketWebsiteInput::toJsonString() const {
         if (!redirect.empty()) {
             rule["Redirect"] = redirect;
         }
-        ruleArray.emplace_back(rule);
+        ruleArray.emplace_back(std::move(rule));
     }
     if (!ruleArray.empty()) {
         j["RoutingRules"] = ruleArray;
@@ -1,16 +1,24 @@
 #include "model/object/CompleteMultipartUploadInput.h"
-#include "../src/external/json/json.hpp"
-using namespace nlohmann;
+#include "../src/utils/JsonWriter.h"
 
 std::string VolcengineTos::inner::InnerCompleteMultipartUploadInput::toJsonString() {
-    json j;
-    json jParts = json::array();
-    for (auto& part : parts_) {
-        json jPart;
-        jPart["PartNumber"] = part.getPartNumber();
-        jPart["ETag"] = part.getEtag();
-        jParts.emplace_back(jPart);
+    JsonWriter writer(parts_.size() * 64 + 16);
+    writeJson(writer, *this);
+    return writer.str();
+}
+
+void VolcengineTos::writeJson(JsonWriter& writer, const inner::InnerCompleteMultipartUploadInput& input) {
+    writer.beginObject();
+    writer.key("Parts");
+    writer.beginArray();
+    for (auto& part : input.getParts()) {
+        writer.beginObject();
+        writer.key("ETag");
+        writer.value(part.getEtag());
+        writer.key("PartNumber");
+        writer.value(part.getPartNumber());
+        writer.endObject();
     }
-    j["Parts"] = jParts;
-    return j.dump();
+    writer.endArray();
+    writer.endObject();
 }
@@ -1,19 +1,32 @@
-#include "../src/external/json/json.hpp"
 #include "model/object/CompleteMultipartUploadV2Input.h"
+#include "../src/utils/JsonWriter.h"
 
 std::string VolcengineTos::CompleteMultipartUploadV2Input::toJsonString() const {
-    nlohmann::json j;
-    nlohmann::json partsArray = nlohmann::json::array();
-    for (auto& p : parts_) {
-        nlohmann::json parts;
-        auto partNumber_ = std::to_string(p.getPartNumber());
-        if (!partNumber_.empty())
-            parts["PartNumber"] = p.getPartNumber();
-        if (!p.getETag().empty())
-            parts["ETag"] = p.getETag();
-        partsArray.push_back(parts);
+    JsonWriter writer(parts_.size() * 64 + 16);
+    writeJson(writer, *this);
+    return writer.str();
+}
+
+void VolcengineTos::writeJson(JsonWriter& writer, const CompleteMultipartUploadV2Input& input) {
+    // 字段按名称排序，与 nlohmann::json 的输出一致
+    const auto& parts = input.getParts();
+    if (parts.empty()) {
+        writer.null();
+        return;
+    }
+    writer.beginObject();
+    writer.key("Parts");
+    writer.beginArray();
+    for (auto& p : parts) {
+        writer.beginObject();
+        if (!p.getETag().empty()) {
+            writer.key("ETag");
+            writer.value(p.getETag());
+        }
+        writer.key("PartNumber");
+        writer.value(p.getPartNumber());
+        writer.endObject();
     }
-    if (!partsArray.empty())
-        j["Parts"] = partsArray;
-    return j.dump();
+    writer.endArray();
+    writer.endObject();
 }
@@ -1,20 +1,34 @@
 #include "model/object/DeleteMultiObjectsInput.h"
-#include "../src/external/json/json.hpp"
-using namespace nlohmann;
+#include "../src/utils/JsonWriter.h"
 
 std::string VolcengineTos::DeleteMultiObjectsInput::toJsonString() {
-    json j;
-    j["Quiet"] = quiet_;
-    json objectToBeDeleteArray = json::array();
-    for (auto& o : objectTobeDeleteds_) {
-        json object;
-        if (!o.getKey().empty())
-            object["Key"] = o.getKey();
-        if (!o.getVersionId().empty())
-            object["VersionId"] = o.getVersionId();
-        objectToBeDeleteArray.push_back(object);
+    JsonWriter writer(objectTobeDeleteds_.size() * 64 + 32);
+    writeJson(writer, *this);
+    return writer.str();
+}
+
+void VolcengineTos::writeJson(JsonWriter& writer, const DeleteMultiObjectsInput& input) {
+    // 字段按名称排序，与 nlohmann::json 的输出一致
+    const auto& objects = input.getObjectTobeDeleteds();
+    writer.beginObject();
+    if (!objects.empty()) {
+        writer.key("Objects");
+        writer.beginArray();
+        for (auto& o : objects) {
+            writer.beginObject();
+            if (!o.getKey().empty()) {
+                writer.key("Key");
+                writer.value(o.getKey());
+            }
+            if (!o.getVersionId().empty()) {
+                writer.key("VersionId");
+                writer.value(o.getVersionId());
+            }
+            writer.endObject();
+        }
+        writer.endArray();
     }
-    if (!objectToBeDeleteArray.empty())
-        j["Objects"] = objectToBeDeleteArray;
-    return j.dump();
+    writer.key("Quiet");
+    writer.value(input.isQuiet());
+    writer.endObject();
 }
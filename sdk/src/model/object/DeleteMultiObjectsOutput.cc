@@ -5,7 +5,7 @@ using namespace nlohmann;
 void VolcengineTos::DeleteMultiObjectsOutput::fromJsonString(const std::string& output) {
     auto j = json::parse(output);
     if (j.contains("Deleted")) {
-        auto des = j.at("Deleted");
+        const auto& des = j.at("Deleted");
         for (auto& de : des) {
             Deleted deleted;
             std::string tmp;
@@ -22,11 +22,11 @@ void VolcengineTos::DeleteMultiObjectsOutput::fromJsonString(const std::string&
             if (de.contains("DeleteMarkerVersionId"))
                 de.at("DeleteMarkerVersionId").get_to(tmp);
             deleted.setDeleteMarkerVersionId(tmp);
-            deleteds_.emplace_back(deleted);
+            deleteds_.emplace_back(std::move(deleted));
         }
     }
     if (j.contains("Error")) {
-        auto errs = j.at("Error");
+        const auto& errs = j.at("Error");
         for (auto& err : errs) {
             DeleteError de;
             std::string tmp;
@@ -42,7 +42,7 @@ void VolcengineTos::DeleteMultiObjectsOutput::fromJsonString(const std::string&
             if (err.contains("VersionId"))
                 err.at("VersionId").get_to(tmp);
             de.setVersionId(tmp);
-            errors_.emplace_back(de);
+            errors_.emplace_back(std::move(de));
         }
     }
 }
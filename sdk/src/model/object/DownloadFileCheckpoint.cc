@@ -38,11 +38,11 @@ void VolcengineTos::DownloadFileCheckpoint::load(const std::string& checkpointFi
         fileInfo_.load(j.at("FileInfo"));
     }
     if (j.contains("PartsInfo")) {
-        nlohmann::json parts = j.at("PartsInfo");
+        const auto& parts = j.at("PartsInfo");
         for (auto& part : parts) {
             DownloadFilePartInfo dfp;
             dfp.load(part);
-            partsInfo_.emplace_back(dfp);
+            partsInfo_.emplace_back(std::move(dfp));
         }
     }
 }
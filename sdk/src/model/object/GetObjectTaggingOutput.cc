@@ -6,9 +6,9 @@
 void VolcengineTos::GetObjectTaggingOutput::fromJsonString(const std::string& input) {
     auto j = nlohmann::json::parse(input);
     if (j.contains("TagSet")) {
-        nlohmann::json tags = j.at("TagSet");
+        const auto& tags = j.at("TagSet");
         if (tags.contains("Tags")) {
-            auto tag = tags.at("Tags");
+            const auto& tag = tags.at("Tags");
             std::vector<Tag> tags_;
             for (auto& t : tag) {
                 Tag tag_;
@@ -18,7 +18,7 @@ void VolcengineTos::GetObjectTaggingOutput::fromJsonString(const std::string& in
                 if (t.contains("Value")) {
                     tag_.setValue(t.at("Value").get<std::string>());
                 }
-                tags_.emplace_back(tag_);
+                tags_.emplace_back(std::move(tag_));
             }
             tagSet_.setTags(tags_);
         }
@@ -23,7 +23,7 @@ VolcengineTos::UploadInfo parseUploadInfo(const json& j) {
             j.at("Owner").at("DisplayName").get_to(tmp);
             owner.setDisplayName(tmp);
         }
-        info.setOwner(owner);
+        info.setOwner(std::move(owner));
     }
     if (j.contains("StorageClass")) {
         j.at("StorageClass").get_to(tmp);
@@ -57,20 +57,20 @@ void VolcengineTos::ListMultipartUploadsOutput::fromJsonString(const std::string
     if (j.contains("IsTruncated"))
         j.at("IsTruncated").get_to(isTruncated_);
     if (j.contains("Uploads")) {
-        auto ups = j.at("Uploads");
+        const auto& ups = j.at("Uploads");
         for (auto& up : ups) {
             upload_.emplace_back(parseUploadInfo(up));
         }
     }
     if (j.contains("CommonPrefixes")) {
-        auto cps = j.at("CommonPrefixes");
+        const auto& cps = j.at("CommonPrefixes");
         for (auto& cp : cps) {
             UploadCommonPrefix ucp;
             std::string prefix;
             if (cp.contains("Prefix"))
                 cp.at("Prefix").get_to(prefix);
             ucp.setPrefix(prefix);
-            commonPrefixes_.emplace_back(ucp);
+            commonPrefixes_.emplace_back(std::move(ucp));
         }
     }
 }
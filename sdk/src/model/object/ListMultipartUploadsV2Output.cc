@@ -26,16 +26,16 @@ void VolcengineTos::ListMultipartUploadsV2Output::fromJsonString(const std::stri
         j.at("NextUploadIDMarker").get_to(nextUploadIdMarker_);
 
     if (j.contains("CommonPrefixes")) {
-        nlohmann::json commonPrefixes = j.at("CommonPrefixes");
+        const auto& commonPrefixes = j.at("CommonPrefixes");
         for (auto& commonPrefixe : commonPrefixes) {
             ListedCommonPrefix lc;
             if (commonPrefixe.contains("Prefix"))
                 lc.setPrefix(commonPrefixe.at("Prefix").get<std::string>());
-            commonPrefixes_.emplace_back(lc);
+            commonPrefixes_.emplace_back(std::move(lc));
         }
     }
     if (j.contains("Uploads")) {
-        nlohmann::json uploads = j.at("Uploads");
+        const auto& uploads = j.at("Uploads");
         for (auto& upload : uploads) {
             ListedUpload lu;
             if (upload.contains("Key"))
@@ -54,9 +54,9 @@ void VolcengineTos::ListMultipartUploadsV2Output::fromJsonString(const std::stri
                 if (upload.at("Owner").contains("DisplayName")) {
                     owner.setDisplayName(upload.at("Owner").at("DisplayName").get<std::string>());
                 }
-                lu.setOwner(owner);
+                lu.setOwner(std::move(owner));
             }
-            uploads_.emplace_back(lu);
+            uploads_.emplace_back(std::move(lu));
         }
     }
 }
@@ -77,23 +77,23 @@ void VolcengineTos::ListObjectVersionsOutput::fromJsonString(const std::string&
     if (j.contains("IsTruncated"))
         j.at("IsTruncated").get_to(isTruncated_);
     if (j.contains("CommonPrefixes")) {
-        json pres = j.at("CommonPrefixes");
+        const auto& pres = j.at("CommonPrefixes");
         for (auto& pre : pres) {
             ListedCommonPrefix lcp;
             if (pre.contains("Prefix")) {
                 lcp.setPrefix(pre.at("Prefix").get<std::string>());
             }
-            commonPrefixes_.emplace_back(lcp);
+            commonPrefixes_.emplace_back(std::move(lcp));
         }
     }
     if (j.contains("Versions")) {
-        json versions = j.at("Versions");
+        const auto& versions = j.at("Versions");
         for (auto& v : versions) {
             versions_.emplace_back(parseListedObjectVersionV2(v));
         }
     }
     if (j.contains("DeleteMarkers")) {
-        json dms = j.at("DeleteMarkers");
+        const auto& dms = j.at("DeleteMarkers");
         for (auto& dm : dms) {
             deleteMarkers_.emplace_back(parseListedDeleteMarkerEntry(dm));
         }
@@ -87,23 +87,23 @@ void VolcengineTos::ListObjectVersionsV2Output::fromJsonString(const std::string
         j.at("NextVersionIdMarker").get_to(nextVersionIDMarker_);
 
     if (j.contains("CommonPrefixes")) {
-        json pres = j.at("CommonPrefixes");
+        const auto& pres = j.at("CommonPrefixes");
         for (auto& pre : pres) {
             ListedCommonPrefix lcp;
             if (pre.contains("Prefix")) {
                 lcp.setPrefix(pre.at("Prefix").get<std::string>());
             }
-            commonPrefixes_.emplace_back(lcp);
+            commonPrefixes_.emplace_back(std::move(lcp));
         }
     }
     if (j.contains("Versions")) {
-        json versions = j.at("Versions");
+        const auto& versions = j.at("Versions");
         for (auto& v : versions) {
             versions_.emplace_back(parseListedObjectVersion(v));
         }
     }
     if (j.contains("DeleteMarkers")) {
-        json dms = j.at("DeleteMarkers");
+        const auto& dms = j.at("DeleteMarkers");
         for (auto& dm : dms) {
             deleteMarkers_.emplace_back(parseListedDeleteMarkerEntryV2(dm));
         }
@@ -20,7 +20,7 @@ VolcengineTos::ListedObject parseListedObject(const json& object) {
         if (object.at("Owner").contains("DisplayName")) {
             owner.setDisplayName(object.at("Owner").at("DisplayName").get<std::string>());
         }
-        lo.setOwner(owner);
+        lo.setOwner(std::move(owner));
     }
     if (object.contains("StorageClass"))
         lo.setStorageClass(object.at("StorageClass").get<std::string>());
@@ -48,18 +48,18 @@ void VolcengineTos::ListObjectsOutput::fromJsonString(const std::string& input)
     if (j.contains("EncodingType"))
         j.at("EncodingType").get_to(encodingType_);
     if (j.contains("CommonPrefixes")) {
-        json pres = j.at("CommonPrefixes");
+        const auto& pres = j.at("CommonPrefixes");
         for (auto& pre : pres) {
             ListedCommonPrefix lcp;
             std::string prefix;
             if (pre.contains("Prefix"))
                 pre.at("Prefix").get_to(prefix);
             lcp.setPrefix(prefix);
-            commonPrefixes_.emplace_back(lcp);
+            commonPrefixes_.emplace_back(std::move(lcp));
         }
     }
     if (j.contains("Contents")) {
-        json contents = j.at("Contents");
+        const auto& contents = j.at("Contents");
         for (auto& ct : contents) {
             contents_.emplace_back(parseListedObject(ct));
         }
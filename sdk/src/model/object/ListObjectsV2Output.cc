@@ -27,7 +27,7 @@ VolcengineTos::ListedObjectV2 parseListedObjectV2_(const json& object) {
         if (object.at("Owner").contains("DisplayName")) {
             owner.setDisplayName(object.at("Owner").at("DisplayName").get<std::string>());
         }
-        lo.setOwner(owner);
+        lo.setOwner(std::move(owner));
     }
     if (object.contains("StorageClass"))
         lo.setStorageClass(VolcengineTos::StringtoStorageClassType[object.at("StorageClass").get<std::string>()]);
@@ -59,19 +59,19 @@ void VolcengineTos::ListObjectsV2Output::fromJsonString(const std::string& input
     if (j.contains("NextMarker"))
         j.at("NextMarker").get_to(nextMarker_);
     if (j.contains("CommonPrefixes")) {
-        json pres = j.at("CommonPrefixes");
+        const auto& pres = j.at("CommonPrefixes");
         for (auto& pre : pres) {
             ListedCommonPrefix lcp;
             std::string prefix;
             if (pre.contains("Prefix"))
                 pre.at("Prefix").get_to(prefix);
             lcp.setPrefix(prefix);
-            commonPrefixes_.emplace_back(lcp);
+            commonPrefixes_.emplace_back(std::move(lcp));
         }
     }
 
     if (j.contains("Contents")) {
-        json contents = j.at("Contents");
+        const auto& contents = j.at("Contents");
         for (auto& ct : contents) {
             contents_.push_back(parseListedObjectV2_(ct));
         }
@@ -31,7 +31,7 @@ void VolcengineTos::ListPartsOutput::fromJsonString(const std::string& input) {
         }
     }
     if (j.contains("Parts")) {
-        nlohmann::json parts = j.at("Parts");
+        const auto& parts = j.at("Parts");
         for (auto& part : parts) {
             UploadedPartV2 up;
             if (part.contains("PartNumber"))
@@ -45,7 +45,7 @@ void VolcengineTos::ListPartsOutput::fromJsonString(const std::string& input) {
                         TimeUtils::transLastModifiedStringToTime(part.at("LastModified").get<std::string>());
                 up.setLastModified(lastModified);
             }
-            parts_.emplace_back(up);
+            parts_.emplace_back(std::move(up));
         }
     }
 }
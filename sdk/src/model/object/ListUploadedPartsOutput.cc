@@ -29,7 +29,7 @@ void VolcengineTos::ListUploadedPartsOutput::fromJsonString(const std::string& i
         }
     }
     if (j.contains("Parts")) {
-        auto ups = j.at("Parts");
+        const auto& ups = j.at("Parts");
         for (auto& up : ups) {
             UploadedPart part;
             if (up.contains("PartNumber")) {
@@ -44,7 +44,7 @@ void VolcengineTos::ListUploadedPartsOutput::fromJsonString(const std::string& i
             if (up.contains("Size")) {
                 part.setSize(up.at("Size").get<int64_t>());
             }
-            uploadedParts_.emplace_back(part);
+            uploadedParts_.emplace_back(std::move(part));
         }
     }
 }
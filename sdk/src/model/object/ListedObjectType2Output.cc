@@ -25,7 +25,7 @@ VolcengineTos::ListedObjectV2 parseListedObjectV2(const json& object) {
         if (object.at("Owner").contains("DisplayName")) {
             owner.setDisplayName(object.at("Owner").at("DisplayName").get<std::string>());
         }
-        lo.setOwner(owner);
+        lo.setOwner(std::move(owner));
     }
     if (object.contains("StorageClass"))
         lo.setStorageClass(VolcengineTos::StringtoStorageClassType[object.at("StorageClass").get<std::string>()]);
@@ -63,17 +63,17 @@ void VolcengineTos::ListObjectsType2Output::fromJsonString(const std::string& in
     if (j.contains("NextContinuationToken"))
         j.at("NextContinuationToken").get_to(nextContinuationToken_);
     if (j.contains("CommonPrefixes")) {
-        auto commonPrefixes = j.at("CommonPrefixes");
+        const auto& commonPrefixes = j.at("CommonPrefixes");
         for (auto& cp : commonPrefixes) {
             ListedCommonPrefix listedCommonPrefix;
             if (cp.contains("Prefix")) {
                 listedCommonPrefix.setPrefix(cp.at("Prefix").get<std::string>());
             }
-            commonPrefixes_.emplace_back(listedCommonPrefix);
+            commonPrefixes_.emplace_back(std::move(listedCommonPrefix));
         }
     }
     if (j.contains("Contents")) {
-        nlohmann::json contents = j.at("Contents");
+        const auto& contents = j.at("Contents");
         for (auto& ct : contents) {
             contents_.push_back(parseListedObjectV2(ct));
         }
@@ -15,11 +15,11 @@ std::string VolcengineTos::PostPolicyInner::toJsonString() const {
                 arrayJson.emplace_back(*condition.getAnOperator());
                 arrayJson.emplace_back(stoll(condition.getKey()));
                 arrayJson.emplace_back(stoll(condition.getValue()));
-                jsonConditons.emplace_back(arrayJson);
+                jsonConditons.emplace_back(std::move(arrayJson));
             } else {
                 std::vector<std::string> temp = {*condition.getAnOperator(), condition.getKey(), condition.getValue()};
                 nlohmann::json arrayJson(temp);
-                jsonConditons.emplace_back(arrayJson);
+                jsonConditons.emplace_back(std::move(arrayJson));
             }
         } else {
             tempJson[condition.getKey()] = condition.getValue();
@@ -15,7 +15,7 @@ std::string VolcengineTos::PutObjectTaggingInput::toJsonString() const {
             if (!t.getValue().empty()) {
                 tag["Value"] = t.getValue();
             }
-            tagArray.push_back(tag);
+            tagArray.push_back(std::move(tag));
         }
         if (!tagArray.empty()) {
             j["Tags"] = tagArray;
@@ -44,11 +44,11 @@ void VolcengineTos::ResumableCopyCheckpoint::load(const std::string& checkpointF
         copySourceObjectInfo_.load(j.at("CopySourceObjectInfo"));
     }
     if (j.contains("PartsInfo")) {
-        nlohmann::json parts = j.at("PartsInfo");
+        const auto& parts = j.at("PartsInfo");
         for (auto& part : parts) {
             ResumableCopyPartInfo rfp;
             rfp.load(part);
-            partsInfo_.emplace_back(rfp);
+            partsInfo_.emplace_back(std::move(rfp));
         }
     }
 }
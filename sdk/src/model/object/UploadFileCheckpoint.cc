@@ -48,11 +48,11 @@ void VolcengineTos::UploadFileCheckpoint::load() {
         fileInfo_.load(j.at("UploadFileInfo"));
     }
     if (j.contains("Parts")) {
-        json parts = j.at("Parts");
+        const auto& parts = j.at("Parts");
         for (auto& part : parts) {
             UploadFilePartInfo ufp;
             ufp.load(part);
-            uploadFilePartInfoList_.emplace_back(ufp);
+            uploadFilePartInfoList_.emplace_back(std::move(ufp));
         }
     }
 }
@@ -55,11 +55,11 @@ void VolcengineTos::UploadFileCheckpointV2::load(std::string checkpointFilePath)
         fileInfo_.load(j.at("FileInfo"));
     }
     if (j.contains("PartsInfo")) {
-        nlohmann::json parts = j.at("PartsInfo");
+        const auto& parts = j.at("PartsInfo");
         for (auto& part : parts) {
             UploadFilePartInfoV2 ufp;
             ufp.load(part);
-            partsInfo_.emplace_back(ufp);
+            partsInfo_.emplace_back(std::move(ufp));
         }
     }
 }
@@ -0,0 +1,466 @@
+#include "../TosClientImpl.h"
+#include "TransferJournal.h"
+#include "../utils/LogUtils.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+
+using namespace VolcengineTos;
+
+namespace {
+const int maxPartCount = 10000;
+// copyObject 支持的最大对象
+const int64_t maxCopyObjectSize = 5LL * 1024 * 1024 * 1024;
+
+// journal 中一个源对象的记录，源对象 ETag 变化后记录失效
+struct CopyJournalEntry {
+    bool copied = false;
+    std::string etag;
+    int64_t partSize = 0;
+    std::string uploadId;
+    std::map<int, std::string> parts;
+};
+
+// {"Type":"Upload"} 开始分片复制，{"Type":"Part"} 完成一个分片，{"Type":"Object"} 完成一个对象
+std::map<std::string, CopyJournalEntry> loadCopyJournal(const TransferJournal& journal) {
+    std::map<std::string, CopyJournalEntry> entries;
+    for (const auto& j : journal.load()) {
+        if (!j.contains("Type") || !j.contains("Key")) {
+            continue;
+        }
+        auto& entry = entries[j.at("Key").get<std::string>()];
+        auto type = j.at("Type").get<std::string>();
+        if (type == "Object") {
+            entry = CopyJournalEntry();
+            entry.copied = true;
+            entry.etag = j.value("ETag", std::string());
+        } else if (type == "Upload") {
+            entry = CopyJournalEntry();
+            entry.etag = j.value("ETag", std::string());
+            entry.partSize = j.value("PartSize", int64_t(0));
+            entry.uploadId = j.value("UploadID", std::string());
+        } else if (type == "Part" && j.value("UploadID", std::string()) == entry.uploadId) {
+            entry.parts[j.value("PartNumber", 0)] = j.value("PartETag", std::string());
+        }
+    }
+    return entries;
+}
+
+struct PrefixCopyObject {
+    std::string srcKey;
+    std::string key;
+    std::string etag;
+    int64_t size = 0;
+    uint64_t hashCrc64ecma = 0;
+    // 0 表示使用 copyObject 复制
+    int64_t partSize = 0;
+    // journal 中已复制完成，只需要删除源对象
+    bool copied = false;
+    std::mutex mu;
+    std::string uploadId;
+    bool resumed = false;
+    std::map<int, std::string> parts;
+    std::atomic<int> remaining{0};
+    std::atomic<bool> failed{false};
+    TosError error;
+};
+
+// partNumber 为 0 表示 copyObject，-1 表示只需要完成对象
+struct PrefixCopyTask {
+    std::shared_ptr<PrefixCopyObject> object;
+    int partNumber;
+};
+}  // namespace
+
+Outcome<TosError, CopyPrefixOutput> TosClientImpl::copyPrefixConcurrent(const CopyPrefixInput& input) {
+    Outcome<TosError, CopyPrefixOutput> res;
+    auto clientError = [](const std::string& message) {
+        TosError error;
+        error.setIsClientError(true);
+        error.setMessage(message);
+        return error;
+    };
+    TransferJournal journal(input.getJournalFile());
+    auto recorded = loadCopyJournal(journal);
+    if (!journal.open()) {
+        res.setE(clientError("open journal file failed: " + input.getJournalFile()));
+        res.setSuccess(false);
+        return res;
+    }
+    const auto& srcBucket = input.getSrcBucket();
+    const auto& srcPrefix = input.getSrcPrefix();
+    const auto& bucket = input.getBucket();
+    auto taskNum = std::max(std::min(input.getTaskNum(), 1000), 1);
+    auto threshold = std::min(input.getMultipartThreshold(), maxCopyObjectSize);
+    auto mapper = input.getKeyMapper();
+    auto callback = input.getResultCallback();
+    auto cancel = input.getCancelHook();
+    auto canceled = [&]() { return cancel != nullptr && cancel->isCancel(); };
+    auto logger = LogUtils::GetLogger(LogCategoryTransfer, LogInfo);
+
+    // 列举和复制同时进行，队列满时暂停列举
+    const size_t maxQueued = std::max<size_t>(taskNum * 64, 1024);
+    std::deque<PrefixCopyTask> queue;
+    bool listDone = false;
+    std::mutex mu;
+    std::condition_variable cv;
+
+    std::atomic<int64_t> listedObjects(0);
+    std::atomic<int64_t> copiedObjects(0);
+    std::atomic<int64_t> copiedBytes(0);
+    std::atomic<int64_t> skippedObjects(0);
+    std::atomic<int64_t> multipartObjects(0);
+    std::atomic<int64_t> deletedObjects(0);
+    std::atomic<int64_t> failedObjects(0);
+    std::mutex errorLock;
+    TosError firstError;
+    bool hasFailed = false;
+    auto fail = [&](const std::shared_ptr<PrefixCopyObject>& object, const TosError& err) {
+        std::lock_guard<std::mutex> lck(object->mu);
+        if (!object->failed) {
+            object->error = err;
+            object->failed = true;
+        }
+    };
+    auto recordUpload = [&](const PrefixCopyObject* object) {
+        nlohmann::json j;
+        j["Type"] = "Upload";
+        j["Key"] = object->srcKey;
+        j["ETag"] = object->etag;
+        j["PartSize"] = object->partSize;
+        j["UploadID"] = object->uploadId;
+        journal.append(j);
+    };
+
+    // 目标对象与源对象大小一致，且都有 CRC64 时 CRC64 一致
+    auto verifyCopied = [&](const std::shared_ptr<PrefixCopyObject>& object) {
+        auto headRes = this->headObject(HeadObjectV2Input(bucket, object->key));
+        if (!headRes.isSuccess()) {
+            fail(object, headRes.error());
+            return false;
+        }
+        const auto& head = headRes.result();
+        if (head.getContentLength() != object->size ||
+            (object->hashCrc64ecma != 0 && head.getHashCrc64Ecma() != 0 &&
+             head.getHashCrc64Ecma() != object->hashCrc64ecma)) {
+            fail(object, clientError("the destination object is different from the source object"));
+            return false;
+        }
+        return true;
+    };
+
+    auto finishObject = [&](const std::shared_ptr<PrefixCopyObject>& object) {
+        if (!object->failed && object->partSize > 0) {
+            std::vector<UploadedPartV2> parts;
+            for (const auto& part : object->parts) {
+                parts.emplace_back(part.first, part.second);
+            }
+            CompleteMultipartUploadV2Input complete(bucket, object->key, object->uploadId, parts);
+            auto completeRes = this->completeMultipartUpload(complete);
+            if (!completeRes.isSuccess()) {
+                fail(object, completeRes.error());
+            } else if (object->hashCrc64ecma != 0 && completeRes.result().getHashCrc64ecma() != 0 &&
+                       completeRes.result().getHashCrc64ecma() != object->hashCrc64ecma) {
+                fail(object, clientError("Check CRC failed: CRC checksum of destination is mismatch with source"));
+            }
+        }
+        CopyPrefixResult result;
+        result.setSrcKey(object->srcKey);
+        result.setKey(object->key);
+        result.setSize(object->size);
+        result.setSkipped(object->copied);
+        if (!object->failed && !object->copied) {
+            nlohmann::json j;
+            j["Type"] = "Object";
+            j["Key"] = object->srcKey;
+            j["ETag"] = object->etag;
+            journal.append(j);
+            copiedObjects++;
+            copiedBytes += object->size;
+        }
+        // 上次已复制的对象在删除源对象前重新校验目标对象
+        if (!object->failed && input.isDeleteSource() && (!object->copied || verifyCopied(object))) {
+            DeleteObjectInput deleteInput(srcBucket, object->srcKey);
+            auto deleteRes = this->deleteObject(deleteInput);
+            if (deleteRes.isSuccess()) {
+                deletedObjects++;
+                result.setSourceDeleted(true);
+            } else {
+                fail(object, deleteRes.error());
+            }
+        }
+        if (object->failed) {
+            failedObjects++;
+            {
+                std::lock_guard<std::mutex> lck(errorLock);
+                if (!hasFailed) {
+                    hasFailed = true;
+                    firstError = object->error;
+                    firstError.setMessage(object->srcKey + ": " + object->error.getMessage());
+                }
+            }
+            // 没有 journal 或取消并 abort 时清理分片复制
+            if (!object->uploadId.empty() && (!journal.enabled() || (canceled() && cancel->isAbortFunc()))) {
+                AbortMultipartUploadInput abort(bucket, object->key, object->uploadId);
+                if (!this->abortMultipartUpload(abort).isSuccess() && logger != nullptr) {
+                    logger->info("abort multipart upload failed");
+                }
+            }
+            result.setError(object->error);
+        }
+        result.setSuccess(!object->failed);
+        if (callback != nullptr) {
+            callback(result);
+        }
+    };
+
+    auto runTask = [&](const PrefixCopyTask& task) {
+        auto object = task.object;
+        if (object->failed || task.partNumber < 0) {
+            return;
+        }
+        if (task.partNumber == 0) {
+            CopyObjectV2Input copy(bucket, object->key, srcBucket, object->srcKey);
+            // 使用列举到的 ETag 保证复制的是同一版本
+            copy.setCopySourceIfMatch(object->etag);
+            auto copyRes = this->copyObject(copy);
+            if (!copyRes.isSuccess()) {
+                fail(object, copyRes.error());
+            }
+            return;
+        }
+        std::string uploadId;
+        {
+            // 第一个分片任务创建分片复制，沿用源对象的元数据
+            std::lock_guard<std::mutex> lck(object->mu);
+            if (object->uploadId.empty()) {
+                auto headRes = this->headObject(HeadObjectV2Input(srcBucket, object->srcKey));
+                if (!headRes.isSuccess()) {
+                    object->error = headRes.error();
+                    object->failed = true;
+                    return;
+                }
+                const auto& head = headRes.result();
+                CreateMultipartUploadInput create(bucket, object->key);
+                create.setContentType(head.getContentType());
+                create.setCacheControl(head.getCacheControl());
+                create.setContentDisposition(head.getContentDisposition());
+                create.setContentEncoding(head.getContentEncoding());
+                create.setContentLanguage(head.getContentLanguage());
+                create.setExpires(head.getExpires());
+                create.setMeta(head.getMeta());
+                auto createRes = this->createMultipartUpload(create);
+                if (!createRes.isSuccess()) {
+                    object->error = createRes.error();
+                    object->failed = true;
+                    return;
+                }
+                object->uploadId = createRes.result().getUploadId();
+                recordUpload(object.get());
+            }
+            uploadId = object->uploadId;
+        }
+        auto offset = (task.partNumber - 1) * object->partSize;
+        auto size = std::min(object->partSize, object->size - offset);
+        UploadPartCopyV2Input part(bucket, object->key, srcBucket, object->srcKey, task.partNumber, uploadId);
+        part.setCopySourceRangeStart(offset);
+        part.setCopySourceRangeEnd(offset + size - 1);
+        part.setCopySourceIfMatch(object->etag);
+        auto partRes = this->uploadPartCopy(part);
+        if (!partRes.isSuccess()) {
+            // journal 中的分片复制已失效，下次重新复制
+            if (object->resumed && partRes.error().getStatusCode() == 404) {
+                std::lock_guard<std::mutex> lck(object->mu);
+                object->uploadId.clear();
+                recordUpload(object.get());
+            }
+            fail(object, partRes.error());
+            return;
+        }
+        const auto& etag = partRes.result().getETag();
+        {
+            std::lock_guard<std::mutex> lck(object->mu);
+            object->parts[task.partNumber] = etag;
+        }
+        nlohmann::json j;
+        j["Type"] = "Part";
+        j["Key"] = object->srcKey;
+        j["UploadID"] = uploadId;
+        j["PartNumber"] = task.partNumber;
+        j["PartETag"] = etag;
+        journal.append(j);
+    };
+
+    auto worker = [&]() {
+        while (true) {
+            PrefixCopyTask task;
+            {
+                std::unique_lock<std::mutex> lock(mu);
+                cv.wait(lock, [&]() { return !queue.empty() || listDone; });
+                if (queue.empty()) {
+                    return;
+                }
+                task = queue.front();
+                queue.pop_front();
+                cv.notify_all();
+            }
+            if (!canceled()) {
+                runTask(task);
+            } else {
+                fail(task.object, clientError("the task is canceled"));
+            }
+            if (--task.object->remaining == 0) {
+                finishObject(task.object);
+            }
+        }
+    };
+    std::vector<std::thread> threadPool;
+    for (int i = 0; i < taskNum; i++) {
+        threadPool.emplace_back(worker);
+    }
+
+    auto push = [&](PrefixCopyTask task) {
+        std::unique_lock<std::mutex> lock(mu);
+        cv.wait(lock, [&]() { return queue.size() < maxQueued; });
+        queue.push_back(std::move(task));
+        cv.notify_all();
+    };
+    // 同一个桶内目标对象落在源前缀中且排在当前对象之后时（keyMapper 映射到源前缀之下，或目标前缀是源前缀的上级），
+    // 之后的列举页会返回本次复制出的对象，记录下来并跳过，避免重复复制到更深的前缀或反复移动
+    std::set<std::string> produced;
+    auto enqueue = [&](const ListedObjectV2& content) {
+        listedObjects++;
+        const auto& srcKey = content.getKey();
+        if (!produced.empty() && produced.erase(srcKey) > 0) {
+            skippedObjects++;
+            return;
+        }
+        auto key = mapper != nullptr ? mapper(srcKey) : input.getPrefix() + srcKey.substr(srcPrefix.size());
+        if (key.empty() || (bucket == srcBucket && key == srcKey)) {
+            skippedObjects++;
+            return;
+        }
+        if (bucket == srcBucket && key > srcKey && key.compare(0, srcPrefix.size(), srcPrefix) == 0) {
+            produced.insert(key);
+        }
+        auto object = std::make_shared<PrefixCopyObject>();
+        object->srcKey = srcKey;
+        object->key = key;
+        object->etag = content.getETag();
+        object->size = content.getSize();
+        object->hashCrc64ecma = content.getHashCrc64Ecma();
+        auto it = recorded.find(srcKey);
+        bool unchanged = it != recorded.end() && it->second.etag == object->etag;
+        if (unchanged && it->second.copied) {
+            skippedObjects++;
+            if (!input.isDeleteSource()) {
+                if (callback != nullptr) {
+                    CopyPrefixResult result;
+                    result.setSrcKey(srcKey);
+                    result.setKey(key);
+                    result.setSize(object->size);
+                    result.setSkipped(true);
+                    result.setSuccess(true);
+                    callback(result);
+                }
+                return;
+            }
+            object->copied = true;
+            object->remaining = 1;
+            push({object, -1});
+            return;
+        }
+        if (object->size <= threshold) {
+            object->remaining = 1;
+            push({object, 0});
+            return;
+        }
+        multipartObjects++;
+        // 分片数超过上限时增大分片
+        auto minPartSize = (object->size + maxPartCount - 1) / maxPartCount;
+        object->partSize = std::max(input.getPartSize(), minPartSize);
+        if (unchanged && !it->second.uploadId.empty() && it->second.partSize == object->partSize) {
+            object->uploadId = it->second.uploadId;
+            object->parts = it->second.parts;
+            object->resumed = true;
+        }
+        auto partCount = static_cast<int>((object->size + object->partSize - 1) / object->partSize);
+        std::vector<int> pending;
+        for (int partNumber = 1; partNumber <= partCount; partNumber++) {
+            if (object->parts.count(partNumber) == 0) {
+                pending.push_back(partNumber);
+            }
+        }
+        if (pending.empty()) {
+            pending.push_back(-1);
+        }
+        object->remaining = static_cast<int>(pending.size());
+        for (auto partNumber : pending) {
+            push({object, partNumber});
+        }
+    };
+
+    TosError listError;
+    bool listFailed = false;
+    ListObjectsType2Input listInput;
+    listInput.setBucket(srcBucket);
+    listInput.setPrefix(srcPrefix);
+    listInput.setMaxKeys(1000);
+    while (!canceled()) {
+        auto listRes = this->listObjectsType2(listInput);
+        if (!listRes.isSuccess()) {
+            listError = listRes.error();
+            listFailed = true;
+            break;
+        }
+        for (const auto& content : listRes.result().getContents()) {
+            enqueue(content);
+        }
+        if (!listRes.result().isTruncated()) {
+            break;
+        }
+        listInput.setContinuationToken(listRes.result().getNextContinuationToken());
+    }
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        listDone = true;
+        cv.notify_all();
+    }
+    for (auto& t : threadPool) {
+        t.join();
+    }
+
+    if (canceled()) {
+        res.setE(clientError("the task is canceled"));
+        res.setSuccess(false);
+        return res;
+    }
+    if (listFailed) {
+        res.setE(listError);
+        res.setSuccess(false);
+        return res;
+    }
+    if (failedObjects > 0) {
+        firstError.setMessage("some objects are copied incorrectly (" + std::to_string(failedObjects.load()) +
+                              " failed), you can try again, first error: " + firstError.getMessage());
+        res.setE(firstError);
+        res.setSuccess(false);
+        return res;
+    }
+    CopyPrefixOutput output;
+    output.setBucket(bucket);
+    output.setListedObjects(listedObjects);
+    output.setCopiedObjects(copiedObjects);
+    output.setCopiedBytes(copiedBytes);
+    output.setSkippedObjects(skippedObjects);
+    output.setMultipartObjects(multipartObjects);
+    output.setDeletedObjects(deletedObjects);
+    res.setSuccess(true);
+    res.setR(std::move(output));
+    return res;
+}
@@ -0,0 +1,364 @@
+#include "../TosClientImpl.h"
+#include "utils/crc64.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+using namespace VolcengineTos;
+
+namespace {
+struct PrefixObject {
+    std::string key;
+    std::string filePath;
+    std::string tempFilePath;
+    int64_t size = 0;
+    std::string etag;
+    uint64_t hashCrc64ecma = 0;
+    // 0 表示整个对象一次 GET
+    int64_t partSize = 0;
+    std::vector<uint64_t> partCrc64;
+    std::atomic<int> remaining{0};
+    std::atomic<bool> failed{false};
+    std::mutex mu;
+    TosError error;
+};
+
+// part 为 -1 表示整个对象
+struct PrefixTask {
+    std::shared_ptr<PrefixObject> object;
+    int part;
+    int64_t bytes;
+};
+
+// 限制同时在下载中的字节数
+class InflightBudget {
+public:
+    explicit InflightBudget(int64_t limit) : limit_(limit) {
+    }
+    void acquire(int64_t bytes) {
+        std::unique_lock<std::mutex> lock(mu_);
+        cv_.wait(lock, [&]() { return inflight_ == 0 || inflight_ + bytes <= limit_; });
+        inflight_ += bytes;
+    }
+    void release(int64_t bytes) {
+        std::lock_guard<std::mutex> lock(mu_);
+        inflight_ -= bytes;
+        cv_.notify_all();
+    }
+
+private:
+    int64_t limit_;
+    int64_t inflight_ = 0;
+    std::mutex mu_;
+    std::condition_variable cv_;
+};
+
+// 对象名去掉前缀后作为本地相对路径，拒绝包含 .. 的路径，避免写到目录之外
+bool relativeObjectPath(const std::string& key, const std::string& prefix, std::string& relative) {
+    relative = key.substr(prefix.size());
+    while (!relative.empty() && relative.front() == '/') {
+        relative.erase(0, 1);
+    }
+    size_t start = 0;
+    while (start <= relative.size()) {
+        auto end = relative.find('/', start);
+        if (end == std::string::npos) {
+            end = relative.size();
+        }
+        if (relative.compare(start, end - start, "..") == 0 && end - start == 2) {
+            return false;
+        }
+        start = end + 1;
+    }
+#ifdef _WIN32
+    if (relative.find('\\') != std::string::npos || relative.find(':') != std::string::npos) {
+        return false;
+    }
+    std::replace(relative.begin(), relative.end(), '/', TOS_PATH_DELIMITER);
+#endif
+    return true;
+}
+}  // namespace
+
+Outcome<TosError, DownloadPrefixOutput> TosClientImpl::downloadObjectsConcurrent(
+        const DownloadPrefixInput& input, const std::vector<ListedObjectV2>* objects) {
+    Outcome<TosError, DownloadPrefixOutput> res;
+    const auto& bucket = input.getBucket();
+    const auto& prefix = input.getPrefix();
+    auto directory = input.getDirectory();
+    if (directory.back() != TOS_PATH_DELIMITER) {
+        directory.push_back(TOS_PATH_DELIMITER);
+    }
+    if (!FileUtils::CreateDir(directory, false)) {
+        TosError error;
+        error.setIsClientError(true);
+        error.setMessage("invalid file path, mkdir failed");
+        res.setE(error);
+        res.setSuccess(false);
+        return res;
+    }
+    auto taskNum = std::max(std::min(input.getTaskNum(), 1000), 1);
+    auto cancel = input.getCancelHook();
+    auto canceled = [&]() { return cancel != nullptr && cancel->isCancel(); };
+
+    // 列举和下载同时进行，队列满时暂停列举
+    const size_t maxQueued = std::max<size_t>(taskNum * 64, 1024);
+    std::deque<PrefixTask> queue;
+    bool listDone = false;
+    std::mutex mu;
+    std::condition_variable cv;
+    InflightBudget budget(input.getMaxInflightBytes());
+
+    std::atomic<int64_t> listedObjects(0);
+    std::atomic<int64_t> downloadedFiles(0);
+    std::atomic<int64_t> downloadedBytes(0);
+    std::atomic<int64_t> parallelFiles(0);
+    std::atomic<int64_t> failedFiles(0);
+    std::mutex errorLock;
+    TosError firstError;
+    bool hasFailed = false;
+    auto recordError = [&](const std::string& key, const TosError& err) {
+        failedFiles++;
+        std::lock_guard<std::mutex> lck(errorLock);
+        if (!hasFailed) {
+            hasFailed = true;
+            firstError = err;
+            firstError.setMessage(key + ": " + err.getMessage());
+        }
+    };
+    auto fail = [&](const std::shared_ptr<PrefixObject>& object, const TosError& err) {
+        std::lock_guard<std::mutex> lck(object->mu);
+        if (!object->failed) {
+            object->error = err;
+            object->failed = true;
+        }
+    };
+    auto clientError = [](const std::string& message) {
+        TosError error;
+        error.setIsClientError(true);
+        error.setMessage(message);
+        return error;
+    };
+
+    auto finishObject = [&](const std::shared_ptr<PrefixObject>& object) {
+        if (!object->failed && object->hashCrc64ecma != 0) {
+            uint64_t crc = object->partCrc64.front();
+            for (size_t i = 1; i < object->partCrc64.size(); i++) {
+                auto length = std::min(object->partSize, object->size - static_cast<int64_t>(i) * object->partSize);
+                crc = CRC64::CombineCRC(crc, object->partCrc64[i], length);
+            }
+            if (crc != object->hashCrc64ecma) {
+                fail(object, clientError("Check CRC failed: CRC checksum of client is mismatch with tos"));
+            }
+        }
+        if (!object->failed && std::rename(object->tempFilePath.c_str(), object->filePath.c_str()) != 0) {
+            // 目标文件已存在时先删除再重命名
+            std::remove(object->filePath.c_str());
+            if (std::rename(object->tempFilePath.c_str(), object->filePath.c_str()) != 0) {
+                fail(object, clientError("rename temp file failed"));
+            }
+        }
+        if (object->failed) {
+            std::remove(object->tempFilePath.c_str());
+            recordError(object->key, object->error);
+            return;
+        }
+        downloadedFiles++;
+        downloadedBytes += object->size;
+    };
+
+    auto runTask = [&](const PrefixTask& task) {
+        auto object = task.object;
+        if (object->failed) {
+            return;
+        }
+        std::ios_base::openmode mode = std::ios_base::out | std::ios_base::binary;
+        if (task.part < 0) {
+            mode |= std::ios_base::trunc;
+            if (!FileUtils::CreateDir(object->filePath, true)) {
+                fail(object, clientError("invalid file path, mkdir failed"));
+                return;
+            }
+        } else {
+            mode |= std::ios_base::in;
+        }
+        auto content = std::make_shared<std::fstream>(object->tempFilePath, mode);
+        if (!content->good()) {
+            fail(object, clientError("open file failed: " + object->tempFilePath));
+            return;
+        }
+        GetObjectV2Input getInput(bucket, object->key);
+        // 使用列举到的 ETag 保证各个分片属于同一版本
+        getInput.setIfMatch(object->etag);
+        if (task.part >= 0) {
+            auto start = task.part * object->partSize;
+            content->seekp(start);
+            getInput.setRange(HttpRange(start, start + task.bytes - 1).toString());
+        }
+        auto hashCrc64ecma = std::make_shared<uint64_t>(0);
+        auto getRes = this->getObject(getInput, hashCrc64ecma, content);
+        content->close();
+        if (!getRes.isSuccess()) {
+            fail(object, getRes.error());
+            return;
+        }
+        if (content->fail()) {
+            fail(object, clientError("failed to write stream to file"));
+            return;
+        }
+        object->partCrc64[std::max(task.part, 0)] = *hashCrc64ecma;
+    };
+
+    auto worker = [&]() {
+        while (true) {
+            PrefixTask task;
+            {
+                std::unique_lock<std::mutex> lock(mu);
+                cv.wait(lock, [&]() { return !queue.empty() || listDone; });
+                if (queue.empty()) {
+                    return;
+                }
+                task = queue.front();
+                queue.pop_front();
+                cv.notify_all();
+            }
+            if (!canceled()) {
+                budget.acquire(task.bytes);
+                runTask(task);
+                budget.release(task.bytes);
+            } else {
+                fail(task.object, clientError("the task is canceled"));
+            }
+            if (--task.object->remaining == 0) {
+                finishObject(task.object);
+            }
+        }
+    };
+    std::vector<std::thread> threadPool;
+    for (int i = 0; i < taskNum; i++) {
+        threadPool.emplace_back(worker);
+    }
+
+    auto push = [&](PrefixTask task) {
+        std::unique_lock<std::mutex> lock(mu);
+        cv.wait(lock, [&]() { return queue.size() < maxQueued; });
+        queue.push_back(std::move(task));
+        cv.notify_all();
+    };
+    auto enqueue = [&](const ListedObjectV2& content) {
+        listedObjects++;
+        std::string relative;
+        if (!relativeObjectPath(content.getKey(), prefix, relative)) {
+            recordError(content.getKey(), clientError("invalid object key for local path"));
+            return;
+        }
+        // 目录对象只创建本地目录
+        if (relative.empty() || relative.back() == TOS_PATH_DELIMITER) {
+            FileUtils::CreateDir(directory + relative, false);
+            return;
+        }
+        auto object = std::make_shared<PrefixObject>();
+        object->key = content.getKey();
+        object->filePath = directory + relative;
+        // 多个进程或多次调用可能同时下载到同一目录，临时文件名带上时间戳和实例标识
+        std::stringstream tempSuffix;
+        tempSuffix << ".temp_" << std::hex << std::chrono::steady_clock::now().time_since_epoch().count() << "_"
+                   << reinterpret_cast<uintptr_t>(object.get());
+        object->tempFilePath = object->filePath + tempSuffix.str();
+        object->size = content.getSize();
+        object->etag = content.getETag();
+        object->hashCrc64ecma = content.getHashCrc64Ecma();
+        if (object->size <= input.getParallelThreshold() || input.getPartSize() <= 0) {
+            object->partCrc64.resize(1, 0);
+            object->remaining = 1;
+            push({object, -1, object->size});
+            return;
+        }
+        // 先创建临时文件，各个分片写入各自的位置
+        if (!FileUtils::CreateDir(object->filePath, true) ||
+            !std::ofstream(object->tempFilePath, std::ios_base::out | std::ios_base::trunc).good()) {
+            recordError(object->key, clientError("create temp file failed: " + object->tempFilePath));
+            return;
+        }
+        parallelFiles++;
+        object->partSize = input.getPartSize();
+        auto parts = static_cast<int>((object->size + object->partSize - 1) / object->partSize);
+        object->partCrc64.resize(parts, 0);
+        object->remaining = parts;
+        for (int part = 0; part < parts; part++) {
+            push({object, part, std::min(object->partSize, object->size - part * object->partSize)});
+        }
+    };
+    TosError listError;
+    bool listFailed = false;
+    if (objects != nullptr) {
+        for (const auto& content : *objects) {
+            if (canceled()) {
+                break;
+            }
+            enqueue(content);
+        }
+    } else {
+        ListObjectsType2Input listInput;
+        listInput.setBucket(bucket);
+        listInput.setPrefix(prefix);
+        listInput.setMaxKeys(1000);
+        while (!canceled()) {
+            auto listRes = this->listObjectsType2(listInput);
+            if (!listRes.isSuccess()) {
+                listError = listRes.error();
+                listFailed = true;
+                break;
+            }
+            for (const auto& content : listRes.result().getContents()) {
+                enqueue(content);
+            }
+            if (!listRes.result().isTruncated()) {
+                break;
+            }
+            listInput.setContinuationToken(listRes.result().getNextContinuationToken());
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        listDone = true;
+        cv.notify_all();
+    }
+    for (auto& t : threadPool) {
+        t.join();
+    }
+
+    if (canceled()) {
+        res.setE(clientError("the task is canceled"));
+        res.setSuccess(false);
+        return res;
+    }
+    if (listFailed) {
+        res.setE(listError);
+        res.setSuccess(false);
+        return res;
+    }
+    if (failedFiles > 0) {
+        firstError.setMessage("some objects are downloaded incorrectly (" + std::to_string(failedFiles.load()) +
+                              " failed), you can try again, first error: " + firstError.getMessage());
+        res.setE(firstError);
+        res.setSuccess(false);
+        return res;
+    }
+    DownloadPrefixOutput output;
+    output.setBucket(bucket);
+    output.setListedObjects(listedObjects);
+    output.setDownloadedFiles(downloadedFiles);
+    output.setDownloadedBytes(downloadedBytes);
+    output.setParallelFiles(parallelFiles);
+    res.setSuccess(true);
+    res.setR(std::move(output));
+    return res;
+}
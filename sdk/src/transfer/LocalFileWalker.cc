@@ -0,0 +1,141 @@
+#include "LocalFileWalker.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <sys/stat.h>
+#include <thread>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#endif
+
+using namespace VolcengineTos;
+
+namespace {
+struct DirEntry {
+    std::string name;
+    bool isDir;
+};
+
+bool listDir(const std::string& dir, std::vector<DirEntry>& entries) {
+#ifdef _WIN32
+    WIN32_FIND_DATAA data;
+    HANDLE handle = FindFirstFileA((dir + "\\*").c_str(), &data);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    do {
+        std::string name = data.cFileName;
+        if (name == "." || name == "..") {
+            continue;
+        }
+        // 不进入目录联接和符号链接
+        if (data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) {
+            continue;
+        }
+        entries.push_back({name, (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0});
+    } while (FindNextFileA(handle, &data));
+    FindClose(handle);
+    return true;
+#else
+    DIR* d = opendir(dir.c_str());
+    if (d == nullptr) {
+        return false;
+    }
+    struct dirent* entry;
+    while ((entry = readdir(d)) != nullptr) {
+        std::string name = entry->d_name;
+        if (name == "." || name == "..") {
+            continue;
+        }
+        struct stat st {};
+        if (lstat((dir + "/" + name).c_str(), &st) != 0) {
+            continue;
+        }
+        entries.push_back({name, S_ISDIR(st.st_mode)});
+    }
+    closedir(d);
+    return true;
+#endif
+}
+}  // namespace
+
+bool VolcengineTos::WalkLocalDirectory(const std::string& root, int threads, std::vector<LocalFileInfo>& files,
+                                       std::string& error) {
+#ifdef _WIN32
+    const std::string delimiter = "\\";
+#else
+    const std::string delimiter = "/";
+#endif
+    std::string base = root;
+    while (base.size() > 1 && (base.back() == '/' || base.back() == '\\')) {
+        base.pop_back();
+    }
+    // 待遍历的目录，保存相对路径
+    std::deque<std::string> pending = {""};
+    int busy = 0;
+    bool failed = false;
+    std::mutex mu;
+    std::condition_variable cv;
+    auto worker = [&]() {
+        std::unique_lock<std::mutex> lock(mu);
+        while (true) {
+            cv.wait(lock, [&]() { return !pending.empty() || busy == 0 || failed; });
+            if (failed || pending.empty()) {
+                return;
+            }
+            auto relative = pending.front();
+            pending.pop_front();
+            busy++;
+            lock.unlock();
+
+            auto dir = relative.empty() ? base : base + delimiter + relative;
+            std::vector<DirEntry> entries;
+            bool ok = listDir(dir, entries);
+            std::vector<std::string> dirs;
+            std::vector<LocalFileInfo> found;
+            for (const auto& entry : entries) {
+                auto childRelative = relative.empty() ? entry.name : relative + "/" + entry.name;
+                if (entry.isDir) {
+                    dirs.push_back(childRelative);
+                    continue;
+                }
+                LocalFileInfo info;
+                info.path = dir + delimiter + entry.name;
+                info.relativePath = childRelative;
+                struct stat st {};
+                // 跟随指向文件的符号链接
+                if (stat(info.path.c_str(), &st) != 0 || (st.st_mode & S_IFMT) != S_IFREG) {
+                    continue;
+                }
+                info.size = st.st_size;
+                info.lastModified = st.st_mtime;
+                found.push_back(std::move(info));
+            }
+
+            lock.lock();
+            busy--;
+            if (!ok) {
+                failed = true;
+                error = "open directory failed: " + dir;
+            }
+            for (auto& d : dirs) {
+                pending.push_back(std::move(d));
+            }
+            for (auto& f : found) {
+                files.push_back(std::move(f));
+            }
+            cv.notify_all();
+        }
+    };
+    std::vector<std::thread> threadPool;
+    for (int i = 0; i < std::max(threads, 1); i++) {
+        threadPool.emplace_back(worker);
+    }
+    for (auto& t : threadPool) {
+        t.join();
+    }
+    return !failed;
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace VolcengineTos {
+struct LocalFileInfo {
+    std::string path;
+    // 相对于遍历根目录的路径，分隔符统一为 '/'
+    std::string relativePath;
+    int64_t size = 0;
+    time_t lastModified = 0;
+};
+
+// 多线程遍历本地目录树，返回其中的普通文件，不跟随指向目录的符号链接。
+// 打开目录失败时返回 false，error 中记录失败的目录。
+bool WalkLocalDirectory(const std::string& root, int threads, std::vector<LocalFileInfo>& files, std::string& error);
+}  // namespace VolcengineTos
@@ -0,0 +1,432 @@
+#include "transfer/ObjectAppender.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include "TosClientV2.h"
+#include "../TosClientImpl.h"
+#include "../utils/LogUtils.h"
+#include "utils/crc64.h"
+
+using namespace VolcengineTos;
+
+class ObjectAppender::Impl {
+public:
+    Impl(std::shared_ptr<TosClientImpl> client, const AppendObjectV2Input& input, const AppenderOptions& options);
+    ~Impl();
+
+    bool append(const std::string& data);
+    bool append(const char* data, size_t size);
+    bool flush();
+    bool close();
+    TosError error();
+    AppenderStats stats();
+
+private:
+    using Clock = std::chrono::steady_clock;
+    struct Record {
+        std::string data;
+        Clock::time_point time;
+    };
+
+    void run();
+    // 调用方持有 mu_
+    bool readyToCommit(Clock::time_point now);
+    // 通过 headObject 获取当前对象的长度与 CRC64
+    bool locate(TosError& error);
+    void rollover();
+    // 把 batch 追加到当前对象，结果不确定时通过 headObject 确认
+    bool commit(const std::string& batch, TosError& error);
+    // 返回 1 表示 batch 已追加，0 表示未追加，-1 表示对象已被其他写入方修改或请求失败
+    int recover(const std::string& batch, uint64_t batchCrc, TosError& error);
+    // 连接失败、408、429 与 5xx 可以重试
+    static bool retryable(const TosError& error);
+    // 第 attempt 次重试前等待
+    void backoff(int attempt);
+    void fail(const TosError& error);
+
+    std::shared_ptr<TosClientImpl> client_;
+    AppendObjectV2Input input_;
+    AppenderOptions options_;
+
+    std::mutex mu_;
+    // 有新数据、需要立即提交或关闭时通知后台线程
+    std::condition_variable flushCv_;
+    // 数据提交或失败时通知等待缓冲区空间与 flush 的线程
+    std::condition_variable commitCv_;
+    // 尚未开始提交的数据
+    std::deque<Record> records_;
+    int64_t pending_ = 0;
+    // 包括正在提交的数据
+    int64_t buffered_ = 0;
+    // flush 要求在提交达到该字节数前不等待时间阈值
+    int64_t flushTarget_ = 0;
+    bool closed_ = false;
+    bool failed_ = false;
+    TosError error_;
+    AppenderStats stats_;
+
+    // 以下由后台线程访问
+    std::string key_;
+    int index_ = 0;
+    bool located_ = false;
+    int64_t offset_ = 0;
+    uint64_t crc_ = 0;
+    std::thread flusher_;
+    std::mutex closeMu_;
+};
+
+ObjectAppender::ObjectAppender(const TosClientV2& client, const AppendObjectV2Input& input,
+                               const AppenderOptions& options)
+        : impl_(std::make_shared<Impl>(client.tosClientImpl_, input, options)) {
+}
+
+ObjectAppender::~ObjectAppender() = default;
+
+bool ObjectAppender::append(const std::string& data) {
+    return impl_->append(data);
+}
+
+bool ObjectAppender::append(const char* data, size_t size) {
+    return impl_->append(data, size);
+}
+
+bool ObjectAppender::flush() {
+    return impl_->flush();
+}
+
+bool ObjectAppender::close() {
+    return impl_->close();
+}
+
+TosError ObjectAppender::error() {
+    return impl_->error();
+}
+
+AppenderStats ObjectAppender::stats() {
+    return impl_->stats();
+}
+
+static TosError appenderError(const std::string& message) {
+    TosError error;
+    error.setIsClientError(true);
+    error.setMessage(message);
+    return error;
+}
+
+ObjectAppender::Impl::Impl(std::shared_ptr<TosClientImpl> client, const AppendObjectV2Input& input,
+                           const AppenderOptions& options)
+        : client_(std::move(client)), input_(input), options_(options), key_(input.getKey()) {
+    if (options_.maxBufferBytes <= 0) {
+        options_.maxBufferBytes = AppenderOptions().maxBufferBytes;
+    }
+    options_.flushBytes = std::min(std::max<int64_t>(options_.flushBytes, 1), options_.maxBufferBytes);
+    options_.flushIntervalMillis = std::max(options_.flushIntervalMillis, 0);
+    stats_.key = key_;
+    flusher_ = std::thread(&ObjectAppender::Impl::run, this);
+}
+
+ObjectAppender::Impl::~Impl() {
+    close();
+}
+
+bool ObjectAppender::Impl::append(const std::string& data) {
+    return append(data.data(), data.size());
+}
+
+bool ObjectAppender::Impl::append(const char* data, size_t size) {
+    std::unique_lock<std::mutex> lock(mu_);
+    auto length = static_cast<int64_t>(size);
+    // 缓冲区为空时超过上限的数据也可以写入
+    commitCv_.wait(lock, [&] {
+        return closed_ || failed_ || buffered_ == 0 || buffered_ + length <= options_.maxBufferBytes;
+    });
+    if (closed_ || failed_) {
+        return false;
+    }
+    if (size == 0) {
+        return true;
+    }
+    Record record;
+    record.data.assign(data, size);
+    record.time = Clock::now();
+    records_.push_back(std::move(record));
+    pending_ += length;
+    buffered_ += length;
+    stats_.appendedBytes += length;
+    if (records_.size() == 1 || pending_ >= options_.flushBytes) {
+        flushCv_.notify_one();
+    }
+    return true;
+}
+
+bool ObjectAppender::Impl::flush() {
+    std::unique_lock<std::mutex> lock(mu_);
+    auto target = stats_.appendedBytes;
+    flushTarget_ = std::max(flushTarget_, target);
+    flushCv_.notify_one();
+    commitCv_.wait(lock, [&] { return failed_ || stats_.committedBytes >= target; });
+    return stats_.committedBytes >= target;
+}
+
+bool ObjectAppender::Impl::close() {
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        closed_ = true;
+        flushCv_.notify_one();
+        commitCv_.notify_all();
+    }
+    {
+        std::lock_guard<std::mutex> lock(closeMu_);
+        if (flusher_.joinable()) {
+            flusher_.join();
+        }
+    }
+    std::lock_guard<std::mutex> lock(mu_);
+    return !failed_;
+}
+
+TosError ObjectAppender::Impl::error() {
+    std::lock_guard<std::mutex> lock(mu_);
+    return error_;
+}
+
+AppenderStats ObjectAppender::Impl::stats() {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto stats = stats_;
+    stats.bufferedBytes = buffered_;
+    return stats;
+}
+
+bool ObjectAppender::Impl::readyToCommit(Clock::time_point now) {
+    if (records_.empty()) {
+        return false;
+    }
+    return closed_ || pending_ >= options_.flushBytes || flushTarget_ > stats_.committedBytes ||
+           now - records_.front().time >= std::chrono::milliseconds(options_.flushIntervalMillis);
+}
+
+void ObjectAppender::Impl::run() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mu_);
+            while (!readyToCommit(Clock::now())) {
+                if (closed_ && records_.empty()) {
+                    return;
+                }
+                if (records_.empty()) {
+                    flushCv_.wait(lock);
+                } else {
+                    flushCv_.wait_until(lock,
+                                        records_.front().time + std::chrono::milliseconds(options_.flushIntervalMillis));
+                }
+            }
+        }
+        TosError error;
+        if (!located_ && !locate(error)) {
+            fail(error);
+            return;
+        }
+        // 合并已缓冲的数据，不超过当前对象的剩余空间
+        std::string batch;
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            auto limit = std::numeric_limits<int64_t>::max();
+            if (options_.maxObjectSize > 0) {
+                limit = options_.maxObjectSize - offset_;
+            }
+            while (!records_.empty()) {
+                auto& record = records_.front();
+                auto size = static_cast<int64_t>(batch.size() + record.data.size());
+                // 新对象的第一条数据总是写入，避免超过 maxObjectSize 的单条数据无法提交
+                if (size > limit && (offset_ > 0 || !batch.empty())) {
+                    break;
+                }
+                batch.append(record.data);
+                records_.pop_front();
+            }
+            pending_ -= static_cast<int64_t>(batch.size());
+        }
+        if (batch.empty()) {
+            rollover();
+            continue;
+        }
+        auto size = static_cast<int64_t>(batch.size());
+        if (!commit(batch, error)) {
+            {
+                // 未提交的数据放回缓冲区
+                std::lock_guard<std::mutex> lock(mu_);
+                Record record;
+                record.data = std::move(batch);
+                record.time = Clock::now();
+                records_.push_front(std::move(record));
+                pending_ += size;
+            }
+            fail(error);
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mu_);
+        buffered_ -= size;
+        stats_.committedBytes += size;
+        stats_.commits++;
+        stats_.nextOffset = offset_;
+        commitCv_.notify_all();
+    }
+}
+
+bool ObjectAppender::Impl::locate(TosError& error) {
+    auto res = client_->headObject(HeadObjectV2Input(input_.getBucket(), key_));
+    for (int attempt = 1; !res.isSuccess() && attempt <= options_.maxRetries && retryable(res.error()); attempt++) {
+        backoff(attempt);
+        res = client_->headObject(HeadObjectV2Input(input_.getBucket(), key_));
+    }
+    if (!res.isSuccess()) {
+        if (res.error().getStatusCode() == 404) {
+            offset_ = 0;
+            crc_ = 0;
+            located_ = true;
+            return true;
+        }
+        error = res.error();
+        return false;
+    }
+    if (res.result().getObjectType() != "Appendable") {
+        error = appenderError("object " + key_ + " is not appendable");
+        return false;
+    }
+    offset_ = res.result().getContentLength();
+    crc_ = res.result().getHashCrc64Ecma();
+    located_ = true;
+    std::lock_guard<std::mutex> lock(mu_);
+    stats_.nextOffset = offset_;
+    return true;
+}
+
+void ObjectAppender::Impl::rollover() {
+    index_++;
+    key_ = options_.rolloverKey != nullptr ? options_.rolloverKey(input_.getKey(), index_)
+                                           : input_.getKey() + "." + std::to_string(index_);
+    located_ = false;
+    auto logger = LogUtils::GetLogger(LogCategoryTransfer, LogInfo);
+    if (logger != nullptr) {
+        logger->info("append object roll over to {} at offset {}", key_, offset_);
+    }
+    std::lock_guard<std::mutex> lock(mu_);
+    stats_.rollovers++;
+    stats_.key = key_;
+    stats_.nextOffset = 0;
+}
+
+bool ObjectAppender::Impl::commit(const std::string& batch, TosError& error) {
+    auto size = static_cast<int64_t>(batch.size());
+    auto batchCrc = CRC64::CalcCRC(0, const_cast<char*>(batch.data()), batch.size());
+    for (int attempt = 0;; attempt++) {
+        if (attempt > 0) {
+            backoff(attempt);
+        }
+        auto input = input_;
+        input.setKey(key_);
+        input.setOffset(offset_);
+        input.setContent(std::make_shared<std::stringstream>(batch));
+        input.setContentLength(size);
+        // 以已提交部分的 CRC64 为初值，校验的是整个对象的 CRC64
+        input.setPreHashCrc64Ecma(crc_);
+        auto res = client_->appendObject(input);
+        if (res.isSuccess()) {
+            offset_ = res.result().getNextAppendOffset();
+            auto crc = res.result().getHashCrc64ecma();
+            crc_ = crc != 0 ? crc : CRC64::CombineCRC(crc_, batchCrc, size);
+            return true;
+        }
+        error = res.error();
+        auto statusCode = error.getStatusCode();
+        // 连接断开、5xx、crc 校验失败时请求可能已生效，请求级重试的追加可能因为上一次已生效返回 409
+        if (statusCode <= 0 || statusCode >= 500 || statusCode == 409) {
+            auto recovered = recover(batch, batchCrc, error);
+            if (recovered > 0) {
+                return true;
+            }
+            if (recovered < 0) {
+                return false;
+            }
+        } else if (!retryable(error)) {
+            return false;
+        }
+        if (attempt >= options_.maxRetries) {
+            return false;
+        }
+    }
+}
+
+int ObjectAppender::Impl::recover(const std::string& batch, uint64_t batchCrc, TosError& error) {
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        stats_.recoveries++;
+    }
+    auto size = static_cast<int64_t>(batch.size());
+    auto res = client_->headObject(HeadObjectV2Input(input_.getBucket(), key_));
+    if (!res.isSuccess()) {
+        auto statusCode = res.error().getStatusCode();
+        if (statusCode == 404 && offset_ == 0) {
+            return 0;
+        }
+        if (statusCode <= 0 || statusCode >= 500) {
+            return 0;
+        }
+        error = res.error();
+        return -1;
+    }
+    if (res.result().getObjectType() != "Appendable") {
+        error = appenderError("object " + key_ + " is not appendable");
+        return -1;
+    }
+    auto length = res.result().getContentLength();
+    if (length == offset_) {
+        return 0;
+    }
+    if (length == offset_ + size) {
+        auto expected = CRC64::CombineCRC(crc_, batchCrc, size);
+        auto crc = res.result().getHashCrc64Ecma();
+        if (crc != 0 && crc != expected) {
+            error = appenderError("object " + key_ + " CRC64 mismatch after append at offset " +
+                                  std::to_string(offset_));
+            return -1;
+        }
+        auto logger = LogUtils::GetLogger(LogCategoryTransfer, LogInfo);
+        if (logger != nullptr) {
+            logger->info("append to {} at offset {} has taken effect, length {}", key_, offset_, length);
+        }
+        offset_ = length;
+        crc_ = expected;
+        return 1;
+    }
+    error = appenderError("object " + key_ + " was modified by another writer, expected length " +
+                          std::to_string(offset_) + ", actual " + std::to_string(length));
+    return -1;
+}
+
+bool ObjectAppender::Impl::retryable(const TosError& error) {
+    auto statusCode = error.getStatusCode();
+    return statusCode <= 0 || statusCode == 408 || statusCode == 429 || statusCode >= 500;
+}
+
+void ObjectAppender::Impl::backoff(int attempt) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(int64_t(options_.retryBackoffMillis) * attempt));
+    std::lock_guard<std::mutex> lock(mu_);
+    stats_.retries++;
+}
+
+void ObjectAppender::Impl::fail(const TosError& error) {
+    auto logger = LogUtils::GetLogger(LogCategoryTransfer, LogInfo);
+    if (logger != nullptr) {
+        logger->info("append object {} failed: {}", key_, error.getMessage());
+    }
+    std::lock_guard<std::mutex> lock(mu_);
+    failed_ = true;
+    error_ = error;
+    commitCv_.notify_all();
+}
@@ -0,0 +1,356 @@
+#include "transfer/ObjectReadSession.h"
+#include "RequestBuilder.h"
+#include "TosClientV2.h"
+#include "../TosClientImpl.h"
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+using namespace VolcengineTos;
+
+class ObjectReadSession::Impl {
+public:
+    Impl(std::shared_ptr<TosClientImpl> client, const GetObjectV2Input& input, const ReadSessionOptions& options);
+    ~Impl();
+
+    Outcome<TosError, GetObjectV2Output> read(int64_t start, int64_t end);
+    ReadSessionStats stats() const;
+
+private:
+    struct PrefetchResult {
+        Outcome<TosError, GetObjectV2Output> outcome;
+        std::string data;
+    };
+    struct Window {
+        int64_t start = 0;
+        int64_t end = 0;
+        int64_t consumed = 0;
+        std::shared_future<PrefetchResult> result;
+    };
+
+    GetObjectV2Input rangeInput(int64_t start, int64_t end, bool prefetch) const;
+    static PrefetchResult fetch(TosClientImpl& client, const GetObjectV2Input& input);
+    void learnObject(const GetObjectBasicOutput& basicOutput);
+    bool readFromWindows(int64_t start, int64_t end, std::string& data, GetObjectBasicOutput& basicOutput);
+    void updatePattern(int64_t start, int64_t end);
+    void schedule();
+    void launch(int64_t start, int64_t end);
+    int64_t bufferedBytes() const;
+    void dropWindow(const std::shared_ptr<Window>& window);
+    void reapRetired(bool wait);
+
+    std::shared_ptr<TosClientImpl> client_;
+    GetObjectV2Input input_;
+    ReadSessionOptions options_;
+    mutable std::mutex mu_;
+    // 按 start 排序
+    std::deque<std::shared_ptr<Window>> windows_;
+    // 已丢弃但仍在进行的预读请求
+    std::vector<std::shared_future<PrefetchResult>> retired_;
+    std::string etag_;
+    int64_t objectSize_ = -1;
+    int64_t window_ = 0;
+    int64_t lastStart_ = -1;
+    int64_t lastEnd_ = -1;
+    int64_t stride_ = 0;
+    bool sequential_ = false;
+    bool strided_ = false;
+    ReadSessionStats stats_;
+};
+
+ObjectReadSession::ObjectReadSession(const TosClientV2& client, const GetObjectV2Input& input,
+                                     const ReadSessionOptions& options)
+        : impl_(std::make_shared<Impl>(client.tosClientImpl_, input, options)) {
+}
+
+ObjectReadSession::~ObjectReadSession() = default;
+
+Outcome<TosError, GetObjectV2Output> ObjectReadSession::read(int64_t start, int64_t end) {
+    return impl_->read(start, end);
+}
+
+ReadSessionStats ObjectReadSession::stats() const {
+    return impl_->stats();
+}
+
+ObjectReadSession::Impl::Impl(std::shared_ptr<TosClientImpl> client, const GetObjectV2Input& input,
+                              const ReadSessionOptions& options)
+        : client_(std::move(client)), input_(input), options_(options) {
+    if (options_.minWindow <= 0) {
+        options_.minWindow = ReadSessionOptions().minWindow;
+    }
+    options_.maxWindow = std::max(options_.maxWindow, options_.minWindow);
+    window_ = std::min(std::max(options_.initialWindow, options_.minWindow), options_.maxWindow);
+    stats_.window = window_;
+}
+
+ObjectReadSession::Impl::~Impl() {
+    std::lock_guard<std::mutex> lock(mu_);
+    while (!windows_.empty()) {
+        dropWindow(windows_.front());
+        windows_.pop_front();
+    }
+    reapRetired(true);
+}
+
+GetObjectV2Input ObjectReadSession::Impl::rangeInput(int64_t start, int64_t end, bool prefetch) const {
+    GetObjectV2Input input = input_;
+    input.setRangeStart(0);
+    input.setRangeEnd(0);
+    input.setRange(HttpRange(start, end).toString());
+    // 预读的数据要与已读到的数据属于同一版本
+    if (prefetch && !etag_.empty()) {
+        input.setIfMatch(etag_);
+    }
+    return input;
+}
+
+ObjectReadSession::Impl::PrefetchResult ObjectReadSession::Impl::fetch(TosClientImpl& client,
+                                                                       const GetObjectV2Input& input) {
+    PrefetchResult result;
+    result.outcome = client.getObject(input, nullptr, nullptr);
+    if (result.outcome.isSuccess()) {
+        auto content = result.outcome.result().getContent();
+        if (content != nullptr) {
+            std::stringstream ss;
+            ss << content->rdbuf();
+            result.data = ss.str();
+        }
+        result.outcome.result().setContent(nullptr);
+    }
+    return result;
+}
+
+void ObjectReadSession::Impl::learnObject(const GetObjectBasicOutput& basicOutput) {
+    if (etag_.empty()) {
+        etag_ = basicOutput.getETags();
+    }
+    // Content-Range: bytes start-end/total
+    const auto& contentRange = basicOutput.getContentRange();
+    auto slash = contentRange.find('/');
+    if (slash != std::string::npos && slash + 1 < contentRange.size()) {
+        char* endPtr = nullptr;
+        auto size = std::strtoll(contentRange.c_str() + slash + 1, &endPtr, 10);
+        if (endPtr != nullptr && *endPtr == '\0' && size >= 0) {
+            objectSize_ = size;
+        }
+    } else if (contentRange.empty()) {
+        objectSize_ = basicOutput.getContentLength();
+    }
+}
+
+void ObjectReadSession::Impl::updatePattern(int64_t start, int64_t end) {
+    if (lastStart_ >= 0) {
+        sequential_ = start == lastEnd_ + 1;
+        // 连续两次步长和长度相同才认为是跳读
+        auto stride = start - lastStart_;
+        strided_ = !sequential_ && stride > 0 && stride == stride_ && end - start == lastEnd_ - lastStart_;
+        stride_ = stride;
+    }
+    lastStart_ = start;
+    lastEnd_ = end;
+}
+
+int64_t ObjectReadSession::Impl::bufferedBytes() const {
+    int64_t bytes = 0;
+    for (const auto& window : windows_) {
+        bytes += window->end - window->start + 1 - window->consumed;
+    }
+    return bytes;
+}
+
+void ObjectReadSession::Impl::dropWindow(const std::shared_ptr<Window>& window) {
+    int64_t wasted = window->end - window->start + 1 - window->consumed;
+    if (window->result.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        const auto& result = window->result.get();
+        wasted = result.outcome.isSuccess() ? static_cast<int64_t>(result.data.size()) - window->consumed : 0;
+    } else {
+        retired_.push_back(window->result);
+    }
+    if (wasted > 0) {
+        stats_.wastedBytes += wasted;
+        // 预读的数据没有被读取，缩小窗口
+        window_ = std::max(window_ / 2, options_.minWindow);
+    }
+}
+
+void ObjectReadSession::Impl::reapRetired(bool wait) {
+    auto it = retired_.begin();
+    while (it != retired_.end()) {
+        if (wait) {
+            it->wait();
+        } else if (it->wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ++it;
+            continue;
+        }
+        it = retired_.erase(it);
+    }
+}
+
+void ObjectReadSession::Impl::launch(int64_t start, int64_t end) {
+    auto window = std::make_shared<Window>();
+    window->start = start;
+    window->end = end;
+    // 析构前会等待全部预读请求完成，任务中只持有裸指针，避免在线程池的线程中释放 client
+    auto client = client_.get();
+    auto input = rangeInput(start, end, true);
+    auto promise = std::make_shared<std::promise<PrefetchResult>>();
+    window->result = promise->get_future().share();
+    client_->executor()->submit([client, input, promise]() { promise->set_value(fetch(*client, input)); });
+    windows_.push_back(window);
+    stats_.prefetchRequests++;
+    stats_.prefetchedBytes += end - start + 1;
+}
+
+void ObjectReadSession::Impl::schedule() {
+    if (options_.prefetchWindows <= 0 || objectSize_ < 0) {
+        return;
+    }
+    auto windows = static_cast<size_t>(options_.prefetchWindows);
+    if (sequential_) {
+        auto pos = lastEnd_ + 1;
+        if (!windows_.empty()) {
+            pos = std::max(pos, windows_.back()->end + 1);
+        }
+        while (windows_.size() < windows && pos < objectSize_ &&
+               bufferedBytes() + window_ <= options_.maxBufferedBytes) {
+            auto end = std::min(pos + window_ - 1, objectSize_ - 1);
+            launch(pos, end);
+            pos = end + 1;
+        }
+    } else if (strided_) {
+        auto length = lastEnd_ - lastStart_ + 1;
+        for (int k = 1; k <= options_.prefetchWindows && windows_.size() < windows; k++) {
+            auto start = lastStart_ + k * stride_;
+            if (start >= objectSize_ || bufferedBytes() + length > options_.maxBufferedBytes) {
+                break;
+            }
+            if (!windows_.empty() && windows_.back()->start >= start) {
+                continue;
+            }
+            launch(start, std::min(start + length - 1, objectSize_ - 1));
+        }
+    }
+}
+
+bool ObjectReadSession::Impl::readFromWindows(int64_t start, int64_t end, std::string& data,
+                                              GetObjectBasicOutput& basicOutput) {
+    std::vector<std::shared_ptr<Window>> covering;
+    auto pos = start;
+    for (const auto& window : windows_) {
+        if (window->end < pos) {
+            continue;
+        }
+        if (window->start > pos) {
+            break;
+        }
+        covering.push_back(window);
+        pos = window->end + 1;
+        if (pos > end) {
+            break;
+        }
+    }
+    if (covering.empty() || pos <= end) {
+        return false;
+    }
+    bool waited = false;
+    for (const auto& window : covering) {
+        if (window->result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            waited = true;
+        }
+        const auto& result = window->result.get();
+        if (!result.outcome.isSuccess()) {
+            return false;
+        }
+    }
+    data.clear();
+    data.reserve(end - start + 1);
+    pos = start;
+    for (const auto& window : covering) {
+        const auto& result = window->result.get();
+        auto windowEnd = window->start + static_cast<int64_t>(result.data.size()) - 1;
+        auto to = std::min(end, windowEnd);
+        if (to < pos) {
+            return false;
+        }
+        data.append(result.data, pos - window->start, to - pos + 1);
+        window->consumed += to - pos + 1;
+        pos = to + 1;
+    }
+    if (pos <= end) {
+        return false;
+    }
+    basicOutput = covering.front()->result.get().outcome.result().getGetObjectBasicOutput();
+    stats_.prefetchHits++;
+    stats_.consumedBytes += data.size();
+    if (waited) {
+        // 读取比预读快，扩大窗口以减少请求次数
+        stats_.prefetchWaits++;
+        window_ = std::min(window_ * 2, options_.maxWindow);
+    }
+    return true;
+}
+
+Outcome<TosError, GetObjectV2Output> ObjectReadSession::Impl::read(int64_t start, int64_t end) {
+    Outcome<TosError, GetObjectV2Output> res;
+    if (start < 0 || end < start) {
+        TosError error;
+        error.setIsClientError(true);
+        error.setMessage("invalid range format");
+        res.setE(error);
+        res.setSuccess(false);
+        return res;
+    }
+    std::lock_guard<std::mutex> lock(mu_);
+    stats_.reads++;
+    reapRetired(false);
+    if (objectSize_ >= 0 && start < objectSize_) {
+        end = std::min(end, objectSize_ - 1);
+    }
+    updatePattern(start, end);
+
+    std::string data;
+    GetObjectBasicOutput basicOutput;
+    if (!readFromWindows(start, end, data, basicOutput)) {
+        auto result = fetch(*client_, rangeInput(start, end, false));
+        if (!result.outcome.isSuccess()) {
+            return std::move(result.outcome);
+        }
+        basicOutput = result.outcome.result().getGetObjectBasicOutput();
+        // 对象已变化时丢弃全部预读
+        if (!etag_.empty() && basicOutput.getETags() != etag_) {
+            etag_.clear();
+            sequential_ = false;
+            strided_ = false;
+        }
+        learnObject(basicOutput);
+        data = std::move(result.data);
+    }
+    // 丢弃已经读过的窗口，访问模式被打断时丢弃全部窗口
+    while (!windows_.empty() && (windows_.front()->end <= end || (!sequential_ && !strided_))) {
+        dropWindow(windows_.front());
+        windows_.pop_front();
+    }
+    schedule();
+    stats_.window = window_;
+
+    auto length = static_cast<int64_t>(data.size());
+    basicOutput.setContentLength(length);
+    basicOutput.setContentRange("bytes " + std::to_string(start) + "-" + std::to_string(start + length - 1) + "/" +
+                                (objectSize_ >= 0 ? std::to_string(objectSize_) : "*"));
+    GetObjectV2Output output;
+    output.setGetObjectBasicOutput(basicOutput);
+    output.setContent(std::make_shared<std::stringstream>(std::move(data)));
+    res.setSuccess(true);
+    res.setR(std::move(output));
+    return res;
+}
+
+ReadSessionStats ObjectReadSession::Impl::stats() const {
+    std::lock_guard<std::mutex> lock(mu_);
+    return stats_;
+}
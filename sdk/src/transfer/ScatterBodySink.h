@@ -0,0 +1,44 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "transport/http/Body.h"
+
+namespace VolcengineTos {
+// 对象中 [offset, offset + length) 的数据写入 buffer
+struct ScatterTarget {
+    int64_t offset = 0;
+    int64_t length = 0;
+    char* buffer = nullptr;
+    // 实际写入的字节数
+    int64_t written = 0;
+};
+
+// 把从 start 开始的响应体按对象偏移直接拷贝到调用方的内存中，不在中间缓冲。
+// targets 之间的空洞数据被丢弃。重试时从偏移 0 重新写入，覆盖之前的数据
+class ScatterBodySink : public BodySink {
+public:
+    ScatterBodySink(int64_t start, std::vector<ScatterTarget*> targets)
+            : start_(start), targets_(std::move(targets)) {
+    }
+    bool writeAt(int64_t offset, const char* data, int64_t len) override {
+        int64_t begin = start_ + offset;
+        int64_t end = begin + len;
+        for (auto target : targets_) {
+            int64_t from = std::max(begin, target->offset);
+            int64_t to = std::min(end, target->offset + target->length);
+            if (from < to) {
+                std::memcpy(target->buffer + (from - target->offset), data + (from - begin), to - from);
+                target->written = std::max(target->written, to - target->offset);
+            }
+        }
+        return true;
+    }
+
+private:
+    int64_t start_;
+    std::vector<ScatterTarget*> targets_;
+};
+}  // namespace VolcengineTos
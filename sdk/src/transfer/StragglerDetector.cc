@@ -0,0 +1,236 @@
+#include "transfer/StragglerDetector.h"
+#include <algorithm>
+#include <limits>
+#include "metrics/Metrics.h"
+#include "utils/BaseUtils.h"
+#include "../utils/LogUtils.h"
+
+using namespace VolcengineTos;
+
+StragglerDetector::StragglerDetector(const StragglerOptions& options, const DataTransferListener& listener)
+        : options_(options), listener_(listener) {
+    if (options_.checkIntervalMillis > 0) {
+        checker_ = std::thread(&StragglerDetector::checkLoop, this);
+    }
+}
+
+StragglerDetector::~StragglerDetector() {
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    if (checker_.joinable()) {
+        checker_.join();
+    }
+}
+
+std::shared_ptr<StragglerAttempt> StragglerDetector::begin(int partNumber, int64_t size) {
+    auto attempt = std::make_shared<StragglerAttempt>();
+    attempt->partNumber = partNumber;
+    attempt->detector_ = this;
+    if (listener_.dataTransferStatusChange_ != nullptr) {
+        attempt->listener = {progress, attempt.get()};
+    }
+    std::lock_guard<std::mutex> lock(mu_);
+    auto& part = parts_[partNumber];
+    part.size = size;
+    part.attempts.push_back(attempt);
+    return attempt;
+}
+
+std::shared_ptr<StragglerAttempt> StragglerDetector::beginDuplicate() {
+    if (!options_.duplicateTail) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(mu_);
+    if (completedRates_.empty()) {
+        return nullptr;
+    }
+    std::vector<double> rates = completedRates_;
+    std::nth_element(rates.begin(), rates.begin() + rates.size() / 2, rates.end());
+    double median = rates[rates.size() / 2];
+    // 只为唯一请求已进行足够久、且剩余耗时超过按中位数吞吐重新请求所需耗时的分片发起重复请求
+    int target = -1;
+    double longest = 0;
+    for (const auto& p : parts_) {
+        const auto& part = p.second;
+        if (part.done || part.attempts.size() != 1 || part.attempts[0]->restart_) {
+            continue;
+        }
+        const auto& monitor = part.attempts[0]->monitor;
+        if (monitor->elapsedMillis() < options_.minElapsedMillis) {
+            continue;
+        }
+        double rate = rateOf(*part.attempts[0]);
+        double remaining = rate > 0 ? (part.size - monitor->transferred()) / rate
+                                    : std::numeric_limits<double>::max();
+        if (remaining > part.size / median && remaining > longest) {
+            target = p.first;
+            longest = remaining;
+        }
+    }
+    if (target < 0) {
+        return nullptr;
+    }
+    auto attempt = std::make_shared<StragglerAttempt>();
+    attempt->partNumber = target;
+    attempt->duplicate = true;
+    attempt->detector_ = this;
+    if (listener_.dataTransferStatusChange_ != nullptr) {
+        attempt->listener = {progress, attempt.get()};
+    }
+    parts_[target].attempts.push_back(attempt);
+    duplicates_++;
+    if (MetricsRegistry::Enabled()) {
+        MetricsRegistry::instance()->recordStragglerDuplicate();
+    }
+    auto logger = LogUtils::GetLogger(LogCategoryTransfer, LogInfo);
+    if (logger != nullptr) {
+        logger->info("duplicate part {}, estimated remaining {} s", target, static_cast<int64_t>(longest));
+    }
+    return attempt;
+}
+
+StragglerDetector::FinishResult StragglerDetector::finish(const std::shared_ptr<StragglerAttempt>& attempt,
+                                                          bool success) {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto& part = parts_[attempt->partNumber];
+    part.attempts.erase(std::remove(part.attempts.begin(), part.attempts.end(), attempt), part.attempts.end());
+    if (part.done) {
+        return PartSuperseded;
+    }
+    if (success) {
+        part.done = true;
+        auto elapsed = std::max<int64_t>(attempt->monitor->elapsedMillis(), 1);
+        completedRates_.push_back(static_cast<double>(part.size) * 1000 / elapsed);
+        // 先完成者生效，中止同一分片的其他请求
+        for (const auto& other : part.attempts) {
+            other->monitor->abort();
+        }
+        return PartSucceed;
+    }
+    if (attempt->restart_) {
+        return PartRestart;
+    }
+    return part.attempts.empty() ? PartFailed : PartSuperseded;
+}
+
+bool StragglerDetector::busy() {
+    std::lock_guard<std::mutex> lock(mu_);
+    for (const auto& p : parts_) {
+        if (!p.second.done && !p.second.attempts.empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+double StragglerDetector::rateOf(const StragglerAttempt& attempt) {
+    auto elapsed = attempt.monitor->elapsedMillis();
+    if (elapsed <= 0) {
+        return 0;
+    }
+    return static_cast<double>(attempt.monitor->transferred()) * 1000 / elapsed;
+}
+
+double StragglerDetector::medianRate() {
+    std::vector<double> rates = completedRates_;
+    for (const auto& p : parts_) {
+        for (const auto& attempt : p.second.attempts) {
+            if (attempt->monitor->elapsedMillis() >= options_.minElapsedMillis) {
+                rates.push_back(rateOf(*attempt));
+            }
+        }
+    }
+    if (rates.empty() || static_cast<int>(rates.size()) < options_.minSamples) {
+        return -1;
+    }
+    std::nth_element(rates.begin(), rates.begin() + rates.size() / 2, rates.end());
+    return rates[rates.size() / 2];
+}
+
+void StragglerDetector::check() {
+    std::lock_guard<std::mutex> lock(mu_);
+    double median = medianRate();
+    if (median <= 0) {
+        return;
+    }
+    auto logger = LogUtils::GetLogger(LogCategoryTransfer, LogInfo);
+    for (auto& p : parts_) {
+        auto& part = p.second;
+        // 已有重复请求的分片交给重复请求，不再重启
+        if (part.done || part.attempts.size() != 1 || part.restarts >= options_.maxRestarts) {
+            continue;
+        }
+        auto& attempt = part.attempts[0];
+        if (attempt->duplicate || attempt->restart_ ||
+            attempt->monitor->elapsedMillis() < options_.minElapsedMillis) {
+            continue;
+        }
+        double rate = rateOf(*attempt);
+        if (rate >= median * options_.slowRatio) {
+            continue;
+        }
+        attempt->restart_ = true;
+        attempt->monitor->abort();
+        part.restarts++;
+        restarts_++;
+        if (MetricsRegistry::Enabled()) {
+            MetricsRegistry::instance()->recordStragglerRestart();
+        }
+        if (logger != nullptr) {
+            logger->info("restart part {}, throughput {} B/s, median {} B/s", p.first, static_cast<int64_t>(rate),
+                         static_cast<int64_t>(median));
+        }
+    }
+}
+
+void StragglerDetector::checkLoop() {
+    std::unique_lock<std::mutex> lock(mu_);
+    while (!stop_) {
+        cv_.wait_for(lock, std::chrono::milliseconds(options_.checkIntervalMillis), [this] { return stop_; });
+        if (stop_) {
+            break;
+        }
+        lock.unlock();
+        check();
+        lock.lock();
+    }
+}
+
+uint64_t StragglerDetector::restarts() {
+    std::lock_guard<std::mutex> lock(mu_);
+    return restarts_;
+}
+
+uint64_t StragglerDetector::duplicates() {
+    std::lock_guard<std::mutex> lock(mu_);
+    return duplicates_;
+}
+
+void StragglerDetector::progress(const std::shared_ptr<DataTransferStatus>& status) {
+    auto attempt = static_cast<StragglerAttempt*>(status->userData_);
+    attempt->detector_->onProgress(attempt, *status);
+}
+
+void StragglerDetector::onProgress(StragglerAttempt* attempt, const DataTransferStatus& status) {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto& part = parts_[attempt->partNumber];
+    int64_t delta = 0;
+    if (status.type_ == 4) {
+        // 被中止的请求不算作传输失败
+        if (attempt->monitor->aborted()) {
+            return;
+        }
+    } else {
+        // consumedBytes_ 在请求重试时从 0 开始，只转发超过该分片已转发进度的部分
+        if (status.consumedBytes_ <= part.credited && status.rwOnceBytes_ > 0) {
+            return;
+        }
+        delta = std::max<int64_t>(status.consumedBytes_ - part.credited, 0);
+        part.credited += delta;
+    }
+    DataTransferStatus forward{part.credited, part.size, delta, status.type_, listener_.userData_};
+    listener_.dataTransferStatusChange_(std::make_shared<DataTransferStatus>(forward));
+}
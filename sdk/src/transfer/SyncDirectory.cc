@@ -0,0 +1,439 @@
+#include "../src/external/json/json.hpp"
+#include "../TosClientImpl.h"
+#include "LocalFileWalker.h"
+#include "utils/crc64.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <sys/stat.h>
+
+using namespace VolcengineTos;
+
+namespace {
+const int64_t largeFileSize = 8 * 1024 * 1024;
+const size_t maxDeleteKeys = 1000;
+
+// 状态文件中一个本地文件的记录
+struct SyncState {
+    int64_t size;
+    time_t lastModified;
+    uint64_t crc64;
+};
+
+// {"Files":{"相对路径":{"Size":1,"LastModified":1,"Crc64":1}}}
+std::map<std::string, SyncState> loadSyncState(const std::string& path) {
+    std::map<std::string, SyncState> states;
+    if (path.empty()) {
+        return states;
+    }
+    std::ifstream ifs(path, std::ios::in);
+    if (!ifs.good()) {
+        return states;
+    }
+    auto j = nlohmann::json::parse(ifs, nullptr, false);
+    if (j.is_discarded() || !j.is_object() || !j.contains("Files") || !j.at("Files").is_object()) {
+        return states;
+    }
+    for (auto it = j.at("Files").begin(); it != j.at("Files").end(); ++it) {
+        if (!it.value().is_object()) {
+            continue;
+        }
+        SyncState state{};
+        state.size = it.value().value("Size", int64_t(0));
+        state.lastModified = it.value().value("LastModified", int64_t(0));
+        state.crc64 = it.value().value("Crc64", uint64_t(0));
+        states[it.key()] = state;
+    }
+    return states;
+}
+
+// 先写临时文件再重命名，避免中断时留下不完整的状态文件
+bool saveSyncState(const std::string& path, const std::map<std::string, SyncState>& states) {
+    nlohmann::json files = nlohmann::json::object();
+    for (const auto& state : states) {
+        nlohmann::json j;
+        j["Size"] = state.second.size;
+        j["LastModified"] = static_cast<int64_t>(state.second.lastModified);
+        j["Crc64"] = state.second.crc64;
+        files[state.first] = j;
+    }
+    nlohmann::json root;
+    root["Files"] = files;
+    auto tempPath = path + ".temp";
+    {
+        std::ofstream ofs(tempPath, std::ios::out | std::ios::trunc);
+        ofs << root.dump();
+        if (!ofs.good()) {
+            return false;
+        }
+    }
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::remove(path.c_str());
+        return std::rename(tempPath.c_str(), path.c_str()) == 0;
+    }
+    return true;
+}
+
+struct SyncFile {
+    LocalFileInfo info;
+    bool hashed = false;
+    uint64_t crc64 = 0;
+};
+
+// 小文件由多个线程各自计算，大文件逐个使用 CRC64::CalcFileCRC 在文件内分块并发计算
+void hashFilesConcurrent(std::vector<SyncFile*>& files, int taskNum, const std::function<bool()>& canceled) {
+    std::vector<SyncFile*> smallFiles;
+    for (auto file : files) {
+        if (file->info.size <= largeFileSize) {
+            smallFiles.push_back(file);
+            continue;
+        }
+        if (canceled()) {
+            return;
+        }
+        file->hashed = CRC64::CalcFileCRC(file->info.path, taskNum, file->crc64);
+    }
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        size_t index;
+        while ((index = next++) < smallFiles.size() && !canceled()) {
+            auto file = smallFiles[index];
+            file->hashed = CRC64::CalcFileCRC(file->info.path, 1, file->crc64);
+        }
+    };
+    std::vector<std::thread> threadPool;
+    auto threads = std::min<size_t>(taskNum, smallFiles.size());
+    for (size_t i = 0; i < threads; i++) {
+        threadPool.emplace_back(worker);
+    }
+    for (auto& t : threadPool) {
+        t.join();
+    }
+}
+
+// 状态文件和保存时使用的临时文件可能位于同步目录中，它们不参与同步，也不能被 deleteExtras 删除。
+// 按文件名和所在目录识别，目录比较 inode 以忽略路径写法的差异
+class StateFileFilter {
+public:
+    explicit StateFileFilter(const std::string& stateFile) {
+        if (stateFile.empty()) {
+            return;
+        }
+        splitPath(stateFile, dir_, name_);
+        enabled_ = !name_.empty();
+    }
+
+    bool matches(const std::string& path) const {
+        if (!enabled_) {
+            return false;
+        }
+        std::string dir, name;
+        splitPath(path, dir, name);
+        if (name != name_ && name != name_ + ".temp") {
+            return false;
+        }
+        if (dir == dir_) {
+            return true;
+        }
+#ifdef _WIN32
+        return false;
+#else
+        struct stat a {};
+        struct stat b {};
+        return stat(dir.c_str(), &a) == 0 && stat(dir_.c_str(), &b) == 0 && a.st_dev == b.st_dev &&
+               a.st_ino == b.st_ino;
+#endif
+    }
+
+private:
+    static void splitPath(const std::string& path, std::string& dir, std::string& name) {
+        auto pos = path.find_last_of("/\\");
+        if (pos == std::string::npos) {
+            dir = ".";
+            name = path;
+            return;
+        }
+        dir = pos == 0 ? path.substr(0, 1) : path.substr(0, pos);
+        name = path.substr(pos + 1);
+    }
+
+    bool enabled_ = false;
+    std::string dir_;
+    std::string name_;
+};
+
+// 下载时与 downloadPrefix 一致，去掉相对路径开头的 '/'
+std::string remoteRelativePath(const std::string& key, const std::string& prefix, bool upload) {
+    auto relative = key.substr(prefix.size());
+    while (!upload && !relative.empty() && relative.front() == '/') {
+        relative.erase(0, 1);
+    }
+    return relative;
+}
+}  // namespace
+
+Outcome<TosError, SyncDirectoryOutput> TosClientImpl::syncDirectoryConcurrent(const SyncDirectoryInput& input) {
+    Outcome<TosError, SyncDirectoryOutput> res;
+    auto clientError = [&](const std::string& message) {
+        TosError error;
+        error.setIsClientError(true);
+        error.setMessage(message);
+        res.setE(error);
+        res.setSuccess(false);
+        return res;
+    };
+    const auto& bucket = input.getBucket();
+    const auto& prefix = input.getPrefix();
+    bool upload = input.getDirection() == SyncDirectionType::Upload;
+    auto taskNum = std::max(std::min(input.getTaskNum(), 1000), 1);
+    auto cancel = input.getCancelHook();
+    std::function<bool()> canceled = [&]() { return cancel != nullptr && cancel->isCancel(); };
+
+    if (!upload && !FileUtils::CreateDir(input.getDirectory(), false)) {
+        return clientError("invalid file path, mkdir failed");
+    }
+    std::vector<LocalFileInfo> localFiles;
+    std::string check;
+    if (!WalkLocalDirectory(input.getDirectory(), taskNum, localFiles, check)) {
+        return clientError(check);
+    }
+    std::map<std::string, std::unique_ptr<SyncFile>> locals;
+    StateFileFilter stateFileFilter(input.getStateFile());
+    for (auto& info : localFiles) {
+        if (stateFileFilter.matches(info.path)) {
+            continue;
+        }
+        std::unique_ptr<SyncFile> file(new SyncFile());
+        auto relative = info.relativePath;
+        file->info = std::move(info);
+        locals[relative] = std::move(file);
+    }
+
+    // 列举前缀下的全部对象，目录对象不参与比较
+    std::map<std::string, ListedObjectV2> remotes;
+    ListObjectsType2Input listInput;
+    listInput.setBucket(bucket);
+    listInput.setPrefix(prefix);
+    listInput.setMaxKeys(1000);
+    while (true) {
+        if (canceled()) {
+            return clientError("the task is canceled");
+        }
+        auto listRes = this->listObjectsType2(listInput);
+        if (!listRes.isSuccess()) {
+            res.setE(listRes.error());
+            res.setSuccess(false);
+            return res;
+        }
+        for (const auto& content : listRes.result().getContents()) {
+            auto relative = remoteRelativePath(content.getKey(), prefix, upload);
+            if (!relative.empty() && relative.back() != '/') {
+                remotes[relative] = content;
+            }
+        }
+        if (!listRes.result().isTruncated()) {
+            break;
+        }
+        listInput.setContinuationToken(listRes.result().getNextContinuationToken());
+    }
+
+    // 大小和修改时间都未变化时沿用状态文件中的 CRC64；
+    // 只有大小与对象一致时才需要计算 CRC64，记录状态文件时计算全部本地文件
+    auto states = loadSyncState(input.getStateFile());
+    std::vector<SyncFile*> toHash;
+    for (auto& local : locals) {
+        auto file = local.second.get();
+        auto state = states.find(local.first);
+        if (state != states.end() && state->second.size == file->info.size &&
+            state->second.lastModified == file->info.lastModified) {
+            file->crc64 = state->second.crc64;
+            file->hashed = true;
+            continue;
+        }
+        auto remote = remotes.find(local.first);
+        bool comparable = remote != remotes.end() && remote->second.getSize() == file->info.size &&
+                          remote->second.getHashCrc64Ecma() != 0;
+        if (comparable || !input.getStateFile().empty()) {
+            toHash.push_back(file);
+        }
+    }
+    SyncDirectoryOutput output;
+    output.setBucket(bucket);
+    int64_t hashedBytes = 0;
+    for (auto file : toHash) {
+        hashedBytes += file->info.size;
+    }
+    hashFilesConcurrent(toHash, taskNum, canceled);
+    if (canceled()) {
+        return clientError("the task is canceled");
+    }
+    output.setHashedFiles(toHash.size());
+    output.setHashedBytes(hashedBytes);
+
+    // 对象没有 CRC64 时退化为比较修改时间
+    auto changed = [](const SyncFile* file, const ListedObjectV2& remote, bool upload) {
+        if (file->info.size != remote.getSize()) {
+            return true;
+        }
+        if (remote.getHashCrc64Ecma() != 0) {
+            return !file->hashed || file->crc64 != remote.getHashCrc64Ecma();
+        }
+        return upload ? file->info.lastModified > remote.getLastModified()
+                      : remote.getLastModified() > file->info.lastModified;
+    };
+    int64_t unchangedFiles = 0;
+    std::vector<LocalFileInfo> uploadFiles;
+    std::vector<ListedObjectV2> downloadObjects;
+    std::vector<std::string> extras;
+    if (upload) {
+        for (const auto& local : locals) {
+            auto remote = remotes.find(local.first);
+            if (remote == remotes.end() || changed(local.second.get(), remote->second, true)) {
+                uploadFiles.push_back(local.second->info);
+            } else {
+                unchangedFiles++;
+            }
+        }
+        for (const auto& remote : remotes) {
+            if (locals.find(remote.first) == locals.end()) {
+                extras.push_back(remote.second.getKey());
+            }
+        }
+    } else {
+        for (const auto& remote : remotes) {
+            auto local = locals.find(remote.first);
+            if (local == locals.end() || changed(local->second.get(), remote.second, false)) {
+                downloadObjects.push_back(remote.second);
+            } else {
+                unchangedFiles++;
+            }
+        }
+        for (const auto& local : locals) {
+            if (remotes.find(local.first) == remotes.end()) {
+                extras.push_back(local.second->info.path);
+            }
+        }
+    }
+    output.setUnchangedFiles(unchangedFiles);
+
+    TosError transferError;
+    bool transferFailed = false;
+    bool downloaded = false;
+    if (upload && !uploadFiles.empty()) {
+        UploadDirectoryInput uploadInput(bucket, input.getDirectory(), prefix);
+        uploadInput.setTaskNum(taskNum);
+        uploadInput.setPartSize(input.getPartSize());
+        uploadInput.setMultipartThreshold(input.getMultipartThreshold());
+        uploadInput.setCancelHook(cancel);
+        auto uploadRes = uploadLocalFilesConcurrent(uploadInput, uploadFiles);
+        if (uploadRes.isSuccess()) {
+            output.setTransferredFiles(uploadRes.result().getUploadedFiles());
+            output.setTransferredBytes(uploadRes.result().getUploadedBytes());
+        } else {
+            transferError = uploadRes.error();
+            transferFailed = true;
+        }
+    } else if (!upload && !downloadObjects.empty()) {
+        DownloadPrefixInput downloadInput(bucket, prefix, input.getDirectory());
+        downloadInput.setTaskNum(taskNum);
+        downloadInput.setPartSize(input.getPartSize());
+        downloadInput.setParallelThreshold(input.getMultipartThreshold());
+        downloadInput.setCancelHook(cancel);
+        auto downloadRes = downloadObjectsConcurrent(downloadInput, &downloadObjects);
+        downloaded = downloadRes.isSuccess();
+        if (downloaded) {
+            output.setTransferredFiles(downloadRes.result().getDownloadedFiles());
+            output.setTransferredBytes(downloadRes.result().getDownloadedBytes());
+        } else {
+            transferError = downloadRes.error();
+            transferFailed = true;
+        }
+    }
+
+    // 传输失败时不删除，避免误删尚未同步的数据
+    int64_t deletedFiles = 0;
+    if (!transferFailed && input.isDeleteExtras()) {
+        if (upload) {
+            for (size_t start = 0; start < extras.size(); start += maxDeleteKeys) {
+                DeleteMultiObjectsInput deleteInput;
+                deleteInput.setBucket(bucket);
+                deleteInput.setQuiet(true);
+                auto end = std::min(start + maxDeleteKeys, extras.size());
+                for (auto i = start; i < end; i++) {
+                    deleteInput.addObjectTobeDeleted(ObjectTobeDeleted(extras[i]));
+                }
+                auto deleteRes = this->deleteMultiObjects(deleteInput);
+                if (!deleteRes.isSuccess()) {
+                    transferError = deleteRes.error();
+                    transferFailed = true;
+                    break;
+                }
+                deletedFiles += (end - start) - deleteRes.result().getErrors().size();
+                if (!deleteRes.result().getErrors().empty() && !transferFailed) {
+                    const auto& first = deleteRes.result().getErrors().front();
+                    transferError.setMessage("delete object failed: " + first.getKey() + ": " + first.getMessage());
+                    transferFailed = true;
+                }
+            }
+        } else {
+            for (const auto& path : extras) {
+                if (std::remove(path.c_str()) == 0) {
+                    deletedFiles++;
+                } else if (!transferFailed) {
+                    transferError.setIsClientError(true);
+                    transferError.setMessage("delete local file failed: " + path);
+                    transferFailed = true;
+                }
+            }
+        }
+    }
+    output.setDeletedFiles(deletedFiles);
+
+    // 即使传输失败也保存已计算的 CRC64，下次执行时不再重新计算
+    if (!input.getStateFile().empty()) {
+        std::map<std::string, SyncState> saved;
+        for (const auto& local : locals) {
+            const auto& info = local.second->info;
+            if (!local.second->hashed) {
+                continue;
+            }
+            if (!upload && input.isDeleteExtras() && remotes.find(local.first) == remotes.end()) {
+                continue;
+            }
+            saved[local.first] = {info.size, info.lastModified, local.second->crc64};
+        }
+        // 下载成功的文件使用对象的 CRC64，下载失败时本地文件可能未更新，保留原有记录
+        for (const auto& object : downloadObjects) {
+            if (!downloaded) {
+                break;
+            }
+            auto relative = remoteRelativePath(object.getKey(), prefix, false);
+            auto path = input.getDirectory() + TOS_PATH_DELIMITER + relative;
+#ifdef _WIN32
+            std::replace(path.begin(), path.end(), '/', TOS_PATH_DELIMITER);
+#endif
+            struct stat st {};
+            saved.erase(relative);
+            if (object.getHashCrc64Ecma() != 0 && stat(path.c_str(), &st) == 0 && st.st_size == object.getSize()) {
+                saved[relative] = {object.getSize(), st.st_mtime, object.getHashCrc64Ecma()};
+            }
+        }
+        if (!saveSyncState(input.getStateFile(), saved) && !transferFailed) {
+            transferError.setIsClientError(true);
+            transferError.setMessage("save state file failed: " + input.getStateFile());
+            transferFailed = true;
+        }
+    }
+    if (transferFailed) {
+        res.setE(transferError);
+        res.setSuccess(false);
+        return res;
+    }
+    res.setSuccess(true);
+    res.setR(std::move(output));
+    return res;
+}
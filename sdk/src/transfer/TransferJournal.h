@@ -0,0 +1,58 @@
+#pragma once
+
+#include "../src/external/json/json.hpp"
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace VolcengineTos {
+// 每行一个 json 记录，只追加写入，进程中断时最多丢失最后一行。路径为空时不记录
+class TransferJournal {
+public:
+    explicit TransferJournal(std::string path) : path_(std::move(path)) {
+    }
+    bool enabled() const {
+        return !path_.empty();
+    }
+    const std::string& path() const {
+        return path_;
+    }
+    // 读取全部记录，跳过无法解析的行
+    std::vector<nlohmann::json> load() const {
+        std::vector<nlohmann::json> records;
+        if (!enabled()) {
+            return records;
+        }
+        std::ifstream ifs(path_, std::ios::in);
+        std::string line;
+        while (std::getline(ifs, line)) {
+            auto j = nlohmann::json::parse(line, nullptr, false);
+            if (!j.is_discarded() && j.is_object()) {
+                records.push_back(std::move(j));
+            }
+        }
+        return records;
+    }
+    bool open() {
+        if (enabled()) {
+            ofs_.open(path_, std::ios::out | std::ios::app);
+            return ofs_.good();
+        }
+        return true;
+    }
+    void append(const nlohmann::json& j) {
+        if (!enabled()) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mu_);
+        ofs_ << j.dump() << "\n";
+        ofs_.flush();
+    }
+
+private:
+    std::string path_;
+    std::mutex mu_;
+    std::ofstream ofs_;
+};
+}  // namespace VolcengineTos
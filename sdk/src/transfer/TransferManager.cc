@@ -0,0 +1,581 @@
+#include "transfer/TransferManager.h"
+#include <algorithm>
+#include <thread>
+#include "TosClientV2.h"
+#include "../TosClientImpl.h"
+
+using namespace VolcengineTos;
+
+class TransferManager::Impl {
+public:
+    Impl(std::shared_ptr<TosClientImpl> client, const TransferManagerOptions& options);
+    ~Impl();
+
+    std::shared_ptr<TransferJob> uploadFile(const UploadFileV2Input& input, int priority);
+    std::shared_ptr<TransferJob> downloadFile(const DownloadFileInput& input, int priority);
+    std::shared_ptr<TransferJob> resumableCopyObject(const ResumableCopyObjectInput& input, int priority);
+    void pauseAll();
+    void resumeAll();
+    TransferManagerStats stats();
+
+private:
+    friend class TransferJob;
+    std::shared_ptr<TransferJob> newJob(int priority);
+    void submit(const std::shared_ptr<TransferJob>& job);
+    // 在运行任务数未达上限时按优先级启动等待中的任务
+    void schedule();
+    // 在后台线程中执行一次任务，counted 为 true 时计入运行任务数
+    void launch(const std::shared_ptr<TransferJob>& job, bool counted, bool abort);
+    void onRunFinished(const std::shared_ptr<TransferJob>& job, bool counted);
+    // 任务结束后移出 jobs_，计入统计
+    void retire(const std::shared_ptr<TransferJob>& job);
+
+    std::shared_ptr<TosClientImpl> client_;
+    TransferManagerOptions options_;
+    std::shared_ptr<PartScheduler> scheduler_;
+    std::shared_ptr<RateLimiter> limiter_;
+
+    std::mutex mu_;
+    std::condition_variable threadsCv_;
+    int64_t nextId_ = 1;
+    // 运行中的任务数与后台线程数
+    int running_ = 0;
+    int threads_ = 0;
+    bool closed_ = false;
+    // 未结束的任务，按提交顺序
+    std::vector<std::shared_ptr<TransferJob>> jobs_;
+    int succeeded_ = 0;
+    int failed_ = 0;
+    int cancelled_ = 0;
+    int64_t retiredBytes_ = 0;
+};
+
+PartScheduler::PartScheduler(int maxConcurrency) : maxConcurrency_(std::max(maxConcurrency, 1)) {
+}
+
+bool PartScheduler::acquire(int priority, const std::function<bool()>& stop) {
+    std::unique_lock<std::mutex> lock(mu_);
+    auto key = std::make_pair(-priority, sequence_++);
+    waiters_.insert(key);
+    while (running_ >= maxConcurrency_ || *waiters_.begin() != key) {
+        if (stop != nullptr && stop()) {
+            waiters_.erase(key);
+            // 排在后面的请求可能因此轮到
+            cv_.notify_all();
+            return false;
+        }
+        // 定期检查 stop，取消任务时不依赖 wakeAll
+        cv_.wait_for(lock, std::chrono::milliseconds(100));
+    }
+    waiters_.erase(waiters_.begin());
+    running_++;
+    cv_.notify_all();
+    return true;
+}
+
+void PartScheduler::release() {
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        running_--;
+    }
+    cv_.notify_all();
+}
+
+void PartScheduler::wakeAll() {
+    cv_.notify_all();
+}
+
+int PartScheduler::running() {
+    std::lock_guard<std::mutex> lock(mu_);
+    return running_;
+}
+
+int PartScheduler::waiting() {
+    std::lock_guard<std::mutex> lock(mu_);
+    return static_cast<int>(waiters_.size());
+}
+
+TransferJob::TransferJob(TransferManager::Impl* manager, int64_t id, int priority)
+        : manager_(manager), id_(id), priority_(priority) {
+}
+
+TransferJobState TransferJob::state() {
+    std::lock_guard<std::mutex> lock(mu_);
+    return state_;
+}
+
+bool TransferJob::finished() {
+    std::lock_guard<std::mutex> lock(mu_);
+    return state_ == TransferJobState::Succeeded || state_ == TransferJobState::Failed ||
+           state_ == TransferJobState::Cancelled;
+}
+
+void TransferJob::pause() {
+    TransferManager::Impl* manager = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        if (state_ == TransferJobState::Pending) {
+            state_ = TransferJobState::Paused;
+        } else if (state_ == TransferJobState::Running && !cancelRequested_) {
+            // 运行中的任务在各分片请求结束后退出，checkpoint 保留
+            pauseRequested_ = true;
+            if (hook_ != nullptr) {
+                hook_->Cancel(false);
+            }
+            manager = manager_;
+        }
+    }
+    cv_.notify_all();
+    if (manager != nullptr) {
+        manager->scheduler_->wakeAll();
+    }
+}
+
+void TransferJob::resume() {
+    TransferManager::Impl* manager = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        if (state_ != TransferJobState::Paused || manager_ == nullptr) {
+            return;
+        }
+        state_ = TransferJobState::Pending;
+        manager = manager_;
+    }
+    manager->schedule();
+}
+
+void TransferJob::cancel() {
+    TransferManager::Impl* manager = nullptr;
+    bool cleanup = false;
+    bool retired = false;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        manager = manager_;
+        if (state_ == TransferJobState::Pending || state_ == TransferJobState::Paused) {
+            if (started_ && manager != nullptr) {
+                // 已运行过的任务再执行一次以删除 checkpoint 并中止分片上传
+                cancelRequested_ = true;
+                state_ = TransferJobState::Running;
+                cleanup = true;
+            } else {
+                state_ = TransferJobState::Cancelled;
+                error_.setIsClientError(true);
+                error_.setMessage("the task is canceled");
+                retired = true;
+            }
+        } else if (state_ == TransferJobState::Running) {
+            cancelRequested_ = true;
+            if (hook_ != nullptr) {
+                hook_->Cancel(true);
+            }
+        } else {
+            return;
+        }
+    }
+    cv_.notify_all();
+    if (manager == nullptr) {
+        return;
+    }
+    if (cleanup) {
+        manager->launch(shared_from_this(), false, true);
+    } else if (retired) {
+        manager->retire(shared_from_this());
+    }
+    manager->scheduler_->wakeAll();
+}
+
+TransferJobState TransferJob::wait() {
+    std::unique_lock<std::mutex> lock(mu_);
+    cv_.wait(lock, [this] {
+        return state_ != TransferJobState::Pending && state_ != TransferJobState::Running;
+    });
+    return state_;
+}
+
+TosError TransferJob::error() {
+    std::lock_guard<std::mutex> lock(mu_);
+    return error_;
+}
+
+TransferJobStats TransferJob::stats() {
+    std::lock_guard<std::mutex> lock(mu_);
+    TransferJobStats stats;
+    stats.transferredBytes = transferred_;
+    stats.totalBytes = total_;
+    stats.runningMillis = runMillis_;
+    if (state_ == TransferJobState::Running && hook_ != nullptr) {
+        stats.runningMillis += std::chrono::duration_cast<std::chrono::milliseconds>(
+                                       std::chrono::steady_clock::now() - runStart_)
+                                       .count();
+    }
+    if (stats.runningMillis > 0) {
+        stats.bytesPerSecond = static_cast<double>(runBytes_) * 1000 / stats.runningMillis;
+    }
+    return stats;
+}
+
+bool TransferJob::markRunning() {
+    std::lock_guard<std::mutex> lock(mu_);
+    if (state_ != TransferJobState::Pending) {
+        return false;
+    }
+    state_ = TransferJobState::Running;
+    return true;
+}
+
+void TransferJob::run(bool abort) {
+    auto hook = std::make_shared<MyCancelHook>();
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        // 启动前已被暂停或取消
+        if (abort || cancelRequested_) {
+            hook->Cancel(true);
+        } else if (pauseRequested_) {
+            hook->Cancel(false);
+        }
+        hook_ = hook;
+        started_ = true;
+        runStart_ = std::chrono::steady_clock::now();
+    }
+    TosError error;
+    bool success = runner_(hook, error);
+    bool cleanup = false;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        // 暂停后又被取消，本次执行保留了 checkpoint，需要再执行一次清理
+        if (!success && cancelRequested_ && !hook->isAbortFunc()) {
+            hook = std::make_shared<MyCancelHook>();
+            hook->Cancel(true);
+            hook_ = hook;
+            cleanup = true;
+        }
+    }
+    if (cleanup) {
+        success = runner_(hook, error);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        runMillis_ += std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() -
+                                                                             runStart_)
+                              .count();
+        hook_ = nullptr;
+        if (success) {
+            state_ = TransferJobState::Succeeded;
+            error_ = TosError();
+        } else if (cancelRequested_) {
+            state_ = TransferJobState::Cancelled;
+            error_ = error;
+        } else if (pauseRequested_) {
+            state_ = TransferJobState::Paused;
+        } else {
+            state_ = TransferJobState::Failed;
+            error_ = error;
+        }
+        pauseRequested_ = false;
+    }
+    cv_.notify_all();
+}
+
+void TransferJob::progress(const std::shared_ptr<DataTransferStatus>& status) {
+    static_cast<TransferJob*>(status->userData_)->onProgress(*status);
+}
+
+void TransferJob::onProgress(const DataTransferStatus& status) {
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        transferred_ = status.consumedBytes_;
+        total_ = status.totalBytes_;
+        runBytes_ += status.rwOnceBytes_;
+    }
+    if (listener_.dataTransferStatusChange_ != nullptr) {
+        auto forward = std::make_shared<DataTransferStatus>(status);
+        forward->userData_ = listener_.userData_;
+        listener_.dataTransferStatusChange_(forward);
+    }
+}
+
+void TransferJob::onPartCopied(int64_t bytes) {
+    std::lock_guard<std::mutex> lock(mu_);
+    transferred_ += bytes;
+    runBytes_ += bytes;
+}
+
+TransferManager::TransferManager(const TosClientV2& client, const TransferManagerOptions& options)
+        : impl_(std::make_shared<Impl>(client.tosClientImpl_, options)) {
+}
+
+TransferManager::~TransferManager() = default;
+
+std::shared_ptr<TransferJob> TransferManager::uploadFile(const UploadFileV2Input& input, int priority) {
+    return impl_->uploadFile(input, priority);
+}
+
+std::shared_ptr<TransferJob> TransferManager::downloadFile(const DownloadFileInput& input, int priority) {
+    return impl_->downloadFile(input, priority);
+}
+
+std::shared_ptr<TransferJob> TransferManager::resumableCopyObject(const ResumableCopyObjectInput& input,
+                                                                  int priority) {
+    return impl_->resumableCopyObject(input, priority);
+}
+
+void TransferManager::pauseAll() {
+    impl_->pauseAll();
+}
+
+void TransferManager::resumeAll() {
+    impl_->resumeAll();
+}
+
+TransferManagerStats TransferManager::stats() {
+    return impl_->stats();
+}
+
+TransferManager::Impl::Impl(std::shared_ptr<TosClientImpl> client, const TransferManagerOptions& options)
+        : client_(std::move(client)), options_(options) {
+    scheduler_ = std::make_shared<PartScheduler>(options_.maxConcurrency);
+    if (options_.maxBandwidth > 0) {
+        limiter_ = std::make_shared<MyRateLimiter>(options_.maxBandwidth, options_.maxBandwidth);
+    }
+}
+
+TransferManager::Impl::~Impl() {
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        closed_ = true;
+    }
+    pauseAll();
+    std::unique_lock<std::mutex> lock(mu_);
+    threadsCv_.wait(lock, [this] { return threads_ == 0; });
+    for (auto& job : jobs_) {
+        std::lock_guard<std::mutex> jobLock(job->mu_);
+        job->manager_ = nullptr;
+    }
+}
+
+std::shared_ptr<TransferJob> TransferManager::Impl::newJob(int priority) {
+    std::lock_guard<std::mutex> lock(mu_);
+    return std::shared_ptr<TransferJob>(new TransferJob(this, nextId_++, priority));
+}
+
+void TransferManager::Impl::submit(const std::shared_ptr<TransferJob>& job) {
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        jobs_.push_back(job);
+    }
+    schedule();
+}
+
+std::shared_ptr<TransferJob> TransferManager::Impl::uploadFile(const UploadFileV2Input& input, int priority) {
+    auto job = newJob(priority);
+    auto in = input;
+    in.setEnableCheckpoint(true);
+    if (in.getRateLimiter() == nullptr && limiter_ != nullptr) {
+        in.setRateLimiter(limiter_);
+    }
+    job->listener_ = in.getDataTransferListener();
+    in.setDataTransferListener({TransferJob::progress, job.get()});
+    auto client = client_;
+    PartSchedule schedule;
+    schedule.scheduler = scheduler_;
+    schedule.priority = priority;
+    job->runner_ = [client, in, schedule](const std::shared_ptr<CancelHook>& hook, TosError& error) mutable {
+        in.setCancelHook(hook);
+        auto res = client->uploadFile(in, schedule);
+        if (!res.isSuccess()) {
+            error = res.error();
+        }
+        return res.isSuccess();
+    };
+    submit(job);
+    return job;
+}
+
+std::shared_ptr<TransferJob> TransferManager::Impl::downloadFile(const DownloadFileInput& input, int priority) {
+    auto job = newJob(priority);
+    auto in = input;
+    in.setEnableCheckpoint(true);
+    if (in.getRateLimiter() == nullptr && limiter_ != nullptr) {
+        in.setRateLimiter(limiter_);
+    }
+    job->listener_ = in.getDataTransferListener();
+    in.setDataTransferListener({TransferJob::progress, job.get()});
+    auto client = client_;
+    PartSchedule schedule;
+    schedule.scheduler = scheduler_;
+    schedule.priority = priority;
+    job->runner_ = [client, in, schedule](const std::shared_ptr<CancelHook>& hook, TosError& error) mutable {
+        in.setCancelHook(hook);
+        auto res = client->downloadFile(in, schedule);
+        if (!res.isSuccess()) {
+            error = res.error();
+        }
+        return res.isSuccess();
+    };
+    submit(job);
+    return job;
+}
+
+std::shared_ptr<TransferJob> TransferManager::Impl::resumableCopyObject(const ResumableCopyObjectInput& input,
+                                                                        int priority) {
+    auto job = newJob(priority);
+    auto in = input;
+    in.setEnableCheckpoint(true);
+    // 服务端复制没有数据进度回调，按完成的分片统计
+    auto events = in.getCopyEventListener().eventChange_;
+    auto raw = job.get();
+    in.setCopyEventListener({[raw, events](std::shared_ptr<CopyEvent> event) {
+        if (event->type_ == CopyEventUploadPartSucceed && event->copyPartInfo_ != nullptr) {
+            raw->onPartCopied(event->copyPartInfo_->copySourceRangeEnd_ - event->copyPartInfo_->copySourceRangeStart_ +
+                              1);
+        }
+        if (events != nullptr) {
+            events(event);
+        }
+    }});
+    auto client = client_;
+    PartSchedule schedule;
+    schedule.scheduler = scheduler_;
+    schedule.priority = priority;
+    job->runner_ = [client, in, schedule](const std::shared_ptr<CancelHook>& hook, TosError& error) mutable {
+        in.setCancelHook(hook);
+        auto res = client->resumableCopyObject(in, schedule);
+        if (!res.isSuccess()) {
+            error = res.error();
+        }
+        return res.isSuccess();
+    };
+    submit(job);
+    return job;
+}
+
+void TransferManager::Impl::pauseAll() {
+    std::vector<std::shared_ptr<TransferJob>> jobs;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        jobs = jobs_;
+    }
+    for (auto& job : jobs) {
+        job->pause();
+    }
+}
+
+void TransferManager::Impl::resumeAll() {
+    std::vector<std::shared_ptr<TransferJob>> jobs;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        jobs = jobs_;
+    }
+    for (auto& job : jobs) {
+        job->resume();
+    }
+}
+
+TransferManagerStats TransferManager::Impl::stats() {
+    TransferManagerStats stats;
+    std::vector<std::shared_ptr<TransferJob>> jobs;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        jobs = jobs_;
+        stats.succeeded = succeeded_;
+        stats.failed = failed_;
+        stats.cancelled = cancelled_;
+        stats.transferredBytes = retiredBytes_;
+    }
+    for (auto& job : jobs) {
+        auto state = job->state();
+        auto jobStats = job->stats();
+        stats.transferredBytes += jobStats.transferredBytes;
+        if (state == TransferJobState::Pending) {
+            stats.pending++;
+        } else if (state == TransferJobState::Running) {
+            stats.running++;
+            stats.bytesPerSecond += jobStats.bytesPerSecond;
+        } else if (state == TransferJobState::Paused) {
+            stats.paused++;
+        }
+    }
+    stats.activeParts = scheduler_->running();
+    stats.waitingParts = scheduler_->waiting();
+    return stats;
+}
+
+void TransferManager::Impl::schedule() {
+    std::vector<std::shared_ptr<TransferJob>> toStart;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        if (closed_) {
+            return;
+        }
+        while (running_ < std::max(options_.maxRunningJobs, 1)) {
+            // 优先级最高的等待中任务，同优先级先提交的优先
+            std::shared_ptr<TransferJob> next;
+            for (auto& job : jobs_) {
+                if ((next == nullptr || job->priority_ > next->priority_) &&
+                    job->state() == TransferJobState::Pending) {
+                    next = job;
+                }
+            }
+            if (next == nullptr) {
+                break;
+            }
+            if (!next->markRunning()) {
+                continue;
+            }
+            running_++;
+            toStart.push_back(next);
+        }
+    }
+    for (auto& job : toStart) {
+        launch(job, true, false);
+    }
+}
+
+void TransferManager::Impl::launch(const std::shared_ptr<TransferJob>& job, bool counted, bool abort) {
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        threads_++;
+    }
+    std::thread([this, job, counted, abort]() {
+        job->run(abort);
+        onRunFinished(job, counted);
+    }).detach();
+}
+
+void TransferManager::Impl::onRunFinished(const std::shared_ptr<TransferJob>& job, bool counted) {
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        if (counted) {
+            running_--;
+        }
+    }
+    if (job->finished()) {
+        retire(job);
+    }
+    // 在减少线程数之前启动后续任务，析构时不会错过新启动的线程
+    schedule();
+    std::lock_guard<std::mutex> lock(mu_);
+    threads_--;
+    threadsCv_.notify_all();
+}
+
+void TransferManager::Impl::retire(const std::shared_ptr<TransferJob>& job) {
+    auto state = job->state();
+    auto transferred = job->stats().transferredBytes;
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = std::find(jobs_.begin(), jobs_.end(), job);
+    if (it == jobs_.end()) {
+        return;
+    }
+    jobs_.erase(it);
+    retiredBytes_ += transferred;
+    if (state == TransferJobState::Succeeded) {
+        succeeded_++;
+    } else if (state == TransferJobState::Failed) {
+        failed_++;
+    } else {
+        cancelled_++;
+    }
+    std::lock_guard<std::mutex> jobLock(job->mu_);
+    job->manager_ = nullptr;
+}
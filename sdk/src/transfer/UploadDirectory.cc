@@ -0,0 +1,371 @@
+#include "../src/external/json/json.hpp"
+#include "../TosClientImpl.h"
+#include "LocalFileWalker.h"
+#include "TransferJournal.h"
+#include "../utils/LogUtils.h"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+
+using namespace VolcengineTos;
+
+namespace {
+const int maxPartCount = 10000;
+
+// manifest 中一个对象的记录
+struct ManifestEntry {
+    bool completed = false;
+    int64_t size = 0;
+    time_t lastModified = 0;
+    int64_t partSize = 0;
+    std::string uploadId;
+    std::map<int, std::string> parts;
+};
+
+// manifest 基于 TransferJournal：
+// {"Type":"Upload"} 开始分片上传，{"Type":"Part"} 完成一个分片，{"Type":"File"} 完成一个文件
+class UploadManifest : public TransferJournal {
+public:
+    explicit UploadManifest(std::string path) : TransferJournal(std::move(path)) {
+    }
+    std::map<std::string, ManifestEntry> entries() const {
+        std::map<std::string, ManifestEntry> entries;
+        for (const auto& j : load()) {
+            if (!j.contains("Type") || !j.contains("Key")) {
+                continue;
+            }
+            auto& entry = entries[j.at("Key").get<std::string>()];
+            auto type = j.at("Type").get<std::string>();
+            if (type == "File") {
+                entry = ManifestEntry();
+                entry.completed = true;
+                entry.size = j.value("Size", int64_t(0));
+                entry.lastModified = j.value("LastModified", int64_t(0));
+            } else if (type == "Upload") {
+                entry = ManifestEntry();
+                entry.size = j.value("Size", int64_t(0));
+                entry.lastModified = j.value("LastModified", int64_t(0));
+                entry.partSize = j.value("PartSize", int64_t(0));
+                entry.uploadId = j.value("UploadID", std::string());
+            } else if (type == "Part" && j.value("UploadID", std::string()) == entry.uploadId) {
+                entry.parts[j.value("PartNumber", 0)] = j.value("ETag", std::string());
+            }
+        }
+        return entries;
+    }
+};
+
+struct DirectoryFile {
+    LocalFileInfo info;
+    std::string key;
+    // 0 表示使用 putObject 上传
+    int64_t partSize = 0;
+    std::mutex mu;
+    std::string uploadId;
+    bool resumed = false;
+    std::map<int, std::string> parts;
+    // 本次需要执行的任务数，最后一个任务完成时合并分片
+    std::atomic<int> remaining{0};
+    std::atomic<bool> failed{false};
+    TosError error;
+};
+
+// partNumber 为 0 表示整个文件 putObject，-1 表示只需要合并分片
+struct DirectoryTask {
+    DirectoryFile* file;
+    int partNumber;
+};
+}  // namespace
+
+Outcome<TosError, UploadDirectoryOutput> TosClientImpl::uploadDirectoryConcurrent(const UploadDirectoryInput& input) {
+    Outcome<TosError, UploadDirectoryOutput> res;
+    std::string check;
+    auto taskNum = std::max(std::min(input.getTaskNum(), 1000), 1);
+    std::vector<LocalFileInfo> localFiles;
+    if (!WalkLocalDirectory(input.getDirectory(), taskNum, localFiles, check)) {
+        TosError error;
+        error.setIsClientError(true);
+        error.setMessage(check);
+        res.setE(error);
+        res.setSuccess(false);
+        return res;
+    }
+    return uploadLocalFilesConcurrent(input, std::move(localFiles));
+}
+
+Outcome<TosError, UploadDirectoryOutput> TosClientImpl::uploadLocalFilesConcurrent(
+        const UploadDirectoryInput& input, std::vector<LocalFileInfo> localFiles) {
+    Outcome<TosError, UploadDirectoryOutput> res;
+    TosError error;
+    error.setIsClientError(true);
+    auto taskNum = std::max(std::min(input.getTaskNum(), 1000), 1);
+    UploadManifest manifest(input.getManifestFile());
+    auto recorded = manifest.entries();
+    if (!manifest.open()) {
+        error.setMessage("open manifest file failed: " + input.getManifestFile());
+        res.setE(error);
+        res.setSuccess(false);
+        return res;
+    }
+
+    UploadDirectoryOutput output;
+    output.setBucket(input.getBucket());
+    int64_t skippedFiles = 0;
+    int64_t totalBytes = 0;
+    int64_t resumedBytes = 0;
+    std::vector<std::unique_ptr<DirectoryFile>> files;
+    for (auto& info : localFiles) {
+        std::unique_ptr<DirectoryFile> file(new DirectoryFile());
+        file->key = input.getPrefix() + info.relativePath;
+        file->info = std::move(info);
+        auto it = recorded.find(file->key);
+        bool unchanged = it != recorded.end() && it->second.size == file->info.size &&
+                         it->second.lastModified == file->info.lastModified;
+        if (unchanged && it->second.completed) {
+            skippedFiles++;
+            continue;
+        }
+        if (file->info.size > input.getMultipartThreshold()) {
+            // 分片数超过上限时增大分片
+            auto minPartSize = (file->info.size + maxPartCount - 1) / maxPartCount;
+            file->partSize = std::max(input.getPartSize(), minPartSize);
+            if (unchanged && !it->second.uploadId.empty() && it->second.partSize == file->partSize) {
+                file->uploadId = it->second.uploadId;
+                file->parts = it->second.parts;
+                file->resumed = true;
+            }
+        }
+        totalBytes += file->info.size;
+        files.push_back(std::move(file));
+    }
+    output.setSkippedFiles(skippedFiles);
+
+    // 大文件的分片在前，按文件大小从大到小调度，最大的文件最先开始，缩短整体耗时
+    std::sort(files.begin(), files.end(), [](const std::unique_ptr<DirectoryFile>& a,
+                                             const std::unique_ptr<DirectoryFile>& b) {
+        if ((a->partSize > 0) != (b->partSize > 0)) {
+            return a->partSize > 0;
+        }
+        return a->info.size > b->info.size;
+    });
+    std::vector<DirectoryTask> tasks;
+    int64_t multipartFiles = 0;
+    for (auto& file : files) {
+        if (file->partSize == 0) {
+            tasks.push_back({file.get(), 0});
+            file->remaining = 1;
+            continue;
+        }
+        multipartFiles++;
+        auto partCount = static_cast<int>((file->info.size + file->partSize - 1) / file->partSize);
+        for (int partNumber = 1; partNumber <= partCount; partNumber++) {
+            if (file->parts.count(partNumber) != 0) {
+                resumedBytes += std::min(file->partSize, file->info.size - (partNumber - 1) * file->partSize);
+                continue;
+            }
+            tasks.push_back({file.get(), partNumber});
+            file->remaining++;
+        }
+        if (file->remaining == 0) {
+            tasks.push_back({file.get(), -1});
+            file->remaining = 1;
+        }
+    }
+    output.setMultipartFiles(multipartFiles);
+
+    // 整个目录的进度
+    UploadDownloadFileProcessStat processStat;
+    auto pProcessStat = &processStat;
+    auto process = input.getDataTransferListener();
+    DataTransferListener partListener = {nullptr, nullptr};
+    if (process.dataTransferStatusChange_ != nullptr) {
+        pProcessStat->dataTransferListener_ = process;
+        pProcessStat->totalBytes_ = totalBytes;
+        pProcessStat->consumedBytes_ = resumedBytes;
+        pProcessStat->userData = (void*)pProcessStat;
+        partListener = {UploadDownloadFileProcessCallback, (void*)pProcessStat};
+    }
+
+    auto logger = LogUtils::GetLogger(LogCategoryTransfer, LogInfo);
+    auto cancel = input.getCancelHook();
+    const auto& bucket = input.getBucket();
+    std::atomic<int64_t> uploadedFiles(0);
+    std::atomic<int64_t> uploadedBytes(0);
+    std::atomic<int64_t> failedFiles(0);
+    std::mutex errorLock;
+    TosError firstError;
+    bool hasFailed = false;
+    auto fail = [&](DirectoryFile* file, const TosError& err) {
+        std::lock_guard<std::mutex> lck(file->mu);
+        if (!file->failed) {
+            file->error = err;
+            file->failed = true;
+        }
+    };
+    auto recordUpload = [&](DirectoryFile* file) {
+        nlohmann::json j;
+        j["Type"] = "Upload";
+        j["Key"] = file->key;
+        j["Size"] = file->info.size;
+        j["LastModified"] = static_cast<int64_t>(file->info.lastModified);
+        j["PartSize"] = file->partSize;
+        j["UploadID"] = file->uploadId;
+        manifest.append(j);
+    };
+    auto finishFile = [&](DirectoryFile* file) {
+        if (!file->failed && file->partSize > 0) {
+            std::vector<UploadedPartV2> parts;
+            for (const auto& part : file->parts) {
+                parts.emplace_back(part.first, part.second);
+            }
+            CompleteMultipartUploadV2Input complete(bucket, file->key, file->uploadId, parts);
+            auto completeRes = this->completeMultipartUpload(complete);
+            if (!completeRes.isSuccess()) {
+                fail(file, completeRes.error());
+            }
+        }
+        if (file->failed) {
+            failedFiles++;
+            {
+                std::lock_guard<std::mutex> lck(errorLock);
+                if (!hasFailed) {
+                    hasFailed = true;
+                    firstError = file->error;
+                    firstError.setMessage(file->key + ": " + file->error.getMessage());
+                }
+            }
+            // 没有 manifest 时无法续传，取消分片上传
+            if (!file->uploadId.empty() && !manifest.enabled()) {
+                AbortMultipartUploadInput abort(bucket, file->key, file->uploadId);
+                if (!this->abortMultipartUpload(abort).isSuccess() && logger != nullptr) {
+                    logger->info("abort multipart upload failed");
+                }
+            }
+            return;
+        }
+        nlohmann::json j;
+        j["Type"] = "File";
+        j["Key"] = file->key;
+        j["Size"] = file->info.size;
+        j["LastModified"] = static_cast<int64_t>(file->info.lastModified);
+        manifest.append(j);
+        uploadedFiles++;
+        uploadedBytes += file->info.size;
+    };
+    auto runTask = [&](const DirectoryTask& task) {
+        auto file = task.file;
+        if (file->failed) {
+            return;
+        }
+        if (task.partNumber == 0) {
+            PutObjectFromFileInput put(bucket, file->key, file->info.path);
+            put.setDataTransferListener(partListener);
+            // 已按目录的 multipartThreshold 分流，小文件不再切换为分片上传
+            auto putRes = this->putObjectFromFile(put, false);
+            if (!putRes.isSuccess()) {
+                fail(file, putRes.error());
+            }
+            return;
+        }
+        if (task.partNumber < 0) {
+            return;
+        }
+        std::string uploadId;
+        {
+            // 第一个分片任务创建分片上传
+            std::lock_guard<std::mutex> lck(file->mu);
+            if (file->uploadId.empty()) {
+                CreateMultipartUploadInput create(bucket, file->key);
+                auto createRes = this->createMultipartUpload(create);
+                if (!createRes.isSuccess()) {
+                    file->error = createRes.error();
+                    file->failed = true;
+                    return;
+                }
+                file->uploadId = createRes.result().getUploadId();
+                recordUpload(file);
+            }
+            uploadId = file->uploadId;
+        }
+        auto offset = (task.partNumber - 1) * file->partSize;
+        auto size = std::min(file->partSize, file->info.size - offset);
+        UploadPartFromFileInput part(bucket, file->key, uploadId, task.partNumber, file->info.path, offset, size);
+        part.setDataTransferListener(partListener);
+        auto partRes = this->uploadPartFromFile(part, nullptr);
+        if (!partRes.isSuccess()) {
+            // manifest 中的分片上传已失效，下次重新上传
+            if (file->resumed && partRes.error().getStatusCode() == 404) {
+                std::lock_guard<std::mutex> lck(file->mu);
+                file->uploadId.clear();
+                recordUpload(file);
+            }
+            fail(file, partRes.error());
+            return;
+        }
+        const auto& etag = partRes.result().getUploadPartV2Output().getETag();
+        {
+            std::lock_guard<std::mutex> lck(file->mu);
+            file->parts[task.partNumber] = etag;
+        }
+        nlohmann::json j;
+        j["Type"] = "Part";
+        j["Key"] = file->key;
+        j["UploadID"] = uploadId;
+        j["PartNumber"] = task.partNumber;
+        j["ETag"] = etag;
+        manifest.append(j);
+    };
+
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> threadPool;
+    auto workers = std::min(static_cast<size_t>(taskNum), tasks.size());
+    for (size_t i = 0; i < workers; i++) {
+        threadPool.emplace_back([&]() {
+            size_t current;
+            while ((current = next++) < tasks.size()) {
+                if (cancel != nullptr && cancel->isCancel()) {
+                    break;
+                }
+                const auto& task = tasks[current];
+                runTask(task);
+                if (--task.file->remaining == 0) {
+                    finishFile(task.file);
+                }
+            }
+        });
+    }
+    for (auto& worker : threadPool) {
+        worker.join();
+    }
+
+    if (cancel != nullptr && cancel->isCancel()) {
+        // 取消并 abort 时清理未完成的分片上传
+        if (cancel->isAbortFunc()) {
+            for (auto& file : files) {
+                if (file->remaining > 0 && !file->uploadId.empty()) {
+                    AbortMultipartUploadInput abort(bucket, file->key, file->uploadId);
+                    this->abortMultipartUpload(abort);
+                }
+            }
+        }
+        error.setMessage("the task is canceled");
+        res.setE(error);
+        res.setSuccess(false);
+        return res;
+    }
+    if (failedFiles > 0) {
+        firstError.setMessage("some files are uploaded incorrectly (" + std::to_string(failedFiles.load()) +
+                              " failed), you can try again, first error: " + firstError.getMessage());
+        res.setE(firstError);
+        res.setSuccess(false);
+        return res;
+    }
+    output.setUploadedFiles(uploadedFiles);
+    output.setUploadedBytes(uploadedBytes);
+    res.setSuccess(true);
+    res.setR(std::move(output));
+    return res;
+}
@@ -15,6 +15,19 @@ DefaultTransport::DefaultTransport(const TransportConfig& config) {
     conf.proxyUsername = config.getProxyUsername();
     conf.proxyPassword = config.getProxyPassword();
     conf.dnsCacheTime = config.getDnsCacheTime();
+    conf.enableDnsLoadBalance = config.isEnableDnsLoadBalance();
+    conf.tlsHandshakeTimeout = config.getTlsHandshakeTimeout();
+    conf.responseHeaderTimeout = config.getResponseHeaderTimeout();
+    conf.readTimeout = config.getReadTimeout();
+    conf.writeTimeout = config.getWriteTimeout();
+    conf.tcpKeepAliveInterval = config.getKeepAliveInterval();
+    conf.tcpKeepAliveCount = config.getKeepAliveCount();
+    conf.maxIdleCount = config.getMaxIdleCount();
+    conf.idleConnectionTimeout = config.getIdleConnectionTimeout();
+    conf.receiveBufferSize = config.getReceiveBufferSize();
+    conf.uploadBufferSize = config.getUploadBufferSize();
+    conf.socketSendBufferSize = config.getSocketSendBufferSize();
+    conf.socketReceiveBufferSize = config.getSocketReceiveBufferSize();
     client_ = std::make_shared<HttpClient>(conf);
 }
 
@@ -28,12 +41,17 @@ std::shared_ptr<TosResponse> DefaultTransport::roundTrip(const std::shared_ptr<T
     httpReq->setUrl(request->toUrl());
     httpReq->setHeaders(request->getHeaders());
     httpReq->setMethod(request->getMethod());
-    httpReq->setBody(request->getContent());
+    httpReq->setBodySource(request->getBodySource());
+    httpReq->setResponseSink(request->getResponseSink());
     httpReq->setContentLength(request->getContentLength());
     httpReq->setDataTransferListener(request->getDataTransferListener());
     httpReq->setRateLimiter(request->getRataLimiter());
+    httpReq->setTransferMonitor(request->getTransferMonitor());
+    httpReq->setFreshConnection(request->isFreshConnection());
     httpReq->setCheckCrc64(request->isCheckCrc64());
     httpReq->setPreHashCrc64Ecma(request->getPreHashCrc64Ecma());
+    httpReq->setFuncName(request->getFuncName());
+    httpReq->setOperationMetrics(request->getOperationMetrics());
     auto httpResp = client_->doRequest(httpReq);
     auto res = std::make_shared<TosResponse>(httpResp->Body());
     res->setStatusCode(httpResp->statusCode());
@@ -41,6 +59,7 @@ std::shared_ptr<TosResponse> DefaultTransport::roundTrip(const std::shared_ptr<T
     res->setHeaders(httpResp->Headers());
     res->setHashCrc64Result(httpResp->getHashCrc64Result());
     res->setCurlErrCode(httpResp->getCurlErrCode());
+    res->setConnectFailed(httpResp->isConnectFailed());
     std::string cl(httpResp->getHeaderValueByKey(http::HEADER_CONTENT_LENGTH));
     if (cl.empty()) {
         res->setContentLength(0);
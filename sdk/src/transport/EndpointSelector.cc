@@ -0,0 +1,268 @@
+#include "EndpointSelector.h"
+#include <algorithm>
+#include <curl/curl.h>
+#include "metrics/Metrics.h"
+#include "utils/BaseUtils.h"
+#include "../utils/LogUtils.h"
+
+using namespace VolcengineTos;
+
+static const int minEjectMillis = 1000;
+static const int maxEjectMillis = 30000;
+
+// 指标与日志中的 endpoint 名称，scheme 不同的同一 host 分别统计
+static std::string endpointName(const EndpointSelector::Endpoint& endpoint) {
+    return endpoint.scheme + "://" + endpoint.host;
+}
+
+EndpointSelector::EndpointSelector(std::vector<Endpoint> endpoints, int probeIntervalSeconds, ProbeFunc probe)
+        : endpoints_(std::move(endpoints)),
+          probeIntervalSeconds_(probeIntervalSeconds),
+          probe_(std::move(probe)),
+          failing_(new std::atomic<bool>[endpoints_.size()]) {
+    for (size_t i = 0; i < endpoints_.size(); i++) {
+        State s;
+        s.stats.scheme = endpoints_[i].scheme;
+        s.stats.host = endpoints_[i].host;
+        states_.push_back(s);
+        failing_[i] = false;
+    }
+    if (probeIntervalSeconds_ > 0 && probe_ && endpoints_.size() > 1) {
+        prober_ = std::thread(&EndpointSelector::probeLoop, this);
+    }
+}
+
+EndpointSelector::~EndpointSelector() {
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    if (prober_.joinable()) {
+        prober_.join();
+    }
+}
+
+int EndpointSelector::fastest(Clock::time_point now, const std::vector<bool>& exclude) const {
+    int best = -1;
+    for (size_t i = 0; i < states_.size(); i++) {
+        if (exclude[i] || now < states_[i].ejectUntil) {
+            continue;
+        }
+        if (best < 0) {
+            best = static_cast<int>(i);
+            continue;
+        }
+        // 尚无探测结果的排在有结果的之后，同样没有时按配置顺序
+        auto latency = states_[i].stats.avgLatencyMicros;
+        auto bestLatency = states_[best].stats.avgLatencyMicros;
+        if (latency != 0 && (bestLatency == 0 || latency < bestLatency)) {
+            best = static_cast<int>(i);
+        }
+    }
+    return best;
+}
+
+void EndpointSelector::switchTo(size_t index, const char* reason) {
+    size_t active = active_.load(std::memory_order_relaxed);
+    if (index == active) {
+        return;
+    }
+    auto logger = LogUtils::GetLogger(LogCategoryTransport, LogInfo);
+    if (logger != nullptr) {
+        logger->info("switch endpoint from {} to {}: {}", endpointName(endpoints_[active]),
+                     endpointName(endpoints_[index]), reason);
+    }
+    if (MetricsRegistry::Enabled()) {
+        MetricsRegistry::instance()->recordEndpointSwitch(endpointName(endpoints_[index]));
+    }
+    active_.store(index, std::memory_order_relaxed);
+}
+
+void EndpointSelector::rebalance(Clock::time_point now) {
+    // 下一个被剔除的 endpoint 恢复时需要重新选择
+    auto next = Clock::time_point::max();
+    for (const auto& s : states_) {
+        if (now < s.ejectUntil) {
+            next = std::min(next, s.ejectUntil);
+        }
+    }
+    nextRebalance_.store(next.time_since_epoch().count(), std::memory_order_relaxed);
+
+    size_t active = active_.load(std::memory_order_relaxed);
+    int best = fastest(now, std::vector<bool>(states_.size(), false));
+    if (best < 0) {
+        // 全部被剔除，选最早恢复的 endpoint 探测
+        size_t earliest = 0;
+        for (size_t i = 1; i < states_.size(); i++) {
+            if (states_[i].ejectUntil < states_[earliest].ejectUntil) {
+                earliest = i;
+            }
+        }
+        switchTo(earliest, "all endpoints ejected");
+        return;
+    }
+    if (static_cast<size_t>(best) == active) {
+        return;
+    }
+    if (now < states_[active].ejectUntil) {
+        switchTo(best, "endpoint ejected");
+        return;
+    }
+    // 两者都有探测结果时，快 20% 以上才切换，避免在耗时相近的 endpoint 间来回切换
+    auto activeLatency = states_[active].stats.avgLatencyMicros;
+    auto bestLatency = states_[best].stats.avgLatencyMicros;
+    if (activeLatency == 0 || bestLatency == 0 || bestLatency * 5 < activeLatency * 4) {
+        switchTo(best, "faster endpoint");
+    }
+}
+
+size_t EndpointSelector::select() {
+    if (endpoints_.size() == 1) {
+        return 0;
+    }
+    // 状态没有变化时不加锁，直接使用当前的 endpoint
+    auto now = Clock::now();
+    if (now.time_since_epoch().count() < nextRebalance_.load(std::memory_order_relaxed)) {
+        return active_.load(std::memory_order_relaxed);
+    }
+    std::lock_guard<std::mutex> lock(mu_);
+    rebalance(now);
+    return active_.load(std::memory_order_relaxed);
+}
+
+void EndpointSelector::eject(size_t index) {
+    auto& s = states_[index];
+    s.stats.failures++;
+    int millis = minEjectMillis << std::min(s.stats.failures - 1, 5);
+    s.ejectUntil = Clock::now() + std::chrono::milliseconds(std::min(millis, maxEjectMillis));
+    failing_[index] = true;
+    nextRebalance_.store(0, std::memory_order_relaxed);
+}
+
+int EndpointSelector::failover(size_t index, std::vector<bool>& tried) {
+    std::lock_guard<std::mutex> lock(mu_);
+    tried.resize(states_.size(), false);
+    tried[index] = true;
+    eject(index);
+    if (MetricsRegistry::Enabled()) {
+        MetricsRegistry::instance()->recordEndpointFailure(endpointName(endpoints_[index]));
+    }
+    int next = fastest(Clock::now(), tried);
+    if (next < 0) {
+        // 其余 endpoint 也被剔除时，仍按顺序尝试未尝试过的
+        for (size_t i = 0; i < tried.size(); i++) {
+            if (!tried[i]) {
+                next = static_cast<int>(i);
+                break;
+            }
+        }
+    }
+    if (next < 0) {
+        return -1;
+    }
+    if (active_.load(std::memory_order_relaxed) == index) {
+        switchTo(next, "connect failed");
+    } else if (MetricsRegistry::Enabled()) {
+        MetricsRegistry::instance()->recordEndpointSwitch(endpointName(endpoints_[next]));
+    }
+    return next;
+}
+
+void EndpointSelector::succeed(size_t index) {
+    // 大多数请求所在的 endpoint 没有失败记录，不需要加锁
+    if (endpoints_.size() == 1 || !failing_[index].load(std::memory_order_relaxed)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mu_);
+    states_[index].stats.failures = 0;
+    states_[index].ejectUntil = Clock::time_point();
+    failing_[index] = false;
+    nextRebalance_.store(0, std::memory_order_relaxed);
+}
+
+void EndpointSelector::probe() {
+    bool enableMetrics = MetricsRegistry::Enabled();
+    for (size_t i = 0; i < endpoints_.size(); i++) {
+        auto micros = probe_(endpoints_[i].scheme, endpoints_[i].host);
+        if (enableMetrics) {
+            MetricsRegistry::instance()->recordEndpointProbe(endpointName(endpoints_[i]), micros >= 0,
+                                                             micros >= 0 ? micros : 0);
+        }
+        std::lock_guard<std::mutex> lock(mu_);
+        auto& s = states_[i];
+        if (micros < 0) {
+            eject(i);
+            continue;
+        }
+        auto latency = static_cast<uint64_t>(std::max<int64_t>(micros, 1));
+        s.stats.avgLatencyMicros =
+                s.stats.avgLatencyMicros == 0 ? latency : (s.stats.avgLatencyMicros * 7 + latency) / 8;
+        s.stats.failures = 0;
+        s.ejectUntil = Clock::time_point();
+        failing_[i] = false;
+        // 耗时变化后可能需要切换到更快的 endpoint
+        nextRebalance_.store(0, std::memory_order_relaxed);
+    }
+}
+
+void EndpointSelector::probeLoop() {
+    std::unique_lock<std::mutex> lock(mu_);
+    while (!stop_) {
+        lock.unlock();
+        probe();
+        lock.lock();
+        cv_.wait_for(lock, std::chrono::seconds(probeIntervalSeconds_), [this] { return stop_; });
+    }
+}
+
+std::vector<EndpointStats> EndpointSelector::stats() {
+    std::vector<EndpointStats> result;
+    std::lock_guard<std::mutex> lock(mu_);
+    auto now = Clock::now();
+    for (const auto& s : states_) {
+        auto stats = s.stats;
+        stats.ejected = now < s.ejectUntil;
+        result.push_back(stats);
+    }
+    return result;
+}
+
+EndpointSelector::ProbeFunc EndpointSelector::httpProbe(const TransportConfig& config) {
+    return [config](const std::string& scheme, const std::string& host) -> int64_t {
+        CURL* curl = curl_easy_init();
+        if (curl == nullptr) {
+            return -1;
+        }
+        // 只关心能否建连并收到响应，任何状态码都视为可达
+        std::string url = scheme + "://" + host + "/";
+        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+        curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+        if (config.getConnectTimeout() > 0) {
+            curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, static_cast<long>(config.getConnectTimeout()));
+            curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, static_cast<long>(config.getConnectTimeout()) * 2);
+        }
+        std::string proxy;
+        std::string proxyUserPwd;
+        if (config.getProxyPort() != -1 && !config.getProxyHost().empty()) {
+            proxy = config.getProxyHost() + ":" + std::to_string(config.getProxyPort());
+            proxyUserPwd = config.getProxyUsername() + ":" + config.getProxyPassword();
+            curl_easy_setopt(curl, CURLOPT_PROXY, proxy.c_str());
+            curl_easy_setopt(curl, CURLOPT_PROXYUSERPWD, proxyUserPwd.c_str());
+            curl_easy_setopt(curl, CURLOPT_PROXYTYPE, CURLPROXY_HTTP);
+        }
+        if (!config.isEnableVerifySsl()) {
+            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
+            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
+        }
+        int64_t micros = -1;
+        if (curl_easy_perform(curl) == CURLE_OK) {
+            double seconds = 0;
+            curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME, &seconds);
+            micros = static_cast<int64_t>(seconds * 1000000);
+        }
+        curl_easy_cleanup(curl);
+        return micros;
+    };
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "transport/TransportConfig.h"
+
+namespace VolcengineTos {
+// 单个 endpoint 的状态，供测试与排查使用
+struct EndpointStats {
+    std::string scheme;
+    std::string host;
+    int failures = 0;
+    bool ejected = false;
+    // 探测耗时的指数滑动平均，单位微秒，尚未探测成功时为 0
+    uint64_t avgLatencyMicros = 0;
+};
+
+// 在一组可互相替代的 endpoint（例如同一 region 的内网与公网 endpoint）间为请求选择 endpoint。
+// 后台定期探测各 endpoint 的耗时，新请求发往最快的健康 endpoint；尚无探测结果时按配置顺序选择。
+// 探测或请求建连失败的 endpoint 被暂时剔除，剔除时间随连续失败次数指数增长
+class EndpointSelector {
+public:
+    // 返回探测耗时，单位微秒，不可达时返回 -1
+    using ProbeFunc = std::function<int64_t(const std::string& scheme, const std::string& host)>;
+    struct Endpoint {
+        std::string scheme;
+        std::string host;
+    };
+
+    // probeIntervalSeconds 不大于 0 时不启动后台探测
+    EndpointSelector(std::vector<Endpoint> endpoints, int probeIntervalSeconds, ProbeFunc probe);
+    ~EndpointSelector();
+
+    size_t size() const {
+        return endpoints_.size();
+    }
+    const Endpoint& endpoint(size_t index) const {
+        return endpoints_[index];
+    }
+
+    // 为新请求选择 endpoint
+    size_t select();
+    // 请求在 index 上建连失败，剔除该 endpoint 并返回下一个未尝试过的 endpoint，都尝试过时返回 -1。
+    // tried 记录本次请求已尝试过的 endpoint
+    int failover(size_t index, std::vector<bool>& tried);
+    // 请求在 index 上收到了响应
+    void succeed(size_t index);
+    // 探测一轮全部 endpoint
+    void probe();
+
+    std::vector<EndpointStats> stats();
+
+    // 以 HEAD 请求 endpoint 根路径的耗时作为探测结果，沿用 config 中的代理、SSL 与建连超时设置
+    static ProbeFunc httpProbe(const TransportConfig& config);
+
+private:
+    using Clock = std::chrono::steady_clock;
+    struct State {
+        EndpointStats stats;
+        Clock::time_point ejectUntil;
+    };
+
+    void eject(size_t index);
+    // 重新选择 active_，并计算下一次需要重新选择的时间
+    void rebalance(Clock::time_point now);
+    // 在未被剔除且不在 exclude 中的 endpoint 里选最快的，没有时返回 -1
+    int fastest(Clock::time_point now, const std::vector<bool>& exclude) const;
+    void switchTo(size_t index, const char* reason);
+    void probeLoop();
+
+    std::vector<Endpoint> endpoints_;
+    int probeIntervalSeconds_;
+    ProbeFunc probe_;
+
+    std::mutex mu_;
+    std::vector<State> states_;
+    // 当前新请求使用的 endpoint，select 不加锁读取
+    std::atomic<size_t> active_{0};
+    // 早于该时间（steady_clock 计数）时 select 直接返回 active_；状态变化时置 0，被剔除的 endpoint 恢复时到期
+    std::atomic<int64_t> nextRebalance_{0};
+    // 各 endpoint 是否有未清除的失败，succeed 先检查它再加锁
+    std::unique_ptr<std::atomic<bool>[]> failing_;
+
+    std::condition_variable cv_;
+    bool stop_ = false;
+    std::thread prober_;
+};
+}  // namespace VolcengineTos
@@ -0,0 +1,129 @@
+#include "transport/http/Body.h"
+#include "../../utils/FileRangeReader.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace VolcengineTos;
+
+int64_t MemoryBodySource::readAt(int64_t offset, char* buf, int64_t len) {
+    if (offset < 0 || offset > size_) {
+        return -1;
+    }
+    len = std::min(len, size_ - offset);
+    std::memcpy(buf, data_ + offset, static_cast<size_t>(len));
+    return len;
+}
+
+FileBodySource::FileBodySource(const std::string& filePath, int64_t offset, int64_t length)
+        : reader_(new FileRangeReader(filePath)), offset_(offset), length_(length) {
+    if (length_ < 0 && reader_->good()) {
+        length_ = std::max<int64_t>(reader_->size() - offset_, 0);
+    }
+}
+
+FileBodySource::~FileBodySource() = default;
+
+bool FileBodySource::good() const {
+    return reader_->good() && length_ >= 0;
+}
+
+int64_t FileBodySource::readAt(int64_t offset, char* buf, int64_t len) {
+    if (!good() || offset < 0 || offset > length_) {
+        return -1;
+    }
+    len = std::min(len, length_ - offset);
+    if (len > 0 && !reader_->read(buf, offset_ + offset, len)) {
+        return -1;
+    }
+    return len;
+}
+
+StreamBodySource::StreamBodySource(std::shared_ptr<std::iostream> stream, int64_t length)
+        : stream_(std::move(stream)), start_(-1), length_(length) {
+    int64_t pos = stream_->tellg();
+    if (pos < 0) {
+        // 流处于 fail 状态时 tellg 返回 -1，清除状态后重新获取；仍然失败的流只能顺序读取一次，长度未知
+        stream_->clear();
+        pos = stream_->tellg();
+    }
+    start_ = pos;
+}
+
+int64_t StreamBodySource::size() {
+    if (length_ < 0 && start_ >= 0) {
+        stream_->seekg(0, std::ios::end);
+        int64_t end = stream_->tellg();
+        stream_->clear();
+        stream_->seekg(start_ + pos_, std::ios::beg);
+        if (end >= start_) {
+            length_ = end - start_;
+        }
+    }
+    return length_;
+}
+
+int64_t StreamBodySource::readAt(int64_t offset, char* buf, int64_t len) {
+    if (offset != pos_) {
+        if (start_ < 0) {
+            return -1;
+        }
+        stream_->clear();
+        stream_->seekg(start_ + offset, std::ios::beg);
+        if (stream_->fail()) {
+            return -1;
+        }
+        pos_ = offset;
+    }
+    if (length_ >= 0) {
+        len = std::min(len, length_ - offset);
+    }
+    if (len <= 0) {
+        return 0;
+    }
+    stream_->read(buf, len);
+    auto got = static_cast<int64_t>(stream_->gcount());
+    if (stream_->bad()) {
+        return -1;
+    }
+    pos_ += got;
+    return got;
+}
+
+bool MemoryBodySink::writeAt(int64_t offset, const char* data, int64_t len) {
+    if (offset < 0 || offset + len > capacity_) {
+        return false;
+    }
+    std::memcpy(buffer_ + offset, data, static_cast<size_t>(len));
+    written_ = std::max(written_, offset + len);
+    return true;
+}
+
+StreamBodySink::StreamBodySink(std::shared_ptr<std::iostream> stream) : stream_(std::move(stream)), start_(-1) {
+    int64_t pos = stream_->tellp();
+    if (pos < 0) {
+        stream_->clear();
+        pos = stream_->tellp();
+    }
+    start_ = pos;
+}
+
+bool StreamBodySink::writeAt(int64_t offset, const char* data, int64_t len) {
+    if (offset != pos_) {
+        // 重试时回到起始位置重新写入
+        if (start_ < 0) {
+            return false;
+        }
+        stream_->clear();
+        stream_->seekp(start_ + offset, std::ios::beg);
+        if (stream_->fail()) {
+            return false;
+        }
+        pos_ = offset;
+    }
+    stream_->write(data, static_cast<std::streamsize>(len));
+    if (stream_->bad()) {
+        return false;
+    }
+    pos_ += len;
+    return true;
+}
@@ -0,0 +1,212 @@
+#include "HostResolver.h"
+#include <algorithm>
+#include <cstring>
+#include "metrics/Metrics.h"
+#include "utils/BaseUtils.h"
+#include "../../utils/LogUtils.h"
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#endif
+
+using namespace VolcengineTos;
+
+static const int minEjectMillis = 1000;
+static const int maxEjectMillis = 30000;
+
+HostResolver::HostResolver(int ttlSeconds, ResolveFunc resolve)
+        : ttlSeconds_(ttlSeconds > 0 ? ttlSeconds : 60), resolve_(std::move(resolve)) {
+    if (!resolve_) {
+        resolve_ = resolveAll;
+    }
+}
+
+std::vector<std::string> HostResolver::resolveAll(const std::string& host, int port) {
+    std::vector<std::string> addresses;
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* result = nullptr;
+    if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &result) != 0) {
+        return addresses;
+    }
+    for (auto p = result; p != nullptr; p = p->ai_next) {
+        char buf[INET6_ADDRSTRLEN] = {0};
+        const void* addr = nullptr;
+        if (p->ai_family == AF_INET) {
+            addr = &reinterpret_cast<sockaddr_in*>(p->ai_addr)->sin_addr;
+        } else if (p->ai_family == AF_INET6) {
+            addr = &reinterpret_cast<sockaddr_in6*>(p->ai_addr)->sin6_addr;
+        }
+        if (addr == nullptr || inet_ntop(p->ai_family, addr, buf, sizeof(buf)) == nullptr) {
+            continue;
+        }
+        std::string address(buf);
+        if (std::find(addresses.begin(), addresses.end(), address) == addresses.end()) {
+            addresses.push_back(address);
+        }
+    }
+    freeaddrinfo(result);
+    return addresses;
+}
+
+bool HostResolver::isAddressLiteral(const std::string& host) {
+    unsigned char buf[sizeof(in6_addr)];
+    std::string h = host;
+    if (h.size() > 2 && h.front() == '[' && h.back() == ']') {
+        h = h.substr(1, h.size() - 2);
+    }
+    return inet_pton(AF_INET, h.c_str(), buf) == 1 || inet_pton(AF_INET6, h.c_str(), buf) == 1;
+}
+
+HostResolver::Address* HostResolver::find(Entry& entry, const std::string& address) {
+    for (auto& a : entry.addresses) {
+        if (a.stats.address == address) {
+            return &a;
+        }
+    }
+    return nullptr;
+}
+
+void HostResolver::refresh(const std::string& key, const std::string& host, int port,
+                           std::unique_lock<std::mutex>& lock) {
+    entries_[key].resolving = true;
+    lock.unlock();
+    auto resolved = resolve_(host, port);
+    lock.lock();
+    auto& entry = entries_[key];
+    entry.resolving = false;
+    resolved_.notify_all();
+    if (resolved.empty()) {
+        // 解析失败时保留旧结果，稍后重试
+        entry.expireAt = Clock::now() + std::chrono::seconds(1);
+        return;
+    }
+    // 仍然存在的地址保留统计与剔除状态
+    std::vector<Address> addresses;
+    for (const auto& ip : resolved) {
+        auto old = find(entry, ip);
+        if (old != nullptr) {
+            addresses.push_back(*old);
+        } else {
+            Address a;
+            a.stats.address = ip;
+            addresses.push_back(a);
+        }
+    }
+    entry.addresses.swap(addresses);
+    entry.expireAt = Clock::now() + std::chrono::seconds(ttlSeconds_);
+}
+
+std::string HostResolver::acquire(const std::string& host, int port, const std::string& preferred) {
+    auto key = host + ":" + std::to_string(port);
+    std::unique_lock<std::mutex> lock(mu_);
+    auto now = Clock::now();
+    auto& entry = entries_[key];
+    // 首次解析时只有一个线程调用 resolve，其他线程等待它的结果；过期后只有一个线程刷新，其他线程继续使用旧地址
+    if (entry.addresses.empty() && entry.resolving) {
+        resolved_.wait(lock, [&]() { return !entry.resolving; });
+        now = Clock::now();
+    } else if (entry.addresses.empty() || (now >= entry.expireAt && !entry.resolving)) {
+        refresh(key, host, port, lock);
+        now = Clock::now();
+    }
+    auto& current = entries_[key];
+    if (current.addresses.empty()) {
+        return "";
+    }
+
+    Address* chosen = nullptr;
+    int64_t minOutstanding = INT64_MAX;
+    for (const auto& a : current.addresses) {
+        if (now >= a.ejectUntil) {
+            minOutstanding = std::min(minOutstanding, a.stats.outstanding);
+        }
+    }
+    if (minOutstanding == INT64_MAX) {
+        // 全部被剔除，选最早恢复的地址探测
+        for (auto& a : current.addresses) {
+            if (chosen == nullptr || a.ejectUntil < chosen->ejectUntil) {
+                chosen = &a;
+            }
+        }
+    } else {
+        auto p = preferred.empty() ? nullptr : find(current, preferred);
+        if (p != nullptr && now >= p->ejectUntil && p->stats.outstanding <= minOutstanding) {
+            chosen = p;
+        } else {
+            size_t n = current.addresses.size();
+            for (size_t i = 0; i < n; i++) {
+                auto& a = current.addresses[(current.cursor + i) % n];
+                if (now >= a.ejectUntil && a.stats.outstanding == minOutstanding) {
+                    chosen = &a;
+                    current.cursor = (current.cursor + i + 1) % n;
+                    break;
+                }
+            }
+        }
+    }
+    chosen->stats.outstanding++;
+    return chosen->stats.address;
+}
+
+void HostResolver::release(const std::string& host, int port, const std::string& address, bool connectFailed,
+                           uint64_t connectMicros) {
+    auto key = host + ":" + std::to_string(port);
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        return;
+    }
+    // 刷新后地址可能已不在列表中
+    auto a = find(it->second, address);
+    if (a == nullptr) {
+        return;
+    }
+    a->stats.outstanding = std::max<int64_t>(a->stats.outstanding - 1, 0);
+    bool enableMetrics = MetricsRegistry::Enabled();
+    if (connectFailed) {
+        a->stats.failures++;
+        int millis = minEjectMillis << std::min(a->stats.failures - 1, 5);
+        a->ejectUntil = Clock::now() + std::chrono::milliseconds(std::min(millis, maxEjectMillis));
+        if (enableMetrics) {
+            MetricsRegistry::instance()->recordAddressConnect(host, address, false, 0);
+        }
+        auto logger = LogUtils::GetLogger(LogCategoryTransport, LogInfo);
+        if (logger != nullptr) {
+            logger->info("connect to {} ({}) failed {} times, eject for {} ms", address, host, a->stats.failures,
+                         std::min(millis, maxEjectMillis));
+        }
+        return;
+    }
+    if (connectMicros > 0) {
+        a->stats.failures = 0;
+        a->stats.connects++;
+        a->stats.avgConnectMicros = a->stats.avgConnectMicros == 0
+                                            ? connectMicros
+                                            : (a->stats.avgConnectMicros * 7 + connectMicros) / 8;
+        if (enableMetrics) {
+            MetricsRegistry::instance()->recordAddressConnect(host, address, true, connectMicros);
+        }
+    }
+}
+
+std::vector<HostAddressStats> HostResolver::stats(const std::string& host, int port) {
+    std::vector<HostAddressStats> result;
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = entries_.find(host + ":" + std::to_string(port));
+    if (it == entries_.end()) {
+        return result;
+    }
+    auto now = Clock::now();
+    for (const auto& a : it->second.addresses) {
+        auto s = a.stats;
+        s.ejected = now < a.ejectUntil;
+        result.push_back(s);
+    }
+    return result;
+}
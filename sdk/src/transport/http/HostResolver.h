@@ -0,0 +1,68 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace VolcengineTos {
+// 单个地址的状态，供测试与排查使用
+struct HostAddressStats {
+    std::string address;
+    int64_t outstanding = 0;
+    int failures = 0;
+    bool ejected = false;
+    uint64_t connects = 0;
+    // 新建连接耗时（含 TLS 握手）的指数滑动平均，单位微秒
+    uint64_t avgConnectMicros = 0;
+};
+
+// 解析 host 的全部 A/AAAA 记录，新请求在健康地址间按进行中的请求数最少分散，同样少时轮转。
+// 建连或 TLS 握手失败的地址被暂时剔除，剔除时间随连续失败次数指数增长；全部被剔除时选最早恢复的地址探测。
+class HostResolver {
+public:
+    using ResolveFunc = std::function<std::vector<std::string>(const std::string& host, int port)>;
+    // ttlSeconds 为解析结果的缓存时间，resolve 为空时使用 getaddrinfo
+    explicit HostResolver(int ttlSeconds, ResolveFunc resolve = nullptr);
+
+    // 为一次请求选择地址。preferred 为 curl 句柄上次使用的地址，仍健康且不比其他地址繁忙时沿用，以复用已有连接。
+    // 解析失败时返回空串，调用方回退到 libcurl 自己的解析
+    std::string acquire(const std::string& host, int port, const std::string& preferred);
+    // 请求结束。connectFailed 为 true 时剔除该地址；connectMicros 为新建连接的耗时，复用连接时为 0
+    void release(const std::string& host, int port, const std::string& address, bool connectFailed,
+                 uint64_t connectMicros);
+
+    std::vector<HostAddressStats> stats(const std::string& host, int port);
+
+    static std::vector<std::string> resolveAll(const std::string& host, int port);
+    static bool isAddressLiteral(const std::string& host);
+
+private:
+    using Clock = std::chrono::steady_clock;
+    struct Address {
+        HostAddressStats stats;
+        Clock::time_point ejectUntil;
+    };
+    struct Entry {
+        std::vector<Address> addresses;
+        Clock::time_point expireAt;
+        size_t cursor = 0;
+        bool resolving = false;
+    };
+
+    void refresh(const std::string& key, const std::string& host, int port, std::unique_lock<std::mutex>& lock);
+    static Address* find(Entry& entry, const std::string& address);
+
+    int ttlSeconds_;
+    ResolveFunc resolve_;
+    std::mutex mu_;
+    // 解析完成时通知等待首次解析结果的线程
+    std::condition_variable resolved_;
+    // key 为 host:port
+    std::map<std::string, Entry> entries_;
+};
+}  // namespace VolcengineTos
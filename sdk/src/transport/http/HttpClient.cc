@@ -1,7 +1,15 @@
 #include <iostream>
 #include "curl/curl.h"
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#endif
 
 #include "transport/http/HttpClient.h"
+#include "HostResolver.h"
 #include "common/Common.h"
 #include "utils/BaseUtils.h"
 #include "TosClient.h"
@@ -25,6 +33,18 @@ struct ResourceManager {
     uint64_t recvCrc64Value;
     std::shared_ptr<RateLimiter> rateLimiter;
     //    std::shared_ptr<DataConsumeCallBack> callBack;
+    std::shared_ptr<BodySink> sink;  // 2xx 响应体的接收方，第一次 receive 时确定
+    int64_t recvOffset;              // 已写入 sink 的字节数
+    // 设置了 responseHeaderTimeout/readTimeout/writeTimeout 时由 transferProgress 检查，单位毫秒
+    int64_t responseHeaderTimeout;
+    int64_t readTimeout;
+    int64_t writeTimeout;
+    bool headerReceived;
+    curl_off_t lastUploaded;
+    curl_off_t lastDownloaded;
+    std::chrono::steady_clock::time_point lastProgress;  // 上次收发数据的时间
+    const char* timeoutReason;                           // 非空时表示因超时中止
+    TransferMonitor* monitor;                            // 非空时由 transferProgress 更新进度并检查是否被中止
 };
 
 static void processHandler(const DataTransferStatusChange& handler, int64_t consumedBytes, int64_t totalBytes,
@@ -43,7 +63,7 @@ static size_t sendBody(char* ptr, size_t size, size_t nmemb, void* data) {
                        resourceMan->userData);
         return 0;
     }
-    std::shared_ptr<std::iostream>& content = resourceMan->httpReq->Body();
+    const std::shared_ptr<BodySource>& source = resourceMan->httpReq->getBodySource();
     const size_t wanted = size * nmemb;
 
     auto rateLimiter = resourceMan->rateLimiter;
@@ -63,7 +83,7 @@ static size_t sendBody(char* ptr, size_t size, size_t nmemb, void* data) {
     }
 
     size_t got = 0;
-    if (content != nullptr && wanted > 0) {
+    if (source != nullptr && wanted > 0) {
         size_t read = wanted;
         if (resourceMan->total > 0) {
             int64_t remains = resourceMan->total - resourceMan->send;
@@ -71,8 +91,17 @@ static size_t sendBody(char* ptr, size_t size, size_t nmemb, void* data) {
                 read = static_cast<size_t>(remains);
             }
         }
-        content->read(ptr, read);
-        got = static_cast<size_t>(content->gcount());
+        // 按偏移读取，每次发送都从 0 开始，重试时无需 seek
+        int64_t n = source->readAt(resourceMan->send, ptr, static_cast<int64_t>(read));
+        if (n < 0) {
+            resourceMan->dataTransferType = 4;
+            if (resourceMan->progress) {
+                processHandler(resourceMan->progress, resourceMan->send, resourceMan->total, 0,
+                               resourceMan->dataTransferType, resourceMan->userData);
+            }
+            return CURL_READFUNC_ABORT;
+        }
+        got = static_cast<size_t>(n);
     }
 
     resourceMan->send += got;
@@ -123,35 +152,35 @@ static size_t recvBody(char* ptr, size_t size, size_t nmemb, void* userdata) {
         return -1;
     }
     // 第一次receive response body , 初始化state->resposne->body
-    // 如果200使用传入的iostream接收数据，反之生成一个stringstream接收错误信息
+    // 如果200使用请求的 BodySink 接收数据，未设置时写入传入的iostream，反之生成一个stringstream接收错误信息。
+    // 这里创建的 sink 只在本次请求内有效，需要在重试时回到起始位置的输出流应由调用方在请求上设置 sink
     if (resourceMan->firstRecv) {
         long response_code = 0;
         curl_easy_getinfo(resourceMan->curl, CURLINFO_RESPONSE_CODE, &response_code);
         if (response_code / 100 == 2) {
-            resourceMan->httpResp->setBody(resourceMan->httpReq->responseOutput());
+            auto output = resourceMan->httpReq->responseOutput();
+            resourceMan->httpResp->setBody(output);
+            resourceMan->sink = resourceMan->httpReq->getResponseSink();
+            if (resourceMan->sink == nullptr && output != nullptr && !output->fail()) {
+                resourceMan->sink = std::make_shared<StreamBodySink>(output);
+            }
         } else {
-            resourceMan->httpResp->setBody(std::make_shared<std::stringstream>());
+            auto errorBody = std::make_shared<std::stringstream>();
+            resourceMan->httpResp->setBody(errorBody);
+            resourceMan->sink = std::make_shared<StreamBodySink>(errorBody);
         }
         resourceMan->firstRecv = false;
     }
-    std::shared_ptr<std::iostream>& content = resourceMan->httpResp->Body();
-    if (content == nullptr || content->fail()) {
+    if (resourceMan->sink == nullptr ||
+        !resourceMan->sink->writeAt(resourceMan->recvOffset, ptr, static_cast<int64_t>(wanted))) {
         resourceMan->dataTransferType = 4;
-        processHandler(resourceMan->progress, resourceMan->send, resourceMan->total, 0, resourceMan->dataTransferType,
-                       resourceMan->userData);
-        return -2;
-    }
-    content->write(ptr, static_cast<std::streamsize>(wanted));
-//    if (resourceMan->callBack != nullptr) {
-//        resourceMan->callBack->Consume(wanted);
-//    }
-
-    if (content->bad()) {
-        resourceMan->dataTransferType = 4;
-        processHandler(resourceMan->progress, resourceMan->send, resourceMan->total, 0, resourceMan->dataTransferType,
-                       resourceMan->userData);
-        return -3;
+        if (resourceMan->progress) {
+            processHandler(resourceMan->progress, resourceMan->send, resourceMan->total, 0,
+                           resourceMan->dataTransferType, resourceMan->userData);
+        }
+        return resourceMan->sink == nullptr ? -2 : -3;
     }
+    resourceMan->recvOffset += static_cast<int64_t>(wanted);
 
     resourceMan->send += wanted;
     if (resourceMan->progress) {
@@ -172,6 +201,10 @@ static size_t recvBody(char* ptr, size_t size, size_t nmemb, void* userdata) {
 static size_t recvHeaders(char* buffer, size_t size, size_t nitems, void* userdata) {
     auto* resourceMan = static_cast<ResourceManager*>(userdata);
     const size_t length = nitems * size;
+    if (!resourceMan->headerReceived) {
+        resourceMan->headerReceived = true;
+        resourceMan->lastProgress = std::chrono::steady_clock::now();
+    }
 
     std::string line(buffer);
     auto pos = line.find(':');
@@ -194,6 +227,142 @@ static size_t recvHeaders(char* buffer, size_t size, size_t nitems, void* userda
     return length;
 }
 
+// libcurl 至少每秒回调一次，按所处阶段检查连续没有收发数据的时间，超时返回非 0 中止请求
+static int transferProgress(void* clientp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal,
+                            curl_off_t ulnow) {
+    auto* resourceMan = static_cast<ResourceManager*>(clientp);
+    if (resourceMan->monitor != nullptr) {
+        resourceMan->monitor->update(static_cast<int64_t>(dlnow + ulnow));
+        if (resourceMan->monitor->aborted()) {
+            return 1;
+        }
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (dlnow != resourceMan->lastDownloaded || ulnow != resourceMan->lastUploaded) {
+        resourceMan->lastDownloaded = dlnow;
+        resourceMan->lastUploaded = ulnow;
+        resourceMan->lastProgress = now;
+        return 0;
+    }
+    auto idle = std::chrono::duration_cast<std::chrono::milliseconds>(now - resourceMan->lastProgress).count();
+    int64_t timeout = 0;
+    const char* reason = nullptr;
+    if (resourceMan->headerReceived) {
+        timeout = resourceMan->readTimeout;
+        reason = "read timeout";
+    } else if (resourceMan->total > 0 && resourceMan->send < resourceMan->total) {
+        timeout = resourceMan->writeTimeout;
+        reason = "write timeout";
+    } else {
+        timeout = resourceMan->responseHeaderTimeout;
+        reason = "response header timeout";
+    }
+    if (timeout > 0 && idle >= timeout) {
+        resourceMan->timeoutReason = reason;
+        return 1;
+    }
+    return 0;
+}
+
+static int configureSocket(void* clientp, curl_socket_t fd, curlsocktype purpose) {
+    if (purpose != CURLSOCKTYPE_IPCXN) {
+        return CURL_SOCKOPT_OK;
+    }
+    auto* options = static_cast<SocketOptions*>(clientp);
+    // 设置失败时沿用系统默认值，不影响请求
+    if (options->sendBufferSize > 0) {
+        setsockopt(fd, SOL_SOCKET, SO_SNDBUF, reinterpret_cast<const char*>(&options->sendBufferSize),
+                   sizeof(options->sendBufferSize));
+    }
+    if (options->receiveBufferSize > 0) {
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char*>(&options->receiveBufferSize),
+                   sizeof(options->receiveBufferSize));
+    }
+#ifdef TCP_KEEPCNT
+    if (options->keepAliveCount > 0) {
+        setsockopt(fd, IPPROTO_TCP, TCP_KEEPCNT, reinterpret_cast<const char*>(&options->keepAliveCount),
+                   sizeof(options->keepAliveCount));
+    }
+#endif
+    return CURL_SOCKOPT_OK;
+}
+
+// curl 记录的各阶段耗时均从请求开始累计，单位微秒
+struct CurlTimings {
+    int64_t nameLookUp;
+    int64_t connect;
+    int64_t tlsConnect;
+    int64_t preTransfer;
+    int64_t startTransfer;
+    int64_t total;
+    int64_t uploaded;
+    int64_t downloaded;
+};
+
+static CurlTimings getCurlTimings(CURL* curl) {
+    CurlTimings timings{};
+#ifdef CURL_VERSION_7610
+    curl_off_t value = 0;
+    curl_easy_getinfo(curl, CURLINFO_NAMELOOKUP_TIME_T, &value);
+    timings.nameLookUp = value;
+    curl_easy_getinfo(curl, CURLINFO_CONNECT_TIME_T, &value);
+    timings.connect = value;
+    curl_easy_getinfo(curl, CURLINFO_APPCONNECT_TIME_T, &value);
+    timings.tlsConnect = value;
+    curl_easy_getinfo(curl, CURLINFO_PRETRANSFER_TIME_T, &value);
+    timings.preTransfer = value;
+    curl_easy_getinfo(curl, CURLINFO_STARTTRANSFER_TIME_T, &value);
+    timings.startTransfer = value;
+    curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME_T, &value);
+    timings.total = value;
+    curl_easy_getinfo(curl, CURLINFO_SIZE_UPLOAD_T, &value);
+    timings.uploaded = value;
+    curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD_T, &value);
+    timings.downloaded = value;
+#else
+    double value = 0;
+    curl_easy_getinfo(curl, CURLINFO_NAMELOOKUP_TIME, &value);
+    timings.nameLookUp = (int64_t)(value * 1000000);
+    curl_easy_getinfo(curl, CURLINFO_CONNECT_TIME, &value);
+    timings.connect = (int64_t)(value * 1000000);
+    curl_easy_getinfo(curl, CURLINFO_APPCONNECT_TIME, &value);
+    timings.tlsConnect = (int64_t)(value * 1000000);
+    curl_easy_getinfo(curl, CURLINFO_PRETRANSFER_TIME, &value);
+    timings.preTransfer = (int64_t)(value * 1000000);
+    curl_easy_getinfo(curl, CURLINFO_STARTTRANSFER_TIME, &value);
+    timings.startTransfer = (int64_t)(value * 1000000);
+    curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME, &value);
+    timings.total = (int64_t)(value * 1000000);
+    curl_easy_getinfo(curl, CURLINFO_SIZE_UPLOAD, &value);
+    timings.uploaded = (int64_t)value;
+    curl_easy_getinfo(curl, CURLINFO_SIZE_DOWNLOAD, &value);
+    timings.downloaded = (int64_t)value;
+#endif
+    return timings;
+}
+
+static void recordCurlMetrics(CURL* curl, const std::shared_ptr<OperationMetrics>& op) {
+    auto timings = getCurlTimings(curl);
+    // 复用连接时 DNS/连接/握手阶段为 0，不计入
+    if (timings.nameLookUp > 0) {
+        op->recordLatency(MetricsPhaseDNS, timings.nameLookUp);
+    }
+    if (timings.connect > timings.nameLookUp) {
+        op->recordLatency(MetricsPhaseConnect, timings.connect - timings.nameLookUp);
+    }
+    if (timings.tlsConnect > timings.connect) {
+        op->recordLatency(MetricsPhaseTLS, timings.tlsConnect - timings.connect);
+    }
+    if (timings.startTransfer > timings.preTransfer) {
+        op->recordLatency(MetricsPhaseFirstByte, timings.startTransfer - timings.preTransfer);
+    }
+    if (timings.total > timings.startTransfer && timings.startTransfer > 0) {
+        op->recordLatency(MetricsPhaseTransfer, timings.total - timings.startTransfer);
+    }
+    op->recordLatency(MetricsPhaseHttp, timings.total);
+    op->recordBytes(timings.uploaded, timings.downloaded);
+}
+
 }  // namespace VolcengineTos
 
 using namespace VolcengineTos;
@@ -206,17 +375,38 @@ void HttpClient::cleanupGlobalState() {
 }
 
 HttpClient::HttpClient(const HttpConfig& config) {
-    curlContainer_ = new CurlContainer(config.maxConnections,config.socketTimeout,config.connectTimeout);
+    // libcurl 的建连超时包含 TCP 建连与 TLS 握手，取 connectTimeout 与 dialTimeout + tlsHandshakeTimeout 中的较小者
+    long connectTimeout = config.connectTimeout;
+    if (config.dialTimeout > 0 && config.tlsHandshakeTimeout > 0) {
+        long dialTimeout = (static_cast<long>(config.dialTimeout) + config.tlsHandshakeTimeout) * 1000;
+        connectTimeout = connectTimeout > 0 ? std::min(connectTimeout, dialTimeout) : dialTimeout;
+    }
+    curlContainer_ = new CurlContainer(config.maxConnections, config.socketTimeout, connectTimeout,
+                                       config.maxIdleCount > 0 ? config.maxIdleCount : 0);
     tcpKeepAlive_ = config.tcpKeepAlive;
+    tcpKeepAliveInterval_ = config.tcpKeepAliveInterval;
     dialTimeout_ = config.dialTimeout;
     requestTimeout_ = config.requestTimeout;
-    connectTimeout_ = config.connectTimeout;
+    connectTimeout_ = static_cast<int>(connectTimeout);
+    responseHeaderTimeout_ = config.responseHeaderTimeout;
+    readTimeout_ = config.readTimeout;
+    writeTimeout_ = config.writeTimeout;
+    idleConnectionTimeout_ = config.idleConnectionTimeout;
+    receiveBufferSize_ = config.receiveBufferSize;
+    uploadBufferSize_ = config.uploadBufferSize;
+    socketOptions_.sendBufferSize = config.socketSendBufferSize;
+    socketOptions_.receiveBufferSize = config.socketReceiveBufferSize;
+    socketOptions_.keepAliveCount = config.tcpKeepAlive > 0 ? config.tcpKeepAliveCount : 0;
     enableVerifySSL_ = config.enableVerifySSL;
     proxyHost_ = config.proxyHost;
     proxyPort_ = config.proxyPort;
     proxyUsername_ = config.proxyUsername;
     proxyPassword_ = config.proxyPassword;
     dnsCacheTime_ = config.dnsCacheTime;
+    // 经过代理时由代理解析域名
+    if (config.enableDnsLoadBalance && (proxyPort_ == -1 || proxyHost_.empty())) {
+        resolver_ = std::make_shared<HostResolver>(dnsCacheTime_ * 60);
+    }
 }
 void HttpClient::setShareHandle(CURL* curl_handle, int cacheTime) {
     std::lock_guard<std::mutex> lock(mu_);
@@ -242,9 +432,58 @@ void HttpClient::removeDNS(void* curl, const std::shared_ptr<HttpRequest>& reque
     curl_easy_setopt(curl, CURLOPT_RESOLVE, dns_list);
 }
 
+void HttpClient::setTransferOptions(void* curl) {
+    if (tcpKeepAlive_ > 0) {
+        curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+        curl_easy_setopt(curl, CURLOPT_TCP_KEEPIDLE, static_cast<long>(tcpKeepAlive_));
+        if (tcpKeepAliveInterval_ > 0) {
+            curl_easy_setopt(curl, CURLOPT_TCP_KEEPINTVL, static_cast<long>(tcpKeepAliveInterval_));
+        }
+    }
+    if (receiveBufferSize_ > 0) {
+        curl_easy_setopt(curl, CURLOPT_BUFFERSIZE, static_cast<long>(receiveBufferSize_));
+    }
+#if LIBCURL_VERSION_NUM >= 0x073e00
+    if (uploadBufferSize_ > 0) {
+        curl_easy_setopt(curl, CURLOPT_UPLOAD_BUFFERSIZE, static_cast<long>(uploadBufferSize_));
+    }
+#endif
+#if LIBCURL_VERSION_NUM >= 0x074100
+    if (idleConnectionTimeout_ > 0) {
+        curl_easy_setopt(curl, CURLOPT_MAXAGE_CONN, static_cast<long>(idleConnectionTimeout_));
+    }
+#endif
+    if (socketOptions_.sendBufferSize > 0 || socketOptions_.receiveBufferSize > 0 ||
+        socketOptions_.keepAliveCount > 0) {
+        curl_easy_setopt(curl, CURLOPT_SOCKOPTFUNCTION, configureSocket);
+        curl_easy_setopt(curl, CURLOPT_SOCKOPTDATA, &socketOptions_);
+    }
+}
+
 std::shared_ptr<HttpResponse> HttpClient::doRequest(const std::shared_ptr<HttpRequest>& request) {
+    // 请求体统一通过 BodySource 读取，只设置了 iostream 的请求在这里包装一次
+    if (request->getBodySource() == nullptr && request->Body() != nullptr) {
+        request->setBodySource(std::make_shared<StreamBodySource>(request->Body()));
+    }
+    // roundTrip 已查找好 OperationMetrics，直接调用 transport 时在这里查找一次
+    std::shared_ptr<OperationMetrics> op;
+    if (MetricsRegistry::Enabled()) {
+        op = request->getOperationMetrics();
+        if (op == nullptr) {
+            op = MetricsRegistry::instance()->operation(request->getFuncName());
+        }
+    }
+    std::chrono::steady_clock::time_point acquireStart;
+    if (op != nullptr) {
+        acquireStart = std::chrono::steady_clock::now();
+    }
     // init curl for this request
     CURL * curl = curlContainer_->Acquire();
+    if (op != nullptr) {
+        auto waitTime = MetricsUtils::ElapsedMicros(acquireStart);
+        MetricsRegistry::instance()->recordPoolWait(waitTime);
+        op->recordLatency(MetricsPhasePoolWait, waitTime);
+    }
     if (requestTimeout_ != 0) {
         curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, 1L);
         curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, requestTimeout_);
@@ -267,6 +506,7 @@ std::shared_ptr<HttpResponse> HttpClient::doRequest(const std::shared_ptr<HttpRe
         curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
         curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
     }
+    setTransferOptions(curl);
     // set req specific params
     auto response = std::make_shared<HttpResponse>();
     auto processHandler = request->getDataTransferListener().dataTransferStatusChange_;
@@ -282,8 +522,24 @@ std::shared_ptr<HttpResponse> HttpClient::doRequest(const std::shared_ptr<HttpRe
                                    checkCrc64, initCRC64, initCRC64,      rateLimiter};
 
     resourceMan.total = request->getContentLength();
+    resourceMan.responseHeaderTimeout = static_cast<int64_t>(responseHeaderTimeout_) * 1000;
+    resourceMan.readTimeout = static_cast<int64_t>(readTimeout_) * 1000;
+    resourceMan.writeTimeout = static_cast<int64_t>(writeTimeout_) * 1000;
+    resourceMan.lastProgress = std::chrono::steady_clock::now();
+    resourceMan.monitor = request->getTransferMonitor().get();
+    if (resourceMan.monitor != nullptr) {
+        resourceMan.monitor->start();
+    }
+    if (responseHeaderTimeout_ > 0 || readTimeout_ > 0 || writeTimeout_ > 0 || resourceMan.monitor != nullptr) {
+        curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+        curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, transferProgress);
+        curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &resourceMan);
+    }
 
     curl_easy_setopt(curl, CURLOPT_URL, request->url().toString().c_str());
+    if (request->isFreshConnection()) {
+        curl_easy_setopt(curl, CURLOPT_FRESH_CONNECT, 1L);
+    }
 
     // set opt for different http methods
     if (request->method() == http::MethodHead) {
@@ -333,7 +589,60 @@ std::shared_ptr<HttpResponse> HttpClient::doRequest(const std::shared_ptr<HttpRe
     if (dnsCacheTime_ > 0) {
         setShareHandle(curl, dnsCacheTime_);
     }
+    // 由 resolver 选择本次连接的地址，Host 头、SNI 与证书校验仍使用原域名
+    std::string address, host;
+    int port = 0;
+    curl_slist* connectTo = nullptr;
+    if (resolver_ != nullptr && !HostResolver::isAddressLiteral(request->url().host())) {
+        host = request->url().host();
+        port = request->url().port().empty() ? (request->url().scheme() == "http" ? 80 : 443)
+                                              : std::stoi(request->url().port());
+        std::string preferred;
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            auto it = handleAddress_.find(curl);
+            if (it != handleAddress_.end()) {
+                preferred = it->second;
+            }
+        }
+        address = resolver_->acquire(host, port, preferred);
+        if (!address.empty()) {
+            std::string target = address.find(':') == std::string::npos ? address : "[" + address + "]";
+            auto rule = host + ":" + std::to_string(port) + ":" + target + ":" + std::to_string(port);
+            connectTo = curl_slist_append(connectTo, rule.c_str());
+        }
+    }
+    curl_easy_setopt(curl, CURLOPT_CONNECT_TO, connectTo);
     CURLcode res = curl_easy_perform(curl);
+    if (res == CURLE_ABORTED_BY_CALLBACK && resourceMan.timeoutReason != nullptr) {
+        // 与 libcurl 自身的超时一样处理，可以重试
+        res = CURLE_OPERATION_TIMEDOUT;
+    }
+    // 建连或握手失败，包括建连完成前超时，此时请求没有到达服务端
+    bool connectFailed = res == CURLE_COULDNT_CONNECT || res == CURLE_SSL_CONNECT_ERROR;
+    if (res == CURLE_OPERATION_TIMEDOUT && getCurlTimings(curl).connect == 0) {
+        connectFailed = true;
+    }
+    response->setConnectFailed(connectFailed);
+    if (!address.empty()) {
+        // 建连或握手失败的地址暂时剔除
+        auto timings = getCurlTimings(curl);
+        long numConnects = 0;
+        curl_easy_getinfo(curl, CURLINFO_NUM_CONNECTS, &numConnects);
+        uint64_t connectMicros = 0;
+        if (!connectFailed && numConnects > 0 && timings.connect > 0) {
+            connectMicros = std::max(timings.connect, timings.tlsConnect) - timings.nameLookUp;
+        }
+        resolver_->release(host, port, address, connectFailed, connectMicros);
+        std::lock_guard<std::mutex> lock(mu_);
+        if (connectFailed) {
+            handleAddress_.erase(curl);
+        } else {
+            handleAddress_[curl] = address;
+        }
+    }
+    curl_easy_setopt(curl, CURLOPT_CONNECT_TO, nullptr);
+    curl_slist_free_all(connectTo);
     if (res == CURLE_COULDNT_CONNECT) {
         response->setStatus(http::Refused);
         std::stringstream ss;
@@ -344,53 +653,47 @@ std::shared_ptr<HttpResponse> HttpClient::doRequest(const std::shared_ptr<HttpRe
         response->setStatus(http::otherErr);
         std::stringstream ss;
         ss << "curlCode: " << res << ", " << curl_easy_strerror(res);
+        if (resourceMan.timeoutReason != nullptr) {
+            ss << " (" << resourceMan.timeoutReason << ")";
+        } else if (res == CURLE_ABORTED_BY_CALLBACK && resourceMan.monitor != nullptr &&
+                   resourceMan.monitor->aborted()) {
+            ss << " (aborted by transfer monitor)";
+        }
         response->setStatusMsg(ss.str());
         response->setCurlErrCode(res);
     } else {
         response->setStatus(http::Success);
 
-#ifdef CURL_VERSION_7610
-        auto logger = LogUtils::GetLogger();
-        if (logger != nullptr) {
-            long nameLookUp = 0;
-            long connectTime = 0;
-            long tlsConnect = 0;
-            long startTrans = 0;
-            long totalTime = 0;
-            curl_easy_getinfo(curl, CURLINFO_NAMELOOKUP_TIME_T, &nameLookUp);
-            curl_easy_getinfo(curl, CURLINFO_CONNECT_TIME_T, &connectTime);
-            curl_easy_getinfo(curl, CURLINFO_APPCONNECT_TIME_T, &tlsConnect);
-            curl_easy_getinfo(curl, CURLINFO_PRETRANSFER_TIME_T, &startTrans);
-            curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME_T, &totalTime);
+        // 日志关闭或本条被采样丢弃时不再查询耗时
+        auto logger = LogUtils::GetLogger(LogCategoryTransport, LogDebug);
+        if (logger != nullptr && LogUtils::SampleRequestLog(LogCategoryTransport)) {
+            auto timings = getCurlTimings(curl);
             logger->debug(
                     "Method:{}, Host:{}, request uri:{}, DNS resolution time:{} ms, TCP establish connection time:{} ms, TLS handshake time:{} ms, start transfer time:{} ms, Data sending time:{} ms, Total HTTP request time:{} ms",
-                    request->method(), request->url().host(), request->url().path(), nameLookUp / 1000,
-                    connectTime / 1000, tlsConnect / 1000, startTrans / 1000, (totalTime - startTrans) / 1000,
-                    totalTime / 1000);
+                    request->method(), request->url().host(), request->url().path(), timings.nameLookUp / 1000,
+                    timings.connect / 1000, timings.tlsConnect / 1000, timings.preTransfer / 1000,
+                    (timings.total - timings.preTransfer) / 1000, timings.total / 1000);
         }
-#else
-        auto logger = LogUtils::GetLogger();
-        if (logger != nullptr) {
-            double nameLookUp = 0;
-            double connectTime = 0;
-            double tlsConnect = 0;
-            double startTrans = 0;
-            double totalTime = 0;
-            curl_easy_getinfo(curl, CURLINFO_NAMELOOKUP_TIME, &nameLookUp);
-            curl_easy_getinfo(curl, CURLINFO_CONNECT_TIME, &connectTime);
-            curl_easy_getinfo(curl, CURLINFO_APPCONNECT_TIME, &tlsConnect);
-            curl_easy_getinfo(curl, CURLINFO_PRETRANSFER_TIME, &startTrans);
-            curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME, &totalTime);
-            auto logger = LogUtils::GetLogger();
-            logger->debug(
-                    "Method:{}, Host:{}, request uri:{}, DNS resolution time:{} ms, TCP establish connection time:{} ms, TLS handshake time:{} ms, start transfer time:{} ms, Data sending time:{} ms, Total HTTP request time:{} ms",
-                    request->method(), request->url().host(), request->url().path(), (long)(nameLookUp * 1000),
-                    (long)(connectTime * 1000), (long)(tlsConnect * 1000), (long)(startTrans * 1000),
-                    (long)((totalTime - startTrans) * 1000), (long)(totalTime * 1000));
+    }
+    // 请求上设置的 BodySink 在响应成功时提交，提交失败视为请求失败；失败的请求可能重试，重试时回到 sink 的起始位置重新写入
+    auto& responseSink = request->getResponseSink();
+    if (responseSink != nullptr) {
+        long code = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &code);
+        if (res == CURLE_OK && code / 100 == 2) {
+            if (!responseSink->commit()) {
+                response->setStatus(http::otherErr);
+                response->setStatusMsg("commit response body failed");
+            }
+        } else {
+            responseSink->abort();
         }
-#endif
     }
-    if (res != CURLE_OK && dnsCacheTime_ > 0) {
+    if (op != nullptr) {
+        recordCurlMetrics(curl, op);
+    }
+    // 指定了地址时由 resolver 按地址剔除，不再清除整个 host 的缓存
+    if (res != CURLE_OK && dnsCacheTime_ > 0 && address.empty()) {
         removeDNS(curl, request);
     }
     long response_code = 0;
@@ -412,7 +715,11 @@ std::shared_ptr<HttpResponse> HttpClient::doRequest(const std::shared_ptr<HttpRe
     }
 
     request->setTransferedBytes(resourceMan.send);
-    curlContainer_->Release(curl, (res != CURLE_OK));
+    // 句柄被替换后地址已失效，新句柄可能复用同一指针
+    if (curlContainer_->Release(curl, (res != CURLE_OK)) && resolver_ != nullptr) {
+        std::lock_guard<std::mutex> lock(mu_);
+        handleAddress_.erase(curl);
+    }
     curl_slist_free_all(list);
     return response;
 }
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace VolcengineTos {
+// 按偏移读取文件，POSIX 下使用 pread，不共享文件偏移，多个线程可以各自持有
+#ifdef _WIN32
+class FileRangeReader {
+public:
+    explicit FileRangeReader(const std::string &filePath) : ifs_(filePath, std::ios::in | std::ios::binary) {
+    }
+    bool good() const {
+        return ifs_.good();
+    }
+    int64_t size() {
+        ifs_.clear();
+        ifs_.seekg(0, std::ios::end);
+        return static_cast<int64_t>(ifs_.tellg());
+    }
+    bool read(char *buf, int64_t offset, int64_t len) {
+        ifs_.clear();
+        ifs_.seekg(offset);
+        ifs_.read(buf, len);
+        return ifs_.gcount() == len;
+    }
+
+private:
+    std::ifstream ifs_;
+};
+#else
+class FileRangeReader {
+public:
+    explicit FileRangeReader(const std::string &filePath) : fd_(::open(filePath.c_str(), O_RDONLY)) {
+    }
+    ~FileRangeReader() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+    FileRangeReader(const FileRangeReader &) = delete;
+    FileRangeReader &operator=(const FileRangeReader &) = delete;
+    bool good() const {
+        return fd_ >= 0;
+    }
+    int64_t size() const {
+        struct stat st {};
+        return ::fstat(fd_, &st) == 0 ? static_cast<int64_t>(st.st_size) : -1;
+    }
+    bool read(char *buf, int64_t offset, int64_t len) const {
+        while (len > 0) {
+            auto n = ::pread(fd_, buf, static_cast<size_t>(len), static_cast<off_t>(offset));
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            buf += n;
+            offset += n;
+            len -= n;
+        }
+        return true;
+    }
+
+private:
+    int fd_;
+};
+#endif
+}  // namespace VolcengineTos
@@ -0,0 +1,154 @@
+#include "JsonWriter.h"
+#include "utils/BaseUtils.h"
+
+using namespace VolcengineTos;
+
+static const size_t Md5ChunkSize = 16 * 1024;
+
+JsonWriter::JsonWriter(size_t reserve, bool md5) : md5Enabled_(md5) {
+    buffer_.reserve(reserve);
+    if (md5Enabled_) {
+        MD5_Init(&md5Ctx_);
+    }
+}
+
+void JsonWriter::separate() {
+    if (afterKey_) {
+        afterKey_ = false;
+        return;
+    }
+    if (!hasElement_.empty()) {
+        if (hasElement_.back()) {
+            buffer_.push_back(',');
+        }
+        hasElement_.back() = true;
+    }
+}
+
+void JsonWriter::beginObject() {
+    separate();
+    buffer_.push_back('{');
+    hasElement_.push_back(false);
+}
+
+void JsonWriter::endObject() {
+    buffer_.push_back('}');
+    hasElement_.pop_back();
+    updateMd5(false);
+}
+
+void JsonWriter::beginArray() {
+    separate();
+    buffer_.push_back('[');
+    hasElement_.push_back(false);
+}
+
+void JsonWriter::endArray() {
+    buffer_.push_back(']');
+    hasElement_.pop_back();
+    updateMd5(false);
+}
+
+void JsonWriter::key(const char* key) {
+    separate();
+    buffer_.push_back('"');
+    buffer_.append(key);
+    buffer_.append("\":");
+    afterKey_ = true;
+}
+
+void JsonWriter::value(const std::string& value) {
+    static const char* hex = "0123456789abcdef";
+    separate();
+    buffer_.push_back('"');
+    for (auto c : value) {
+        auto ch = static_cast<unsigned char>(c);
+        switch (ch) {
+            case '"':
+                buffer_.append("\\\"");
+                break;
+            case '\\':
+                buffer_.append("\\\\");
+                break;
+            case '\b':
+                buffer_.append("\\b");
+                break;
+            case '\f':
+                buffer_.append("\\f");
+                break;
+            case '\n':
+                buffer_.append("\\n");
+                break;
+            case '\r':
+                buffer_.append("\\r");
+                break;
+            case '\t':
+                buffer_.append("\\t");
+                break;
+            default:
+                if (ch < 0x20) {
+                    buffer_.append("\\u00");
+                    buffer_.push_back(hex[ch >> 4]);
+                    buffer_.push_back(hex[ch & 0xf]);
+                } else {
+                    buffer_.push_back(c);
+                }
+        }
+    }
+    buffer_.push_back('"');
+}
+
+void JsonWriter::value(int64_t value) {
+    separate();
+    buffer_.append(std::to_string(value));
+}
+
+void JsonWriter::value(bool value) {
+    separate();
+    buffer_.append(value ? "true" : "false");
+}
+
+void JsonWriter::null() {
+    separate();
+    buffer_.append("null");
+}
+
+void JsonWriter::updateMd5(bool all) {
+    if (!md5Enabled_ || md5Finished_ || buffer_.size() <= md5Offset_) {
+        return;
+    }
+    auto pending = buffer_.size() - md5Offset_;
+    if (!all && pending < Md5ChunkSize) {
+        return;
+    }
+    MD5_Update(&md5Ctx_, buffer_.data() + md5Offset_, pending);
+    md5Offset_ = buffer_.size();
+}
+
+std::string JsonWriter::md5() {
+    if (!md5Enabled_ || md5Finished_) {
+        return CryptoUtils::md5Sum(buffer_);
+    }
+    updateMd5(true);
+    unsigned char md5Res[MD5_DIGEST_LENGTH];
+    MD5_Final(md5Res, &md5Ctx_);
+    md5Finished_ = true;
+    return CryptoUtils::base64Encode(md5Res, MD5_DIGEST_LENGTH);
+}
+
+std::shared_ptr<const std::string> JsonWriter::release() {
+    auto data = std::make_shared<const std::string>(std::move(buffer_));
+    buffer_ = std::string();
+    return data;
+}
+
+void JsonWriter::reset() {
+    buffer_.clear();
+    hasElement_.clear();
+    afterKey_ = false;
+    md5Offset_ = 0;
+    md5Finished_ = false;
+    if (md5Enabled_) {
+        MD5_Init(&md5Ctx_);
+    }
+}
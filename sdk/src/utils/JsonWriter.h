@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <openssl/md5.h>
+
+namespace VolcengineTos {
+// 直接写入缓冲区的 JSON 序列化，不构造 nlohmann::json 节点，用于分片列表、删除列表等较大的请求体。
+// 输出与 nlohmann::json::dump() 一致：无空白，字符串按 JSON 规则转义，非 ASCII 字符原样输出。
+// 开启 md5 时边写边计算 Content-MD5，release 后缓冲区交给 MemoryBodySource，不再拷贝
+class JsonWriter {
+public:
+    explicit JsonWriter(size_t reserve = 0, bool md5 = false);
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+    // 对象中的下一个字段名，key 不需要转义
+    void key(const char* key);
+    void value(const std::string& value);
+    void value(int64_t value);
+    void value(int value) {
+        this->value(static_cast<int64_t>(value));
+    }
+    void value(bool value);
+    void null();
+
+    const std::string& str() const {
+        return buffer_;
+    }
+    // base64 编码的 MD5，调用后不能再写入
+    std::string md5();
+    std::shared_ptr<const std::string> release();
+    // 清空内容并保留已分配的空间，用于连续序列化多个请求体
+    void reset();
+
+private:
+    // 数组或对象中第二个及之后的元素前写入逗号
+    void separate();
+    // 累积的未计算 MD5 的数据超过一定大小时计算，趁数据仍在缓存中
+    void updateMd5(bool all);
+
+    std::string buffer_;
+    // 每层数组或对象是否已有元素
+    std::vector<bool> hasElement_;
+    bool afterKey_ = false;
+    bool md5Enabled_;
+    bool md5Finished_ = false;
+    MD5_CTX md5Ctx_;
+    size_t md5Offset_ = 0;
+};
+
+class CompleteMultipartUploadV2Input;
+class DeleteMultiObjectsInput;
+namespace inner {
+class InnerCompleteMultipartUploadInput;
+}  // namespace inner
+
+// 把请求体直接写入 writer，与各自 toJsonString 的输出一致，定义在对应的 model 源文件中
+void writeJson(JsonWriter& writer, const CompleteMultipartUploadV2Input& input);
+void writeJson(JsonWriter& writer, const inner::InnerCompleteMultipartUploadInput& input);
+void writeJson(JsonWriter& writer, const DeleteMultiObjectsInput& input);
+}  // namespace VolcengineTos
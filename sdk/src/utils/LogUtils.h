@@ -1,8 +1,12 @@
 #pragma once
 
 #include "Type.h"
+#include <atomic>
+#include <chrono>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <vector>
 #include "spdlog/spdlog.h"
 #include "spdlog/async.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
@@ -12,12 +16,7 @@
 
 namespace VolcengineTos {
 
-static LogLevel tosSDKLogLevel = LogLevel::LogOff;
-static std::string loggerName = "tos";
-static std::string logFilePath = "";
-static int64_t logMaxFileSize = 5242880;
-static int logMaxFiles = 3;
-
+// 日志配置保存在单例内，避免头文件中的 static 变量在每个编译单元各有一份
 class LogUtils {
 public:
     static LogUtils* instance() {
@@ -25,78 +24,207 @@ public:
         return &instance;
     }
     static void SetLogger(const std::string& filePath, const std::string& name, LogLevel level) {
-        tosSDKLogLevel = level;
-        loggerName = name;
-        logFilePath = filePath;
-        InitInnerLog();
+        instance()->initLogger(filePath, name, level, defaultMaxFileSize, defaultMaxFiles, false, 0,
+                               LogOverflowBlock);
     }
     static void SetLogger(const std::string& filePath, const std::string& name, LogLevel level, int64_t maxFileSize,
                           int maxFiles) {
-        tosSDKLogLevel = level;
-        loggerName = name;
-        logFilePath = filePath;
-        logMaxFileSize = maxFileSize;
-        logMaxFiles = maxFiles;
-        InitInnerLog();
+        instance()->initLogger(filePath, name, level, maxFileSize, maxFiles, false, 0, LogOverflowBlock);
+    }
+    // 异步日志：请求线程只负责入队，由后台线程写文件；queueSize 为队列长度，policy 为队列满时的处理策略
+    static void SetAsyncLogger(const std::string& filePath, const std::string& name, LogLevel level,
+                               int64_t maxFileSize = defaultMaxFileSize, int maxFiles = defaultMaxFiles,
+                               size_t queueSize = defaultQueueSize, LogOverflowPolicy policy = LogOverflowDropOldest) {
+        instance()->initLogger(filePath, name, level, maxFileSize, maxFiles, true, queueSize, policy);
     }
     static std::shared_ptr<spdlog::logger> GetLogger() {
         return instance()->getLogger();
     }
+    // category 在 level 下不输出时返回 nullptr，调用方据此跳过计时与格式化
+    static std::shared_ptr<spdlog::logger> GetLogger(LogCategory category, LogLevel level) {
+        if (!ShouldLog(category, level)) {
+            return nullptr;
+        }
+        return instance()->getLogger();
+    }
+    static bool ShouldLog(LogCategory category, LogLevel level) {
+        auto ins = instance();
+        int current = ins->categoryLevels_[category].load(std::memory_order_relaxed);
+        if (current < 0) {
+            current = ins->level_.load(std::memory_order_relaxed);
+        }
+        return level != LogOff && level <= current;
+    }
     static void SetLoggerLevel(LogLevel loglevel) {
-        instance()->setLogLevel(loglevel);
+        instance()->level_.store(loglevel, std::memory_order_relaxed);
+        instance()->applyLevel();
+    }
+    // 单独设置某一类日志的级别，不设置时沿用 SetLoggerLevel 的级别
+    static void SetCategoryLevel(LogCategory category, LogLevel loglevel) {
+        instance()->categoryLevels_[category].store(loglevel, std::memory_order_relaxed);
+        instance()->applyLevel();
+    }
+    // 清除某一类日志单独设置的级别，之后重新沿用 SetLoggerLevel 的级别
+    static void ClearCategoryLevel(LogCategory category) {
+        instance()->categoryLevels_[category].store(-1, std::memory_order_relaxed);
+        instance()->applyLevel();
+    }
+    // 逐请求日志采样：每 sampleEvery 条输出 1 条，且每秒最多输出 maxPerSecond 条，<= 0 表示不限制
+    static void SetRequestLogSampling(int sampleEvery, int maxPerSecond) {
+        instance()->sampleEvery_.store(sampleEvery, std::memory_order_relaxed);
+        instance()->maxPerSecond_.store(maxPerSecond, std::memory_order_relaxed);
+    }
+    // 判断本条逐请求日志是否需要输出，每类日志分别计数，同一请求的不同类日志互不影响采样
+    static bool SampleRequestLog(LogCategory category) {
+        auto ins = instance();
+        auto& sampler = ins->samplers_[category];
+        int every = ins->sampleEvery_.load(std::memory_order_relaxed);
+        if (every > 1 && sampler.seq.fetch_add(1, std::memory_order_relaxed) % every != 0) {
+            return false;
+        }
+        int maxPerSecond = ins->maxPerSecond_.load(std::memory_order_relaxed);
+        if (maxPerSecond > 0) {
+            int64_t now = std::chrono::duration_cast<std::chrono::seconds>(
+                                  std::chrono::steady_clock::now().time_since_epoch())
+                                  .count();
+            int64_t window = sampler.window.load(std::memory_order_relaxed);
+            if (now != window && sampler.window.compare_exchange_strong(window, now)) {
+                sampler.windowCount.store(0, std::memory_order_relaxed);
+            }
+            if (sampler.windowCount.fetch_add(1, std::memory_order_relaxed) >= maxPerSecond) {
+                return false;
+            }
+        }
+        return true;
     }
 
     static void InitInnerLog() {
-        instance();
-        SetLoggerLevel(tosSDKLogLevel);
+        instance()->applyLevel();
     }
     static void CloseLogger() {
-        tosSDKLogLevel = LogLevel::LogOff;
-        spdlog::drop(loggerName);  // 释放logger
+        instance()->closeLogger();
     }
 
 private:
+    static const int64_t defaultMaxFileSize = 5242880;
+    static const int defaultMaxFiles = 3;
+    static const size_t defaultQueueSize = 8192;
+
     std::shared_ptr<spdlog::logger> getLogger() const {
-        return logger_;
+        return std::atomic_load(&logger_);
     }
-    void setLogLevel(LogLevel level) {
+    static spdlog::level::level_enum toSpdLevel(int level) {
         // debug< info< warn< error< critical  日志信息低于设置的级别时,不予显示
         if (level == LogDebug) {
-            logger_->set_level(spdlog::level::debug);
+            return spdlog::level::debug;
         }
         if (level == LogInfo) {
-            logger_->set_level(spdlog::level::info);
+            return spdlog::level::info;
+        }
+        return spdlog::level::off;
+    }
+    // logger 本身取各分类中最详细的级别，分类过滤由 ShouldLog 完成
+    void applyLevel() {
+        auto logger = getLogger();
+        if (logger == nullptr) {
+            return;
         }
-        if (level == LogOff) {
-            logger_->set_level(spdlog::level::off);
+        int level = level_.load(std::memory_order_relaxed);
+        for (int i = 0; i < LogCategoryNum; i++) {
+            int categoryLevel = categoryLevels_[i].load(std::memory_order_relaxed);
+            if (categoryLevel > level) {
+                level = categoryLevel;
+            }
         }
+        logger->set_level(toSpdLevel(level));
     }
 
 public:
     LogUtils() {
-        if (!logFilePath.empty()) {
-            init_logger();
-            setLogLevel(tosSDKLogLevel);
+        for (int i = 0; i < LogCategoryNum; i++) {
+            categoryLevels_[i].store(-1, std::memory_order_relaxed);
         }
     }
 
     ~LogUtils() = default;
 
 private:
-    void init_logger() {
-        // 创建 logFilePath 的父目录文件夹
-        bool ret = FileUtils::CreateDir(logFilePath, true);
+    void initLogger(const std::string& filePath, const std::string& name, LogLevel level, int64_t maxFileSize,
+                    int maxFiles, bool async, size_t queueSize, LogOverflowPolicy policy) {
+        std::lock_guard<std::mutex> lock(mu_);
+        level_.store(level, std::memory_order_relaxed);
+        if (filePath.empty()) {
+            return;
+        }
+        // 创建 filePath 的父目录文件夹
+        bool ret = FileUtils::CreateDir(filePath, true);
         if (!ret) {
             // 错误处理，创建文件夹失败的场景
             std::cout << "invalid file path, mkdir failed" << std::endl;
             return;
         }
+        if (std::atomic_load(&logger_) != nullptr) {
+            spdlog::drop(loggerName_);
+        }
+        loggerName_ = name;
+        spdlog::drop(loggerName_);
 
-        // _mt 为线程安全的日志
-        logger_ = spdlog::rotating_logger_mt(loggerName, logFilePath, logMaxFileSize, logMaxFiles);
+        std::shared_ptr<spdlog::logger> logger;
+        if (async) {
+            auto sink = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(filePath, maxFileSize, maxFiles);
+            // 后台单线程写文件，async_logger 只持有线程池的 weak_ptr，线程池需比 logger 活得更久。
+            // 调用方可能仍持有旧的 logger，重新设置时队列长度不变则复用线程池，否则旧线程池保留到进程退出
+            size_t size = defaultQueueSize;
+            if (queueSize > 0) {
+                size = queueSize;
+            }
+            if (threadPool_ == nullptr || threadPoolQueueSize_ != size) {
+                if (threadPool_ != nullptr) {
+                    retiredThreadPools_.push_back(threadPool_);
+                }
+                threadPool_ = std::make_shared<spdlog::details::thread_pool>(size, 1);
+                threadPoolQueueSize_ = size;
+            }
+            auto overflow = policy == LogOverflowBlock ? spdlog::async_overflow_policy::block
+                                                       : spdlog::async_overflow_policy::overrun_oldest;
+            logger = std::make_shared<spdlog::async_logger>(loggerName_, sink, threadPool_, overflow);
+            spdlog::register_logger(logger);
+        } else {
+            // _mt 为线程安全的日志
+            logger = spdlog::rotating_logger_mt(loggerName_, filePath, maxFileSize, maxFiles);
+        }
+        std::atomic_store(&logger_, logger);
+        applyLevel();
+    }
+    void closeLogger() {
+        std::lock_guard<std::mutex> lock(mu_);
+        level_.store(LogOff, std::memory_order_relaxed);
+        auto logger = std::atomic_load(&logger_);
+        if (logger != nullptr) {
+            logger->flush();
+            logger->set_level(spdlog::level::off);
+        }
+        std::atomic_store(&logger_, std::shared_ptr<spdlog::logger>());
+        spdlog::drop(loggerName_);  // 释放logger
     }
 
 private:
+    std::mutex mu_;
+    std::string loggerName_ = "tos";
     std::shared_ptr<spdlog::logger> logger_ = nullptr;
+    std::shared_ptr<spdlog::details::thread_pool> threadPool_ = nullptr;
+    size_t threadPoolQueueSize_ = 0;
+    std::vector<std::shared_ptr<spdlog::details::thread_pool>> retiredThreadPools_;
+    std::atomic<int> level_{LogOff};
+    std::atomic<int> categoryLevels_[LogCategoryNum];
+    std::atomic<int> sampleEvery_{1};
+    std::atomic<int> maxPerSecond_{0};
+    // 每类日志的采样计数与限速窗口
+    struct Sampler {
+        std::atomic<uint64_t> seq{0};
+        std::atomic<int64_t> window{0};
+        std::atomic<int> windowCount{0};
+    };
+    Sampler samplers_[LogCategoryNum];
 };
 }  // namespace VolcengineTos
@@ -1,6 +1,7 @@
 #pragma once
 
-#include <map>
+#include <algorithm>
+#include <cstring>
 #include <string>
 #include "utils/BaseUtils.h"
 
@@ -8,7 +9,13 @@ namespace VolcengineTos {
 const static char* DEFAULT_MIMETYPE = "application/octet-stream";
 // const static char* DEFAULT_MIMETYPE = "binary/octet-stream";
 
-const static std::map<std::string, std::string> mimeTypeMap{
+struct MimeTypeEntry {
+    const char* ext;
+    const char* mimeType;
+};
+
+// 按扩展名字节序排列，使用二分查找
+static constexpr MimeTypeEntry mimeTypeTable[] = {
         {"3gp", "video/3gpp"},
         {"7z", "application/x-7z-compressed"},
         {"abw", "application/x-abiword"},
@@ -547,14 +554,20 @@ const static std::map<std::string, std::string> mimeTypeMap{
         {"xyz", "chemical/x-xyz"},
         {"xz", "application/x-xz"},
         {"zip", "application/zip"}};
+static constexpr size_t mimeTypeTableSize = sizeof(mimeTypeTable) / sizeof(mimeTypeTable[0]);
+
 class MimeType {
 public:
     static std::string getMimetypeByObjectKey(const std::string& objectKey) {
         int lastPeriodIndex = objectKey.find_last_of('.');
         if (lastPeriodIndex != objectKey.npos && lastPeriodIndex + 1 < objectKey.size()) {
             auto ext = VolcengineTos::StringUtils::toLower(objectKey.substr(lastPeriodIndex + 1));
-            if (mimeTypeMap.count(ext)) {
-                return mimeTypeMap.at(ext);
+            auto end = mimeTypeTable + mimeTypeTableSize;
+            auto it = std::lower_bound(mimeTypeTable, end, ext, [](const MimeTypeEntry& e, const std::string& k) {
+                return std::strcmp(e.ext, k.c_str()) < 0;
+            });
+            if (it != end && ext == it->ext) {
+                return it->mimeType;
             }
         }
         return DEFAULT_MIMETYPE;
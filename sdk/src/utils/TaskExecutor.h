@@ -0,0 +1,69 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace VolcengineTos {
+// 固定数量的后台线程按提交顺序执行任务，线程在第一次提交时创建。
+// 析构时执行完队列中的任务后退出，任务中不能释放持有 executor 的对象
+class TaskExecutor {
+public:
+    explicit TaskExecutor(int threads) : threads_(std::max(threads, 1)) {
+    }
+    ~TaskExecutor() {
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            stopped_ = true;
+        }
+        cv_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+    TaskExecutor(const TaskExecutor&) = delete;
+    TaskExecutor& operator=(const TaskExecutor&) = delete;
+
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            tasks_.push_back(std::move(task));
+            if (workers_.size() < static_cast<size_t>(threads_) && tasks_.size() > static_cast<size_t>(idle_)) {
+                workers_.emplace_back(&TaskExecutor::run, this);
+            }
+        }
+        cv_.notify_one();
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(mu_);
+        while (true) {
+            idle_++;
+            cv_.wait(lock, [this]() { return stopped_ || !tasks_.empty(); });
+            idle_--;
+            if (tasks_.empty()) {
+                return;
+            }
+            auto task = std::move(tasks_.front());
+            tasks_.pop_front();
+            lock.unlock();
+            task();
+            lock.lock();
+        }
+    }
+
+    int threads_;
+    std::mutex mu_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> tasks_;
+    std::vector<std::thread> workers_;
+    // 等待任务的线程数，排队的任务多于空闲线程时才创建新线程
+    int idle_ = 0;
+    bool stopped_ = false;
+};
+}  // namespace VolcengineTos
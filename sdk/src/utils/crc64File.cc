@@ -0,0 +1,195 @@
+#include "utils/crc64.h"
+#include "FileRangeReader.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace VolcengineTos {
+namespace {
+const int64_t crcChunkSize = 8 * 1024 * 1024;
+
+bool fileSize(const std::string &filePath, int64_t &size) {
+    std::ifstream ifs(filePath, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!ifs.good()) {
+        return false;
+    }
+    size = static_cast<int64_t>(ifs.tellg());
+    return size >= 0;
+}
+
+struct CrcChunk {
+    int64_t offset;
+    int64_t length;
+    uint64_t crc;
+};
+
+// 多个线程并发计算各块的 CRC64
+bool calcChunksCRC(const std::string &filePath, std::vector<CrcChunk> &chunks, int threads) {
+    std::atomic<size_t> next(0);
+    std::atomic<bool> failed(false);
+    auto worker = [&]() {
+        // 每个线程使用独立的文件句柄
+        FileRangeReader reader(filePath);
+        if (!reader.good()) {
+            failed = true;
+            return;
+        }
+        std::vector<char> buffer;
+        size_t index;
+        while (!failed && (index = next++) < chunks.size()) {
+            auto &chunk = chunks[index];
+            buffer.resize(static_cast<size_t>(chunk.length));
+            if (chunk.length > 0 && !reader.read(buffer.data(), chunk.offset, chunk.length)) {
+                failed = true;
+                return;
+            }
+            chunk.crc = CRC64::CalcCRC(0, buffer.data(), static_cast<size_t>(chunk.length));
+        }
+    };
+    auto count = std::max<size_t>(std::min<size_t>(std::max(threads, 1), chunks.size()), 1);
+    if (count == 1) {
+        worker();
+        return !failed;
+    }
+    std::vector<std::thread> threadPool;
+    for (size_t i = 0; i < count; i++) {
+        threadPool.emplace_back(worker);
+    }
+    for (auto &t : threadPool) {
+        t.join();
+    }
+    return !failed;
+}
+}  // namespace
+
+bool CRC64::CalcFileCRC(const std::string &filePath, int threads, uint64_t &crc) {
+    std::vector<uint64_t> partCRCs;
+    if (!CalcFilePartCRC(filePath, crcChunkSize, threads, partCRCs)) {
+        return false;
+    }
+    int64_t size = 0;
+    if (!fileSize(filePath, size)) {
+        return false;
+    }
+    crc = partCRCs.front();
+    for (size_t i = 1; i < partCRCs.size(); i++) {
+        crc = CombineCRC(crc, partCRCs[i], std::min(crcChunkSize, size - static_cast<int64_t>(i) * crcChunkSize));
+    }
+    return true;
+}
+
+bool CRC64::CalcFilePartCRC(const std::string &filePath, int64_t partSize, int threads,
+                            std::vector<uint64_t> &partCRCs) {
+    return CalcFilePartCRC(filePath, partSize, threads, std::vector<bool>(), partCRCs);
+}
+
+bool CRC64::CalcFilePartCRC(const std::string &filePath, int64_t partSize, int threads,
+                            const std::vector<bool> &selected, std::vector<uint64_t> &partCRCs) {
+    int64_t size = 0;
+    if (partSize <= 0 || !fileSize(filePath, size)) {
+        return false;
+    }
+    // 空文件作为一个长度为 0 的分片
+    auto parts = std::max<int64_t>((size + partSize - 1) / partSize, 1);
+    // 分片较大时继续切分为 8MB 的块，使单个分片也能并发计算
+    std::vector<CrcChunk> chunks;
+    std::vector<size_t> firstChunk;
+    for (int64_t part = 0; part < parts; part++) {
+        firstChunk.push_back(chunks.size());
+        if (!selected.empty() && (static_cast<size_t>(part) >= selected.size() || !selected[part])) {
+            continue;
+        }
+        auto end = std::min(size, (part + 1) * partSize);
+        auto offset = part * partSize;
+        do {
+            auto length = std::min(crcChunkSize, end - offset);
+            chunks.push_back({offset, length, 0});
+            offset += length;
+        } while (offset < end);
+    }
+    firstChunk.push_back(chunks.size());
+    if (!calcChunksCRC(filePath, chunks, threads)) {
+        return false;
+    }
+    partCRCs.assign(static_cast<size_t>(parts), 0);
+    for (int64_t part = 0; part < parts; part++) {
+        if (firstChunk[part] == firstChunk[part + 1]) {
+            continue;
+        }
+        auto crc = chunks[firstChunk[part]].crc;
+        for (auto i = firstChunk[part] + 1; i < firstChunk[part + 1]; i++) {
+            crc = CombineCRC(crc, chunks[i].crc, chunks[i].length);
+        }
+        partCRCs[part] = crc;
+    }
+    return true;
+}
+
+bool CRC64::CalcStreamCRC(std::istream &stream, int threads, uint64_t &crc) {
+    threads = std::max(threads, 1);
+    // 读取线程按顺序读出各块，计算线程并发计算，最多缓存 threads * 2 块
+    const size_t maxQueued = static_cast<size_t>(threads) * 2;
+    std::deque<std::pair<size_t, std::shared_ptr<std::vector<char>>>> queue;
+    std::vector<CrcChunk> chunks;
+    bool readDone = false;
+    std::mutex mu;
+    std::condition_variable cv;
+    auto worker = [&]() {
+        while (true) {
+            std::pair<size_t, std::shared_ptr<std::vector<char>>> task;
+            {
+                std::unique_lock<std::mutex> lock(mu);
+                cv.wait(lock, [&]() { return !queue.empty() || readDone; });
+                if (queue.empty()) {
+                    return;
+                }
+                task = std::move(queue.front());
+                queue.pop_front();
+                cv.notify_all();
+            }
+            auto value = CalcCRC(0, task.second->data(), task.second->size());
+            std::lock_guard<std::mutex> lock(mu);
+            chunks[task.first].crc = value;
+        }
+    };
+    std::vector<std::thread> threadPool;
+    for (int i = 0; i < threads; i++) {
+        threadPool.emplace_back(worker);
+    }
+    while (stream.good()) {
+        auto buffer = std::make_shared<std::vector<char>>(crcChunkSize);
+        stream.read(buffer->data(), crcChunkSize);
+        auto n = stream.gcount();
+        if (n <= 0) {
+            break;
+        }
+        buffer->resize(static_cast<size_t>(n));
+        std::unique_lock<std::mutex> lock(mu);
+        cv.wait(lock, [&]() { return queue.size() < maxQueued; });
+        chunks.push_back({0, n, 0});
+        queue.emplace_back(chunks.size() - 1, std::move(buffer));
+        cv.notify_all();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        readDone = true;
+        cv.notify_all();
+    }
+    for (auto &t : threadPool) {
+        t.join();
+    }
+    if (stream.bad()) {
+        return false;
+    }
+    crc = 0;
+    for (size_t i = 0; i < chunks.size(); i++) {
+        crc = i == 0 ? chunks[i].crc : CombineCRC(crc, chunks[i].crc, chunks[i].length);
+    }
+    return true;
+}
+}  // namespace VolcengineTos
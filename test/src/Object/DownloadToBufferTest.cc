@@ -0,0 +1,107 @@
+#include "../TestConfig.h"
+#include "../Utils.h"
+#include "TosClientV2.h"
+#include "utils/crc64.h"
+#include <gtest/gtest.h>
+
+namespace VolcengineTos {
+class DownloadToBufferTest : public ::testing::Test {
+protected:
+    DownloadToBufferTest() {
+    }
+
+    ~DownloadToBufferTest() override {
+    }
+
+    static void SetUpTestCase() {
+        ClientConfig conf;
+        conf.endPoint = TestConfig::Endpoint;
+        cliV2 = std::make_shared<TosClientV2>(TestConfig::Region, TestConfig::Ak, TestConfig::Sk, conf);
+        bkt_name = TestUtils::GetBucketName(TestConfig::TestPrefix);
+        TestUtils::CreateBucket(cliV2, bkt_name);
+    }
+
+    // Tears down the stuff shared by all tests in this test case.
+    static void TearDownTestCase() {
+        TestUtils::CleanBucket(cliV2, bkt_name);
+        cliV2 = nullptr;
+    }
+
+public:
+    static std::shared_ptr<TosClientV2> cliV2;
+    static std::string bkt_name;
+};
+
+std::shared_ptr<TosClientV2> DownloadToBufferTest::cliV2 = nullptr;
+std::string DownloadToBufferTest::bkt_name = "";
+
+TEST_F(DownloadToBufferTest, ParallelDownloadTest) {
+    std::string obj_key = TestUtils::GetObjectKey(TestConfig::TestPrefix);
+    std::string data = TestUtils::GetRandomString(3 * 1024 * 1024 + 123);
+    TestUtils::PutObject(cliV2, bkt_name, obj_key, data);
+
+    // buffer 可以大于对象，多余部分不被写入
+    std::vector<char> buffer(data.size() + 16, 'x');
+    DownloadToBufferInput input(bkt_name, obj_key, buffer.data(), buffer.size());
+    input.setPartSize(256 * 1024);
+    input.setTaskNum(4);
+    auto output = cliV2->downloadToBuffer(input);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(output.result().getContentLength(), data.size());
+    EXPECT_EQ(output.result().getRequestCount(), 13);
+    EXPECT_EQ(output.result().getHashCrc64ecma(), CRC64::CalcCRC(0, &data[0], data.size()));
+    EXPECT_EQ(std::string(buffer.data(), data.size()), data);
+    EXPECT_EQ(std::string(buffer.data() + data.size(), 16), std::string(16, 'x'));
+
+    // 空对象不发出范围请求
+    std::string empty_key = TestUtils::GetObjectKey(TestConfig::TestPrefix);
+    TestUtils::PutObject(cliV2, bkt_name, empty_key, "");
+    output = cliV2->downloadToBuffer(DownloadToBufferInput(bkt_name, empty_key, nullptr, 0));
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(output.result().getContentLength(), 0);
+    EXPECT_EQ(output.result().getRequestCount(), 0);
+}
+
+TEST_F(DownloadToBufferTest, StaleMetaCacheTest) {
+    ClientConfig conf;
+    conf.endPoint = TestConfig::Endpoint;
+    conf.enableObjectMetaCache = true;
+    auto cachedCli = std::make_shared<TosClientV2>(TestConfig::Region, TestConfig::Ak, TestConfig::Sk, conf);
+
+    std::string obj_key = TestUtils::GetObjectKey(TestConfig::TestPrefix);
+    TestUtils::PutObject(cliV2, bkt_name, obj_key, TestUtils::GetRandomString(1000));
+    ASSERT_TRUE(cachedCli->headObject(HeadObjectV2Input(bkt_name, obj_key)).isSuccess());
+    // 由另一个 client 覆盖对象，cachedCli 缓存的元数据已经过期
+    std::string data = TestUtils::GetRandomString(2000);
+    TestUtils::PutObject(cliV2, bkt_name, obj_key, data);
+
+    std::vector<char> buffer(data.size());
+    DownloadToBufferInput input(bkt_name, obj_key, buffer.data(), buffer.size());
+    input.setPartSize(512);
+    input.setTaskNum(2);
+    auto output = cachedCli->downloadToBuffer(input);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(output.result().getContentLength(), data.size());
+    EXPECT_EQ(std::string(buffer.data(), buffer.size()), data);
+}
+
+TEST_F(DownloadToBufferTest, InvalidBufferTest) {
+    std::string obj_key = TestUtils::GetObjectKey(TestConfig::TestPrefix);
+    std::string data = TestUtils::GetRandomString(1000);
+    TestUtils::PutObject(cliV2, bkt_name, obj_key, data);
+
+    std::vector<char> buffer(999);
+    auto output = cliV2->downloadToBuffer(DownloadToBufferInput(bkt_name, obj_key, buffer.data(), buffer.size()));
+    EXPECT_FALSE(output.isSuccess());
+    EXPECT_TRUE(output.error().isClientError());
+    EXPECT_FALSE(cliV2->downloadToBuffer(DownloadToBufferInput(bkt_name, obj_key, nullptr, 1000)).isSuccess());
+    DownloadToBufferInput input(bkt_name, obj_key, buffer.data(), buffer.size());
+    input.setPartSize(0);
+    EXPECT_FALSE(cliV2->downloadToBuffer(input).isSuccess());
+    EXPECT_EQ(cliV2->downloadToBuffer(DownloadToBufferInput(bkt_name, obj_key + "-not-exist", buffer.data(),
+                                                            buffer.size()))
+                      .error()
+                      .getStatusCode(),
+              404);
+}
+}  // namespace VolcengineTos
@@ -0,0 +1,163 @@
+#include "../TestConfig.h"
+#include "../Utils.h"
+#include "TosClientV2.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace VolcengineTos {
+class ObjectBodySourceSinkTest : public ::testing::Test {
+protected:
+    ObjectBodySourceSinkTest() {
+    }
+
+    ~ObjectBodySourceSinkTest() override {
+    }
+
+    static void SetUpTestCase() {
+        ClientConfig conf;
+        conf.endPoint = TestConfig::Endpoint;
+        cliV2 = std::make_shared<TosClientV2>(TestConfig::Region, TestConfig::Ak, TestConfig::Sk, conf);
+        bkt_name = TestUtils::GetBucketName(TestConfig::TestPrefix);
+        TestUtils::CreateBucket(cliV2, bkt_name);
+    }
+
+    // Tears down the stuff shared by all tests in this test case.
+    static void TearDownTestCase() {
+        TestUtils::CleanBucket(cliV2, bkt_name);
+        cliV2 = nullptr;
+    }
+
+public:
+    static std::shared_ptr<TosClientV2> cliV2;
+    static std::string bkt_name;
+};
+
+std::shared_ptr<TosClientV2> ObjectBodySourceSinkTest::cliV2 = nullptr;
+std::string ObjectBodySourceSinkTest::bkt_name = "";
+
+TEST_F(ObjectBodySourceSinkTest, PutObjectWithBodySourceTest) {
+    std::string obj_key = TestUtils::GetObjectKey(TestConfig::TestPrefix);
+    std::string data = TestUtils::GetRandomString(1024 * 1024 + 7);
+
+    // 内存
+    PutObjectV2Input input(bkt_name, obj_key);
+    input.setBodySource(std::make_shared<MemoryBodySource>(data.data(), data.size()));
+    auto output = cliV2->putObject(input);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(TestUtils::GetObjectContentByStream(cliV2, bkt_name, obj_key), data);
+
+    // 文件中的一段
+    auto filePath = FileUtils::getTempPath() + TestUtils::GetObjectKey("body-source");
+    {
+        std::ofstream file(filePath, std::ios::out | std::ios::binary);
+        file << data;
+    }
+    input.setBodySource(std::make_shared<FileBodySource>(filePath, 100, 1000));
+    output = cliV2->putObject(input);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(TestUtils::GetObjectContentByStream(cliV2, bkt_name, obj_key), data.substr(100, 1000));
+    std::remove(filePath.c_str());
+
+    // 回调
+    input.setBodySource(std::make_shared<CallbackBodySource>(
+            data.size(), [&](int64_t offset, char* buf, int64_t len) -> int64_t {
+                len = std::min<int64_t>(len, data.size() - offset);
+                std::copy(data.begin() + offset, data.begin() + offset + len, buf);
+                return len;
+            }));
+    output = cliV2->putObject(input);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(TestUtils::GetObjectContentByStream(cliV2, bkt_name, obj_key), data);
+
+    // 读取失败时请求失败
+    input.setBodySource(std::make_shared<CallbackBodySource>(
+            data.size(), [](int64_t offset, char* buf, int64_t len) -> int64_t { return -1; }));
+    EXPECT_FALSE(cliV2->putObject(input).isSuccess());
+}
+
+// 只能顺序读取的流，不支持 seek 和 tell
+class SequentialStreamBuf : public std::streambuf {
+public:
+    explicit SequentialStreamBuf(const std::string& data) : data_(data) {
+        setg(&data_[0], &data_[0], &data_[0] + data_.size());
+    }
+
+private:
+    std::string data_;
+};
+
+TEST_F(ObjectBodySourceSinkTest, PutObjectWithStreamTest) {
+    std::string obj_key = TestUtils::GetObjectKey(TestConfig::TestPrefix);
+    std::string data = TestUtils::GetRandomString(1024 * 1024 + 7);
+
+    // 处于 fail 状态的流清除状态后仍能得到长度，完整发送
+    auto ss = std::make_shared<std::stringstream>(data);
+    ss->setstate(std::ios::failbit);
+    auto output = cliV2->putObject(PutObjectV2Input(bkt_name, obj_key, ss));
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(TestUtils::GetObjectContentByStream(cliV2, bkt_name, obj_key), data);
+
+    // 无法确定长度的流直接报错，而不是发送空的请求体
+    SequentialStreamBuf buf(data);
+    auto sequential = std::make_shared<std::iostream>(&buf);
+    output = cliV2->putObject(PutObjectV2Input(bkt_name, obj_key + "-sequential", sequential));
+    ASSERT_FALSE(output.isSuccess());
+    EXPECT_TRUE(output.error().isClientError());
+    EXPECT_EQ(cliV2->headObject(HeadObjectV2Input(bkt_name, obj_key + "-sequential")).error().getStatusCode(), 404);
+
+    // 指定长度时可以顺序发送一次
+    PutObjectV2Input input(bkt_name, obj_key + "-sequential", sequential);
+    input.setContentLength(static_cast<int64_t>(data.size()));
+    output = cliV2->putObject(input);
+    ASSERT_TRUE(output.isSuccess()) << output.error().String();
+    EXPECT_EQ(TestUtils::GetObjectContentByStream(cliV2, bkt_name, obj_key + "-sequential"), data);
+}
+
+TEST_F(ObjectBodySourceSinkTest, GetObjectWithBodySinkTest) {
+    std::string obj_key = TestUtils::GetObjectKey(TestConfig::TestPrefix);
+    std::string data = TestUtils::GetRandomString(1024 * 1024 + 7);
+    TestUtils::PutObject(cliV2, bkt_name, obj_key, data);
+
+    // 直接写入调用方的内存
+    std::vector<char> buffer(data.size());
+    auto sink = std::make_shared<MemoryBodySink>(buffer.data(), buffer.size());
+    auto output = cliV2->getObject(GetObjectV2Input(bkt_name, obj_key), sink);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(sink->written(), data.size());
+    EXPECT_EQ(std::string(buffer.data(), buffer.size()), data);
+    EXPECT_EQ(output.result().getContent(), nullptr);
+
+    // 内存不足时失败
+    std::vector<char> small(data.size() - 1);
+    EXPECT_FALSE(cliV2->getObject(GetObjectV2Input(bkt_name, obj_key),
+                                  std::make_shared<MemoryBodySink>(small.data(), small.size()))
+                         .isSuccess());
+
+    // 范围读取写入回调
+    std::string received;
+    GetObjectV2Input input(bkt_name, obj_key);
+    input.setRange("bytes=10-1033");
+    output = cliV2->getObject(input, std::make_shared<CallbackBodySink>(
+                                             [&](int64_t offset, const char* data, int64_t len) -> bool {
+                                                 received.resize(offset);
+                                                 received.append(data, len);
+                                                 return true;
+                                             }));
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(received, data.substr(10, 1024));
+
+    // 对象不存在时不写入 sink
+    std::string notExist;
+    output = cliV2->getObject(GetObjectV2Input(bkt_name, obj_key + "-not-exist"),
+                              std::make_shared<CallbackBodySink>([&](int64_t, const char* data, int64_t len) -> bool {
+                                  notExist.append(data, len);
+                                  return true;
+                              }));
+    EXPECT_FALSE(output.isSuccess());
+    EXPECT_EQ(output.error().getStatusCode(), 404);
+    EXPECT_TRUE(notExist.empty());
+    EXPECT_FALSE(cliV2->getObject(GetObjectV2Input(bkt_name, obj_key), nullptr).isSuccess());
+}
+}  // namespace VolcengineTos
@@ -0,0 +1,91 @@
+#include "../TestConfig.h"
+#include "../Utils.h"
+#include "TosClientV2.h"
+#include <gtest/gtest.h>
+
+namespace VolcengineTos {
+class ObjectReadSessionTest : public ::testing::Test {
+protected:
+    ObjectReadSessionTest() {
+    }
+
+    ~ObjectReadSessionTest() override {
+    }
+
+    static void SetUpTestCase() {
+        ClientConfig conf;
+        conf.endPoint = TestConfig::Endpoint;
+        cliV2 = std::make_shared<TosClientV2>(TestConfig::Region, TestConfig::Ak, TestConfig::Sk, conf);
+        bkt_name = TestUtils::GetBucketName(TestConfig::TestPrefix);
+        TestUtils::CreateBucket(cliV2, bkt_name);
+    }
+
+    // Tears down the stuff shared by all tests in this test case.
+    static void TearDownTestCase() {
+        TestUtils::CleanBucket(cliV2, bkt_name);
+        cliV2 = nullptr;
+    }
+
+public:
+    static std::shared_ptr<TosClientV2> cliV2;
+    static std::string bkt_name;
+};
+
+std::shared_ptr<TosClientV2> ObjectReadSessionTest::cliV2 = nullptr;
+std::string ObjectReadSessionTest::bkt_name = "";
+
+static std::string readContent(const Outcome<TosError, GetObjectV2Output>& output) {
+    std::stringstream ss;
+    ss << output.result().getContent()->rdbuf();
+    return ss.str();
+}
+
+TEST_F(ObjectReadSessionTest, SequentialReadTest) {
+    std::string obj_key = TestUtils::GetObjectKey(TestConfig::TestPrefix);
+    std::string data = TestUtils::GetRandomString(1024 * 1024 + 100);
+    TestUtils::PutObject(cliV2, bkt_name, obj_key, data);
+
+    ReadSessionOptions options;
+    options.initialWindow = 64 * 1024;
+    options.minWindow = 64 * 1024;
+    auto session = cliV2->openReadSession(GetObjectV2Input(bkt_name, obj_key), options);
+    int64_t step = 10000;
+    for (int64_t start = 0; start < static_cast<int64_t>(data.size()); start += step) {
+        auto output = session->read(start, start + step - 1);
+        ASSERT_TRUE(output.isSuccess());
+        auto expected = data.substr(start, step);
+        EXPECT_EQ(readContent(output), expected);
+        EXPECT_EQ(output.result().getGetObjectBasicOutput().getContentLength(), expected.size());
+    }
+    auto stats = session->stats();
+    EXPECT_GT(stats.prefetchRequests, 0);
+    EXPECT_GT(stats.prefetchHits, 90);
+    EXPECT_EQ(stats.wastedBytes, 0);
+}
+
+TEST_F(ObjectReadSessionTest, StridedAndRandomReadTest) {
+    std::string obj_key = TestUtils::GetObjectKey(TestConfig::TestPrefix);
+    std::string data = TestUtils::GetRandomString(200000);
+    TestUtils::PutObject(cliV2, bkt_name, obj_key, data);
+
+    auto session = cliV2->openReadSession(GetObjectV2Input(bkt_name, obj_key));
+    for (int64_t start = 0; start + 100 <= static_cast<int64_t>(data.size()); start += 5000) {
+        auto output = session->read(start, start + 99);
+        ASSERT_TRUE(output.isSuccess());
+        EXPECT_EQ(readContent(output), data.substr(start, 100));
+    }
+    EXPECT_GT(session->stats().prefetchHits, 30);
+
+    // 随机读回退为直接读取，越界的范围返回服务端错误
+    auto output = session->read(123, 456);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(readContent(output), data.substr(123, 334));
+    output = session->read(199990, 300000);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(readContent(output), data.substr(199990));
+    output = session->read(300000, 300010);
+    EXPECT_FALSE(output.isSuccess());
+    EXPECT_EQ(output.error().getStatusCode(), 416);
+    EXPECT_FALSE(session->read(10, 5).isSuccess());
+}
+}  // namespace VolcengineTos
@@ -0,0 +1,110 @@
+#include "../TestConfig.h"
+#include "../Utils.h"
+#include "TosClientV2.h"
+#include <gtest/gtest.h>
+
+namespace VolcengineTos {
+class ReadRangesTest : public ::testing::Test {
+protected:
+    ReadRangesTest() {
+    }
+
+    ~ReadRangesTest() override {
+    }
+
+    static void SetUpTestCase() {
+        ClientConfig conf;
+        conf.endPoint = TestConfig::Endpoint;
+        cliV2 = std::make_shared<TosClientV2>(TestConfig::Region, TestConfig::Ak, TestConfig::Sk, conf);
+        bkt_name = TestUtils::GetBucketName(TestConfig::TestPrefix);
+        TestUtils::CreateBucket(cliV2, bkt_name);
+    }
+
+    // Tears down the stuff shared by all tests in this test case.
+    static void TearDownTestCase() {
+        TestUtils::CleanBucket(cliV2, bkt_name);
+        cliV2 = nullptr;
+    }
+
+public:
+    static std::shared_ptr<TosClientV2> cliV2;
+    static std::string bkt_name;
+};
+
+std::shared_ptr<TosClientV2> ReadRangesTest::cliV2 = nullptr;
+std::string ReadRangesTest::bkt_name = "";
+
+TEST_F(ReadRangesTest, MergeAndSplitTest) {
+    std::string obj_key = TestUtils::GetObjectKey(TestConfig::TestPrefix);
+    std::string data = TestUtils::GetRandomString(300000);
+    TestUtils::PutObject(cliV2, bkt_name, obj_key, data);
+
+    // 乱序、重叠和间隔较小的范围
+    std::vector<std::pair<int64_t, int64_t>> ranges = {
+            {200000, 5000}, {0, 100}, {150, 100}, {200, 300}, {100000, 60000}, {205000, 1000}};
+    std::vector<std::string> buffers;
+    for (const auto& range : ranges) {
+        buffers.emplace_back(range.second, '\0');
+    }
+    ReadRangesInput input(bkt_name, obj_key);
+    for (size_t i = 0; i < ranges.size(); i++) {
+        input.addRange(ranges[i].first, ranges[i].second, &buffers[i][0]);
+    }
+    input.setMergeGap(1024);
+    input.setMaxRangeSize(16 * 1024);
+    auto output = cliV2->readRanges(input);
+    ASSERT_TRUE(output.isSuccess());
+    for (size_t i = 0; i < ranges.size(); i++) {
+        EXPECT_EQ(output.result().getReadBytes()[i], ranges[i].second);
+        EXPECT_EQ(buffers[i], data.substr(ranges[i].first, ranges[i].second));
+    }
+    // [0, 500) 一个请求，[100000, 160000) 拆分为 4 个请求，[200000, 206000) 一个请求
+    EXPECT_EQ(output.result().getRequestCount(), 6);
+    EXPECT_FALSE(output.result().getETag().empty());
+
+    // mergeGap 为 0 时只合并重叠或相邻的范围，maxRangeSize 为 0 时不拆分
+    input.setMergeGap(0);
+    input.setMaxRangeSize(0);
+    output = cliV2->readRanges(input);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(output.result().getRequestCount(), 4);
+    for (size_t i = 0; i < ranges.size(); i++) {
+        EXPECT_EQ(buffers[i], data.substr(ranges[i].first, ranges[i].second));
+    }
+}
+
+TEST_F(ReadRangesTest, OutOfRangeAndInvalidTest) {
+    std::string obj_key = TestUtils::GetObjectKey(TestConfig::TestPrefix);
+    std::string data = TestUtils::GetRandomString(10000);
+    TestUtils::PutObject(cliV2, bkt_name, obj_key, data);
+
+    // 超出对象大小的部分不写入
+    std::string tail(200, '\0');
+    std::string beyond(100, '\0');
+    ReadRangesInput input(bkt_name, obj_key);
+    input.addRange(9900, 200, &tail[0]);
+    input.addRange(50000, 100, &beyond[0]);
+    auto output = cliV2->readRanges(input);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(output.result().getReadBytes()[0], 100);
+    EXPECT_EQ(output.result().getReadBytes()[1], 0);
+    EXPECT_EQ(tail.substr(0, 100), data.substr(9900));
+
+    ReadRangesInput beyondInput(bkt_name, obj_key);
+    beyondInput.addRange(50000, 100, &beyond[0]);
+    output = cliV2->readRanges(beyondInput);
+    EXPECT_FALSE(output.isSuccess());
+    EXPECT_EQ(output.error().getStatusCode(), 416);
+
+    ReadRangesInput invalid(bkt_name, obj_key);
+    invalid.addRange(0, 0, &beyond[0]);
+    EXPECT_FALSE(cliV2->readRanges(invalid).isSuccess());
+    EXPECT_FALSE(cliV2->readRanges(ReadRangesInput(bkt_name, obj_key)).isSuccess());
+
+    ReadRangesInput missing(bkt_name, obj_key + "-missing");
+    missing.addRange(0, 100, &beyond[0]);
+    output = cliV2->readRanges(missing);
+    EXPECT_FALSE(output.isSuccess());
+    EXPECT_EQ(output.error().getStatusCode(), 404);
+}
+}  // namespace VolcengineTos
@@ -0,0 +1,258 @@
+#include "../TestConfig.h"
+#include "../Utils.h"
+#include "TosClientV2.h"
+#include <arpa/inet.h>
+#include <atomic>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <netinet/in.h>
+#include <sstream>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+namespace VolcengineTos {
+class AutoParallelTest : public ::testing::Test {
+protected:
+    AutoParallelTest() {
+    }
+
+    ~AutoParallelTest() override {
+    }
+
+    static void SetUpTestCase() {
+        ClientConfig conf;
+        conf.endPoint = TestConfig::Endpoint;
+        conf.multipartThreshold = 10 * 1024 * 1024;
+        conf.parallelGetThreshold = 10 * 1024 * 1024;
+        conf.parallelPartSize = 5 * 1024 * 1024;
+        conf.parallelTaskNum = 4;
+        cliV2 = std::make_shared<TosClientV2>(TestConfig::Region, TestConfig::Ak, TestConfig::Sk, conf);
+        bucketName = TestUtils::GetBucketName(TestConfig::TestPrefix);
+        TestUtils::CreateBucket(cliV2, bucketName);
+        workPath = FileUtils::getWorkPath();
+    }
+
+    // Tears down the stuff shared by all tests in this test case.
+    static void TearDownTestCase() {
+        TestUtils::CleanBucket(cliV2, bucketName);
+        cliV2 = nullptr;
+    }
+
+public:
+    static std::shared_ptr<TosClientV2> cliV2;
+    static std::string bucketName;
+    static std::string workPath;
+};
+
+std::shared_ptr<TosClientV2> AutoParallelTest::cliV2 = nullptr;
+std::string AutoParallelTest::bucketName = "";
+std::string AutoParallelTest::workPath = "";
+
+static std::string readFile(const std::string& path) {
+    std::ifstream ifs(path, std::ios::in | std::ios::binary);
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+    return ss.str();
+}
+
+TEST_F(AutoParallelTest, PutAndGetLargeFileTest) {
+    std::string filePath = workPath + "test" + TOS_PATH_DELIMITER + "testdata" + TOS_PATH_DELIMITER + "autoParallel";
+    TestUtils::WriteRandomDatatoFile(filePath, 23 * 1024 * 1024);
+    std::string objectName = TestUtils::GetObjectKey(TestConfig::TestPrefix);
+
+    PutObjectFromFileInput putInput(bucketName, objectName, filePath);
+    putInput.setMeta({{"self-test", "yes"}});
+    auto putOutput = cliV2->putObjectFromFile(putInput);
+    ASSERT_TRUE(putOutput.isSuccess()) << putOutput.error().String();
+    EXPECT_NE(putOutput.result().getPutObjectV2Output().getHashCrc64ecma(), 0);
+
+    // 超过阈值时以分片上传的方式写入，元数据与单个 PUT 一致
+    auto headOutput = cliV2->headObject(HeadObjectV2Input(bucketName, objectName));
+    ASSERT_TRUE(headOutput.isSuccess());
+    EXPECT_EQ(headOutput.result().getContentLength(), 23 * 1024 * 1024);
+    EXPECT_EQ(headOutput.result().getMeta().at("self-test"), "yes");
+    EXPECT_EQ(headOutput.result().getETags(), putOutput.result().getPutObjectV2Output().getETag());
+    EXPECT_EQ(headOutput.result().getHashCrc64Ecma(), putOutput.result().getPutObjectV2Output().getHashCrc64ecma());
+
+    GetObjectToFileInput getInput(bucketName, objectName, filePath + ".download");
+    auto getOutput = cliV2->getObjectToFile(getInput);
+    ASSERT_TRUE(getOutput.isSuccess()) << getOutput.error().String();
+    const auto& basicOutput = getOutput.result().getGetObjectBasicOutput();
+    EXPECT_EQ(basicOutput.getContentLength(), 23 * 1024 * 1024);
+    EXPECT_EQ(basicOutput.getETags(), headOutput.result().getETags());
+    EXPECT_EQ(basicOutput.getMeta().at("self-test"), "yes");
+    EXPECT_TRUE(readFile(filePath + ".download") == readFile(filePath));
+
+    // 指定范围时仍使用单个 GET
+    getInput.setRange("bytes=0-99");
+    getOutput = cliV2->getObjectToFile(getInput);
+    ASSERT_TRUE(getOutput.isSuccess());
+    EXPECT_EQ(getOutput.result().getGetObjectBasicOutput().getContentLength(), 100);
+    EXPECT_EQ(readFile(filePath + ".download"), readFile(filePath).substr(0, 100));
+    remove(filePath.c_str());
+    remove((filePath + ".download").c_str());
+}
+
+TEST_F(AutoParallelTest, SmallFileTest) {
+    std::string filePath = workPath + "test" + TOS_PATH_DELIMITER + "testdata" + TOS_PATH_DELIMITER + "autoParallelSmall";
+    TestUtils::WriteRandomDatatoFile(filePath, 1024 * 1024);
+    std::string objectName = TestUtils::GetObjectKey(TestConfig::TestPrefix);
+
+    auto putOutput = cliV2->putObjectFromFile(PutObjectFromFileInput(bucketName, objectName, filePath));
+    ASSERT_TRUE(putOutput.isSuccess());
+    // 未超过阈值时为单个 PUT，ETag 是对象的 MD5
+    EXPECT_EQ(putOutput.result().getPutObjectV2Output().getETag().find('-'), std::string::npos);
+
+    auto getOutput = cliV2->getObjectToFile(GetObjectToFileInput(bucketName, objectName, filePath + ".download"));
+    ASSERT_TRUE(getOutput.isSuccess());
+    EXPECT_EQ(readFile(filePath + ".download"), readFile(filePath));
+
+    // 对象不存在时返回 GET 的错误
+    getOutput = cliV2->getObjectToFile(GetObjectToFileInput(bucketName, objectName + "-none", filePath + ".none"));
+    ASSERT_FALSE(getOutput.isSuccess());
+    EXPECT_EQ(getOutput.error().getStatusCode(), 404);
+    EXPECT_EQ(getOutput.error().getCode(), "NoSuchKey");
+    remove(filePath.c_str());
+    remove((filePath + ".download").c_str());
+}
+
+TEST_F(AutoParallelTest, StaleMetaCacheTest) {
+    std::string filePath = workPath + "test" + TOS_PATH_DELIMITER + "testdata" + TOS_PATH_DELIMITER + "autoParallelStale";
+    TestUtils::WriteRandomDatatoFile(filePath, 23 * 1024 * 1024);
+    std::string objectName = TestUtils::GetObjectKey(TestConfig::TestPrefix);
+    ASSERT_TRUE(cliV2->putObjectFromFile(PutObjectFromFileInput(bucketName, objectName, filePath)).isSuccess());
+
+    ClientConfig conf;
+    conf.endPoint = TestConfig::Endpoint;
+    conf.parallelGetThreshold = 10 * 1024 * 1024;
+    conf.parallelPartSize = 5 * 1024 * 1024;
+    conf.enableObjectMetaCache = true;
+    auto cachedClient = std::make_shared<TosClientV2>(TestConfig::Region, TestConfig::Ak, TestConfig::Sk, conf);
+    ASSERT_TRUE(cachedClient->headObject(HeadObjectV2Input(bucketName, objectName)).isSuccess());
+
+    // 对象被其他 client 覆盖后，元数据缓存中的 ETag 已过期，分段下载不应使用它
+    TestUtils::WriteRandomDatatoFile(filePath, 21 * 1024 * 1024);
+    ASSERT_TRUE(cliV2->putObjectFromFile(PutObjectFromFileInput(bucketName, objectName, filePath)).isSuccess());
+    auto getOutput = cachedClient->getObjectToFile(GetObjectToFileInput(bucketName, objectName, filePath + ".download"));
+    ASSERT_TRUE(getOutput.isSuccess()) << getOutput.error().String();
+    EXPECT_EQ(getOutput.result().getGetObjectBasicOutput().getContentLength(), 21 * 1024 * 1024);
+    EXPECT_TRUE(getOutput.result().getGetObjectBasicOutput().getContentRange().empty());
+    EXPECT_TRUE(readFile(filePath + ".download") == readFile(filePath));
+    remove(filePath.c_str());
+    remove((filePath + ".download").c_str());
+}
+
+// 按请求的 Range 返回对象的本地服务：第一个分段返回 206，其余带 If-Match 的分段返回 partStatus，不带 Range 的请求返回 200
+class RangeServer {
+public:
+    RangeServer(std::string body, int partStatus) : body_(std::move(body)), partStatus_(partStatus) {
+        fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        listen(fd_, 16);
+        socklen_t len = sizeof(addr);
+        getsockname(fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+        thread_ = std::thread([this]() {
+            while (true) {
+                int conn = accept(fd_, nullptr, nullptr);
+                if (conn < 0) {
+                    return;
+                }
+                std::string request;
+                char buf[4096];
+                while (request.find("\r\n\r\n") == std::string::npos) {
+                    auto n = recv(conn, buf, sizeof(buf), 0);
+                    if (n <= 0) {
+                        break;
+                    }
+                    request.append(buf, n);
+                }
+                auto response = respond(request);
+                send(conn, response.data(), response.size(), 0);
+                shutdown(conn, SHUT_WR);
+                while (recv(conn, buf, sizeof(buf), 0) > 0) {
+                }
+                close(conn);
+            }
+        });
+    }
+    ~RangeServer() {
+        shutdown(fd_, SHUT_RDWR);
+        close(fd_);
+        thread_.join();
+    }
+    int port() const {
+        return port_;
+    }
+    int fullGets() const {
+        return fullGets_;
+    }
+
+private:
+    std::string respond(const std::string& request) {
+        auto pos = request.find("Range:bytes=");
+        if (pos == std::string::npos) {
+            fullGets_++;
+            return "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(body_.size()) +
+                   "\r\nETag: \"etag\"\r\nConnection: close\r\n\r\n" + body_;
+        }
+        if (request.find("If-Match:") != std::string::npos) {
+            std::string error = "{\"Code\":\"AccessDenied\",\"Message\":\"denied\"}";
+            return "HTTP/1.1 " + std::to_string(partStatus_) + " Error\r\nContent-Type: application/json\r\n" +
+                   "Content-Length: " + std::to_string(error.size()) + "\r\nConnection: close\r\n\r\n" + error;
+        }
+        pos += 12;
+        auto dash = request.find('-', pos);
+        auto start = std::stoll(request.substr(pos, dash - pos));
+        auto end = std::stoll(request.substr(dash + 1, request.find("\r\n", dash) - dash - 1));
+        end = std::min<int64_t>(end, body_.size() - 1);
+        return "HTTP/1.1 206 Partial Content\r\nContent-Length: " + std::to_string(end - start + 1) +
+               "\r\nContent-Range: bytes " + std::to_string(start) + "-" + std::to_string(end) + "/" +
+               std::to_string(body_.size()) + "\r\nETag: \"etag\"\r\nConnection: close\r\n\r\n" +
+               body_.substr(start, end - start + 1);
+    }
+
+    std::string body_;
+    int partStatus_;
+    int fd_;
+    int port_;
+    std::atomic<int> fullGets_{0};
+    std::thread thread_;
+};
+
+TEST(AutoParallelFallbackTest, PartErrorIsReturnedTest) {
+    std::string body(12 * 1024 * 1024, 'a');
+    ClientConfig conf;
+    conf.endPoint = "http://tos-parallel.local";
+    conf.parallelGetThreshold = 10 * 1024 * 1024;
+    conf.parallelPartSize = 5 * 1024 * 1024;
+    auto filePath = FileUtils::getTempPath() + TestUtils::GetObjectKey("auto-parallel");
+
+    // 分段返回 403 时直接返回错误，不再改为单个 GET 重新下载
+    {
+        RangeServer server(body, 403);
+        conf.proxyHost = "127.0.0.1";
+        conf.proxyPort = server.port();
+        TosClientV2 client("cn-beijing", "ak", "sk", conf);
+        auto output = client.getObjectToFile(GetObjectToFileInput("bucket", "key", filePath));
+        ASSERT_FALSE(output.isSuccess());
+        EXPECT_EQ(output.error().getStatusCode(), 403);
+        EXPECT_EQ(server.fullGets(), 0);
+    }
+    // 分段返回 412 说明对象已被覆盖，改为单个 GET
+    {
+        RangeServer server(body, 412);
+        conf.proxyPort = server.port();
+        TosClientV2 client("cn-beijing", "ak", "sk", conf);
+        auto output = client.getObjectToFile(GetObjectToFileInput("bucket", "key", filePath));
+        ASSERT_TRUE(output.isSuccess()) << output.error().String();
+        EXPECT_EQ(server.fullGets(), 1);
+        EXPECT_TRUE(readFile(filePath) == body);
+    }
+    remove(filePath.c_str());
+}
+}  // namespace VolcengineTos
@@ -0,0 +1,175 @@
+#include "../TestConfig.h"
+#include "../Utils.h"
+#include "TosClientV2.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <mutex>
+
+namespace VolcengineTos {
+class CopyPrefixTest : public ::testing::Test {
+protected:
+    CopyPrefixTest() {
+    }
+
+    ~CopyPrefixTest() override {
+    }
+
+    static void SetUpTestCase() {
+        ClientConfig conf;
+        conf.endPoint = TestConfig::Endpoint;
+        cliV2 = std::make_shared<TosClientV2>(TestConfig::Region, TestConfig::Ak, TestConfig::Sk, conf);
+        bucketName = TestUtils::GetBucketName(TestConfig::TestPrefix);
+        TestUtils::CreateBucket(cliV2, bucketName);
+    }
+
+    // Tears down the stuff shared by all tests in this test case.
+    static void TearDownTestCase() {
+        TestUtils::CleanBucket(cliV2, bucketName);
+        cliV2 = nullptr;
+    }
+
+public:
+    static std::shared_ptr<TosClientV2> cliV2;
+    static std::string bucketName;
+};
+
+std::shared_ptr<TosClientV2> CopyPrefixTest::cliV2 = nullptr;
+std::string CopyPrefixTest::bucketName = "";
+
+TEST_F(CopyPrefixTest, CopyPrefixWithJournalTest) {
+    std::string srcPrefix = TestUtils::GetObjectKey(TestConfig::TestPrefix) + "/";
+    std::string prefix = TestUtils::GetObjectKey(TestConfig::TestPrefix) + "-copy/";
+    std::map<std::string, std::string> objects;
+    for (int i = 0; i < 20; i++) {
+        objects["small/" + std::to_string(i)] = TestUtils::GetRandomString(100 + i);
+    }
+    objects["large"] = TestUtils::GetRandomString(11 * 1024 * 1024 + 3);
+    for (const auto& object : objects) {
+        TestUtils::PutObject(cliV2, bucketName, srcPrefix + object.first, object.second);
+    }
+
+    auto journalFile = FileUtils::getTempPath() + TestUtils::GetObjectKey("copy-journal");
+    CopyPrefixInput input(bucketName, srcPrefix, bucketName, prefix);
+    input.setTaskNum(4);
+    input.setPartSize(5 * 1024 * 1024);
+    input.setMultipartThreshold(5 * 1024 * 1024);
+    input.setJournalFile(journalFile);
+    std::mutex mu;
+    std::map<std::string, CopyPrefixResult> results;
+    input.setResultCallback([&](const CopyPrefixResult& result) {
+        std::lock_guard<std::mutex> lock(mu);
+        results[result.getSrcKey()] = result;
+    });
+    auto output = cliV2->copyPrefix(input);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(output.result().getListedObjects(), objects.size());
+    EXPECT_EQ(output.result().getCopiedObjects(), objects.size());
+    EXPECT_EQ(output.result().getMultipartObjects(), 1);
+    EXPECT_EQ(results.size(), objects.size());
+    for (const auto& object : objects) {
+        EXPECT_TRUE(results[srcPrefix + object.first].isSuccess());
+        EXPECT_EQ(results[srcPrefix + object.first].getKey(), prefix + object.first);
+        EXPECT_EQ(TestUtils::GetObjectContentByStream(cliV2, bucketName, prefix + object.first), object.second);
+    }
+
+    // journal 中已复制的对象不再复制
+    results.clear();
+    output = cliV2->copyPrefix(input);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(output.result().getCopiedObjects(), 0);
+    EXPECT_EQ(output.result().getSkippedObjects(), objects.size());
+    EXPECT_TRUE(results[srcPrefix + "large"].isSkipped());
+
+    // 源对象变化后重新复制
+    objects["small/3"] = TestUtils::GetRandomString(300);
+    TestUtils::PutObject(cliV2, bucketName, srcPrefix + "small/3", objects["small/3"]);
+    output = cliV2->copyPrefix(input);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(output.result().getCopiedObjects(), 1);
+    EXPECT_EQ(TestUtils::GetObjectContentByStream(cliV2, bucketName, prefix + "small/3"), objects["small/3"]);
+    std::remove(journalFile.c_str());
+}
+
+TEST_F(CopyPrefixTest, MovePrefixWithKeyMapperTest) {
+    std::string srcPrefix = TestUtils::GetObjectKey(TestConfig::TestPrefix) + "/";
+    std::string prefix = TestUtils::GetObjectKey(TestConfig::TestPrefix) + "-move/";
+    std::map<std::string, std::string> objects;
+    for (int i = 0; i < 10; i++) {
+        objects[std::to_string(i) + (i % 2 == 0 ? ".log" : ".txt")] = TestUtils::GetRandomString(100 + i);
+    }
+    objects["large.log"] = TestUtils::GetRandomString(11 * 1024 * 1024 + 3);
+    for (const auto& object : objects) {
+        TestUtils::PutObject(cliV2, bucketName, srcPrefix + object.first, object.second);
+    }
+
+    // 只移动 .log 对象
+    CopyPrefixInput input(bucketName, srcPrefix, bucketName, prefix);
+    input.setTaskNum(4);
+    input.setPartSize(5 * 1024 * 1024);
+    input.setMultipartThreshold(5 * 1024 * 1024);
+    input.setDeleteSource(true);
+    input.setKeyMapper([&](const std::string& srcKey) -> std::string {
+        if (srcKey.size() < 4 || srcKey.compare(srcKey.size() - 4, 4, ".log") != 0) {
+            return "";
+        }
+        return prefix + srcKey.substr(srcPrefix.size());
+    });
+    auto output = cliV2->copyPrefix(input);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(output.result().getCopiedObjects(), 6);
+    EXPECT_EQ(output.result().getSkippedObjects(), 5);
+    EXPECT_EQ(output.result().getDeletedObjects(), 6);
+    for (const auto& object : objects) {
+        bool moved = object.first.find(".log") != std::string::npos;
+        EXPECT_EQ(cliV2->headObject(HeadObjectV2Input(bucketName, srcPrefix + object.first)).isSuccess(), !moved);
+        if (moved) {
+            EXPECT_EQ(TestUtils::GetObjectContentByStream(cliV2, bucketName, prefix + object.first), object.second);
+        }
+    }
+}
+
+TEST_F(CopyPrefixTest, CopyIntoSourceSubPrefixTest) {
+    std::string srcPrefix = TestUtils::GetObjectKey(TestConfig::TestPrefix) + "/";
+    std::string prefix = srcPrefix + "z/";
+    // 超过一页列举结果，之后的列举页会返回已复制到源前缀之下的对象
+    const int count = 1050;
+    for (int i = 0; i < count; i++) {
+        TestUtils::PutObject(cliV2, bucketName, srcPrefix + std::to_string(1000 + i), std::to_string(i));
+    }
+    CopyPrefixInput input(bucketName, srcPrefix, bucketName, prefix);
+    input.setTaskNum(8);
+    input.setKeyMapper([&](const std::string& srcKey) { return prefix + srcKey.substr(srcPrefix.size()); });
+    auto output = cliV2->copyPrefix(input);
+    ASSERT_TRUE(output.isSuccess()) << output.error().getMessage();
+    EXPECT_EQ(output.result().getCopiedObjects(), count);
+
+    int copied = 0;
+    ListObjectsType2Input listInput(bucketName);
+    listInput.setPrefix(prefix);
+    while (true) {
+        auto listOutput = cliV2->listObjectsType2(listInput);
+        ASSERT_TRUE(listOutput.isSuccess());
+        for (const auto& content : listOutput.result().getContents()) {
+            // 复制出的对象不会被再次复制到更深的前缀
+            EXPECT_EQ(content.getKey().find('/', prefix.size()), std::string::npos) << content.getKey();
+            copied++;
+        }
+        if (!listOutput.result().isTruncated()) {
+            break;
+        }
+        listInput.setContinuationToken(listOutput.result().getNextContinuationToken());
+    }
+    EXPECT_EQ(copied, count);
+}
+
+TEST_F(CopyPrefixTest, CopyPrefixInvalidTest) {
+    std::string srcPrefix = TestUtils::GetObjectKey(TestConfig::TestPrefix) + "/";
+    EXPECT_FALSE(cliV2->copyPrefix(CopyPrefixInput("", srcPrefix, bucketName, "dst/")).isSuccess());
+    // 目标前缀在源前缀之下
+    EXPECT_FALSE(cliV2->copyPrefix(CopyPrefixInput(bucketName, srcPrefix, bucketName, srcPrefix + "copy/"))
+                         .isSuccess());
+    CopyPrefixInput input(bucketName, srcPrefix, bucketName, "dst/");
+    input.setPartSize(1024);
+    EXPECT_FALSE(cliV2->copyPrefix(input).isSuccess());
+}
+}  // namespace VolcengineTos
@@ -3,7 +3,9 @@
 #include "TosClientV2.h"
 #include "model/object/DownloadFileInput.h"
 #include <gtest/gtest.h>
+#include <atomic>
 #include <fstream>
+#include <sstream>
 
 
 namespace VolcengineTos {
@@ -356,4 +358,54 @@ TEST_F(DownLoadFileTest, DownLoadFileWithTrafficLimitTest) {
     EXPECT_EQ(time2 > time1, true);
     remove(filePath.c_str());
 }
+
+static std::string readWholeFile(const std::string& filePath) {
+    std::ifstream file(filePath, std::ios_base::in | std::ios_base::binary);
+    std::ostringstream ss;
+    ss << file.rdbuf();
+    return ss.str();
+}
+
+// 多线程下载时分片完成顺序不定，每个分片都必须写到自己的偏移上
+TEST_F(DownLoadFileTest, DownLoadFileMultiPartDataTest) {
+    std::string filePath = workPath + "test" + TOS_PATH_DELIMITER + "testdata" + TOS_PATH_DELIMITER + "downloadFile4";
+    remove(filePath.c_str());
+    std::string objectName = TestUtils::GetObjectKey(TestConfig::TestPrefix);
+    // 最后一个分片最小，通常最先完成
+    std::string data = TestUtils::GetRandomString(26 << 20);
+    auto putOutput = cliV2->putObject(PutObjectV2Input(bucketName, objectName, std::make_shared<std::stringstream>(data)));
+    ASSERT_TRUE(putOutput.isSuccess());
+
+    DownloadFileInput input;
+    input.setHeadObjectV2Input(HeadObjectV2Input(bucketName, objectName));
+    input.setTaskNum(4);
+    input.setEnableCheckpoint(false);
+    input.setPartSize(5 * 1024 * 1024);
+    input.setFilePath(filePath);
+    auto output = cliV2->downloadFile(input);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_TRUE(readWholeFile(filePath) == data);
+    remove(filePath.c_str());
+
+    // 中断后删除临时文件再续传，checkpoint 中已完成的分片需要重新下载
+    std::shared_ptr<CancelHook> cancelHook(NewCancelHook());
+    std::atomic<int> succeed(0);
+    input.setEnableCheckpoint(true);
+    input.setCancelHook(cancelHook);
+    input.setDownloadEventListener({[&](std::shared_ptr<DownloadEvent> event) {
+        if (event->type_ == DownloadEventDownloadPartSucceed && ++succeed == 2) {
+            cancelHook->Cancel(false);
+        }
+    }});
+    output = cliV2->downloadFile(input);
+    ASSERT_FALSE(output.isSuccess());
+    remove((filePath + ".temp").c_str());
+
+    input.setCancelHook(std::shared_ptr<CancelHook>(NewCancelHook()));
+    input.setDownloadEventListener({nullptr});
+    output = cliV2->downloadFile(input);
+    ASSERT_TRUE(output.isSuccess()) << output.error().String();
+    EXPECT_TRUE(readWholeFile(filePath) == data);
+    remove(filePath.c_str());
+}
 }  // namespace VolcengineTos
@@ -0,0 +1,99 @@
+#include "../TestConfig.h"
+#include "../Utils.h"
+#include "TosClientV2.h"
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sys/stat.h>
+
+namespace VolcengineTos {
+class DownloadPrefixTest : public ::testing::Test {
+protected:
+    DownloadPrefixTest() {
+    }
+
+    ~DownloadPrefixTest() override {
+    }
+
+    static void SetUpTestCase() {
+        ClientConfig conf;
+        conf.endPoint = TestConfig::Endpoint;
+        cliV2 = std::make_shared<TosClientV2>(TestConfig::Region, TestConfig::Ak, TestConfig::Sk, conf);
+        bucketName = TestUtils::GetBucketName(TestConfig::TestPrefix);
+        TestUtils::CreateBucket(cliV2, bucketName);
+    }
+
+    // Tears down the stuff shared by all tests in this test case.
+    static void TearDownTestCase() {
+        TestUtils::CleanBucket(cliV2, bucketName);
+        cliV2 = nullptr;
+    }
+
+public:
+    static std::shared_ptr<TosClientV2> cliV2;
+    static std::string bucketName;
+};
+
+std::shared_ptr<TosClientV2> DownloadPrefixTest::cliV2 = nullptr;
+std::string DownloadPrefixTest::bucketName = "";
+
+static std::string readFile(const std::string& path) {
+    std::ifstream ifs(path, std::ios::in | std::ios::binary);
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+    return ss.str();
+}
+
+TEST_F(DownloadPrefixTest, DownloadPrefixTest) {
+    std::string prefix = TestUtils::GetObjectKey(TestConfig::TestPrefix) + "/";
+    std::map<std::string, std::string> objects;
+    for (int i = 0; i < 30; i++) {
+        objects["small/" + std::to_string(i)] = TestUtils::GetRandomString(100 + i);
+    }
+    objects["a/b/c.txt"] = TestUtils::GetRandomString(1000);
+    objects["empty"] = "";
+    objects["large"] = TestUtils::GetRandomString(11 * 1024 * 1024 + 3);
+    for (const auto& object : objects) {
+        TestUtils::PutObject(cliV2, bucketName, prefix + object.first, object.second);
+    }
+    TestUtils::PutObject(cliV2, bucketName, prefix + "dir/", "");
+
+    auto dir = FileUtils::getTempPath() + TestUtils::GetObjectKey("download-prefix");
+    DownloadPrefixInput input(bucketName, prefix, dir);
+    input.setTaskNum(4);
+    input.setPartSize(5 * 1024 * 1024);
+    input.setParallelThreshold(5 * 1024 * 1024);
+    input.setMaxInflightBytes(8 * 1024 * 1024);
+    auto output = cliV2->downloadPrefix(input);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(output.result().getListedObjects(), objects.size() + 1);
+    EXPECT_EQ(output.result().getDownloadedFiles(), objects.size());
+    EXPECT_EQ(output.result().getParallelFiles(), 1);
+    for (const auto& object : objects) {
+        EXPECT_EQ(readFile(dir + TOS_PATH_DELIMITER + object.first), object.second);
+    }
+    struct stat st {};
+    EXPECT_EQ(stat((dir + TOS_PATH_DELIMITER + "dir").c_str(), &st), 0);
+
+    // 再次下载覆盖已有文件，目录中同名的 .temp 文件不受影响
+    auto userTemp = dir + TOS_PATH_DELIMITER + "large.temp";
+    std::ofstream(userTemp, std::ios_base::out | std::ios_base::binary) << "user data";
+    output = cliV2->downloadPrefix(input);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(readFile(dir + TOS_PATH_DELIMITER + "large"), objects["large"]);
+    EXPECT_EQ(readFile(userTemp), "user data");
+}
+
+TEST_F(DownloadPrefixTest, DownloadPrefixInvalidTest) {
+    std::string prefix = TestUtils::GetObjectKey(TestConfig::TestPrefix) + "/";
+    EXPECT_FALSE(cliV2->downloadPrefix(DownloadPrefixInput(bucketName, prefix, "")).isSuccess());
+    DownloadPrefixInput input(bucketName, prefix, FileUtils::getTempPath());
+    input.setPartSize(1024);
+    EXPECT_FALSE(cliV2->downloadPrefix(input).isSuccess());
+
+    // 前缀下没有对象
+    input.setPartSize(5 * 1024 * 1024);
+    auto output = cliV2->downloadPrefix(input);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(output.result().getListedObjects(), 0);
+}
+}  // namespace VolcengineTos
@@ -0,0 +1,125 @@
+#include "../TestConfig.h"
+#include "../Utils.h"
+#include "metrics/Metrics.h"
+#include "transport/EndpointSelector.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <map>
+#include <thread>
+
+namespace VolcengineTos {
+class EndpointSelectorTest : public ::testing::Test {
+protected:
+    EndpointSelectorTest() {
+    }
+
+    ~EndpointSelectorTest() override {
+    }
+
+    static void SetUpTestCase() {
+    }
+
+    // Tears down the stuff shared by all tests in this test case.
+    static void TearDownTestCase() {
+    }
+};
+
+static std::vector<EndpointSelector::Endpoint> testEndpoints() {
+    return {{"https", "tos-cn-beijing.ivolces.com"}, {"https", "tos-cn-beijing.volces.com"}};
+}
+
+TEST_F(EndpointSelectorTest, SelectFastestTest) {
+    MetricsRegistry::instance()->setEnabled(true);
+    MetricsRegistry::instance()->reset();
+    std::map<std::string, int64_t> latency = {{"tos-cn-beijing.ivolces.com", 20000},
+                                              {"tos-cn-beijing.volces.com", 5000}};
+    EndpointSelector selector(testEndpoints(), 0,
+                              [&](const std::string&, const std::string& host) { return latency[host]; });
+    // 尚无探测结果时按配置顺序
+    EXPECT_EQ(selector.select(), 0);
+    selector.probe();
+    EXPECT_EQ(selector.select(), 1);
+
+    // 耗时相近时不来回切换
+    latency["tos-cn-beijing.ivolces.com"] = 4500;
+    selector.probe();
+    EXPECT_EQ(selector.select(), 1);
+    for (int i = 0; i < 30; i++) {
+        latency["tos-cn-beijing.ivolces.com"] = 1000;
+        selector.probe();
+    }
+    EXPECT_EQ(selector.select(), 0);
+
+    // 探测失败的 endpoint 被剔除
+    latency["tos-cn-beijing.ivolces.com"] = -1;
+    selector.probe();
+    EXPECT_EQ(selector.select(), 1);
+    auto stats = selector.stats();
+    ASSERT_EQ(stats.size(), 2);
+    EXPECT_TRUE(stats[0].ejected);
+    EXPECT_FALSE(stats[1].ejected);
+
+    auto text = PrometheusTextExporter::format(MetricsRegistry::instance()->snapshot());
+    EXPECT_NE(text.find("tos_sdk_endpoint_switches_total{endpoint=\"https://tos-cn-beijing.volces.com\"} 2"),
+              std::string::npos);
+    EXPECT_NE(text.find("tos_sdk_endpoint_failures_total{endpoint=\"https://tos-cn-beijing.ivolces.com\"} 1"),
+              std::string::npos);
+    EXPECT_NE(text.find("tos_sdk_endpoint_probe_duration_microseconds_count{endpoint=\"https://"
+                        "tos-cn-beijing.volces.com\"}"),
+              std::string::npos);
+    MetricsRegistry::instance()->setEnabled(false);
+}
+
+TEST_F(EndpointSelectorTest, FailoverTest) {
+    EndpointSelector selector(testEndpoints(), 0, nullptr);
+    std::vector<bool> tried;
+    EXPECT_EQ(selector.select(), 0);
+    EXPECT_EQ(selector.failover(0, tried), 1);
+    // 被剔除的 endpoint 不再用于新请求
+    EXPECT_EQ(selector.select(), 1);
+    // 本次请求的 endpoint 都尝试过了
+    EXPECT_EQ(selector.failover(1, tried), -1);
+
+    // 全部被剔除时仍选一个探测，收到响应后恢复
+    auto index = selector.select();
+    selector.succeed(index);
+    EXPECT_EQ(selector.stats()[index].failures, 0);
+    EXPECT_FALSE(selector.stats()[index].ejected);
+    EXPECT_EQ(selector.select(), index);
+}
+
+TEST_F(EndpointSelectorTest, BackgroundProbeTest) {
+    std::atomic<int> probes(0);
+    {
+        EndpointSelector selector(testEndpoints(), 1, [&](const std::string&, const std::string& host) -> int64_t {
+            probes++;
+            return host == "tos-cn-beijing.volces.com" ? 100 : 1000;
+        });
+        // 启动后立即探测一轮
+        for (int i = 0; i < 100 && selector.select() != 1; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        EXPECT_EQ(selector.select(), 1);
+    }
+    // 析构时停止探测
+    auto count = probes.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    EXPECT_EQ(probes.load(), count);
+}
+
+TEST_F(EndpointSelectorTest, EjectExpireTest) {
+    EndpointSelector selector(testEndpoints(), 0, nullptr);
+    std::vector<bool> tried;
+    EXPECT_EQ(selector.select(), 0);
+    EXPECT_EQ(selector.failover(0, tried), 1);
+    EXPECT_EQ(selector.select(), 1);
+    // 没有失败记录的 endpoint 收到响应时状态不变
+    selector.succeed(1);
+    EXPECT_EQ(selector.select(), 1);
+    // 剔除到期后按配置顺序切回
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    EXPECT_EQ(selector.select(), 0);
+    EXPECT_EQ(selector.stats()[0].failures, 1);
+    EXPECT_FALSE(selector.stats()[0].ejected);
+}
+}  // namespace VolcengineTos
@@ -0,0 +1,136 @@
+#include "../TestConfig.h"
+#include "../Utils.h"
+#include "metrics/Metrics.h"
+#include "transport/http/HostResolver.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <map>
+#include <thread>
+
+namespace VolcengineTos {
+class HostResolverTest : public ::testing::Test {
+protected:
+    HostResolverTest() {
+    }
+
+    ~HostResolverTest() override {
+    }
+
+    static void SetUpTestCase() {
+    }
+
+    // Tears down the stuff shared by all tests in this test case.
+    static void TearDownTestCase() {
+    }
+};
+
+static HostResolver::ResolveFunc fixedAddresses(const std::vector<std::string>& addresses, int* calls = nullptr) {
+    return [addresses, calls](const std::string&, int) {
+        if (calls != nullptr) {
+            (*calls)++;
+        }
+        return addresses;
+    };
+}
+
+TEST_F(HostResolverTest, SpreadAcrossAddressesTest) {
+    int calls = 0;
+    HostResolver resolver(60, fixedAddresses({"10.0.0.1", "10.0.0.2", "10.0.0.3"}, &calls));
+    // 并发请求分散到不同地址
+    std::map<std::string, int> used;
+    std::vector<std::string> acquired;
+    for (int i = 0; i < 6; i++) {
+        auto address = resolver.acquire("bucket.tos.example.com", 443, "");
+        used[address]++;
+        acquired.push_back(address);
+    }
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(used.size(), 3);
+    for (const auto& u : used) {
+        EXPECT_EQ(u.second, 2);
+    }
+    for (const auto& address : acquired) {
+        resolver.release("bucket.tos.example.com", 443, address, false, 0);
+    }
+
+    // 空闲时沿用句柄上次的地址以复用连接，更忙时换到空闲地址
+    EXPECT_EQ(resolver.acquire("bucket.tos.example.com", 443, "10.0.0.2"), "10.0.0.2");
+    EXPECT_NE(resolver.acquire("bucket.tos.example.com", 443, "10.0.0.2"), "10.0.0.2");
+    // 不同 host 分别解析
+    resolver.acquire("other.tos.example.com", 443, "");
+    EXPECT_EQ(calls, 2);
+}
+
+TEST_F(HostResolverTest, EjectFailedAddressTest) {
+    MetricsRegistry::instance()->setEnabled(true);
+    MetricsRegistry::instance()->reset();
+    HostResolver resolver(60, fixedAddresses({"10.0.0.1", "10.0.0.2"}));
+    auto bad = resolver.acquire("bucket.tos.example.com", 443, "");
+    resolver.release("bucket.tos.example.com", 443, bad, true, 0);
+    // 剔除后只使用健康地址
+    for (int i = 0; i < 4; i++) {
+        auto address = resolver.acquire("bucket.tos.example.com", 443, bad);
+        EXPECT_NE(address, bad);
+        resolver.release("bucket.tos.example.com", 443, address, false, 2000);
+    }
+    auto stats = resolver.stats("bucket.tos.example.com", 443);
+    ASSERT_EQ(stats.size(), 2);
+    for (const auto& s : stats) {
+        EXPECT_EQ(s.ejected, s.address == bad);
+        EXPECT_EQ(s.outstanding, 0);
+        if (s.address != bad) {
+            EXPECT_EQ(s.connects, 4);
+            EXPECT_EQ(s.avgConnectMicros, 2000);
+        }
+    }
+    auto snapshot = MetricsRegistry::instance()->snapshot();
+    ASSERT_EQ(snapshot.addresses.size(), 2);
+    auto text = PrometheusTextExporter::format(snapshot);
+    EXPECT_NE(text.find("tos_sdk_address_connect_failures_total{host=\"bucket.tos.example.com\",address=\"" + bad +
+                        "\"} 1"),
+              std::string::npos);
+
+    // 全部被剔除时仍返回地址用于探测
+    auto good = bad == "10.0.0.1" ? "10.0.0.2" : "10.0.0.1";
+    resolver.acquire("bucket.tos.example.com", 443, "");
+    resolver.release("bucket.tos.example.com", 443, good, true, 0);
+    EXPECT_EQ(resolver.acquire("bucket.tos.example.com", 443, ""), bad);
+    MetricsRegistry::instance()->setEnabled(false);
+}
+
+TEST_F(HostResolverTest, ResolveFailedTest) {
+    HostResolver resolver(60, fixedAddresses({}));
+    EXPECT_EQ(resolver.acquire("bucket.tos.example.com", 443, ""), "");
+    EXPECT_TRUE(HostResolver::isAddressLiteral("127.0.0.1"));
+    EXPECT_TRUE(HostResolver::isAddressLiteral("[::1]"));
+    EXPECT_FALSE(HostResolver::isAddressLiteral("tos-cn-beijing.volces.com"));
+    EXPECT_FALSE(HostResolver::resolveAll("localhost", 80).empty());
+}
+
+TEST_F(HostResolverTest, ConcurrentFirstResolveTest) {
+    std::atomic<int> calls(0);
+    std::atomic<bool> release(false);
+    HostResolver resolver(60, [&](const std::string&, int) {
+        calls++;
+        while (!release) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return std::vector<std::string>{"10.0.0.1", "10.0.0.2"};
+    });
+    // 首次解析进行中时其他线程等待结果，不重复解析
+    std::vector<std::string> acquired(8);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < acquired.size(); i++) {
+        threads.emplace_back([&, i]() { acquired[i] = resolver.acquire("bucket.tos.example.com", 443, ""); });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    release = true;
+    for (auto& t : threads) {
+        t.join();
+    }
+    EXPECT_EQ(calls, 1);
+    for (const auto& address : acquired) {
+        EXPECT_FALSE(address.empty());
+    }
+}
+}  // namespace VolcengineTos
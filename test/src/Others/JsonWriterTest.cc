@@ -0,0 +1,98 @@
+#include "../TestConfig.h"
+#include "../Utils.h"
+#include "TosClientV2.h"
+#include "json/json.hpp"
+#include "utils/BaseUtils.h"
+#include "utils/JsonWriter.h"
+#include <gtest/gtest.h>
+
+namespace VolcengineTos {
+class JsonWriterTest : public ::testing::Test {
+protected:
+    JsonWriterTest() {
+    }
+
+    ~JsonWriterTest() override {
+    }
+
+    static void SetUpTestCase() {
+    }
+
+    // Tears down the stuff shared by all tests in this test case.
+    static void TearDownTestCase() {
+    }
+};
+
+TEST_F(JsonWriterTest, EscapeTest) {
+    std::string special = "a\"b\\c\b\f\n\r\t\x01\x1f/中文";
+    JsonWriter writer;
+    writer.beginObject();
+    writer.key("Key");
+    writer.value(special);
+    writer.key("List");
+    writer.beginArray();
+    writer.value(int64_t(-1));
+    writer.value(true);
+    writer.null();
+    writer.beginObject();
+    writer.endObject();
+    writer.endArray();
+    writer.endObject();
+
+    nlohmann::json j;
+    j["Key"] = special;
+    j["List"] = nlohmann::json::array({-1, true, nullptr, nlohmann::json::object()});
+    EXPECT_EQ(writer.str(), j.dump());
+}
+
+TEST_F(JsonWriterTest, RequestBodyTest) {
+    // 输出与原先基于 nlohmann::json 的序列化一致
+    std::vector<UploadedPartV2> parts;
+    nlohmann::json jParts = nlohmann::json::array();
+    for (int i = 1; i <= 10000; i++) {
+        std::string etag = "\"" + std::to_string(i * 7919) + "\"";
+        parts.emplace_back(UploadedPartV2(i, etag));
+        nlohmann::json part;
+        part["PartNumber"] = i;
+        part["ETag"] = etag;
+        jParts.push_back(std::move(part));
+    }
+    CompleteMultipartUploadV2Input complete("bucket", "key", "uploadId", parts);
+    nlohmann::json jComplete;
+    jComplete["Parts"] = jParts;
+    EXPECT_EQ(complete.toJsonString(), jComplete.dump());
+    EXPECT_EQ(CompleteMultipartUploadV2Input().toJsonString(), "null");
+
+    DeleteMultiObjectsInput input;
+    input.setQuiet(true);
+    nlohmann::json jObjects = nlohmann::json::array();
+    for (int i = 0; i < 1000; i++) {
+        ObjectTobeDeleted object;
+        object.setKey("dir/key\t" + std::to_string(i));
+        nlohmann::json jObject;
+        jObject["Key"] = object.getKey();
+        if (i % 2 == 0) {
+            object.setVersionId(std::to_string(i));
+            jObject["VersionId"] = object.getVersionId();
+        }
+        input.addObjectTobeDeleted(object);
+        jObjects.push_back(std::move(jObject));
+    }
+    nlohmann::json jDelete;
+    jDelete["Quiet"] = true;
+    jDelete["Objects"] = jObjects;
+    auto expected = jDelete.dump();
+    EXPECT_EQ(input.toJsonString(), expected);
+
+    // 边写边计算的 MD5 与整体计算的一致
+    JsonWriter writer(0, true);
+    writeJson(writer, input);
+    EXPECT_EQ(writer.md5(), CryptoUtils::md5Sum(expected));
+    auto body = writer.release();
+    EXPECT_EQ(*body, expected);
+    writer.reset();
+    writer.beginArray();
+    writer.endArray();
+    EXPECT_EQ(writer.md5(), CryptoUtils::md5Sum("[]"));
+}
+}  // namespace VolcengineTos
@@ -0,0 +1,91 @@
+#include "../TestConfig.h"
+#include "../Utils.h"
+#include "utils/LogUtils.h"
+#include <gtest/gtest.h>
+
+namespace VolcengineTos {
+class LogUtilsTest : public ::testing::Test {
+protected:
+    LogUtilsTest() {
+    }
+
+    ~LogUtilsTest() override {
+    }
+
+    static void SetUpTestCase() {
+    }
+
+    // Tears down the stuff shared by all tests in this test case.
+    static void TearDownTestCase() {
+        LogUtils::ClearCategoryLevel(LogCategoryRequest);
+        LogUtils::ClearCategoryLevel(LogCategoryTransport);
+        LogUtils::SetRequestLogSampling(1, 0);
+        LogUtils::CloseLogger();
+    }
+};
+
+TEST_F(LogUtilsTest, CategoryLevelTest) {
+    LogUtils::SetAsyncLogger("./log/async.log", "tos-log-test", LogLevel::LogInfo);
+    EXPECT_NE(LogUtils::GetLogger(LogCategoryTransfer, LogInfo), nullptr);
+    EXPECT_EQ(LogUtils::GetLogger(LogCategoryTransport, LogDebug), nullptr);
+
+    LogUtils::SetCategoryLevel(LogCategoryTransport, LogDebug);
+    EXPECT_NE(LogUtils::GetLogger(LogCategoryTransport, LogDebug), nullptr);
+    LogUtils::SetCategoryLevel(LogCategoryRequest, LogOff);
+    EXPECT_EQ(LogUtils::GetLogger(LogCategoryRequest, LogInfo), nullptr);
+    LogUtils::SetCategoryLevel(LogCategoryTransport, LogOff);
+    // 清除单独设置的级别后重新沿用全局级别
+    LogUtils::ClearCategoryLevel(LogCategoryRequest);
+    EXPECT_NE(LogUtils::GetLogger(LogCategoryRequest, LogInfo), nullptr);
+    LogUtils::ClearCategoryLevel(LogCategoryTransport);
+    EXPECT_EQ(LogUtils::GetLogger(LogCategoryTransport, LogDebug), nullptr);
+
+    // 重新设置异步日志后，之前取得的 logger 仍可写入
+    auto oldLogger = LogUtils::GetLogger();
+    LogUtils::SetAsyncLogger("./log/async2.log", "tos-log-test", LogLevel::LogInfo, 5242880, 3, 1024);
+    oldLogger->info("written by the previous logger");
+    oldLogger->flush();
+    EXPECT_NE(LogUtils::GetLogger(), oldLogger);
+
+    LogUtils::CloseLogger();
+    EXPECT_EQ(LogUtils::GetLogger(LogCategoryTransfer, LogInfo), nullptr);
+    EXPECT_EQ(LogUtils::GetLogger(), nullptr);
+}
+
+TEST_F(LogUtilsTest, RequestLogSamplingTest) {
+    LogUtils::SetRequestLogSampling(4, 0);
+    int sampled = 0;
+    for (int i = 0; i < 100; i++) {
+        if (LogUtils::SampleRequestLog(LogCategoryRequest)) {
+            sampled++;
+        }
+    }
+    EXPECT_EQ(sampled, 25);
+
+    LogUtils::SetRequestLogSampling(1, 10);
+    sampled = 0;
+    for (int i = 0; i < 100; i++) {
+        if (LogUtils::SampleRequestLog(LogCategoryRequest)) {
+            sampled++;
+        }
+    }
+    EXPECT_LE(sampled, 20);
+    EXPECT_GE(sampled, 10);
+
+    // 同一请求先后采样 transport 与 request 日志，各类按自己的计数采样
+    LogUtils::SetRequestLogSampling(2, 0);
+    int transportSampled = 0;
+    sampled = 0;
+    for (int i = 0; i < 100; i++) {
+        if (LogUtils::SampleRequestLog(LogCategoryTransport)) {
+            transportSampled++;
+        }
+        if (LogUtils::SampleRequestLog(LogCategoryRequest)) {
+            sampled++;
+        }
+    }
+    EXPECT_EQ(transportSampled, 50);
+    EXPECT_EQ(sampled, 50);
+    LogUtils::SetRequestLogSampling(1, 0);
+}
+}  // namespace VolcengineTos
@@ -1,7 +1,10 @@
 #include "../TestConfig.h"
 #include "../Utils.h"
 #include "TosClientV2.h"
+#include "utils/crc64.h"
 #include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
 
 namespace VolcengineTos {
 class Md5Crc64DataVerifyTest : public ::testing::Test {
@@ -194,4 +197,50 @@ TEST_F(Md5Crc64DataVerifyTest, GetObjectCutOffVerifyTest) {
     EXPECT_EQ(output.isSuccess(), true);
 }
 
+TEST_F(Md5Crc64DataVerifyTest, FileCrc64Test) {
+    auto filePath = FileUtils::getTempPath() + TestUtils::GetObjectKey("crc64-file");
+    TestUtils::WriteRandomDatatoFile(filePath, 21 * 1024 * 1024 + 5);
+    std::ifstream ifs(filePath, std::ios::in | std::ios::binary);
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+    auto data = ss.str();
+    auto expected = CRC64::CalcCRC(0, &data[0], data.size());
+
+    uint64_t crc = 0;
+    EXPECT_TRUE(CRC64::CalcFileCRC(filePath, 4, crc));
+    EXPECT_EQ(crc, expected);
+    crc = 0;
+    EXPECT_TRUE(CRC64::CalcStreamCRC(ss.seekg(0), 4, crc));
+    EXPECT_EQ(crc, expected);
+
+    // 各分片的 CRC64 合并后与整个文件一致
+    std::vector<uint64_t> partCRCs;
+    int64_t partSize = 5 * 1024 * 1024;
+    EXPECT_TRUE(CRC64::CalcFilePartCRC(filePath, partSize, 4, partCRCs));
+    ASSERT_EQ(partCRCs.size(), 5);
+    EXPECT_EQ(partCRCs[1], CRC64::CalcCRC(0, &data[partSize], partSize));
+    crc = partCRCs[0];
+    for (size_t i = 1; i < partCRCs.size(); i++) {
+        crc = CRC64::CombineCRC(crc, partCRCs[i], std::min<int64_t>(partSize, data.size() - i * partSize));
+    }
+    EXPECT_EQ(crc, expected);
+
+    // 只计算选中的分片，未选中的分片记为 0
+    std::vector<uint64_t> selectedCRCs;
+    EXPECT_TRUE(CRC64::CalcFilePartCRC(filePath, partSize, 4, {false, true, false, false, true}, selectedCRCs));
+    ASSERT_EQ(selectedCRCs.size(), 5);
+    EXPECT_EQ(selectedCRCs[0], 0);
+    EXPECT_EQ(selectedCRCs[1], partCRCs[1]);
+    EXPECT_EQ(selectedCRCs[3], 0);
+    EXPECT_EQ(selectedCRCs[4], partCRCs[4]);
+
+    std::string objName = TestUtils::GetObjectKey(TestConfig::TestPrefix);
+    auto output = cliV2->putObjectFromFile(PutObjectFromFileInput(bkt_name, objName, filePath));
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(output.result().getPutObjectV2Output().getHashCrc64ecma(), expected);
+
+    std::remove(filePath.c_str());
+    EXPECT_FALSE(CRC64::CalcFileCRC(filePath, 4, crc));
+}
+
 }  // namespace VolcengineTos
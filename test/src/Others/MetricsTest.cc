@@ -0,0 +1,116 @@
+#include "../TestConfig.h"
+#include "../Utils.h"
+#include "metrics/Metrics.h"
+#include <gtest/gtest.h>
+
+namespace VolcengineTos {
+class MetricsTest : public ::testing::Test {
+protected:
+    MetricsTest() {
+    }
+
+    ~MetricsTest() override {
+    }
+
+    static void SetUpTestCase() {
+    }
+
+    // Tears down the stuff shared by all tests in this test case.
+    static void TearDownTestCase() {
+        MetricsRegistry::instance()->reset();
+    }
+};
+
+TEST_F(MetricsTest, HistogramBucketTest) {
+    for (uint64_t v : {0ull, 7ull, 8ull, 9ull, 100ull, 1000ull, 123456ull, 1ull << 40}) {
+        int index = LatencyHistogram::bucketIndex(v);
+        EXPECT_GE(LatencyHistogram::bucketUpperBound(index), v);
+        if (index > 0) {
+            EXPECT_LT(LatencyHistogram::bucketUpperBound(index - 1), v);
+        }
+    }
+
+    LatencyHistogram h;
+    for (uint64_t i = 1; i <= 1000; i++) {
+        h.record(i);
+    }
+    auto s = h.snapshot();
+    EXPECT_EQ(s.count, 1000);
+    EXPECT_EQ(s.sum, 500500);
+    EXPECT_EQ(s.max, 1000);
+    auto p50 = s.percentile(0.5);
+    EXPECT_GE(p50, 500);
+    EXPECT_LE(p50, 500 * 1.125);
+    auto p99 = s.percentile(0.99);
+    EXPECT_GE(p99, 990);
+    EXPECT_LE(p99, 1000);
+}
+
+TEST_F(MetricsTest, PrometheusTextExporterTest) {
+    auto registry = MetricsRegistry::instance();
+    registry->reset();
+    registry->recordLatency("putObject", MetricsPhaseRequest, 1500);
+    registry->recordRequest("putObject", true, 2);
+    registry->recordRequest("putObject", false, 0);
+    registry->recordBytes("putObject", 1024, 0);
+
+    auto exporter = std::make_shared<PrometheusTextExporter>();
+    registry->addExporter(exporter);
+    registry->flush();
+    auto text = exporter->getText();
+    EXPECT_NE(text.find("tos_sdk_request_duration_microseconds_count{operation=\"putObject\",phase=\"request\"} 1"),
+              std::string::npos);
+    EXPECT_NE(text.find("tos_sdk_requests_total{operation=\"putObject\"} 2"), std::string::npos);
+    EXPECT_NE(text.find("tos_sdk_retries_total{operation=\"putObject\"} 2"), std::string::npos);
+    EXPECT_NE(text.find("tos_sdk_errors_total{operation=\"putObject\"} 1"), std::string::npos);
+    EXPECT_NE(text.find("tos_sdk_sent_bytes_total{operation=\"putObject\"} 1024"), std::string::npos);
+    EXPECT_NE(text.find("tos_sdk_connection_pool_in_use"), std::string::npos);
+
+    // 固定的 le 集合，没有记录的区间也输出；le 是 100、1000、2500、60000000 所在内部桶的上界
+    const std::string bucket = "tos_sdk_request_duration_microseconds_bucket{operation=\"putObject\",phase=\"request\",";
+    EXPECT_NE(text.find(bucket + "le=\"103\"} 0"), std::string::npos);
+    EXPECT_NE(text.find(bucket + "le=\"1023\"} 0"), std::string::npos);
+    EXPECT_NE(text.find(bucket + "le=\"2559\"} 1"), std::string::npos);
+    EXPECT_NE(text.find(bucket + "le=\"62914559\"} 1"), std::string::npos);
+    EXPECT_NE(text.find(bucket + "le=\"+Inf\"} 1"), std::string::npos);
+}
+
+TEST_F(MetricsTest, PrometheusCumulativeBucketTest) {
+    auto registry = MetricsRegistry::instance();
+    registry->reset();
+    // 落在 le 上、le 两侧以及超过最大 le 的样本
+    for (uint64_t v : {100ull, 103ull, 104ull, 1000ull, 1023ull, 1024ull, 70000000ull}) {
+        registry->recordLatency("getObject", MetricsPhaseRequest, v);
+    }
+    auto text = PrometheusTextExporter::format(registry->snapshot());
+
+    // 每个 le 的累计计数等于不大于 le 的样本数
+    const std::string bucket = "tos_sdk_request_duration_microseconds_bucket{operation=\"getObject\",phase=\"request\",";
+    std::vector<std::pair<std::string, uint64_t>> expected = {
+            {"103", 2}, {"255", 3}, {"1023", 5}, {"2559", 6}, {"62914559", 6}, {"+Inf", 7}};
+    for (const auto& e : expected) {
+        EXPECT_NE(text.find(bucket + "le=\"" + e.first + "\"} " + std::to_string(e.second) + "\n"), std::string::npos)
+                << e.first;
+    }
+
+    // le 严格递增，累计计数不减
+    uint64_t lastLe = 0, lastCount = 0;
+    size_t pos = 0;
+    int lines = 0;
+    while ((pos = text.find(bucket + "le=\"", pos)) != std::string::npos) {
+        pos += bucket.size() + 4;
+        auto quote = text.find('"', pos);
+        auto le = text.substr(pos, quote - pos);
+        auto count = std::stoull(text.substr(quote + 3, text.find('\n', quote) - quote - 3));
+        EXPECT_GE(count, lastCount);
+        lastCount = count;
+        if (le != "+Inf") {
+            EXPECT_GT(std::stoull(le), lastLe);
+            lastLe = std::stoull(le);
+        }
+        lines++;
+    }
+    EXPECT_EQ(lines, 19);
+    registry->reset();
+}
+}  // namespace VolcengineTos
@@ -0,0 +1,108 @@
+#include "../TestConfig.h"
+#include "../Utils.h"
+#include "TosClientV2.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace VolcengineTos {
+class ObjectAppenderTest : public ::testing::Test {
+protected:
+    ObjectAppenderTest() {
+    }
+
+    ~ObjectAppenderTest() override {
+    }
+
+    static void SetUpTestCase() {
+        ClientConfig conf;
+        conf.endPoint = TestConfig::Endpoint;
+        cliV2 = std::make_shared<TosClientV2>(TestConfig::Region, TestConfig::Ak, TestConfig::Sk, conf);
+        bucketName = TestUtils::GetBucketName(TestConfig::TestPrefix);
+        TestUtils::CreateBucket(cliV2, bucketName);
+    }
+
+    // Tears down the stuff shared by all tests in this test case.
+    static void TearDownTestCase() {
+        TestUtils::CleanBucket(cliV2, bucketName);
+        cliV2 = nullptr;
+    }
+
+public:
+    static std::shared_ptr<TosClientV2> cliV2;
+    static std::string bucketName;
+};
+
+std::shared_ptr<TosClientV2> ObjectAppenderTest::cliV2 = nullptr;
+std::string ObjectAppenderTest::bucketName = "";
+
+TEST(ObjectAppenderOfflineTest, FailedAppenderKeepsDataTest) {
+    ClientConfig conf;
+    conf.endPoint = "http://127.0.0.1:1";
+    conf.maxRetryCount = 0;
+    TosClientV2 client("cn-beijing", "ak", "sk", conf);
+    AppenderOptions options;
+    options.maxRetries = 0;
+    auto appender = client.openAppender(AppendObjectV2Input("test-bucket", "log", nullptr, 0), options);
+    EXPECT_TRUE(appender->append("line 1\n"));
+    EXPECT_TRUE(appender->append("line 2\n"));
+    // 无法连接时提交失败，未提交的数据保留在缓冲区中
+    EXPECT_FALSE(appender->flush());
+    EXPECT_FALSE(appender->append("line 3\n"));
+    EXPECT_FALSE(appender->close());
+    EXPECT_FALSE(appender->error().getMessage().empty());
+    auto stats = appender->stats();
+    EXPECT_EQ(stats.appendedBytes, 14);
+    EXPECT_EQ(stats.committedBytes, 0);
+    EXPECT_EQ(stats.bufferedBytes, 14);
+    EXPECT_EQ(stats.commits, 0);
+}
+
+TEST_F(ObjectAppenderTest, GroupCommitAndRolloverTest) {
+    std::string objectName = TestUtils::GetObjectKey(TestConfig::TestPrefix);
+    AppenderOptions options;
+    options.flushBytes = 16 * 1024;
+    options.flushIntervalMillis = 100;
+    options.maxObjectSize = 64 * 1024;
+    auto appender = cliV2->openAppender(AppendObjectV2Input(bucketName, objectName, nullptr, 0), options);
+
+    std::string line(1000, 'a');
+    line.back() = '\n';
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 50; i++) {
+                EXPECT_TRUE(appender->append(line));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_TRUE(appender->flush());
+    auto stats = appender->stats();
+    EXPECT_EQ(stats.committedBytes, 200 * 1000);
+    EXPECT_EQ(stats.bufferedBytes, 0);
+    // 多条写入合并为一次追加
+    EXPECT_LT(stats.commits, 200);
+    EXPECT_EQ(stats.rollovers, 3);
+    EXPECT_TRUE(appender->close());
+
+    // 每个对象不超过上限且只包含完整的行
+    int64_t total = 0;
+    for (int i = 0; i <= stats.rollovers; i++) {
+        auto key = i == 0 ? objectName : objectName + "." + std::to_string(i);
+        auto output = cliV2->headObject(HeadObjectV2Input(bucketName, key));
+        ASSERT_TRUE(output.isSuccess());
+        EXPECT_LE(output.result().getContentLength(), options.maxObjectSize);
+        EXPECT_EQ(output.result().getContentLength() % 1000, 0);
+        total += output.result().getContentLength();
+    }
+    EXPECT_EQ(total, 200 * 1000);
+
+    // 重新打开时从对象末尾继续追加
+    auto reopened = cliV2->openAppender(AppendObjectV2Input(bucketName, objectName + ".3", nullptr, 0));
+    EXPECT_TRUE(reopened->append(line));
+    EXPECT_TRUE(reopened->close());
+    EXPECT_EQ(reopened->stats().nextOffset, stats.nextOffset + 1000);
+}
+}  // namespace VolcengineTos
@@ -0,0 +1,280 @@
+#include "../TestConfig.h"
+#include "../Utils.h"
+#include "cache/ObjectCache.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace VolcengineTos {
+class ObjectCacheTest : public ::testing::Test {
+protected:
+    ObjectCacheTest() {
+    }
+
+    ~ObjectCacheTest() override {
+    }
+
+    static void SetUpTestCase() {
+    }
+
+    // Tears down the stuff shared by all tests in this test case.
+    static void TearDownTestCase() {
+    }
+};
+
+static CachedObjectMeta buildMeta(const std::string& etag, int64_t size) {
+    CachedObjectMeta meta;
+    meta.etag = etag;
+    meta.size = size;
+    return meta;
+}
+
+static std::string buildData(int64_t size) {
+    std::string data(static_cast<size_t>(size), '\0');
+    for (int64_t i = 0; i < size; i++) {
+        data[i] = static_cast<char>('a' + i % 26);
+    }
+    return data;
+}
+
+TEST_F(ObjectCacheTest, MemoryPutAndReadTest) {
+    ObjectCacheOptions options;
+    options.blockSize = 10;
+    ObjectCache cache(options);
+    auto key = ObjectCache::CacheKey("bucket", "key", "");
+    auto data = buildData(25);
+    cache.put(key, buildMeta("etag", 25), 0, data, cache.epoch(key));
+
+    std::string out;
+    EXPECT_TRUE(cache.read(key, 0, 24, out));
+    EXPECT_EQ(out, data);
+    EXPECT_TRUE(cache.read(key, 7, 21, out));
+    EXPECT_EQ(out, data.substr(7, 15));
+
+    CachedObjectMeta meta;
+    bool fresh = true;
+    EXPECT_TRUE(cache.getMeta(key, meta, fresh));
+    EXPECT_EQ(meta.etag, "etag");
+    EXPECT_EQ(meta.size, 25);
+    // ttl 为 0 时每次都需要重新校验
+    EXPECT_FALSE(fresh);
+    EXPECT_EQ(cache.stats().memoryBytes, 25);
+    EXPECT_FALSE(cache.getMeta(ObjectCache::CacheKey("bucket", "key", "v1"), meta, fresh));
+}
+
+TEST_F(ObjectCacheTest, RangeBlockTest) {
+    ObjectCacheOptions options;
+    options.blockSize = 10;
+    ObjectCache cache(options);
+    auto key = ObjectCache::CacheKey("bucket", "key", "");
+    auto data = buildData(45);
+    auto meta = buildMeta("etag", 45);
+    // 未对齐的开头和不完整的中间块都不会缓存
+    cache.put(key, meta, 5, data.substr(5, 20), cache.epoch(key));
+
+    int64_t first = 0, last = 0;
+    EXPECT_TRUE(cache.missingBlocks(key, 0, 44, first, last));
+    EXPECT_EQ(first, 0);
+    EXPECT_EQ(last, 4);
+    EXPECT_FALSE(cache.missingBlocks(key, 10, 19, first, last));
+    std::string out;
+    EXPECT_TRUE(cache.read(key, 12, 18, out));
+    EXPECT_EQ(out, data.substr(12, 7));
+    EXPECT_FALSE(cache.read(key, 12, 20, out));
+
+    // 对象的最后一块不足 blockSize 也会缓存
+    cache.put(key, meta, 40, data.substr(40), cache.epoch(key));
+    EXPECT_TRUE(cache.missingBlocks(key, 10, 44, first, last));
+    EXPECT_EQ(first, 2);
+    EXPECT_EQ(last, 3);
+    cache.put(key, meta, 20, data.substr(20, 20), cache.epoch(key));
+    EXPECT_FALSE(cache.missingBlocks(key, 10, 44, first, last));
+    EXPECT_TRUE(cache.read(key, 10, 44, out));
+    EXPECT_EQ(out, data.substr(10));
+}
+
+TEST_F(ObjectCacheTest, LruEvictionTest) {
+    ObjectCacheOptions options;
+    options.blockSize = 10;
+    options.memoryCapacity = 30;
+    ObjectCache cache(options);
+    auto data = buildData(10);
+    auto key1 = ObjectCache::CacheKey("bucket", "key1", "");
+    auto key2 = ObjectCache::CacheKey("bucket", "key2", "");
+    auto key3 = ObjectCache::CacheKey("bucket", "key3", "");
+    auto key4 = ObjectCache::CacheKey("bucket", "key4", "");
+    cache.put(key1, buildMeta("e1", 10), 0, data, cache.epoch(key1));
+    cache.put(key2, buildMeta("e2", 10), 0, data, cache.epoch(key2));
+    cache.put(key3, buildMeta("e3", 10), 0, data, cache.epoch(key3));
+    std::string out;
+    // 访问 key1 后 key2 成为最久未使用
+    EXPECT_TRUE(cache.read(key1, 0, 9, out));
+    cache.put(key4, buildMeta("e4", 10), 0, data, cache.epoch(key4));
+
+    CachedObjectMeta meta;
+    bool fresh = false;
+    EXPECT_TRUE(cache.getMeta(key1, meta, fresh));
+    EXPECT_FALSE(cache.getMeta(key2, meta, fresh));
+    EXPECT_TRUE(cache.getMeta(key3, meta, fresh));
+    EXPECT_TRUE(cache.getMeta(key4, meta, fresh));
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.evictions, 1);
+    EXPECT_EQ(stats.memoryBytes, 30);
+    EXPECT_EQ(stats.entries, 3);
+}
+
+TEST_F(ObjectCacheTest, DiskTierTest) {
+    ObjectCacheOptions options;
+    options.blockSize = 16;
+    options.memoryObjectLimit = 32;
+    options.diskPath = "./object_cache_test_dir";
+    options.diskCapacity = 64;
+    auto key = ObjectCache::CacheKey("bucket", "big", "");
+    auto data = buildData(50);
+    {
+        ObjectCache cache(options);
+        EXPECT_TRUE(cache.admits(50));
+        cache.put(key, buildMeta("etag", 50), 0, data, cache.epoch(key));
+        auto stats = cache.stats();
+        EXPECT_EQ(stats.memoryBytes, 0);
+        EXPECT_EQ(stats.diskBytes, 50);
+        std::string out;
+        EXPECT_TRUE(cache.read(key, 3, 49, out));
+        EXPECT_EQ(out, data.substr(3));
+
+        // 超出磁盘容量时淘汰最久未使用的块
+        auto other = ObjectCache::CacheKey("bucket", "other", "");
+        cache.put(other, buildMeta("etag", 40), 0, buildData(40), cache.epoch(other));
+        stats = cache.stats();
+        EXPECT_LE(stats.diskBytes, 64);
+        EXPECT_GT(stats.evictions, 0);
+        EXPECT_FALSE(cache.read(key, 0, 49, out));
+        EXPECT_TRUE(cache.read(other, 0, 39, out));
+        EXPECT_EQ(out, buildData(40));
+    }
+    options.diskPath = "";
+    ObjectCache noDisk(options);
+    EXPECT_FALSE(noDisk.admits(50));
+    noDisk.put(key, buildMeta("etag", 50), 0, data, noDisk.epoch(key));
+    EXPECT_EQ(noDisk.stats().entries, 0);
+}
+
+TEST_F(ObjectCacheTest, InvalidateTest) {
+    ObjectCacheOptions options;
+    options.blockSize = 10;
+    ObjectCache cache(options);
+    auto data = buildData(10);
+    auto key = ObjectCache::CacheKey("bucket", "key", "");
+    auto version = ObjectCache::CacheKey("bucket", "key", "v1");
+    auto sibling = ObjectCache::CacheKey("bucket", "key2", "");
+    cache.put(key, buildMeta("e1", 10), 0, data, cache.epoch(key));
+    cache.put(version, buildMeta("e1", 10), 0, data, cache.epoch(version));
+    cache.put(sibling, buildMeta("e1", 10), 0, data, cache.epoch(sibling));
+
+    // etag 变化时丢弃旧的块
+    auto newData = buildData(20);
+    cache.put(key, buildMeta("e2", 20), 0, newData.substr(0, 10), cache.epoch(key));
+    int64_t first = 0, last = 0;
+    EXPECT_TRUE(cache.missingBlocks(key, 0, 19, first, last));
+    EXPECT_EQ(first, 1);
+    CachedObjectMeta meta;
+    bool fresh = false;
+    EXPECT_TRUE(cache.getMeta(key, meta, fresh));
+    EXPECT_EQ(meta.etag, "e2");
+
+    // 失效对象的所有版本，不影响前缀相同的其他对象
+    cache.invalidateObject("bucket", "key");
+    EXPECT_FALSE(cache.getMeta(key, meta, fresh));
+    EXPECT_FALSE(cache.getMeta(version, meta, fresh));
+    EXPECT_TRUE(cache.getMeta(sibling, meta, fresh));
+    EXPECT_EQ(cache.stats().invalidations, 2);
+    cache.clear();
+    EXPECT_EQ(cache.stats().entries, 0);
+    EXPECT_EQ(cache.stats().memoryBytes, 0);
+}
+
+TEST_F(ObjectCacheTest, WriteEpochTest) {
+    ObjectCacheOptions options;
+    options.blockSize = 10;
+    options.memoryObjectLimit = 20;
+    ObjectCache cache(options);
+    auto data = buildData(10);
+    auto key = ObjectCache::CacheKey("bucket", "key", "v1");
+    auto sibling = ObjectCache::CacheKey("bucket", "key2", "");
+
+    // 读取开始后对象被本 client 写过，写之前读到的数据不放入缓存
+    auto epoch = cache.epoch(key);
+    auto siblingEpoch = cache.epoch(sibling);
+    cache.invalidateObject("bucket", "key");
+    cache.put(key, buildMeta("e1", 10), 0, data, epoch);
+    CachedObjectMeta meta;
+    bool fresh = false;
+    EXPECT_FALSE(cache.getMeta(key, meta, fresh));
+    cache.put(key, buildMeta("e1", 10), 0, data, cache.epoch(key));
+    EXPECT_TRUE(cache.getMeta(key, meta, fresh));
+    cache.put(sibling, buildMeta("e1", 10), 0, data, siblingEpoch);
+    EXPECT_TRUE(cache.getMeta(sibling, meta, fresh));
+
+    // 超出上限的对象记录下来，对象失效后清除
+    EXPECT_FALSE(cache.admits(30));
+    cache.markUncacheable(key);
+    EXPECT_TRUE(cache.uncacheable(key));
+    EXPECT_FALSE(cache.uncacheable(sibling));
+    cache.invalidateObject("bucket", "key");
+    EXPECT_FALSE(cache.uncacheable(key));
+}
+
+TEST_F(ObjectCacheTest, TtlAndEmptyObjectTest) {
+    ObjectCacheOptions options;
+    options.ttl = 60;
+    ObjectCache cache(options);
+    auto key = ObjectCache::CacheKey("bucket", "empty", "");
+    cache.put(key, buildMeta("etag", 0), 0, "", cache.epoch(key));
+    CachedObjectMeta meta;
+    bool fresh = false;
+    EXPECT_TRUE(cache.getMeta(key, meta, fresh));
+    EXPECT_TRUE(fresh);
+    std::string out = "x";
+    EXPECT_TRUE(cache.read(key, 0, -1, out));
+    EXPECT_TRUE(out.empty());
+}
+
+TEST_F(ObjectCacheTest, ConcurrentAccessTest) {
+    ObjectCacheOptions options;
+    options.blockSize = 64;
+    options.memoryCapacity = 64 * 20;
+    options.memoryObjectLimit = 64;
+    options.diskPath = "./object_cache_test_dir";
+    options.diskCapacity = 256 * 10;
+    ObjectCache cache(options);
+    std::atomic<int> mismatch(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([&cache, &mismatch, t]() {
+            for (int i = 0; i < 2000; i++) {
+                int64_t size = (i + t) % 2 == 0 ? 64 : 256;
+                auto key = ObjectCache::CacheKey("bucket", "key-" + std::to_string(i % 50) + "-" + std::to_string(size),
+                                                 "");
+                auto data = buildData(size);
+                std::string out;
+                if (cache.read(key, 0, size - 1, out)) {
+                    if (out != data) {
+                        mismatch++;
+                    }
+                } else {
+                    cache.put(key, buildMeta("etag", size), 0, data, cache.epoch(key));
+                }
+                if (i % 97 == 0) {
+                    cache.invalidate(key);
+                }
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    EXPECT_EQ(mismatch, 0);
+    auto stats = cache.stats();
+    EXPECT_LE(stats.memoryBytes, 64 * 20);
+    EXPECT_LE(stats.diskBytes, 256 * 10);
+}
+}  // namespace VolcengineTos
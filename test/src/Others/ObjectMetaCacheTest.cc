@@ -0,0 +1,181 @@
+#include "../TestConfig.h"
+#include "../Utils.h"
+#include "cache/ObjectCache.h"
+#include "cache/ObjectMetaCache.h"
+#include "cache/SingleFlight.h"
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+
+namespace VolcengineTos {
+class ObjectMetaCacheTest : public ::testing::Test {
+protected:
+    ObjectMetaCacheTest() {
+    }
+
+    ~ObjectMetaCacheTest() override {
+    }
+
+    static void SetUpTestCase() {
+    }
+
+    // Tears down the stuff shared by all tests in this test case.
+    static void TearDownTestCase() {
+    }
+};
+
+static Outcome<TosError, HeadObjectV2Output> buildHeadResult(const std::string& etag) {
+    HeadObjectV2Output output;
+    output.setETags(etag);
+    Outcome<TosError, HeadObjectV2Output> res;
+    res.setSuccess(true);
+    res.setR(std::move(output));
+    return res;
+}
+
+static Outcome<TosError, HeadObjectV2Output> buildHeadError(int statusCode) {
+    TosError error;
+    error.setStatusCode(statusCode);
+    Outcome<TosError, HeadObjectV2Output> res(error);
+    return res;
+}
+
+TEST_F(ObjectMetaCacheTest, PutAndGetTest) {
+    ObjectMetaCache cache(ObjectMetaCacheOptions{});
+    auto key = ObjectCache::CacheKey("bucket", "key", "");
+    Outcome<TosError, HeadObjectV2Output> res;
+    EXPECT_FALSE(cache.get(key, res));
+    cache.put(key, buildHeadResult("etag"), cache.epoch());
+    EXPECT_TRUE(cache.get(key, res));
+    EXPECT_TRUE(res.isSuccess());
+    EXPECT_EQ(res.result().getETags(), "etag");
+
+    // 404 按 negativeTtl 缓存，其他错误不缓存
+    auto missing = ObjectCache::CacheKey("bucket", "missing", "");
+    cache.put(missing, buildHeadError(404), cache.epoch());
+    EXPECT_TRUE(cache.get(missing, res));
+    EXPECT_FALSE(res.isSuccess());
+    EXPECT_EQ(res.error().getStatusCode(), 404);
+    auto failed = ObjectCache::CacheKey("bucket", "failed", "");
+    cache.put(failed, buildHeadError(503), cache.epoch());
+    EXPECT_FALSE(cache.get(failed, res));
+
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.negativeHits, 1);
+    EXPECT_EQ(stats.misses, 2);
+    EXPECT_EQ(stats.entries, 2);
+}
+
+TEST_F(ObjectMetaCacheTest, TtlTest) {
+    ObjectMetaCacheOptions options;
+    options.ttl = 1;
+    options.negativeTtl = 0;
+    ObjectMetaCache cache(options);
+    auto key = ObjectCache::CacheKey("bucket", "key", "");
+    auto missing = ObjectCache::CacheKey("bucket", "missing", "");
+    cache.put(key, buildHeadResult("etag"), cache.epoch());
+    cache.put(missing, buildHeadError(404), cache.epoch());
+    Outcome<TosError, HeadObjectV2Output> res;
+    EXPECT_TRUE(cache.get(key, res));
+    EXPECT_FALSE(cache.get(missing, res));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    EXPECT_FALSE(cache.get(key, res));
+    EXPECT_EQ(cache.stats().entries, 0);
+}
+
+TEST_F(ObjectMetaCacheTest, InvalidateAndEpochTest) {
+    ObjectMetaCacheOptions options;
+    options.maxEntries = 2;
+    ObjectMetaCache cache(options);
+    auto key = ObjectCache::CacheKey("bucket", "key", "");
+    auto version = ObjectCache::CacheKey("bucket", "key", "v1");
+    auto other = ObjectCache::CacheKey("bucket", "other", "");
+    cache.put(key, buildHeadResult("e1"), cache.epoch());
+    cache.put(version, buildHeadResult("e2"), cache.epoch());
+    Outcome<TosError, HeadObjectV2Output> res;
+    EXPECT_TRUE(cache.get(key, res));
+    // 超过 maxEntries 时淘汰最久未使用的 version
+    cache.put(other, buildHeadResult("e3"), cache.epoch());
+    EXPECT_FALSE(cache.get(version, res));
+    EXPECT_TRUE(cache.get(other, res));
+
+    // 请求期间发生写操作，返回的结果不缓存
+    auto epoch = cache.epoch();
+    cache.invalidateObject("bucket", "key");
+    EXPECT_FALSE(cache.get(key, res));
+    cache.put(key, buildHeadResult("stale"), epoch);
+    EXPECT_FALSE(cache.get(key, res));
+    EXPECT_TRUE(cache.get(other, res));
+    EXPECT_EQ(cache.stats().invalidations, 1);
+}
+
+TEST_F(ObjectMetaCacheTest, SingleFlightTest) {
+    SingleFlight<int> flight;
+    std::atomic<int> calls(0);
+    std::atomic<bool> release(false);
+    std::vector<std::thread> threads;
+    std::vector<int> results(8, 0);
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([&, t]() {
+            results[t] = flight.run("key", [&]() {
+                calls++;
+                while (!release) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                return 42;
+            });
+        });
+    }
+    // 等所有线程都加入同一次调用
+    while (flight.shared() < 7) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    release = true;
+    for (auto& th : threads) {
+        th.join();
+    }
+    EXPECT_EQ(calls, 1);
+    for (auto r : results) {
+        EXPECT_EQ(r, 42);
+    }
+    // 调用结束后不再共享结果
+    EXPECT_EQ(flight.run("key", []() { return 7; }), 7);
+    EXPECT_EQ(flight.run("other", []() { return 8; }), 8);
+    EXPECT_EQ(flight.shared(), 7);
+}
+
+TEST_F(ObjectMetaCacheTest, SingleFlightExceptionTest) {
+    SingleFlight<int> flight;
+    std::atomic<bool> release(false);
+    std::atomic<int> failed(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&]() {
+            try {
+                flight.run("key", [&]() -> int {
+                    while (!release) {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                    }
+                    throw std::runtime_error("fn failed");
+                });
+            } catch (const std::runtime_error& e) {
+                if (std::string(e.what()) == "fn failed") {
+                    failed++;
+                }
+            }
+        });
+    }
+    while (flight.shared() < 3) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    release = true;
+    for (auto& th : threads) {
+        th.join();
+    }
+    // 执行者和等待者都拿到原始异常
+    EXPECT_EQ(failed, 4);
+    // 异常后 key 已移除，后续调用重新执行
+    EXPECT_EQ(flight.run("key", []() { return 7; }), 7);
+}
+}  // namespace VolcengineTos
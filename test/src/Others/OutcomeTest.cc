@@ -0,0 +1,86 @@
+#include "../TestConfig.h"
+#include "../Utils.h"
+#include "TosClientV2.h"
+#include <gtest/gtest.h>
+
+namespace VolcengineTos {
+class OutcomeTest : public ::testing::Test {
+protected:
+    OutcomeTest() {
+    }
+
+    ~OutcomeTest() override {
+    }
+
+    static void SetUpTestCase() {
+    }
+
+    // Tears down the stuff shared by all tests in this test case.
+    static void TearDownTestCase() {
+    }
+};
+
+static ListObjectsType2Output buildOutput(int keys) {
+    ListObjectsType2Output output;
+    std::vector<ListedObjectV2> contents(keys);
+    for (int i = 0; i < keys; i++) {
+        contents[i].setKey("prefix/object-key-" + std::to_string(i));
+    }
+    output.setContents(std::move(contents));
+    return output;
+}
+
+TEST_F(OutcomeTest, MoveResultTest) {
+    auto output = buildOutput(100);
+    const auto* data = output.getContents().data();
+
+    Outcome<TosError, ListObjectsType2Output> res;
+    res.setSuccess(true);
+    res.setR(std::move(output));
+    // setR 移动后不会重新分配 contents
+    EXPECT_EQ(res.result().getContents().data(), data);
+    EXPECT_EQ(res.result().getContents().size(), 100);
+
+    Outcome<TosError, ListObjectsType2Output> moved(std::move(res));
+    EXPECT_TRUE(moved.isSuccess());
+    EXPECT_EQ(moved.result().getContents().data(), data);
+
+    Outcome<TosError, ListObjectsType2Output> assigned;
+    assigned = std::move(moved);
+    EXPECT_TRUE(assigned.isSuccess());
+    EXPECT_EQ(assigned.result().getContents().data(), data);
+    EXPECT_EQ(assigned.result().getContents()[99].getKey(), "prefix/object-key-99");
+
+    // 拷贝语义保持不变
+    Outcome<TosError, ListObjectsType2Output> copied(assigned);
+    EXPECT_NE(copied.result().getContents().data(), data);
+    EXPECT_EQ(copied.result().getContents().size(), 100);
+    EXPECT_EQ(assigned.result().getContents().size(), 100);
+}
+
+TEST_F(OutcomeTest, MoveErrorTest) {
+    TosError error;
+    error.setMessage("some error message that is long enough to allocate");
+    Outcome<TosError, ListObjectsType2Output> res(error);
+    EXPECT_FALSE(res.isSuccess());
+    Outcome<TosError, ListObjectsType2Output> moved(std::move(res));
+    EXPECT_FALSE(moved.isSuccess());
+    EXPECT_EQ(moved.error().getMessage(), error.getMessage());
+}
+
+TEST_F(OutcomeTest, NoexceptMoveTest) {
+    typedef Outcome<TosError, ListObjectsType2Output> ListOutcome;
+    EXPECT_TRUE(std::is_nothrow_move_constructible<ListOutcome>::value);
+    EXPECT_TRUE(std::is_nothrow_move_assignable<ListOutcome>::value);
+
+    // vector 扩容时移动已有元素，contents 不会被拷贝
+    std::vector<ListOutcome> results;
+    results.reserve(1);
+    results.emplace_back(buildOutput(10));
+    const auto* data = results[0].result().getContents().data();
+    for (int i = 0; i < 8; i++) {
+        results.emplace_back(buildOutput(1));
+    }
+    EXPECT_EQ(results[0].result().getContents().data(), data);
+}
+}  // namespace VolcengineTos
@@ -0,0 +1,90 @@
+#include "../TestConfig.h"
+#include "../Utils.h"
+#include "metrics/Metrics.h"
+#include "transfer/PartRetryQueue.h"
+#include <gtest/gtest.h>
+
+namespace VolcengineTos {
+class PartRetryQueueTest : public ::testing::Test {
+protected:
+    PartRetryQueueTest() {
+    }
+
+    ~PartRetryQueueTest() override {
+    }
+
+    static void SetUpTestCase() {
+    }
+
+    // Tears down the stuff shared by all tests in this test case.
+    static void TearDownTestCase() {
+    }
+};
+
+TEST_F(PartRetryQueueTest, RetryBudgetTest) {
+    MetricsRegistry::instance()->setEnabled(true);
+    MetricsRegistry::instance()->reset();
+    PartRetryOptions options;
+    options.maxRetries = 2;
+    options.backoffMillis = 20;
+    PartRetryQueue<int> queue({1, 2}, options);
+    PartRetryQueue<int>::Entry entry;
+    ASSERT_TRUE(queue.pop(entry));
+    EXPECT_EQ(entry.part, 1);
+    EXPECT_EQ(entry.retries, 0);
+    EXPECT_FALSE(queue.freshConnection(entry));
+
+    // 不可恢复的错误不重试
+    EXPECT_FALSE(queue.retry(entry, 404));
+    EXPECT_FALSE(queue.retry(entry, 400));
+    // 重新排队的分片排在尚未开始的分片之后
+    EXPECT_TRUE(queue.retry(entry, 503));
+    ASSERT_TRUE(queue.pop(entry));
+    EXPECT_EQ(entry.part, 2);
+    ASSERT_TRUE(queue.pop(entry));
+    EXPECT_EQ(entry.part, 1);
+    EXPECT_EQ(entry.retries, 1);
+    EXPECT_TRUE(queue.freshConnection(entry));
+    EXPECT_TRUE(queue.Wait(entry, [] { return false; }));
+    EXPECT_GE(std::chrono::steady_clock::now(), entry.notBefore);
+
+    // 连接失败可以重试，用尽重试次数后不再重新排队
+    EXPECT_TRUE(queue.retry(entry, -1));
+    ASSERT_TRUE(queue.pop(entry));
+    EXPECT_EQ(entry.retries, 2);
+    EXPECT_FALSE(queue.retry(entry, 500));
+    EXPECT_FALSE(queue.pop(entry));
+    EXPECT_TRUE(queue.empty());
+
+    auto text = PrometheusTextExporter::format(MetricsRegistry::instance()->snapshot());
+    EXPECT_NE(text.find("tos_sdk_part_retries_total 2"), std::string::npos);
+    MetricsRegistry::instance()->setEnabled(false);
+}
+
+TEST_F(PartRetryQueueTest, BackoffTest) {
+    PartRetryOptions options;
+    options.backoffMillis = 1000;
+    options.maxBackoffMillis = 5000;
+    PartRetryQueue<int> queue({}, options);
+    EXPECT_EQ(queue.backoff(1), 1000);
+    EXPECT_EQ(queue.backoff(2), 2000);
+    EXPECT_EQ(queue.backoff(3), 4000);
+    EXPECT_EQ(queue.backoff(4), 5000);
+    EXPECT_EQ(queue.backoff(30), 5000);
+
+    // 退避期间停止时提前返回
+    PartRetryQueue<int>::Entry entry;
+    entry.notBefore = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(queue.Wait(entry, [] { return true; }));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+
+    // 立即重传的分片排在队首，不计入重试次数
+    PartRetryQueue<int> restart({1, 2}, options);
+    ASSERT_TRUE(restart.pop(entry));
+    restart.pushFront(entry);
+    ASSERT_TRUE(restart.pop(entry));
+    EXPECT_EQ(entry.part, 1);
+    EXPECT_EQ(entry.retries, 0);
+}
+}  // namespace VolcengineTos
@@ -2,6 +2,14 @@
 #include "../Utils.h"
 #include "TosClientV2.h"
 #include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <atomic>
+#include <fstream>
+#include <netinet/in.h>
+#include <sstream>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
 
 namespace VolcengineTos {
 class RetryTest : public ::testing::Test {
@@ -225,4 +233,90 @@ TEST_F(RetryTest, RetryUploadPartTest) {
     EXPECT_EQ(ss->tellg() == 1, true);
 }
 
+// 本地服务，按顺序为每个连接发送一个预设的响应后关闭连接，响应用完后不再接受连接
+class ScriptedServer {
+public:
+    explicit ScriptedServer(std::vector<std::string> responses) : responses_(std::move(responses)) {
+        fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        listen(fd_, 4);
+        socklen_t len = sizeof(addr);
+        getsockname(fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+        thread_ = std::thread([this]() {
+            for (const auto& response : responses_) {
+                int conn = accept(fd_, nullptr, nullptr);
+                if (conn < 0) {
+                    return;
+                }
+                // 读完请求头
+                std::string request;
+                char buf[4096];
+                while (request.find("\r\n\r\n") == std::string::npos) {
+                    auto n = recv(conn, buf, sizeof(buf), 0);
+                    if (n <= 0) {
+                        break;
+                    }
+                    request.append(buf, n);
+                }
+                send(conn, response.data(), response.size(), 0);
+                accepted_++;
+                // 先关闭写端，等客户端读完已发送的数据后再关闭连接，避免未读数据被 RST 丢弃
+                shutdown(conn, SHUT_WR);
+                while (recv(conn, buf, sizeof(buf), 0) > 0) {
+                }
+                close(conn);
+            }
+        });
+    }
+    ~ScriptedServer() {
+        shutdown(fd_, SHUT_RDWR);
+        close(fd_);
+        thread_.join();
+    }
+    int port() const {
+        return port_;
+    }
+    int accepted() const {
+        return accepted_;
+    }
+
+private:
+    std::vector<std::string> responses_;
+    int fd_;
+    int port_;
+    std::atomic<int> accepted_{0};
+    std::thread thread_;
+};
+
+TEST_F(RetryTest, RetryGetObjectToFileRewritesFromStartTest) {
+    std::string body = "0123456789abcdefghij";
+    std::string header = "HTTP/1.1 200 OK\r\nContent-Length: 20\r\nETag: \"etag\"\r\nConnection: close\r\n\r\n";
+    // 第一次返回 503，第二次在响应体中途断开，第三次返回完整的数据
+    ScriptedServer server({"HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\nConnection: close\r\n\r\n",
+                           header + body.substr(0, 10), header + body});
+    ClientConfig conf;
+    conf.endPoint = "http://tos-retry.local";
+    conf.proxyHost = "127.0.0.1";
+    conf.proxyPort = server.port();
+    conf.maxRetryCount = 3;
+    conf.parallelGetThreshold = 0;
+    TosClientV2 client("cn-beijing", "ak", "sk", conf);
+
+    auto filePath = FileUtils::getTempPath() + TestUtils::GetObjectKey("retry-get");
+    auto output = client.getObjectToFile(GetObjectToFileInput("bucket", "key", filePath));
+    ASSERT_TRUE(output.isSuccess()) << output.error().String();
+    EXPECT_EQ(server.accepted(), 3);
+    // 重试从文件的起始位置重新写入，不会追加在上一次写入的部分数据之后
+    std::ifstream ifs(filePath, std::ios::in | std::ios::binary);
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+    EXPECT_EQ(ss.str(), body);
+    ifs.close();
+    remove(filePath.c_str());
+}
+
 }  // namespace VolcengineTos
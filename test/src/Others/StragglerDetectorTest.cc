@@ -0,0 +1,180 @@
+#include "../TestConfig.h"
+#include "../Utils.h"
+#include "metrics/Metrics.h"
+#include "transfer/StragglerDetector.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace VolcengineTos {
+class StragglerDetectorTest : public ::testing::Test {
+protected:
+    StragglerDetectorTest() {
+    }
+
+    ~StragglerDetectorTest() override {
+    }
+
+    static void SetUpTestCase() {
+    }
+
+    // Tears down the stuff shared by all tests in this test case.
+    static void TearDownTestCase() {
+    }
+};
+
+static StragglerOptions testOptions() {
+    StragglerOptions options;
+    options.minElapsedMillis = 50;
+    options.checkIntervalMillis = 0;
+    return options;
+}
+
+static void reportProgress(const std::shared_ptr<StragglerAttempt>& attempt, int64_t consumed, int64_t total,
+                           int64_t once) {
+    auto status = std::make_shared<DataTransferStatus>(DataTransferStatus{consumed, total, once, 2, nullptr});
+    status->userData_ = attempt->listener.userData_;
+    attempt->listener.dataTransferStatusChange_(status);
+}
+
+TEST_F(StragglerDetectorTest, RestartSlowPartTest) {
+    MetricsRegistry::instance()->setEnabled(true);
+    MetricsRegistry::instance()->reset();
+    StragglerDetector detector(testOptions(), {nullptr, nullptr});
+    std::vector<std::shared_ptr<StragglerAttempt>> attempts;
+    for (int i = 1; i <= 4; i++) {
+        attempts.push_back(detector.begin(i, 1000000));
+        attempts.back()->monitor->start();
+    }
+    // 未设置整个传输的进度回调时不转发进度
+    EXPECT_EQ(attempts[0]->listener.dataTransferStatusChange_, nullptr);
+    // 进行时间不足时不判断
+    detector.check();
+    EXPECT_EQ(detector.restarts(), 0);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    for (int i = 0; i < 3; i++) {
+        attempts[i]->monitor->update(500000);
+    }
+    attempts[3]->monitor->update(1000);
+    detector.check();
+    EXPECT_EQ(detector.restarts(), 1);
+    EXPECT_FALSE(attempts[0]->monitor->aborted());
+    EXPECT_TRUE(attempts[3]->monitor->aborted());
+    EXPECT_EQ(detector.finish(attempts[3], false), StragglerDetector::PartRestart);
+
+    // 重启后的请求正常完成
+    auto retry = detector.begin(4, 1000000);
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(detector.finish(attempts[i], true), StragglerDetector::PartSucceed);
+    }
+    EXPECT_TRUE(detector.busy());
+    EXPECT_EQ(detector.finish(retry, true), StragglerDetector::PartSucceed);
+    EXPECT_FALSE(detector.busy());
+
+    // 非落后导致的失败直接报告
+    auto failed = detector.begin(5, 1000000);
+    EXPECT_EQ(detector.finish(failed, false), StragglerDetector::PartFailed);
+
+    auto text = PrometheusTextExporter::format(MetricsRegistry::instance()->snapshot());
+    EXPECT_NE(text.find("tos_sdk_straggler_restarts_total 1"), std::string::npos);
+    MetricsRegistry::instance()->setEnabled(false);
+}
+
+TEST_F(StragglerDetectorTest, DuplicateTailTest) {
+    StragglerDetector detector(testOptions(), {nullptr, nullptr});
+    auto fast = detector.begin(1, 1000);
+    fast->monitor->start();
+    // 没有已完成的分片时无法估计
+    EXPECT_EQ(detector.beginDuplicate(), nullptr);
+    EXPECT_EQ(detector.finish(fast, true), StragglerDetector::PartSucceed);
+
+    auto slow = detector.begin(2, 100000000);
+    slow->monitor->start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    slow->monitor->update(10);
+    auto duplicate = detector.beginDuplicate();
+    ASSERT_NE(duplicate, nullptr);
+    EXPECT_EQ(duplicate->partNumber, 2);
+    EXPECT_TRUE(duplicate->duplicate);
+    EXPECT_EQ(detector.duplicates(), 1);
+    // 每个分片最多一个重复请求
+    EXPECT_EQ(detector.beginDuplicate(), nullptr);
+
+    // 先完成者生效，中止另一个请求
+    EXPECT_EQ(detector.finish(duplicate, true), StragglerDetector::PartSucceed);
+    EXPECT_TRUE(slow->monitor->aborted());
+    EXPECT_EQ(detector.finish(slow, false), StragglerDetector::PartSuperseded);
+    EXPECT_FALSE(detector.busy());
+
+    // 重复请求失败时由原请求继续
+    auto primary = detector.begin(3, 100000000);
+    primary->monitor->start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    auto backup = detector.beginDuplicate();
+    ASSERT_NE(backup, nullptr);
+    EXPECT_EQ(detector.finish(backup, false), StragglerDetector::PartSuperseded);
+    EXPECT_FALSE(primary->monitor->aborted());
+    EXPECT_EQ(detector.finish(primary, true), StragglerDetector::PartSucceed);
+
+    // 关闭重复请求
+    auto options = testOptions();
+    options.duplicateTail = false;
+    StragglerDetector noDuplicate(options, {nullptr, nullptr});
+    auto done = noDuplicate.begin(1, 1000);
+    done->monitor->start();
+    noDuplicate.finish(done, true);
+    auto stalled = noDuplicate.begin(2, 100000000);
+    stalled->monitor->start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    EXPECT_EQ(noDuplicate.beginDuplicate(), nullptr);
+}
+
+TEST_F(StragglerDetectorTest, ProgressTest) {
+    int64_t consumed = 0;
+    int events = 0;
+    DataTransferListener listener = {[&](const std::shared_ptr<DataTransferStatus>& status) {
+                                         consumed += status->rwOnceBytes_;
+                                         events++;
+                                     },
+                                     nullptr};
+    StragglerDetector detector(testOptions(), listener);
+    auto first = detector.begin(1, 100);
+    ASSERT_NE(first->listener.dataTransferStatusChange_, nullptr);
+    reportProgress(first, 40, 100, 40);
+    EXPECT_EQ(consumed, 40);
+
+    // 重启后的请求从 0 开始，只计入超过之前进度的部分
+    first->monitor->abort();
+    auto second = detector.begin(1, 100);
+    reportProgress(second, 30, 100, 30);
+    EXPECT_EQ(consumed, 40);
+    reportProgress(second, 70, 100, 40);
+    EXPECT_EQ(consumed, 70);
+    reportProgress(second, 100, 100, 30);
+    EXPECT_EQ(consumed, 100);
+
+    // 被中止的请求不上报失败
+    auto failedEvents = events;
+    auto status = std::make_shared<DataTransferStatus>(DataTransferStatus{40, 100, 0, 4, first.get()});
+    first->listener.dataTransferStatusChange_(status);
+    EXPECT_EQ(events, failedEvents);
+}
+
+TEST_F(StragglerDetectorTest, BackgroundCheckTest) {
+    auto options = testOptions();
+    options.checkIntervalMillis = 10;
+    StragglerDetector detector(options, {nullptr, nullptr});
+    std::vector<std::shared_ptr<StragglerAttempt>> attempts;
+    for (int i = 1; i <= 3; i++) {
+        attempts.push_back(detector.begin(i, 1000000));
+        attempts.back()->monitor->start();
+        attempts.back()->monitor->update(i == 3 ? 0 : 100000);
+    }
+    // 完全停滞的分片请求被后台检查中止
+    for (int i = 0; i < 100 && !attempts[2]->monitor->aborted(); i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_TRUE(attempts[2]->monitor->aborted());
+    EXPECT_FALSE(attempts[0]->monitor->aborted());
+}
+}  // namespace VolcengineTos
@@ -0,0 +1,175 @@
+#include "../TestConfig.h"
+#include "../Utils.h"
+#include "TosClientV2.h"
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+
+namespace VolcengineTos {
+class SyncDirectoryTest : public ::testing::Test {
+protected:
+    SyncDirectoryTest() {
+    }
+
+    ~SyncDirectoryTest() override {
+    }
+
+    static void SetUpTestCase() {
+        ClientConfig conf;
+        conf.endPoint = TestConfig::Endpoint;
+        cliV2 = std::make_shared<TosClientV2>(TestConfig::Region, TestConfig::Ak, TestConfig::Sk, conf);
+        bucketName = TestUtils::GetBucketName(TestConfig::TestPrefix);
+        TestUtils::CreateBucket(cliV2, bucketName);
+    }
+
+    // Tears down the stuff shared by all tests in this test case.
+    static void TearDownTestCase() {
+        TestUtils::CleanBucket(cliV2, bucketName);
+        cliV2 = nullptr;
+    }
+
+public:
+    static std::shared_ptr<TosClientV2> cliV2;
+    static std::string bucketName;
+};
+
+std::shared_ptr<TosClientV2> SyncDirectoryTest::cliV2 = nullptr;
+std::string SyncDirectoryTest::bucketName = "";
+
+static std::string readFile(const std::string& path) {
+    std::ifstream ifs(path, std::ios::in | std::ios::binary);
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+    return ss.str();
+}
+
+TEST_F(SyncDirectoryTest, SyncUploadTest) {
+    auto dir = FileUtils::getTempPath() + TestUtils::GetObjectKey("sync-upload") + TOS_PATH_DELIMITER;
+    std::vector<std::string> files = {"a.txt", "sub/b.txt", "sub/deep/c.txt", "large"};
+    for (const auto& file : files) {
+        ASSERT_TRUE(FileUtils::CreateDir(dir + file, true));
+        TestUtils::WriteRandomDatatoFile(dir + file, file == "large" ? 11 * 1024 * 1024 + 7 : 1000);
+    }
+    std::string prefix = TestUtils::GetObjectKey(TestConfig::TestPrefix) + "/";
+    std::string stateFile = dir + "../" + TestUtils::GetObjectKey("sync-state");
+
+    SyncDirectoryInput input(bucketName, dir, prefix, SyncDirectionType::Upload);
+    input.setTaskNum(4);
+    input.setPartSize(5 * 1024 * 1024);
+    input.setMultipartThreshold(5 * 1024 * 1024);
+    input.setStateFile(stateFile);
+    auto output = cliV2->syncDirectory(input);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(output.result().getTransferredFiles(), files.size());
+    EXPECT_EQ(output.result().getHashedFiles(), files.size());
+
+    // 没有变化时不传输，也不重新计算 CRC64
+    output = cliV2->syncDirectory(input);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(output.result().getTransferredFiles(), 0);
+    EXPECT_EQ(output.result().getUnchangedFiles(), files.size());
+    EXPECT_EQ(output.result().getHashedFiles(), 0);
+
+    // 大小不变的修改通过 CRC64 识别，前缀下多出的对象被删除
+    TestUtils::WriteRandomDatatoFile(dir + "sub/b.txt", 1000);
+    TestUtils::PutObject(cliV2, bucketName, prefix + "extra", "extra");
+    input.setStateFile("");
+    input.setDeleteExtras(true);
+    output = cliV2->syncDirectory(input);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(output.result().getTransferredFiles(), 1);
+    EXPECT_EQ(output.result().getUnchangedFiles(), files.size() - 1);
+    EXPECT_EQ(output.result().getDeletedFiles(), 1);
+    auto getOutput = cliV2->getObject(GetObjectV2Input(bucketName, prefix + "sub/b.txt"));
+    ASSERT_TRUE(getOutput.isSuccess());
+    std::stringstream ss;
+    ss << getOutput.result().getContent()->rdbuf();
+    EXPECT_EQ(ss.str(), readFile(dir + "sub/b.txt"));
+    EXPECT_FALSE(cliV2->headObject(HeadObjectV2Input(bucketName, prefix + "extra")).isSuccess());
+}
+
+TEST_F(SyncDirectoryTest, SyncDownloadTest) {
+    std::string prefix = TestUtils::GetObjectKey(TestConfig::TestPrefix) + "/";
+    std::map<std::string, std::string> objects;
+    for (int i = 0; i < 10; i++) {
+        objects["small/" + std::to_string(i)] = TestUtils::GetRandomString(100 + i);
+    }
+    objects["large"] = TestUtils::GetRandomString(11 * 1024 * 1024 + 3);
+    for (const auto& object : objects) {
+        TestUtils::PutObject(cliV2, bucketName, prefix + object.first, object.second);
+    }
+
+    auto dir = FileUtils::getTempPath() + TestUtils::GetObjectKey("sync-download");
+    SyncDirectoryInput input(bucketName, dir, prefix, SyncDirectionType::Download);
+    input.setTaskNum(4);
+    input.setPartSize(5 * 1024 * 1024);
+    input.setMultipartThreshold(5 * 1024 * 1024);
+    input.setStateFile(dir + ".state");
+    auto output = cliV2->syncDirectory(input);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(output.result().getTransferredFiles(), objects.size());
+    for (const auto& object : objects) {
+        EXPECT_EQ(readFile(dir + TOS_PATH_DELIMITER + object.first), object.second);
+    }
+
+    // 下载的文件使用对象的 CRC64 记录状态，再次同步时不需要计算
+    output = cliV2->syncDirectory(input);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(output.result().getTransferredFiles(), 0);
+    EXPECT_EQ(output.result().getUnchangedFiles(), objects.size());
+    EXPECT_EQ(output.result().getHashedFiles(), 0);
+
+    // 对象更新后只下载变化的对象，本地多出的文件被删除
+    objects["small/3"] = TestUtils::GetRandomString(200);
+    TestUtils::PutObject(cliV2, bucketName, prefix + "small/3", objects["small/3"]);
+    std::ofstream(dir + TOS_PATH_DELIMITER + "local-only") << "local";
+    input.setDeleteExtras(true);
+    output = cliV2->syncDirectory(input);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(output.result().getTransferredFiles(), 1);
+    EXPECT_EQ(output.result().getDeletedFiles(), 1);
+    EXPECT_EQ(readFile(dir + TOS_PATH_DELIMITER + "small/3"), objects["small/3"]);
+    EXPECT_FALSE(std::ifstream(dir + TOS_PATH_DELIMITER + "local-only").good());
+}
+
+TEST_F(SyncDirectoryTest, StateFileInDirectoryTest) {
+    auto dir = FileUtils::getTempPath() + TestUtils::GetObjectKey("sync-state-inside");
+    std::string prefix = TestUtils::GetObjectKey(TestConfig::TestPrefix) + "/";
+    ASSERT_TRUE(FileUtils::CreateDir(dir + TOS_PATH_DELIMITER + "a.txt", true));
+    TestUtils::WriteRandomDatatoFile(dir + TOS_PATH_DELIMITER + "a.txt", 1000);
+
+    // 状态文件位于同步目录中，不会被上传
+    SyncDirectoryInput input(bucketName, dir, prefix, SyncDirectionType::Upload);
+    input.setStateFile(dir + TOS_PATH_DELIMITER + ".sync-state");
+    auto output = cliV2->syncDirectory(input);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(output.result().getTransferredFiles(), 1);
+    output = cliV2->syncDirectory(input);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(output.result().getTransferredFiles(), 0);
+    EXPECT_EQ(output.result().getUnchangedFiles(), 1);
+    EXPECT_FALSE(cliV2->headObject(HeadObjectV2Input(bucketName, prefix + ".sync-state")).isSuccess());
+
+    // 下载并删除本地多出的文件时保留状态文件，路径写法不同也能识别
+    input.setDirection(SyncDirectionType::Download);
+    input.setDeleteExtras(true);
+    input.setStateFile(dir + TOS_PATH_DELIMITER + "." + TOS_PATH_DELIMITER + ".sync-state");
+    output = cliV2->syncDirectory(input);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(output.result().getDeletedFiles(), 0);
+    EXPECT_TRUE(std::ifstream(dir + TOS_PATH_DELIMITER + ".sync-state").good());
+}
+
+TEST_F(SyncDirectoryTest, SyncDirectoryInvalidTest) {
+    std::string prefix = TestUtils::GetObjectKey(TestConfig::TestPrefix) + "/";
+    EXPECT_FALSE(cliV2->syncDirectory(SyncDirectoryInput(bucketName, "", prefix, SyncDirectionType::Upload))
+                         .isSuccess());
+    SyncDirectoryInput input(bucketName, FileUtils::getTempPath(), prefix, SyncDirectionType::Download);
+    input.setPartSize(1024);
+    EXPECT_FALSE(cliV2->syncDirectory(input).isSuccess());
+    input.setDirection(SyncDirectionType::Upload);
+    input.setDirectory(FileUtils::getTempPath() + TestUtils::GetObjectKey("not-exist"));
+    input.setPartSize(5 * 1024 * 1024);
+    EXPECT_FALSE(cliV2->syncDirectory(input).isSuccess());
+}
+}  // namespace VolcengineTos
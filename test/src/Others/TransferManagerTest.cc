@@ -0,0 +1,122 @@
+#include "../TestConfig.h"
+#include "../Utils.h"
+#include "TosClientV2.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace VolcengineTos {
+class TransferManagerTest : public ::testing::Test {
+protected:
+    TransferManagerTest() {
+    }
+
+    ~TransferManagerTest() override {
+    }
+
+    static void SetUpTestCase() {
+        ClientConfig conf;
+        conf.endPoint = TestConfig::Endpoint;
+        cliV2 = std::make_shared<TosClientV2>(TestConfig::Region, TestConfig::Ak, TestConfig::Sk, conf);
+        bucketName = TestUtils::GetBucketName(TestConfig::TestPrefix);
+        TestUtils::CreateBucket(cliV2, bucketName);
+        workPath = FileUtils::getWorkPath();
+    }
+
+    // Tears down the stuff shared by all tests in this test case.
+    static void TearDownTestCase() {
+        TestUtils::CleanBucket(cliV2, bucketName);
+        cliV2 = nullptr;
+    }
+
+public:
+    static std::shared_ptr<TosClientV2> cliV2;
+    static std::string bucketName;
+    static std::string workPath;
+};
+
+std::shared_ptr<TosClientV2> TransferManagerTest::cliV2 = nullptr;
+std::string TransferManagerTest::bucketName = "";
+std::string TransferManagerTest::workPath = "";
+
+TEST(PartSchedulerTest, PriorityTest) {
+    PartScheduler scheduler(1);
+    ASSERT_TRUE(scheduler.acquire(0, nullptr));
+    std::mutex mu;
+    std::vector<int> order;
+    auto worker = [&](int priority) {
+        ASSERT_TRUE(scheduler.acquire(priority, nullptr));
+        {
+            std::lock_guard<std::mutex> lock(mu);
+            order.push_back(priority);
+        }
+        scheduler.release();
+    };
+    // 先到的低优先级请求排在后到的高优先级请求之后
+    std::thread low(worker, 0);
+    while (scheduler.waiting() < 1) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::thread high(worker, 10);
+    while (scheduler.waiting() < 2) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(scheduler.running(), 1);
+    scheduler.release();
+    low.join();
+    high.join();
+    ASSERT_EQ(order.size(), 2);
+    EXPECT_EQ(order[0], 10);
+    EXPECT_EQ(order[1], 0);
+    EXPECT_EQ(scheduler.running(), 0);
+
+    // 等待中被停止时放弃名额
+    ASSERT_TRUE(scheduler.acquire(0, nullptr));
+    EXPECT_FALSE(scheduler.acquire(0, [] { return true; }));
+    EXPECT_EQ(scheduler.waiting(), 0);
+    scheduler.release();
+}
+
+TEST_F(TransferManagerTest, PauseAndResumeTest) {
+    std::string filePath = workPath + "test" + TOS_PATH_DELIMITER + "testdata" + TOS_PATH_DELIMITER + "transferManager";
+    TestUtils::WriteRandomDatatoFile(filePath, 30 * 1024 * 1024);
+    std::string objectName = TestUtils::GetObjectKey(TestConfig::TestPrefix);
+
+    TransferManagerOptions options;
+    options.maxConcurrency = 2;
+    auto manager = cliV2->newTransferManager(options);
+    UploadFileV2Input input;
+    input.setCreateMultipartUploadInput(CreateMultipartUploadInput(bucketName, objectName));
+    input.setTaskNum(4);
+    input.setPartSize(5 * 1024 * 1024);
+    input.setFilePath(filePath);
+    auto job = manager->uploadFile(input, 1);
+    job->pause();
+    auto state = job->wait();
+    // 暂停前可能已经完成
+    if (state == TransferJobState::Paused) {
+        EXPECT_EQ(manager->stats().paused, 1);
+        job->resume();
+        state = job->wait();
+    }
+    EXPECT_EQ(state, TransferJobState::Succeeded);
+    EXPECT_EQ(job->stats().transferredBytes, 30 * 1024 * 1024);
+    EXPECT_EQ(manager->stats().succeeded, 1);
+
+    DownloadFileInput downloadInput;
+    downloadInput.setHeadObjectV2Input(HeadObjectV2Input(bucketName, objectName));
+    downloadInput.setFilePath(filePath + ".download");
+    downloadInput.setPartSize(5 * 1024 * 1024);
+    downloadInput.setTaskNum(4);
+    auto download = manager->downloadFile(downloadInput, 10);
+    EXPECT_EQ(download->wait(), TransferJobState::Succeeded);
+    EXPECT_EQ(download->stats().totalBytes, 30 * 1024 * 1024);
+
+    // 取消后不再运行
+    auto cancelled = manager->uploadFile(input);
+    cancelled->cancel();
+    EXPECT_EQ(cancelled->wait(), TransferJobState::Cancelled);
+    EXPECT_EQ(manager->stats().cancelled, 1);
+    remove(filePath.c_str());
+    remove((filePath + ".download").c_str());
+}
+}  // namespace VolcengineTos
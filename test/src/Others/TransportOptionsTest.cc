@@ -0,0 +1,164 @@
+#include "../TestConfig.h"
+#include "../Utils.h"
+#include "transport/http/HttpClient.h"
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+namespace VolcengineTos {
+class TransportOptionsTest : public ::testing::Test {
+protected:
+    TransportOptionsTest() {
+    }
+
+    ~TransportOptionsTest() override {
+    }
+
+    static void SetUpTestCase() {
+    }
+
+    // Tears down the stuff shared by all tests in this test case.
+    static void TearDownTestCase() {
+    }
+};
+
+// 只接受一个连接的本地服务，读完请求后发送 response，然后停住直到测试结束
+class StallServer {
+public:
+    explicit StallServer(std::string response) : response_(std::move(response)) {
+        fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        listen(fd_, 1);
+        socklen_t len = sizeof(addr);
+        getsockname(fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+        thread_ = std::thread([this]() {
+            int conn = accept(fd_, nullptr, nullptr);
+            if (conn < 0) {
+                return;
+            }
+            char buf[4096];
+            recv(conn, buf, sizeof(buf), 0);
+            if (!response_.empty()) {
+                send(conn, response_.data(), response_.size(), 0);
+            }
+            while (!stop_) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            close(conn);
+        });
+    }
+    ~StallServer() {
+        stop_ = true;
+        shutdown(fd_, SHUT_RDWR);
+        close(fd_);
+        thread_.join();
+    }
+    std::string url() const {
+        return "http://127.0.0.1:" + std::to_string(port_) + "/";
+    }
+
+private:
+    std::string response_;
+    int fd_;
+    int port_;
+    std::atomic<bool> stop_{false};
+    std::thread thread_;
+};
+
+static HttpConfig testConfig() {
+    HttpConfig conf{};
+    conf.maxConnections = 2;
+    conf.socketTimeout = 30000;
+    conf.connectTimeout = 10000;
+    conf.proxyPort = -1;
+    conf.tcpKeepAlive = 30;
+    conf.tcpKeepAliveInterval = 5;
+    conf.tcpKeepAliveCount = 3;
+    conf.receiveBufferSize = 512 * 1024;
+    conf.uploadBufferSize = 1024 * 1024;
+    conf.socketSendBufferSize = 4 * 1024 * 1024;
+    conf.socketReceiveBufferSize = 4 * 1024 * 1024;
+    return conf;
+}
+
+static std::shared_ptr<HttpResponse> doGet(HttpClient& client, const std::string& url, double& seconds) {
+    auto request = std::make_shared<HttpRequest>("GET");
+    request->setUrl(Url(url));
+    auto start = std::chrono::steady_clock::now();
+    auto response = client.doRequest(request);
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return response;
+}
+
+TEST_F(TransportOptionsTest, ResponseHeaderTimeoutTest) {
+    StallServer server("");
+    auto conf = testConfig();
+    conf.responseHeaderTimeout = 1;
+    HttpClient client(conf);
+    double seconds = 0;
+    auto response = doGet(client, server.url(), seconds);
+    EXPECT_EQ(response->getCurlErrCode(), CURLE_OPERATION_TIMEDOUT);
+    EXPECT_NE(response->statusMsg().find("response header timeout"), std::string::npos);
+    EXPECT_LT(seconds, 5);
+}
+
+TEST_F(TransportOptionsTest, ReadTimeoutTest) {
+    // 响应头声明 100 字节，只发送 10 字节
+    StallServer server("HTTP/1.1 200 OK\r\nContent-Length: 100\r\n\r\n0123456789");
+    auto conf = testConfig();
+    conf.responseHeaderTimeout = 10;
+    conf.readTimeout = 1;
+    HttpClient client(conf);
+    double seconds = 0;
+    auto response = doGet(client, server.url(), seconds);
+    EXPECT_EQ(response->getCurlErrCode(), CURLE_OPERATION_TIMEDOUT);
+    EXPECT_NE(response->statusMsg().find("read timeout"), std::string::npos);
+    EXPECT_LT(seconds, 5);
+}
+
+TEST_F(TransportOptionsTest, TransferMonitorAbortTest) {
+    StallServer server("HTTP/1.1 200 OK\r\nContent-Length: 100\r\n\r\n0123456789");
+    HttpClient client(testConfig());
+    auto monitor = std::make_shared<TransferMonitor>();
+    auto request = std::make_shared<HttpRequest>("GET");
+    request->setUrl(Url(server.url()));
+    request->setTransferMonitor(monitor);
+    std::thread aborter([&]() {
+        for (int i = 0; i < 500 && monitor->transferred() < 10; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        monitor->abort();
+    });
+    auto start = std::chrono::steady_clock::now();
+    auto response = client.doRequest(request);
+    auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    aborter.join();
+    EXPECT_EQ(response->getCurlErrCode(), CURLE_ABORTED_BY_CALLBACK);
+    EXPECT_NE(response->statusMsg().find("aborted by transfer monitor"), std::string::npos);
+    EXPECT_EQ(monitor->transferred(), 10);
+    EXPECT_GT(monitor->elapsedMillis(), 0);
+    EXPECT_LT(seconds, 5);
+}
+
+TEST_F(TransportOptionsTest, ConnectTimeoutTest) {
+    // 建连超时取 connectTimeout 与 dialTimeout + tlsHandshakeTimeout 中的较小者，不可达的地址在约 2 秒后失败
+    auto conf = testConfig();
+    conf.connectTimeout = 30000;
+    conf.dialTimeout = 1;
+    conf.tlsHandshakeTimeout = 1;
+    HttpClient client(conf);
+    double seconds = 0;
+    auto response = doGet(client, "http://10.255.255.1/", seconds);
+    EXPECT_NE(response->getCurlErrCode(), 0);
+    EXPECT_LT(seconds, 5);
+}
+}  // namespace VolcengineTos
@@ -0,0 +1,71 @@
+#include "../TestConfig.h"
+#include "../Utils.h"
+#include "Type.h"
+#include "utils/MimeType.h"
+#include <cstring>
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace VolcengineTos {
+class TypeTableTest : public ::testing::Test {
+protected:
+    TypeTableTest() {
+    }
+
+    ~TypeTableTest() override {
+    }
+
+    static void SetUpTestCase() {
+    }
+
+    // Tears down the stuff shared by all tests in this test case.
+    static void TearDownTestCase() {
+    }
+};
+
+TEST_F(TypeTableTest, EnumTableTest) {
+    EXPECT_EQ(ACLTypetoString[ACLType::BucketOwnerFullControl], "bucket-owner-full-control");
+    EXPECT_EQ(ACLTypetoString[ACLType::NotSet], "");
+    EXPECT_EQ(StringtoACLType["public-read"], ACLType::PublicRead);
+    EXPECT_EQ(StorageClassTypetoString[StorageClassType::COLD_ARCHIVE], "COLD_ARCHIVE");
+    EXPECT_EQ(StringtoStorageClassType["INTELLIGENT_TIERING"], StorageClassType::INTELLIGENT_TIERING);
+    EXPECT_EQ(StringtoMetadataDirectiveType["REPLACE"], REPLACE);
+    EXPECT_EQ(StringtoTierType["Bulk"], TierType::TierBulk);
+    // 未知值返回默认枚举，且不会改变表
+    EXPECT_EQ(StringtoStorageClassType["UNKNOWN"], StorageClassType::NotSet);
+    EXPECT_EQ(StringtoStorageClassType[""], StorageClassType::NotSet);
+    EXPECT_EQ(StringtoPermissionType["none"], PermissionType::NotSet);
+}
+
+TEST_F(TypeTableTest, ConcurrentLookupTest) {
+    std::vector<std::thread> threads;
+    std::atomic<int> mismatch(0);
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([&mismatch, t]() {
+            for (int i = 0; i < 10000; i++) {
+                auto s = (i + t) % 2 == 0 ? "STANDARD" : "UNKNOWN-" + std::to_string(i);
+                auto type = StringtoStorageClassType[s];
+                if ((i + t) % 2 == 0 ? type != StorageClassType::STANDARD : type != StorageClassType::NotSet) {
+                    mismatch++;
+                }
+            }
+        });
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    EXPECT_EQ(mismatch, 0);
+}
+
+TEST_F(TypeTableTest, MimeTypeTest) {
+    for (size_t i = 1; i < mimeTypeTableSize; i++) {
+        EXPECT_LT(std::strcmp(mimeTypeTable[i - 1].ext, mimeTypeTable[i].ext), 0);
+    }
+    EXPECT_EQ(MimeType::getMimetypeByObjectKey("a/b.mp4"), "video/mp4");
+    EXPECT_EQ(MimeType::getMimetypeByObjectKey("a/b.ZIP"), "application/zip");
+    EXPECT_EQ(MimeType::getMimetypeByObjectKey("3gp.3gp"), "video/3gpp");
+    EXPECT_EQ(MimeType::getMimetypeByObjectKey("a.unknown-ext"), "application/octet-stream");
+    EXPECT_EQ(MimeType::getMimetypeByObjectKey("noext"), "application/octet-stream");
+    EXPECT_EQ(MimeType::getMimetypeByObjectKey("trailing."), "application/octet-stream");
+}
+}  // namespace VolcengineTos
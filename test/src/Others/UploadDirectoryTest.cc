@@ -0,0 +1,103 @@
+#include "../TestConfig.h"
+#include "../Utils.h"
+#include "TosClientV2.h"
+#include <gtest/gtest.h>
+#include <fstream>
+
+namespace VolcengineTos {
+class UploadDirectoryTest : public ::testing::Test {
+protected:
+    UploadDirectoryTest() {
+    }
+
+    ~UploadDirectoryTest() override {
+    }
+
+    static void SetUpTestCase() {
+        ClientConfig conf;
+        conf.endPoint = TestConfig::Endpoint;
+        cliV2 = std::make_shared<TosClientV2>(TestConfig::Region, TestConfig::Ak, TestConfig::Sk, conf);
+        bucketName = TestUtils::GetBucketName(TestConfig::TestPrefix);
+        TestUtils::CreateBucket(cliV2, bucketName);
+    }
+
+    // Tears down the stuff shared by all tests in this test case.
+    static void TearDownTestCase() {
+        TestUtils::CleanBucket(cliV2, bucketName);
+        cliV2 = nullptr;
+    }
+
+public:
+    static std::shared_ptr<TosClientV2> cliV2;
+    static std::string bucketName;
+};
+
+std::shared_ptr<TosClientV2> UploadDirectoryTest::cliV2 = nullptr;
+std::string UploadDirectoryTest::bucketName = "";
+
+static std::string readFile(const std::string& path) {
+    std::ifstream ifs(path, std::ios::in | std::ios::binary);
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+    return ss.str();
+}
+
+static void processCallBack(std::shared_ptr<DataTransferStatus> status) {
+    auto last = static_cast<std::pair<int64_t, int64_t>*>(status->userData_);
+    last->first = status->consumedBytes_;
+    last->second = status->totalBytes_;
+}
+
+TEST_F(UploadDirectoryTest, UploadDirectoryWithManifestTest) {
+    auto dir = FileUtils::getTempPath() + TestUtils::GetObjectKey("upload-directory") + TOS_PATH_DELIMITER;
+    std::vector<std::string> files = {"a.txt", "sub/b.txt", "sub/deep/c.txt", "sub/deep/large1", "large2"};
+    for (const auto& file : files) {
+        ASSERT_TRUE(FileUtils::CreateDir(dir + file, true));
+        auto large = file.find("large") != std::string::npos;
+        TestUtils::WriteRandomDatatoFile(dir + file, large ? 11 * 1024 * 1024 + 7 : 1000);
+    }
+    std::string prefix = TestUtils::GetObjectKey(TestConfig::TestPrefix) + "/";
+    std::string manifest = dir + "../" + TestUtils::GetObjectKey("manifest");
+
+    UploadDirectoryInput input(bucketName, dir, prefix);
+    input.setTaskNum(4);
+    input.setPartSize(5 * 1024 * 1024);
+    input.setMultipartThreshold(5 * 1024 * 1024);
+    input.setManifestFile(manifest);
+    std::pair<int64_t, int64_t> progress(0, 0);
+    input.setDataTransferListener({processCallBack, &progress});
+    auto output = cliV2->uploadDirectory(input);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(output.result().getUploadedFiles(), 5);
+    EXPECT_EQ(output.result().getMultipartFiles(), 2);
+    EXPECT_EQ(output.result().getSkippedFiles(), 0);
+    EXPECT_EQ(progress.first, progress.second);
+    EXPECT_EQ(progress.second, output.result().getUploadedBytes());
+    for (const auto& file : files) {
+        EXPECT_EQ(TestUtils::GetObjectContentByStream(cliV2, bucketName, prefix + file), readFile(dir + file));
+    }
+
+    // 再次执行只上传有变化的文件
+    TestUtils::WriteRandomDatatoFile(dir + "sub/b.txt", 2000);
+    input.setDataTransferListener({nullptr, nullptr});
+    output = cliV2->uploadDirectory(input);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(output.result().getUploadedFiles(), 1);
+    EXPECT_EQ(output.result().getSkippedFiles(), 4);
+    EXPECT_EQ(TestUtils::GetObjectContentByStream(cliV2, bucketName, prefix + "sub/b.txt"),
+              readFile(dir + "sub/b.txt"));
+    std::remove(manifest.c_str());
+}
+
+TEST_F(UploadDirectoryTest, UploadDirectoryInvalidInputTest) {
+    UploadDirectoryInput input(bucketName, "", "prefix/");
+    EXPECT_FALSE(cliV2->uploadDirectory(input).isSuccess());
+    input.setDirectory(FileUtils::getTempPath() + TestUtils::GetObjectKey("not-exist"));
+    auto output = cliV2->uploadDirectory(input);
+    EXPECT_FALSE(output.isSuccess());
+    EXPECT_TRUE(output.error().isClientError());
+    input.setDirectory(FileUtils::getTempPath());
+    input.setPartSize(1024);
+    EXPECT_FALSE(cliV2->uploadDirectory(input).isSuccess());
+}
+}  // namespace VolcengineTos
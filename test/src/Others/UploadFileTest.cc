@@ -1,7 +1,10 @@
 #include "../TestConfig.h"
 #include "../Utils.h"
 #include "TosClientV2.h"
+#include <fstream>
 #include <gtest/gtest.h>
+#include <mutex>
+#include <sstream>
 
 namespace VolcengineTos {
 class UploadFileTest : public ::testing::Test {
@@ -87,6 +90,41 @@ TEST_F(UploadFileTest, UploadEmptyFileWithoutCheckpointTest) {
     EXPECT_EQ(out_obj_get.isSuccess(), true);
     EXPECT_EQ(out_obj_get.result().getContentLength(), 0);
 }
+TEST_F(UploadFileTest, UploadFileExactMultipleOfPartSizeTest) {
+    std::string filePath =
+            workPath + "test" + TOS_PATH_DELIMITER + "testdata" + TOS_PATH_DELIMITER + "uploadFileExactMultiple";
+    TestUtils::WriteRandomDatatoFile(filePath, 10 * 1024 * 1024);
+
+    std::string objectName = TestUtils::GetObjectKey(TestConfig::TestPrefix);
+    UploadFileV2Input input;
+    input.setCreateMultipartUploadInput(CreateMultipartUploadInput(bucketName, objectName));
+    input.setTaskNum(2);
+    input.setPartSize(5 * 1024 * 1024);
+    input.setFilePath(filePath);
+    // 文件大小恰好是分片大小的整数倍时，每个分片都是 partSize
+    std::vector<int64_t> partSizes;
+    std::mutex mu;
+    UploadEventListener listener;
+    listener.eventChange_ = [&](std::shared_ptr<UploadEvent> event) {
+        if (event->type_ == UploadEventUploadPartSucceed) {
+            std::lock_guard<std::mutex> lock(mu);
+            partSizes.push_back(event->uploadPartInfo_->partSize_);
+        }
+    };
+    input.setUploadEventListener(listener);
+    auto output = cliV2->uploadFile(input);
+    ASSERT_TRUE(output.isSuccess());
+    EXPECT_EQ(partSizes, std::vector<int64_t>(2, 5 * 1024 * 1024));
+
+    auto headOutput = cliV2->headObject(HeadObjectV2Input(bucketName, objectName));
+    ASSERT_TRUE(headOutput.isSuccess());
+    EXPECT_EQ(headOutput.result().getContentLength(), 10 * 1024 * 1024);
+    std::ifstream ifs(filePath, std::ios::in | std::ios::binary);
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+    EXPECT_TRUE(TestUtils::GetObjectContentByStream(cliV2, bucketName, objectName) == ss.str());
+    remove(filePath.c_str());
+}
 //  带上进度条、限流、事件、cancel等
 static void ProgressCallback(std::shared_ptr<DataTransferStatus> datatransferstatus) {
     int64_t consumedBytes = datatransferstatus->consumedBytes_;